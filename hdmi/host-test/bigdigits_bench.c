@@ -0,0 +1,175 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file bigdigits_bench.c
+*
+* Checks mpModExp()/mpModExpMont() against a square-and-multiply reference
+* built on mpModMult(), checks that mpModExp() reports a failed workspace
+* allocation, and times the 1024-bit (HDCP 2.2 km encryption) and 3072-bit
+* (DCP certificate signature) exponentiations with e = 65537 and with a full
+* size exponent.
+*
+* Usage: bigdigits_bench [iterations], 0 runs the checks only.
+*
+******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <linux/slab.h>
+#include "bigdigits.h"
+#include "host.h"
+
+#define MAX_DIGITS	(3072 / 32)
+
+/* Reference, left-to-right square-and-multiply reducing with mpDivide */
+static void ref_modexp(u32 y[], const u32 x[], const u32 e[], u32 m[],
+		       size_t ndigits)
+{
+	u32 t[MAX_DIGITS];
+	size_t n = mpBitLength(e, ndigits);
+
+	mpSetDigit(y, 1, ndigits);
+	while (n--) {
+		mpModMult(t, y, y, m, ndigits);
+		if (mpGetBit((u32 *)e, ndigits, n))
+			mpModMult(y, t, x, m, ndigits);
+		else
+			mpSetEqual(y, t, ndigits);
+	}
+}
+
+static void rand_digits(u32 a[], size_t ndigits)
+{
+	size_t i;
+
+	for (i = 0; i < ndigits; i++)
+		a[i] = host_rand();
+}
+
+struct operands {
+	u32 m[MAX_DIGITS];
+	u32 x[MAX_DIGITS];
+	u32 e[MAX_DIGITS];
+	size_t ndigits;
+};
+
+/* RSA like operands: odd modulus with the top bit set, x < m */
+static void make_operands(struct operands *op, size_t bits, int short_e)
+{
+	op->ndigits = bits / 32;
+	rand_digits(op->m, op->ndigits);
+	op->m[0] |= 1;
+	op->m[op->ndigits - 1] |= 0x80000000;
+	rand_digits(op->x, op->ndigits);
+	op->x[op->ndigits - 1] &= 0x7FFFFFFF;
+	if (short_e) {
+		mpSetDigit(op->e, 65537, op->ndigits);
+	} else {
+		rand_digits(op->e, op->ndigits);
+		op->e[op->ndigits - 1] |= 0x80000000;
+	}
+}
+
+static void check(size_t bits, int short_e)
+{
+	struct operands op;
+	u32 y[MAX_DIGITS], r[MAX_DIGITS];
+	u32 ws[mpMODEXP_WORKSPACE_DIGITS(MAX_DIGITS)];
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		make_operands(&op, bits, short_e);
+		ref_modexp(r, op.x, op.e, op.m, op.ndigits);
+
+		CHECK(mpModExp(y, op.x, op.e, op.m, op.ndigits) == 0);
+		CHECK(mpEqual(y, r, op.ndigits));
+
+		memset(y, 0, sizeof(y));
+		mpModExpMont(y, op.x, op.e, op.m, op.ndigits, ws);
+		CHECK(mpEqual(y, r, op.ndigits));
+	}
+
+	/* The edge cases of the exponent: 0, 1 and a base of 0 and 1 */
+	mpSetZero(op.e, op.ndigits);
+	mpModExpMont(y, op.x, op.e, op.m, op.ndigits, ws);
+	CHECK(mpShortCmp(y, 1, op.ndigits) == 0);
+	mpSetDigit(op.e, 1, op.ndigits);
+	mpModExpMont(y, op.x, op.e, op.m, op.ndigits, ws);
+	CHECK(mpEqual(y, op.x, op.ndigits));
+	mpSetDigit(op.e, 65537, op.ndigits);
+	mpSetZero(op.x, op.ndigits);
+	mpModExpMont(y, op.x, op.e, op.m, op.ndigits, ws);
+	CHECK(mpIsZero(y, op.ndigits));
+	mpSetDigit(op.x, 1, op.ndigits);
+	mpModExpMont(y, op.x, op.e, op.m, op.ndigits, ws);
+	CHECK(mpShortCmp(y, 1, op.ndigits) == 0);
+
+	/* A failed workspace allocation is reported, not a BUG */
+	host_kmalloc_fail_after = 0;
+	CHECK(mpModExp(y, op.x, op.e, op.m, op.ndigits) == -1);
+	host_kmalloc_fail_after = -1;
+}
+
+static void bench(size_t bits, int short_e, int iterations)
+{
+	struct operands op;
+	u32 y[MAX_DIGITS];
+	u32 ws[mpMODEXP_WORKSPACE_DIGITS(MAX_DIGITS)];
+	u64 t0, t1, t2, t3;
+	int i, ref_iterations;
+
+	/* The reference is the slowest, keep its run short */
+	ref_iterations = iterations / 10 ? iterations / 10 : 1;
+
+	make_operands(&op, bits, short_e);
+
+	t0 = host_ns();
+	for (i = 0; i < iterations; i++)
+		mpModExp(y, op.x, op.e, op.m, op.ndigits);
+	t1 = host_ns();
+	for (i = 0; i < iterations; i++)
+		mpModExpMont(y, op.x, op.e, op.m, op.ndigits, ws);
+	t2 = host_ns();
+	for (i = 0; i < ref_iterations; i++)
+		ref_modexp(y, op.x, op.e, op.m, op.ndigits);
+	t3 = host_ns();
+
+	printf("%4zu-bit e=%-7s mpModExp %10llu ns  mpModExpMont %10llu ns  "
+	       "mpModMult %10llu ns\n", bits, short_e ? "65537" : "full",
+	       (unsigned long long)((t1 - t0) / iterations),
+	       (unsigned long long)((t2 - t1) / iterations),
+	       (unsigned long long)((t3 - t2) / ref_iterations));
+}
+
+int main(int argc, char **argv)
+{
+	int iterations = argc > 1 ? atoi(argv[1]) : 0;
+
+	check(1024, 1);
+	check(1024, 0);
+	check(3072, 1);
+	check(3072, 0);
+
+	if (iterations > 0) {
+		bench(1024, 1, iterations * 10);
+		bench(1024, 0, iterations);
+		bench(3072, 1, iterations * 10);
+		bench(3072, 0, iterations / 10 ? iterations / 10 : 1);
+	}
+
+	return host_report("bigdigits");
+}
@@ -0,0 +1,795 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file frl_test.c
+*
+* Unit test of the HDMI TX FRL training engine (xv_hdmitx_frl.c) against a
+* simulated SCDC peer. The peer implements the sink side of the training:
+* FLT_ready, the Ln_LTP_req pattern, TxFFE and rate change requests, the
+* FLT_update handshake and FRL_start. Time is simulated, the engine is
+* polled every XV_HDMITX_FRL_POLL_INTERVAL ms.
+*
+******************************************************************************/
+
+#include <string.h>
+#include "xv_hdmitx_frl.h"
+#include "xv_hdmitx.h"
+#include "host.h"
+
+#define NEVER			0xFFFFFFFF
+#define LANES			XV_HDMITX_FRL_MAX_LANES
+
+/* Simulated sink, the SCDC registers and what the source configured */
+struct peer {
+	u8 Scdc[256];
+	u8 FailReads;			/* All SCDC reads fail */
+	u32 ReadyMs;			/* FLT_ready delay after Config_1 */
+	u8 PassRate;			/* Highest rate the link passes at */
+	u8 NeedFfe[LANES];		/* TxFFE level each lane needs */
+	u8 StartFrl;			/* Set FRL_start after the training */
+
+	u32 NowMs;
+	u32 ConfigMs;			/* Time of the last Config_1 write */
+	u8 LanePassed[LANES];
+	u8 Published;			/* All lanes passed was published */
+	u8 Started;			/* FRL_start was set */
+
+	u8 FailSetRate;
+	u8 Rate;			/* Last SetRate */
+	u8 Lanes;
+	u8 LineRate;
+	u32 SetRateCalls;
+	u8 FirstRate;			/* First SetRate since peer_reset */
+	u8 Ltp[LANES];			/* Patterns sent by the source */
+	u8 Ffe[LANES];			/* TxFFE levels of the source */
+	u32 SetFfeCalls;
+	u32 Reads;
+};
+
+static u8 peer_want_ltp(u8 Lane)
+{
+	return Lane + 5;
+}
+
+static void peer_reset(struct peer *p)
+{
+	memset(p, 0, sizeof(*p));
+	p->Scdc[XV_HDMITX_FRL_SCDC_SINK_VERSION] = 1;
+	p->PassRate = XHDMIC_MAXFRLRATE_4X12GBITSPS;
+	p->StartFrl = TRUE;
+	p->FirstRate = 0xFF;
+}
+
+/* The sink forgets the training, e.g. on a new rate or a link error */
+static void peer_retrain(struct peer *p)
+{
+	memset(p->LanePassed, 0, sizeof(p->LanePassed));
+	p->Published = FALSE;
+	p->Started = FALSE;
+	p->Scdc[XV_HDMITX_FRL_SCDC_UPDATE_0] &=
+		~XV_HDMITX_FRL_SCDC_FRL_START_MASK;
+}
+
+static void peer_publish(struct peer *p, const u8 *Req)
+{
+	p->Scdc[XV_HDMITX_FRL_SCDC_STATUS_FLAGS_1] = Req[0] | (Req[1] << 4);
+	p->Scdc[XV_HDMITX_FRL_SCDC_STATUS_FLAGS_2] = Req[2] | (Req[3] << 4);
+	p->Scdc[XV_HDMITX_FRL_SCDC_UPDATE_0] |=
+		XV_HDMITX_FRL_SCDC_FLT_UPDATE_MASK;
+}
+
+/* The sink side between two polls of the source */
+static void peer_step(struct peer *p)
+{
+	u8 *Update = &p->Scdc[XV_HDMITX_FRL_SCDC_UPDATE_0];
+	u8 Rate = p->Scdc[XV_HDMITX_FRL_SCDC_CONFIG_1] & 0xF;
+	u8 Req[LANES] = { 0 };
+	u8 Lanes;
+	u8 Lane;
+	u8 Passed = TRUE;
+
+	if (!Rate)
+		return;
+
+	if (!(p->Scdc[XV_HDMITX_FRL_SCDC_STATUS_FLAGS_0] &
+	      XV_HDMITX_FRL_SCDC_FLT_READY_MASK)) {
+		if (p->ReadyMs != NEVER && p->NowMs - p->ConfigMs >= p->ReadyMs)
+			p->Scdc[XV_HDMITX_FRL_SCDC_STATUS_FLAGS_0] |=
+				XV_HDMITX_FRL_SCDC_FLT_READY_MASK;
+		return;
+	}
+
+	/* Wait until the source has handled the previous update */
+	if (*Update & XV_HDMITX_FRL_SCDC_FLT_UPDATE_MASK)
+		return;
+
+	if (p->Published) {
+		if (p->StartFrl && !p->Started) {
+			*Update |= XV_HDMITX_FRL_SCDC_FRL_START_MASK;
+			p->Started = TRUE;
+		}
+		return;
+	}
+
+	Lanes = FrlRateTable[Rate].Lanes;
+	if (Rate > p->PassRate) {
+		Req[0] = XV_HDMITX_FRL_LTP_RATE_CHANGE;
+		peer_publish(p, Req);
+		return;
+	}
+
+	for (Lane = 0; Lane < Lanes; Lane++) {
+		if (p->LanePassed[Lane])
+			continue;
+		if (p->Ltp[Lane] != peer_want_ltp(Lane)) {
+			Req[Lane] = peer_want_ltp(Lane);
+		} else if (p->Ffe[Lane] < p->NeedFfe[Lane]) {
+			Req[Lane] = XV_HDMITX_FRL_LTP_FFE_CHANGE;
+		} else {
+			p->LanePassed[Lane] = TRUE;
+			continue;
+		}
+		Passed = FALSE;
+	}
+
+	if (Passed)
+		p->Published = TRUE;
+	peer_publish(p, Req);
+}
+
+static int peer_scdc_read(void *CallbackRef, u8 Offset, u8 *DataPtr)
+{
+	struct peer *p = CallbackRef;
+
+	p->Reads++;
+	if (p->FailReads)
+		return XST_FAILURE;
+	*DataPtr = p->Scdc[Offset];
+	return XST_SUCCESS;
+}
+
+static int peer_scdc_write(void *CallbackRef, u8 Offset, u8 Data)
+{
+	struct peer *p = CallbackRef;
+
+	switch (Offset) {
+	case XV_HDMITX_FRL_SCDC_UPDATE_0:
+		/* Write 1 to clear */
+		p->Scdc[Offset] &= ~Data;
+		break;
+	case XV_HDMITX_FRL_SCDC_CONFIG_1:
+		p->Scdc[Offset] = Data;
+		p->ConfigMs = p->NowMs;
+		peer_retrain(p);
+		if (!(Data & 0xF))
+			p->Scdc[XV_HDMITX_FRL_SCDC_STATUS_FLAGS_0] = 0;
+		break;
+	default:
+		p->Scdc[Offset] = Data;
+		break;
+	}
+	return XST_SUCCESS;
+}
+
+static int peer_set_rate(void *CallbackRef, u8 FrlRate, u8 Lanes,
+			 u8 LineRate)
+{
+	struct peer *p = CallbackRef;
+
+	if (p->FirstRate == 0xFF)
+		p->FirstRate = FrlRate;
+	p->Rate = FrlRate;
+	p->Lanes = Lanes;
+	p->LineRate = LineRate;
+	p->SetRateCalls++;
+	return p->FailSetRate ? XST_FAILURE : XST_SUCCESS;
+}
+
+static void peer_set_ltp(void *CallbackRef, u8 Lane, u8 Ltp)
+{
+	struct peer *p = CallbackRef;
+
+	CHECK(Lane < LANES);
+	p->Ltp[Lane] = Ltp;
+}
+
+static void peer_set_ffe(void *CallbackRef, u8 Lane, u8 FfeLevel)
+{
+	struct peer *p = CallbackRef;
+
+	CHECK(Lane < LANES);
+	p->Ffe[Lane] = FfeLevel;
+	p->SetFfeCalls++;
+}
+
+static void init(XV_HdmiTx_Frl *Frl, struct peer *p, u8 FfeLevels)
+{
+	XV_HdmiTx_FrlConfig Config = {
+		.ScdcRead = peer_scdc_read,
+		.ScdcWrite = peer_scdc_write,
+		.SetRate = peer_set_rate,
+		.SetLtp = peer_set_ltp,
+		.SetFfe = peer_set_ffe,
+		.CallbackRef = p,
+		.MaxFrlRate = XHDMIC_MAXFRLRATE_4X12GBITSPS,
+		.FfeLevels = FfeLevels,
+	};
+
+	peer_reset(p);
+	CHECK(XV_HdmiTx_FrlInitialize(Frl, &Config) == XST_SUCCESS);
+}
+
+/*
+ * Polls the engine every XV_HDMITX_FRL_POLL_INTERVAL ms until it reaches
+ * Until or LTS:L, or MaxMs have passed. Returns the time it took.
+ */
+static u32 run(XV_HdmiTx_Frl *Frl, struct peer *p, XV_HdmiTx_FrlState Until,
+	       u32 MaxMs)
+{
+	XV_HdmiTx_FrlState State = Frl->State;
+	u32 Ms = 0;
+
+	while (Ms < MaxMs && State != Until &&
+	       (Ms == 0 || State != XV_HDMITX_FRL_STATE_LTS_L)) {
+		Ms += XV_HDMITX_FRL_POLL_INTERVAL;
+		p->NowMs += XV_HDMITX_FRL_POLL_INTERVAL;
+		peer_step(p);
+		State = XV_HdmiTx_FrlPoll(Frl, XV_HDMITX_FRL_POLL_INTERVAL);
+	}
+
+	return Ms;
+}
+
+static u8 config_1(u8 Rate, u8 FfeLevels)
+{
+	return Rate | (FfeLevels << XV_HDMITX_FRL_SCDC_FFE_LEVELS_SHIFT);
+}
+
+static void test_initialize(void)
+{
+	XV_HdmiTx_FrlConfig Config;
+	XV_HdmiTx_Frl Frl;
+
+	memset(&Config, 0, sizeof(Config));
+	Config.ScdcRead = peer_scdc_read;
+	Config.ScdcWrite = peer_scdc_write;
+	Config.SetRate = peer_set_rate;
+	CHECK(XV_HdmiTx_FrlInitialize(&Frl, &Config) == XST_FAILURE);
+
+	Config.SetLtp = peer_set_ltp;
+	Config.FfeLevels = 7;
+	CHECK(XV_HdmiTx_FrlInitialize(&Frl, &Config) == XST_SUCCESS);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L);
+	CHECK(Frl.Config.FfeLevels == XV_HDMITX_FRL_MAX_FFE_LEVEL);
+}
+
+/* A HF-VSDB or HF-SCDB with the given SCDC and Max_FRL_Rate bytes */
+static void edid_build(u8 *Edid, int Scdb, u8 Scdc, u8 MaxFrlRate)
+{
+	u8 *Ext = &Edid[128];
+	u8 *Blk;
+
+	memset(Edid, 0, 256);
+	Edid[126] = 1;
+	Ext[0] = 0x02;
+	Ext[1] = 3;
+
+	/* A short video data block in front */
+	Ext[4] = (2 << 5) | 2;
+	Ext[5] = 16;
+	Ext[6] = 97;
+
+	Blk = &Ext[7];
+	if (Scdb) {
+		Blk[0] = (0x07 << 5) | 7;
+		Blk[1] = 0x79;
+	} else {
+		Blk[0] = (0x03 << 5) | 7;
+		Blk[1] = 0xD8;
+		Blk[2] = 0x5D;
+		Blk[3] = 0xC4;
+	}
+	Blk[4] = 1;
+	Blk[5] = 120;
+	Blk[6] = Scdc;
+	Blk[7] = MaxFrlRate << 4;
+	Ext[2] = 7 + 8;
+}
+
+static void test_edid(void)
+{
+	u8 Edid[256];
+	u8 Rate;
+	u32 Id;
+
+	for (Rate = 1; Rate < XHDMIC_MAXFRLRATE_SIZE; Rate++) {
+		edid_build(Edid, FALSE, 0x80, Rate);
+		CHECK(XV_HdmiTx_FrlGetEdidMaxRate(Edid, 256) == Rate);
+		edid_build(Edid, TRUE, 0x80, Rate);
+		CHECK(XV_HdmiTx_FrlGetEdidMaxRate(Edid, 256) == Rate);
+	}
+
+	/* Reserved rates are clamped */
+	edid_build(Edid, FALSE, 0x80, 0xF);
+	CHECK(XV_HdmiTx_FrlGetEdidMaxRate(Edid, 256) ==
+	      XHDMIC_MAXFRLRATE_4X12GBITSPS);
+
+	/* No SCDC, no FRL */
+	edid_build(Edid, FALSE, 0x00, XHDMIC_MAXFRLRATE_4X12GBITSPS);
+	CHECK(XV_HdmiTx_FrlGetEdidMaxRate(Edid, 256) ==
+	      XHDMIC_MAXFRLRATE_NOT_SUPPORTED);
+
+	/* Base block only */
+	edid_build(Edid, FALSE, 0x80, XHDMIC_MAXFRLRATE_4X12GBITSPS);
+	CHECK(XV_HdmiTx_FrlGetEdidMaxRate(Edid, 128) ==
+	      XHDMIC_MAXFRLRATE_NOT_SUPPORTED);
+
+	/* The block crosses the end of the data block collection */
+	Edid[128 + 2] = 7 + 6;
+	CHECK(XV_HdmiTx_FrlGetEdidMaxRate(Edid, 256) ==
+	      XHDMIC_MAXFRLRATE_NOT_SUPPORTED);
+
+	/* Other OUI */
+	edid_build(Edid, FALSE, 0x80, XHDMIC_MAXFRLRATE_4X12GBITSPS);
+	Edid[128 + 7 + 1] = 0x03;
+	CHECK(XV_HdmiTx_FrlGetEdidMaxRate(Edid, 256) ==
+	      XHDMIC_MAXFRLRATE_NOT_SUPPORTED);
+
+	/* The sink identifier covers the vendor and product identification */
+	Id = XV_HdmiTx_FrlGetEdidSinkId(Edid);
+	Edid[0] = 0xFF;
+	Edid[18] = 0xFF;
+	CHECK(XV_HdmiTx_FrlGetEdidSinkId(Edid) == Id);
+	Edid[12] ^= 1;
+	CHECK(XV_HdmiTx_FrlGetEdidSinkId(Edid) != Id);
+}
+
+/* LTS:1 to LTS:P at the highest rate */
+static void test_train(void)
+{
+	XV_HdmiTx_Frl Frl;
+	struct peer p;
+	u8 Lane;
+
+	init(&Frl, &p, 0);
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_2);
+	CHECK(p.Scdc[XV_HDMITX_FRL_SCDC_SOURCE_VERSION] == 1);
+	CHECK(p.Scdc[XV_HDMITX_FRL_SCDC_CONFIG_1] ==
+	      config_1(XHDMIC_MAXFRLRATE_4X12GBITSPS, 0));
+	CHECK(p.Rate == XHDMIC_MAXFRLRATE_4X12GBITSPS);
+	CHECK(p.Lanes == 4 && p.LineRate == 12);
+
+	p.ReadyMs = 10;
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_3, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_3);
+	CHECK(p.NowMs == 10);
+
+	/* The patterns the sink asks for are sent until the lanes pass */
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P_ARM, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_P_ARM);
+	for (Lane = 0; Lane < LANES; Lane++) {
+		CHECK(p.LanePassed[Lane]);
+		CHECK(p.Ltp[Lane] == XV_HDMITX_FRL_LTP_NONE);
+	}
+
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_P);
+	CHECK(!(p.Scdc[XV_HDMITX_FRL_SCDC_UPDATE_0] &
+		XV_HDMITX_FRL_SCDC_FRL_START_MASK));
+	CHECK(p.Rate == XHDMIC_MAXFRLRATE_4X12GBITSPS);
+	CHECK(Frl.Trainings == 1 && Frl.RateFallbacks == 0 &&
+	      Frl.Failures == 0);
+
+	/* Stays in LTS:P */
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_L, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_P);
+
+	/* The sink limit applies */
+	init(&Frl, &p, 0);
+	p.ReadyMs = 0;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_3X6GBITSPS) ==
+	      XST_SUCCESS);
+	CHECK(p.Rate == XHDMIC_MAXFRLRATE_3X6GBITSPS && p.Lanes == 3);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_P);
+	CHECK(!p.LanePassed[3] && p.Ltp[3] == XV_HDMITX_FRL_LTP_NONE);
+}
+
+/* Ln_LTP_req = 0xE raises the TxFFE level of the lane up to FFE_Levels */
+static void test_ffe(void)
+{
+	static const u8 Need[LANES] = { 1, 3, 0, 2 };
+	XV_HdmiTx_Frl Frl;
+	struct peer p;
+	u8 Lane;
+	u32 Ms;
+
+	init(&Frl, &p, 3);
+	memcpy(p.NeedFfe, Need, sizeof(Need));
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	CHECK(p.Scdc[XV_HDMITX_FRL_SCDC_CONFIG_1] ==
+	      config_1(XHDMIC_MAXFRLRATE_4X12GBITSPS, 3));
+	for (Lane = 0; Lane < LANES; Lane++)
+		CHECK(p.Ffe[Lane] == 0);
+
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_P);
+	for (Lane = 0; Lane < LANES; Lane++) {
+		CHECK(p.Ffe[Lane] == Need[Lane]);
+		CHECK(Frl.Ffe[Lane] == Need[Lane]);
+	}
+	/* Four initial levels and one call per increment */
+	CHECK(p.SetFfeCalls == 4 + 1 + 3 + 0 + 2);
+	CHECK(Frl.RateFallbacks == 0);
+
+	/* A lane needing more than FFE_Levels never passes, LTS:3 times out */
+	init(&Frl, &p, 1);
+	memcpy(p.NeedFfe, Need, sizeof(Need));
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_3, 1000);
+	Ms = run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L);
+	CHECK(Ms == XV_HDMITX_FRL_LTS3_TIMEOUT);
+	for (Lane = 0; Lane < LANES; Lane++)
+		CHECK(Frl.Ffe[Lane] <= 1);
+	CHECK(Frl.Failures == 1);
+	CHECK(p.Rate == 0 && p.Scdc[XV_HDMITX_FRL_SCDC_CONFIG_1] == 0);
+
+	/* Without a TxFFE callback the levels are still tracked */
+	init(&Frl, &p, 3);
+	Frl.Config.SetFfe = NULL;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	CHECK(p.SetFfeCalls == 0);
+}
+
+/* Ln_LTP_req = 0xF, LTS:4 falls back to the next lower rate */
+static void test_rate_fallback(void)
+{
+	XV_HdmiTx_Frl Frl;
+	struct peer p;
+
+	init(&Frl, &p, 3);
+	p.PassRate = XHDMIC_MAXFRLRATE_3X6GBITSPS;
+	p.NeedFfe[1] = 2;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_P);
+	CHECK(Frl.RateFallbacks == XHDMIC_MAXFRLRATE_4X12GBITSPS -
+	      XHDMIC_MAXFRLRATE_3X6GBITSPS);
+	CHECK(Frl.FrlRate == XHDMIC_MAXFRLRATE_3X6GBITSPS);
+	CHECK(p.Rate == XHDMIC_MAXFRLRATE_3X6GBITSPS);
+	CHECK(p.Lanes == 3 && p.LineRate == 6);
+	CHECK(p.Scdc[XV_HDMITX_FRL_SCDC_CONFIG_1] ==
+	      config_1(XHDMIC_MAXFRLRATE_3X6GBITSPS, 3));
+	CHECK(Frl.Ffe[1] == 2 && Frl.Failures == 0);
+
+	/* Below 3x3 Gbps there is no FRL */
+	init(&Frl, &p, 0);
+	p.PassRate = XHDMIC_MAXFRLRATE_NOT_SUPPORTED;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X8GBITSPS) ==
+	      XST_SUCCESS);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L);
+	CHECK(Frl.RateFallbacks == XHDMIC_MAXFRLRATE_4X8GBITSPS);
+	CHECK(Frl.Failures == 1);
+	CHECK(p.Rate == 0 && p.Lanes == 3);
+
+	/* A failing rate change ends in LTS:L */
+	init(&Frl, &p, 0);
+	p.PassRate = XHDMIC_MAXFRLRATE_4X10GBITSPS;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	p.FailSetRate = TRUE;
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L);
+	CHECK(Frl.RateFallbacks == 1 && Frl.Failures == 1);
+}
+
+static void test_timeouts(void)
+{
+	XV_HdmiTx_Frl Frl;
+	struct peer p;
+	u32 Ms;
+
+	/* LTS:2, no FLT_ready within 100 ms */
+	init(&Frl, &p, 0);
+	p.ReadyMs = NEVER;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	Ms = run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_3, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L);
+	CHECK(Ms == XV_HDMITX_FRL_LTS2_TIMEOUT);
+	CHECK(p.Rate == 0 && Frl.Failures == 1);
+
+	/* FLT_ready just in time */
+	init(&Frl, &p, 0);
+	p.ReadyMs = XV_HDMITX_FRL_LTS2_TIMEOUT - XV_HDMITX_FRL_POLL_INTERVAL;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_3, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_3);
+
+	/* SCDC read errors count as no status change */
+	init(&Frl, &p, 0);
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	p.FailReads = TRUE;
+	Ms = run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_3, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L);
+	CHECK(Ms == XV_HDMITX_FRL_LTS2_TIMEOUT);
+
+	/* LTS:3, the lanes do not pass within 200 ms */
+	init(&Frl, &p, 0);
+	p.NeedFfe[2] = 1;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_3, 1000);
+	Ms = run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L);
+	CHECK(Ms == XV_HDMITX_FRL_LTS3_TIMEOUT);
+
+	/* unless the sink sets FLT_no_timeout */
+	init(&Frl, &p, 0);
+	p.NeedFfe[2] = 1;
+	p.Scdc[XV_HDMITX_FRL_SCDC_SOURCE_TEST_CFG] =
+		XV_HDMITX_FRL_SCDC_FLT_NO_TIMEOUT_MASK;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	CHECK(Frl.NoTimeout);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 10 * XV_HDMITX_FRL_LTS3_TIMEOUT);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_3);
+	XV_HdmiTx_FrlStop(&Frl);
+
+	/* LTS:P, no FRL_start within 200 ms */
+	init(&Frl, &p, 0);
+	p.StartFrl = FALSE;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P_ARM, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_P_ARM);
+	Ms = run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L);
+	CHECK(Ms == XV_HDMITX_FRL_LTS3_TIMEOUT);
+}
+
+/* LTS:P, the sink requests retraining through FLT_update */
+static void test_retrain(void)
+{
+	XV_HdmiTx_Frl Frl;
+	struct peer p;
+
+	init(&Frl, &p, 3);
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_P);
+
+	peer_retrain(&p);
+	p.NeedFfe[3] = 2;
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_3, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_3);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_P);
+	CHECK(Frl.Ffe[3] == 2);
+	CHECK(Frl.Trainings == 1 && Frl.Failures == 0);
+
+	/* A rate change request in LTS:P */
+	peer_retrain(&p);
+	p.PassRate = XHDMIC_MAXFRLRATE_4X10GBITSPS;
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_3, 1000);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 1000);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_P);
+	CHECK(p.Rate == XHDMIC_MAXFRLRATE_4X10GBITSPS);
+	CHECK(Frl.RateFallbacks == 1);
+}
+
+/* Hotplug of the sink, which resets its SCDC, and a full training */
+static XV_HdmiTx_FrlState train(XV_HdmiTx_Frl *Frl, struct peer *p,
+				u32 SinkId, u8 SinkMaxFrlRate)
+{
+	p->Scdc[XV_HDMITX_FRL_SCDC_CONFIG_1] = 0;
+	p->Scdc[XV_HDMITX_FRL_SCDC_STATUS_FLAGS_0] = 0;
+	p->Scdc[XV_HDMITX_FRL_SCDC_UPDATE_0] = 0;
+	p->FirstRate = 0xFF;
+	XV_HdmiTx_FrlStart(Frl, SinkId, SinkMaxFrlRate);
+	run(Frl, p, XV_HDMITX_FRL_STATE_LTS_P, 2000);
+	return Frl->State;
+}
+
+/* The rate and TxFFE levels of the last training are reused per sink */
+static void test_cache(void)
+{
+	static const u8 Need[LANES] = { 1, 0, 2, 1 };
+	XV_HdmiTx_Frl Frl;
+	struct peer p;
+	u32 Ms;
+	u32 Id;
+
+	init(&Frl, &p, 3);
+	p.PassRate = XHDMIC_MAXFRLRATE_4X8GBITSPS;
+	memcpy(p.NeedFfe, Need, sizeof(Need));
+	CHECK(train(&Frl, &p, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XV_HDMITX_FRL_STATE_LTS_P);
+	CHECK(p.FirstRate == XHDMIC_MAXFRLRATE_4X12GBITSPS);
+	CHECK(Frl.RateFallbacks == 2);
+	Ms = p.NowMs;
+
+	/* Retraining the same sink starts at the known-good point */
+	XV_HdmiTx_FrlStop(&Frl);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L && p.Rate == 0);
+	memset(p.Ffe, 0, sizeof(p.Ffe));
+	p.NowMs = 0;
+	CHECK(train(&Frl, &p, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XV_HDMITX_FRL_STATE_LTS_P);
+	CHECK(p.FirstRate == XHDMIC_MAXFRLRATE_4X8GBITSPS);
+	CHECK(!memcmp(p.Ffe, Need, sizeof(Need)));
+	CHECK(Frl.RateFallbacks == 2);
+	CHECK(p.NowMs < Ms);
+
+	/* A cached rate above the current limit is not used */
+	XV_HdmiTx_FrlStop(&Frl);
+	p.PassRate = XHDMIC_MAXFRLRATE_4X12GBITSPS;
+	CHECK(train(&Frl, &p, 1, XHDMIC_MAXFRLRATE_4X6GBITSPS) ==
+	      XV_HDMITX_FRL_STATE_LTS_P);
+	CHECK(p.FirstRate == XHDMIC_MAXFRLRATE_4X6GBITSPS);
+
+	/* A failed training removes the sink */
+	XV_HdmiTx_FrlStop(&Frl);
+	p.ReadyMs = NEVER;
+	CHECK(train(&Frl, &p, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XV_HDMITX_FRL_STATE_LTS_L);
+	p.ReadyMs = 0;
+	p.PassRate = XHDMIC_MAXFRLRATE_4X10GBITSPS;
+	CHECK(train(&Frl, &p, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XV_HDMITX_FRL_STATE_LTS_P);
+	CHECK(p.FirstRate == XHDMIC_MAXFRLRATE_4X12GBITSPS);
+
+	/* The oldest sink is replaced when the cache is full */
+	for (Id = 2; Id <= XV_HDMITX_FRL_CACHE_SIZE + 1; Id++) {
+		XV_HdmiTx_FrlStop(&Frl);
+		CHECK(train(&Frl, &p, Id, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+		      XV_HDMITX_FRL_STATE_LTS_P);
+	}
+	XV_HdmiTx_FrlStop(&Frl);
+	train(&Frl, &p, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS);
+	CHECK(p.FirstRate == XHDMIC_MAXFRLRATE_4X12GBITSPS);
+	XV_HdmiTx_FrlStop(&Frl);
+	train(&Frl, &p, XV_HDMITX_FRL_CACHE_SIZE + 1,
+	      XHDMIC_MAXFRLRATE_4X12GBITSPS);
+	CHECK(p.FirstRate == XHDMIC_MAXFRLRATE_4X10GBITSPS);
+
+	XV_HdmiTx_FrlStop(&Frl);
+	XV_HdmiTx_FrlCacheFlush(&Frl);
+	train(&Frl, &p, XV_HDMITX_FRL_CACHE_SIZE + 1,
+	      XHDMIC_MAXFRLRATE_4X12GBITSPS);
+	CHECK(p.FirstRate == XHDMIC_MAXFRLRATE_4X12GBITSPS);
+}
+
+/* LTS:1 failures and XV_HdmiTx_FrlStop */
+static void test_legacy(void)
+{
+	XV_HdmiTx_Frl Frl;
+	struct peer p;
+	u32 Calls;
+
+	init(&Frl, &p, 0);
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_NOT_SUPPORTED) ==
+	      XST_FAILURE);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L && p.Reads == 0);
+	CHECK(p.Rate == 0 && p.Lanes == 3);
+
+	init(&Frl, &p, 0);
+	p.Scdc[XV_HDMITX_FRL_SCDC_SINK_VERSION] = 0;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_FAILURE);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L && Frl.Failures == 1);
+
+	init(&Frl, &p, 0);
+	p.FailReads = TRUE;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_FAILURE);
+
+	init(&Frl, &p, 0);
+	p.FailSetRate = TRUE;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_FAILURE);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L);
+
+	/* Stop in LTS:3 stops the patterns and returns to TMDS */
+	init(&Frl, &p, 0);
+	p.NeedFfe[0] = 1;
+	CHECK(XV_HdmiTx_FrlStart(&Frl, 1, XHDMIC_MAXFRLRATE_4X12GBITSPS) ==
+	      XST_SUCCESS);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_3, 1000);
+	run(&Frl, &p, XV_HDMITX_FRL_STATE_LTS_P, 20);
+	CHECK(p.Ltp[0] != XV_HDMITX_FRL_LTP_NONE);
+	XV_HdmiTx_FrlStop(&Frl);
+	CHECK(Frl.State == XV_HDMITX_FRL_STATE_LTS_L);
+	CHECK(p.Ltp[0] == XV_HDMITX_FRL_LTP_NONE);
+	CHECK(p.Rate == 0 && p.Lanes == 3);
+	CHECK(Frl.Failures == 0);
+
+	Calls = p.SetRateCalls;
+	XV_HdmiTx_FrlStop(&Frl);
+	CHECK(p.SetRateCalls == Calls);
+	CHECK(XV_HdmiTx_FrlPoll(&Frl, 1000) == XV_HDMITX_FRL_STATE_LTS_L);
+}
+
+/* The SCDC callbacks over the DDC */
+static u8 DdcSlave;
+static u8 DdcBuf[4];
+static u16 DdcLength;
+static u8 DdcStop;
+
+int XV_HdmiTx_DdcWrite(XV_HdmiTx *InstancePtr, u8 Slave, u16 Length,
+		       u8 *Buffer, u8 Stop)
+{
+	DdcSlave = Slave;
+	DdcLength = Length;
+	DdcStop = Stop;
+	memcpy(DdcBuf, Buffer, Length);
+	return XST_SUCCESS;
+}
+
+int XV_HdmiTx_DdcRead(XV_HdmiTx *InstancePtr, u8 Slave, u16 Length,
+		      u8 *Buffer, u8 Stop)
+{
+	CHECK(Slave == XV_HDMITX_FRL_SCDC_SLAVE);
+	CHECK(Length == 1 && Stop == TRUE);
+	CHECK(DdcSlave == Slave && DdcLength == 1 && DdcStop == FALSE);
+	*Buffer = DdcBuf[0] ^ 0xFF;
+	return XST_SUCCESS;
+}
+
+static void test_ddc(void)
+{
+	XV_HdmiTx Tx;
+	u8 Data;
+
+	memset(&Tx, 0, sizeof(Tx));
+	CHECK(XV_HdmiTx_FrlDdcScdcWrite(&Tx, XV_HDMITX_FRL_SCDC_CONFIG_1,
+					0x36) == XST_SUCCESS);
+	CHECK(DdcSlave == XV_HDMITX_FRL_SCDC_SLAVE && DdcLength == 2);
+	CHECK(DdcBuf[0] == XV_HDMITX_FRL_SCDC_CONFIG_1 && DdcBuf[1] == 0x36);
+	CHECK(DdcStop == TRUE);
+
+	CHECK(XV_HdmiTx_FrlDdcScdcRead(&Tx, XV_HDMITX_FRL_SCDC_UPDATE_0,
+				       &Data) == XST_SUCCESS);
+	CHECK(Data == (XV_HDMITX_FRL_SCDC_UPDATE_0 ^ 0xFF));
+}
+
+int main(void)
+{
+	test_initialize();
+	test_edid();
+	test_train();
+	test_ffe();
+	test_rate_fallback();
+	test_timeouts();
+	test_retrain();
+	test_cache();
+	test_legacy();
+	test_ddc();
+
+	return host_report("frl");
+}
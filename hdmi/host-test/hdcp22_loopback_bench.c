@@ -0,0 +1,437 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file hdcp22_loopback_bench.c
+*
+* Runs the HDCP 2.2 loopback self-test (xhdcp22_loopback.c) on the host and
+* prints its timings. The TX and RX drivers run unmodified on register
+* blocks in memory, with the software Montgomery multiplier and with the
+* timers on the hrtimer backend of the XTmrCtr software mode, over the real
+* host clock.
+*
+* The DCP LLC key is replaced through the test hooks of the TX driver by a
+* host generated 3072-bit key (six 512-bit primes, e = 3), which signs the
+* receiver certificate and the SRM. The receiver key is a host generated
+* 1024-bit key with e = 65537.
+*
+* Checks an RSAES-OAEP round trip through the receiver key, that all test
+* vectors pass, that the status callbacks of both instances are not called
+* while connected and that the handlers of both instances are restored on
+* release.
+*
+* Usage: hdcp22_loopback_bench [iterations], every test vector runs
+* iterations times, 1 by default.
+*
+******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <linux/kernel.h>
+#include "bigdigits.h"
+#include "xhdcp22_tx.h"
+#include "xhdcp22_tx_i.h"
+#include "xhdcp22_rx.h"
+#include "xhdcp22_rx_i.h"
+#include "xhdcp22_cipher_hw.h"
+#include "xhdcp22_rng_hw.h"
+#include "xhdcp22_common.h"
+#include "xhdcp22_loopback.h"
+#include "xtmrctr_hrtimer.h"
+#include "host.h"
+
+#define PRIME_DIGITS	(512 / 32)
+#define DCP_PRIMES	6
+#define DCP_DIGITS	(DCP_PRIMES * PRIME_DIGITS)
+#define RX_DIGITS	(2 * PRIME_DIGITS)
+
+/* Register map of a TX or RX instance, the sub-core offsets are or'ed in */
+#define CORE_SIZE	0x10000
+#define CIPHER_OFFSET	0x1000
+#define RNG_OFFSET	0x2000
+#define MMULT_OFFSET	0x3000
+#define TIMER_OFFSET	0x4000
+
+#define TX_TIMER_ID	0
+#define RX_TIMER_ID	1
+
+/* Configuration tables, as defined by phy-vphy.c */
+XTmrCtr_Config XTmrCtr_ConfigTable[XPAR_XTMRCTR_NUM_INSTANCES] = {
+	{ TX_TIMER_ID, TIMER_OFFSET, 100000000 },
+	{ RX_TIMER_ID, TIMER_OFFSET, 100000000 },
+};
+XHdcp22_Cipher_Config XHdcp22_Cipher_ConfigTable[XPAR_XHDCP22_CIPHER_NUM_INSTANCES] = {
+	{ 0, CIPHER_OFFSET },
+};
+XHdcp22_mmult_Config XHdcp22_mmult_ConfigTable[XPAR_XHDCP22_MMULT_NUM_INSTANCES] = {
+	{ 0, MMULT_OFFSET },
+};
+XHdcp22_Rng_Config XHdcp22_Rng_ConfigTable[XPAR_XHDCP22_RNG_NUM_INSTANCES] = {
+	{ 0, RNG_OFFSET },
+};
+XHdcp22_Rx_Config XHdcp22_Rx_ConfigTable[XPAR_XHDCP22_RX_NUM_INSTANCES] = {
+	{ 0, 0, XHDCP22_RX_HDMI, XHDCP22_RX_RECEIVER, RX_TIMER_ID, 0, 0, 0 },
+};
+XHdcp22_Tx_Config XHdcp22_Tx_ConfigTable[XPAR_XHDCP22_TX_NUM_INSTANCES] = {
+	{ 0, 0, XHDCP22_TX_HDMI, XHDCP22_TX_TRANSMITTER, TX_TIMER_ID, 0, 0 },
+};
+
+static u8 kpub_dcp[XHDCP22_TX_KPUB_DCP_LLC_N_SIZE +
+		   XHDCP22_TX_KPUB_DCP_LLC_E_SIZE];
+static u32 dcp_n[DCP_DIGITS], dcp_d[DCP_DIGITS];
+
+static u8 lc128[XHDCP22_RX_LC128_SIZE];
+static XHdcp22_Rx_CertRx cert_rx;
+static XHdcp22_Rx_KprivRx kpriv_rx;
+
+/* First-generation SRM revoking one device that is not the receiver */
+#define SRM_HEADER_SIZE	12
+#define SRM_SIZE	(SRM_HEADER_SIZE + XHDCP22_TX_SRM_RCVID_SIZE + \
+			 XHDCP22_TX_SRM_SIGNATURE_SIZE)
+static u8 srm[SRM_SIZE];
+
+static const u8 receiver_id[XHDCP22_RX_RCVID_SIZE] = {
+	0x8F, 0x0F, 0xA5, 0x5A, 0x33
+};
+static const u8 revoked_id[XHDCP22_TX_SRM_RCVID_SIZE] = {
+	0x0F, 0x8F, 0x5A, 0xA5, 0x33
+};
+
+/* Test hooks of the TX driver, only the DCP LLC key is replaced */
+u8 XHdcp22Tx_TestSimulateTimeout(XHdcp22_Tx *InstancePtr)
+{
+	return FALSE;
+}
+
+void XHdcp22Tx_TestGenerateRtx(XHdcp22_Tx *InstancePtr, u8 *RtxPtr) {}
+void XHdcp22Tx_TestGenerateKm(XHdcp22_Tx *InstancePtr, u8 *KmPtr) {}
+void XHdcp22Tx_TestGenerateKmMaskingSeed(XHdcp22_Tx *InstancePtr,
+					 u8 *SeedPtr) {}
+void XHdcp22Tx_TestGenerateRn(XHdcp22_Tx *InstancePtr, u8 *RnPtr) {}
+void XHdcp22Tx_TestGenerateRiv(XHdcp22_Tx *InstancePtr, u8 *RivPtr) {}
+void XHdcp22Tx_TestGenerateKs(XHdcp22_Tx *InstancePtr, u8 *KsPtr) {}
+void XHdcp22Tx_LogDisplayUnitTest(XHdcp22_Tx *InstancePtr) {}
+
+const u8 *XHdcp22Tx_TestGetKPubDpc(XHdcp22_Tx *InstancePtr)
+{
+	return kpub_dcp;
+}
+
+static void rand_bytes(u8 *p, size_t n)
+{
+	while (n--)
+		*p++ = (u8)host_rand();
+}
+
+/* Miller-Rabin with the first prime bases, n odd */
+static int is_probable_prime(u32 n[], size_t ndigits)
+{
+	static const u32 bases[] = { 2, 3, 5, 7, 11, 13, 17, 19 };
+	u32 nm1[PRIME_DIGITS], d[PRIME_DIGITS], a[PRIME_DIGITS], y[PRIME_DIGITS];
+	u32 ws[mpMODEXP_WORKSPACE_DIGITS(PRIME_DIGITS)];
+	size_t s = 0, r, i;
+
+	mpSetDigit(a, 1, ndigits);
+	mpSubtract(nm1, n, a, ndigits);
+	mpSetEqual(d, nm1, ndigits);
+	while (!(d[0] & 1)) {
+		mpShiftRight(d, d, 1, ndigits);
+		s++;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(bases); i++) {
+		mpSetDigit(a, bases[i], ndigits);
+		mpModExpMont(y, a, d, n, ndigits, ws);
+		if (mpShortCmp(y, 1, ndigits) == 0 || mpEqual(y, nm1, ndigits))
+			continue;
+		for (r = 1; r < s; r++) {
+			mpModMult(y, y, y, n, ndigits);
+			if (mpEqual(y, nm1, ndigits))
+				break;
+		}
+		if (r == s)
+			return 0;
+	}
+	return 1;
+}
+
+/*
+ * Random 512-bit prime with the top four bits set, so products of them have
+ * the full size, and with gcd(e, p - 1) = 1 for the prime e.
+ */
+static void random_prime(u32 p[], u32 e)
+{
+	u32 q[PRIME_DIGITS];
+	u32 sp;
+	int composite;
+
+	for (;;) {
+		rand_bytes((u8 *)p, PRIME_DIGITS * 4);
+		p[PRIME_DIGITS - 1] |= 0xF0000000;
+		p[0] |= 1;
+		if (mpShortDiv(q, p, e, PRIME_DIGITS) == 1)
+			continue;
+		composite = 0;
+		for (sp = 3; sp < 2000 && !composite; sp += 2)
+			composite = mpShortDiv(q, p, sp, PRIME_DIGITS) == 0;
+		if (!composite && is_probable_prime(p, PRIME_DIGITS))
+			return;
+	}
+}
+
+/* EMSA-PKCS1-v1_5 with SHA-256 and s = EM^d mod n, 3072-bit */
+static void dcp_sign(const u8 *msg, u32 len, u8 *sig)
+{
+	static const u8 digest_info[] = {
+		0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+		0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20
+	};
+	u8 em[XHDCP22_TX_CERT_SIGNATURE_SIZE];
+	u32 m[DCP_DIGITS], s[DCP_DIGITS];
+	u32 ws[mpMODEXP_WORKSPACE_DIGITS(DCP_DIGITS)];
+
+	em[0] = 0x00;
+	em[1] = 0x01;
+	memset(&em[2], 0xFF, 330);
+	em[332] = 0x00;
+	memcpy(&em[333], digest_info, sizeof(digest_info));
+	XHdcp22Cmn_Sha256Hash(msg, len, &em[352]);
+
+	mpConvFromOctets(m, DCP_DIGITS, em, sizeof(em));
+	mpModExpMont(s, m, dcp_d, dcp_n, DCP_DIGITS, ws);
+	mpConvToOctets(s, DCP_DIGITS, sig, XHDCP22_TX_CERT_SIGNATURE_SIZE);
+}
+
+/* DCP LLC stand-in, n is the product of six primes and e = 3 */
+static void make_dcp_key(void)
+{
+	u32 p[PRIME_DIGITS], pm1[PRIME_DIGITS], one[PRIME_DIGITS];
+	u32 a[DCP_DIGITS], b[DCP_DIGITS], w[2 * DCP_DIGITS];
+	u32 phi[DCP_DIGITS], e[DCP_DIGITS];
+	int i;
+
+	mpSetDigit(one, 1, PRIME_DIGITS);
+	mpSetDigit(dcp_n, 1, DCP_DIGITS);
+	mpSetDigit(phi, 1, DCP_DIGITS);
+	for (i = 0; i < DCP_PRIMES; i++) {
+		random_prime(p, 3);
+		mpSubtract(pm1, p, one, PRIME_DIGITS);
+
+		mpSetZero(a, DCP_DIGITS);
+		mpSetEqual(a, p, PRIME_DIGITS);
+		mpMultiply(w, dcp_n, a, DCP_DIGITS);
+		mpSetEqual(dcp_n, w, DCP_DIGITS);
+
+		mpSetZero(b, DCP_DIGITS);
+		mpSetEqual(b, pm1, PRIME_DIGITS);
+		mpMultiply(w, phi, b, DCP_DIGITS);
+		mpSetEqual(phi, w, DCP_DIGITS);
+	}
+
+	mpSetDigit(e, 3, DCP_DIGITS);
+	mpModInv(dcp_d, e, phi, DCP_DIGITS);
+
+	mpConvToOctets(dcp_n, DCP_DIGITS, kpub_dcp,
+		       XHDCP22_TX_KPUB_DCP_LLC_N_SIZE);
+	kpub_dcp[XHDCP22_TX_KPUB_DCP_LLC_N_SIZE] = 3;
+}
+
+/* Receiver key in the CRT form of XHdcp22_Rx_KprivRx, p > q */
+static void make_rx_key(void)
+{
+	u32 p[RX_DIGITS], q[RX_DIGITS], pm1[RX_DIGITS], qm1[RX_DIGITS];
+	u32 one[RX_DIGITS], n[2 * RX_DIGITS], phi[2 * RX_DIGITS];
+	u32 e[RX_DIGITS], d[RX_DIGITS], t[RX_DIGITS];
+
+	mpSetZero(p, RX_DIGITS);
+	mpSetZero(q, RX_DIGITS);
+	random_prime(p, 65537);
+	do {
+		random_prime(q, 65537);
+	} while (mpEqual(p, q, PRIME_DIGITS));
+	if (mpCompare(p, q, PRIME_DIGITS) < 0) {
+		mpSetEqual(t, p, PRIME_DIGITS);
+		mpSetEqual(p, q, PRIME_DIGITS);
+		mpSetEqual(q, t, PRIME_DIGITS);
+	}
+
+	mpSetDigit(one, 1, RX_DIGITS);
+	mpSubtract(pm1, p, one, RX_DIGITS);
+	mpSubtract(qm1, q, one, RX_DIGITS);
+	mpMultiply(n, p, q, RX_DIGITS);
+	mpMultiply(phi, pm1, qm1, RX_DIGITS);
+	mpSetDigit(e, 65537, RX_DIGITS);
+	mpModInv(d, e, phi, RX_DIGITS);
+
+	mpConvToOctets(p, PRIME_DIGITS, kpriv_rx.p, XHDCP22_RX_P_SIZE);
+	mpConvToOctets(q, PRIME_DIGITS, kpriv_rx.q, XHDCP22_RX_P_SIZE);
+	mpModulo(t, d, RX_DIGITS, pm1, PRIME_DIGITS);
+	mpConvToOctets(t, PRIME_DIGITS, kpriv_rx.dp, XHDCP22_RX_P_SIZE);
+	mpModulo(t, d, RX_DIGITS, qm1, PRIME_DIGITS);
+	mpConvToOctets(t, PRIME_DIGITS, kpriv_rx.dq, XHDCP22_RX_P_SIZE);
+	mpModInv(t, q, p, PRIME_DIGITS);
+	mpConvToOctets(t, PRIME_DIGITS, kpriv_rx.qinv, XHDCP22_RX_P_SIZE);
+
+	memcpy(cert_rx.ReceiverId, receiver_id, sizeof(receiver_id));
+	mpConvToOctets(n, RX_DIGITS, cert_rx.KpubRx, XHDCP22_RX_N_SIZE);
+	cert_rx.KpubRx[XHDCP22_RX_N_SIZE + 0] = 0x01;
+	cert_rx.KpubRx[XHDCP22_RX_N_SIZE + 1] = 0x00;
+	cert_rx.KpubRx[XHDCP22_RX_N_SIZE + 2] = 0x01;
+	dcp_sign((u8 *)&cert_rx, offsetof(XHdcp22_Rx_CertRx, Signature),
+		 cert_rx.Signature);
+}
+
+static void make_srm(void)
+{
+	u32 len = SRM_SIZE - 5;
+
+	srm[0] = 0x91;		/* SRM ID, HDCP2 indicator */
+	srm[3] = 0x01;		/* SRM version */
+	srm[4] = 0x01;		/* one generation */
+	srm[5] = len >> 16;
+	srm[6] = len >> 8;
+	srm[7] = len;
+	srm[9] = 0x40;		/* one device, 10-bit field */
+	memcpy(&srm[SRM_HEADER_SIZE], revoked_id, sizeof(revoked_id));
+	dcp_sign(srm, SRM_SIZE - XHDCP22_TX_SRM_SIGNATURE_SIZE,
+		 &srm[SRM_SIZE - XHDCP22_TX_SRM_SIGNATURE_SIZE]);
+}
+
+/* An instance and its sub-cores, at or'able addresses */
+static UINTPTR alloc_core(void)
+{
+	u8 *base = aligned_alloc(CORE_SIZE, CORE_SIZE);
+
+	memset(base, 0, CORE_SIZE);
+	*(u32 *)(base + CIPHER_OFFSET + XHDCP22_CIPHER_VER_ID_OFFSET) =
+		XHDCP22_CIPHER_VER_ID << 16;
+	*(u32 *)(base + RNG_OFFSET + XHDCP22_RNG_VER_ID_OFFSET) =
+		XHDCP22_RNG_VER_ID << 16;
+	return (UINTPTR)base;
+}
+
+/* Timer service of the drivers, without their locks */
+static void timer_service(void *ref, XTmrCtr *TmrCtrPtr)
+{
+	XTmrCtr_InterruptHandler(TmrCtrPtr);
+}
+
+static int status_calls;
+
+static void status_callback(void *ref)
+{
+	status_calls++;
+}
+
+static int ddc_stub(u8 DeviceAddress, u16 ByteCount, u8 *BufferPtr, u8 Stop,
+		    void *RefPtr)
+{
+	return XST_FAILURE;
+}
+
+int main(int argc, char **argv)
+{
+	static XHdcp22_Tx tx;
+	static XHdcp22_Rx rx;
+	static XHdcp22_Loopback loopback;
+	static XTmrCtr_HrTimer tx_timer, rx_timer;
+	static char log[4096];
+	XHdcp22_Rx_Handles rx_handles;
+	u8 km[XHDCP22_RX_KM_SIZE], km_out[XHDCP22_RX_N_SIZE];
+	u8 seed[XHDCP22_RX_HASH_SIZE], ekpub_km[XHDCP22_RX_N_SIZE];
+	int km_len;
+	u32 iterations = argc > 1 ? strtoul(argv[1], NULL, 0) : 1;
+	UINTPTR tx_base, rx_base;
+	u64 t;
+
+	t = host_ns();
+	make_dcp_key();
+	make_rx_key();
+	make_srm();
+	rand_bytes(lc128, sizeof(lc128));
+	printf("hdcp22_loopback: keys generated in %llu ms\n",
+	       (host_ns() - t) / 1000000);
+
+	XTmrCtr_HrTimerInitialize(&tx_timer, &XTmrCtr_ConfigTable[TX_TIMER_ID],
+				  timer_service, NULL);
+	XTmrCtr_HrTimerInitialize(&rx_timer, &XTmrCtr_ConfigTable[RX_TIMER_ID],
+				  timer_service, NULL);
+
+	/* As XV_HdmiTxSs_SubcoreInitHdcp22 and XV_HdmiRxSs_SubcoreInitHdcp22 */
+	tx_base = alloc_core();
+	if (XHdcp22Tx_CfgInitialize(&tx, &XHdcp22_Tx_ConfigTable[0],
+				    tx_base) != XST_SUCCESS) {
+		printf("hdcp22_loopback: TX initialization failed\n");
+		return 1;
+	}
+	XHdcp22Tx_SetCallback(&tx, XHDCP22_TX_HANDLER_DDC_WRITE,
+			      (void *)ddc_stub, NULL);
+	XHdcp22Tx_SetCallback(&tx, XHDCP22_TX_HANDLER_DDC_READ,
+			      (void *)ddc_stub, NULL);
+	XHdcp22Tx_SetCallback(&tx, XHDCP22_TX_HANDLER_AUTHENTICATED,
+			      (void *)status_callback, NULL);
+	XHdcp22Tx_SetCallback(&tx, XHDCP22_TX_HANDLER_UNAUTHENTICATED,
+			      (void *)status_callback, NULL);
+	XHdcp22Tx_SetMessagePollingValue(&tx, 10);
+	XHdcp22Tx_LoadLc128(&tx, lc128);
+	CHECK(XHdcp22Tx_LoadRevocationTable(&tx, srm) == XST_SUCCESS);
+	CHECK(tx.RevocationList.NumDevices == 1);
+
+	rx_base = alloc_core();
+	if (XHdcp22Rx_CfgInitialize(&rx, &XHdcp22_Rx_ConfigTable[0],
+				    rx_base) != XST_SUCCESS) {
+		printf("hdcp22_loopback: RX initialization failed\n");
+		return 1;
+	}
+	XHdcp22Rx_SetCallback(&rx, XHDCP22_RX_HANDLER_AUTHENTICATED,
+			      (void *)status_callback, NULL);
+	XHdcp22Rx_SetCallback(&rx, XHDCP22_RX_HANDLER_UNAUTHENTICATED,
+			      (void *)status_callback, NULL);
+	XHdcp22Rx_LoadLc128(&rx, lc128);
+	XHdcp22Rx_LoadPublicCert(&rx, (u8 *)&cert_rx);
+	CHECK(XHdcp22Rx_LoadPrivateKey(&rx, (u8 *)&kpriv_rx) == XST_SUCCESS);
+	memcpy(&rx_handles, &rx.Handles, sizeof(rx_handles));
+
+	/* RSAES-OAEP round trip through the receiver key */
+	rand_bytes(km, sizeof(km));
+	rand_bytes(seed, sizeof(seed));
+	CHECK(XHdcp22Rx_RsaesOaepEncrypt(&rx,
+			(XHdcp22_Rx_KpubRx *)cert_rx.KpubRx, km, sizeof(km),
+			seed, ekpub_km) == XST_SUCCESS);
+	CHECK(XHdcp22Rx_RsaesOaepDecrypt(&rx, &kpriv_rx, ekpub_km, km_out,
+					 &km_len) == XST_SUCCESS);
+	CHECK(km_len == sizeof(km) && memcmp(km, km_out, sizeof(km)) == 0);
+
+	CHECK(XHdcp22Loopback_Initialize(&loopback, &tx, &rx) == XST_SUCCESS);
+	CHECK(XHdcp22Loopback_SelfTest(&loopback, iterations) == XST_SUCCESS);
+	CHECK(loopback.Stats.VectorsFailed == 0);
+	CHECK(status_calls == 0);
+	XHdcp22Loopback_StatsShow(&loopback, log, sizeof(log));
+	fputs(log, stdout);
+	XHdcp22Loopback_Release(&loopback);
+
+	CHECK(tx.DdcRead == ddc_stub && tx.DdcWrite == ddc_stub);
+	CHECK(tx.IsAuthenticatedCallbackSet && tx.IsUnauthenticatedCallbackSet);
+	CHECK(!tx.Info.IsEnabled && !XHdcp22Rx_IsEnabled(&rx));
+	CHECK(memcmp(&rx_handles, &rx.Handles, sizeof(rx_handles)) == 0);
+
+	XTmrCtr_HrTimerRelease(&tx_timer);
+	XTmrCtr_HrTimerRelease(&rx_timer);
+	free((void *)tx_base);
+	free((void *)rx_base);
+
+	return host_report("hdcp22_loopback");
+}
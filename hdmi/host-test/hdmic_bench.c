@@ -0,0 +1,116 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file hdmic_bench.c
+*
+* Microbenchmark of the infoframe parsers and generators of xv_hdmic.c. It
+* reports ns/packet of the current code and of the reference code of
+* hdmic_ref.c for each input, e.g. the packets of corpus/:
+*
+*   hdmic_bench iterations [file|dir]...
+*
+******************************************************************************/
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hdmic_ref.h"
+#include "host.h"
+
+static u32 Iterations;
+
+static void bench_file(const char *Path)
+{
+	u8 Buf[1 + 2 * HDMIC_OP_MAX_SIZE];
+	u64 In[HDMIC_OP_MAX_SIZE / sizeof(u64)];
+	u64 Out[HDMIC_OP_MAX_SIZE / sizeof(u64)];
+	const hdmic_op *Op;
+	const char *Name;
+	u64 t0, t1, t2;
+	size_t Size;
+	FILE *File;
+	u32 Index;
+
+	File = fopen(Path, "rb");
+	if (!File) {
+		printf("%s: cannot open\n", Path);
+		host_failures++;
+		return;
+	}
+	Size = fread(Buf, 1, sizeof(Buf), File);
+	fclose(File);
+
+	Op = hdmic_decode(Buf, Size, In, Out);
+	if (!Op)
+		return;
+
+	t0 = host_ns();
+	for (Index = 0; Index < Iterations; Index++)
+		Op->New(In, Out);
+	t1 = host_ns();
+	for (Index = 0; Index < Iterations; Index++)
+		Op->Ref(In, Out);
+	t2 = host_ns();
+
+	Name = strrchr(Path, '/');
+	printf("%-40s %-29s %6.1f %6.1f ns/packet\n", Name ? Name + 1 : Path,
+	       Op->Name, (double)(t1 - t0) / Iterations,
+	       (double)(t2 - t1) / Iterations);
+}
+
+static void bench_path(const char *Path)
+{
+	char File[512];
+	struct dirent **List;
+	int Count;
+	int Index;
+
+	Count = scandir(Path, &List, NULL, alphasort);
+	if (Count < 0) {
+		bench_file(Path);
+		return;
+	}
+	for (Index = 0; Index < Count; Index++) {
+		if (List[Index]->d_name[0] != '.') {
+			snprintf(File, sizeof(File), "%s/%s", Path,
+				 List[Index]->d_name);
+			bench_file(File);
+		}
+		free(List[Index]);
+	}
+	free(List);
+}
+
+int main(int argc, char **argv)
+{
+	int Arg;
+
+	if (argc < 3) {
+		printf("usage: %s iterations [file|dir]...\n", argv[0]);
+		return 2;
+	}
+	Iterations = strtoul(argv[1], NULL, 0);
+	if (!Iterations)
+		Iterations = 1;
+
+	printf("%-40s %-29s %6s %6s\n", "input", "operation", "new", "ref");
+	for (Arg = 2; Arg < argc; Arg++)
+		bench_path(argv[Arg]);
+
+	return host_report("hdmic_bench");
+}
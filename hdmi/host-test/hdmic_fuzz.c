@@ -0,0 +1,150 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file hdmic_fuzz.c
+*
+* Fuzz harness checking that the infoframe parsers and generators of
+* xv_hdmic.c are bit-exact with the reference code of hdmic_ref.c. The
+* first input byte selects the operation, see hdmic_run().
+*
+* Built with -DHDMIC_LIBFUZZER it is a libFuzzer target (make fuzz). Else
+* it runs the inputs given on the command line, files or directories such
+* as corpus/, followed by random inputs (make check):
+*
+*   hdmic_fuzz [-n random-inputs] [file|dir]...
+*
+* The seeds in corpus/ are AUX packets of common streams (AVI, audio, audio
+* metadata, SPD and DRM infoframes, general control packets and a VSIF), in
+* the layout XV_HdmiRx_GetAux reads them: 7 packet bytes and an ECC byte
+* per data word, ECC zeroed. The gen-* seeds are the same packets parsed,
+* as inputs of the generators.
+*
+******************************************************************************/
+
+#include <stdlib.h>
+#include "hdmic_ref.h"
+
+int LLVMFuzzerTestOneInput(const u8 *Data, size_t Size)
+{
+	if (hdmic_run(Data, Size))
+		abort();
+	return 0;
+}
+
+#ifndef HDMIC_LIBFUZZER
+
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+#include "host.h"
+
+static u32 Inputs;
+
+static void run_file(const char *Path)
+{
+	u8 Buf[1 + 2 * HDMIC_OP_MAX_SIZE];
+	size_t Size;
+	FILE *File;
+
+	File = fopen(Path, "rb");
+	if (!File) {
+		printf("%s: cannot open\n", Path);
+		host_failures++;
+		return;
+	}
+	Size = fread(Buf, 1, sizeof(Buf), File);
+	fclose(File);
+
+	Inputs++;
+	if (hdmic_run(Buf, Size)) {
+		printf("  from %s\n", Path);
+		host_failures++;
+	}
+}
+
+static void run_path(const char *Path)
+{
+	char File[512];
+	struct dirent *Entry;
+	DIR *Dir;
+
+	Dir = opendir(Path);
+	if (!Dir) {
+		run_file(Path);
+		return;
+	}
+	while ((Entry = readdir(Dir))) {
+		if (Entry->d_name[0] == '.')
+			continue;
+		snprintf(File, sizeof(File), "%s/%s", Path, Entry->d_name);
+		run_file(File);
+	}
+	closedir(Dir);
+}
+
+/* Random inputs, half of the packets get the type the parser expects */
+static void run_random(u32 Count)
+{
+	static const u8 Type[] = {
+		AUX_AVI_INFOFRAME_TYPE, AUX_GENERAL_CONTROL_PACKET_TYPE,
+		AUX_AUDIO_INFOFRAME_TYPE, AUX_AUDIO_METADATA_PACKET_TYPE,
+		AUX_SPD_INFOFRAME_TYPE, AUX_DRM_INFOFRAME_TYPE
+	};
+	u8 Buf[1 + 2 * HDMIC_OP_MAX_SIZE];
+	u32 Index;
+	u32 Byte;
+
+	for (Index = 0; Index < Count; Index++) {
+		for (Byte = 0; Byte < sizeof(Buf); Byte++) {
+			/* Mostly small values, as in real packets */
+			Buf[Byte] = host_rand() & 1 ? host_rand() :
+				    host_rand() & 3;
+		}
+		Buf[0] %= hdmic_num_ops;
+		if (Buf[0] < sizeof(Type) && host_rand() & 1)
+			Buf[1] = Type[Buf[0]];
+
+		Inputs++;
+		if (hdmic_run(Buf, sizeof(Buf)) && host_failures++ > 10)
+			return;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	u32 Count = 0;
+	u32 Index;
+	int Arg;
+
+	for (Index = 0; Index < hdmic_num_ops; Index++) {
+		CHECK(hdmic_ops[Index].InSize <= HDMIC_OP_MAX_SIZE);
+		CHECK(hdmic_ops[Index].OutSize <= HDMIC_OP_MAX_SIZE);
+	}
+
+	for (Arg = 1; Arg < argc; Arg++) {
+		if (!strcmp(argv[Arg], "-n") && Arg + 1 < argc)
+			Count = strtoul(argv[++Arg], NULL, 0);
+		else
+			run_path(argv[Arg]);
+	}
+	run_random(Count);
+
+	printf("hdmic_fuzz: %u inputs\n", Inputs);
+	return host_report("hdmic");
+}
+
+#endif /* HDMIC_LIBFUZZER */
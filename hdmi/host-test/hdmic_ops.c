@@ -0,0 +1,151 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file hdmic_ops.c
+*
+* The operations of hdmic_ref.h and the bit-exact comparison of the current
+* xv_hdmic.c code with the reference.
+*
+******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <linux/kernel.h>
+#include "hdmic_ref.h"
+
+#define HDMIC_PARSE(Name, Type)						\
+static void New_##Name(void *In, void *Out)				\
+{									\
+	XV_HdmiC_##Name(In, Out);					\
+}									\
+static void Ref_##Name(void *In, void *Out)				\
+{									\
+	Ref_XV_HdmiC_##Name(In, Out);					\
+}
+
+#define HDMIC_GENERATE(Name, Type)					\
+static void New_##Name(void *In, void *Out)				\
+{									\
+	*(XHdmiC_Aux *)Out = XV_HdmiC_##Name(In);			\
+}									\
+static void Ref_##Name(void *In, void *Out)				\
+{									\
+	*(XHdmiC_Aux *)Out = Ref_XV_HdmiC_##Name(In);			\
+}
+
+HDMIC_PARSE(ParseAVIInfoFrame, XHdmiC_AVI_InfoFrame)
+HDMIC_PARSE(ParseGCP, XHdmiC_GeneralControlPacket)
+HDMIC_PARSE(ParseAudioInfoFrame, XHdmiC_AudioInfoFrame)
+HDMIC_PARSE(ParseAudioMetadata, XHdmiC_AudioMetadata)
+HDMIC_PARSE(ParseSPDIF, XHdmiC_SPDInfoFrame)
+HDMIC_PARSE(ParseDRMIF, struct v4l2_hdr10_payload)
+HDMIC_GENERATE(AVIIF_GeneratePacket, XHdmiC_AVI_InfoFrame)
+HDMIC_GENERATE(AudioIF_GeneratePacket, XHdmiC_AudioInfoFrame)
+HDMIC_GENERATE(AudioMetadata_GeneratePacket, XHdmiC_AudioMetadata)
+HDMIC_GENERATE(SPDIF_GeneratePacket, XHdmiC_SPDInfoFrame)
+/* Fills the XHdmiC_Aux passed in */
+HDMIC_PARSE(DRMIF_GeneratePacket, struct v4l2_hdr10_payload)
+
+#define HDMIC_OP_PARSE(Name, Type)					\
+	{ #Name, sizeof(XHdmiC_Aux), sizeof(Type), New_##Name, Ref_##Name }
+#define HDMIC_OP_GENERATE(Name, Type)					\
+	{ #Name, sizeof(Type), sizeof(XHdmiC_Aux), New_##Name, Ref_##Name }
+
+/* The order defines the first byte of the fuzz inputs, only append */
+const hdmic_op hdmic_ops[] = {
+	HDMIC_OP_PARSE(ParseAVIInfoFrame, XHdmiC_AVI_InfoFrame),
+	HDMIC_OP_PARSE(ParseGCP, XHdmiC_GeneralControlPacket),
+	HDMIC_OP_PARSE(ParseAudioInfoFrame, XHdmiC_AudioInfoFrame),
+	HDMIC_OP_PARSE(ParseAudioMetadata, XHdmiC_AudioMetadata),
+	HDMIC_OP_PARSE(ParseSPDIF, XHdmiC_SPDInfoFrame),
+	HDMIC_OP_PARSE(ParseDRMIF, struct v4l2_hdr10_payload),
+	HDMIC_OP_GENERATE(AVIIF_GeneratePacket, XHdmiC_AVI_InfoFrame),
+	HDMIC_OP_GENERATE(AudioIF_GeneratePacket, XHdmiC_AudioInfoFrame),
+	HDMIC_OP_GENERATE(AudioMetadata_GeneratePacket, XHdmiC_AudioMetadata),
+	HDMIC_OP_GENERATE(SPDIF_GeneratePacket, XHdmiC_SPDInfoFrame),
+	{ "DRMIF_GeneratePacket", sizeof(struct v4l2_hdr10_payload),
+	  sizeof(XHdmiC_Aux), New_DRMIF_GeneratePacket,
+	  Ref_DRMIF_GeneratePacket },
+};
+
+const u32 hdmic_num_ops = ARRAY_SIZE(hdmic_ops);
+
+/* Aligned for the structures of the operations */
+typedef union {
+	u8 Byte[HDMIC_OP_MAX_SIZE];
+	u64 Align;
+} hdmic_buf;
+
+static void hdmic_dump(const char *What, const u8 *Buf, u32 Size)
+{
+	u32 Index;
+
+	printf("  %s:", What);
+	for (Index = 0; Index < Size; Index++)
+		printf(" %02x", Buf[Index]);
+	printf("\n");
+}
+
+const hdmic_op *hdmic_decode(const u8 *Data, size_t Size, void *In,
+			     void *Out)
+{
+	const hdmic_op *Op;
+	size_t Len;
+
+	if (Size < 1)
+		return NULL;
+	Op = &hdmic_ops[Data[0] % hdmic_num_ops];
+	Data++;
+	Size--;
+
+	memset(In, 0, HDMIC_OP_MAX_SIZE);
+	Len = Size < Op->InSize ? Size : Op->InSize;
+	memcpy(In, Data, Len);
+	Data += Len;
+	Size -= Len;
+
+	memset(Out, 0, HDMIC_OP_MAX_SIZE);
+	Len = Size < Op->OutSize ? Size : Op->OutSize;
+	memcpy(Out, Data, Len);
+
+	return Op;
+}
+
+int hdmic_run(const u8 *Data, size_t Size)
+{
+	const hdmic_op *Op;
+	hdmic_buf In[2], Out[2];
+
+	Op = hdmic_decode(Data, Size, In[0].Byte, Out[0].Byte);
+	if (!Op)
+		return 0;
+	In[1] = In[0];
+	Out[1] = Out[0];
+
+	Op->New(In[0].Byte, Out[0].Byte);
+	Op->Ref(In[1].Byte, Out[1].Byte);
+
+	if (!memcmp(In[0].Byte, In[1].Byte, Op->InSize) &&
+	    !memcmp(Out[0].Byte, Out[1].Byte, Op->OutSize))
+		return 0;
+
+	printf("%s: mismatch\n", Op->Name);
+	hdmic_dump("in ", In[1].Byte, Op->InSize);
+	hdmic_dump("new", Out[0].Byte, Op->OutSize);
+	hdmic_dump("ref", Out[1].Byte, Op->OutSize);
+	return -1;
+}
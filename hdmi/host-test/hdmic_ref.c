@@ -0,0 +1,735 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2018 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file hdmic_ref.c
+*
+* Reference copy of the field by field infoframe parsers and generators of
+* xv_hdmic.c as they were before the descriptor table rewrite, renamed with
+* a Ref_ prefix. hdmic_fuzz and hdmic_bench check that the current code is
+* bit-exact with these. Keep this file unchanged.
+*
+******************************************************************************/
+
+/******************************* Include Files ********************************/
+#include <linux/string.h>
+#include "xv_hdmic.h"
+#include "hdmic_ref.h"
+
+/*************************** Function Definitions *****************************/
+/**
+*
+* This function retrieves the Auxiliary Video Information Info Frame.
+*
+* @param  None.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+void Ref_XV_HdmiC_ParseAVIInfoFrame(XHdmiC_Aux *AuxPtr, XHdmiC_AVI_InfoFrame *infoFramePtr)
+{
+	if (AuxPtr->Header.Byte[0] == AUX_AVI_INFOFRAME_TYPE) {
+
+		/* Header, Version */
+		infoFramePtr->Version = AuxPtr->Header.Byte[1];
+
+		/* PB1 */
+		infoFramePtr->ColorSpace = (AuxPtr->Data.Byte[1] >> 5) & 0x7;
+		infoFramePtr->ActiveFormatDataPresent = (AuxPtr->Data.Byte[1] >> 4) & 0x1;
+		infoFramePtr->BarInfo = (AuxPtr->Data.Byte[1] >> 2) & 0x3;
+		infoFramePtr->ScanInfo = AuxPtr->Data.Byte[1] & 0x3;
+
+		/* PB2 */
+		infoFramePtr->Colorimetry = (AuxPtr->Data.Byte[2] >> 6) & 0x3;
+		infoFramePtr->PicAspectRatio = (AuxPtr->Data.Byte[2] >> 4) & 0x3;
+		infoFramePtr->ActiveAspectRatio = AuxPtr->Data.Byte[2] & 0xf;
+
+		/* PB3 */
+		infoFramePtr->Itc = (AuxPtr->Data.Byte[3] >> 7) & 0x1;
+		infoFramePtr->ExtendedColorimetry = (AuxPtr->Data.Byte[3] >> 4) & 0x7;
+		infoFramePtr->QuantizationRange = (AuxPtr->Data.Byte[3] >> 2) & 0x3;
+		infoFramePtr->NonUniformPictureScaling = AuxPtr->Data.Byte[3] & 0x3;
+
+		/* PB4 */
+		infoFramePtr->VIC = AuxPtr->Data.Byte[4] & 0x7f;
+
+		/* PB5 */
+		infoFramePtr->YccQuantizationRange = (AuxPtr->Data.Byte[5] >> 6) & 0x3;
+		infoFramePtr->ContentType = (AuxPtr->Data.Byte[5] >> 4) & 0x3;
+		infoFramePtr->PixelRepetition = AuxPtr->Data.Byte[5] & 0xf;
+
+		/* PB6/7 */
+		infoFramePtr->TopBar = (AuxPtr->Data.Byte[8] << 8) | AuxPtr->Data.Byte[6];
+
+		/* PB8/9 */
+		infoFramePtr->BottomBar = (AuxPtr->Data.Byte[10] << 8) | AuxPtr->Data.Byte[9];
+
+		/* PB10/11 */
+		infoFramePtr->LeftBar = (AuxPtr->Data.Byte[12] << 8) | AuxPtr->Data.Byte[11];
+
+		/* PB12/13 */
+		infoFramePtr->RightBar = (AuxPtr->Data.Byte[14] << 8) | AuxPtr->Data.Byte[13];
+
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function retrieves the General Control Packet.
+*
+* @param  None.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+void Ref_XV_HdmiC_ParseGCP(XHdmiC_Aux *AuxPtr, XHdmiC_GeneralControlPacket *GcpPtr)
+{
+	if (AuxPtr->Header.Byte[0] == AUX_GENERAL_CONTROL_PACKET_TYPE) {
+
+		/* SB0 */
+		GcpPtr->Clear_AVMUTE = (AuxPtr->Data.Byte[0] >> 4) & 0x1;
+		GcpPtr->Set_AVMUTE = AuxPtr->Data.Byte[0] & 0x1;
+
+		/* SB1 */
+		GcpPtr->PixelPackingPhase = (AuxPtr->Data.Byte[1] >> 4) & 0xf;
+		GcpPtr->ColorDepth = AuxPtr->Data.Byte[1] & 0xf;
+
+		/* SB2 */
+		GcpPtr->Default_Phase = AuxPtr->Data.Byte[2] & 0x1;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function retrieves the Audio Info Frame.
+*
+* @param  None.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+void Ref_XV_HdmiC_ParseAudioInfoFrame(XHdmiC_Aux *AuxPtr, XHdmiC_AudioInfoFrame *AudIFPtr)
+{
+	if (AuxPtr->Header.Byte[0] == AUX_AUDIO_INFOFRAME_TYPE) {
+
+		/* HB1, Version */
+		AudIFPtr->Version = AuxPtr->Header.Byte[1];
+
+		/* PB1 */
+		AudIFPtr->CodingType = (AuxPtr->Data.Byte[1] >> 4) & 0xf;
+		AudIFPtr->ChannelCount = (AuxPtr->Data.Byte[1]) & 0x7;
+
+		/* PB2 */
+		AudIFPtr->SampleFrequency = (AuxPtr->Data.Byte[2] >> 2) & 0x7;
+		AudIFPtr->SampleSize = AuxPtr->Data.Byte[2] & 0x3;
+
+		/* PB4 */
+		AudIFPtr->ChannelAllocation = AuxPtr->Data.Byte[4];
+
+		/* PB5 */
+		AudIFPtr->Downmix_Inhibit = (AuxPtr->Data.Byte[5] >> 7) & 0x1;
+		AudIFPtr->LevelShiftVal = (AuxPtr->Data.Byte[5] >> 4) & 0xf;
+		AudIFPtr->LFE_Playback_Level = AuxPtr->Data.Byte[5] & 0x3;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function retrieves the Audio Metadata.
+*
+* @param  None.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+void Ref_XV_HdmiC_ParseAudioMetadata(XHdmiC_Aux *AuxPtr,
+		XHdmiC_AudioMetadata *AudMetadata)
+{
+	if (AuxPtr->Header.Byte[0] == AUX_AUDIO_METADATA_PACKET_TYPE) {
+		/* 3D Audio */
+		AudMetadata->Audio3D = AuxPtr->Header.Byte[1] & 0x1;
+
+		/* HB2 */
+		AudMetadata->Num_Audio_Str =
+				(AuxPtr->Header.Byte[2] >> 2) & 0x3;
+		AudMetadata->Num_Views = AuxPtr->Header.Byte[2] & 0x3;
+
+		/* PB0 */
+		AudMetadata->Audio3D_ChannelCount =
+				AuxPtr->Data.Byte[0] & 0x1F;
+
+		/* PB1 */
+		AudMetadata->ACAT = AuxPtr->Data.Byte[1] & 0x0F;
+
+		/* PB2 */
+		AudMetadata->Audio3D_ChannelAllocation =
+				AuxPtr->Data.Byte[2] & 0xFF;
+	}
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function retrieves the SPD Infoframes.
+ *
+ * @param  None.
+ *
+ * @return None.
+ *
+ * @note   None.
+ *
+******************************************************************************/
+void Ref_XV_HdmiC_ParseSPDIF(XHdmiC_Aux *AuxPtr, XHdmiC_SPDInfoFrame *SPDInfoFrame)
+{
+	if (AuxPtr->Header.Byte[0] == AUX_SPD_INFOFRAME_TYPE) {
+		/* 3D Audio */
+		SPDInfoFrame->Version = AuxPtr->Header.Byte[1];
+
+		/* Vendor Name Characters */
+		SPDInfoFrame->VN1 = AuxPtr->Data.Byte[1];
+		SPDInfoFrame->VN2 = AuxPtr->Data.Byte[2];
+		SPDInfoFrame->VN3 = AuxPtr->Data.Byte[3];
+		SPDInfoFrame->VN4 = AuxPtr->Data.Byte[4];
+		SPDInfoFrame->VN5 = AuxPtr->Data.Byte[5];
+		SPDInfoFrame->VN6 = AuxPtr->Data.Byte[6];
+		SPDInfoFrame->VN7 = AuxPtr->Data.Byte[8];
+		SPDInfoFrame->VN8 = AuxPtr->Data.Byte[9];
+
+		/* Product Description Character */
+		SPDInfoFrame->PD1 = AuxPtr->Data.Byte[10];
+		SPDInfoFrame->PD2 = AuxPtr->Data.Byte[11];
+		SPDInfoFrame->PD3 = AuxPtr->Data.Byte[12];
+		SPDInfoFrame->PD4 = AuxPtr->Data.Byte[13];
+		SPDInfoFrame->PD5 = AuxPtr->Data.Byte[14];
+		SPDInfoFrame->PD6 = AuxPtr->Data.Byte[16];
+		SPDInfoFrame->PD7 = AuxPtr->Data.Byte[17];
+		SPDInfoFrame->PD8 = AuxPtr->Data.Byte[18];
+		SPDInfoFrame->PD9 = AuxPtr->Data.Byte[19];
+		SPDInfoFrame->PD10 = AuxPtr->Data.Byte[20];
+		SPDInfoFrame->PD11 = AuxPtr->Data.Byte[21];
+		SPDInfoFrame->PD12 = AuxPtr->Data.Byte[22];
+		SPDInfoFrame->PD13 = AuxPtr->Data.Byte[24];
+		SPDInfoFrame->PD14 = AuxPtr->Data.Byte[25];
+		SPDInfoFrame->PD15 = AuxPtr->Data.Byte[26];
+		SPDInfoFrame->PD16 = AuxPtr->Data.Byte[27];
+
+		/* Source Information */
+		SPDInfoFrame->SourceInfo = AuxPtr->Data.Byte[28];
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function retrieves the DRM Infoframes.
+*
+* @param  None.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+void Ref_XV_HdmiC_ParseDRMIF(XHdmiC_Aux *AuxPtr, struct v4l2_hdr10_payload *DRMInfoFrame)
+{
+	if (AuxPtr->Header.Byte[0] == AUX_DRM_INFOFRAME_TYPE) {
+
+		/* Vendor Name Characters */
+		DRMInfoFrame->eotf = AuxPtr->Data.Byte[1] & 0x7;
+
+		DRMInfoFrame->metadata_type =
+				AuxPtr->Data.Byte[2] & 0x7;
+
+		DRMInfoFrame->display_primaries[0].x =
+				(AuxPtr->Data.Byte[3] & 0xFF) |
+				(AuxPtr->Data.Byte[4] << 8);
+
+		DRMInfoFrame->display_primaries[0].y =
+				(AuxPtr->Data.Byte[5] & 0xFF) |
+				(AuxPtr->Data.Byte[6] << 8);
+
+		DRMInfoFrame->display_primaries[1].x =
+				(AuxPtr->Data.Byte[8] & 0xFF) |
+				(AuxPtr->Data.Byte[9] << 8);
+
+		DRMInfoFrame->display_primaries[1].y =
+				(AuxPtr->Data.Byte[10] & 0xFF) |
+				(AuxPtr->Data.Byte[11] << 8);
+
+		DRMInfoFrame->display_primaries[2].x =
+				(AuxPtr->Data.Byte[12] & 0xFF) |
+				(AuxPtr->Data.Byte[13] << 8);
+
+		DRMInfoFrame->display_primaries[2].y =
+				(AuxPtr->Data.Byte[14] & 0xFF) |
+				(AuxPtr->Data.Byte[16] << 8);
+
+		DRMInfoFrame->white_point.x =
+				(AuxPtr->Data.Byte[17] & 0xFF) |
+				(AuxPtr->Data.Byte[18] << 8);
+
+		DRMInfoFrame->white_point.y =
+				(AuxPtr->Data.Byte[19] & 0xFF) |
+				(AuxPtr->Data.Byte[20] << 8);
+
+		DRMInfoFrame->max_mdl =
+				(AuxPtr->Data.Byte[21] & 0xFF) |
+				(AuxPtr->Data.Byte[22] << 8);
+
+		DRMInfoFrame->min_mdl =
+				(AuxPtr->Data.Byte[24] & 0xFF) |
+				(AuxPtr->Data.Byte[25] << 8);
+
+		DRMInfoFrame->max_cll =
+				(AuxPtr->Data.Byte[26] & 0xFF) |
+				(AuxPtr->Data.Byte[27] << 8);
+
+		DRMInfoFrame->max_fall =
+				(AuxPtr->Data.Byte[28] & 0xFF) |
+				(AuxPtr->Data.Byte[29] << 8);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function generates and sends Auxilliary Video Infoframes
+*
+* @param  InstancePtr is a pointer to the HDMI TX Subsystem instance.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+XHdmiC_Aux Ref_XV_HdmiC_AVIIF_GeneratePacket(XHdmiC_AVI_InfoFrame *infoFramePtr)
+{
+//	Xil_AssertNonvoid(infoFramePtr != NULL);
+
+	u8 Index;
+	u8 Crc;
+	XHdmiC_Aux aux;
+
+	(void)memset((void *)&aux, 0, sizeof(XHdmiC_Aux));
+
+	/* Header, Packet type*/
+	aux.Header.Byte[0] = AUX_AVI_INFOFRAME_TYPE;
+
+	/* Version */
+	aux.Header.Byte[1] = infoFramePtr->Version;
+
+	/* Length */
+	aux.Header.Byte[2] = 13;
+
+	/* Checksum (this will be calculated by the HDMI TX IP) */
+	aux.Header.Byte[3] = 0;
+
+	/* PB1 */
+   aux.Data.Byte[1] = (infoFramePtr->ColorSpace & 0x7) << 5 |
+		   ((infoFramePtr->ActiveFormatDataPresent << 4) & 0x10) |
+		   ((infoFramePtr->BarInfo << 2) & 0xc) |
+		   (infoFramePtr->ScanInfo & 0x3);
+
+   /* PB2 */
+   aux.Data.Byte[2] = ((infoFramePtr->Colorimetry & 0x3) << 6  |
+		   ((infoFramePtr->PicAspectRatio << 4) & 0x30) |
+		   (infoFramePtr->ActiveAspectRatio & 0xf));
+
+   /* PB3 */
+   aux.Data.Byte[3] = (infoFramePtr->Itc & 0x1) << 7 |
+		   ((infoFramePtr->ExtendedColorimetry << 4) & 0x70) |
+		   ((infoFramePtr->QuantizationRange << 2) & 0xc) |
+		   (infoFramePtr->NonUniformPictureScaling & 0x3);
+
+   /* PB4 */
+   aux.Data.Byte[4] = infoFramePtr->VIC;
+
+   /* PB5 */
+   aux.Data.Byte[5] = (infoFramePtr->YccQuantizationRange & 0x3) << 6 |
+		   ((infoFramePtr->ContentType << 4) & 0x30) |
+		   (infoFramePtr->PixelRepetition & 0xf);
+
+   /* PB6 */
+   aux.Data.Byte[6] = infoFramePtr->TopBar & 0xff;
+
+   aux.Data.Byte[7] = 0;
+
+   /* PB8 */
+   aux.Data.Byte[8] = (infoFramePtr->TopBar & 0xff00) >> 8;
+
+   /* PB9 */
+   aux.Data.Byte[9] = infoFramePtr->BottomBar & 0xff;
+
+   /* PB10 */
+   aux.Data.Byte[10] = (infoFramePtr->BottomBar & 0xff00) >> 8;
+
+   /* PB11 */
+   aux.Data.Byte[11] = infoFramePtr->LeftBar & 0xff;
+
+   /* PB12 */
+   aux.Data.Byte[12] = (infoFramePtr->LeftBar & 0xff00) >> 8;
+
+   /* PB13 */
+   aux.Data.Byte[13] = infoFramePtr->RightBar & 0xff;
+
+   /* PB14 */
+   aux.Data.Byte[14] = (infoFramePtr->RightBar & 0xff00) >> 8;
+
+   /* Index references the length to calculate start of loop from where values are reserved */
+   for (Index = aux.Header.Byte[2] + 2; Index < 32; Index++) {
+	   aux.Data.Byte[Index] = 0;
+   }
+
+   /* Calculate AVI infoframe checksum */
+   Crc = 0;
+
+   /* Header */
+   for (Index = 0; Index < 3; Index++) {
+     Crc += aux.Header.Byte[Index];
+   }
+
+   /* Data */
+   for (Index = 1; Index < (aux.Header.Byte[2] + 2); Index++) {
+     Crc += aux.Data.Byte[Index];
+   }
+
+   Crc = 256 - Crc;
+
+   /* PB0 */
+   aux.Data.Byte[0] = Crc;
+
+   return aux;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function generates and sends Audio Infoframes
+*
+* @param  InstancePtr is a pointer to the HDMI TX Subsystem instance.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+XHdmiC_Aux Ref_XV_HdmiC_AudioIF_GeneratePacket(XHdmiC_AudioInfoFrame *AudioInfoFrame)
+{
+//	Xil_AssertNonvoid(AudioInfoFrame != NULL);
+
+	u8 Index;
+	u8 Crc;
+	XHdmiC_Aux aux;
+
+	(void)memset((void *)&aux, 0, sizeof(XHdmiC_Aux));
+
+	/* Header, Packet Type */
+	aux.Header.Byte[0] = AUX_AUDIO_INFOFRAME_TYPE;
+
+	/* Version */
+	aux.Header.Byte[1] = 0x01;
+
+	/* Length */
+	aux.Header.Byte[2] = 0x0A;
+
+	aux.Header.Byte[3] = 0;
+
+	/* PB1 */
+	aux.Data.Byte[1] = AudioInfoFrame->CodingType << 4 |
+			(AudioInfoFrame->ChannelCount & 0x7);
+
+	/* PB2 */
+	aux.Data.Byte[2] = ((AudioInfoFrame->SampleFrequency << 2) & 0x1c) |
+			(AudioInfoFrame->SampleSize & 0x3);
+
+	/* PB3 */
+	aux.Data.Byte[3] = 0;
+
+
+	/* PB4 */
+	aux.Data.Byte[4] = AudioInfoFrame->ChannelAllocation;
+
+	/* PB5 */
+	aux.Data.Byte[5] = (AudioInfoFrame->Downmix_Inhibit << 7) |
+			((AudioInfoFrame->LevelShiftVal << 3) & 0x78) |
+			(AudioInfoFrame->LFE_Playback_Level & 0x3);
+
+	for (Index = 6; Index < 32; Index++)
+	{
+		aux.Data.Byte[Index] = 0;
+	}
+
+	/* Calculate Audio infoframe checksum */
+	  Crc = 0;
+
+	  /* Header */
+	  for (Index = 0; Index < 3; Index++) {
+	    Crc += aux.Header.Byte[Index];
+	  }
+
+	  /* Data */
+	  for (Index = 1; Index < aux.Header.Byte[2] + 1; Index++) {
+		  Crc += aux.Data.Byte[Index];
+	  }
+
+	  Crc = 256 - Crc;
+
+	  aux.Data.Byte[0] = Crc;
+
+	  return aux;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function generates and sends Audio Metadata Packet
+*
+* @param  InstancePtr is a pointer to the HDMI TX Subsystem instance.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+XHdmiC_Aux Ref_XV_HdmiC_AudioMetadata_GeneratePacket(XHdmiC_AudioMetadata
+		*AudMetadata)
+{
+	u8 Index;
+	XHdmiC_Aux aux;
+
+	(void)memset((void *)&aux, 0, sizeof(XHdmiC_Aux));
+
+	/* Header, Packet Type */
+	aux.Header.Byte[0] = AUX_AUDIO_METADATA_PACKET_TYPE;
+
+	/* 3D Audio */
+	aux.Header.Byte[1] = AudMetadata->Audio3D & 0x1;
+
+	/* HB2 */
+	aux.Header.Byte[2] = ((AudMetadata->Num_Audio_Str & 0x3) << 2) |
+			(AudMetadata->Num_Views & 0x3);
+
+	/* HB3 */
+	aux.Header.Byte[3] = 0;
+
+	/* PB0 */
+	aux.Data.Byte[0] = AudMetadata->Audio3D_ChannelCount & 0x1F;
+
+	/* PB1 */
+	aux.Data.Byte[1] = AudMetadata->ACAT & 0x0F;
+
+	/* PB2 */
+	aux.Data.Byte[2] = AudMetadata->Audio3D_ChannelAllocation & 0xFF;
+
+	for (Index = 3; Index < 32; Index++)
+		aux.Data.Byte[Index] = 0;
+
+	return aux;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function generates and sends SPD Infoframes
+ *
+ * @param  InstancePtr is a pointer to the HDMI TX Subsystem instance.
+ *
+ * @return None.
+ *
+ * @note   None.
+ *
+******************************************************************************/
+XHdmiC_Aux Ref_XV_HdmiC_SPDIF_GeneratePacket(XHdmiC_SPDInfoFrame *SPDInfoFrame)
+{
+	u8 Index;
+	u8 Crc;
+	XHdmiC_Aux aux;
+
+	(void)memset((void *)&aux, 0, sizeof(XHdmiC_Aux));
+
+	/* Header, Packet Type */
+	aux.Header.Byte[0] = AUX_SPD_INFOFRAME_TYPE;
+
+	/* 3D Audio */
+	aux.Header.Byte[1] = SPDInfoFrame->Version;
+
+	/* Length of SPD InfoFrame */
+	aux.Header.Byte[2] = 25;
+
+	/* HB3 */
+	aux.Header.Byte[3] = 0; /* CRC */
+
+	/* Vendor Name Characters */
+	aux.Data.Byte[0] = 0; /* CRC */
+	aux.Data.Byte[1] = SPDInfoFrame->VN1;
+	aux.Data.Byte[2] = SPDInfoFrame->VN2;
+	aux.Data.Byte[3] = SPDInfoFrame->VN3;
+	aux.Data.Byte[4] = SPDInfoFrame->VN4;
+	aux.Data.Byte[5] = SPDInfoFrame->VN5;
+	aux.Data.Byte[6] = SPDInfoFrame->VN6;
+	aux.Data.Byte[7] = 0; /* ECC */
+	aux.Data.Byte[8] = SPDInfoFrame->VN7;
+	aux.Data.Byte[9] = SPDInfoFrame->VN8;
+
+	/* Product Description Character */
+	aux.Data.Byte[10] = SPDInfoFrame->PD1;
+	aux.Data.Byte[11] = SPDInfoFrame->PD2;
+	aux.Data.Byte[12] = SPDInfoFrame->PD3;
+	aux.Data.Byte[13] = SPDInfoFrame->PD4;
+	aux.Data.Byte[14] = SPDInfoFrame->PD5;
+	aux.Data.Byte[15] = 0; /* ECC */
+	aux.Data.Byte[16] = SPDInfoFrame->PD6;
+	aux.Data.Byte[17] = SPDInfoFrame->PD7;
+	aux.Data.Byte[18] = SPDInfoFrame->PD8;
+	aux.Data.Byte[19] = SPDInfoFrame->PD9;
+	aux.Data.Byte[20] = SPDInfoFrame->PD10;
+	aux.Data.Byte[21] = SPDInfoFrame->PD11;
+	aux.Data.Byte[22] = SPDInfoFrame->PD12;
+	aux.Data.Byte[23] = 0; /* ECC */
+	aux.Data.Byte[24] = SPDInfoFrame->PD13;
+	aux.Data.Byte[25] = SPDInfoFrame->PD14;
+	aux.Data.Byte[26] = SPDInfoFrame->PD15;
+	aux.Data.Byte[27] = SPDInfoFrame->PD16;
+
+	/* Source Information */
+	aux.Data.Byte[28] = SPDInfoFrame->SourceInfo;
+	aux.Data.Byte[29] = 0;
+	aux.Data.Byte[30] = 0;
+	aux.Data.Byte[31] = 0; /* ECC */
+
+	/* Calculate SPD infoframe checksum */
+	Crc = 0;
+
+	/* Header */
+	for (Index = 0; Index < 3; Index++)
+		Crc += aux.Header.Byte[Index];
+
+	/* Data */
+	for (Index = 1; Index < aux.Header.Byte[2] + 4; Index++)
+		Crc += aux.Data.Byte[Index];
+
+	Crc = 256 - Crc;
+
+	aux.Data.Byte[0] = Crc;
+
+	return aux;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function generates and sends DRM Infoframes
+ *
+ * @param  InstancePtr is a pointer to the HDMI TX Subsystem instance.
+ *
+ * @return None.
+ *
+ * @note   None.
+ *
+******************************************************************************/
+void Ref_XV_HdmiC_DRMIF_GeneratePacket(struct v4l2_hdr10_payload *DRMInfoFrame, XHdmiC_Aux *aux)
+{
+	u8 Index;
+	u8 Crc;
+
+	memset(aux, 0, sizeof(XHdmiC_Aux));
+
+	/* Header, Packet Type */
+	aux->Header.Byte[0] = AUX_DRM_INFOFRAME_TYPE;
+
+	/* Version Refer CEA-861-G */
+	aux->Header.Byte[1] = 0x1;
+
+	/* Length of DRM InfoFrame */
+	aux->Header.Byte[2] = 26;
+
+	/* HB3 */
+	aux->Header.Byte[3] = 0; /* CRC */
+
+	/* Vendor Name Characters */
+	aux->Data.Byte[0] = 0; /* CRC */
+	aux->Data.Byte[1] = DRMInfoFrame->eotf & 0x7;
+
+	aux->Data.Byte[2] = DRMInfoFrame->metadata_type & 0x7;
+
+	aux->Data.Byte[3] = DRMInfoFrame->display_primaries[0].x & 0xFF;
+	aux->Data.Byte[4] = DRMInfoFrame->display_primaries[0].x >> 8;
+
+	aux->Data.Byte[5] = DRMInfoFrame->display_primaries[0].y & 0xFF;
+	aux->Data.Byte[6] = DRMInfoFrame->display_primaries[0].y >> 8;
+	aux->Data.Byte[7] = 0; /* ECC */
+
+	aux->Data.Byte[8] = DRMInfoFrame->display_primaries[1].x & 0xFF;
+	aux->Data.Byte[9] = DRMInfoFrame->display_primaries[1].x >> 8;
+
+	aux->Data.Byte[10] = DRMInfoFrame->display_primaries[1].y & 0xFF;
+	aux->Data.Byte[11] = DRMInfoFrame->display_primaries[1].y >> 8;
+
+	aux->Data.Byte[12] = DRMInfoFrame->display_primaries[2].x & 0xFF;
+	aux->Data.Byte[13] = DRMInfoFrame->display_primaries[2].x >> 8;
+
+	aux->Data.Byte[14] = DRMInfoFrame->display_primaries[2].y & 0xFF;
+	aux->Data.Byte[15] = 0; /* ECC */
+	aux->Data.Byte[16] = DRMInfoFrame->display_primaries[2].y >> 8;
+
+	aux->Data.Byte[17] = DRMInfoFrame->white_point.x & 0xFF;
+	aux->Data.Byte[18] = DRMInfoFrame->white_point.x >> 8;
+
+	aux->Data.Byte[19] = DRMInfoFrame->white_point.y & 0xFF;
+	aux->Data.Byte[20] = DRMInfoFrame->white_point.y >> 8;
+
+	aux->Data.Byte[21] = DRMInfoFrame->max_mdl & 0xFF;
+	aux->Data.Byte[22] = DRMInfoFrame->max_mdl >> 8;
+	aux->Data.Byte[23] = 0; /* ECC */
+
+	aux->Data.Byte[24] = DRMInfoFrame->min_mdl & 0xFF;
+	aux->Data.Byte[25] = DRMInfoFrame->min_mdl >> 8;
+
+	aux->Data.Byte[26] = DRMInfoFrame->max_cll & 0xFF;
+	aux->Data.Byte[27] = DRMInfoFrame->max_cll >> 8;
+
+	aux->Data.Byte[28] = DRMInfoFrame->max_fall & 0xFF;
+	aux->Data.Byte[29] = DRMInfoFrame->max_fall >> 8;
+
+	aux->Data.Byte[30] = 0;
+	aux->Data.Byte[31] = 0; /* ECC */
+
+	/* Calculate DRM infoframe checksum */
+	Crc = 0;
+
+	/* Header */
+	for (Index = 0; Index < 3; Index++)
+		Crc += aux->Header.Byte[Index];
+
+	/* Data */
+	for (Index = 1; Index < aux->Header.Byte[2] + 4; Index++)
+		Crc += aux->Data.Byte[Index];
+
+	Crc = 256 - Crc;
+
+	aux->Data.Byte[0] = Crc;
+}
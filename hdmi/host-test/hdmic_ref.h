@@ -0,0 +1,94 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file hdmic_ref.h
+*
+* The reference infoframe parsers and generators of hdmic_ref.c and the
+* table of operations hdmic_fuzz and hdmic_bench run on both the current
+* xv_hdmic.c code and the reference.
+*
+******************************************************************************/
+
+#ifndef HDMIC_REF_H
+#define HDMIC_REF_H
+
+#include "xv_hdmic.h"
+
+/* Defined in xv_hdmic.c but not declared in xv_hdmic.h */
+void XV_HdmiC_ParseAudioMetadata(XHdmiC_Aux *AuxPtr,
+		XHdmiC_AudioMetadata *AudMetadata);
+void XV_HdmiC_ParseSPDIF(XHdmiC_Aux *AuxPtr,
+		XHdmiC_SPDInfoFrame *SPDInfoFrame);
+
+void Ref_XV_HdmiC_ParseAVIInfoFrame(XHdmiC_Aux *AuxPtr,
+		XHdmiC_AVI_InfoFrame *infoFramePtr);
+void Ref_XV_HdmiC_ParseGCP(XHdmiC_Aux *AuxPtr,
+		XHdmiC_GeneralControlPacket *GcpPtr);
+void Ref_XV_HdmiC_ParseAudioInfoFrame(XHdmiC_Aux *AuxPtr,
+		XHdmiC_AudioInfoFrame *AudIFPtr);
+void Ref_XV_HdmiC_ParseAudioMetadata(XHdmiC_Aux *AuxPtr,
+		XHdmiC_AudioMetadata *AudMetadata);
+void Ref_XV_HdmiC_ParseSPDIF(XHdmiC_Aux *AuxPtr,
+		XHdmiC_SPDInfoFrame *SPDInfoFrame);
+void Ref_XV_HdmiC_ParseDRMIF(XHdmiC_Aux *AuxPtr,
+		struct v4l2_hdr10_payload *DRMInfoFrame);
+XHdmiC_Aux Ref_XV_HdmiC_AVIIF_GeneratePacket(
+		XHdmiC_AVI_InfoFrame *infoFramePtr);
+XHdmiC_Aux Ref_XV_HdmiC_AudioIF_GeneratePacket(
+		XHdmiC_AudioInfoFrame *AudioInfoFrame);
+XHdmiC_Aux Ref_XV_HdmiC_AudioMetadata_GeneratePacket(
+		XHdmiC_AudioMetadata *AudioMetadata);
+XHdmiC_Aux Ref_XV_HdmiC_SPDIF_GeneratePacket(
+		XHdmiC_SPDInfoFrame *SPDInfoFrame);
+void Ref_XV_HdmiC_DRMIF_GeneratePacket(
+		struct v4l2_hdr10_payload *DRMInfoFrame, XHdmiC_Aux *aux);
+
+/* Largest input or output object of an operation */
+#define HDMIC_OP_MAX_SIZE	128
+
+/*
+ * An operation runs a parser or generator with In as its input and Out as
+ * its output. Parsers take a XHdmiC_Aux and fill a structure, generators
+ * take a structure and fill a XHdmiC_Aux.
+ */
+typedef struct {
+	const char *Name;
+	u32 InSize;
+	u32 OutSize;
+	void (*New)(void *In, void *Out);
+	void (*Ref)(void *In, void *Out);
+} hdmic_op;
+
+extern const hdmic_op hdmic_ops[];
+extern const u32 hdmic_num_ops;
+
+/*
+ * Decodes a fuzz input: the first byte of Data selects the operation, the
+ * rest, zero padded, is the input followed by the initial output. In and
+ * Out hold HDMIC_OP_MAX_SIZE bytes. Returns NULL for an empty input.
+ */
+const hdmic_op *hdmic_decode(const u8 *Data, size_t Size, void *In,
+			     void *Out);
+
+/*
+ * Runs the operation selected by the first byte of Data on the current and
+ * the reference code, see hdmic_decode(). Returns 0 if both produced the
+ * same bytes.
+ */
+int hdmic_run(const u8 *Data, size_t Size);
+
+#endif /* HDMIC_REF_H */
@@ -0,0 +1,252 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file host.c
+*
+* Host side implementation of the helpers declared in host.h.
+*
+******************************************************************************/
+
+#include <time.h>
+#include <linux/delay.h>
+#include <linux/hrtimer.h>
+#include <linux/random.h>
+#include <linux/sched.h>
+#include <linux/slab.h>
+#include <linux/workqueue.h>
+#include "host.h"
+
+int host_kmalloc_fail_after = -1;
+int host_failures;
+
+static u32 host_seed = 0x2545F491;
+
+static bool host_virtual;
+static u64 host_virtual_ns;
+static struct hrtimer *host_timers;
+static struct work_struct *host_work, **host_work_tail = &host_work;
+
+u64 host_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* xorshift32, deterministic so that failures are reproducible */
+u32 host_rand(void)
+{
+	host_seed ^= host_seed << 13;
+	host_seed ^= host_seed >> 17;
+	host_seed ^= host_seed << 5;
+	return host_seed;
+}
+
+void host_srand(u32 seed)
+{
+	host_seed = seed ? seed : 0x2545F491;
+}
+
+int host_report(const char *name)
+{
+	printf("%s: %s\n", name, host_failures ? "FAILED" : "passed");
+	return host_failures ? 1 : 0;
+}
+
+void get_random_bytes(void *buf, size_t len)
+{
+	u8 *p = buf;
+
+	while (len--)
+		*p++ = (u8)host_rand();
+}
+
+/* The virtual clock starts where the real clock is, it never goes back */
+void host_clock_virtual(bool virtual)
+{
+	if (virtual && !host_virtual)
+		host_virtual_ns = host_ns();
+	host_virtual = virtual;
+}
+
+u64 ktime_get_ns(void)
+{
+	return host_virtual ? host_virtual_ns : host_ns();
+}
+
+static struct hrtimer *host_next_timer(void)
+{
+	struct hrtimer *t, *next = NULL;
+
+	for (t = host_timers; t; t = t->next)
+		if (!next || t->expires < next->expires)
+			next = t;
+	return next;
+}
+
+static void host_dequeue_timer(struct hrtimer *timer)
+{
+	struct hrtimer **pp;
+
+	for (pp = &host_timers; *pp; pp = &(*pp)->next) {
+		if (*pp == timer) {
+			*pp = timer->next;
+			break;
+		}
+	}
+	timer->queued = false;
+	timer->next = NULL;
+}
+
+/* Runs the expired hrtimers first, then the queued work, until none is left */
+int host_run_pending(void)
+{
+	struct hrtimer *t;
+	struct work_struct *w;
+	int n = 0;
+
+	for (;;) {
+		t = host_next_timer();
+		if (t && (u64)t->expires <= ktime_get_ns()) {
+			host_dequeue_timer(t);
+			t->function(t);
+			n++;
+			continue;
+		}
+		w = host_work;
+		if (w) {
+			host_work = w->next;
+			if (!host_work)
+				host_work_tail = &host_work;
+			w->next = NULL;
+			w->pending = false;
+			w->func(w);
+			n++;
+			continue;
+		}
+		return n;
+	}
+}
+
+/*
+ * Lets ns pass. The virtual clock stops at every hrtimer expiration on the
+ * way, so the expirations see the time they were armed for.
+ */
+void host_clock_advance(u64 ns)
+{
+	struct timespec ts;
+	struct hrtimer *t;
+	u64 end;
+
+	if (!host_virtual) {
+		ts.tv_sec = ns / 1000000000ULL;
+		ts.tv_nsec = ns % 1000000000ULL;
+		nanosleep(&ts, NULL);
+		host_run_pending();
+		return;
+	}
+
+	end = host_virtual_ns + ns;
+	while ((t = host_next_timer()) && (u64)t->expires <= end) {
+		if ((u64)t->expires > host_virtual_ns)
+			host_virtual_ns = t->expires;
+		host_run_pending();
+	}
+	host_virtual_ns = end;
+	host_run_pending();
+}
+
+void hrtimer_setup(struct hrtimer *timer,
+		   enum hrtimer_restart (*function)(struct hrtimer *),
+		   clockid_t clock_id, enum hrtimer_mode mode)
+{
+	timer->function = function;
+	timer->expires = 0;
+	timer->queued = false;
+	timer->next = NULL;
+}
+
+void hrtimer_start(struct hrtimer *timer, ktime_t tim, enum hrtimer_mode mode)
+{
+	if (timer->queued)
+		host_dequeue_timer(timer);
+	timer->expires = mode == HRTIMER_MODE_REL ? ktime_get_ns() + tim : tim;
+	timer->queued = true;
+	timer->next = host_timers;
+	host_timers = timer;
+}
+
+int hrtimer_try_to_cancel(struct hrtimer *timer)
+{
+	if (!timer->queued)
+		return 0;
+	host_dequeue_timer(timer);
+	return 1;
+}
+
+int hrtimer_cancel(struct hrtimer *timer)
+{
+	return hrtimer_try_to_cancel(timer);
+}
+
+bool schedule_work(struct work_struct *work)
+{
+	if (work->pending)
+		return false;
+	work->pending = true;
+	work->next = NULL;
+	*host_work_tail = work;
+	host_work_tail = &work->next;
+	return true;
+}
+
+bool cancel_work_sync(struct work_struct *work)
+{
+	struct work_struct **pp;
+
+	if (!work->pending)
+		return false;
+	for (pp = &host_work; *pp; pp = &(*pp)->next) {
+		if (*pp == work) {
+			*pp = work->next;
+			break;
+		}
+	}
+	host_work_tail = &host_work;
+	while (*host_work_tail)
+		host_work_tail = &(*host_work_tail)->next;
+	work->next = NULL;
+	work->pending = false;
+	return true;
+}
+
+void usleep_range(unsigned long min, unsigned long max)
+{
+	host_clock_advance((u64)min * 1000);
+}
+
+void msleep(unsigned int msecs)
+{
+	host_clock_advance((u64)msecs * 1000000);
+}
+
+int cond_resched(void)
+{
+	host_run_pending();
+	return 0;
+}
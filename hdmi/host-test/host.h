@@ -0,0 +1,59 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file host.h
+*
+* Helpers shared by the host unit tests and benchmarks: a monotonic clock,
+* a deterministic random generator, allocation failure injection (see
+* include/linux/slab.h) and a CHECK macro that counts failures.
+*
+* The clock of the ktime, hrtimer, workqueue and delay stand-ins is real by
+* default: it follows CLOCK_MONOTONIC and delays sleep. The virtual clock
+* stands still until host_clock_advance() or a delay moves it, which makes
+* timer tests exact and fast. Expired hrtimers and queued work run from
+* host_clock_advance(), delays and cond_resched(), one at a time as on a
+* single CPU.
+*
+******************************************************************************/
+
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdio.h>
+#include <linux/types.h>
+
+extern int host_failures;
+
+#define CHECK(c)							\
+	do {								\
+		if (!(c)) {						\
+			printf("%s:%d: CHECK(%s) failed\n",		\
+			       __FILE__, __LINE__, #c);			\
+			host_failures++;				\
+		}							\
+	} while (0)
+
+u64 host_ns(void);
+u32 host_rand(void);
+void host_srand(u32 seed);
+int host_report(const char *name);
+
+void host_clock_virtual(bool virtual);
+void host_clock_advance(u64 ns);
+int host_run_pending(void);
+
+#endif /* HOST_H */
@@ -0,0 +1,9 @@
+/* Host stand-in for <asm-generic/bug.h>, see ../../Makefile */
+#ifndef HOST_ASM_GENERIC_BUG_H
+#define HOST_ASM_GENERIC_BUG_H
+
+#include <stdlib.h>
+
+#define BUG_ON(c)	do { if (c) abort(); } while (0)
+
+#endif
@@ -0,0 +1 @@
+/* Host stand-in for <linux/clk.h>, see ../../Makefile */
@@ -0,0 +1,9 @@
+/* Host stand-in for <linux/delay.h>, see ../../Makefile */
+#ifndef HOST_LINUX_DELAY_H
+#define HOST_LINUX_DELAY_H
+
+/* let the host clock pass, see host.h */
+void usleep_range(unsigned long min, unsigned long max);
+void msleep(unsigned int msecs);
+
+#endif
@@ -0,0 +1,35 @@
+/* Host stand-in for <linux/hrtimer.h>, see ../../Makefile */
+#ifndef HOST_LINUX_HRTIMER_H
+#define HOST_LINUX_HRTIMER_H
+
+#include <time.h>
+#include <linux/ktime.h>
+
+enum hrtimer_mode {
+	HRTIMER_MODE_ABS,
+	HRTIMER_MODE_REL,
+};
+
+/* expirations are one-shot, HRTIMER_RESTART is not supported */
+enum hrtimer_restart {
+	HRTIMER_NORESTART,
+	HRTIMER_RESTART,
+};
+
+struct hrtimer {
+	enum hrtimer_restart (*function)(struct hrtimer *timer);
+	ktime_t expires;
+	bool queued;
+	struct hrtimer *next;
+};
+
+/* run from host_clock_advance(), delays and cond_resched(), see host.h */
+void hrtimer_setup(struct hrtimer *timer,
+		   enum hrtimer_restart (*function)(struct hrtimer *),
+		   clockid_t clock_id, enum hrtimer_mode mode);
+void hrtimer_start(struct hrtimer *timer, ktime_t tim,
+		   enum hrtimer_mode mode);
+int hrtimer_try_to_cancel(struct hrtimer *timer);
+int hrtimer_cancel(struct hrtimer *timer);
+
+#endif
@@ -0,0 +1,17 @@
+/* Host stand-in for <linux/io.h>, see ../../Makefile */
+#ifndef HOST_LINUX_IO_H
+#define HOST_LINUX_IO_H
+
+#include <linux/types.h>
+
+static inline u32 ioread32(const volatile void *addr)
+{
+	return *(const volatile u32 *)addr;
+}
+
+static inline void iowrite32(u32 value, volatile void *addr)
+{
+	*(volatile u32 *)addr = value;
+}
+
+#endif
@@ -0,0 +1,50 @@
+/* Host stand-in for <linux/kernel.h>, see ../../Makefile */
+#ifndef HOST_LINUX_KERNEL_H
+#define HOST_LINUX_KERNEL_H
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <linux/types.h>
+
+#define KERN_ERR	""
+#define KERN_WARNING	""
+#define KERN_INFO	""
+#define KERN_DEBUG	""
+#define printk(...)	printf(__VA_ARGS__)
+
+#define ARRAY_SIZE(a)	(sizeof(a) / sizeof((a)[0]))
+#define BIT(n)		(1UL << (n))
+#define min(a, b)	((a) < (b) ? (a) : (b))
+#define max(a, b)	((a) > (b) ? (a) : (b))
+#define min_t(t, a, b)	min((t)(a), (t)(b))
+#define max_t(t, a, b)	max((t)(a), (t)(b))
+#define container_of(p, t, m) ((t *)((char *)(p) - offsetof(t, m)))
+#define U64_MAX		UINT64_MAX
+
+#define READ_ONCE(x)	(*(const volatile __typeof__(x) *)&(x))
+#define WRITE_ONCE(x, v) (*(volatile __typeof__(x) *)&(x) = (v))
+
+static inline int vscnprintf(char *buf, size_t size, const char *fmt,
+			     va_list args)
+{
+	int i;
+
+	if (size == 0)
+		return 0;
+	i = vsnprintf(buf, size, fmt, args);
+	return i < 0 ? 0 : ((size_t)i < size ? i : (int)size - 1);
+}
+
+static inline __attribute__((format(printf, 3, 4)))
+int scnprintf(char *buf, size_t size, const char *fmt, ...)
+{
+	va_list args;
+	int i;
+
+	va_start(args, fmt);
+	i = vscnprintf(buf, size, fmt, args);
+	va_end(args);
+	return i;
+}
+
+#endif
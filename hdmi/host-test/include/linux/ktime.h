@@ -0,0 +1,21 @@
+/* Host stand-in for <linux/ktime.h>, see ../../Makefile */
+#ifndef HOST_LINUX_KTIME_H
+#define HOST_LINUX_KTIME_H
+
+#include <linux/types.h>
+
+#define NSEC_PER_USEC	1000L
+#define NSEC_PER_MSEC	1000000L
+#define NSEC_PER_SEC	1000000000L
+
+typedef s64 ktime_t;
+
+/* the host clock, real or virtual, see host.h */
+u64 ktime_get_ns(void);
+
+static inline ktime_t ns_to_ktime(u64 ns)
+{
+	return (ktime_t)ns;
+}
+
+#endif
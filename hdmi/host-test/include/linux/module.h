@@ -0,0 +1,2 @@
+/* Host stand-in for <linux/module.h>, see ../../Makefile */
+#include <linux/kernel.h>
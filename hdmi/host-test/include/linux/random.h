@@ -0,0 +1,10 @@
+/* Host stand-in for <linux/random.h>, see ../../Makefile */
+#ifndef HOST_LINUX_RANDOM_H
+#define HOST_LINUX_RANDOM_H
+
+#include <stddef.h>
+
+/* deterministic, from host_rand() */
+void get_random_bytes(void *buf, size_t len);
+
+#endif
@@ -0,0 +1,8 @@
+/* Host stand-in for <linux/sched.h>, see ../../Makefile */
+#ifndef HOST_LINUX_SCHED_H
+#define HOST_LINUX_SCHED_H
+
+/* runs the expired hrtimers and the queued work, see host.h */
+int cond_resched(void);
+
+#endif
@@ -0,0 +1,27 @@
+/* Host stand-in for <linux/slab.h>, see ../../Makefile */
+#ifndef HOST_LINUX_SLAB_H
+#define HOST_LINUX_SLAB_H
+
+#include <stdlib.h>
+
+#define GFP_KERNEL	0
+
+/* number of allocations to let through before failing, < 0 never fails */
+extern int host_kmalloc_fail_after;
+
+static inline void *kzalloc(size_t size, int flags)
+{
+	(void)flags;
+	if (host_kmalloc_fail_after == 0)
+		return NULL;
+	if (host_kmalloc_fail_after > 0)
+		host_kmalloc_fail_after--;
+	return calloc(1, size);
+}
+
+static inline void kfree(const void *p)
+{
+	free((void *)p);
+}
+
+#endif
@@ -0,0 +1,2 @@
+/* Host stand-in for <linux/stdarg.h>, see ../../Makefile */
+#include <stdarg.h>
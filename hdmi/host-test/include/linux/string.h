@@ -0,0 +1,13 @@
+/* Host stand-in for <linux/string.h>, see ../../Makefile */
+#ifndef HOST_LINUX_STRING_H
+#define HOST_LINUX_STRING_H
+
+#include <string.h>
+
+static inline void memzero_explicit(void *s, size_t count)
+{
+	memset(s, 0, count);
+	__asm__ __volatile__("" : : "r"(s) : "memory");
+}
+
+#endif
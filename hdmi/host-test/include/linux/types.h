@@ -0,0 +1,19 @@
+/* Host stand-in for <linux/types.h>, see ../../Makefile */
+#ifndef HOST_LINUX_TYPES_H
+#define HOST_LINUX_TYPES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+/* as in the kernel, u64 is unsigned long long on all architectures */
+typedef unsigned long long u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef long long s64;
+
+#endif
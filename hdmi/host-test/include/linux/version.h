@@ -0,0 +1,8 @@
+/* Host stand-in for <linux/version.h>, see ../../Makefile */
+#ifndef HOST_LINUX_VERSION_H
+#define HOST_LINUX_VERSION_H
+
+#define KERNEL_VERSION(a, b, c)	(((a) << 16) + ((b) << 8) + (c))
+#define LINUX_VERSION_CODE	KERNEL_VERSION(6, 13, 0)
+
+#endif
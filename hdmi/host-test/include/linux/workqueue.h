@@ -0,0 +1,27 @@
+/* Host stand-in for <linux/workqueue.h>, see ../../Makefile */
+#ifndef HOST_LINUX_WORKQUEUE_H
+#define HOST_LINUX_WORKQUEUE_H
+
+#include <linux/types.h>
+
+struct work_struct;
+typedef void (*work_func_t)(struct work_struct *work);
+
+struct work_struct {
+	work_func_t func;
+	bool pending;
+	struct work_struct *next;
+};
+
+#define INIT_WORK(w, f)							\
+	do {								\
+		(w)->func = (f);					\
+		(w)->pending = false;					\
+		(w)->next = NULL;					\
+	} while (0)
+
+/* run from host_clock_advance(), delays and cond_resched(), see host.h */
+bool schedule_work(struct work_struct *work);
+bool cancel_work_sync(struct work_struct *work);
+
+#endif
@@ -0,0 +1,23 @@
+/* Host stand-in for <media/hdr-ctrls.h>, see ../../Makefile */
+#ifndef HOST_MEDIA_HDR_CTRLS_H
+#define HOST_MEDIA_HDR_CTRLS_H
+
+#include <linux/types.h>
+
+struct v4l2_primary {
+	u16 x;
+	u16 y;
+};
+
+struct v4l2_hdr10_payload {
+	u8 eotf;
+	u8 metadata_type;
+	struct v4l2_primary display_primaries[3];
+	struct v4l2_primary white_point;
+	u16 max_mdl;
+	u16 min_mdl;
+	u16 max_cll;
+	u16 max_fall;
+};
+
+#endif
@@ -0,0 +1 @@
+/* Host stand-in for <uapi/linux/videodev2.h>, see ../../../Makefile */
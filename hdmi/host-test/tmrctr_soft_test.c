@@ -0,0 +1,257 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file tmrctr_soft_test.c
+*
+* Unit test of the XTmrCtr software timer mode (xtmrctr.c, xtmrctr_intr.c,
+* xtmrctr_options.c) on its hrtimer backend (xtmrctr_hrtimer.c), over the
+* virtual host clock. The timer runs at 100 MHz, so a tick is 10 ns and the
+* expirations fall on whole nanoseconds.
+*
+* Checks the counter values against the elapsed virtual time, that the
+* handler of a single shot counter runs once at its expiration and that of
+* an auto reload counter once per period, that stopping and releasing
+* cancel the expirations, that both counters of an instance expire in time
+* order and that XTmrCtr_SoftWait lets the virtual time pass up to the
+* expiration.
+*
+******************************************************************************/
+
+#include <linux/kernel.h>
+#include <linux/ktime.h>
+#include "xtmrctr.h"
+#include "xtmrctr_hrtimer.h"
+#include "host.h"
+
+#define TIMER_HZ	100000000
+#define TICK_NS		10
+
+#define MAX_EVENTS	32
+
+XTmrCtr_Config XTmrCtr_ConfigTable[XPAR_XTMRCTR_NUM_INSTANCES] = {
+	{ 0, 0, TIMER_HZ },
+};
+
+static XTmrCtr Timer;
+static XTmrCtr_HrTimer HrTimer;
+
+/* Handler calls, in order */
+static struct {
+	u8 TmrCtrNumber;
+	u64 Ns;
+} Events[MAX_EVENTS];
+static int NumEvents;
+
+static void timer_handler(void *CallBackRef, u8 TmrCtrNumber)
+{
+	if (NumEvents < MAX_EVENTS) {
+		Events[NumEvents].TmrCtrNumber = TmrCtrNumber;
+		Events[NumEvents].Ns = ktime_get_ns();
+	}
+	NumEvents++;
+}
+
+/* The timer interrupt thread of the drivers, without their locks */
+static void timer_service(void *ref, XTmrCtr *TmrCtrPtr)
+{
+	XTmrCtr_InterruptHandler(TmrCtrPtr);
+}
+
+/* Counter reset value for a period of ns, counting up or down */
+static u32 period_ticks(u64 ns, bool down)
+{
+	u32 ticks = (u32)(ns / TICK_NS);
+
+	return down ? ticks - 1 : (u32)(0x100000000ULL - ticks);
+}
+
+static void timer_setup(void)
+{
+	CHECK(XTmrCtr_Initialize(&Timer, 0) == XST_SUCCESS);
+	CHECK(XTmrCtr_IsSoft(&Timer));
+	XTmrCtr_SetHandler(&Timer, timer_handler, NULL);
+	NumEvents = 0;
+}
+
+static void test_single_shot(void)
+{
+	u32 reset = period_ticks(NSEC_PER_MSEC, false);
+	u64 t0;
+
+	timer_setup();
+	XTmrCtr_SetOptions(&Timer, 0, XTC_INT_MODE_OPTION);
+	XTmrCtr_SetResetValue(&Timer, 0, reset);
+	t0 = ktime_get_ns();
+	XTmrCtr_Start(&Timer, 0);
+
+	host_clock_advance(NSEC_PER_MSEC / 2);
+	CHECK(XTmrCtr_GetValue(&Timer, 0) == reset + 50000);
+	CHECK(!XTmrCtr_IsExpired(&Timer, 0));
+
+	host_clock_advance(NSEC_PER_MSEC / 2 - 1);
+	CHECK(NumEvents == 0);
+
+	host_clock_advance(1);
+	CHECK(NumEvents == 1);
+	CHECK(Events[0].TmrCtrNumber == 0);
+	CHECK(Events[0].Ns == t0 + NSEC_PER_MSEC);
+	CHECK(Timer.Stats.Interrupts == 1);
+
+	/* Disabled and reloaded, as the AXI timer */
+	CHECK(XTmrCtr_GetValue(&Timer, 0) == reset);
+	host_clock_advance(10 * NSEC_PER_MSEC);
+	CHECK(NumEvents == 1);
+}
+
+static void test_auto_reload(void)
+{
+	u32 reset = period_ticks(NSEC_PER_MSEC, true);
+	u64 t0;
+	int i;
+
+	timer_setup();
+	XTmrCtr_SetOptions(&Timer, 0, XTC_INT_MODE_OPTION |
+			   XTC_AUTO_RELOAD_OPTION | XTC_DOWN_COUNT_OPTION);
+	XTmrCtr_SetResetValue(&Timer, 0, reset);
+	t0 = ktime_get_ns();
+	XTmrCtr_Start(&Timer, 0);
+
+	host_clock_advance(10 * NSEC_PER_MSEC + NSEC_PER_MSEC / 2);
+	CHECK(NumEvents == 10);
+	for (i = 0; i < min(NumEvents, MAX_EVENTS); i++)
+		CHECK(Events[i].Ns == t0 + (u64)(i + 1) * NSEC_PER_MSEC);
+	CHECK(XTmrCtr_GetValue(&Timer, 0) == reset - 50000);
+
+	/* Stop freezes the value and cancels the expirations */
+	XTmrCtr_Stop(&Timer, 0);
+	host_clock_advance(5 * NSEC_PER_MSEC);
+	CHECK(NumEvents == 10);
+	CHECK(XTmrCtr_GetValue(&Timer, 0) == reset - 50000);
+
+	/* A restart begins a new period */
+	t0 = ktime_get_ns();
+	XTmrCtr_Start(&Timer, 0);
+	host_clock_advance(NSEC_PER_MSEC);
+	CHECK(NumEvents == 11);
+	CHECK(Events[10].Ns == t0 + NSEC_PER_MSEC);
+	XTmrCtr_Stop(&Timer, 0);
+}
+
+static void test_two_counters(void)
+{
+	static const struct {
+		u8 TmrCtrNumber;
+		u64 Ms;
+	} expected[] = { { 0, 3 }, { 1, 5 }, { 0, 6 }, { 0, 9 } };
+	u64 t0;
+	int i;
+
+	timer_setup();
+	XTmrCtr_SetOptions(&Timer, 0, XTC_INT_MODE_OPTION |
+			   XTC_AUTO_RELOAD_OPTION);
+	XTmrCtr_SetResetValue(&Timer, 0, period_ticks(3 * NSEC_PER_MSEC, false));
+	XTmrCtr_SetOptions(&Timer, 1, XTC_INT_MODE_OPTION);
+	XTmrCtr_SetResetValue(&Timer, 1, period_ticks(5 * NSEC_PER_MSEC, false));
+	t0 = ktime_get_ns();
+	XTmrCtr_Start(&Timer, 0);
+	XTmrCtr_Start(&Timer, 1);
+
+	host_clock_advance(10 * NSEC_PER_MSEC);
+	CHECK(NumEvents == ARRAY_SIZE(expected));
+	for (i = 0; i < min_t(int, NumEvents, ARRAY_SIZE(expected)); i++) {
+		CHECK(Events[i].TmrCtrNumber == expected[i].TmrCtrNumber);
+		CHECK(Events[i].Ns == t0 + expected[i].Ms * NSEC_PER_MSEC);
+	}
+	XTmrCtr_Stop(&Timer, 0);
+	XTmrCtr_Stop(&Timer, 1);
+}
+
+static void test_soft_wait(void)
+{
+	u64 t0;
+
+	timer_setup();
+
+	/* Polled counter, below and above the msleep threshold */
+	XTmrCtr_SetOptions(&Timer, 0, 0);
+	XTmrCtr_SetResetValue(&Timer, 0, period_ticks(2 * NSEC_PER_MSEC, false));
+	t0 = ktime_get_ns();
+	XTmrCtr_Start(&Timer, 0);
+	XTmrCtr_SoftWait(&Timer, 0);
+	CHECK(ktime_get_ns() == t0 + 2 * NSEC_PER_MSEC);
+	CHECK(XTmrCtr_IsExpired(&Timer, 0));
+
+	XTmrCtr_SetResetValue(&Timer, 0, period_ticks(50 * NSEC_PER_MSEC, false));
+	t0 = ktime_get_ns();
+	XTmrCtr_Start(&Timer, 0);
+	XTmrCtr_SoftWait(&Timer, 0);
+	CHECK(ktime_get_ns() == t0 + 50 * NSEC_PER_MSEC);
+	CHECK(XTmrCtr_IsExpired(&Timer, 0));
+	XTmrCtr_Stop(&Timer, 0);
+	CHECK(XTmrCtr_IsExpired(&Timer, 0));
+	CHECK(NumEvents == 0);
+
+	/* The handler of an interrupt mode counter runs within the wait */
+	XTmrCtr_SetOptions(&Timer, 0, XTC_INT_MODE_OPTION);
+	XTmrCtr_SetResetValue(&Timer, 0, period_ticks(NSEC_PER_MSEC, false));
+	t0 = ktime_get_ns();
+	XTmrCtr_Start(&Timer, 0);
+	XTmrCtr_SoftWait(&Timer, 0);
+	CHECK(NumEvents == 1);
+	CHECK(Events[0].Ns == t0 + NSEC_PER_MSEC);
+
+	/* Returns at once on a stopped counter */
+	t0 = ktime_get_ns();
+	XTmrCtr_SoftWait(&Timer, 0);
+	CHECK(ktime_get_ns() == t0);
+	XTmrCtr_Stop(&Timer, 0);
+}
+
+static void test_release(void)
+{
+	timer_setup();
+	XTmrCtr_SetOptions(&Timer, 0, XTC_INT_MODE_OPTION |
+			   XTC_AUTO_RELOAD_OPTION);
+	XTmrCtr_SetResetValue(&Timer, 0, period_ticks(NSEC_PER_MSEC, false));
+	XTmrCtr_Start(&Timer, 0);
+	host_clock_advance(NSEC_PER_MSEC);
+	CHECK(NumEvents == 1);
+
+	XTmrCtr_HrTimerRelease(&HrTimer);
+	host_clock_advance(10 * NSEC_PER_MSEC);
+	CHECK(NumEvents == 1);
+
+	/* Arming after the release has no effect either */
+	XTmrCtr_Start(&Timer, 0);
+	host_clock_advance(10 * NSEC_PER_MSEC);
+	CHECK(NumEvents == 1);
+}
+
+int main(void)
+{
+	host_clock_virtual(true);
+	XTmrCtr_HrTimerInitialize(&HrTimer, &XTmrCtr_ConfigTable[0],
+				  timer_service, NULL);
+
+	test_single_shot();
+	test_auto_reload();
+	test_two_counters();
+	test_soft_wait();
+	test_release();
+
+	return host_report("tmrctr_soft");
+}
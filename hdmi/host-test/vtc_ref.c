@@ -0,0 +1,358 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file vtc_ref.c
+*
+* Reference copy of the Generator register writers of xvtc.c as they were
+* before the register image and shadow rewrite, renamed with a Ref_ prefix.
+* vtc_test checks that the register image is bit-exact with what these
+* write. Keep this file unchanged.
+*
+******************************************************************************/
+
+/******************************* Include Files ********************************/
+#include "xvtc.h"
+#include "vtc_ref.h"
+
+/*************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This function sets up the output polarity of the VTC core.
+*
+* @param	InstancePtr is a pointer to the VTC instance to be
+*		worked on.
+* @param	PolarityPtr points to a Polarity configuration structure with
+*		the setting to use on the VTC core.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void Ref_XVtc_SetPolarity(XVtc *InstancePtr, XVtc_Polarity *PolarityPtr)
+{
+	u32 PolRegValue;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid(PolarityPtr != NULL);
+
+	/* Read Control register value back and clear all polarity
+	 * bits first
+	 */
+	PolRegValue = XVtc_ReadReg(InstancePtr->Config.BaseAddress,
+					(XVTC_GPOL_OFFSET));
+	PolRegValue &= (u32)(~(XVTC_POL_ALLP_MASK));
+
+	/* Change the register value according to the setting in the Polarity
+	 * configuration structure
+	 */
+	if (PolarityPtr->ActiveChromaPol)
+		PolRegValue |= XVTC_POL_ACP_MASK;
+
+	if (PolarityPtr->ActiveVideoPol)
+		PolRegValue |= XVTC_POL_AVP_MASK;
+
+	if (PolarityPtr->FieldIdPol)
+		PolRegValue |= XVTC_POL_FIP_MASK;
+
+	if (PolarityPtr->VBlankPol)
+		PolRegValue |= XVTC_POL_VBP_MASK;
+
+	if (PolarityPtr->VSyncPol)
+		PolRegValue |= XVTC_POL_VSP_MASK;
+
+	if (PolarityPtr->HBlankPol)
+		PolRegValue |= XVTC_POL_HBP_MASK;
+
+	if (PolarityPtr->HSyncPol)
+		PolRegValue |= XVTC_POL_HSP_MASK;
+
+	XVtc_WriteReg(InstancePtr->Config.BaseAddress, (XVTC_GPOL_OFFSET),
+			PolRegValue);
+}
+
+/*****************************************************************************/
+/**
+ * This function sets the VBlank/VSync Horizontal Offsets for the Generator
+ * in a VTC device.
+ *
+ * @param  InstancePtr is a pointer to the VTC device instance to be worked on.
+ * @param  HoriOffsets points to a VBlank/VSync Horizontal Offset configuration
+ *	   with the setting to use on the VTC device.
+ * @return NONE.
+ *
+ *****************************************************************************/
+void Ref_XVtc_SetGeneratorHoriOffset(XVtc *InstancePtr,
+				XVtc_HoriOffsets *HoriOffsets)
+{
+	u32 RegValue;
+
+	/* Assert bad arguments and conditions */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid(HoriOffsets != NULL);
+
+	/* Calculate and update Generator VBlank Hori. Offset 0 register value
+	 */
+	RegValue = (HoriOffsets->V0BlankHoriStart) & XVTC_XVXHOX_HSTART_MASK;
+	RegValue |= (HoriOffsets->V0BlankHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
+					XVTC_XVXHOX_HEND_MASK;
+	XVtc_WriteReg(InstancePtr->Config.BaseAddress, XVTC_GVBHOFF_OFFSET,
+								RegValue);
+
+	/* Calculate and update Generator VSync Hori. Offset 0 register
+	 * value
+	 */
+	RegValue = (HoriOffsets->V0SyncHoriStart) & XVTC_XVXHOX_HSTART_MASK;
+	RegValue |= (HoriOffsets->V0SyncHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
+					XVTC_XVXHOX_HEND_MASK;
+	XVtc_WriteReg(InstancePtr->Config.BaseAddress, XVTC_GVSHOFF_OFFSET,
+								RegValue);
+
+	/* Calculate and update Generator VBlank Hori. Offset 1 register
+	 * value
+	 */
+	RegValue = (HoriOffsets->V1BlankHoriStart) & XVTC_XVXHOX_HSTART_MASK;
+	RegValue |= (HoriOffsets->V1BlankHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
+					XVTC_XVXHOX_HEND_MASK;
+	XVtc_WriteReg(InstancePtr->Config.BaseAddress, XVTC_GVBHOFF_F1_OFFSET,
+								RegValue);
+
+	/* Calculate and update Generator VSync Hori. Offset 1 register
+	 * value
+	 */
+	RegValue = (HoriOffsets->V1SyncHoriStart) & XVTC_XVXHOX_HSTART_MASK;
+	RegValue |= (HoriOffsets->V1SyncHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
+					XVTC_XVXHOX_HEND_MASK;
+	XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+						XVTC_GVSHOFF_F1_OFFSET,
+								RegValue);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets up VTC signal to be used by the Generator module
+* in the VTC core.
+*
+* @param	InstancePtr is a pointer to the VTC instance to be
+*		worked on.
+* @param	SignalCfgPtr is a pointer to the VTC signal configuration
+*		to be used by the Generator module in the VTC core.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void Ref_XVtc_SetGenerator(XVtc *InstancePtr, XVtc_Signal *SignalCfgPtr)
+{
+	u32 RegValue;
+	u32 r_htotal, r_vtotal, r_hactive, r_vactive;
+	XVtc_Signal *SCPtr;
+	XVtc_HoriOffsets horiOffsets;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid(SignalCfgPtr != NULL);
+
+	SCPtr = SignalCfgPtr;
+	if(SCPtr->OriginMode == 0)
+	{
+		r_htotal = SCPtr->HTotal+1;
+		r_vtotal = SCPtr->V0Total+1;
+
+		r_hactive = r_htotal - SCPtr->HActiveStart;
+		r_vactive = r_vtotal - SCPtr->V0ActiveStart;
+
+		RegValue = (r_htotal) & XVTC_SB_START_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+					XVTC_GHSIZE_OFFSET, RegValue);
+
+		RegValue = (r_vtotal) & XVTC_VSIZE_F0_MASK;
+		RegValue |= ((SCPtr->V1Total+1) << XVTC_VSIZE_F1_SHIFT) &
+							XVTC_VSIZE_F1_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+					XVTC_GVSIZE_OFFSET, RegValue);
+
+
+		RegValue = (r_hactive) & XVTC_ASIZE_HORI_MASK;
+		RegValue |= ((r_vactive) << XVTC_ASIZE_VERT_SHIFT ) &
+							XVTC_ASIZE_VERT_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+						XVTC_GASIZE_OFFSET, RegValue);
+		/* For some resolutions, the FIELD1 vactive size is different
+		 * from FIELD0, e.g. XVIDC_VM_720x486_60_I (SDI NTSC),
+		 * As there is no vactive FIELD1 entry in the video common
+		 * library, program it separately. For resolutions where
+		 * vactive values are different, it should be taken care in
+		 * corrosponding driver. Otherwise program same values in
+		 * FIELD0 and FIELD1 registers */
+		RegValue = ((r_vactive) << XVTC_ASIZE_VERT_SHIFT) &
+				XVTC_ASIZE_VERT_MASK;
+
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+						XVTC_GASIZE_F1_OFFSET, RegValue);
+
+		/* Update the Generator Horizontal 1 Register */
+		RegValue = (SCPtr->HSyncStart + r_hactive) &
+						XVTC_SB_START_MASK;
+		RegValue |= ((SCPtr->HBackPorchStart + r_hactive) <<
+				XVTC_SB_END_SHIFT) & XVTC_SB_END_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+					XVTC_GHSYNC_OFFSET, RegValue);
+
+		/* Update the Generator Vertical 1 Register (field 0) */
+		RegValue = (SCPtr->V0SyncStart + r_vactive -1) &
+						XVTC_SB_START_MASK;
+		RegValue |= ((SCPtr->V0BackPorchStart + r_vactive -1) <<
+				XVTC_SB_END_SHIFT) & XVTC_SB_END_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+					XVTC_GVSYNC_OFFSET, RegValue);
+
+		/* Update the Generator Vertical Sync Register (field 1) */
+		RegValue = (SCPtr->V1SyncStart + r_vactive -1) &
+						XVTC_SB_START_MASK;
+		RegValue |= ((SCPtr->V1BackPorchStart + r_vactive -1) <<
+					XVTC_SB_END_SHIFT) & XVTC_SB_END_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+					XVTC_GVSYNC_F1_OFFSET, RegValue);
+
+		/* Chroma Start */
+		RegValue = XVtc_ReadReg(InstancePtr->Config.BaseAddress,
+							XVTC_GFENC_OFFSET);
+		RegValue &= ~XVTC_ENC_CPARITY_MASK;
+		RegValue = (((SCPtr->V0ChromaStart - SCPtr->V0ActiveStart) <<
+						XVTC_ENC_CPARITY_SHIFT) &
+					XVTC_ENC_CPARITY_MASK) | RegValue;
+
+		RegValue &= ~XVTC_ENC_PROG_MASK;
+		RegValue |= (SCPtr->Interlaced << XVTC_ENC_PROG_SHIFT) &
+				XVTC_ENC_PROG_MASK;
+
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+						XVTC_GFENC_OFFSET, RegValue);
+
+		/* Setup default Horizontal Offsets - can override later with
+		 * XVtc_SetGeneratorHoriOffset()
+		 */
+		horiOffsets.V0BlankHoriStart = r_hactive;
+		horiOffsets.V0BlankHoriEnd = r_hactive;
+		horiOffsets.V0SyncHoriStart = SCPtr->HSyncStart + r_hactive;
+		horiOffsets.V0SyncHoriEnd = SCPtr->HSyncStart + r_hactive;
+
+		horiOffsets.V1BlankHoriStart = r_hactive;
+		horiOffsets.V1BlankHoriEnd = r_hactive;
+		horiOffsets.V1SyncHoriStart = SCPtr->HSyncStart + r_hactive;
+		horiOffsets.V1SyncHoriEnd = SCPtr->HSyncStart + r_hactive;
+
+	}
+	else
+	{
+		/* Total in mode=1 is the line width */
+		r_htotal = SCPtr->HTotal;
+		/* Total in mode=1 is the frame height */
+		r_vtotal = SCPtr->V0Total;
+		r_hactive = SCPtr->HFrontPorchStart;
+		r_vactive = SCPtr->V0FrontPorchStart;
+
+		RegValue = (r_htotal) & XVTC_SB_START_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+					XVTC_GHSIZE_OFFSET, RegValue);
+
+		RegValue = (r_vtotal) & XVTC_VSIZE_F0_MASK;
+		RegValue |= ((SCPtr->V1Total) << XVTC_VSIZE_F1_SHIFT) &
+							XVTC_VSIZE_F1_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+						XVTC_GVSIZE_OFFSET, RegValue);
+
+
+		RegValue = (r_hactive) & XVTC_ASIZE_HORI_MASK;
+		RegValue |= ((r_vactive) << XVTC_ASIZE_VERT_SHIFT) &
+							XVTC_ASIZE_VERT_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+						XVTC_GASIZE_OFFSET, RegValue);
+		/* For some resolutions, the FIELD1 vactive size is different
+		 * from FIELD0, e.g. XVIDC_VM_720x486_60_I (SDI NTSC),
+		 * As there is no vactive FIELD1 entry in the video common
+		 * library, program it separately. For resolutions where
+		 * vactive values are different, it should be taken care in
+		 * corrosponding driver. Otherwise program same values in
+		 * FIELD0 and FIELD1 registers */
+		RegValue = ((r_vactive) << XVTC_ASIZE_VERT_SHIFT) &
+				XVTC_ASIZE_VERT_MASK;
+
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+						XVTC_GASIZE_F1_OFFSET, RegValue);
+
+		/* Update the Generator Horizontal 1 Register */
+		RegValue = (SCPtr->HSyncStart) & XVTC_SB_START_MASK;
+		RegValue |= ((SCPtr->HBackPorchStart) << XVTC_SB_END_SHIFT) &
+						XVTC_SB_END_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+					XVTC_GHSYNC_OFFSET, RegValue);
+
+
+		/* Update the Generator Vertical Sync Register (field 0) */
+		RegValue = (SCPtr->V0SyncStart) & XVTC_SB_START_MASK;
+		RegValue |= ((SCPtr->V0BackPorchStart) << XVTC_SB_END_SHIFT) &
+						XVTC_SB_END_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+						XVTC_GVSYNC_OFFSET, RegValue);
+
+		/* Update the Generator Vertical Sync Register (field 1) */
+		RegValue = (SCPtr->V1SyncStart) & XVTC_SB_START_MASK;
+		RegValue |= ((SCPtr->V1BackPorchStart) << XVTC_SB_END_SHIFT) &
+						XVTC_SB_END_MASK;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+					XVTC_GVSYNC_F1_OFFSET, RegValue);
+
+		/* Chroma Start */
+		  RegValue = XVtc_ReadReg(InstancePtr->Config.BaseAddress,
+							XVTC_GFENC_OFFSET);
+		RegValue &= ~XVTC_ENC_CPARITY_MASK;
+		RegValue = (((SCPtr->V0ChromaStart - SCPtr->V0ActiveStart) <<
+							XVTC_ENC_CPARITY_SHIFT)
+					& XVTC_ENC_CPARITY_MASK) | RegValue;
+
+		RegValue &= ~XVTC_ENC_PROG_MASK;
+		RegValue |= (SCPtr->Interlaced << XVTC_ENC_PROG_SHIFT) &
+						XVTC_ENC_PROG_MASK;
+
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+					XVTC_GFENC_OFFSET, RegValue);
+
+		/* Setup default Horizontal Offsets - can override later with
+		 * XVtc_SetGeneratorHoriOffset()
+		 */
+		horiOffsets.V0BlankHoriStart = r_hactive;
+		horiOffsets.V0BlankHoriEnd = r_hactive;
+		horiOffsets.V0SyncHoriStart = SCPtr->HSyncStart;
+		horiOffsets.V0SyncHoriEnd = SCPtr->HSyncStart;
+		horiOffsets.V1BlankHoriStart = r_hactive;
+		horiOffsets.V1BlankHoriEnd = r_hactive;
+		horiOffsets.V1SyncHoriStart = SCPtr->HSyncStart;
+		horiOffsets.V1SyncHoriEnd = SCPtr->HSyncStart;
+
+	}
+	Ref_XVtc_SetGeneratorHoriOffset(InstancePtr, &horiOffsets);
+
+}
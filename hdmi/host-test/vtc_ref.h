@@ -0,0 +1,34 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file vtc_ref.h
+*
+* The reference Generator register writers of vtc_ref.c.
+*
+******************************************************************************/
+
+#ifndef VTC_REF_H
+#define VTC_REF_H
+
+#include "xvtc.h"
+
+void Ref_XVtc_SetPolarity(XVtc *InstancePtr, XVtc_Polarity *PolarityPtr);
+void Ref_XVtc_SetGeneratorHoriOffset(XVtc *InstancePtr,
+		XVtc_HoriOffsets *HoriOffsets);
+void Ref_XVtc_SetGenerator(XVtc *InstancePtr, XVtc_Signal *SignalCfgPtr);
+
+#endif /* VTC_REF_H */
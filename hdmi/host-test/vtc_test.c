@@ -0,0 +1,194 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file vtc_test.c
+*
+* Unit test of the VTC Generator register image (xvtc.c). For every entry of
+* xvidc_timings_table.c, progressive and interlaced, the image built by
+* XVtc_ConvTiming2GeneratorRegs and written by XVtc_CommitGenerator must
+* leave the same register file as the reference writers of vtc_ref.c, as
+* must XVtc_SetGeneratorTiming and XVtc_SetGenerator. The shadow must skip
+* unchanged registers and write the changed ones only.
+*
+******************************************************************************/
+
+#include <string.h>
+#include "xvtc.h"
+#include "xvidc.h"
+#include "vtc_ref.h"
+#include "host.h"
+
+#define NUM_REGS	((XVTC_GGD_OFFSET / 4) + 1)
+
+extern const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED];
+
+/* Register files of the VTC under test and of the reference */
+static u32 Regs[NUM_REGS];
+static u32 RefRegs[NUM_REGS];
+
+static void vtc_init(XVtc *Vtc, u32 *RegFile)
+{
+	XVtc_Config Cfg;
+
+	memset(&Cfg, 0, sizeof(Cfg));
+	memset(RegFile, 0, sizeof(Regs));
+	XVtc_CfgInitialize(Vtc, &Cfg, (UINTPTR)RegFile);
+}
+
+/* As XV_HdmiTxSs_VtcSetup, at one pixel per clock */
+static void vtc_timing(const XVidC_VideoTiming *Vt, u8 Interlaced,
+		XVtc_Timing *Timing)
+{
+	memset(Timing, 0, sizeof(*Timing));
+	Timing->HActiveVideo = Vt->HActive;
+	Timing->HFrontPorch = Vt->HFrontPorch;
+	Timing->HSyncWidth = Vt->HSyncWidth;
+	Timing->HBackPorch = Vt->HBackPorch;
+	Timing->HSyncPolarity = Vt->HSyncPolarity;
+	Timing->VActiveVideo = Vt->VActive;
+	Timing->V0FrontPorch = Vt->F0PVFrontPorch;
+	Timing->V0SyncWidth = Vt->F0PVSyncWidth;
+	Timing->V0BackPorch = Vt->F0PVBackPorch;
+	Timing->V1FrontPorch = Vt->F1VFrontPorch;
+	Timing->V1SyncWidth = Vt->F1VSyncWidth;
+	Timing->V1BackPorch = Vt->F1VBackPorch;
+	Timing->VSyncPolarity = Vt->VSyncPolarity;
+	Timing->Interlaced = Interlaced;
+}
+
+/* The original XVtc_SetGeneratorTiming, optionally with another polarity */
+static void ref_set_timing(XVtc *Ref, XVtc_Timing *Timing,
+		XVtc_Polarity *PolarityPtr)
+{
+	XVtc_Polarity Polarity;
+	XVtc_Signal Signal;
+	XVtc_HoriOffsets Hoff;
+
+	XVtc_ConvTiming2Signal(Ref, Timing, &Signal, &Hoff, &Polarity);
+	Ref_XVtc_SetPolarity(Ref, PolarityPtr ? PolarityPtr : &Polarity);
+	Ref_XVtc_SetGenerator(Ref, &Signal);
+	Ref_XVtc_SetGeneratorHoriOffset(Ref, &Hoff);
+}
+
+static int regs_equal(void)
+{
+	return !memcmp(Regs, RefRegs, sizeof(Regs));
+}
+
+/* A full commit from an invalid shadow matches the reference */
+static void test_full(void)
+{
+	XVtc_GeneratorRegs Image;
+	XVtc_HoriOffsets Hoff;
+	XVtc_Polarity Polarity;
+	XVtc_Signal Signal;
+	XVtc_Timing Timing;
+	XVtc Vtc, Ref;
+	u32 Mode;
+	u8 Interlaced;
+
+	for (Mode = 0; Mode < XVIDC_VM_NUM_SUPPORTED; Mode++) {
+		for (Interlaced = 0; Interlaced <= 1; Interlaced++) {
+			vtc_timing(&XVidC_VideoTimingModes[Mode].Timing,
+				   Interlaced, &Timing);
+
+			/* Polarity derived from the timing */
+			vtc_init(&Ref, RefRegs);
+			ref_set_timing(&Ref, &Timing, NULL);
+			vtc_init(&Vtc, Regs);
+			XVtc_ConvTiming2GeneratorRegs(&Vtc, &Timing, NULL, &Image);
+			CHECK(XVtc_CommitGenerator(&Vtc, &Image) ==
+			      XVTC_GEN_NUM_REGS);
+			CHECK(regs_equal());
+
+			/* Through the compatibility entry point */
+			vtc_init(&Vtc, Regs);
+			XVtc_SetGeneratorTiming(&Vtc, &Timing);
+			CHECK(regs_equal());
+
+			/* XVtc_SetGenerator also takes origin mode 0 signals */
+			XVtc_ConvTiming2Signal(&Vtc, &Timing, &Signal, &Hoff,
+					       &Polarity);
+			Signal.OriginMode = 0;
+			vtc_init(&Ref, RefRegs);
+			Ref_XVtc_SetGenerator(&Ref, &Signal);
+			vtc_init(&Vtc, Regs);
+			XVtc_SetGenerator(&Vtc, &Signal);
+			CHECK(regs_equal());
+
+			/* Polarity as set up by the HDMI TX subsystem */
+			memset(&Polarity, 0, sizeof(Polarity));
+			Polarity.ActiveChromaPol = 1;
+			Polarity.ActiveVideoPol = 1;
+			Polarity.FieldIdPol = Interlaced;
+			Polarity.VBlankPol = Timing.VSyncPolarity;
+			Polarity.VSyncPol = Timing.VSyncPolarity;
+			Polarity.HBlankPol = Timing.HSyncPolarity;
+			Polarity.HSyncPol = Timing.HSyncPolarity;
+			vtc_init(&Ref, RefRegs);
+			ref_set_timing(&Ref, &Timing, &Polarity);
+			vtc_init(&Vtc, Regs);
+			XVtc_ConvTiming2GeneratorRegs(&Vtc, &Timing, &Polarity,
+						      &Image);
+			XVtc_CommitGenerator(&Vtc, &Image);
+			CHECK(regs_equal());
+		}
+	}
+}
+
+/* Going from mode to mode writes only the changed registers */
+static void test_delta(void)
+{
+	XVtc_GeneratorRegs Image, Prev;
+	XVtc_Timing Timing;
+	XVtc Vtc, Ref;
+	u32 Mode, Index, Changed;
+	u8 Interlaced;
+
+	vtc_init(&Vtc, Regs);
+	for (Mode = 0; Mode < XVIDC_VM_NUM_SUPPORTED; Mode++) {
+		for (Interlaced = 0; Interlaced <= 1; Interlaced++) {
+			vtc_timing(&XVidC_VideoTimingModes[Mode].Timing,
+				   Interlaced, &Timing);
+			Prev = Vtc.GenShadow;
+			XVtc_ConvTiming2GeneratorRegs(&Vtc, &Timing, NULL, &Image);
+
+			Changed = 0;
+			for (Index = 0; Index < XVTC_GEN_NUM_REGS; Index++)
+				Changed += Image.Reg[Index] != Prev.Reg[Index];
+			if (!Vtc.GenShadowValid)
+				Changed = XVTC_GEN_NUM_REGS;
+			CHECK(XVtc_CommitGenerator(&Vtc, &Image) == Changed);
+			CHECK(XVtc_CommitGenerator(&Vtc, &Image) == 0);
+
+			vtc_init(&Ref, RefRegs);
+			ref_set_timing(&Ref, &Timing, NULL);
+			CHECK(regs_equal());
+		}
+	}
+
+	/* An invalidated shadow writes everything again */
+	XVtc_InvalidateGenerator(&Vtc);
+	CHECK(XVtc_CommitGenerator(&Vtc, &Image) == XVTC_GEN_NUM_REGS);
+}
+
+int main(void)
+{
+	test_full();
+	test_delta();
+	return host_report("vtc_test");
+}
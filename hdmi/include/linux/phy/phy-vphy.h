@@ -24,10 +24,22 @@
 
 struct phy;
 
+/* largest EDID passed from the TX to the RX user of the PHY */
+#define XVPHY_EDID_MAX_SIZE (10 * 128)
+
 /* VPHY is built (either as module or built-in) */
 extern void *xvphy_get_xvphy(struct phy *phy);
 extern void xvphy_mutex_lock(struct phy *phy);
 extern void xvphy_mutex_unlock(struct phy *phy);
+extern void xvphy_domain_lock(struct phy *phy);
+extern void xvphy_domain_unlock(struct phy *phy);
+extern void xvphy_quad_lock(struct phy *phy);
+extern void xvphy_quad_unlock(struct phy *phy);
+extern int xvphy_edid_publish(struct phy *phy, const u8 *edid, int len);
+extern int xvphy_edid_get(struct phy *phy, u8 *buf, int size);
+extern void xvphy_edid_set_notify(struct phy *phy, void (*notify)(void *ctx), void *ctx);
+extern void xvphy_hdcp22_register(struct phy *phy, void *hdcp22,
+				  int (*claim)(void *ctx, bool claim), void *ctx);
 extern int xvphy_do_something(struct phy *phy);
 
 #endif /* _PHY_VPHY_H_ */
@@ -0,0 +1,33 @@
+/* SPDX-License-Identifier: GPL-2.0 WITH Linux-syscall-note */
+/*
+ * Xilinx HDMI RX subsystem events
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ */
+
+#ifndef _UAPI_XILINX_HDMIRX_H_
+#define _UAPI_XILINX_HDMIRX_H_
+
+#include <linux/types.h>
+#include <linux/videodev2.h>
+
+/*
+ * Raised when the character error rate of the link crosses the degrade
+ * threshold in either direction. The payload in v4l2_event.u.data is a
+ * struct xhdmi_link_quality_event.
+ */
+#define XHDMI_EVENT_LINK_QUALITY	(V4L2_EVENT_PRIVATE_START + 0x10)
+
+#define XHDMI_LINK_CHANNELS		3
+
+/**
+ * struct xhdmi_link_quality_event - XHDMI_EVENT_LINK_QUALITY payload
+ * @degraded: 1 if the link is degraded, 0 if it recovered
+ * @errors: character errors per second of each TMDS channel
+ */
+struct xhdmi_link_quality_event {
+	__u32 degraded;
+	__u32 errors[XHDMI_LINK_CHANNELS];
+};
+
+#endif /* _UAPI_XILINX_HDMIRX_H_ */
@@ -37,6 +37,8 @@
 #include <linux/list.h>
 #include <linux/slab.h>
 #include <linux/interrupt.h>
+#include <linux/spinlock.h>
+#include <linux/workqueue.h>
 
 #include "linux/phy/phy-vphy.h"
 
@@ -50,9 +52,11 @@
 #include "phy-xilinx-vphy/xdebug.h"
 #include "phy-xilinx-vphy/xvidc.h"
 #include "phy-xilinx-vphy/xtmrctr.h"
+#include "phy-xilinx-vphy/xtmrctr_hrtimer.h"
 #include "phy-xilinx-vphy/xhdcp1x.h"
 #include "phy-xilinx-vphy/xhdcp22_rx.h"
 #include "phy-xilinx-vphy/xhdcp22_tx.h"
+#include "phy-xilinx-vphy/xhdcp22_loopback.h"
 #include "phy-xilinx-vphy/bigdigits.h"
 #include "phy-xilinx-vphy/xhdcp22_cipher.h"
 #include "phy-xilinx-vphy/xhdcp22_mmult.h"
@@ -67,6 +71,24 @@
 #define XHDMIPHY1_DRU_REF_CLK_HZ	200000000
 #define XVPHY_MAX_LANES			6
 
+/* number of interrupt sources tracked in xvphy_irq_sources[] */
+#define XVPHY_IRQ_NUM_SOURCES		14
+/* more than THRESHOLD interrupts within WINDOW is considered a storm */
+#define XVPHY_IRQ_STORM_WINDOW_MS	100
+#define XVPHY_IRQ_STORM_THRESHOLD	200
+/* interrupts stay masked for MIN, doubling up to MAX while the storm lasts */
+#define XVPHY_IRQ_BACKOFF_MIN_MS	10
+#define XVPHY_IRQ_BACKOFF_MAX_MS	1000
+/* max. handler runs per thread invocation for events latched meanwhile */
+#define XVPHY_IRQ_THREAD_BUDGET		4
+
+/* locking domains, indexed by xvphy_lane.direction_tx */
+#define XVPHY_DOMAIN_RX			0
+#define XVPHY_DOMAIN_TX			1
+
+/* max. iterations of the HDCP 2.2 loopback test vectors per sysfs write */
+#define XVPHY_HDCP22_LOOPBACK_MAX_ITERATIONS	100
+
 #define hdmi_mutex_lock(x) mutex_lock(x)
 #define hdmi_mutex_unlock(x) mutex_unlock(x)
 
@@ -95,6 +117,37 @@ struct xvphy_lane {
 	u32 share_laneclk;
 };
 
+/**
+ * struct xvphy_irq_source - description of an interrupt source
+ * @mask: bit in the interrupt status register
+ * @name: name reported in irq_stats
+ * @coalesce_ms: if the source fires again within this window after being
+ *	serviced, it is held masked until the window expires (0 = never)
+ */
+struct xvphy_irq_source {
+	u32 mask;
+	const char *name;
+	unsigned int coalesce_ms;
+};
+
+/**
+ * struct xvphy_irq_stats - interrupt counters
+ * @count: interrupts seen per source
+ * @deferred: times a source was held off by coalescing
+ * @total: hard interrupts
+ * @spurious: hard interrupts without a known source pending
+ * @thread_runs: baremetal interrupt handler invocations
+ * @storms: interrupt storms detected
+ */
+struct xvphy_irq_stats {
+	u64 count[XVPHY_IRQ_NUM_SOURCES];
+	u64 deferred[XVPHY_IRQ_NUM_SOURCES];
+	u64 total;
+	u64 spurious;
+	u64 thread_runs;
+	u64 storms;
+};
+
 /**
  * struct xvphy_dev - representation of a Xilinx Video PHY
  * @dev: pointer to device
@@ -105,8 +158,18 @@ struct xvphy_dev {
 	/* virtual remapped I/O memory */
 	void __iomem *iomem;
 	int irq;
-	/* protects the XVphy/XHdmiphy1 baseline against concurrent access */
+	/* protects the quad resources shared by TX and RX (QPLL, DRP ports,
+	 * clock detector); the XVphy baseline takes it around the sections that
+	 * access them, for XHdmiphy1 it is held across the baseline calls */
 	struct mutex xvphy_mutex;
+	/* serialize the TX and RX users of the PHY and their channels, each
+	 * taken before xvphy_mutex; both domains point to tx_mutex if TX and
+	 * RX share a PLL */
+	struct mutex tx_mutex;
+	struct mutex rx_mutex;
+	struct mutex *domain_mutex[2];
+	/* interrupt sources serviced in each domain */
+	u32 domain_intr_mask[2];
 	struct xvphy_lane *lanes[XVPHY_MAX_LANES];
 	/* bookkeeping for the baseline subsystem driver instance */
 	XVphy xvphy;
@@ -117,6 +180,38 @@ struct xvphy_dev {
 	struct clk *dru_clk;
 	/* If Video Phy flag */
 	u32 isvphy;
+	/* protects the interrupt bookkeeping below, taken in hard IRQ */
+	spinlock_t irq_lock;
+	/* status accumulated by the hard IRQ handler for the thread */
+	u32 irq_pending;
+	/* sources held masked until their coalescing window expires */
+	u32 irq_deferred;
+	unsigned long irq_last[XVPHY_IRQ_NUM_SOURCES];
+	unsigned long irq_deadline[XVPHY_IRQ_NUM_SOURCES];
+	/* storm detection and backoff */
+	unsigned long storm_window;
+	u32 storm_count;
+	u32 storm_backoff_ms;
+	unsigned long storm_until;
+	bool storm;
+	/* re-enables held sources */
+	struct delayed_work irq_work;
+	struct xvphy_irq_stats irq_stats;
+	/* EDID read by the TX user, for pass-through to the RX user */
+	struct mutex edid_mutex;
+	u8 edid[XVPHY_EDID_MAX_SIZE];
+	int edid_len;
+	/* RX side notification of a new EDID, called with edid_mutex held */
+	void (*edid_notify)(void *ctx);
+	void *edid_notify_ctx;
+	/* HDCP 2.2 instances of the RX and TX users, indexed by domain, and
+	 * their claim callbacks, for the loopback benchmark */
+	struct mutex hdcp22_mutex;
+	void *hdcp22[2];
+	int (*hdcp22_claim[2])(void *ctx, bool claim);
+	void *hdcp22_ctx[2];
+	/* results of the last loopback run */
+	char *hdcp22_loopback_log;
 };
 
 /* given the (Linux) phy handle, return the xvphy */
@@ -134,12 +229,16 @@ EXPORT_SYMBOL_GPL(xvphy_get_xvphy);
 
 /* given the (Linux) phy handle, enter critical section of xvphy baseline code
  * XVphy/XHdmiphy1 functions must be called with mutex acquired to prevent concurrent access
- * by XVphy/XHdmiphy1 and upper-layer video protocol drivers */
+ * by XVphy/XHdmiphy1 and upper-layer video protocol drivers.
+ * This takes the locking domain of the lane direction, then the quad lock if
+ * the baseline does not take it itself (XHdmiphy1). */
 void xvphy_mutex_lock(struct phy *phy)
 {
 	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
 	struct xvphy_dev *vphy_dev = vphy_lane->data;
-	hdmi_mutex_lock(&vphy_dev->xvphy_mutex);
+	hdmi_mutex_lock(vphy_dev->domain_mutex[vphy_lane->direction_tx]);
+	if (!vphy_dev->isvphy)
+		hdmi_mutex_lock(&vphy_dev->xvphy_mutex);
 }
 EXPORT_SYMBOL_GPL(xvphy_mutex_lock);
 
@@ -147,10 +246,138 @@ void xvphy_mutex_unlock(struct phy *phy)
 {
 	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
 	struct xvphy_dev *vphy_dev = vphy_lane->data;
-	hdmi_mutex_unlock(&vphy_dev->xvphy_mutex);
+	if (!vphy_dev->isvphy)
+		hdmi_mutex_unlock(&vphy_dev->xvphy_mutex);
+	hdmi_mutex_unlock(vphy_dev->domain_mutex[vphy_lane->direction_tx]);
 }
 EXPORT_SYMBOL_GPL(xvphy_mutex_unlock);
 
+/* given the (Linux) phy handle, enter the locking domain of the lane direction
+ * only. Use this to serialize longer TX or RX sequences that do not access the
+ * PHY; take xvphy_quad_lock() inside it around XVphy/XHdmiphy1 calls. */
+void xvphy_domain_lock(struct phy *phy)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+	struct xvphy_dev *vphy_dev = vphy_lane->data;
+	hdmi_mutex_lock(vphy_dev->domain_mutex[vphy_lane->direction_tx]);
+}
+EXPORT_SYMBOL_GPL(xvphy_domain_lock);
+
+void xvphy_domain_unlock(struct phy *phy)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+	struct xvphy_dev *vphy_dev = vphy_lane->data;
+	hdmi_mutex_unlock(vphy_dev->domain_mutex[vphy_lane->direction_tx]);
+}
+EXPORT_SYMBOL_GPL(xvphy_domain_unlock);
+
+/* given the (Linux) phy handle, take the quad lock with the domain lock held;
+ * nothing to do for XVphy, whose baseline takes it around the shared sections */
+void xvphy_quad_lock(struct phy *phy)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+	struct xvphy_dev *vphy_dev = vphy_lane->data;
+	if (!vphy_dev->isvphy)
+		hdmi_mutex_lock(&vphy_dev->xvphy_mutex);
+}
+EXPORT_SYMBOL_GPL(xvphy_quad_lock);
+
+void xvphy_quad_unlock(struct phy *phy)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+	struct xvphy_dev *vphy_dev = vphy_lane->data;
+	if (!vphy_dev->isvphy)
+		hdmi_mutex_unlock(&vphy_dev->xvphy_mutex);
+}
+
+/* XVphy register lock handler, serializes the baseline sections that access
+ * the quad resources shared by TX and RX */
+static void xvphy_reg_lock(void *ref, u8 lock)
+{
+	struct xvphy_dev *vphy_dev = ref;
+
+	if (lock)
+		hdmi_mutex_lock(&vphy_dev->xvphy_mutex);
+	else
+		hdmi_mutex_unlock(&vphy_dev->xvphy_mutex);
+}
+EXPORT_SYMBOL_GPL(xvphy_quad_unlock);
+
+/* given the (Linux) phy handle, publish the downstream EDID read by the TX
+ * user of the PHY, and notify the RX user if it subscribed. A length of zero
+ * withdraws the EDID. */
+int xvphy_edid_publish(struct phy *phy, const u8 *edid, int len)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+	struct xvphy_dev *vphy_dev = vphy_lane->data;
+
+	if (len < 0 || len > XVPHY_EDID_MAX_SIZE || (len && !edid))
+		return -EINVAL;
+
+	hdmi_mutex_lock(&vphy_dev->edid_mutex);
+	if (len)
+		memcpy(vphy_dev->edid, edid, len);
+	vphy_dev->edid_len = len;
+	if (vphy_dev->edid_notify)
+		vphy_dev->edid_notify(vphy_dev->edid_notify_ctx);
+	hdmi_mutex_unlock(&vphy_dev->edid_mutex);
+	return 0;
+}
+EXPORT_SYMBOL_GPL(xvphy_edid_publish);
+
+/* given the (Linux) phy handle, copy the published EDID into buf,
+ * returns the number of bytes copied, 0 if there is none */
+int xvphy_edid_get(struct phy *phy, u8 *buf, int size)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+	struct xvphy_dev *vphy_dev = vphy_lane->data;
+	int len;
+
+	hdmi_mutex_lock(&vphy_dev->edid_mutex);
+	len = min(size, vphy_dev->edid_len);
+	memcpy(buf, vphy_dev->edid, len);
+	hdmi_mutex_unlock(&vphy_dev->edid_mutex);
+	return len;
+}
+EXPORT_SYMBOL_GPL(xvphy_edid_get);
+
+/* given the (Linux) phy handle, (un)subscribe to EDID updates. notify is
+ * called with the EDID lock held and must only schedule work. After
+ * unsubscribing (notify == NULL) it is guaranteed not to be called anymore. */
+void xvphy_edid_set_notify(struct phy *phy, void (*notify)(void *ctx), void *ctx)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+	struct xvphy_dev *vphy_dev = vphy_lane->data;
+
+	hdmi_mutex_lock(&vphy_dev->edid_mutex);
+	vphy_dev->edid_notify = notify;
+	vphy_dev->edid_notify_ctx = ctx;
+	hdmi_mutex_unlock(&vphy_dev->edid_mutex);
+}
+EXPORT_SYMBOL_GPL(xvphy_edid_set_notify);
+
+/* given the (Linux) phy handle, register the HDCP 2.2 instance of the TX
+ * (XHdcp22_Tx) or RX (XHdcp22_Rx) user of the PHY for the loopback benchmark.
+ * claim(ctx, true) lends the instance to the loopback if the link is idle,
+ * after which the user must not poll it, or returns -EBUSY. claim(ctx, false)
+ * re-initializes the instance through the subsystem and gives it back.
+ * hdcp22 == NULL unregisters, which waits for a running loopback. Must not be
+ * called with a lock held that claim takes. */
+void xvphy_hdcp22_register(struct phy *phy, void *hdcp22,
+			   int (*claim)(void *ctx, bool claim), void *ctx)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+	struct xvphy_dev *vphy_dev = vphy_lane->data;
+	int domain = vphy_lane->direction_tx;
+
+	hdmi_mutex_lock(&vphy_dev->hdcp22_mutex);
+	vphy_dev->hdcp22[domain] = hdcp22;
+	vphy_dev->hdcp22_claim[domain] = hdcp22 ? claim : NULL;
+	vphy_dev->hdcp22_ctx[domain] = hdcp22 ? ctx : NULL;
+	hdmi_mutex_unlock(&vphy_dev->hdcp22_mutex);
+}
+EXPORT_SYMBOL_GPL(xvphy_hdcp22_register);
+
 /* XVphy functions must be called with mutex acquired to prevent concurrent access
  * by XVphy and upper-layer video protocol drivers */
 EXPORT_SYMBOL_GPL(XVphy_GetPllType);
@@ -192,69 +419,304 @@ EXPORT_SYMBOL_GPL(XHdmiphy1_ClkDetFreqReset);
 EXPORT_SYMBOL_GPL(XHdmiphy1_ClkDetGetRefClkFreqHz);
 EXPORT_SYMBOL_GPL(XHdmiphy1_TxPllreset);
 
+#define XVPHY_INTR_ALL_MASK (XVPHY_INTR_HANDLER_TYPE_TXRESET_DONE | \
+			XVPHY_INTR_HANDLER_TYPE_RXRESET_DONE | \
+			XVPHY_INTR_HANDLER_TYPE_CPLL_LOCK | \
+			XVPHY_INTR_HANDLER_TYPE_QPLL0_LOCK | \
+			XVPHY_INTR_HANDLER_TYPE_TXALIGN_DONE | \
+			XVPHY_INTR_HANDLER_TYPE_QPLL1_LOCK | \
+			XVPHY_INTR_HANDLER_TYPE_TX_CLKDET_FREQ_CHANGE | \
+			XVPHY_INTR_HANDLER_TYPE_RX_CLKDET_FREQ_CHANGE | \
+			XVPHY_INTR_HANDLER_TYPE_TX_MMCM_LOCK_CHANGE | \
+			XVPHY_INTR_HANDLER_TYPE_RX_MMCM_LOCK_CHANGE | \
+			XVPHY_INTR_HANDLER_TYPE_TX_TMR_TIMEOUT | \
+			XVPHY_INTR_HANDLER_TYPE_RX_TMR_TIMEOUT)
+
+#define XHDMIPHY1_INTR_ALL_MASK (XHDMIPHY1_INTR_HANDLER_TYPE_TXRESET_DONE | \
+			XHDMIPHY1_INTR_HANDLER_TYPE_RXRESET_DONE | \
+			XHDMIPHY1_INTR_HANDLER_TYPE_LCPLL_LOCK | \
+			XHDMIPHY1_INTR_HANDLER_TYPE_RPLL_LOCK | \
+			XHDMIPHY1_INTR_HANDLER_TYPE_TX_GPO_RISING_EDGE | \
+			XHDMIPHY1_INTR_HANDLER_TYPE_RX_GPO_RISING_EDGE | \
+			XHDMIPHY1_INTR_HANDLER_TYPE_TX_CLKDET_FREQ_CHANGE | \
+			XHDMIPHY1_INTR_HANDLER_TYPE_RX_CLKDET_FREQ_CHANGE | \
+			XHDMIPHY1_INTR_HANDLER_TYPE_TX_MMCM_LOCK_CHANGE | \
+			XHDMIPHY1_INTR_HANDLER_TYPE_RX_MMCM_LOCK_CHANGE | \
+			XHDMIPHY1_INTR_HANDLER_TYPE_TX_TMR_TIMEOUT | \
+			XHDMIPHY1_INTR_HANDLER_TYPE_RX_TMR_TIMEOUT)
+
+/* interrupt sources, in the order they are reported in irq_stats */
+static const struct xvphy_irq_source xvphy_irq_sources[XVPHY_IRQ_NUM_SOURCES] = {
+	{ XVPHY_INTR_TXRESETDONE_MASK,		"tx_reset_done",	0 },
+	{ XVPHY_INTR_RXRESETDONE_MASK,		"rx_reset_done",	0 },
+	{ XVPHY_INTR_CPLL_LOCK_MASK,		"cpll_lock",		20 },
+	{ XVPHY_INTR_QPLL0_LOCK_MASK,		"qpll0_lcpll_lock",	20 },
+	{ XVPHY_INTR_TXALIGNDONE_MASK,		"tx_align_done",	0 },
+	{ XVPHY_INTR_QPLL1_LOCK_MASK,		"qpll1_rpll_lock",	20 },
+	{ XVPHY_INTR_TXCLKDETFREQCHANGE_MASK,	"tx_clkdet_freq_change", 50 },
+	{ XVPHY_INTR_RXCLKDETFREQCHANGE_MASK,	"rx_clkdet_freq_change", 50 },
+	{ XVPHY_INTR_TXMMCMUSRCLK_LOCK_MASK,	"tx_mmcm_lock",		20 },
+	{ XVPHY_INTR_RXMMCMUSRCLK_LOCK_MASK,	"rx_mmcm_lock",		20 },
+	{ XHDMIPHY1_INTR_TXGPO_RE_MASK,		"tx_gpo_rising_edge",	0 },
+	{ XHDMIPHY1_INTR_RXGPO_RE_MASK,		"rx_gpo_rising_edge",	0 },
+	{ XVPHY_INTR_TXTMRTIMEOUT_MASK,		"tx_tmr_timeout",	0 },
+	{ XVPHY_INTR_RXTMRTIMEOUT_MASK,		"rx_tmr_timeout",	0 },
+};
+
+static u32 xvphy_intr_all_mask(struct xvphy_dev *vphydev)
+{
+	return vphydev->isvphy ? XVPHY_INTR_ALL_MASK : XHDMIPHY1_INTR_ALL_MASK;
+}
+
+static u32 xvphy_intr_status(struct xvphy_dev *vphydev)
+{
+	if (vphydev->isvphy)
+		return XVphy_ReadReg(vphydev->xvphy.Config.BaseAddr, XVPHY_INTR_STS_REG);
+
+	return XHdmiphy1_ReadReg(vphydev->xgtphy.Config.BaseAddr, XHDMIPHY1_INTR_STS_REG);
+}
+
 static void xvphy_intr_disable(struct xvphy_dev *vphydev)
 {
 	if (vphydev->isvphy)
-		XVphy_IntrDisable(&vphydev->xvphy, XVPHY_INTR_HANDLER_TYPE_TXRESET_DONE |
-			XVPHY_INTR_HANDLER_TYPE_RXRESET_DONE |
-			XVPHY_INTR_HANDLER_TYPE_CPLL_LOCK |
-			XVPHY_INTR_HANDLER_TYPE_QPLL0_LOCK |
-			XVPHY_INTR_HANDLER_TYPE_TXALIGN_DONE |
-			XVPHY_INTR_HANDLER_TYPE_QPLL1_LOCK |
-			XVPHY_INTR_HANDLER_TYPE_TX_CLKDET_FREQ_CHANGE |
-			XVPHY_INTR_HANDLER_TYPE_RX_CLKDET_FREQ_CHANGE |
-			XVPHY_INTR_HANDLER_TYPE_TX_MMCM_LOCK_CHANGE |
-			XVPHY_INTR_HANDLER_TYPE_RX_MMCM_LOCK_CHANGE |
-			XVPHY_INTR_HANDLER_TYPE_TX_TMR_TIMEOUT |
-			XVPHY_INTR_HANDLER_TYPE_RX_TMR_TIMEOUT);
+		XVphy_IntrDisable(&vphydev->xvphy, XVPHY_INTR_ALL_MASK);
 	else
-		XHdmiphy1_IntrDisable(&vphydev->xgtphy, XHDMIPHY1_INTR_HANDLER_TYPE_TXRESET_DONE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RXRESET_DONE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_LCPLL_LOCK |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RPLL_LOCK |
-			XHDMIPHY1_INTR_HANDLER_TYPE_TX_GPO_RISING_EDGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RX_GPO_RISING_EDGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_TX_CLKDET_FREQ_CHANGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RX_CLKDET_FREQ_CHANGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_TX_MMCM_LOCK_CHANGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RX_MMCM_LOCK_CHANGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_TX_TMR_TIMEOUT |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RX_TMR_TIMEOUT);
+		XHdmiphy1_IntrDisable(&vphydev->xgtphy, XHDMIPHY1_INTR_ALL_MASK);
 }
 
-static void xvphy_intr_enable(struct xvphy_dev *vphydev)
+static void xvphy_intr_enable_mask(struct xvphy_dev *vphydev, u32 mask)
 {
 	if (vphydev->isvphy)
-		XVphy_IntrEnable(&vphydev->xvphy, XVPHY_INTR_HANDLER_TYPE_TXRESET_DONE |
-			XVPHY_INTR_HANDLER_TYPE_RXRESET_DONE |
-			XVPHY_INTR_HANDLER_TYPE_CPLL_LOCK |
-			XVPHY_INTR_HANDLER_TYPE_QPLL0_LOCK |
-			XVPHY_INTR_HANDLER_TYPE_TXALIGN_DONE |
-			XVPHY_INTR_HANDLER_TYPE_QPLL1_LOCK |
-			XVPHY_INTR_HANDLER_TYPE_TX_CLKDET_FREQ_CHANGE |
-			XVPHY_INTR_HANDLER_TYPE_RX_CLKDET_FREQ_CHANGE |
-			XVPHY_INTR_HANDLER_TYPE_TX_MMCM_LOCK_CHANGE |
-			XVPHY_INTR_HANDLER_TYPE_RX_MMCM_LOCK_CHANGE |
-			XVPHY_INTR_HANDLER_TYPE_TX_TMR_TIMEOUT |
-			XVPHY_INTR_HANDLER_TYPE_RX_TMR_TIMEOUT);
+		XVphy_IntrEnable(&vphydev->xvphy, mask & XVPHY_INTR_ALL_MASK);
 	else
-		XHdmiphy1_IntrEnable(&vphydev->xgtphy, XHDMIPHY1_INTR_HANDLER_TYPE_TXRESET_DONE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RXRESET_DONE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_LCPLL_LOCK |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RPLL_LOCK |
-			XHDMIPHY1_INTR_HANDLER_TYPE_TX_GPO_RISING_EDGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RX_GPO_RISING_EDGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_TX_CLKDET_FREQ_CHANGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RX_CLKDET_FREQ_CHANGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_TX_MMCM_LOCK_CHANGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RX_MMCM_LOCK_CHANGE |
-			XHDMIPHY1_INTR_HANDLER_TYPE_TX_TMR_TIMEOUT |
-			XHDMIPHY1_INTR_HANDLER_TYPE_RX_TMR_TIMEOUT);
+		XHdmiphy1_IntrEnable(&vphydev->xgtphy, mask & XHDMIPHY1_INTR_ALL_MASK);
+}
+
+static void xvphy_intr_enable(struct xvphy_dev *vphydev)
+{
+	xvphy_intr_enable_mask(vphydev, xvphy_intr_all_mask(vphydev));
+}
+
+/* account a hard interrupt and detect storms, called with irq_lock held */
+static void xvphy_irq_account(struct xvphy_dev *vphydev, u32 status)
+{
+	struct xvphy_irq_stats *stats = &vphydev->irq_stats;
+	unsigned long now = jiffies;
+	int i;
+
+	stats->total++;
+	if (!(status & xvphy_intr_all_mask(vphydev)))
+		stats->spurious++;
+
+	for (i = 0; i < XVPHY_IRQ_NUM_SOURCES; i++)
+		if (status & xvphy_irq_sources[i].mask)
+			stats->count[i]++;
+
+	if (time_after_eq(now, vphydev->storm_window +
+			  msecs_to_jiffies(XVPHY_IRQ_STORM_WINDOW_MS))) {
+		/* a calm window ends the exponential backoff */
+		if (!vphydev->storm &&
+		    vphydev->storm_count <= XVPHY_IRQ_STORM_THRESHOLD)
+			vphydev->storm_backoff_ms = 0;
+		vphydev->storm_window = now;
+		vphydev->storm_count = 0;
+	}
+
+	if (++vphydev->storm_count > XVPHY_IRQ_STORM_THRESHOLD && !vphydev->storm) {
+		vphydev->storm_backoff_ms = vphydev->storm_backoff_ms ?
+			min_t(u32, vphydev->storm_backoff_ms * 2, XVPHY_IRQ_BACKOFF_MAX_MS) :
+			XVPHY_IRQ_BACKOFF_MIN_MS;
+		vphydev->storm_until = now + msecs_to_jiffies(vphydev->storm_backoff_ms);
+		vphydev->storm = true;
+		stats->storms++;
+	}
+}
+
+/* hold off sources that fire again within their coalescing window,
+ * called with irq_lock held */
+static void xvphy_irq_coalesce(struct xvphy_dev *vphydev, u32 status)
+{
+	const struct xvphy_irq_source *src;
+	unsigned long now = jiffies;
+	unsigned long window;
+	int i;
+
+	for (i = 0; i < XVPHY_IRQ_NUM_SOURCES; i++) {
+		src = &xvphy_irq_sources[i];
+		if (!(status & src->mask))
+			continue;
+		window = msecs_to_jiffies(src->coalesce_ms);
+		if (src->coalesce_ms && time_before(now, vphydev->irq_last[i] + window)) {
+			vphydev->irq_deferred |= src->mask;
+			vphydev->irq_deadline[i] = now + window;
+			vphydev->irq_stats.deferred[i]++;
+		}
+		vphydev->irq_last[i] = now;
+	}
+}
+
+/*
+ * Drop expired holds and compute the interrupt sources that may be enabled.
+ * Returns false while a storm backoff is active; *delay is set to the time
+ * until the next hold expires, or 0 if nothing is held. Called with irq_lock
+ * held.
+ */
+static bool xvphy_irq_update_holds(struct xvphy_dev *vphydev, u32 *mask,
+				   unsigned long *delay)
+{
+	unsigned long now = jiffies;
+	unsigned long next = 0;
+	bool enable = true;
+	int i;
+
+	if (vphydev->storm) {
+		if (time_before(now, vphydev->storm_until)) {
+			next = vphydev->storm_until - now;
+			enable = false;
+		} else {
+			vphydev->storm = false;
+		}
+	}
+
+	for (i = 0; i < XVPHY_IRQ_NUM_SOURCES; i++) {
+		if (!(vphydev->irq_deferred & xvphy_irq_sources[i].mask))
+			continue;
+		if (time_after_eq(now, vphydev->irq_deadline[i])) {
+			vphydev->irq_deferred &= ~xvphy_irq_sources[i].mask;
+			continue;
+		}
+		if (!next || vphydev->irq_deadline[i] - now < next)
+			next = vphydev->irq_deadline[i] - now;
+	}
+
+	*mask = xvphy_intr_all_mask(vphydev) & ~vphydev->irq_deferred;
+	*delay = next;
+	return enable;
+}
+
+/* re-enable interrupt sources once their hold or the storm backoff expired */
+static void xvphy_irq_work(struct work_struct *work)
+{
+	struct xvphy_dev *vphydev = container_of(work, struct xvphy_dev,
+						 irq_work.work);
+	unsigned long delay;
+	bool enable;
+	u32 mask;
+
+	spin_lock_irq(&vphydev->irq_lock);
+	enable = xvphy_irq_update_holds(vphydev, &mask, &delay);
+	spin_unlock_irq(&vphydev->irq_lock);
+
+	if (enable)
+		xvphy_intr_enable_mask(vphydev, mask);
+	if (delay)
+		mod_delayed_work(system_wq, &vphydev->irq_work, delay);
+}
+
+/* call baremetal interrupt handler for the events of one locking domain,
+ * events of the other domain are left pending in the status register */
+static void xvphy_irq_service(struct xvphy_dev *vphydev, int domain)
+{
+	u32 hold = xvphy_intr_all_mask(vphydev) & ~vphydev->domain_intr_mask[domain];
+
+	hdmi_mutex_lock(vphydev->domain_mutex[domain]);
+	if (!vphydev->isvphy)
+		hdmi_mutex_lock(&vphydev->xvphy_mutex);
+
+	/* handle pending interrupts */
+	if (vphydev->isvphy) {
+		vphydev->xvphy.IntrHoldMask = hold;
+		XVphy_InterruptHandler(&vphydev->xvphy);
+		vphydev->xvphy.IntrHoldMask = 0;
+	} else {
+		vphydev->xgtphy.IntrHoldMask = hold;
+		XHdmiphy1_InterruptHandler(&vphydev->xgtphy);
+		vphydev->xgtphy.IntrHoldMask = 0;
+	}
+
+	if (!vphydev->isvphy)
+		hdmi_mutex_unlock(&vphydev->xvphy_mutex);
+	hdmi_mutex_unlock(vphydev->domain_mutex[domain]);
+}
+
+/* PLL lock interrupt bit of the PLL used by the given direction */
+static u32 xvphy_pll_intr_mask(struct xvphy_dev *vphydev, int domain)
+{
+	u32 PllType;
+
+	if (vphydev->isvphy) {
+		PllType = XVphy_GetPllType(&vphydev->xvphy, 0,
+			domain == XVPHY_DOMAIN_TX ? XVPHY_DIR_TX : XVPHY_DIR_RX,
+			XVPHY_CHANNEL_ID_CH1);
+		switch (PllType) {
+		case XVPHY_PLL_TYPE_CPLL:
+			return XVPHY_INTR_CPLL_LOCK_MASK;
+		case XVPHY_PLL_TYPE_QPLL:
+		case XVPHY_PLL_TYPE_QPLL0:
+		case XVPHY_PLL_TYPE_PLL0:
+			return XVPHY_INTR_QPLL0_LOCK_MASK;
+		case XVPHY_PLL_TYPE_QPLL1:
+		case XVPHY_PLL_TYPE_PLL1:
+			return XVPHY_INTR_QPLL1_LOCK_MASK;
+		default:
+			return 0;
+		}
+	}
+
+	PllType = XHdmiphy1_GetPllType(&vphydev->xgtphy, 0,
+		domain == XVPHY_DOMAIN_TX ? XHDMIPHY1_DIR_TX : XHDMIPHY1_DIR_RX,
+		XHDMIPHY1_CHANNEL_ID_CH1);
+	switch (PllType) {
+	case XHDMIPHY1_PLL_TYPE_CPLL:
+		return XHDMIPHY1_INTR_CPLL_LOCK_MASK;
+	case XHDMIPHY1_PLL_TYPE_QPLL:
+	case XHDMIPHY1_PLL_TYPE_QPLL0:
+	case XHDMIPHY1_PLL_TYPE_LCPLL:
+		return XHDMIPHY1_INTR_QPLL0_LOCK_MASK;
+	case XHDMIPHY1_PLL_TYPE_QPLL1:
+	case XHDMIPHY1_PLL_TYPE_RPLL:
+		return XHDMIPHY1_INTR_QPLL1_LOCK_MASK;
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Set up the TX and RX locking domains once the PLL selection is known.
+ * If both directions run from the same PLL, its reconfiguration affects
+ * both, so the domains are merged.
+ */
+static void xvphy_domain_init(struct xvphy_dev *vphydev)
+{
+	u32 tx_pll = xvphy_pll_intr_mask(vphydev, XVPHY_DOMAIN_TX);
+	u32 rx_pll = xvphy_pll_intr_mask(vphydev, XVPHY_DOMAIN_RX);
+	u32 all = xvphy_intr_all_mask(vphydev);
+
+	vphydev->domain_mutex[XVPHY_DOMAIN_TX] = &vphydev->tx_mutex;
+	if (!tx_pll || tx_pll == rx_pll) {
+		vphydev->domain_mutex[XVPHY_DOMAIN_RX] = &vphydev->tx_mutex;
+		vphydev->domain_intr_mask[XVPHY_DOMAIN_TX] = all;
+		vphydev->domain_intr_mask[XVPHY_DOMAIN_RX] = 0;
+		dev_info(vphydev->dev, "TX and RX share a PLL, single locking domain\n");
+		return;
+	}
+
+	vphydev->domain_mutex[XVPHY_DOMAIN_RX] = &vphydev->rx_mutex;
+	vphydev->domain_intr_mask[XVPHY_DOMAIN_RX] = all & (rx_pll |
+		XVPHY_INTR_RXRESETDONE_MASK |
+		XVPHY_INTR_RXCLKDETFREQCHANGE_MASK |
+		XVPHY_INTR_RXMMCMUSRCLK_LOCK_MASK |
+		XHDMIPHY1_INTR_RXGPO_RE_MASK |
+		XVPHY_INTR_RXTMRTIMEOUT_MASK);
+	/* TX services everything else, including unused PLLs */
+	vphydev->domain_intr_mask[XVPHY_DOMAIN_TX] = all &
+		~vphydev->domain_intr_mask[XVPHY_DOMAIN_RX];
 }
 
 static irqreturn_t xvphy_irq_handler(int irq, void *dev_id)
 {
 	struct xvphy_dev *vphydev;
+	u32 IntrStatus;
 
 	vphydev = (struct xvphy_dev *)dev_id;
 	if (!vphydev)
@@ -263,40 +725,214 @@ static irqreturn_t xvphy_irq_handler(int irq, void *dev_id)
 	/* Disable interrupts in the VPHY, they are re-enabled once serviced */
 	xvphy_intr_disable(vphydev);
 
+	/* accumulate status until the thread gets to run */
+	IntrStatus = xvphy_intr_status(vphydev);
+	spin_lock(&vphydev->irq_lock);
+	vphydev->irq_pending |= IntrStatus;
+	xvphy_irq_account(vphydev, IntrStatus);
+	spin_unlock(&vphydev->irq_lock);
+
 	return IRQ_WAKE_THREAD;
 }
 
 static irqreturn_t xvphy_irq_thread(int irq, void *dev_id)
 {
 	struct xvphy_dev *vphydev;
+	unsigned long delay;
+	bool enable, storm;
 	u32 IntrStatus;
+	u32 mask;
+	int loops = 0;
 
 	vphydev = (struct xvphy_dev *)dev_id;
 	if (!vphydev)
 		return IRQ_NONE;
 
-	/* call baremetal interrupt handler with mutex locked */
-	hdmi_mutex_lock(&vphydev->xvphy_mutex);
+	do {
+		spin_lock_irq(&vphydev->irq_lock);
+		IntrStatus = vphydev->irq_pending;
+		vphydev->irq_pending = 0;
+		xvphy_irq_coalesce(vphydev, IntrStatus);
+		vphydev->irq_stats.thread_runs++;
+		spin_unlock_irq(&vphydev->irq_lock);
+
+		dev_dbg(vphydev->dev, "%s IntrStatus = 0x%08x\n",
+			vphydev->isvphy ? "XVphy" : "XHdmiphy1", IntrStatus);
+
+		/* TX and RX events are handled in their own domain, so that
+		 * the other direction is only blocked on the quad lock */
+		if (IntrStatus & vphydev->domain_intr_mask[XVPHY_DOMAIN_TX])
+			xvphy_irq_service(vphydev, XVPHY_DOMAIN_TX);
+		if (IntrStatus & vphydev->domain_intr_mask[XVPHY_DOMAIN_RX])
+			xvphy_irq_service(vphydev, XVPHY_DOMAIN_RX);
+
+		/* service events that latched meanwhile without another IRQ,
+		 * unless they are held off by coalescing */
+		IntrStatus = xvphy_intr_status(vphydev);
+		spin_lock_irq(&vphydev->irq_lock);
+		IntrStatus &= xvphy_intr_all_mask(vphydev) & ~vphydev->irq_deferred;
+		vphydev->irq_pending |= IntrStatus;
+		storm = vphydev->storm;
+		spin_unlock_irq(&vphydev->irq_lock);
+	} while (IntrStatus && !storm && ++loops < XVPHY_IRQ_THREAD_BUDGET);
+
+	spin_lock_irq(&vphydev->irq_lock);
+	enable = xvphy_irq_update_holds(vphydev, &mask, &delay);
+	spin_unlock_irq(&vphydev->irq_lock);
+
+	if (!enable)
+		dev_warn_ratelimited(vphydev->dev,
+			"interrupt storm, backing off %u ms\n",
+			vphydev->storm_backoff_ms);
 
-	if (vphydev->isvphy) {
-		IntrStatus = XVphy_ReadReg(vphydev->xvphy.Config.BaseAddr, XVPHY_INTR_STS_REG);
-		dev_dbg(vphydev->dev,"XVphy IntrStatus = 0x%08x\n", IntrStatus);
+	/* Enable interrupt requesting in the VPHY */
+	if (enable)
+		xvphy_intr_enable_mask(vphydev, mask);
+	if (delay)
+		mod_delayed_work(system_wq, &vphydev->irq_work, delay);
+
+	return IRQ_HANDLED;
+}
+
+static ssize_t irq_stats_show(struct device *dev, struct device_attribute *attr,
+	char *buf)
+{
+	struct xvphy_dev *vphydev = dev_get_drvdata(dev);
+	struct xvphy_irq_stats stats;
+	u32 deferred, backoff;
+	ssize_t count = 0;
+	int i;
+
+	spin_lock_irq(&vphydev->irq_lock);
+	stats = vphydev->irq_stats;
+	deferred = vphydev->irq_deferred;
+	backoff = vphydev->storm ? vphydev->storm_backoff_ms : 0;
+	spin_unlock_irq(&vphydev->irq_lock);
+
+	count += scnprintf(buf + count, PAGE_SIZE - count,
+			"%-24s %12s %12s\n", "source", "count", "deferred");
+	for (i = 0; i < XVPHY_IRQ_NUM_SOURCES; i++) {
+		if (!(xvphy_irq_sources[i].mask & xvphy_intr_all_mask(vphydev)))
+			continue;
+		count += scnprintf(buf + count, PAGE_SIZE - count,
+				"%-24s %12llu %12llu%s\n", xvphy_irq_sources[i].name,
+				stats.count[i], stats.deferred[i],
+				(deferred & xvphy_irq_sources[i].mask) ? " (held)" : "");
+	}
+	count += scnprintf(buf + count, PAGE_SIZE - count,
+			"irqs %llu spurious %llu thread_runs %llu storms %llu backoff_ms %u\n",
+			stats.total, stats.spurious, stats.thread_runs,
+			stats.storms, backoff);
+	return count;
+}
+
+static ssize_t hdcp22_loopback_show(struct device *dev,
+	struct device_attribute *attr, char *buf)
+{
+	struct xvphy_dev *vphydev = dev_get_drvdata(dev);
+	ssize_t count = 0;
+
+	hdmi_mutex_lock(&vphydev->hdcp22_mutex);
+	if (vphydev->hdcp22_loopback_log)
+		count = scnprintf(buf, PAGE_SIZE, "%s",
+				  vphydev->hdcp22_loopback_log);
+	hdmi_mutex_unlock(&vphydev->hdcp22_mutex);
+	return count;
+}
+
+/* run the HDCP 2.2 test vectors the given number of times, with the TX and
+ * RX users of the PHY authenticating against each other through a DDC model.
+ * Both links must be idle; the users stop polling HDCP meanwhile and
+ * re-initialize it afterwards. */
+static ssize_t hdcp22_loopback_store(struct device *dev,
+	struct device_attribute *attr, const char *buf, size_t count)
+{
+	struct xvphy_dev *vphydev = dev_get_drvdata(dev);
+	XHdcp22_Loopback *loopback;
+	unsigned int iterations;
+	int ret = count;
+
+	if (kstrtouint(buf, 10, &iterations) || !iterations ||
+	    iterations > XVPHY_HDCP22_LOOPBACK_MAX_ITERATIONS)
+		return -EINVAL;
+
+	loopback = kzalloc(sizeof(*loopback), GFP_KERNEL);
+	if (!loopback)
+		return -ENOMEM;
+
+	hdmi_mutex_lock(&vphydev->hdcp22_mutex);
+	if (!vphydev->hdcp22[XVPHY_DOMAIN_TX] ||
+	    !vphydev->hdcp22[XVPHY_DOMAIN_RX]) {
+		ret = -ENODEV;
+		goto out;
+	}
+	if (!vphydev->hdcp22_loopback_log) {
+		vphydev->hdcp22_loopback_log = devm_kzalloc(vphydev->dev,
+							    PAGE_SIZE,
+							    GFP_KERNEL);
+		if (!vphydev->hdcp22_loopback_log) {
+			ret = -ENOMEM;
+			goto out;
+		}
+	}
+
+	/* take both instances away from their users, only if idle */
+	ret = vphydev->hdcp22_claim[XVPHY_DOMAIN_TX](
+			vphydev->hdcp22_ctx[XVPHY_DOMAIN_TX], true);
+	if (ret)
+		goto out;
+	ret = vphydev->hdcp22_claim[XVPHY_DOMAIN_RX](
+			vphydev->hdcp22_ctx[XVPHY_DOMAIN_RX], true);
+	if (ret)
+		goto release_tx;
+	ret = count;
+
+	if (XHdcp22Loopback_Initialize(loopback,
+				       vphydev->hdcp22[XVPHY_DOMAIN_TX],
+				       vphydev->hdcp22[XVPHY_DOMAIN_RX]) !=
+	    XST_SUCCESS) {
+		ret = -EAGAIN;
 	} else {
-		IntrStatus = XHdmiphy1_ReadReg(vphydev->xgtphy.Config.BaseAddr, XHDMIPHY1_INTR_STS_REG);
-		dev_dbg(vphydev->dev,"XHdmiphy1 IntrStatus = 0x%08x\n", IntrStatus);
+		if (XHdcp22Loopback_SelfTest(loopback, iterations) !=
+		    XST_SUCCESS)
+			dev_warn(vphydev->dev, "HDCP 2.2 loopback test vectors failed\n");
+		XHdcp22Loopback_StatsShow(loopback,
+					  vphydev->hdcp22_loopback_log,
+					  PAGE_SIZE);
+		XHdcp22Loopback_Release(loopback);
 	}
 
-	/* handle pending interrupts */
-	if (vphydev->isvphy)
-		XVphy_InterruptHandler(&vphydev->xvphy);
-	else
-		XHdmiphy1_InterruptHandler(&vphydev->xgtphy);
-	hdmi_mutex_unlock(&vphydev->xvphy_mutex);
+	vphydev->hdcp22_claim[XVPHY_DOMAIN_RX](
+			vphydev->hdcp22_ctx[XVPHY_DOMAIN_RX], false);
+release_tx:
+	vphydev->hdcp22_claim[XVPHY_DOMAIN_TX](
+			vphydev->hdcp22_ctx[XVPHY_DOMAIN_TX], false);
+out:
+	hdmi_mutex_unlock(&vphydev->hdcp22_mutex);
+	kfree(loopback);
+	return ret;
+}
 
-	/* Enable interrupt requesting in the VPHY */
-	xvphy_intr_enable(vphydev);
+static DEVICE_ATTR(irq_stats, 0444, irq_stats_show, NULL/*store*/);
+static DEVICE_ATTR(hdcp22_loopback, 0644, hdcp22_loopback_show,
+		   hdcp22_loopback_store);
+static struct attribute *xvphy_attrs[] = {
+	&dev_attr_irq_stats.attr,
+	&dev_attr_hdcp22_loopback.attr,
+	NULL,
+};
 
-	return IRQ_HANDLED;
+static struct attribute_group xvphy_attr_group = {
+	.attrs = xvphy_attrs,
+};
+
+/* undo the interrupt bookkeeping, runs after the IRQ has been released */
+static void xvphy_irq_cleanup(void *data)
+{
+	struct xvphy_dev *vphydev = data;
+
+	sysfs_remove_group(&vphydev->dev->kobj, &xvphy_attr_group);
+	cancel_delayed_work_sync(&vphydev->irq_work);
 }
 
 /**
@@ -605,6 +1241,13 @@ static int xvphy_probe(struct platform_device *pdev)
 
 	/* mutex that protects against concurrent access */
 	mutex_init(&vphydev->xvphy_mutex);
+	mutex_init(&vphydev->tx_mutex);
+	mutex_init(&vphydev->rx_mutex);
+	mutex_init(&vphydev->edid_mutex);
+	mutex_init(&vphydev->hdcp22_mutex);
+	/* single domain until the PLL selection is known */
+	vphydev->domain_mutex[XVPHY_DOMAIN_TX] = &vphydev->tx_mutex;
+	vphydev->domain_mutex[XVPHY_DOMAIN_RX] = &vphydev->tx_mutex;
 
 	vphydev->dev = &pdev->dev;
 	/* set a pointer to our driver data */
@@ -776,6 +1419,9 @@ static int xvphy_probe(struct platform_device *pdev)
 		dev_err(&pdev->dev, "HDMI VPHY initialization error\n");
 		return ENODEV;
 	}
+	/* TX and RX only serialize on the quad resources they share */
+	if (vphydev->isvphy)
+		XVphy_SetRegLockHandler(&vphydev->xvphy, xvphy_reg_lock, vphydev);
 
 	if (vphydev->isvphy)
 		Data = XVphy_GetVersion(&vphydev->xvphy);
@@ -785,6 +1431,23 @@ static int xvphy_probe(struct platform_device *pdev)
 			((Data >> 16) & 0xFF), (Data & 0xFFFF));
 
 
+	xvphy_domain_init(vphydev);
+
+	spin_lock_init(&vphydev->irq_lock);
+	INIT_DELAYED_WORK(&vphydev->irq_work, xvphy_irq_work);
+	vphydev->storm_window = jiffies;
+
+	ret = sysfs_create_group(&vphydev->dev->kobj, &xvphy_attr_group);
+	if (ret) {
+		dev_err(vphydev->dev, "sysfs group creation (%d) failed\n", ret);
+		return ret;
+	}
+
+	/* registered before the IRQ so that it runs after the IRQ is freed */
+	ret = devm_add_action_or_reset(&pdev->dev, xvphy_irq_cleanup, vphydev);
+	if (ret)
+		return ret;
+
 	ret = devm_request_threaded_irq(&pdev->dev, vphydev->irq, xvphy_irq_handler, xvphy_irq_thread,
 			IRQF_TRIGGER_HIGH /*IRQF_SHARED*/, "xilinx-vphy", vphydev/*dev_id*/);
 
@@ -817,6 +1480,10 @@ static int __maybe_unused xvphy_pm_suspend(struct device *dev)
 {
 	struct xvphy_dev *vphydev = dev_get_drvdata(dev);
 	dev_dbg(vphydev->dev, "Vphy suspend function called\n");
+	/* wait for a running IRQ thread, it may re-arm the hold work, and
+	 * cancel the work before masking so nothing re-enables the sources */
+	disable_irq(vphydev->irq);
+	cancel_delayed_work_sync(&vphydev->irq_work);
 	xvphy_intr_disable(vphydev);
 	return 0;
 }
@@ -825,7 +1492,14 @@ static int __maybe_unused xvphy_pm_resume(struct device *dev)
 {
 	struct xvphy_dev *vphydev = dev_get_drvdata(dev);
 	dev_dbg(vphydev->dev, "Vphy resume function called\n");
+	/* start without holds, all sources are serviced after resume */
+	spin_lock_irq(&vphydev->irq_lock);
+	vphydev->irq_deferred = 0;
+	vphydev->storm = false;
+	vphydev->storm_backoff_ms = 0;
+	spin_unlock_irq(&vphydev->irq_lock);
 	xvphy_intr_enable(vphydev);
+	enable_irq(vphydev->irq);
 	return 0;
 }
 
@@ -935,6 +1609,10 @@ EXPORT_SYMBOL_GPL(XHdcp1x_DisableBlank);
 EXPORT_SYMBOL_GPL(XHdcp1x_EnableEncryption);
 EXPORT_SYMBOL_GPL(XHdcp1x_IsDwnstrmCapable);
 EXPORT_SYMBOL_GPL(XHdcp1x_LateInit);
+EXPORT_SYMBOL_GPL(XHdcp1x_LoadRevocationList);
+EXPORT_SYMBOL_GPL(XHdcp1x_AddRevokedKsv);
+EXPORT_SYMBOL_GPL(XHdcp1x_ClearRevocationList);
+EXPORT_SYMBOL_GPL(XHdcp1x_IsKsvRevoked);
 
 /* Global API's for XTmr */
 EXPORT_SYMBOL_GPL(XTmrCtr_CfgInitialize);
@@ -949,6 +1627,9 @@ EXPORT_SYMBOL_GPL(XTmrCtr_Offsets);
 EXPORT_SYMBOL_GPL(XTmrCtr_LookupConfig);
 EXPORT_SYMBOL_GPL(XTmrCtr_GetOptions);
 EXPORT_SYMBOL_GPL(XTmrCtr_Stop);
+EXPORT_SYMBOL_GPL(XTmrCtr_SoftWait);
+EXPORT_SYMBOL_GPL(XTmrCtr_HrTimerInitialize);
+EXPORT_SYMBOL_GPL(XTmrCtr_HrTimerRelease);
 
 /* Global API's for xhdcp22Rx */
 EXPORT_SYMBOL_GPL(XHdcp22Rx_IsAuthenticated);
@@ -986,6 +1667,7 @@ EXPORT_SYMBOL_GPL(XHdcp22Tx_IsEnabled);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_GetTopologyField);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_Reset);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_SetMessagePollingValue);
+EXPORT_SYMBOL_GPL(XHdcp22Tx_SetAdaptivePolling);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_Enable);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_GetTimer);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_Disable);
@@ -1007,6 +1689,8 @@ EXPORT_SYMBOL_GPL(XHdcp22Tx_DisableBlank);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_GetVersion);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_SetCallback);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_SetContentStreamType);
+EXPORT_SYMBOL_GPL(XHdcp22Tx_ChangeContentStreamType);
+EXPORT_SYMBOL_GPL(XHdcp22Tx_IsContentStreamTypeChangePending);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_EnableBlank);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_LogShow);
 EXPORT_SYMBOL_GPL(XHdcp22Tx_EnableEncryption);
@@ -1028,5 +1712,8 @@ EXPORT_SYMBOL_GPL(XV_HdmiC_XVidC_To_IfColorformat);
 EXPORT_SYMBOL_GPL(XV_HdmiC_AVIIF_GeneratePacket);
 EXPORT_SYMBOL_GPL(XV_HdmiC_VSIF_GeneratePacket);
 EXPORT_SYMBOL_GPL(VicTable);
+EXPORT_SYMBOL_GPL(FrlRateTable);
 EXPORT_SYMBOL_GPL(XV_HdmiC_ParseDRMIF);
 EXPORT_SYMBOL_GPL(XV_HdmiC_DRMIF_GeneratePacket);
+EXPORT_SYMBOL_GPL(XHdmiC_TMDS_GetAudSampFreq);
+EXPORT_SYMBOL_GPL(XHdmiC_TMDS_GetAudSampRateHz);
@@ -1015,7 +1015,8 @@ size_t mpConvToOctets(const u32 a[], size_t ndigits, unsigned char *c, size_t nb
 #define mpNEXTBITMASK(mask, n) do{if(mask==1){mask=HIBITMASK;n--;}else{mask>>=1;}}while(0)
 
 
-int mpModExp(u32 yout[], const u32 x[], const u32 e[], u32 m[], size_t ndigits)
+static void mpModExpClassic(u32 yout[], const u32 x[], const u32 e[], u32 m[],
+	size_t ndigits, u32 ws[])
 {	/*	Computes y = x^e mod m */
 	/*	"Classic" binary left-to-right method */
 	/*  [v2.2] removed const restriction on m[] to avoid using an extra alloc'd var
@@ -1023,21 +1024,18 @@ int mpModExp(u32 yout[], const u32 x[], const u32 e[], u32 m[], size_t ndigits)
 	u32 mask;
 	size_t n;
 	size_t nn = ndigits * 2;
-	/* Create some double-length temps */
-
+	/* Use the workspace for some double-length temps */
 	u32 *t1, *t2, *y;
-	t1 = kzalloc(nn * 3 * sizeof(u32), GFP_KERNEL);
-	t2 = &t1[nn * 1];
-	y  = &t1[nn * 2];
-
-	assert(ndigits != 0);
+	t1 = ws;
+	t2 = &ws[nn * 1];
+	y  = &ws[nn * 2];
 
 	n = mpSizeof(e, ndigits);
 	/* Catch e==0 => x^0=1 */
 	if (0 == n)
 	{
 		mpSetDigit(yout, 1, ndigits);
-		goto done;
+		return;
 	}
 	/* Find second-most significant bit in e */
 	for (mask = HIBITMASK; mask > 0; mask >>= 1)
@@ -1067,9 +1065,177 @@ int mpModExp(u32 yout[], const u32 x[], const u32 e[], u32 m[], size_t ndigits)
 
 	/* Return y */
 	mpSetEqual(yout, y, ndigits);
+}
+
+/* Computes -m0^-1 mod 2^32 for odd m0 */
+static u32 mpMontInv(u32 m0)
+{
+	/* m0 is its own inverse mod 2^3, each Newton step doubles the bits */
+	u32 inv = m0;
+
+	inv *= 2 - m0 * inv;
+	inv *= 2 - m0 * inv;
+	inv *= 2 - m0 * inv;
+	inv *= 2 - m0 * inv;
+
+	return (u32)0 - inv;
+}
+
+static void mpMontMult(u32 a[], const u32 x[], const u32 y[], const u32 m[],
+	u32 minv, u32 t[], size_t ndigits)
+{	/*	Computes a = x * y * R^-1 mod m, R = 2^(BITS_PER_DIGIT * ndigits)
+		where x, y < m, |t| = ndigits + 2, a may overlap x or y.
+
+		Ref: Koc, Acar, Kaliski, "Analyzing and Comparing Montgomery
+		Multiplication Algorithms", CIOS method.
+	*/
+	size_t i, j, n = ndigits;
+	u64 uv;
+	u32 c, q;
+
+	for (j = 0; j < n + 2; j++)
+		t[j] = 0;
+
+	for (i = 0; i < n; i++)
+	{
+		/* t = t + x * y_i */
+		c = 0;
+		for (j = 0; j < n; j++)
+		{
+			uv = (u64)x[j] * y[i] + t[j] + c;
+			t[j] = (u32)uv;
+			c = (u32)(uv >> BITS_PER_DIGIT);
+		}
+		uv = (u64)t[n] + c;
+		t[n] = (u32)uv;
+		t[n+1] = (u32)(uv >> BITS_PER_DIGIT);
+
+		/* t = (t + q * m) / 2^BITS_PER_DIGIT, q chosen to clear t_0 */
+		q = t[0] * minv;
+		uv = (u64)q * m[0] + t[0];
+		c = (u32)(uv >> BITS_PER_DIGIT);
+		for (j = 1; j < n; j++)
+		{
+			uv = (u64)q * m[j] + t[j] + c;
+			t[j-1] = (u32)uv;
+			c = (u32)(uv >> BITS_PER_DIGIT);
+		}
+		uv = (u64)t[n] + c;
+		t[n-1] = (u32)uv;
+		t[n] = t[n+1] + (u32)(uv >> BITS_PER_DIGIT);
+	}
+
+	/* t < 2m, one final subtraction */
+	if (t[n] || mpCompare(t, m, n) >= 0)
+		mpSubtract(a, t, m, n);
+	else
+		mpSetEqual(a, t, n);
+}
+
+int mpModExpMont(u32 yout[], const u32 x[], const u32 e[], u32 m[],
+	size_t ndigits, u32 ws[])
+{	/*	Computes y = x^e mod m using Montgomery multiplication */
+	/*	ws is a workspace of mpMODEXP_WORKSPACE_DIGITS(ndigits) digits,
+		so nothing is allocated here. Falls back to the classic method
+		for even or single digit moduli. */
+	size_t nn = ndigits * 2;
+	size_t n, i;
+	u32 *u, *q, *r, *t, *xm, *ym;
+	u32 minv, mask, ee;
+
+	assert(ndigits != 0);
+
+	if (ndigits < 2 || !(m[0] & 1))
+	{
+		mpModExpClassic(yout, x, e, m, ndigits, ws);
+		return 0;
+	}
+
+	n = mpSizeof(e, ndigits);
+	/* Catch e==0 => x^0=1 */
+	if (0 == n)
+	{
+		mpSetDigit(yout, 1, ndigits);
+		return 0;
+	}
+
+	u = ws;
+	q = &ws[nn * 1];
+	r = &ws[nn * 2];
+
+	/* Convert to the Montgomery domain, xm = x * R mod m */
+	for (i = 0; i < ndigits; i++)
+	{
+		u[i] = 0;
+		u[i + ndigits] = x[i];
+	}
+	mpDivide(q, r, u, nn, m, ndigits);
+
+	/* The dividend and quotient are free from here on */
+	xm = r;
+	ym = q;
+	t = u;
+	minv = mpMontInv(m[0]);
+
+	/* Set y = x */
+	mpSetEqual(ym, xm, ndigits);
+
+	if (1 == n)
+	{
+		/* Short exponent, e.g. F4 = 65537: 16 squares and 1 multiply */
+		ee = e[0];
+		for (mask = HIBITMASK; !(ee & mask); mask >>= 1)
+			;
+		for (mask >>= 1; mask; mask >>= 1)
+		{
+			mpMontMult(ym, ym, ym, m, minv, t, ndigits);
+			if (ee & mask)
+				mpMontMult(ym, ym, xm, m, minv, t, ndigits);
+		}
+	}
+	else
+	{
+		/* Find second-most significant bit in e */
+		for (mask = HIBITMASK; mask > 0; mask >>= 1)
+		{
+			if (e[n-1] & mask)
+				break;
+		}
+		mpNEXTBITMASK(mask, n);
+
+		/* For bit j = k-2 downto 0 */
+		while (n)
+		{
+			mpMontMult(ym, ym, ym, m, minv, t, ndigits);
+			if (e[n-1] & mask)
+				mpMontMult(ym, ym, xm, m, minv, t, ndigits);
+
+			/* Move to next bit */
+			mpNEXTBITMASK(mask, n);
+		}
+	}
+
+	/* Convert back, y = ym * 1 * R^-1 mod m */
+	mpSetDigit(xm, 1, ndigits);
+	mpMontMult(yout, ym, xm, m, minv, t, ndigits);
+
+	return 0;
+}
+
+int mpModExp(u32 yout[], const u32 x[], const u32 e[], u32 m[], size_t ndigits)
+{	/*	Computes y = x^e mod m */
+	u32 *ws;
+
+	assert(ndigits != 0);
+
+	ws = kzalloc(mpMODEXP_WORKSPACE_DIGITS(ndigits) * sizeof(u32),
+		GFP_KERNEL);
+	if (!ws)
+		return -1;	/* Error: out of memory */
+
+	mpModExpMont(yout, x, e, m, ndigits, ws);
 
-done:
-	kfree(t1);
+	kfree(ws);
 
 	return 0;
 }
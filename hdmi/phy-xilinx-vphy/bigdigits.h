@@ -168,8 +168,23 @@ size_t mpConvFromOctets(u32 a[], size_t ndigits, const unsigned char *c, size_t
 @returns number of non-zero octets required. */
 size_t mpConvToOctets(const u32 a[], size_t ndigits, unsigned char *c, size_t nbytes);
 
-/** Computes y = x^e mod m */
+/** Computes y = x^e mod m
+@returns 0 on success or -1 if the workspace cannot be allocated
+@remark Allocates its workspace, see mpModExpMont() to avoid that.
+*/
 int mpModExp(u32 y[], const u32 x[], const u32 e[], u32 m[], size_t ndigits);
+/** Number of digits of the workspace used by mpModExpMont() */
+#define mpMODEXP_WORKSPACE_DIGITS(ndigits) (6 * (ndigits))
+/** Computes y = x^e mod m using Montgomery multiplication
+@param[out] y to receive the result, an array of size `ndigits`
+@param[in] x base of size `ndigits`
+@param[in] e exponent of size `ndigits`
+@param[in] m modulus of size `ndigits`
+@param[in] ndigits size of arrays `y`, `x`, `e` and `m`
+@param[in] ws workspace of mpMODEXP_WORKSPACE_DIGITS(`ndigits`) digits
+@remark Does not allocate memory. Not constant-time, for public key operations.
+*/
+int mpModExpMont(u32 y[], const u32 x[], const u32 e[], u32 m[], size_t ndigits, u32 ws[]);
 
 /** @endcond */
 
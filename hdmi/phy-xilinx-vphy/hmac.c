@@ -35,6 +35,7 @@
 #include <linux/math64.h>
 #include <linux/kernel.h>
 #include <linux/slab.h>
+#include <linux/string.h>
 
 #include "xil_types.h"
 #include "xstatus.h"
@@ -55,6 +55,7 @@
 /* Local Function Prototyptes */
 void SHA1PadMessage(SHA1Context *);
 void SHA1ProcessMessageBlock(SHA1Context *);
+static void SHA1ProcessBlock(u32 *, const u8 *);
 
 /*
  *  SHA1Reset
@@ -177,6 +178,10 @@ int SHA1Input(    SHA1Context    *context,
                   const u8  *message_array,
                   unsigned       length)
 {
+    u32 bits_low;
+    u32 bits_high;
+    unsigned fill;
+
     if (!length)
     {
         return shaSuccess;
@@ -198,33 +203,172 @@ int SHA1Input(    SHA1Context    *context,
     {
          return context->Corrupted;
     }
-    while(length-- && !context->Corrupted)
+
+    /*
+     *  Update the message length once for the whole input
+     */
+    bits_low = length << 3;
+    bits_high = length >> 29;
+    context->Length_Low += bits_low;
+    if (context->Length_Low < bits_low)
+    {
+        bits_high++;
+    }
+    context->Length_High += bits_high;
+    if (context->Length_High < bits_high)
     {
-    context->Message_Block[context->Message_Block_Index++] =
-                    (*message_array & 0xFF);
+        /* Message is too long */
+        context->Corrupted = 1;
+        return context->Corrupted;
+    }
 
-    context->Length_Low += 8;
-    if (context->Length_Low == 0)
+    /*
+     *  Complete a partially filled message block first
+     */
+    if (context->Message_Block_Index)
     {
-        context->Length_High++;
-        if (context->Length_High == 0)
+        fill = 64 - context->Message_Block_Index;
+        if (fill > length)
         {
-            /* Message is too long */
-            context->Corrupted = 1;
+            fill = length;
+        }
+        memcpy(&context->Message_Block[context->Message_Block_Index],
+               message_array, fill);
+        context->Message_Block_Index += fill;
+        message_array += fill;
+        length -= fill;
+
+        if (context->Message_Block_Index == 64)
+        {
+            SHA1ProcessMessageBlock(context);
         }
     }
 
-    if (context->Message_Block_Index == 64)
+    /*
+     *  Process whole blocks straight from the input
+     */
+    while (length >= 64)
     {
-        SHA1ProcessMessageBlock(context);
+        SHA1ProcessBlock(context->Intermediate_Hash, message_array);
+        message_array += 64;
+        length -= 64;
     }
 
-    message_array++;
+    /*
+     *  Keep the remainder for the next call
+     */
+    if (length)
+    {
+        memcpy(context->Message_Block, message_array, length);
+        context->Message_Block_Index = length;
     }
 
     return shaSuccess;
 }
 
+/*
+ *  SHA1 round functions and constants
+ */
+#define SHA1_F1(b,c,d)  ((d) ^ ((b) & ((c) ^ (d))))
+#define SHA1_F2(b,c,d)  ((b) ^ (c) ^ (d))
+#define SHA1_F3(b,c,d)  (((b) & (c)) | ((d) & ((b) | (c))))
+#define SHA1_K1         0x5A827999
+#define SHA1_K2         0x6ED9EBA1
+#define SHA1_K3         0x8F1BBCDC
+#define SHA1_K4         0xCA62C1D6
+
+/*
+ *  Word t of the message schedule, kept in a ring of 16 words
+ */
+#define SHA1_W(t) \
+    ((t) < 16 ? W[(t) & 15] : \
+     (W[(t) & 15] = SHA1CircularShift(1, W[((t) + 13) & 15] ^ \
+        W[((t) + 8) & 15] ^ W[((t) + 2) & 15] ^ W[(t) & 15])))
+
+/*
+ *  One round, the caller rotates the roles of the word buffers
+ */
+#define SHA1_ROUND(a,b,c,d,e,f,k,t) \
+    do { \
+        e += SHA1CircularShift(5,a) + f(b,c,d) + (k) + SHA1_W(t); \
+        b = SHA1CircularShift(30,b); \
+    } while (0)
+
+#define SHA1_ROUND5(f,k,t) \
+    do { \
+        SHA1_ROUND(A,B,C,D,E,f,k,(t)); \
+        SHA1_ROUND(E,A,B,C,D,f,k,(t) + 1); \
+        SHA1_ROUND(D,E,A,B,C,f,k,(t) + 2); \
+        SHA1_ROUND(C,D,E,A,B,f,k,(t) + 3); \
+        SHA1_ROUND(B,C,D,E,A,f,k,(t) + 4); \
+    } while (0)
+
+/*
+ *  SHA1ProcessBlock
+ *
+ *  Description:
+ *      This function will process 512 bits of the message, updating
+ *      the intermediate hash. The rounds are unrolled and the message
+ *      schedule is computed on the fly in a ring of 16 words.
+ *
+ *  Parameters:
+ *      hash: [in/out]
+ *          The intermediate hash to update.
+ *      block: [in]
+ *          The 64 octets of the message to process.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ */
+static void SHA1ProcessBlock(u32 *hash, const u8 *block)
+{
+    u32      W[16];             /* Word sequence               */
+    u32      A, B, C, D, E;     /* Word buffers                */
+    int      t;
+
+    /*
+     *  Initialize the first 16 words in the array W
+     */
+    for(t = 0; t < 16; t++, block += 4)
+    {
+        W[t] = ((u32)block[0] << 24) | ((u32)block[1] << 16) |
+               ((u32)block[2] << 8) | (u32)block[3];
+    }
+
+    A = hash[0];
+    B = hash[1];
+    C = hash[2];
+    D = hash[3];
+    E = hash[4];
+
+    SHA1_ROUND5(SHA1_F1, SHA1_K1, 0);
+    SHA1_ROUND5(SHA1_F1, SHA1_K1, 5);
+    SHA1_ROUND5(SHA1_F1, SHA1_K1, 10);
+    SHA1_ROUND5(SHA1_F1, SHA1_K1, 15);
+
+    SHA1_ROUND5(SHA1_F2, SHA1_K2, 20);
+    SHA1_ROUND5(SHA1_F2, SHA1_K2, 25);
+    SHA1_ROUND5(SHA1_F2, SHA1_K2, 30);
+    SHA1_ROUND5(SHA1_F2, SHA1_K2, 35);
+
+    SHA1_ROUND5(SHA1_F3, SHA1_K3, 40);
+    SHA1_ROUND5(SHA1_F3, SHA1_K3, 45);
+    SHA1_ROUND5(SHA1_F3, SHA1_K3, 50);
+    SHA1_ROUND5(SHA1_F3, SHA1_K3, 55);
+
+    SHA1_ROUND5(SHA1_F2, SHA1_K4, 60);
+    SHA1_ROUND5(SHA1_F2, SHA1_K4, 65);
+    SHA1_ROUND5(SHA1_F2, SHA1_K4, 70);
+    SHA1_ROUND5(SHA1_F2, SHA1_K4, 75);
+
+    hash[0] += A;
+    hash[1] += B;
+    hash[2] += C;
+    hash[3] += D;
+    hash[4] += E;
+}
+
 /*
  *  SHA1ProcessMessageBlock
  *
@@ -248,87 +392,7 @@ int SHA1Input(    SHA1Context    *context,
  */
 void SHA1ProcessMessageBlock(SHA1Context *context)
 {
-    const u32 K[] =    {       /* Constants defined in SHA-1   */
-                            0x5A827999,
-                            0x6ED9EBA1,
-                            0x8F1BBCDC,
-                            0xCA62C1D6
-                            };
-    int           t;                 /* Loop counter                */
-    u32      temp;              /* Temporary word value        */
-    u32      W[80];             /* Word sequence               */
-    u32      A, B, C, D, E;     /* Word buffers                */
-
-    /*
-     *  Initialize the first 16 words in the array W
-     */
-    for(t = 0; t < 16; t++)
-    {
-        W[t] = context->Message_Block[t * 4] << 24;
-        W[t] |= context->Message_Block[t * 4 + 1] << 16;
-        W[t] |= context->Message_Block[t * 4 + 2] << 8;
-        W[t] |= context->Message_Block[t * 4 + 3];
-    }
-
-    for(t = 16; t < 80; t++)
-    {
-       W[t] = SHA1CircularShift(1,W[t-3] ^ W[t-8] ^ W[t-14] ^ W[t-16]);
-    }
-
-    A = context->Intermediate_Hash[0];
-    B = context->Intermediate_Hash[1];
-    C = context->Intermediate_Hash[2];
-    D = context->Intermediate_Hash[3];
-    E = context->Intermediate_Hash[4];
-
-    for(t = 0; t < 20; t++)
-    {
-        temp =  SHA1CircularShift(5,A) +
-                ((B & C) | ((~B) & D)) + E + W[t] + K[0];
-        E = D;
-        D = C;
-        C = SHA1CircularShift(30,B);
-
-        B = A;
-        A = temp;
-    }
-
-    for(t = 20; t < 40; t++)
-    {
-        temp = SHA1CircularShift(5,A) + (B ^ C ^ D) + E + W[t] + K[1];
-        E = D;
-        D = C;
-        C = SHA1CircularShift(30,B);
-        B = A;
-        A = temp;
-    }
-
-    for(t = 40; t < 60; t++)
-    {
-        temp = SHA1CircularShift(5,A) +
-               ((B & C) | (B & D) | (C & D)) + E + W[t] + K[2];
-        E = D;
-        D = C;
-        C = SHA1CircularShift(30,B);
-        B = A;
-        A = temp;
-    }
-
-    for(t = 60; t < 80; t++)
-    {
-        temp = SHA1CircularShift(5,A) + (B ^ C ^ D) + E + W[t] + K[3];
-        E = D;
-        D = C;
-        C = SHA1CircularShift(30,B);
-        B = A;
-        A = temp;
-    }
-
-    context->Intermediate_Hash[0] += A;
-    context->Intermediate_Hash[1] += B;
-    context->Intermediate_Hash[2] += C;
-    context->Intermediate_Hash[3] += D;
-    context->Intermediate_Hash[4] += E;
+    SHA1ProcessBlock(context->Intermediate_Hash, context->Message_Block);
 
     context->Message_Block_Index = 0;
 }
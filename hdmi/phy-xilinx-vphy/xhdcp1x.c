@@ -51,6 +51,10 @@
 * 4.1   yas    11/10/16 Added function XHdcp1x_SetHdmiMode.
 * 4.1   yas    08/03/17 Updated the initialization to memset the XHdcp1x
 *                       structure to 0.
+* 4.3   XLNX   10/18/26 Added functions XHdcp1x_LoadRevocationList,
+*                       XHdcp1x_AddRevokedKsv, XHdcp1x_ClearRevocationList
+*                       and XHdcp1x_IsKsvRevoked.
+*                       Added function XHdcp1x_GetSrmSize.
 * </pre>
 *
 ******************************************************************************/
@@ -89,6 +93,20 @@
 #define INCLUDE_TX
 #endif
 
+/* HDCP 1.x System Renewability Message layout */
+#define XHDCP1X_SRM_ID			(0x80u)	/**< SRM ID, upper nibble
+						  *  of the first byte */
+#define XHDCP1X_SRM_HEADER_SIZE		(5u)	/**< SRM ID, version and
+						  *  generation number */
+#define XHDCP1X_SRM_SIGNATURE_SIZE	(40u)	/**< DCP LLC signature */
+#define XHDCP1X_SRM_NUM_DEVICES_MASK	(0x7Fu)	/**< Number of devices of
+						  *  a VRL entry */
+
+/** Multiplicative hash of a KSV into the revocation list hash set */
+#define XHDCP1X_REVOCATION_HASH(Ksv) \
+	((u32)(((Ksv) * 0x9E3779B97F4A7C15ull) >> 32) & \
+	 (XHDCP1X_REVOCATION_LIST_HASH_SIZE - 1))
+
 /**
  * This defines the version of the software driver
  */
@@ -1177,6 +1195,269 @@ void XHdcp1x_SetKsvRevokeCheck(XHdcp1x_KsvRevokeCheck RevokeCheckFunc)
 	XHdcp1xKsvRevokeCheck = RevokeCheckFunc;
 }
 
+/*****************************************************************************/
+/**
+* This function clears the KSV revocation list of an HDCP interface.
+*
+* @param	InstancePtr is the pointer to the HDCP interface.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XHdcp1x_ClearRevocationList(XHdcp1x *InstancePtr)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	memset(&InstancePtr->RevocationList, 0,
+			sizeof(XHdcp1x_RevocationList));
+}
+
+/*****************************************************************************/
+/**
+* This function adds a KSV to the revocation list of an HDCP interface.
+*
+* @param	InstancePtr is the pointer to the HDCP interface.
+* @param	Ksv is the KSV to revoke.
+*
+* @return
+*		- XST_SUCCESS if the KSV is in the revocation list.
+*		- XST_FAILURE if the KSV is zero or the list is full.
+*
+* @note		None.
+*
+******************************************************************************/
+int XHdcp1x_AddRevokedKsv(XHdcp1x *InstancePtr, u64 Ksv)
+{
+	XHdcp1x_RevocationList *ListPtr;
+	u32 Slot;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	ListPtr = &InstancePtr->RevocationList;
+	Ksv &= 0xFFFFFFFFFFull;
+
+	if (Ksv == 0) {
+		return (XST_FAILURE);
+	}
+
+	/* Linear probing, the set is never more than half full */
+	Slot = XHDCP1X_REVOCATION_HASH(Ksv);
+	while (ListPtr->Ksv[Slot] != 0) {
+		if (ListPtr->Ksv[Slot] == Ksv) {
+			return (XST_SUCCESS);
+		}
+		Slot = (Slot + 1) & (XHDCP1X_REVOCATION_LIST_HASH_SIZE - 1);
+	}
+
+	if (ListPtr->NumDevices >= XHDCP1X_REVOCATION_LIST_MAX_DEVICES) {
+		return (XST_FAILURE);
+	}
+
+	ListPtr->Ksv[Slot] = Ksv;
+	ListPtr->NumDevices++;
+
+	return (XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function checks a KSV against the revocation list of an HDCP
+* interface.
+*
+* @param	InstancePtr is the pointer to the HDCP interface.
+* @param	Ksv is the KSV to check.
+*
+* @return	Truth value indicating the KSV is revoked (TRUE) or not (FALSE).
+*
+* @note		Every slot of the hash set is compared without branching on
+*		the KSV, so the time taken does not depend on the KSV or on
+*		whether and where it is found. Only an empty list returns
+*		early.
+*
+******************************************************************************/
+int XHdcp1x_IsKsvRevoked(const XHdcp1x *InstancePtr, u64 Ksv)
+{
+	const XHdcp1x_RevocationList *ListPtr;
+	u64 Match = 0;
+	u32 Slot;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	ListPtr = &InstancePtr->RevocationList;
+	Ksv &= 0xFFFFFFFFFFull;
+
+	if (ListPtr->NumDevices == 0) {
+		return (FALSE);
+	}
+
+	/* Bit 63 of (Diff | -Diff) is set unless Diff is zero */
+	for (Slot = 0; Slot < XHDCP1X_REVOCATION_LIST_HASH_SIZE; Slot++) {
+		u64 Diff = ListPtr->Ksv[Slot] ^ Ksv;
+
+		Match |= ~(Diff | (0 - Diff)) >> 63;
+	}
+
+	/* A zero KSV matches the free slots, it is never revoked */
+	Match &= (Ksv | (0 - Ksv)) >> 63;
+
+	return ((int)Match);
+}
+
+/*****************************************************************************/
+/**
+* This function loads the KSV revocation list of an HDCP interface from an
+* HDCP 1.x System Renewability Message (SRM), replacing the current list.
+* The vendor revocation lists (VRL) of all generations in the SRM are
+* added.
+*
+* @param	InstancePtr is the pointer to the HDCP interface.
+* @param	SrmPtr is a pointer to the SRM.
+* @param	SrmSize is the size of the SRM in bytes.
+*
+* @return
+*		- XST_SUCCESS if the revocation list has been loaded.
+*		- XST_FAILURE if the SRM is malformed or holds more than
+*		  XHDCP1X_REVOCATION_LIST_MAX_DEVICES KSVs. The revocation
+*		  list is cleared in that case.
+*
+* @note		The DCP LLC signature of the SRM is not verified, the
+*		application must only pass SRMs it has verified. KSVs are
+*		stored in the SRM most significant byte first.
+*
+******************************************************************************/
+int XHdcp1x_LoadRevocationList(XHdcp1x *InstancePtr, const u8 *SrmPtr,
+		u32 SrmSize)
+{
+	u32 Offset = XHDCP1X_SRM_HEADER_SIZE;
+	u32 NumGenerations;
+	u32 Generation;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(SrmPtr != NULL);
+
+	XHdcp1x_ClearRevocationList(InstancePtr);
+
+	if ((SrmSize < XHDCP1X_SRM_HEADER_SIZE) ||
+			((SrmPtr[0] & 0xF0u) != XHDCP1X_SRM_ID)) {
+		return (XST_FAILURE);
+	}
+	NumGenerations = SrmPtr[4];
+
+	for (Generation = 0; Generation < NumGenerations; Generation++) {
+		/* The first generation has a 24-bit VRL length, the next
+		 * generations a 16-bit one, both including the length field
+		 * and the signature */
+		u32 LengthSize = (Generation == 0) ? 3 : 2;
+		u32 VrlLength = 0;
+		u32 VrlEnd;
+		u32 Idx;
+
+		if (Offset + LengthSize > SrmSize) {
+			goto malformed;
+		}
+		for (Idx = 0; Idx < LengthSize; Idx++) {
+			VrlLength = (VrlLength << 8) | SrmPtr[Offset + Idx];
+		}
+		if ((VrlLength < LengthSize + XHDCP1X_SRM_SIGNATURE_SIZE) ||
+				(Offset + VrlLength > SrmSize)) {
+			goto malformed;
+		}
+		VrlEnd = Offset + VrlLength - XHDCP1X_SRM_SIGNATURE_SIZE;
+		Offset += LengthSize;
+
+		/* VRL entries: number of devices followed by their KSVs */
+		while (Offset < VrlEnd) {
+			u32 NumDevices = SrmPtr[Offset++] &
+					XHDCP1X_SRM_NUM_DEVICES_MASK;
+
+			if (Offset + (NumDevices * XHDCP1X_KSV_SIZE) > VrlEnd) {
+				goto malformed;
+			}
+			while (NumDevices-- > 0) {
+				u64 Ksv = 0;
+
+				for (Idx = 0; Idx < XHDCP1X_KSV_SIZE; Idx++) {
+					Ksv = (Ksv << 8) | SrmPtr[Offset++];
+				}
+				if (XHdcp1x_AddRevokedKsv(InstancePtr, Ksv) !=
+						XST_SUCCESS) {
+					goto malformed;
+				}
+			}
+		}
+
+		/* Skip the signature */
+		Offset = VrlEnd + XHDCP1X_SRM_SIGNATURE_SIZE;
+	}
+
+	return (XST_SUCCESS);
+
+malformed:
+	XHdcp1x_ClearRevocationList(InstancePtr);
+	return (XST_FAILURE);
+}
+
+/*****************************************************************************/
+/**
+* This function determines the size of an HDCP 1.x SRM from its header and
+* the VRL lengths of its generations, so that an SRM received in pieces is
+* known to be complete.
+*
+* @param	SrmPtr is a pointer to the start of the SRM.
+* @param	Size is the number of bytes of the SRM available at SrmPtr.
+*
+* @return	The size of the SRM in bytes, or 0 if more than Size bytes
+*		are needed to determine it.
+*
+* @note		The SRM is not validated. A malformed SRM yields a size that
+*		XHdcp1x_LoadRevocationList then rejects.
+*
+******************************************************************************/
+u32 XHdcp1x_GetSrmSize(const u8 *SrmPtr, u32 Size)
+{
+	u32 Offset = XHDCP1X_SRM_HEADER_SIZE;
+	u32 NumGenerations;
+	u32 Generation;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(SrmPtr != NULL);
+
+	if (Size < XHDCP1X_SRM_HEADER_SIZE) {
+		return (0);
+	}
+	if ((SrmPtr[0] & 0xF0u) != XHDCP1X_SRM_ID) {
+		return (XHDCP1X_SRM_HEADER_SIZE);
+	}
+	NumGenerations = SrmPtr[4];
+
+	for (Generation = 0; Generation < NumGenerations; Generation++) {
+		u32 LengthSize = (Generation == 0) ? 3 : 2;
+		u32 VrlLength = 0;
+		u32 Idx;
+
+		if (Offset + LengthSize > Size) {
+			return (0);
+		}
+		for (Idx = 0; Idx < LengthSize; Idx++) {
+			VrlLength = (VrlLength << 8) | SrmPtr[Offset + Idx];
+		}
+
+		/* The VRL length includes the length field itself */
+		if (VrlLength < LengthSize) {
+			VrlLength = LengthSize;
+		}
+		Offset += VrlLength;
+	}
+
+	return (Offset);
+}
+
 /*****************************************************************************/
 /**
 * This function sets timer start function for the module.
@@ -306,9 +306,11 @@
 *    XHdcp1x_HandleTimeout when a timer started using the interfaces in step
 *    2 expires.
 *
-* 4. Optional binding of the platform specific function that tests KSV against
-*    a stored revocation list (HDCP transmit interfaces only) using
-*    XHdcp1x_SetKsvRevokeCheck.
+* 4. Optional loading of the KSV revocation list of the interface from an
+*    HDCP 1.x SRM using XHdcp1x_LoadRevocationList (HDCP transmit interfaces
+*    only), after XHdcp1x_CfgInitialize. Alternatively a platform specific
+*    function that tests a KSV against a stored revocation list can be bound
+*    using XHdcp1x_SetKsvRevokeCheck.
 *
 * 5. Initialization, self-test, and basic configuration of the HDCP driver
 *    instances. The relevant functions are:
@@ -707,6 +709,11 @@
 * 4.2   yas    13/08/18 Addded hdcp14_PropagateTopoErrUpstream flag to track
 *                       topology failures and ready the topology for the
 *                       repeater application to read.
+* 4.3   XLNX   10/18/26 Added per-instance KSV revocation list
+*                       XHdcp1x_RevocationList and functions
+*                       XHdcp1x_LoadRevocationList, XHdcp1x_AddRevokedKsv,
+*                       XHdcp1x_ClearRevocationList, XHdcp1x_IsKsvRevoked.
+*                       Added function XHdcp1x_GetSrmSize.
 * </pre>
 *
 ******************************************************************************/
@@ -736,6 +743,16 @@ extern "C" {
 #define XHDCP1X_RPTR_MAX_DEVS_COUNT	32	/**< Maximum devices that can
 						  *  be cascaded to the
 						  *  Repeater */
+#define XHDCP1X_REVOCATION_LIST_MAX_DEVICES	128	/**< Maximum number
+							  *  of revoked KSVs,
+							  *  bounds the list
+							  *  to 2 KB per
+							  *  instance */
+#define XHDCP1X_REVOCATION_LIST_HASH_SIZE \
+	(2 * XHDCP1X_REVOCATION_LIST_MAX_DEVICES)	/**< Number of slots
+							  *  of the revoked
+							  *  KSV hash set,
+							  *  a power of 2 */
 
 #define XHdcp1x_SetCallBack  XHdcp1x_SetCallback	/**< Alternative name
 							  *  for the function
@@ -1114,6 +1131,18 @@ typedef int (*XHdcp1x_TimerStop)(void *InstancePtr);
  */
 typedef int (*XHdcp1x_TimerDelay)(void *InstancePtr, u16 DelayInMs);
 
+/**
+ * This typedef contains the revoked KSVs of an HDCP interface, kept in an
+ * open addressing hash set so that adding a KSV is O(1). Look-ups compare
+ * every slot, see XHdcp1x_IsKsvRevoked. A KSV of zero marks a free slot,
+ * as it is never a valid KSV.
+ */
+typedef struct {
+	u64 Ksv[XHDCP1X_REVOCATION_LIST_HASH_SIZE];	/**< Hash set of
+							  *  revoked KSVs */
+	u32 NumDevices;		/**< Number of revoked KSVs */
+} XHdcp1x_RevocationList;
+
 /**
  * This typedef contains an instance of an HDCP interface
  */
@@ -1132,6 +1161,8 @@ typedef struct {
 	XHdcp1x_RepeaterExchange RepeaterValues; /**< The Repeater value to
 						   *  be exchanged between
 						   *  Tx and Rx */
+	XHdcp1x_RevocationList RevocationList; /**< KSVs revoked by the
+						 *  loaded SRM */
 	void *Hdcp1xRef;	/**< A void reference pointer for
 				  *  association of a external core
 				  *  in our case a timer with the
@@ -1210,6 +1241,12 @@ void XHdcp1x_PortIntrHandler(void *InstancePtr, u32 IntCause);
 void XHdcp1x_SetDebugLogMsg(XHdcp1x_LogMsg LogFunc);
 
 void XHdcp1x_SetKsvRevokeCheck(XHdcp1x_KsvRevokeCheck RevokeCheckFunc);
+int XHdcp1x_LoadRevocationList(XHdcp1x *InstancePtr, const u8 *SrmPtr,
+		u32 SrmSize);
+u32 XHdcp1x_GetSrmSize(const u8 *SrmPtr, u32 Size);
+int XHdcp1x_AddRevokedKsv(XHdcp1x *InstancePtr, u64 Ksv);
+void XHdcp1x_ClearRevocationList(XHdcp1x *InstancePtr);
+int XHdcp1x_IsKsvRevoked(const XHdcp1x *InstancePtr, u64 Ksv);
 void XHdcp1x_SetTimerStart(XHdcp1x *InstancePtr,
 		XHdcp1x_TimerStart TimerStartFunc);
 void XHdcp1x_SetTimerStop(XHdcp1x *InstancePtr,
@@ -28,6 +28,8 @@
 * Ver   Who    Date     Changes
 * ----- ------ -------- --------------------------------------------------
 * 1.00  fidus  07/16/15 Initial release.
+* 4.3   XLNX   10/18/26 Check the revocation list of the interface in
+*                       XHdcp1x_PlatformIsKsvRevoked.
 * </pre>
 *
 ******************************************************************************/
@@ -64,7 +66,11 @@ extern XHdcp1x_KsvRevokeCheck XHdcp1xKsvRevokeCheck; /**< Instance of function
 *
 * @return	Truth value indicating the KSV is revoked (TRUE) or not (FALSE)
 *
-* @note		None.
+* @note		Both the revocation list of the interface and the platform
+*		function set by XHdcp1x_SetKsvRevokeCheck are checked for
+*		every KSV. The list look-up takes the same time for every
+*		KSV, the time of the platform function is up to its
+*		implementation.
 *
 ******************************************************************************/
 int XHdcp1x_PlatformIsKsvRevoked(const XHdcp1x *InstancePtr, u64 Ksv)
@@ -74,9 +80,12 @@ int XHdcp1x_PlatformIsKsvRevoked(const XHdcp1x *InstancePtr, u64 Ksv)
 	/* Verify arguments. */
 	Xil_AssertNonvoid(InstancePtr != NULL);
 
+	/* Revocation list of this interface */
+	IsRevoked = XHdcp1x_IsKsvRevoked(InstancePtr, Ksv);
+
 	/* Sanity Check */
 	if (XHdcp1xKsvRevokeCheck != NULL) {
-		IsRevoked = (*XHdcp1xKsvRevokeCheck)(InstancePtr, Ksv);
+		IsRevoked |= !!(*XHdcp1xKsvRevokeCheck)(InstancePtr, Ksv);
 	}
 
 	return (IsRevoked);
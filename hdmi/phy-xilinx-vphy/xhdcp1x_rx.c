@@ -57,6 +57,8 @@
 *                       XHdcp1x_RxSetTopologyMaxDevsExceeded,
 *                       XHdcp1x_RxCheckEncryptionChange.
 * 4.1   yas    11/10/16 Added function XHdcp1x_RxSetHdmiMode.
+* 4.3   XLNX   10/18/26 Hash the KSV list in chunks in
+*                       XHdcp1x_RxCalculateSHA1Value.
 * </pre>
 *
 *****************************************************************************/
@@ -1341,6 +1343,8 @@ static int XHdcp1x_RxCalculateSHA1Value(XHdcp1x *InstancePtr, u16 RepeaterInfo)
 	int IsValid = FALSE;
 	u32 KsvCount;
 	u64 tempKsv;
+	u8 KsvChunk[13 * XHDCP1X_PORT_SIZE_BKSV];
+	u32 ChunkSize = 0;
 
 	/* Initialize Buf */
 	memset(Buf, 0, 24);
@@ -1354,22 +1358,35 @@ static int XHdcp1x_RxCalculateSHA1Value(XHdcp1x *InstancePtr, u16 RepeaterInfo)
 	/* Determine theNumToRead */
 	NumToRead = ((RepeaterInfo & 0x7Fu));
 
-	/* Read one ksv at a time from the
-	 * Ksv List and send it to SHA1 Input
+	/* The Ksv List holds no more than 32 entries */
+	if (NumToRead > (sizeof(InstancePtr->RepeaterValues.KsvList) /
+			sizeof(XHdcp1x_Ksv))) {
+		NumToRead = (sizeof(InstancePtr->RepeaterValues.KsvList) /
+			sizeof(XHdcp1x_Ksv));
+	}
+
+	/* Serialize the Ksv List into a local buffer and send it to
+	 * SHA1 Input in chunks of whole SHA-1 blocks
 	 */
 	KsvCount = 0;
 
-	while (KsvCount < NumToRead) {
-		if (InstancePtr->RepeaterValues.DeviceCount > 0) {
-			tempKsv = InstancePtr->RepeaterValues.KsvList[KsvCount];
-			XHDCP1X_PORT_UINT_TO_BUF(Buf , tempKsv ,
-					(XHDCP1X_PORT_SIZE_BKSV*8));
-			SHA1Input(&Sha1Context , Buf , XHDCP1X_PORT_SIZE_BKSV);
-		}
-		else {
-			IsValid = FALSE;
-		}
+	if ((NumToRead > 0) &&
+			(InstancePtr->RepeaterValues.DeviceCount == 0)) {
+		IsValid = FALSE;
+	}
+
+	while ((KsvCount < NumToRead) && (IsValid)) {
+		tempKsv = InstancePtr->RepeaterValues.KsvList[KsvCount];
+		XHDCP1X_PORT_UINT_TO_BUF((KsvChunk + ChunkSize), tempKsv,
+				(XHDCP1X_PORT_SIZE_BKSV*8));
+		ChunkSize += XHDCP1X_PORT_SIZE_BKSV;
 		KsvCount++;
+
+		if ((ChunkSize == sizeof(KsvChunk)) ||
+				(KsvCount == NumToRead)) {
+			SHA1Input(&Sha1Context, KsvChunk, ChunkSize);
+			ChunkSize = 0;
+		}
 	}
 
 	/* Check for success */
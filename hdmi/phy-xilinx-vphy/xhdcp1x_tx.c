@@ -61,6 +61,11 @@
 *                       it available in XHdcp1x_TxGetTopology().
 *                       Updating the XHdcp1x_TxReset() to clear the
 *                       Authentication Request flag.
+* 4.3   XLNX   10/18/26 Read the KSV FIFO in chunks in
+*                       XHdcp1x_TxValidateKsvList and update V per chunk.
+*                       Validate and revocation check the KSV list of a
+*                       repeater, using a population count for the 20 ones
+*                       check.
 * </pre>
 *
 *****************************************************************************/
@@ -71,6 +76,7 @@
 #include "sha1.h"
 //#include <stdio.h>
 //#include <stdlib.h>
+#include <linux/bitops.h>
 #include <linux/string.h>
 #include "xhdcp1x.h"
 #include "xhdcp1x_cipher.h"
@@ -101,6 +107,22 @@
 #define XHDCP1X_MAX_BCAPS_RDY_POLL_CNT	(55) /**< Max times to poll on BCaps
 					  *  Ready bit at 100ms interval */
 
+#if (defined(XPAR_XV_HDMITX_NUM_INSTANCES) && \
+     (XPAR_XV_HDMITX_NUM_INSTANCES > 0)) || \
+    (defined(XPAR_XV_HDMITX1_NUM_INSTANCES) && \
+     (XPAR_XV_HDMITX1_NUM_INSTANCES > 0))
+/** Bytes of the KSV FIFO read per DDC transaction, 13 KSVs so that every
+ *  chunk completes at least one SHA-1 block */
+#define XHDCP1X_TX_KSVFIFO_CHUNK_SIZE	(13 * XHDCP1X_PORT_SIZE_BKSV)
+#else
+/** Bytes of the KSV FIFO read per AUX transaction */
+#define XHDCP1X_TX_KSVFIFO_CHUNK_SIZE	XHDCP1X_PORT_SIZE_KSVFIFO
+#endif
+
+/** Number of entries of the repeater KSV list */
+#define XHDCP1X_TX_KSVLIST_SIZE \
+	(sizeof(((XHdcp1x_RepeaterExchange *)0)->KsvList) / sizeof(XHdcp1x_Ksv))
+
 /**************************** Type Definitions *******************************/
 
 /**
@@ -158,6 +180,7 @@ static void XHdcp1x_TxCheckRxCapable(const XHdcp1x *InstancePtr,
 		XHdcp1x_StateType *NextStatePtr);
 static u64 XHdcp1x_TxGenerateAn(XHdcp1x *InstancePtr);
 static int XHdcp1x_TxIsKsvValid(u64 Ksv);
+static int XHdcp1x_TxIsKsvListValid(const u8 *KsvBuf, int NumKsvs);
 static void XHdcp1x_TxExchangeKsvs(XHdcp1x *InstancePtr,
 		XHdcp1x_StateType *NextStatePtr);
 static void XHdcp1x_TxStartComputations(XHdcp1x *InstancePtr,
@@ -1383,23 +1406,49 @@ static u64 XHdcp1x_TxGenerateAn(XHdcp1x *InstancePtr)
 ******************************************************************************/
 static int XHdcp1x_TxIsKsvValid(u64 Ksv)
 {
-	int IsValid = FALSE;
-	int NumOnes = 0;
+	/* Check for 20 1s */
+	return (hweight64(Ksv) == 20);
+}
 
-	/* Determine NumOnes */
-	while (Ksv != 0) {
-		if ((Ksv & 1) != 0) {
-			NumOnes++;
-		}
-		Ksv >>= 1;
-	}
+/*****************************************************************************/
+/**
+* This function validates a list of KSVs as read from the KSV FIFO. The
+* number of ones of every KSV is checked without exiting early, so the time
+* taken only depends on the length of the list.
+*
+* @param	KsvBuf is the list of KSVs, XHDCP1X_PORT_SIZE_BKSV bytes each
+*		in KSV FIFO (little endian) byte order.
+* @param	NumKsvs is the number of KSVs in the list.
+*
+* @return	Truth value indicating all KSVs are valid (TRUE) or not (FALSE).
+*
+* @note		For DisplayPort null KSVs are skipped, see
+*		XHdcp1x_TxValidateKsvList.
+*
+******************************************************************************/
+static int XHdcp1x_TxIsKsvListValid(const u8 *KsvBuf, int NumKsvs)
+{
+	u32 Invalid = 0;
+	int Idx;
 
-	/* Check for 20 1s */
-	if (NumOnes == 20) {
-		IsValid = TRUE;
+	for (Idx = 0; Idx < NumKsvs; Idx++) {
+		u64 Ksv = 0;
+
+		XHDCP1X_PORT_BUF_TO_UINT(Ksv,
+				(KsvBuf + (Idx * XHDCP1X_PORT_SIZE_BKSV)),
+				XHDCP1X_PORT_SIZE_BKSV * 8);
+#if !((defined(XPAR_XV_HDMITX_NUM_INSTANCES) && \
+     (XPAR_XV_HDMITX_NUM_INSTANCES > 0)) || \
+    (defined(XPAR_XV_HDMITX1_NUM_INSTANCES) && \
+     (XPAR_XV_HDMITX1_NUM_INSTANCES > 0)))
+		if (Ksv == 0) {
+			continue;
+		}
+#endif
+		Invalid |= (hweight64(Ksv) ^ 20);
 	}
 
-	return (IsValid);
+	return (Invalid == 0);
 }
 
 /*****************************************************************************/
@@ -1900,34 +1949,22 @@ static void XHdcp1x_TxPollForWaitForReady(XHdcp1x *InstancePtr,
 *
 * @return	Truth value indicating valid (TRUE) or invalid (FALSE).
 *
-* @note		None.
+* @note		The whole list is always read, checked and hashed, an invalid
+*		or revoked KSV only clears a flag, so the time taken does not
+*		depend on where such a KSV is in the list. Only a failed
+*		read of the KSV FIFO ends the loop early.
 *
 ******************************************************************************/
 static int XHdcp1x_TxValidateKsvList(XHdcp1x *InstancePtr, u16 RepeaterInfo)
 {
 	SHA1Context Sha1Context;
 	u8 Buf[24];
+	u8 KsvChunk[XHDCP1X_TX_KSVFIFO_CHUNK_SIZE];
 	int NumToRead = 0;
 	int KsvCount = 0;
 	int IsValid = FALSE;
-
-	u8 ksvListHolder[127*XHDCP1X_PORT_SIZE_BKSV];
-
-#if (defined(XPAR_XV_HDMITX_NUM_INSTANCES) && \
-     (XPAR_XV_HDMITX_NUM_INSTANCES > 0)) || \
-    (defined(XPAR_XV_HDMITX1_NUM_INSTANCES) && \
-     (XPAR_XV_HDMITX1_NUM_INSTANCES > 0))
-
-#else
-
-	int NumOfKsvsToRead = 0;
-	unsigned int KSVListSize = 0;
-	unsigned int ksvListByteCount = 0;
-
-#endif
-
-	/* Initialize the local KSV fifo */
-	memset(ksvListHolder, 0, (127*XHDCP1X_PORT_SIZE_BKSV));
+	int IsListValid = TRUE;
+	int IsRevoked = FALSE;
 
 	/* Initialize Buf */
 	memset(Buf, 0, 24);
@@ -1941,110 +1978,80 @@ static int XHdcp1x_TxValidateKsvList(XHdcp1x *InstancePtr, u16 RepeaterInfo)
 	/* Determine theNumToRead */
 	NumToRead = (((RepeaterInfo & 0x7Fu) * 5));
 
-#if (defined(XPAR_XV_HDMITX_NUM_INSTANCES) && \
-     (XPAR_XV_HDMITX_NUM_INSTANCES > 0)) || \
-    (defined(XPAR_XV_HDMITX1_NUM_INSTANCES) && \
-     (XPAR_XV_HDMITX1_NUM_INSTANCES > 0))
-	/* Read the ksv list */
-	/* Read the entire KSV fifo list in one go */
-	int ByteCount = 0;
-
-	if(XHdcp1x_PortRead(InstancePtr, XHDCP1X_PORT_OFFSET_KSVFIFO,
-			ksvListHolder, NumToRead) ) {
-
-		/* Update the calculation of V */
-		SHA1Input(&Sha1Context, ksvListHolder, NumToRead);
-
-		/* Update this value in the RepeaterExchange
-		 * structure to be read later by RX */
-
-		u64 Value = 0;
-		u32 Index;
-		while (ByteCount < NumToRead) {
-			if((ByteCount + 1) % 5 == 0) {
-
-				Index = (((ByteCount+1) / XHDCP1X_PORT_SIZE_BKSV) - 1) * XHDCP1X_PORT_SIZE_BKSV;
-
-				XHDCP1X_PORT_BUF_TO_UINT(Value ,
-						(ksvListHolder + ( (((ByteCount+1)
-						/ XHDCP1X_PORT_SIZE_BKSV) - 1)
-						* XHDCP1X_PORT_SIZE_BKSV)),
-					XHDCP1X_PORT_SIZE_BKSV * 8);
-				if (!(Value)) {
-					XHdcp1x_TxDebugLog(InstancePtr ,
-						"Error: Null KSV read "
-						"from downstream KSV List");
-				}
-				InstancePtr->RepeaterValues.KsvList[KsvCount++] =
-					(Value & 0xFFFFFFFFFFul);
-				Value = 0;
-			}
-
-			ByteCount++;
-
-		}
-
-		UNUSED(Index);
-	}
-	else {
-		/* Update the statistics */
-		InstancePtr->Tx.Stats.ReadFailures++;
-
-		/* Update IsValid */
-		IsValid = FALSE;
-	}
-
-#else
-
-	NumOfKsvsToRead = (NumToRead / 5);
-
-	KSVListSize = NumOfKsvsToRead;
-
-	/* Read the ksv list */
-	do {
-		/* Read 15 bytes at a go */
-		int NumThisTime = XHDCP1X_PORT_SIZE_KSVFIFO;
-		int NumOfKsvsThisTime = 3;
+	/* Read the ksv list in chunks, the KSV FIFO pointer auto increments.
+	 * Each chunk is hashed and split into KSVs as soon as it is read, so
+	 * no copy of the complete list is needed to compute V */
+	while (NumToRead > 0) {
+		int NumThisTime = XHDCP1X_TX_KSVFIFO_CHUNK_SIZE;
+		int Offset = 0;
 
 		/* Truncate if necessary */
 		if (NumThisTime > NumToRead) {
 			NumThisTime = NumToRead;
 		}
 
-		if (NumOfKsvsThisTime > NumOfKsvsToRead) {
-			NumOfKsvsThisTime = NumOfKsvsToRead;
-		}
-
 		/* Read the next chunk of the list */
 		if (XHdcp1x_PortRead(InstancePtr, XHDCP1X_PORT_OFFSET_KSVFIFO,
-				Buf, NumThisTime) > 0) {
-
-			/* Update the calculation of V */
-			SHA1Input(&Sha1Context, Buf, NumThisTime);
-
-			/* Duplicate the buffer */
-			int BufReadKsvCount=0;
-			while(BufReadKsvCount < NumThisTime) {
-				ksvListHolder[ksvListByteCount++] = Buf[BufReadKsvCount];
-				BufReadKsvCount++;
-			}
-
-		}
-		else {
+				KsvChunk, NumThisTime) <= 0) {
 			/* Update the statistics */
 			InstancePtr->Tx.Stats.ReadFailures++;
 
 			/* Update IsValid */
 			IsValid = FALSE;
+			break;
 		}
 
-		/* Update for loop */
-		NumToRead -= NumThisTime;
-		NumOfKsvsToRead -= NumOfKsvsThisTime;
+		/* Update the calculation of V */
+		SHA1Input(&Sha1Context, KsvChunk, NumThisTime);
+
+		/* Check all KSVs of the chunk at once */
+		IsListValid &= XHdcp1x_TxIsKsvListValid(KsvChunk,
+				NumThisTime / XHDCP1X_PORT_SIZE_BKSV);
 
-	} while ((NumToRead > 0) && (IsValid));
+		/* Update the KSVs in the RepeaterExchange structure to be
+		 * read later by RX */
+		while (Offset < NumThisTime) {
+			u64 Value = 0;
+
+			XHDCP1X_PORT_BUF_TO_UINT(Value, (KsvChunk + Offset),
+					XHDCP1X_PORT_SIZE_BKSV * 8);
+			Offset += XHDCP1X_PORT_SIZE_BKSV;
 
+			if (!(Value)) {
+				XHdcp1x_TxDebugLog(InstancePtr ,
+					"Error: Null KSV read "
+					"from downstream KSV List");
+#if !((defined(XPAR_XV_HDMITX_NUM_INSTANCES) && \
+     (XPAR_XV_HDMITX_NUM_INSTANCES > 0)) || \
+    (defined(XPAR_XV_HDMITX1_NUM_INSTANCES) && \
+     (XPAR_XV_HDMITX1_NUM_INSTANCES > 0)))
+				continue;
 #endif
+			}
+
+			/* Check for revoked */
+			IsRevoked |= XHdcp1x_PlatformIsKsvRevoked(InstancePtr,
+					Value);
+
+			/* Keep room for the Bksv of the attached repeater */
+			if (KsvCount < (XHDCP1X_TX_KSVLIST_SIZE - 1)) {
+				InstancePtr->RepeaterValues.KsvList[KsvCount++] =
+					(Value & 0xFFFFFFFFFFul);
+			}
+		}
+
+		/* Update for loop */
+		NumToRead -= NumThisTime;
+	}
+
+	if (!IsListValid) {
+		XHdcp1x_TxDebugLog(InstancePtr, "ksv list invalid");
+		IsValid = FALSE;
+	}
+	if (IsRevoked) {
+		XHdcp1x_TxDebugLog(InstancePtr, "ksv list holds a revoked ksv");
+		IsValid = FALSE;
+	}
 
 	/* Check for success */
 	if (IsValid) {
@@ -2135,41 +2142,6 @@ static int XHdcp1x_TxValidateKsvList(XHdcp1x *InstancePtr, u16 RepeaterInfo)
 	}
 
 	if (InstancePtr->IsRepeater) {
-
-#if (defined(XPAR_XV_HDMITX_NUM_INSTANCES) && \
-     (XPAR_XV_HDMITX_NUM_INSTANCES > 0)) || \
-    (defined(XPAR_XV_HDMITX1_NUM_INSTANCES) && \
-     (XPAR_XV_HDMITX1_NUM_INSTANCES > 0))
-			/* Do nothing */
-#else
-		/* Update this value in the RepeaterExchange
-		 * structure to be read later by RX
-		 */
-		u64 Value = 0;
-		u32 thisKsv = 0;
-		while(thisKsv < KSVListSize) {
-
-			XHDCP1X_PORT_BUF_TO_UINT(Value ,
-				(ksvListHolder +
-				(thisKsv * XHDCP1X_PORT_SIZE_BKSV)) ,
-				XHDCP1X_PORT_SIZE_BKSV * 8);
-			if (!(Value)) {
-				XHdcp1x_TxDebugLog(InstancePtr ,
-					"Error: Null KSV read "
-					"from downstream KSV List");
-				thisKsv++;
-				continue;
-			}
-
-
-			InstancePtr->RepeaterValues.KsvList[KsvCount++] =
-				(Value & 0xFFFFFFFFFFul);
-
-			Value = 0;
-			thisKsv++;
-		}
-#endif
-
 		{
 			u8 Bksv[5];
 
@@ -0,0 +1,1035 @@
+/******************************************************************************
+*
+ *
+ * Copyright (C) 2015, 2016, 2017 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xhdcp22_loopback.c
+* @{
+* @details
+*
+* This file contains the implementation of the HDCP 2.2 TX to RX loopback
+* benchmark. The transmitter DDC read/write handlers and the receiver DDC
+* register handlers are redirected to a software model of the HDCP DDC
+* register space, so both state machines can authenticate against each other
+* without an HDMI link.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ------ -------- --------------------------------------------------
+* 1.00  XLNX   10/18/26 Initial release.
+* 1.01  XLNX   10/18/26 Stub the status callbacks of both instances while
+*                       connected and leave the re-initialization of the
+*                       cores to the caller. Poll the receiver before a
+*                       new message is written, as during a DDC transfer.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <linux/kernel.h>
+#include <linux/ktime.h>
+#include <linux/math64.h>
+#include <linux/sched.h>
+#include <linux/string.h>
+#include "xhdcp22_loopback.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XHDCP22_LOOPBACK_DDC_ADDRESS      0x3A /**< HDCP port I2C address */
+#define XHDCP22_LOOPBACK_VERSION_REG      0x50 /**< HDCP2Version */
+#define XHDCP22_LOOPBACK_WRITE_REG        0x60 /**< Write_Message */
+#define XHDCP22_LOOPBACK_RXSTATUS0_REG    0x70 /**< RxStatus[7:0] */
+#define XHDCP22_LOOPBACK_RXSTATUS1_REG    0x71 /**< RxStatus[15:8] */
+#define XHDCP22_LOOPBACK_READ_REG         0x80 /**< Read_Message */
+
+/** HDCP2Version register value advertising HDCP 2.2 */
+#define XHDCP22_LOOPBACK_VERSION_HDCP22   0x04
+
+/** Message_Size bits inside RxStatus[15:8] */
+#define XHDCP22_LOOPBACK_RXSTATUS1_SIZE_MASK 0x03
+
+/** Time-out of a test vector that is expected to fail, in milliseconds */
+#define XHDCP22_LOOPBACK_FAIL_TIMEOUT     500
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/**************************** Type Definitions *******************************/
+
+/************************** Function Prototypes ******************************/
+
+static int XHdcp22Loopback_TxDdcWrite(u8 DeviceAddress, u16 ByteCount,
+                                      u8 *BufferPtr, u8 Stop, void *RefPtr);
+static int XHdcp22Loopback_TxDdcRead(u8 DeviceAddress, u16 ByteCount,
+                                     u8 *BufferPtr, u8 Stop, void *RefPtr);
+static void XHdcp22Loopback_RxSetAddress(void *RefPtr, u32 Data);
+static void XHdcp22Loopback_RxSetData(void *RefPtr, u32 Data);
+static u32 XHdcp22Loopback_RxGetData(void *RefPtr);
+static u32 XHdcp22Loopback_RxGetWriteBufferSize(void *RefPtr);
+static u32 XHdcp22Loopback_RxGetReadBufferSize(void *RefPtr);
+static u32 XHdcp22Loopback_RxIsWriteBufferEmpty(void *RefPtr);
+static u32 XHdcp22Loopback_RxIsReadBufferEmpty(void *RefPtr);
+static void XHdcp22Loopback_RxClearReadBuffer(void *RefPtr);
+static void XHdcp22Loopback_RxClearWriteBuffer(void *RefPtr);
+static void XHdcp22Loopback_RxTopologyUpdate(void *RefPtr);
+static void XHdcp22Loopback_RecordMsg(XHdcp22_Loopback *InstancePtr, u8 MsgId);
+static void XHdcp22Loopback_RxPoll(XHdcp22_Loopback *InstancePtr);
+static void XHdcp22Loopback_ResetDdc(XHdcp22_Loopback *InstancePtr);
+static int XHdcp22Loopback_RunOnce(XHdcp22_Loopback *InstancePtr);
+
+/************************** Variable Definitions *****************************/
+
+/** Message names indexed by HDCP 2.2 message ID */
+static const char *XHdcp22Loopback_MsgNames[XHDCP22_LOOPBACK_NUM_MSG_IDS] = {
+	NULL, NULL,
+	"AKE_Init",
+	"AKE_Send_Cert",
+	"AKE_No_Stored_km",
+	"AKE_Stored_km",
+	NULL,
+	"AKE_Send_H_prime",
+	"AKE_Send_Pairing_Info",
+	"LC_Init",
+	"LC_Send_L_prime",
+	"SKE_Send_Eks",
+	"RepeaterAuth_Send_ReceiverID_List",
+	NULL, NULL,
+	"RepeaterAuth_Send_Ack",
+	"RepeaterAuth_Stream_Manage",
+	"RepeaterAuth_Stream_Ready",
+};
+
+/** Test vectors run by XHdcp22Loopback_SelfTest, at most 32 */
+static const XHdcp22_Loopback_Vector XHdcp22Loopback_Vectors[] = {
+	{"Receiver, AKE_No_Stored_km",
+	 {1, 0, FALSE, FALSE, 0, 0, XHDCP22_STREAMTYPE_0, FALSE}, XST_SUCCESS},
+	{"Receiver, AKE_Stored_km",
+	 {2, 0, TRUE, FALSE, 0, 0, XHDCP22_STREAMTYPE_0, FALSE}, XST_SUCCESS},
+	{"Repeater, 1 device, type 0",
+	 {1, 0, FALSE, TRUE, 1, 1, XHDCP22_STREAMTYPE_0, FALSE}, XST_SUCCESS},
+	{"Repeater, 31 devices, depth 4, type 1",
+	 {1, 0, FALSE, TRUE, 31, 4, XHDCP22_STREAMTYPE_1, FALSE}, XST_SUCCESS},
+	{"Repeater, AKE_Stored_km, type 1",
+	 {2, 0, TRUE, TRUE, 8, 2, XHDCP22_STREAMTYPE_1, FALSE}, XST_SUCCESS},
+	{"Repeater, MaxCascadeExceeded",
+	 {1, XHDCP22_LOOPBACK_FAIL_TIMEOUT, FALSE, TRUE, 1, 4,
+	  XHDCP22_STREAMTYPE_0, TRUE}, XST_FAILURE},
+};
+
+/** Distinct bytes with four ones, making the receiver IDs unique */
+static const u8 XHdcp22Loopback_RcvIdTag[4] = {0x5A, 0xA5, 0x3C, 0xC3};
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function connects a transmitter and a receiver instance through the
+* DDC model. The current handlers of both instances, the receiver mode and
+* the transmitter content stream type are saved and restored by
+* #XHdcp22Loopback_Release. The authentication status callbacks of both
+* instances are not called while connected, so the subsystem drivers do not
+* see the loopback authentications.
+*
+* @param  InstancePtr is a pointer to the loopback instance.
+* @param  TxPtr is a pointer to an initialized XHdcp22_Tx instance.
+* @param  RxPtr is a pointer to an initialized XHdcp22_Rx instance.
+*
+* @return
+*         - XST_SUCCESS if both instances are connected.
+*         - XST_FAILURE if one of the instances is not ready.
+*
+* @note   None.
+*
+******************************************************************************/
+int XHdcp22Loopback_Initialize(XHdcp22_Loopback *InstancePtr,
+                               XHdcp22_Tx *TxPtr, XHdcp22_Rx *RxPtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(TxPtr != NULL);
+	Xil_AssertNonvoid(RxPtr != NULL);
+
+	if (TxPtr->IsReady != XIL_COMPONENT_IS_READY ||
+	    RxPtr->IsReady != XIL_COMPONENT_IS_READY) {
+		return XST_FAILURE;
+	}
+
+	memset(InstancePtr, 0, sizeof(XHdcp22_Loopback));
+	InstancePtr->TxPtr = TxPtr;
+	InstancePtr->RxPtr = RxPtr;
+
+	/* Save the handlers installed by the subsystem drivers */
+	InstancePtr->TxDdcRead = TxPtr->DdcRead;
+	InstancePtr->TxDdcWrite = TxPtr->DdcWrite;
+	InstancePtr->TxDdcHandlerRef = TxPtr->DdcHandlerRef;
+	InstancePtr->TxIsDdcReadSet = TxPtr->IsDdcReadSet;
+	InstancePtr->TxIsDdcWriteSet = TxPtr->IsDdcWriteSet;
+	InstancePtr->TxAuthenticatedCallback = TxPtr->AuthenticatedCallback;
+	InstancePtr->TxAuthenticatedCallbackRef = TxPtr->AuthenticatedCallbackRef;
+	InstancePtr->TxIsAuthenticatedCallbackSet =
+		TxPtr->IsAuthenticatedCallbackSet;
+	InstancePtr->TxUnauthenticatedCallback = TxPtr->UnauthenticatedCallback;
+	InstancePtr->TxUnauthenticatedCallbackRef =
+		TxPtr->UnauthenticatedCallbackRef;
+	InstancePtr->TxIsUnauthenticatedCallbackSet =
+		TxPtr->IsUnauthenticatedCallbackSet;
+	InstancePtr->TxTopologyCallback =
+		TxPtr->DownstreamTopologyAvailableCallback;
+	InstancePtr->TxTopologyCallbackRef =
+		TxPtr->DownstreamTopologyAvailableCallbackRef;
+	InstancePtr->TxIsTopologyCallbackSet =
+		TxPtr->IsDownstreamTopologyAvailableCallbackSet;
+	InstancePtr->TxContentStreamType = TxPtr->Info.ContentStreamType;
+	InstancePtr->TxIsContentStreamTypeSet = TxPtr->Info.IsContentStreamTypeSet;
+	memcpy(&InstancePtr->RxHandles, &RxPtr->Handles,
+	       sizeof(XHdcp22_Rx_Handles));
+	InstancePtr->RxMode = RxPtr->Config.Mode;
+
+	/* Only the loopback handlers are called while connected */
+	TxPtr->IsAuthenticatedCallbackSet = (FALSE);
+	TxPtr->IsUnauthenticatedCallbackSet = (FALSE);
+	TxPtr->IsDownstreamTopologyAvailableCallbackSet = (FALSE);
+	memset(&RxPtr->Handles, 0, sizeof(XHdcp22_Rx_Handles));
+
+	XHdcp22Loopback_ResetDdc(InstancePtr);
+
+	/* Transmitter side of the DDC model */
+	XHdcp22Tx_SetCallback(TxPtr, XHDCP22_TX_HANDLER_DDC_WRITE,
+	                      (void *)XHdcp22Loopback_TxDdcWrite, InstancePtr);
+	XHdcp22Tx_SetCallback(TxPtr, XHDCP22_TX_HANDLER_DDC_READ,
+	                      (void *)XHdcp22Loopback_TxDdcRead, InstancePtr);
+
+	/* Receiver side of the DDC model */
+	XHdcp22Rx_SetCallback(RxPtr, XHDCP22_RX_HANDLER_DDC_SETREGADDR,
+	                      (void *)XHdcp22Loopback_RxSetAddress, InstancePtr);
+	XHdcp22Rx_SetCallback(RxPtr, XHDCP22_RX_HANDLER_DDC_SETREGDATA,
+	                      (void *)XHdcp22Loopback_RxSetData, InstancePtr);
+	XHdcp22Rx_SetCallback(RxPtr, XHDCP22_RX_HANDLER_DDC_GETREGDATA,
+	                      (void *)XHdcp22Loopback_RxGetData, InstancePtr);
+	XHdcp22Rx_SetCallback(RxPtr, XHDCP22_RX_HANDLER_DDC_GETWBUFSIZE,
+	                      (void *)XHdcp22Loopback_RxGetWriteBufferSize, InstancePtr);
+	XHdcp22Rx_SetCallback(RxPtr, XHDCP22_RX_HANDLER_DDC_GETRBUFSIZE,
+	                      (void *)XHdcp22Loopback_RxGetReadBufferSize, InstancePtr);
+	XHdcp22Rx_SetCallback(RxPtr, XHDCP22_RX_HANDLER_DDC_ISWBUFEMPTY,
+	                      (void *)XHdcp22Loopback_RxIsWriteBufferEmpty, InstancePtr);
+	XHdcp22Rx_SetCallback(RxPtr, XHDCP22_RX_HANDLER_DDC_ISRBUFEMPTY,
+	                      (void *)XHdcp22Loopback_RxIsReadBufferEmpty, InstancePtr);
+	XHdcp22Rx_SetCallback(RxPtr, XHDCP22_RX_HANDLER_DDC_CLEARRBUF,
+	                      (void *)XHdcp22Loopback_RxClearReadBuffer, InstancePtr);
+	XHdcp22Rx_SetCallback(RxPtr, XHDCP22_RX_HANDLER_DDC_CLEARWBUF,
+	                      (void *)XHdcp22Loopback_RxClearWriteBuffer, InstancePtr);
+	XHdcp22Rx_SetCallback(RxPtr, XHDCP22_RX_HANDLER_TOPOLOGY_UPDATE,
+	                      (void *)XHdcp22Loopback_RxTopologyUpdate, InstancePtr);
+
+	XHdcp22Loopback_StatsReset(InstancePtr);
+	InstancePtr->IsConnected = (TRUE);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function disconnects the transmitter and receiver from the DDC model
+* and restores the handlers and settings that were saved by
+* #XHdcp22Loopback_Initialize. Both state machines are left disabled and the
+* pairing info of the loopback receiver is cleared.
+*
+* @param  InstancePtr is a pointer to the loopback instance.
+*
+* @return None.
+*
+* @note   The cores are not reset. The caller re-initializes them through
+*         the subsystem drivers, which also reset the DDC.
+*
+******************************************************************************/
+void XHdcp22Loopback_Release(XHdcp22_Loopback *InstancePtr)
+{
+	XHdcp22_Tx *TxPtr;
+	XHdcp22_Rx *RxPtr;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	if (!InstancePtr->IsConnected)
+		return;
+
+	TxPtr = InstancePtr->TxPtr;
+	RxPtr = InstancePtr->RxPtr;
+
+	XHdcp22Tx_Disable(TxPtr);
+	XHdcp22Tx_ClearPairingInfo(TxPtr);
+	XHdcp22Rx_Disable(RxPtr);
+
+	TxPtr->DdcRead = InstancePtr->TxDdcRead;
+	TxPtr->DdcWrite = InstancePtr->TxDdcWrite;
+	TxPtr->DdcHandlerRef = InstancePtr->TxDdcHandlerRef;
+	TxPtr->IsDdcReadSet = InstancePtr->TxIsDdcReadSet;
+	TxPtr->IsDdcWriteSet = InstancePtr->TxIsDdcWriteSet;
+	TxPtr->AuthenticatedCallback = InstancePtr->TxAuthenticatedCallback;
+	TxPtr->AuthenticatedCallbackRef = InstancePtr->TxAuthenticatedCallbackRef;
+	TxPtr->IsAuthenticatedCallbackSet =
+		InstancePtr->TxIsAuthenticatedCallbackSet;
+	TxPtr->UnauthenticatedCallback = InstancePtr->TxUnauthenticatedCallback;
+	TxPtr->UnauthenticatedCallbackRef =
+		InstancePtr->TxUnauthenticatedCallbackRef;
+	TxPtr->IsUnauthenticatedCallbackSet =
+		InstancePtr->TxIsUnauthenticatedCallbackSet;
+	TxPtr->DownstreamTopologyAvailableCallback =
+		InstancePtr->TxTopologyCallback;
+	TxPtr->DownstreamTopologyAvailableCallbackRef =
+		InstancePtr->TxTopologyCallbackRef;
+	TxPtr->IsDownstreamTopologyAvailableCallbackSet =
+		InstancePtr->TxIsTopologyCallbackSet;
+	TxPtr->Info.ContentStreamType = InstancePtr->TxContentStreamType;
+	TxPtr->Info.IsContentStreamTypeSet = InstancePtr->TxIsContentStreamTypeSet;
+	memcpy(&RxPtr->Handles, &InstancePtr->RxHandles,
+	       sizeof(XHdcp22_Rx_Handles));
+	XHdcp22Rx_SetRepeater(RxPtr, InstancePtr->RxMode == XHDCP22_RX_REPEATER);
+
+	InstancePtr->IsConnected = (FALSE);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function clears the accumulated benchmark results.
+*
+* @param  InstancePtr is a pointer to the loopback instance.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+void XHdcp22Loopback_StatsReset(XHdcp22_Loopback *InstancePtr)
+{
+	int Idx;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	memset(&InstancePtr->Stats, 0, sizeof(XHdcp22_Loopback_Stats));
+	InstancePtr->Stats.MinNs = U64_MAX;
+	for (Idx = 0; Idx < XHDCP22_LOOPBACK_NUM_MSG_IDS; Idx++)
+		InstancePtr->Stats.Msg[Idx].MinNs = U64_MAX;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs a number of authentications between the connected
+* transmitter and receiver and accumulates the results in the statistics.
+*
+* @param  InstancePtr is a pointer to the loopback instance.
+* @param  OptionsPtr is a pointer to the run options.
+*
+* @return
+*         - XST_SUCCESS if all authentications passed.
+*         - XST_FAILURE if at least one authentication failed or timed out.
+*
+* @note   This function busy polls both state machines and must be called
+*         from a context that may sleep.
+*
+******************************************************************************/
+int XHdcp22Loopback_Run(XHdcp22_Loopback *InstancePtr,
+                        const XHdcp22_Loopback_Options *OptionsPtr)
+{
+	int Result = XST_SUCCESS;
+	u32 Iteration;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(OptionsPtr != NULL);
+	Xil_AssertNonvoid(OptionsPtr->DeviceCnt <= 31);
+
+	if (!InstancePtr->IsConnected)
+		return XST_FAILURE;
+
+	memcpy(&InstancePtr->Options, OptionsPtr, sizeof(XHdcp22_Loopback_Options));
+	if (InstancePtr->Options.TimeOut_mSec == 0)
+		InstancePtr->Options.TimeOut_mSec = XHDCP22_LOOPBACK_DEFAULT_TIMEOUT;
+
+	/* Always start with the full AKE_No_Stored_km exchange */
+	XHdcp22Tx_ClearPairingInfo(InstancePtr->TxPtr);
+
+	for (Iteration = 0; Iteration < InstancePtr->Options.Iterations; Iteration++) {
+		if (XHdcp22Loopback_RunOnce(InstancePtr) != XST_SUCCESS)
+			Result = XST_FAILURE;
+	}
+
+	return Result;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs the built-in test vectors: AKE with and without stored
+* km against a receiver and against repeaters with various topologies and
+* content stream types, and a repeater topology error that must make the
+* authentication fail. The results are accumulated in the statistics.
+*
+* @param  InstancePtr is a pointer to the loopback instance.
+* @param  Iterations is the number of times every test vector is run.
+*
+* @return
+*         - XST_SUCCESS if all test vectors gave the expected result.
+*         - XST_FAILURE otherwise.
+*
+* @note   As #XHdcp22Loopback_Run.
+*
+******************************************************************************/
+int XHdcp22Loopback_SelfTest(XHdcp22_Loopback *InstancePtr, u32 Iterations)
+{
+	const XHdcp22_Loopback_Vector *VectorPtr;
+	XHdcp22_Loopback_Options Options;
+	int Result = XST_SUCCESS;
+	u32 Idx;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	for (Idx = 0; Idx < ARRAY_SIZE(XHdcp22Loopback_Vectors); Idx++) {
+		VectorPtr = &XHdcp22Loopback_Vectors[Idx];
+		Options = VectorPtr->Options;
+		Options.Iterations *= Iterations;
+
+		if (XHdcp22Loopback_Run(InstancePtr, &Options) ==
+		    VectorPtr->ExpectedResult) {
+			InstancePtr->Stats.VectorsPassed++;
+		} else {
+			InstancePtr->Stats.VectorsFailed++;
+			InstancePtr->Stats.FailedVectors |= BIT(Idx);
+			Result = XST_FAILURE;
+		}
+	}
+
+	return Result;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function prints the accumulated benchmark results into a buffer.
+*
+* @param  InstancePtr is a pointer to the loopback instance.
+* @param  buff is a pointer to the buffer to write to.
+* @param  buff_size is the size of the passed buffer.
+*
+* @return Number of characters printed to the buffer.
+*
+* @note   None.
+*
+******************************************************************************/
+int XHdcp22Loopback_StatsShow(XHdcp22_Loopback *InstancePtr, char *buff,
+                              int buff_size)
+{
+	XHdcp22_Loopback_Stats *StatsPtr;
+	XHdcp22_Loopback_MsgStats *MsgPtr;
+	int strSize = 0;
+	int Idx;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	StatsPtr = &InstancePtr->Stats;
+
+	strSize += scnprintf(buff+strSize, buff_size-strSize,
+			"\r\n-------HDCP22 loopback results-------\r\n");
+	strSize += scnprintf(buff+strSize, buff_size-strSize,
+			"Authentications: %u passed, %u failed\r\n",
+			StatsPtr->Passed, StatsPtr->Failed);
+	if (StatsPtr->Passed) {
+		strSize += scnprintf(buff+strSize, buff_size-strSize,
+				"Total (us): avg %llu min %llu max %llu\r\n",
+				div_u64(StatsPtr->TotalNs, StatsPtr->Passed) / 1000,
+				StatsPtr->MinNs / 1000, StatsPtr->MaxNs / 1000);
+	}
+	strSize += scnprintf(buff+strSize, buff_size-strSize,
+			"TX poll: %u calls, %llu us\r\n",
+			StatsPtr->TxPolls, StatsPtr->TxCpuNs / 1000);
+	strSize += scnprintf(buff+strSize, buff_size-strSize,
+			"RX poll: %u calls, %llu us\r\n",
+			StatsPtr->RxPolls, StatsPtr->RxCpuNs / 1000);
+	strSize += scnprintf(buff+strSize, buff_size-strSize,
+			"DDC: %u writes, %u reads, %u RxStatus reads\r\n",
+			StatsPtr->DdcWrites, StatsPtr->DdcReads,
+			StatsPtr->RxStatusReads);
+	if (StatsPtr->VectorsPassed || StatsPtr->VectorsFailed) {
+		strSize += scnprintf(buff+strSize, buff_size-strSize,
+				"Test vectors: %u passed, %u failed\r\n",
+				StatsPtr->VectorsPassed, StatsPtr->VectorsFailed);
+		for (Idx = 0; Idx < ARRAY_SIZE(XHdcp22Loopback_Vectors); Idx++) {
+			if (!(StatsPtr->FailedVectors & BIT(Idx)))
+				continue;
+			strSize += scnprintf(buff+strSize, buff_size-strSize,
+					"Failed: %s\r\n",
+					XHdcp22Loopback_Vectors[Idx].Name);
+		}
+	}
+	strSize += scnprintf(buff+strSize, buff_size-strSize,
+			"[Message] count avg(us) min(us) max(us)\r\n");
+
+	for (Idx = 0; Idx < XHDCP22_LOOPBACK_NUM_MSG_IDS; Idx++) {
+		MsgPtr = &StatsPtr->Msg[Idx];
+		if (MsgPtr->Count == 0)
+			continue;
+		strSize += scnprintf(buff+strSize, buff_size-strSize,
+				"[%s] %u %llu %llu %llu\r\n",
+				XHdcp22Loopback_MsgNames[Idx] ?
+				XHdcp22Loopback_MsgNames[Idx] : "Unknown",
+				MsgPtr->Count,
+				div_u64(MsgPtr->TotalNs, MsgPtr->Count) / 1000,
+				MsgPtr->MinNs / 1000, MsgPtr->MaxNs / 1000);
+	}
+
+	return strSize;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs one authentication and updates the statistics.
+*
+* @param  InstancePtr is a pointer to the loopback instance.
+*
+* @return
+*         - XST_SUCCESS if the authentication passed.
+*         - XST_FAILURE otherwise.
+*
+* @note   None.
+*
+******************************************************************************/
+static int XHdcp22Loopback_RunOnce(XHdcp22_Loopback *InstancePtr)
+{
+	XHdcp22_Tx *TxPtr = InstancePtr->TxPtr;
+	XHdcp22_Rx *RxPtr = InstancePtr->RxPtr;
+	XHdcp22_Loopback_Stats *StatsPtr = &InstancePtr->Stats;
+	u64 Start, Deadline, T1, T2, Elapsed;
+	int Status;
+
+	StatsPtr->Iterations++;
+
+	/* Bring both sides and the DDC model to a known state */
+	XHdcp22Loopback_ResetDdc(InstancePtr);
+
+	XHdcp22Rx_Disable(RxPtr);
+	XHdcp22Rx_SetRepeater(RxPtr, InstancePtr->Options.Repeater);
+	XHdcp22Rx_Reset(RxPtr);
+	XHdcp22Rx_Enable(RxPtr);
+
+	XHdcp22Tx_Reset(TxPtr);
+	if (!InstancePtr->Options.StoredKm)
+		XHdcp22Tx_ClearPairingInfo(TxPtr);
+	XHdcp22Tx_SetContentStreamType(TxPtr, InstancePtr->Options.StreamType);
+	XHdcp22Tx_Enable(TxPtr);
+
+	Start = ktime_get_ns();
+	Deadline = Start + (u64)InstancePtr->Options.TimeOut_mSec * NSEC_PER_MSEC;
+	InstancePtr->MsgTimeStamp = Start;
+
+	if (XHdcp22Tx_Authenticate(TxPtr) != XST_SUCCESS) {
+		StatsPtr->Failed++;
+		return XST_FAILURE;
+	}
+
+	for (;;) {
+		XHdcp22Loopback_RxPoll(InstancePtr);
+		T1 = ktime_get_ns();
+		Status = XHdcp22Tx_Poll(TxPtr);
+		T2 = ktime_get_ns();
+
+		StatsPtr->TxCpuNs += T2 - T1;
+		StatsPtr->TxPolls++;
+
+		if (Status == XHDCP22_TX_AUTHENTICATED &&
+		    XHdcp22Rx_IsAuthenticated(RxPtr))
+			break;
+
+		if (Status == XHDCP22_TX_INCOMPATIBLE_RX ||
+		    Status == XHDCP22_TX_DEVICE_IS_REVOKED ||
+		    Status == XHDCP22_TX_NO_SRM_LOADED ||
+		    T2 > Deadline) {
+			StatsPtr->Failed++;
+			return XST_FAILURE;
+		}
+
+		cond_resched();
+	}
+
+	Elapsed = T2 - Start;
+	StatsPtr->Passed++;
+	StatsPtr->TotalNs += Elapsed;
+	StatsPtr->MinNs = min(StatsPtr->MinNs, Elapsed);
+	StatsPtr->MaxNs = max(StatsPtr->MaxNs, Elapsed);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function records the latency of a message, measured from the previous
+* message, or from the start of authentication for the first message.
+*
+* @param  InstancePtr is a pointer to the loopback instance.
+* @param  MsgId is the HDCP 2.2 message ID.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Loopback_RecordMsg(XHdcp22_Loopback *InstancePtr, u8 MsgId)
+{
+	XHdcp22_Loopback_MsgStats *MsgPtr;
+	u64 Now = ktime_get_ns();
+	u64 Delta = Now - InstancePtr->MsgTimeStamp;
+
+	InstancePtr->MsgTimeStamp = Now;
+
+	if (MsgId >= XHDCP22_LOOPBACK_NUM_MSG_IDS)
+		return;
+
+	MsgPtr = &InstancePtr->Stats.Msg[MsgId];
+	MsgPtr->Count++;
+	MsgPtr->TotalNs += Delta;
+	MsgPtr->MinNs = min(MsgPtr->MinNs, Delta);
+	MsgPtr->MaxNs = max(MsgPtr->MaxNs, Delta);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function polls the receiver and accounts the time spent in it.
+*
+* @param  InstancePtr is a pointer to the loopback instance.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Loopback_RxPoll(XHdcp22_Loopback *InstancePtr)
+{
+	u64 T0 = ktime_get_ns();
+
+	XHdcp22Rx_Poll(InstancePtr->RxPtr);
+
+	InstancePtr->Stats.RxCpuNs += ktime_get_ns() - T0;
+	InstancePtr->Stats.RxPolls++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function resets the DDC register model.
+*
+* @param  InstancePtr is a pointer to the loopback instance.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Loopback_ResetDdc(XHdcp22_Loopback *InstancePtr)
+{
+	InstancePtr->TxOffset = 0;
+	InstancePtr->RxAddress = 0;
+	InstancePtr->Version = XHDCP22_LOOPBACK_VERSION_HDCP22;
+	InstancePtr->RxStatus[0] = 0;
+	InstancePtr->RxStatus[1] = 0;
+	InstancePtr->WriteSize = 0;
+	InstancePtr->WriteOffset = 0;
+	InstancePtr->ReadSize = 0;
+	InstancePtr->ReadOffset = 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the transmitter DDC write handler. The first byte sets the
+* HDCP port offset; data written to the Write_Message offset is placed in the
+* receiver write buffer and signalled to the receiver on a stop condition.
+*
+* @param  DeviceAddress is the (i2c) device address of the HDCP port.
+* @param  ByteCount is the amount of data bytes in the buffer.
+* @param  BufferPtr is a pointer to the buffer with offset and data.
+* @param  Stop is a flag to control if a stop token is set or not.
+* @param  RefPtr is a pointer to the loopback instance.
+*
+* @return XST_SUCCESS or XST_FAILURE on a wrong device address.
+*
+* @note   None.
+*
+******************************************************************************/
+static int XHdcp22Loopback_TxDdcWrite(u8 DeviceAddress, u16 ByteCount,
+                                      u8 *BufferPtr, u8 Stop, void *RefPtr)
+{
+	XHdcp22_Loopback *InstancePtr = (XHdcp22_Loopback *)RefPtr;
+	u16 Size;
+
+	if (DeviceAddress != XHDCP22_LOOPBACK_DDC_ADDRESS || ByteCount == 0)
+		return XST_FAILURE;
+
+	InstancePtr->Stats.DdcWrites++;
+	InstancePtr->TxOffset = BufferPtr[0];
+
+	if (InstancePtr->TxOffset != XHDCP22_LOOPBACK_WRITE_REG || ByteCount < 2)
+		return XST_SUCCESS;
+
+	/* On hardware the receiver runs during the DDC transfer, let it handle
+	 * the completion of the previous read before the next message lands */
+	XHdcp22Loopback_RxPoll(InstancePtr);
+
+	Size = min_t(u16, ByteCount - 1, XHDCP22_LOOPBACK_MSG_BUFFER_SIZE);
+	memcpy(InstancePtr->WriteBuffer, &BufferPtr[1], Size);
+	InstancePtr->WriteSize = Size;
+	InstancePtr->WriteOffset = 0;
+
+	XHdcp22Loopback_RecordMsg(InstancePtr, BufferPtr[1]);
+
+	if (Stop)
+		XHdcp22Rx_SetWriteMessageAvailable(InstancePtr->RxPtr);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the transmitter DDC read handler. It reads from the HDCP
+* port offset set by the previous write. When the Read_Message buffer is
+* drained the Message_Size field is cleared and the receiver is notified.
+*
+* @param  DeviceAddress is the (i2c) device address of the HDCP port.
+* @param  ByteCount is the amount of data bytes to read.
+* @param  BufferPtr is a pointer to the buffer to read into.
+* @param  Stop is a flag to control if a stop token is set or not.
+* @param  RefPtr is a pointer to the loopback instance.
+*
+* @return XST_SUCCESS or XST_FAILURE on a wrong device address.
+*
+* @note   None.
+*
+******************************************************************************/
+static int XHdcp22Loopback_TxDdcRead(u8 DeviceAddress, u16 ByteCount,
+                                     u8 *BufferPtr, u8 Stop, void *RefPtr)
+{
+	XHdcp22_Loopback *InstancePtr = (XHdcp22_Loopback *)RefPtr;
+	u16 Idx;
+
+	if (DeviceAddress != XHDCP22_LOOPBACK_DDC_ADDRESS)
+		return XST_FAILURE;
+
+	InstancePtr->Stats.DdcReads++;
+	memset(BufferPtr, 0, ByteCount);
+
+	switch (InstancePtr->TxOffset) {
+	case XHDCP22_LOOPBACK_VERSION_REG:
+		if (ByteCount > 0)
+			BufferPtr[0] = InstancePtr->Version;
+		break;
+
+	case XHDCP22_LOOPBACK_RXSTATUS0_REG:
+		InstancePtr->Stats.RxStatusReads++;
+		if (ByteCount > 0)
+			BufferPtr[0] = InstancePtr->RxStatus[0];
+		if (ByteCount > 1)
+			BufferPtr[1] = InstancePtr->RxStatus[1];
+		break;
+
+	case XHDCP22_LOOPBACK_READ_REG:
+		for (Idx = 0; Idx < ByteCount &&
+		     InstancePtr->ReadOffset < InstancePtr->ReadSize; Idx++) {
+			BufferPtr[Idx] =
+				InstancePtr->ReadBuffer[InstancePtr->ReadOffset++];
+		}
+
+		if (InstancePtr->ReadSize &&
+		    InstancePtr->ReadOffset >= InstancePtr->ReadSize) {
+			InstancePtr->ReadSize = 0;
+			InstancePtr->ReadOffset = 0;
+			InstancePtr->RxStatus[0] = 0;
+			InstancePtr->RxStatus[1] &=
+				~XHDCP22_LOOPBACK_RXSTATUS1_SIZE_MASK;
+			XHdcp22Rx_SetReadMessageComplete(InstancePtr->RxPtr);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the receiver handler that selects a DDC register.
+*
+* @param  RefPtr is a pointer to the loopback instance.
+* @param  Data is the register address.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Loopback_RxSetAddress(void *RefPtr, u32 Data)
+{
+	XHdcp22_Loopback *InstancePtr = (XHdcp22_Loopback *)RefPtr;
+
+	InstancePtr->RxAddress = (u8)Data;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the receiver handler that writes the selected DDC
+* register. Writes to Read_Message are appended to the read buffer. A write
+* of RxStatus[15:8] with a non-zero Message_Size publishes the message.
+*
+* @param  RefPtr is a pointer to the loopback instance.
+* @param  Data is the register data.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Loopback_RxSetData(void *RefPtr, u32 Data)
+{
+	XHdcp22_Loopback *InstancePtr = (XHdcp22_Loopback *)RefPtr;
+
+	switch (InstancePtr->RxAddress) {
+	case XHDCP22_LOOPBACK_VERSION_REG:
+		InstancePtr->Version = (u8)Data;
+		break;
+
+	case XHDCP22_LOOPBACK_RXSTATUS0_REG:
+		InstancePtr->RxStatus[0] = (u8)Data;
+		break;
+
+	case XHDCP22_LOOPBACK_RXSTATUS1_REG:
+		InstancePtr->RxStatus[1] = (u8)Data;
+		if ((InstancePtr->RxStatus[0] ||
+		     (InstancePtr->RxStatus[1] & XHDCP22_LOOPBACK_RXSTATUS1_SIZE_MASK)) &&
+		    InstancePtr->ReadSize > 0) {
+			XHdcp22Loopback_RecordMsg(InstancePtr,
+					InstancePtr->ReadBuffer[InstancePtr->ReadOffset]);
+		}
+		break;
+
+	case XHDCP22_LOOPBACK_READ_REG:
+		if (InstancePtr->ReadSize < XHDCP22_LOOPBACK_MSG_BUFFER_SIZE)
+			InstancePtr->ReadBuffer[InstancePtr->ReadSize++] = (u8)Data;
+		break;
+
+	default:
+		break;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the receiver handler that reads the selected DDC
+* register. Reads of Write_Message drain the write buffer.
+*
+* @param  RefPtr is a pointer to the loopback instance.
+*
+* @return The register data.
+*
+* @note   None.
+*
+******************************************************************************/
+static u32 XHdcp22Loopback_RxGetData(void *RefPtr)
+{
+	XHdcp22_Loopback *InstancePtr = (XHdcp22_Loopback *)RefPtr;
+
+	switch (InstancePtr->RxAddress) {
+	case XHDCP22_LOOPBACK_VERSION_REG:
+		return InstancePtr->Version;
+
+	case XHDCP22_LOOPBACK_RXSTATUS0_REG:
+		return InstancePtr->RxStatus[0];
+
+	case XHDCP22_LOOPBACK_RXSTATUS1_REG:
+		return InstancePtr->RxStatus[1];
+
+	case XHDCP22_LOOPBACK_WRITE_REG:
+		if (InstancePtr->WriteOffset < InstancePtr->WriteSize)
+			return InstancePtr->WriteBuffer[InstancePtr->WriteOffset++];
+		return 0;
+
+	default:
+		return 0;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the number of unread bytes in the write buffer.
+*
+* @param  RefPtr is a pointer to the loopback instance.
+*
+* @return Number of bytes.
+*
+* @note   None.
+*
+******************************************************************************/
+static u32 XHdcp22Loopback_RxGetWriteBufferSize(void *RefPtr)
+{
+	XHdcp22_Loopback *InstancePtr = (XHdcp22_Loopback *)RefPtr;
+
+	return InstancePtr->WriteSize - InstancePtr->WriteOffset;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the number of unread bytes in the read buffer.
+*
+* @param  RefPtr is a pointer to the loopback instance.
+*
+* @return Number of bytes.
+*
+* @note   None.
+*
+******************************************************************************/
+static u32 XHdcp22Loopback_RxGetReadBufferSize(void *RefPtr)
+{
+	XHdcp22_Loopback *InstancePtr = (XHdcp22_Loopback *)RefPtr;
+
+	return InstancePtr->ReadSize - InstancePtr->ReadOffset;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks if the write buffer is empty.
+*
+* @param  RefPtr is a pointer to the loopback instance.
+*
+* @return TRUE or FALSE.
+*
+* @note   None.
+*
+******************************************************************************/
+static u32 XHdcp22Loopback_RxIsWriteBufferEmpty(void *RefPtr)
+{
+	return (XHdcp22Loopback_RxGetWriteBufferSize(RefPtr) == 0);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks if the read buffer is empty.
+*
+* @param  RefPtr is a pointer to the loopback instance.
+*
+* @return TRUE or FALSE.
+*
+* @note   None.
+*
+******************************************************************************/
+static u32 XHdcp22Loopback_RxIsReadBufferEmpty(void *RefPtr)
+{
+	return (XHdcp22Loopback_RxGetReadBufferSize(RefPtr) == 0);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function clears the read buffer.
+*
+* @param  RefPtr is a pointer to the loopback instance.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Loopback_RxClearReadBuffer(void *RefPtr)
+{
+	XHdcp22_Loopback *InstancePtr = (XHdcp22_Loopback *)RefPtr;
+
+	InstancePtr->ReadSize = 0;
+	InstancePtr->ReadOffset = 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function clears the write buffer.
+*
+* @param  RefPtr is a pointer to the loopback instance.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Loopback_RxClearWriteBuffer(void *RefPtr)
+{
+	XHdcp22_Loopback *InstancePtr = (XHdcp22_Loopback *)RefPtr;
+
+	InstancePtr->WriteSize = 0;
+	InstancePtr->WriteOffset = 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is called by the receiver in repeater mode when it is ready
+* for a topology update. It publishes a synthetic downstream topology with
+* the configured number of devices and cascade depth.
+*
+* @param  RefPtr is a pointer to the loopback instance.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Loopback_RxTopologyUpdate(void *RefPtr)
+{
+	XHdcp22_Loopback *InstancePtr = (XHdcp22_Loopback *)RefPtr;
+	XHdcp22_Rx_Topology Topology;
+	u8 Idx;
+
+	memset(&Topology, 0, sizeof(XHdcp22_Rx_Topology));
+	Topology.DeviceCnt = InstancePtr->Options.DeviceCnt;
+	Topology.Depth = InstancePtr->Options.Depth ?
+			 InstancePtr->Options.Depth : 1;
+	Topology.MaxCascadeExceeded = InstancePtr->Options.MaxCascadeExceeded;
+
+	/* Unique receiver IDs, each with twenty ones and twenty zeros: four
+	 * in bytes 0 and 1 each, eight in bytes 2 and 3 (a rotated 0xFF00),
+	 * and four in byte 4 */
+	for (Idx = 0; Idx < Topology.DeviceCnt; Idx++) {
+		Topology.ReceiverIdList[Idx][0] = 0x0F;
+		Topology.ReceiverIdList[Idx][1] = 0xF0;
+		Topology.ReceiverIdList[Idx][2] = (u8)(0xFF << (Idx % 8));
+		Topology.ReceiverIdList[Idx][3] = (u8)(0xFF >> (8 - (Idx % 8)));
+		Topology.ReceiverIdList[Idx][4] =
+			XHdcp22Loopback_RcvIdTag[Idx / 8];
+	}
+
+	XHdcp22Rx_SetTopology(InstancePtr->RxPtr, &Topology);
+	XHdcp22Rx_SetTopologyUpdate(InstancePtr->RxPtr);
+}
+
+/** @} */
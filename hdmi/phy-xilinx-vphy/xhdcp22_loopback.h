@@ -0,0 +1,225 @@
+/******************************************************************************
+*
+ *
+ * Copyright (C) 2015, 2016, 2017 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xhdcp22_loopback.h
+* @{
+* @details
+*
+* This is the header file of the HDCP 2.2 loopback benchmark. The loopback
+* wires an HDCP 2.2 transmitter instance directly to an HDCP 2.2 receiver
+* instance through an in-memory model of the HDCP DDC register space
+* (Version, Write_Message, RxStatus and Read_Message), replacing the DDC
+* handlers of both instances for the duration of the benchmark.
+*
+* It runs complete AKE, LC and SKE exchanges, and optionally the repeater
+* receiver ID list and content stream management exchanges, and records the
+* latency of every message as well as the time spent inside the transmitter
+* and receiver state machines.
+*
+* <b>Software Initialization and Configuration</b>
+*
+* - Initialize the transmitter and receiver instances and load their keys
+*   (LC128, SRM, certificate and private key) as for normal operation.
+* - Call XHdcp22Loopback_Initialize to connect both instances.
+* - Call XHdcp22Loopback_Run to execute a number of authentications, or
+*   XHdcp22Loopback_SelfTest to execute the built-in test vectors.
+* - Call XHdcp22Loopback_StatsShow to format the results.
+* - Call XHdcp22Loopback_Release to restore the original handlers, then
+*   re-initialize both cores through their subsystem drivers.
+*
+* <b> Threads </b>
+*
+* The transmitter and receiver must not be polled by any other context while
+* the loopback is connected. The authentication status callbacks of both
+* instances are not called in that time.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ------ -------- --------------------------------------------------
+* 1.00  XLNX   10/18/26 Initial release.
+* 1.01  XLNX   10/18/26 Save the status callbacks, the receiver mode and the
+*                       content stream type of the connected instances.
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XHDCP22_LOOPBACK_H
+/**  prevent circular inclusions by using protection macros */
+#define XHDCP22_LOOPBACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+#include "xstatus.h"
+#include "xhdcp22_tx.h"
+#include "xhdcp22_rx.h"
+
+/************************** Constant Definitions *****************************/
+
+/** Number of HDCP 2.2 message identifiers tracked, covering IDs 0..17. */
+#define XHDCP22_LOOPBACK_NUM_MSG_IDS    18
+
+/** Default time-out for a single authentication in milliseconds. */
+#define XHDCP22_LOOPBACK_DEFAULT_TIMEOUT 5000
+
+/** Size of the DDC message buffers of the model. */
+#define XHDCP22_LOOPBACK_MSG_BUFFER_SIZE XHDCP22_RX_MAX_MESSAGE_SIZE
+
+/**************************** Type Definitions *******************************/
+
+/**
+* This typedef contains the options of a loopback run.
+*/
+typedef struct {
+	/** Number of authentications to execute. */
+	u32 Iterations;
+	/** Time-out for a single authentication in milliseconds. */
+	u32 TimeOut_mSec;
+	/** Keep pairing info between iterations to exercise AKE_Stored_km. */
+	u8 StoredKm;
+	/** Run the receiver as repeater upstream interface. */
+	u8 Repeater;
+	/** Number of downstream devices reported by the repeater (max 31). */
+	u8 DeviceCnt;
+	/** Repeater cascade depth reported by the repeater. */
+	u8 Depth;
+	/** Content stream type used by the transmitter in repeater mode. */
+	XHdcp22_Tx_ContentStreamType StreamType;
+	/** Report a topology error (MaxCascadeExceeded) in repeater mode. */
+	u8 MaxCascadeExceeded;
+} XHdcp22_Loopback_Options;
+
+/**
+* This typedef contains a test vector of the loopback: the options of a run
+* and its expected result.
+*/
+typedef struct {
+	const char *Name;                 /**< Name of the test vector. */
+	XHdcp22_Loopback_Options Options; /**< Options of the run. */
+	int ExpectedResult;               /**< XST_SUCCESS or XST_FAILURE. */
+} XHdcp22_Loopback_Vector;
+
+/**
+* This typedef contains the latency statistics of one message type.
+*/
+typedef struct {
+	u32 Count;       /**< Number of occurrences. */
+	u64 TotalNs;     /**< Accumulated latency in nanoseconds. */
+	u64 MinNs;       /**< Minimum latency in nanoseconds. */
+	u64 MaxNs;       /**< Maximum latency in nanoseconds. */
+} XHdcp22_Loopback_MsgStats;
+
+/**
+* This typedef contains the accumulated results of a loopback run.
+*/
+typedef struct {
+	u32 Iterations;       /**< Number of authentications started. */
+	u32 Passed;           /**< Number of successful authentications. */
+	u32 Failed;           /**< Number of failed or timed-out authentications. */
+	u64 TotalNs;          /**< Accumulated authentication time. */
+	u64 MinNs;            /**< Fastest authentication. */
+	u64 MaxNs;            /**< Slowest authentication. */
+	u64 TxCpuNs;          /**< Time spent in XHdcp22Tx_Poll. */
+	u64 RxCpuNs;          /**< Time spent in XHdcp22Rx_Poll. */
+	u32 TxPolls;          /**< Number of XHdcp22Tx_Poll calls. */
+	u32 RxPolls;          /**< Number of XHdcp22Rx_Poll calls. */
+	u32 DdcWrites;        /**< Number of DDC write transactions. */
+	u32 DdcReads;         /**< Number of DDC read transactions. */
+	u32 RxStatusReads;    /**< Number of RxStatus reads. */
+	u32 VectorsPassed;    /**< Number of test vectors with expected result. */
+	u32 VectorsFailed;    /**< Number of test vectors with other result. */
+	u32 FailedVectors;    /**< Bit mask of the failed test vectors. */
+	/** Per message latency, measured from the previous message. */
+	XHdcp22_Loopback_MsgStats Msg[XHDCP22_LOOPBACK_NUM_MSG_IDS];
+} XHdcp22_Loopback_Stats;
+
+/**
+* The loopback instance data, holding the DDC register model, the saved
+* DDC handlers of the connected instances and the results.
+*/
+typedef struct {
+	XHdcp22_Tx *TxPtr;            /**< Connected transmitter. */
+	XHdcp22_Rx *RxPtr;            /**< Connected receiver. */
+
+	/* Saved transmitter DDC handlers */
+	XHdcp22_Tx_DdcHandler TxDdcRead;
+	XHdcp22_Tx_DdcHandler TxDdcWrite;
+	void *TxDdcHandlerRef;
+	u8 TxIsDdcReadSet;
+	u8 TxIsDdcWriteSet;
+
+	/* Saved transmitter callbacks and settings */
+	XHdcp22_Tx_Callback TxAuthenticatedCallback;
+	void *TxAuthenticatedCallbackRef;
+	u8 TxIsAuthenticatedCallbackSet;
+	XHdcp22_Tx_Callback TxUnauthenticatedCallback;
+	void *TxUnauthenticatedCallbackRef;
+	u8 TxIsUnauthenticatedCallbackSet;
+	XHdcp22_Tx_Callback TxTopologyCallback;
+	void *TxTopologyCallbackRef;
+	u8 TxIsTopologyCallbackSet;
+	XHdcp22_Tx_ContentStreamType TxContentStreamType;
+	u8 TxIsContentStreamTypeSet;
+
+	/* Saved receiver handles and mode */
+	XHdcp22_Rx_Handles RxHandles;
+	int RxMode;
+
+	/* DDC register model */
+	u8 TxOffset;                  /**< Offset last written by the transmitter. */
+	u8 RxAddress;                 /**< Address last set by the receiver. */
+	u8 Version;                   /**< HDCP2Version register. */
+	u8 RxStatus[2];               /**< RxStatus registers. */
+	u8 WriteBuffer[XHDCP22_LOOPBACK_MSG_BUFFER_SIZE]; /**< Write_Message. */
+	u32 WriteSize;
+	u32 WriteOffset;
+	u8 ReadBuffer[XHDCP22_LOOPBACK_MSG_BUFFER_SIZE];  /**< Read_Message. */
+	u32 ReadSize;
+	u32 ReadOffset;
+
+	/* Timing */
+	u64 MsgTimeStamp;             /**< Time of the previous message. */
+	XHdcp22_Loopback_Options Options;
+	XHdcp22_Loopback_Stats Stats;
+	u8 IsConnected;
+} XHdcp22_Loopback;
+
+/************************** Function Prototypes ******************************/
+
+int XHdcp22Loopback_Initialize(XHdcp22_Loopback *InstancePtr,
+                               XHdcp22_Tx *TxPtr, XHdcp22_Rx *RxPtr);
+void XHdcp22Loopback_Release(XHdcp22_Loopback *InstancePtr);
+int XHdcp22Loopback_Run(XHdcp22_Loopback *InstancePtr,
+                        const XHdcp22_Loopback_Options *OptionsPtr);
+int XHdcp22Loopback_SelfTest(XHdcp22_Loopback *InstancePtr, u32 Iterations);
+void XHdcp22Loopback_StatsReset(XHdcp22_Loopback *InstancePtr);
+int XHdcp22Loopback_StatsShow(XHdcp22_Loopback *InstancePtr, char *buff,
+                              int buff_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* End of protection macro */
+
+/** @} */
@@ -32,6 +32,8 @@
 * 1.01  MH     08/04/16 Added 64 bit address support.
 * 1.02  MH     02/17/16 Fixed pointer alignment problem in function
 *                       XHdcp22Rng_GetRandom
+* 1.10  XLNX   10/18/26 Added random pool, XHdcp22Rng_GetRandom serves the
+*                       pool first. Added function XHdcp22Rng_FillPool.
 * </pre>
 *
 ******************************************************************************/
@@ -40,6 +42,7 @@
 /***************************** Include Files *********************************/
 #include "xhdcp22_rng.h"
 #include <linux/string.h>
+#include <linux/random.h>
 
 /************************** Constant Definitions *****************************/
 
@@ -108,36 +111,29 @@ int XHdcp22Rng_CfgInitialize(XHdcp22_Rng *InstancePtr,
 /*****************************************************************************/
 /**
 *
-* This function returns a random number.
+* This function reads random words from the RNG core.
 *
 * @param  InstancePtr is a pointer to the XHdcp22_Rng core instance.
 * @param  BufferPtr points to the buffer that will contain a random number.
-* @param  BufferLength is the length of the BufferPtr in bytes.
-*         The length must be greater than or equal to RandomLength.
-* @param  RandomLength is the requested length of the random number in bytes.
-*         The length must be a multiple of 4
+* @param  RandomLength is the requested length in bytes, a multiple of 4.
 *
 * @return None.
 *
 * @note   None.
 *
 ******************************************************************************/
-void XHdcp22Rng_GetRandom(XHdcp22_Rng *InstancePtr, u8 *BufferPtr, u16 BufferLength, u16 RandomLength)
+static void XHdcp22Rng_ReadRandom(XHdcp22_Rng *InstancePtr, u8 *BufferPtr, u16 RandomLength)
 {
 	u32 i, j;
 	u32 Offset = 0;
 	u32 RandomWord;
 	u8 *RandomPtr = (u8 *)&RandomWord;
 
-	Xil_AssertVoid(InstancePtr != NULL);
-	Xil_AssertVoid(BufferPtr != NULL);
-	Xil_AssertVoid(RandomLength%4 == 0);
-	Xil_AssertVoid(BufferLength >= RandomLength);
-
 	for (i=0; i<RandomLength; i+=4)
 	{
 		RandomWord = XHdcp22Rng_ReadReg(InstancePtr->Config.BaseAddress,
 					XHDCP22_RNG_REG_RN_1_OFFSET + Offset);
+
 		for (j=0; j<4; j++) {
 			BufferPtr[i + j] = RandomPtr[j];
 		}
@@ -148,4 +144,83 @@ void XHdcp22Rng_GetRandom(XHdcp22_Rng *InstancePtr, u8 *BufferPtr, u16 BufferLen
 	}
 }
 
+/*****************************************************************************/
+/**
+*
+* This function returns a random number. The random number is taken from
+* the pool when it holds enough bytes, otherwise it is read from the core.
+*
+* @param  InstancePtr is a pointer to the XHdcp22_Rng core instance.
+* @param  BufferPtr points to the buffer that will contain a random number.
+* @param  BufferLength is the length of the BufferPtr in bytes.
+*         The length must be greater than or equal to RandomLength.
+* @param  RandomLength is the requested length of the random number in bytes.
+*         The length must be a multiple of 4
+*
+* @return None.
+*
+* @note   Bytes taken from the pool are cleared and never handed out twice.
+*
+******************************************************************************/
+void XHdcp22Rng_GetRandom(XHdcp22_Rng *InstancePtr, u8 *BufferPtr, u16 BufferLength, u16 RandomLength)
+{
+	u8 *PoolPtr;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(BufferPtr != NULL);
+	Xil_AssertVoid(RandomLength%4 == 0);
+	Xil_AssertVoid(BufferLength >= RandomLength);
+
+	if (RandomLength <= InstancePtr->PoolLevel) {
+		InstancePtr->PoolLevel -= RandomLength;
+		PoolPtr = &InstancePtr->Pool[InstancePtr->PoolLevel];
+		memcpy(BufferPtr, PoolPtr, RandomLength);
+		memzero_explicit(PoolPtr, RandomLength);
+		return;
+	}
+
+	XHdcp22Rng_ReadRandom(InstancePtr, BufferPtr, RandomLength);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function refills the random pool from the RNG core. The random
+* words are mixed with the kernel entropy pool.
+*
+* @param  InstancePtr is a pointer to the XHdcp22_Rng core instance.
+*
+* @return None.
+*
+* @note   This function is intended to be called outside the authentication
+*         critical path, so the random numbers needed during authentication
+*         are served from the pool. The core must be enabled.
+*
+******************************************************************************/
+void XHdcp22Rng_FillPool(XHdcp22_Rng *InstancePtr)
+{
+	u8 Mix[XHDCP22_RNG_POOL_SIZE];
+	u8 *PoolPtr;
+	u16 Length;
+	u16 i;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	Length = (XHDCP22_RNG_POOL_SIZE - InstancePtr->PoolLevel) & ~3;
+	if (Length == 0) {
+		return;
+	}
+
+	PoolPtr = &InstancePtr->Pool[InstancePtr->PoolLevel];
+	XHdcp22Rng_ReadRandom(InstancePtr, PoolPtr, Length);
+
+	get_random_bytes(Mix, Length);
+	for (i=0; i<Length; i++) {
+		PoolPtr[i] ^= Mix[i];
+	}
+	memzero_explicit(Mix, Length);
+
+	InstancePtr->PoolLevel += Length;
+}
+
 /** @} */
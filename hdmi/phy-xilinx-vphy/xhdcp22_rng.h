@@ -44,6 +44,7 @@
 * ----- ------ -------- --------------------------------------------------
 * 1.00  JO     10/01/15 Initial release.
 * 1.01  MH     08/04/16 Added 64 bit address support.
+* 1.10  XLNX   10/18/26 Added random pool and function XHdcp22Rng_FillPool.
 * </pre>
 *
 ******************************************************************************/
@@ -63,6 +64,12 @@ extern "C" {
 
 /************************** Constant Definitions *****************************/
 
+/**
+* Size of the random pool in bytes, enough for the nonces and keys of
+* one HDCP 2.2 transmitter authentication.
+*/
+#define XHDCP22_RNG_POOL_SIZE	128
+
 /**************************** Type Definitions *******************************/
 /**
 * This typedef contains configuration information for the HDCP22 Rng core.
@@ -80,6 +87,8 @@ typedef struct {
 typedef struct {
 	XHdcp22_Rng_Config Config; /**< Hardware Configuration */
 	u32 IsReady;               /**< Core and the driver instance are initialized */
+	u8 Pool[XHDCP22_RNG_POOL_SIZE]; /**< Random bytes read ahead */
+	u16 PoolLevel;             /**< Number of unused bytes in the pool */
 } XHdcp22_Rng;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -146,6 +155,9 @@ int XHdcp22Rng_CfgInitialize(XHdcp22_Rng *InstancePtr, XHdcp22_Rng_Config *CfgPt
 /* Return a random number */
 void XHdcp22Rng_GetRandom(XHdcp22_Rng *InstancePtr, u8 *BufferPtr, u16 BufferLength, u16 RandomLength);
 
+/* Refill the random pool */
+void XHdcp22Rng_FillPool(XHdcp22_Rng *InstancePtr);
+
 /************************** Variable Declarations ****************************/
 
 #ifdef __cplusplus
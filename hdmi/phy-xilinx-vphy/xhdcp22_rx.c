@@ -40,6 +40,7 @@
 * 2.00  MH   04/14/16 Updated for repeater upstream support.
 * 2.01  MH   02/28/17 Fixed compiler warnings.
 * 2.20  MH   06/08/17 Updated for 64 bit support.
+* 2.50  XLNX 10/18/26 Refill the random pool outside of authentication.
 *</pre>
 *
 *****************************************************************************/
@@ -402,6 +403,7 @@ int XHdcp22Rx_Enable(XHdcp22_Rx *InstancePtr)
 	/* Enable RNG and Cipher */
 	XHdcp22Rng_Enable(&InstancePtr->RngInst);
 	XHdcp22Cipher_Enable(&InstancePtr->CipherInst);
+	XHdcp22Rng_FillPool(&InstancePtr->RngInst);
 
 	/* Assert enabled flag */
 	InstancePtr->Info.IsEnabled = TRUE;
@@ -684,6 +686,13 @@ int XHdcp22Rx_Poll(XHdcp22_Rx *InstancePtr)
 	    XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_INFO_STATE, InstancePtr->Info.NextState);
 	}
 
+	/* Refill the random pool outside of authentication */
+	if(InstancePtr->Info.IsEnabled == TRUE &&
+	   InstancePtr->Info.AuthenticationStatus != XHDCP22_RX_AUTHENTICATION_BUSY)
+	{
+		XHdcp22Rng_FillPool(&InstancePtr->RngInst);
+	}
+
 	return (int)(InstancePtr->Info.AuthenticationStatus);
 }
 
@@ -85,6 +85,7 @@
 *                     to array. Added function XHDCP22Rx_GetVersion.
 * 2.00  MH   04/14/16 Updated for repeater upstream support.
 * 2.01  MH   02/28/17 Fixed compiler warnings.
+* 2.02  XLNX 10/18/26 Added MpWorkspace for the RSA operations.
 *</pre>
 *
 *****************************************************************************/
@@ -111,6 +112,7 @@ extern "C" {
 #define XHDCP22_RX_LOG_BUFFER_SIZE            256  /**< The size of the log buffer */
 #define XHDCP22_RX_ENCRYPTION_STATUS_INTERVAL 1000 /**< 1sec encryption status check interval */
 #define XHDCP22_RX_REPEATERAUTH_ACK_INTERVAL  2000 /**< 2sec RepeaterAuth Ack interval */
+#define XHDCP22_RX_MP_WORKSPACE_SIZE          192  /**< RSA workspace in 32-bit words, 6 times the 1024-bit modulus */
 
 /************************** Variable Declaration ****************************/
 
@@ -599,6 +601,8 @@ typedef struct
 	int MessageSize;
 	/** Repeater topology instance */
 	XHdcp22_Rx_Topology Topology;
+	/** Workspace for the RSA modular exponentiation */
+	u32 MpWorkspace[XHDCP22_RX_MP_WORKSPACE_SIZE];
 #ifdef _XHDCP22_RX_TEST_
 	/** Test instance */
 	XHdcp22_Rx_Test Test;
@@ -31,6 +31,10 @@
 * 1.00  MH   10/30/15 First Release
 * 2.00  MH   04/14/16 Updated for repeater upstream support.
 * 2.20  MH   06/21/17 Updated for 64 bit support.
+* 2.30  XLNX 10/18/26 Build the MMULT initialization only with the hardware
+*                     multiplier, fixed pointer signedness warnings.
+* 2.31  XLNX 10/18/26 RSAEP uses the MpWorkspace of the instance instead of
+*                     allocating one per call.
 *</pre>
 *
 *****************************************************************************/
@@ -56,7 +60,7 @@
 
 /************************** Function Prototypes *****************************/
 /* Functions for implementing PCKS1 */
-static int  XHdcp22Rx_Pkcs1Rsaep(const XHdcp22_Rx_KpubRx *KpubRx, u8 *Message,
+static int  XHdcp22Rx_Pkcs1Rsaep(XHdcp22_Rx *InstancePtr, const XHdcp22_Rx_KpubRx *KpubRx, u8 *Message,
 	            u8 *EncryptedMessage);
 static int  XHdcp22Rx_Pkcs1Rsadp(XHdcp22_Rx *InstancePtr, const XHdcp22_Rx_KprivRx *KprivRx,
 	            u8 *EncryptedMessage, u8 *Message);
@@ -64,9 +68,9 @@ static int  XHdcp22Rx_Pkcs1Mgf1(const u8 *seed, const u32 seedlen, u8  *mask, u3
 static int  XHdcp22Rx_Pkcs1EmeOaepEncode(const u8 *Message, const u32 MessageLen,
 	            const u8 *MaskingSeed, u8 *EncodedMessage);
 static int  XHdcp22Rx_Pkcs1EmeOaepDecode(u8 *EncodedMessage, u8 *Message, int *MessageLen);
+#ifndef _XHDCP22_RX_SW_MMULT_
 static void XHdcp22Rx_Pkcs1MontMultFiosInit(XHdcp22_Rx *InstancePtr, u32 *N,
 	            const u32 *NPrime, int NDigits);
-#ifndef _XHDCP22_RX_SW_MMULT_
 static void XHdcp22Rx_Pkcs1MontMultFios(XHdcp22_Rx *InstancePtr, u32 *U, u32 *A,
 	            u32 *B, int NDigits);
 #else
@@ -175,6 +179,7 @@ int XHdcp22Rx_CalcMontNPrime(u8 *NPrime, const u8 *N, int NDigits)
 *
 * Reference: PKCS#1 v2.1, Section 7.1.1
 *
+* @param	InstancePtr is a pointer to the XHdcp22_Rx core instance.
 * @param	KpubRx is the RSA public key structure containing the 1024 bit
 * 			modulus and 24 bit public exponent.
 * @param	Message is the octet string to be encrypted.
@@ -187,10 +192,11 @@ int XHdcp22Rx_CalcMontNPrime(u8 *NPrime, const u8 *N, int NDigits)
 *
 * @note		None.
 *****************************************************************************/
-int XHdcp22Rx_RsaesOaepEncrypt(const XHdcp22_Rx_KpubRx *KpubRx, const u8 *Message,
-	const u32 MessageLen, const u8 *MaskingSeed, u8 *EncryptedMessage)
+int XHdcp22Rx_RsaesOaepEncrypt(XHdcp22_Rx *InstancePtr, const XHdcp22_Rx_KpubRx *KpubRx,
+	const u8 *Message, const u32 MessageLen, const u8 *MaskingSeed, u8 *EncryptedMessage)
 {
 	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(KpubRx != NULL);
 	Xil_AssertNonvoid(Message != NULL);
 	Xil_AssertNonvoid(MessageLen > 0);
@@ -213,7 +219,7 @@ int XHdcp22Rx_RsaesOaepEncrypt(const XHdcp22_Rx_KpubRx *KpubRx, const u8 *Messag
 	}
 
 	/* Step 3: RSA encryption */
-	Status = XHdcp22Rx_Pkcs1Rsaep(KpubRx, em, EncryptedMessage);
+	Status = XHdcp22Rx_Pkcs1Rsaep(InstancePtr, KpubRx, em, EncryptedMessage);
 	if(Status != XST_SUCCESS) {
 		return XST_FAILURE;
 	}
@@ -297,18 +303,21 @@ void XHdcp22Rx_GenerateRandom(XHdcp22_Rx *InstancePtr, int NumOctets,
 *
 * Reference: PKCS#1 v2.1, Section 5.1.1
 *
+* @param	InstancePtr is a pointer to the XHdcp22_Rx core instance.
 * @param	KpubRx is the RSA public key structure containing the 1024 bit
 * 			modulus and 24 bit public exponent.
 * @param	Message is the 128 byte octet string to be encrypted.
 * @param	EncryptedMessage is the 128 byte octet string after encryption.
 *
-* @return	XST_SUCCESS or XST_FAILURE.
+* @return	XST_SUCCESS.
 *
-* @note		None.
+* @note		Uses the MpWorkspace of the instance, nothing is allocated.
 *****************************************************************************/
-static int XHdcp22Rx_Pkcs1Rsaep(const XHdcp22_Rx_KpubRx *KpubRx, u8 *Message, u8 *EncryptedMessage)
+static int XHdcp22Rx_Pkcs1Rsaep(XHdcp22_Rx *InstancePtr, const XHdcp22_Rx_KpubRx *KpubRx,
+	u8 *Message, u8 *EncryptedMessage)
 {
 	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(KpubRx != NULL);
 	Xil_AssertNonvoid(Message != NULL);
 	Xil_AssertNonvoid(EncryptedMessage != NULL);
@@ -323,8 +332,8 @@ static int XHdcp22Rx_Pkcs1Rsaep(const XHdcp22_Rx_KpubRx *KpubRx, u8 *Message, u8
 	mpConvFromOctets(E, XHDCP22_RX_N_SIZE/4, KpubRx->e, 3);
 	mpConvFromOctets(M, XHDCP22_RX_N_SIZE/4, Message, XHDCP22_RX_N_SIZE);
 
-	/* Generate cipher text, c = m^e*mod(n) */
-	mpModExp(C, M, E, N, XHDCP22_RX_N_SIZE/4);
+	/* Generate cipher text, c = m^e*mod(n), in the instance workspace */
+	mpModExpMont(C, M, E, N, XHDCP22_RX_N_SIZE/4, InstancePtr->MpWorkspace);
 
 	/* Convert integer to octet string */
 	mpConvToOctets(C, XHDCP22_RX_N_SIZE/4, EncryptedMessage, XHDCP22_RX_N_SIZE);
@@ -799,6 +808,7 @@ static void XHdcp22Rx_Pkcs1MontMultFiosStub(u32 *U, u32 *A, u32 *B,
 }
 #endif
 
+#ifndef _XHDCP22_RX_SW_MMULT_
 /****************************************************************************/
 /**
 * This function initializes the Montgomery Multiplier (MMULT) hardware
@@ -833,13 +843,12 @@ static void XHdcp22Rx_Pkcs1MontMultFiosInit(XHdcp22_Rx *InstancePtr, u32 *N,
 	while(XHdcp22_mmult_IsReady(&InstancePtr->MmultInst) == 0);
 
 	/* Write Register N */
-	XHdcp22_mmult_Write_N_Words(&InstancePtr->MmultInst, 0, (int *)N, NDigits);
+	XHdcp22_mmult_Write_N_Words(&InstancePtr->MmultInst, 0, N, NDigits);
 
 	/* Write Register NPrime */
-	XHdcp22_mmult_Write_NPrime_Words(&InstancePtr->MmultInst, 0, (int *)NPrime, NDigits);
+	XHdcp22_mmult_Write_NPrime_Words(&InstancePtr->MmultInst, 0, (u32 *)NPrime, NDigits);
 }
 
-#ifndef _XHDCP22_RX_SW_MMULT_
 /****************************************************************************/
 /**
 * This function runs the Montgomery Multiplier (MMULT) hardware to perform
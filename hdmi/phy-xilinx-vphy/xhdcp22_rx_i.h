@@ -31,6 +31,8 @@
 * 1.01  MH   03/02/16 Moved prototype of XHdcp22Rx_CalcMontNPrime to
 *                     to internal functions.
 * 1.02  MH   04/14/16 Updated for repeater upstream support.
+* 1.03  XLNX 10/18/26 XHdcp22Rx_RsaesOaepEncrypt takes the instance for its
+*                     workspace.
 *</pre>
 *
 *****************************************************************************/
@@ -429,8 +431,9 @@ typedef union
 /* Crypto Functions */
 int  XHdcp22Rx_CalcMontNPrime(u8 *NPrime, const u8 *N, int NDigits);
 void XHdcp22Rx_GenerateRandom(XHdcp22_Rx *InstancePtr, int NumOctets, u8* RandomNumberPtr);
-int  XHdcp22Rx_RsaesOaepEncrypt(const XHdcp22_Rx_KpubRx *KpubRx, const u8 *Message,
-			const u32 MessageLen, const u8 *MaskingSeed, u8 *EncryptedMessage);
+int  XHdcp22Rx_RsaesOaepEncrypt(XHdcp22_Rx *InstancePtr, const XHdcp22_Rx_KpubRx *KpubRx,
+			const u8 *Message, const u32 MessageLen, const u8 *MaskingSeed,
+			u8 *EncryptedMessage);
 int  XHdcp22Rx_RsaesOaepDecrypt(XHdcp22_Rx *InstancePtr, const XHdcp22_Rx_KprivRx *KprivRx,
 			 u8 *EncryptedMessage, u8 *Message, int *MessageLen);
 void XHdcp22Rx_ComputeHPrime(const u8* Rrx, const u8 *RxCaps, const u8* Rtx,
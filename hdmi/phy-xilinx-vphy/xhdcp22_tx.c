@@ -61,6 +61,16 @@
 *                          RxStatus register.
 * 2.31  YB     03/28/19 Moved the reading of the DDC status from
 *                          XHdcp22Tx_TimerHandler to XHdcp22Tx_Poll.
+* 2.50  XLNX   10/18/26 Skip the signature verification of receiver
+*                       certificates verified before.
+*                       Refill the random pool outside of authentication.
+*                       Poll RxStatus on an adaptive schedule learned per
+*                       receiver and message.
+* 2.60  XLNX   10/18/26 Change the content stream type of an authenticated
+*                       repeater with RepeaterAuth_Stream_Manage, without
+*                       re-authentication.
+* 2.70  XLNX   10/18/26 Start the timer in test builds unless the unit test
+*                       mode is selected, return the log size of a unit test.
 * </pre>
 *
 ******************************************************************************/
@@ -68,6 +78,7 @@
 /***************************** Include Files *********************************/
 #include "xhdcp22_tx.h"
 #include "xhdcp22_tx_i.h"
+#include "xhdcp22_common.h"
 #include "xil_printf.h"
 
 /************************** Constant Definitions *****************************/
@@ -75,6 +86,9 @@
 /** RxStatus value used to force re-authentication */
 #define XHDCP22_TX_INVALID_RXSTATUS 0xFFFF
 
+/** Interval after the first RxStatus read of the adaptive polling schedule */
+#define XHDCP22_TX_POLL_MIN_INTERVAL_US 1000
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /** Case replacement to copy a case Id to a string with a pre-lead */
@@ -153,6 +167,7 @@ static void XHdcp22Tx_A3A4(XHdcp22_Tx *InstancePtr);
 static void XHdcp22Tx_A4A5(XHdcp22_Tx *InstancePtr);
 static void XHdcp22Tx_A6A7A0(XHdcp22_Tx *InstancePtr);
 static void XHdcp22Tx_A9A0(XHdcp22_Tx *InstancePtr);
+static void XHdcp22Tx_A5A9(XHdcp22_Tx *InstancePtr);
 
 /* Protocol specific functions */
 static int XHdcp22Tx_WriteAKEInit(XHdcp22_Tx *InstancePtr);
@@ -185,6 +200,9 @@ static void XHdcp22Tx_InvalidatePairingInfo(XHdcp22_Tx *InstancePtr,
                                              const u8* ReceiverId);
 static XHdcp22_Tx_PairingInfo *XHdcp22Tx_UpdatePairingInfo(XHdcp22_Tx *InstancePtr,
                               const XHdcp22_Tx_PairingInfo *PairingInfo, u8 Ready);
+static u8 XHdcp22Tx_IsCertVerified(XHdcp22_Tx *InstancePtr, const u8 *HashPtr);
+static void XHdcp22Tx_AddVerifiedCert(XHdcp22_Tx *InstancePtr,
+                                      const u8 *HashPtr);
 
 /* Timer functions */
 static void XHdcp22Tx_TimerHandler(void *CallbackRef, u8 TmrCntNumber);
@@ -193,6 +211,18 @@ static int XHdcp22Tx_StartTimer(XHdcp22_Tx *InstancePtr, u32 TimeOut_mSec,
 static int XHdcp22Tx_WaitForReceiver(XHdcp22_Tx *InstancePtr, int ExpectedSize, u8 ReadyBit);
 static u32 XHdcp22Tx_GetTimerCount(XHdcp22_Tx *InstancePtr);
 
+/* Adaptive RxStatus polling */
+static void XHdcp22Tx_PollStart(XHdcp22_Tx *InstancePtr, u32 TimeOut_mSec,
+                                u8 ReasonId);
+static int XHdcp22Tx_PollWait(XHdcp22_Tx *InstancePtr, int ExpectedSize,
+                              u8 ReadyBit);
+static void XHdcp22Tx_PollDone(XHdcp22_Tx *InstancePtr, u32 ElapsedUs,
+                               u8 Received);
+static void XHdcp22Tx_PollLearn(XHdcp22_Tx *InstancePtr, u8 MsgIdx,
+                                u32 ResponseUs);
+static void XHdcp22Tx_PollSelectProfile(XHdcp22_Tx *InstancePtr,
+                                        const u8 *ReceiverIdPtr);
+
 /* RxStatus handling */
 static void XHdcp22Tx_ReadRxStatus(XHdcp22_Tx *InstancePtr);
 
@@ -349,6 +379,7 @@ int XHdcp22Tx_CfgInitialize(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_Config *CfgPtr,
 	transition_table[XHDCP22_TX_STATE_A3][XHDCP22_TX_STATE_A4] = XHdcp22Tx_A3A4;
 	transition_table[XHDCP22_TX_STATE_A6_A7_A8][XHDCP22_TX_STATE_A0] = XHdcp22Tx_A6A7A0;
 	transition_table[XHDCP22_TX_STATE_A9][XHDCP22_TX_STATE_A0] = XHdcp22Tx_A9A0;
+	transition_table[XHDCP22_TX_STATE_A5][XHDCP22_TX_STATE_A9] = XHdcp22Tx_A5A9;
 
 	InstancePtr->Info.AuthenticationStatus = XHDCP22_TX_UNAUTHENTICATED;
 	InstancePtr->Info.CurrentState = XHDCP22_TX_STATE_H0;
@@ -365,6 +396,12 @@ int XHdcp22Tx_CfgInitialize(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_Config *CfgPtr,
 	InstancePtr->Timer.TimerExpired = (TRUE);
 	InstancePtr->Timer.ReasonId = XHDCP22_TX_TS_UNDEFINED;
 	InstancePtr->Timer.InitialTicks = 0;
+	InstancePtr->Timer.StartTicks = 0;
+
+	/* Adaptive RxStatus polling, no receiver known yet */
+	InstancePtr->PollSchedule.IsEnabled = (TRUE);
+	InstancePtr->PollSchedule.MsgIdx = XHDCP22_TX_POLL_NUM_MSGS;
+	InstancePtr->PollSchedule.ProfileIdx = XHDCP22_TX_POLL_MAX_RECEIVERS;
 
 	/* Receiver ID list */
 	InstancePtr->Info.ReceivedFirstSeqNum_V = (FALSE);
@@ -376,10 +413,15 @@ int XHdcp22Tx_CfgInitialize(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_Config *CfgPtr,
 	/* Content Stream Management */
 	InstancePtr->Info.ContentStreamType = XHDCP22_STREAMTYPE_0; // Default
 	InstancePtr->Info.IsContentStreamTypeSet = (TRUE);
+	InstancePtr->Info.SentContentStreamType = XHDCP22_STREAMTYPE_0;
+	InstancePtr->Info.IsContentStreamTypeChangePending = (FALSE);
 
 	/* Clear pairing info */
 	XHdcp22Tx_ClearPairingInfo(InstancePtr);
 
+	/* Clear verified certificates */
+	XHdcp22Tx_ClearVerifiedCerts(InstancePtr);
+
 	/* Initialize hardware timer */
 	Result = XHdcp22Tx_InitializeTimer(InstancePtr);
 	if (Result != XST_SUCCESS) {
@@ -533,6 +575,7 @@ static int XHdcp22Tx_InitializeRng(XHdcp22_Tx *InstancePtr)
 		return Result;
 	}
 	XHdcp22Rng_Enable(&InstancePtr->Rng);
+	XHdcp22Rng_FillPool(&InstancePtr->Rng);
 	return Result;
 }
 
@@ -595,6 +638,9 @@ int XHdcp22Tx_LoadRevocationTable(XHdcp22_Tx *InstancePtr, const u8 *SrmPtr)
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(SrmPtr != NULL);
 
+	/* Certificates have to be verified again against the new SRM */
+	XHdcp22Tx_ClearVerifiedCerts(InstancePtr);
+
 	SrmBlockPtr = SrmPtr;
 
 	/* byte 1 contains the SRM ID and HDCP2 Indicator field */
@@ -626,7 +672,7 @@ int XHdcp22Tx_LoadRevocationTable(XHdcp22_Tx *InstancePtr, const u8 *SrmPtr)
 	KPubDpcPtr = XHdcp22Tx_GetKPubDpc(InstancePtr);
 
 	/* Verify the first-generation SRM block */
-	Result = XHdcp22Tx_VerifySRM(SrmBlockPtr,
+	Result = XHdcp22Tx_VerifySRM(InstancePtr, SrmBlockPtr,
 	                             BlockSize,
 	                             KPubDpcPtr, // N
 	                             XHDCP22_TX_KPUB_DCP_LLC_N_SIZE,
@@ -649,7 +695,7 @@ int XHdcp22Tx_LoadRevocationTable(XHdcp22_Tx *InstancePtr, const u8 *SrmPtr)
 		BlockSize = LengthField;
 
 		/* Verify the next-generation SRM block */
-		Result = XHdcp22Tx_VerifySRM(SrmBlockPtr,
+		Result = XHdcp22Tx_VerifySRM(InstancePtr, SrmBlockPtr,
 		                             BlockSize,
 		                             KPubDpcPtr, // N
 		                             XHDCP22_TX_KPUB_DCP_LLC_N_SIZE,
@@ -890,6 +936,88 @@ void XHdcp22Tx_SetContentStreamType(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_ContentS
 	InstancePtr->Info.IsContentStreamTypeSet = (TRUE);
 }
 
+/*****************************************************************************/
+/**
+*
+* This function changes the Content Stream Type on an authenticated link,
+* without re-authentication. An authenticated repeater is sent a
+* RepeaterAuth_Stream_Manage message with the next seq_num_M, the link stays
+* authenticated and encrypted meanwhile. A receiver is not told the type,
+* the change takes effect immediately. Without authentication the type is
+* used by the next authentication.
+*
+* @param  InstancePtr is a pointer to the XHdcp22_Tx instance.
+* @param  StreamType specifies the content stream type.
+*
+* @return
+*   - XST_SUCCESS if the type is changed or the change is started.
+*   - XST_FAILURE if the type is Type 1 and the downstream topology holds
+*     HDCP 1.x devices or HDCP 2.0 repeaters.
+*
+* @note   Type 1 content must not be transmitted before
+*         XHdcp22Tx_IsContentStreamTypeChangePending returns FALSE. If the
+*         repeater does not confirm the type, the state machine falls back
+*         to re-authentication.
+*
+******************************************************************************/
+int XHdcp22Tx_ChangeContentStreamType(XHdcp22_Tx *InstancePtr,
+                                      XHdcp22_Tx_ContentStreamType StreamType)
+{
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(StreamType <= XHDCP22_STREAMTYPE_1);
+
+	if (StreamType == XHDCP22_STREAMTYPE_1 &&
+	    InstancePtr->Info.IsTopologyAvailable &&
+	    (InstancePtr->Topology.Hdcp1DeviceDownstream ||
+	     InstancePtr->Topology.Hdcp2LegacyDeviceDownstream)) {
+		return XST_FAILURE;
+	}
+
+	InstancePtr->Info.ContentStreamType = StreamType;
+	InstancePtr->Info.IsContentStreamTypeSet = (TRUE);
+
+	if (InstancePtr->Info.IsReceiverRepeater == (FALSE) ||
+	    InstancePtr->Info.AuthenticationStatus != XHDCP22_TX_AUTHENTICATED) {
+		return XST_SUCCESS;
+	}
+
+	/* State A5 sends the new type to the repeater. Changing back to the
+	 * type in effect before it was sent cancels the change. */
+	if (InstancePtr->Info.IsContentStreamTypeSent == (TRUE) &&
+	    InstancePtr->Info.SentContentStreamType == StreamType &&
+	    InstancePtr->Timer.ReasonId != XHDCP22_TX_TS_WAIT_FOR_CIPHER) {
+		InstancePtr->Info.IsContentStreamTypeChangePending = (FALSE);
+	}
+	else {
+		InstancePtr->Info.IsContentStreamTypeChangePending = (TRUE);
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns whether a Content Stream Type change started with
+* XHdcp22Tx_ChangeContentStreamType still waits for the repeater.
+*
+* @param  InstancePtr is a pointer to the XHdcp22_Tx instance.
+*
+* @return TRUE if the change is in progress, FALSE if the type is in effect
+*         or the link is no longer authenticated.
+*
+******************************************************************************/
+u8 XHdcp22Tx_IsContentStreamTypeChangePending(XHdcp22_Tx *InstancePtr)
+{
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return (InstancePtr->Info.IsContentStreamTypeChangePending &&
+	        InstancePtr->Info.AuthenticationStatus ==
+	        XHDCP22_TX_AUTHENTICATED) ? (TRUE) : (FALSE);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -977,6 +1105,7 @@ int XHdcp22Tx_Authenticate(XHdcp22_Tx *InstancePtr)
 
 	/* Clear Topology Available flag */
 	InstancePtr->Info.IsTopologyAvailable = (FALSE);
+	InstancePtr->Info.IsContentStreamTypeChangePending = (FALSE);
 
 	/* If in repeater mode, clear the content stream type is set flag */
 	if (XHdcp22Tx_IsRepeater(InstancePtr)) {
@@ -1039,6 +1168,11 @@ int XHdcp22Tx_Poll(XHdcp22_Tx *InstancePtr)
 		                (u8)InstancePtr->Info.AuthenticationStatus);
 	}
 
+	/* Refill the random pool outside of authentication */
+	if (InstancePtr->Info.AuthenticationStatus != XHDCP22_TX_AUTHENTICATION_BUSY) {
+		XHdcp22Rng_FillPool(&InstancePtr->Rng);
+	}
+
 	return (int)(InstancePtr->Info.AuthenticationStatus);
 }
 
@@ -1075,6 +1209,7 @@ int XHdcp22Tx_Reset(XHdcp22_Tx *InstancePtr)
 
 	/* Stop the timer if it's still running */
 	XTmrCtr_Stop(&InstancePtr->Timer.TmrCtr, XHDCP22_TX_TIMER_CNTR_0);
+	InstancePtr->PollSchedule.MsgIdx = XHDCP22_TX_POLL_NUM_MSGS;
 
 	/* Clear Topology Available flag */
 	InstancePtr->Info.IsTopologyAvailable = (FALSE);
@@ -1685,6 +1820,7 @@ XHdcp22_Tx_StateType Xhdcp22Tx_StateA1_1(XHdcp22_Tx *InstancePtr)
 	XHdcp22_Tx_PairingInfo *PairingInfoPtr = NULL;
 	const u8* KPubDpcPtr = NULL;
 	XHdcp22_Tx_PairingInfo NewPairingInfo;
+	u8 CertHash[XHDCP22_TX_SHA256_HASH_SIZE];
 
 	/* receive AKE Send message, wait for 100 ms */
 	Result = XHdcp22Tx_WaitForReceiver(InstancePtr, sizeof(XHdcp22_Tx_AKESendCert), FALSE);
@@ -1706,24 +1842,39 @@ XHdcp22_Tx_StateType Xhdcp22Tx_StateA1_1(XHdcp22_Tx *InstancePtr)
 		return XHDCP22_TX_STATE_A0;
 	}
 
-	/* Verify the signature */
-	KPubDpcPtr = XHdcp22Tx_GetKPubDpc(InstancePtr);
-	XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
-	                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE);
-	Result = XHdcp22Tx_VerifyCertificate(&MsgPtr->Message.AKESendCert.CertRx,
-	                   KPubDpcPtr, /* N */
-	                   XHDCP22_TX_KPUB_DCP_LLC_N_SIZE,
-	                   &KPubDpcPtr[XHDCP22_TX_KPUB_DCP_LLC_N_SIZE], /* e */
-	                   XHDCP22_TX_KPUB_DCP_LLC_E_SIZE);
+	/* Use the response times learned for this receiver */
+	XHdcp22Tx_PollSelectProfile(InstancePtr,
+	                            MsgPtr->Message.AKESendCert.CertRx.ReceiverId);
 
-	if (Result != XST_SUCCESS) {
+	/* Skip the signature verification of a certificate verified before */
+	XHdcp22Cmn_Sha256Hash((u8 *)&MsgPtr->Message.AKESendCert.CertRx,
+	                      sizeof(XHdcp22_Tx_CertRx), CertHash);
+	if (XHdcp22Tx_IsCertVerified(InstancePtr, CertHash)) {
 		XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
-	                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_FAIL);
-		return XHDCP22_TX_STATE_A0;
+	                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_CACHED);
 	}
 	else {
+		/* Verify the signature */
+		KPubDpcPtr = XHdcp22Tx_GetKPubDpc(InstancePtr);
 		XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
-	                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_PASS);
+		                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE);
+		Result = XHdcp22Tx_VerifyCertificate(InstancePtr,
+		                   &MsgPtr->Message.AKESendCert.CertRx,
+		                   KPubDpcPtr, /* N */
+		                   XHDCP22_TX_KPUB_DCP_LLC_N_SIZE,
+		                   &KPubDpcPtr[XHDCP22_TX_KPUB_DCP_LLC_N_SIZE], /* e */
+		                   XHDCP22_TX_KPUB_DCP_LLC_E_SIZE);
+
+		if (Result != XST_SUCCESS) {
+			XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
+		                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_FAIL);
+			return XHDCP22_TX_STATE_A0;
+		}
+		else {
+			XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
+		                XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_PASS);
+			XHdcp22Tx_AddVerifiedCert(InstancePtr, CertHash);
+		}
 	}
 
 	/* SRM and revocation check are only performed by the top-level HDCP transmitter */
@@ -2270,6 +2421,17 @@ static XHdcp22_Tx_StateType XHdcp22Tx_StateA4(XHdcp22_Tx *InstancePtr)
 ******************************************************************************/
 static XHdcp22_Tx_StateType XHdcp22Tx_StateA5(XHdcp22_Tx *InstancePtr)
 {
+	/* Send a changed content stream type to the repeater right away,
+	 * without waiting for the re-authentication check timer */
+	if (InstancePtr->Info.AuthenticationStatus == XHDCP22_TX_AUTHENTICATED &&
+	    InstancePtr->Info.IsContentStreamTypeChangePending &&
+	    InstancePtr->Info.IsContentStreamTypeSent == TRUE &&
+	    InstancePtr->Info.SentContentStreamType !=
+	    InstancePtr->Info.ContentStreamType) {
+		InstancePtr->Info.IsContentStreamTypeSent = FALSE;
+		InstancePtr->Info.ContentStreamManageCheckCounter = 0;
+		return XHDCP22_TX_STATE_A9;
+	}
 
 #ifndef _XHDCP22_TX_DISABLE_TIMEOUT_CHECKING_
 	/* wait for a timer to expire, either it is the 200 ms mandatory time
@@ -2302,6 +2464,13 @@ static XHdcp22_Tx_StateType XHdcp22Tx_StateA5(XHdcp22_Tx *InstancePtr)
 			InstancePtr->Info.AuthenticationStatus = XHDCP22_TX_AUTHENTICATED;
 			InstancePtr->Info.ReAuthenticationRequested = (FALSE);
 
+			/* The repeater confirmed the content stream type sent with
+			 * RepeaterAuth_Stream_Manage */
+			if (InstancePtr->Info.SentContentStreamType ==
+			    InstancePtr->Info.ContentStreamType) {
+				InstancePtr->Info.IsContentStreamTypeChangePending = (FALSE);
+			}
+
 			/* Authenticated callback */
 			if (InstancePtr->IsAuthenticatedCallbackSet) {
 				InstancePtr->AuthenticatedCallback(InstancePtr->AuthenticatedCallbackRef);
@@ -2873,6 +3042,27 @@ static void XHdcp22Tx_A9A0(XHdcp22_Tx *InstancePtr)
 	XHdcp22Tx_HandleAuthenticationFailed(InstancePtr);
 }
 
+/*****************************************************************************/
+/**
+*
+* This function executes on transition from state A5 to A9, which means that
+* the content stream type changed on the authenticated link. State A9 waits
+* for the timer, so the running re-authentication check timer is expired.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Tx_A5A9(XHdcp22_Tx *InstancePtr)
+{
+	XTmrCtr_Stop(&InstancePtr->Timer.TmrCtr, XHDCP22_TX_TIMER_CNTR_0);
+	InstancePtr->PollSchedule.MsgIdx = XHDCP22_TX_POLL_NUM_MSGS;
+	InstancePtr->Timer.TimerExpired = (TRUE);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -3140,6 +3330,7 @@ static int XHdcp22Tx_StartTimer(XHdcp22_Tx *InstancePtr, u32 TimeOut_mSec,
 	InstancePtr->Timer.TimerExpired = (FALSE);
 	InstancePtr->Timer.ReasonId = ReasonId;
 	InstancePtr->Timer.InitialTicks = Ticks;
+	InstancePtr->Timer.StartTicks = Ticks;
 
 	/* If the timer was started for receiving a message,
 	 * the message available flag must be reset */
@@ -3149,12 +3340,17 @@ static int XHdcp22Tx_StartTimer(XHdcp22_Tx *InstancePtr, u32 TimeOut_mSec,
 		InstancePtr->Info.MsgAvailable = (FALSE);
 	}
 
+	/* Schedule the RxStatus reads for the message */
+	XHdcp22Tx_PollStart(InstancePtr, TimeOut_mSec, ReasonId);
+
 #ifndef _XHDCP22_TX_DISABLE_TIMEOUT_CHECKING_
 #ifdef _XHDCP22_TX_TEST_
 	if (InstancePtr->Test.TestMode == XHDCP22_TX_TESTMODE_UNIT) {
 		XHdcp22Tx_TimerHandler(InstancePtr, XHDCP22_TX_TIMER_CNTR_0);
+		return XST_SUCCESS;
 	}
-#else
+#endif /* _XHDCP22_TX_TEST_ */
+
 	if (InstancePtr->Timer.TmrCtr.IsReady == (FALSE)) {
 		return XST_FAILURE;
 	}
@@ -3164,7 +3360,6 @@ static int XHdcp22Tx_StartTimer(XHdcp22_Tx *InstancePtr, u32 TimeOut_mSec,
 
 	XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
 	                XHDCP22_TX_LOG_DBG_STARTIMER);
-#endif /* _XHDCP22_TX_TEST_ */
 #endif /* _XHDCP22_TX_DISABLE_TIMEOUT_CHECKING_ */
 
 	return XST_SUCCESS;
@@ -3249,6 +3444,333 @@ void XHdcp22Tx_SetMessagePollingValue(XHdcp22_Tx *InstancePtr, u32 PollingValue)
 	InstancePtr->Info.PollingValue = PollingValue;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function enables or disables the adaptive RxStatus polling schedule.
+* When enabled, the RxStatus register is read while waiting for a message
+* of the receiver at times derived from the response times learned for that
+* receiver, instead of every PollingValue milliseconds. The PollingValue is
+* still used for the link integrity check.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param  Enable is TRUE to use the adaptive schedule, FALSE to poll
+*         every PollingValue milliseconds.
+*
+* @return None.
+*
+* @note   The adaptive schedule is enabled by default. The change takes
+*         effect with the next message that is waited for.
+*
+******************************************************************************/
+void XHdcp22Tx_SetAdaptivePolling(XHdcp22_Tx *InstancePtr, u8 Enable)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	InstancePtr->PollSchedule.IsEnabled = Enable;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function starts the adaptive RxStatus polling schedule for a message.
+* The first read is scheduled just before the response time learned for the
+* receiver or, when nothing has been learned yet, after a default time that
+* is well below the time-out the HDCP specification allows for the message.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param  TimeOut_mSec is the time-out of the message.
+* @param  ReasonId is the reason the timer was started for.
+*
+* @return None.
+*
+* @note   The H' time-out is 200 ms after AKE_Stored_km and 1 s after
+*         AKE_No_Stored_km, which is used to tell both apart.
+*
+******************************************************************************/
+static void XHdcp22Tx_PollStart(XHdcp22_Tx *InstancePtr, u32 TimeOut_mSec,
+                                u8 ReasonId)
+{
+	/* First read when nothing has been learned yet, indexed by XHdcp22_Tx_PollMsg */
+	static const u32 FirstPollUs[XHDCP22_TX_POLL_NUM_MSGS] = {
+		1000, 20000, 2000, 2000, 500, 1000, 1000
+	};
+	XHdcp22_Tx_PollSchedule *SchedPtr = &InstancePtr->PollSchedule;
+	u32 EwmaUs = 0;
+	u8 MsgIdx;
+
+	SchedPtr->ResponseUs = 0;
+
+	switch (ReasonId) {
+	case XHDCP22_TX_AKE_SEND_CERT:
+		MsgIdx = XHDCP22_TX_POLL_MSG_CERT;
+		break;
+	case XHDCP22_TX_AKE_SEND_H_PRIME:
+		MsgIdx = (TimeOut_mSec > 200) ? XHDCP22_TX_POLL_MSG_H_PRIME :
+		                                XHDCP22_TX_POLL_MSG_H_PRIME_STORED;
+		break;
+	case XHDCP22_TX_AKE_SEND_PAIRING_INFO:
+		MsgIdx = XHDCP22_TX_POLL_MSG_PAIRING_INFO;
+		break;
+	case XHDCP22_TX_LC_SEND_L_PRIME:
+		MsgIdx = XHDCP22_TX_POLL_MSG_L_PRIME;
+		break;
+	case XHDCP22_TX_REPEATAUTH_SEND_RECVID_LIST:
+		MsgIdx = XHDCP22_TX_POLL_MSG_RECEIVERID_LIST;
+		break;
+	case XHDCP22_TX_REPEATAUTH_STREAM_READY:
+		MsgIdx = XHDCP22_TX_POLL_MSG_STREAM_READY;
+		break;
+	default:
+		MsgIdx = XHDCP22_TX_POLL_NUM_MSGS;
+		break;
+	}
+
+	if (SchedPtr->IsEnabled == (FALSE) || MsgIdx == XHDCP22_TX_POLL_NUM_MSGS) {
+		SchedPtr->MsgIdx = XHDCP22_TX_POLL_NUM_MSGS;
+		return;
+	}
+
+	if (SchedPtr->ProfileIdx < XHDCP22_TX_POLL_MAX_RECEIVERS) {
+		EwmaUs = SchedPtr->Profile[SchedPtr->ProfileIdx].EwmaUs[MsgIdx];
+	}
+
+	SchedPtr->MsgIdx = MsgIdx;
+	SchedPtr->TimeOutUs = TimeOut_mSec * 1000;
+	SchedPtr->NextPollUs = EwmaUs ? (EwmaUs - (EwmaUs / 8)) : FirstPollUs[MsgIdx];
+	if (SchedPtr->NextPollUs > SchedPtr->TimeOutUs) {
+		SchedPtr->NextPollUs = SchedPtr->TimeOutUs;
+	}
+	SchedPtr->IntervalUs = XHDCP22_TX_POLL_MIN_INTERVAL_US;
+	SchedPtr->PrevPollUs = 0;
+	SchedPtr->Polls = 0;
+	SchedPtr->Stats[MsgIdx].Waits++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function waits for a message of the receiver on the adaptive RxStatus
+* polling schedule. The RxStatus register is read at the scheduled time and,
+* if the message is not available yet, the interval to the next read is
+* doubled up to an eighth of the time-out. When the timer expires the
+* RxStatus register is read a last time.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param  ExpectedSize indicates the expected message size in bytes.
+* @param  ReadyBit indicates if the repeater ready bit from RxStatus register
+*         should be used or the specified ExpectedSize.
+*
+* @return
+*         - XST_SUCCESS if no problems
+*         - XST_FAILURE if the receiver has timed out
+*
+* @note   None.
+*
+******************************************************************************/
+static int XHdcp22Tx_PollWait(XHdcp22_Tx *InstancePtr, int ExpectedSize,
+                              u8 ReadyBit)
+{
+	XHdcp22_Tx_PollSchedule *SchedPtr = &InstancePtr->PollSchedule;
+	u32 TicksPerUs = InstancePtr->Timer.TmrCtr.Config.SysClockFreqHz / 1000000;
+	u32 ElapsedUs;
+	u32 MaxIntervalUs;
+	u8 TimerExpired = InstancePtr->Timer.TimerExpired;
+
+	if (TimerExpired == (FALSE)) {
+		/* Timer is counting down from StartTicks */
+		ElapsedUs = (InstancePtr->Timer.StartTicks -
+		             XHdcp22Tx_GetTimerCount(InstancePtr)) / TicksPerUs;
+		if (ElapsedUs < SchedPtr->NextPollUs) {
+			return XST_SUCCESS;
+		}
+	}
+	else {
+		ElapsedUs = SchedPtr->TimeOutUs;
+	}
+
+	/* Read Rx status. */
+	XHdcp22Tx_ReadRxStatus(InstancePtr);
+	SchedPtr->Polls++;
+
+	if (((ReadyBit == FALSE) && ((InstancePtr->Info.RxStatus & XHDCP22_TX_RXSTATUS_AVAIL_BYTES_MASK) == ExpectedSize)) ||
+		(((ReadyBit == TRUE) && (InstancePtr->Info.RxStatus & XHDCP22_TX_RXSTATUS_READY_MASK)) &&
+		((InstancePtr->Info.RxStatus & XHDCP22_TX_RXSTATUS_AVAIL_BYTES_MASK) > 0))) {
+
+		/* Stop the hardware timer */
+		if (TimerExpired == (FALSE)) {
+			XTmrCtr_Stop(&InstancePtr->Timer.TmrCtr, XHDCP22_TX_TIMER_CNTR_0);
+		}
+
+		/* Set timer expired flag and MsgAvailable flag to signal we've finished waiting */
+		XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG, XHDCP22_TX_LOG_DBG_MSGAVAILABLE);
+		InstancePtr->Timer.TimerExpired = (TRUE);
+		InstancePtr->Info.MsgAvailable = (TRUE);
+		XHdcp22Tx_PollDone(InstancePtr, ElapsedUs, (TRUE));
+		return XST_SUCCESS;
+	}
+
+	if (TimerExpired == (TRUE)) {
+		/* The receiver has timed out...and the data size does not match
+		 * the expected size! */
+		XHdcp22Tx_PollDone(InstancePtr, ElapsedUs, (FALSE));
+		XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG, XHDCP22_TX_LOG_DBG_TIMEOUT);
+		return XST_FAILURE;
+	}
+
+	/* Not available yet, back off */
+	MaxIntervalUs = SchedPtr->TimeOutUs / 8;
+	if (MaxIntervalUs < XHDCP22_TX_POLL_MIN_INTERVAL_US) {
+		MaxIntervalUs = XHDCP22_TX_POLL_MIN_INTERVAL_US;
+	}
+	SchedPtr->PrevPollUs = ElapsedUs;
+	SchedPtr->NextPollUs = ElapsedUs + SchedPtr->IntervalUs;
+	SchedPtr->IntervalUs *= 2;
+	if (SchedPtr->IntervalUs > MaxIntervalUs) {
+		SchedPtr->IntervalUs = MaxIntervalUs;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function ends the adaptive RxStatus polling schedule of a message and
+* updates the statistics and the response time learned for the receiver.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param  ElapsedUs is the time since the timer was started.
+* @param  Received is TRUE if the message is available, FALSE if the
+*         receiver has timed out.
+*
+* @return None.
+*
+* @note   The receiver of AKE_Send_Cert is only known after the message has
+*         been read, its response time is learned by
+*         XHdcp22Tx_PollSelectProfile.
+*
+******************************************************************************/
+static void XHdcp22Tx_PollDone(XHdcp22_Tx *InstancePtr, u32 ElapsedUs,
+                               u8 Received)
+{
+	XHdcp22_Tx_PollSchedule *SchedPtr = &InstancePtr->PollSchedule;
+	XHdcp22_Tx_PollStats *StatsPtr = &SchedPtr->Stats[SchedPtr->MsgIdx];
+	u32 Ms = ElapsedUs / 1000;
+	u8 i = 0;
+
+	StatsPtr->Polls += SchedPtr->Polls;
+
+	if (Received == (FALSE)) {
+		StatsPtr->TimeOuts++;
+		SchedPtr->MsgIdx = XHDCP22_TX_POLL_NUM_MSGS;
+		return;
+	}
+
+	/* Time until the message was seen */
+	while (Ms != 0 && i < (XHDCP22_TX_POLL_HIST_BUCKETS - 1)) {
+		Ms >>= 1;
+		i++;
+	}
+	StatsPtr->Histogram[i]++;
+	StatsPtr->TotalUs += ElapsedUs;
+	if (ElapsedUs > StatsPtr->MaxUs) {
+		StatsPtr->MaxUs = ElapsedUs;
+	}
+
+	/* The message became available between the previous and this read */
+	SchedPtr->ResponseUs = SchedPtr->PrevPollUs +
+	                       ((ElapsedUs - SchedPtr->PrevPollUs) / 2);
+	if (SchedPtr->MsgIdx != XHDCP22_TX_POLL_MSG_CERT) {
+		XHdcp22Tx_PollLearn(InstancePtr, SchedPtr->MsgIdx,
+		                    SchedPtr->ResponseUs);
+	}
+
+	SchedPtr->MsgIdx = XHDCP22_TX_POLL_NUM_MSGS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function updates the moving average of the response time of the
+* current receiver for a message with a weight of 1/4 for the new sample.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param  MsgIdx is the message, see XHdcp22_Tx_PollMsg.
+* @param  ResponseUs is the estimated response time of the receiver.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Tx_PollLearn(XHdcp22_Tx *InstancePtr, u8 MsgIdx,
+                                u32 ResponseUs)
+{
+	XHdcp22_Tx_PollSchedule *SchedPtr = &InstancePtr->PollSchedule;
+	u32 *EwmaPtr;
+
+	if (SchedPtr->ProfileIdx >= XHDCP22_TX_POLL_MAX_RECEIVERS) {
+		return;
+	}
+
+	EwmaPtr = &SchedPtr->Profile[SchedPtr->ProfileIdx].EwmaUs[MsgIdx];
+	if (*EwmaPtr == 0) {
+		*EwmaPtr = ResponseUs ? ResponseUs : 1;
+	}
+	else {
+		*EwmaPtr = *EwmaPtr - (*EwmaPtr / 4) + (ResponseUs / 4);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function selects the learned response times of a receiver for the
+* adaptive RxStatus polling schedule, replacing the oldest entry when the
+* receiver is not known yet and all entries are in use.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param  ReceiverIdPtr is a pointer to the 5-byte receiver Id.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Tx_PollSelectProfile(XHdcp22_Tx *InstancePtr,
+                                        const u8 *ReceiverIdPtr)
+{
+	XHdcp22_Tx_PollSchedule *SchedPtr = &InstancePtr->PollSchedule;
+	XHdcp22_Tx_PollProfile *ProfilePtr;
+	int i;
+
+	for (i=0; i<XHDCP22_TX_POLL_MAX_RECEIVERS; i++) {
+		if (SchedPtr->Profile[i].Valid &&
+		    memcmp(ReceiverIdPtr, SchedPtr->Profile[i].ReceiverId,
+		           XHDCP22_TX_CERT_RCVID_SIZE) == 0) {
+			break;
+		}
+	}
+
+	if (i == XHDCP22_TX_POLL_MAX_RECEIVERS) {
+		i = SchedPtr->ProfileNext;
+		ProfilePtr = &SchedPtr->Profile[i];
+		memset(ProfilePtr, 0, sizeof(XHdcp22_Tx_PollProfile));
+		memcpy(ProfilePtr->ReceiverId, ReceiverIdPtr, XHDCP22_TX_CERT_RCVID_SIZE);
+		ProfilePtr->Valid = (TRUE);
+		SchedPtr->ProfileNext = (i + 1) % XHDCP22_TX_POLL_MAX_RECEIVERS;
+	}
+	SchedPtr->ProfileIdx = i;
+
+	/* The certificate was just waited for */
+	if (SchedPtr->ResponseUs != 0) {
+		XHdcp22Tx_PollLearn(InstancePtr, XHDCP22_TX_POLL_MSG_CERT,
+		                    SchedPtr->ResponseUs);
+		SchedPtr->ResponseUs = 0;
+	}
+}
+
 /*****************************************************************************/
 /**
 *
@@ -3312,6 +3834,11 @@ static int XHdcp22Tx_WaitForReceiver(XHdcp22_Tx *InstancePtr, int ExpectedSize,
 	}
 #endif
 
+	/* Messages with a learned response time use the adaptive schedule */
+	if (InstancePtr->PollSchedule.MsgIdx < XHDCP22_TX_POLL_NUM_MSGS) {
+		return XHdcp22Tx_PollWait(InstancePtr, ExpectedSize, ReadyBit);
+	}
+
 	/* busy waiting...*/
 	if (InstancePtr->Timer.TimerExpired == (FALSE)) {
 
@@ -3540,7 +4067,8 @@ static int XHdcp22Tx_WriteAKENoStoredKm(XHdcp22_Tx *InstancePtr,
 	XHdcp22Tx_GenerateKmMaskingSeed(InstancePtr, MaskingSeed);
 
 	/* Encrypt, pass certificate (1st value is messageId) */
-	XHdcp22Tx_EncryptKm(CertificatePtr, PairingInfoPtr->Km, MaskingSeed, EKpubKm);
+	XHdcp22Tx_EncryptKm(InstancePtr, CertificatePtr, PairingInfoPtr->Km,
+	                    MaskingSeed, EKpubKm);
 	memcpy(MsgPtr->Message.AKENoStoredKm.EKpubKm, EKpubKm,
 	       sizeof(MsgPtr->Message.AKENoStoredKm.EKpubKm));
 
@@ -3736,6 +4264,7 @@ static int XHdcp22Tx_WriteRepeaterAuth_Stream_Manage(XHdcp22_Tx *InstancePtr)
 	/* Value is sent in big endian format */
 	MsgPtr->Message.RepeatAuthStreamManage.StreamID_Type[0] = 0x0; // STREAM_ID: must always be 0x0
 	MsgPtr->Message.RepeatAuthStreamManage.StreamID_Type[1] = (u8)InstancePtr->Info.ContentStreamType; // Stream Type
+	InstancePtr->Info.SentContentStreamType = InstancePtr->Info.ContentStreamType;
 
 	/* To make verifying the MPrime from the repeater easier,
 	 * the M is calculated and stored before executing the write */
@@ -3935,6 +4464,84 @@ static XHdcp22_Tx_PairingInfo *XHdcp22Tx_UpdatePairingInfo(
 	return PairingInfoPtr;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function clears the verified certificates, so the signature of every
+* HDCP2.2 receiver certificate will be verified again.
+*
+* @param   InstancePtr is a pointer to the XHdcp22Tx core instance.
+*
+* @return  XST_SUCCESS
+*
+* @note    None.
+*
+******************************************************************************/
+int XHdcp22Tx_ClearVerifiedCerts(XHdcp22_Tx *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	memset(InstancePtr->Info.VerifiedCert, 0x00,
+	       sizeof(InstancePtr->Info.VerifiedCert));
+	InstancePtr->Info.VerifiedCertNext = 0;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks if a receiver certificate has been verified before.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param  HashPtr is a pointer to the SHA256 hash of the certificate.
+*
+* @return TRUE if the certificate has been verified, FALSE otherwise.
+*
+* @note   None.
+*
+******************************************************************************/
+static u8 XHdcp22Tx_IsCertVerified(XHdcp22_Tx *InstancePtr, const u8 *HashPtr)
+{
+	int i;
+
+	for (i=0; i<XHDCP22_TX_MAX_VERIFIED_CERTS; i++) {
+		if (InstancePtr->Info.VerifiedCert[i].Valid &&
+		    memcmp(HashPtr, InstancePtr->Info.VerifiedCert[i].Hash,
+		           XHDCP22_TX_SHA256_HASH_SIZE) == 0) {
+			return (TRUE);
+		}
+	}
+	return (FALSE);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function stores the hash of a verified receiver certificate,
+* replacing the oldest entry when all entries are in use.
+*
+* @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param  HashPtr is a pointer to the SHA256 hash of the certificate.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Tx_AddVerifiedCert(XHdcp22_Tx *InstancePtr,
+                                      const u8 *HashPtr)
+{
+	XHdcp22_Tx_VerifiedCert *CertPtr =
+		&InstancePtr->Info.VerifiedCert[InstancePtr->Info.VerifiedCertNext];
+
+	memcpy(CertPtr->Hash, HashPtr, XHDCP22_TX_SHA256_HASH_SIZE);
+	CertPtr->Valid = (TRUE);
+
+	InstancePtr->Info.VerifiedCertNext =
+		(InstancePtr->Info.VerifiedCertNext + 1) % XHDCP22_TX_MAX_VERIFIED_CERTS;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -4308,7 +4915,7 @@ int XHdcp22Tx_LogShow(XHdcp22_Tx *InstancePtr, char *buff, int buff_size)
 #ifdef _XHDCP22_TX_TEST_
 	if (InstancePtr->Test.TestMode == XHDCP22_TX_TESTMODE_UNIT) {
 		XHdcp22Tx_LogDisplayUnitTest(InstancePtr);
-		return;
+		return strSize;
 	}
 #endif
 
@@ -4435,6 +5042,7 @@ int XHdcp22Tx_LogShow(XHdcp22_Tx *InstancePtr, char *buff, int buff_size)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, VERIFY_SIGNATURE)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, VERIFY_SIGNATURE_PASS)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, VERIFY_SIGNATURE_FAIL)
+				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, VERIFY_SIGNATURE_CACHED)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, DEVICE_IS_REVOKED)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, ENCRYPT_KM)
 				XHDCP22_TX_CASE_TO_STR_PRE(XHDCP22_TX_LOG_DBG_, ENCRYPT_KM_DONE)
@@ -4506,6 +5114,14 @@ int XHdcp22Tx_LogShow(XHdcp22_Tx *InstancePtr, char *buff, int buff_size)
 ******************************************************************************/
 void XHdcp22Tx_Info(XHdcp22_Tx *InstancePtr)
 {
+	/* Indexed by XHdcp22_Tx_PollMsg */
+	static const char *const PollMsgName[XHDCP22_TX_POLL_NUM_MSGS] = {
+		"Cert", "H'", "H' (stored)", "Pairing", "L'", "RecvIdList",
+		"StreamReady"
+	};
+	XHdcp22_Tx_PollStats *StatsPtr;
+	int i, j;
+
 	XDEBUG_PRINTF("Status : ");
 	if (XHdcp22Tx_IsEnabled(InstancePtr)) {
 		switch (InstancePtr->Info.AuthenticationStatus) {
@@ -4576,6 +5192,25 @@ void XHdcp22Tx_Info(XHdcp22_Tx *InstancePtr)
 	XDEBUG_PRINTF("Auth Requests: %d\n\r", InstancePtr->Info.AuthRequestCnt);
 	XDEBUG_PRINTF("Reauth Requests: %d\n\r", InstancePtr->Info.ReauthRequestCnt);
 	XDEBUG_PRINTF("Polling Interval: %d ms\n\r", InstancePtr->Info.PollingValue);
+	XDEBUG_PRINTF("Adaptive Polling: %s\n\r",
+	              InstancePtr->PollSchedule.IsEnabled ? "Enabled" : "Disabled");
+
+	/* Histogram buckets are <1, <2, <4, ... ms */
+	for (i=0; i<XHDCP22_TX_POLL_NUM_MSGS; i++) {
+		StatsPtr = &InstancePtr->PollSchedule.Stats[i];
+		if (StatsPtr->Waits == 0) {
+			continue;
+		}
+		XDEBUG_PRINTF("%s: waits %u, polls %u, timeouts %u, "
+		              "total %llu us, max %u us, hist",
+		              PollMsgName[i], StatsPtr->Waits, StatsPtr->Polls,
+		              StatsPtr->TimeOuts,
+		              (unsigned long long)StatsPtr->TotalUs, StatsPtr->MaxUs);
+		for (j=0; j<XHDCP22_TX_POLL_HIST_BUCKETS; j++) {
+			XDEBUG_PRINTF(" %u", StatsPtr->Histogram[j]);
+		}
+		XDEBUG_PRINTF("\n\r");
+	}
 }
 
 /** @} */
@@ -69,6 +69,13 @@
 * 2.01  MH     02/28/17 Fixed compiler warnings.
 * 2.20  MH     04/12/17 Added function XHdcp22Tx_IsDwnstrmCapable.
 * 2.30  MH     07/06/17 Changed default polling value to 10 ms.
+* 2.50  XLNX   10/18/26 Added MpWorkspace for the RSA operations.
+*                       Added verified certificate cache and function
+*                       XHdcp22Tx_ClearVerifiedCerts.
+*                       Added adaptive RxStatus polling schedule and
+*                       function XHdcp22Tx_SetAdaptivePolling.
+* 2.60  XLNX   10/18/26 Added functions XHdcp22Tx_ChangeContentStreamType
+*                       and XHdcp22Tx_IsContentStreamTypeChangePending.
 * </pre>
 *
 ******************************************************************************/
@@ -116,6 +123,30 @@ extern "C" {
 */
 #define XHDCP22_TX_MAX_STORED_PAIRINGINFO  2
 
+/**
+* The maximum number of receiver certificates remembered as verified.
+*/
+#define XHDCP22_TX_MAX_VERIFIED_CERTS  4
+
+/**
+* Needed storage in 32-bit words for the modular exponentiation workspace,
+* sized for the 3072-bit DCP LLC public key.
+*/
+#define XHDCP22_TX_MP_WORKSPACE_SIZE  (6 * (384 / 4))
+
+/**
+* The number of receivers for which the adaptive RxStatus polling schedule
+* remembers the learned response times.
+*/
+#define XHDCP22_TX_POLL_MAX_RECEIVERS  4
+
+/**
+* The number of buckets of the adaptive polling latency histograms. Bucket 0
+* counts waits below 1 ms, bucket n waits in [2^(n-1), 2^n) ms and the last
+* bucket everything from 2048 ms up.
+*/
+#define XHDCP22_TX_POLL_HIST_BUCKETS  13
+
 /**
 * The size of the log buffer.
 */
@@ -275,6 +306,22 @@ typedef struct
 	u16 RngId;
 } XHdcp22_Tx_Config;
 
+/**
+* These constants identify the messages that are waited for with the
+* adaptive RxStatus polling schedule.
+*/
+typedef enum
+{
+	XHDCP22_TX_POLL_MSG_CERT,            /**< AKE_Send_Cert. */
+	XHDCP22_TX_POLL_MSG_H_PRIME,         /**< AKE_Send_H_prime after AKE_No_Stored_km. */
+	XHDCP22_TX_POLL_MSG_H_PRIME_STORED,  /**< AKE_Send_H_prime after AKE_Stored_km. */
+	XHDCP22_TX_POLL_MSG_PAIRING_INFO,    /**< AKE_Send_Pairing_Info. */
+	XHDCP22_TX_POLL_MSG_L_PRIME,         /**< LC_Send_L_prime. */
+	XHDCP22_TX_POLL_MSG_RECEIVERID_LIST, /**< RepeaterAuth_Send_ReceiverID_List. */
+	XHDCP22_TX_POLL_MSG_STREAM_READY,    /**< RepeaterAuth_Stream_Ready. */
+	XHDCP22_TX_POLL_NUM_MSGS             /**< Number of messages, also used as none. */
+} XHdcp22_Tx_PollMsg;
+
 /**
  * The current state and data for internal used timer.
  */
@@ -286,6 +333,8 @@ typedef struct
 	u8 ReasonId;
 	/** Keep track of the start value of the timer. */
 	u32 InitialTicks;
+	/** The value the timer was started with. */
+	u32 StartTicks;
 	/** The hardware timer instance.*/
 	XTmrCtr TmrCtr;
 } XHdcp22_Tx_Timer;
@@ -302,6 +351,60 @@ typedef struct {
 	u8 Ekh_Km[16];       /**< Ekh(Km). */
      u8 Ready;            /**< Indicates a valid entry */
 } XHdcp22_Tx_PairingInfo;
+
+/**
+* This typedef contains a receiver certificate with a verified signature.
+*/
+typedef struct {
+	u8 Hash[32];         /**< SHA256 hash of the complete certificate. */
+	u8 Valid;            /**< Indicates a valid entry */
+} XHdcp22_Tx_VerifiedCert;
+
+/**
+* This typedef contains the RxStatus polling statistics of one message.
+*/
+typedef struct {
+	u32 Waits;           /**< Number of times the message was waited for. */
+	u32 Polls;           /**< Number of RxStatus reads while waiting. */
+	u32 TimeOuts;        /**< Number of waits that timed out. */
+	u64 TotalUs;         /**< Accumulated time until the message was seen. */
+	u32 MaxUs;           /**< Longest time until the message was seen. */
+	/** Time until the message was seen, see #XHDCP22_TX_POLL_HIST_BUCKETS. */
+	u32 Histogram[XHDCP22_TX_POLL_HIST_BUCKETS];
+} XHdcp22_Tx_PollStats;
+
+/**
+* This typedef contains the learned response times of one receiver.
+*/
+typedef struct {
+	u8 ReceiverId[5];    /**< Unique receiver Id. */
+	/** Moving average of the response time per message, 0 if not learned. */
+	u32 EwmaUs[XHDCP22_TX_POLL_NUM_MSGS];
+	u8 Valid;            /**< Indicates a valid entry */
+} XHdcp22_Tx_PollProfile;
+
+/**
+* This typedef contains the adaptive RxStatus polling schedule. The first
+* RxStatus read for a message is scheduled just before the response time
+* learned for the receiver, after which the interval between reads is doubled
+* up to an eighth of the message time-out.
+*/
+typedef struct {
+	u8 IsEnabled;        /**< Adaptive polling is used instead of PollingValue. */
+	u8 MsgIdx;           /**< Message waited for, XHDCP22_TX_POLL_NUM_MSGS if none. */
+	u32 TimeOutUs;       /**< Time-out of the current wait. */
+	u32 NextPollUs;      /**< Time of the next RxStatus read. */
+	u32 IntervalUs;      /**< Interval after the next RxStatus read. */
+	u32 PrevPollUs;      /**< Time of the previous RxStatus read. */
+	u32 Polls;           /**< RxStatus reads during the current wait. */
+	u32 ResponseUs;      /**< Estimated response time of the last message. */
+	/** Profile of the current receiver, XHDCP22_TX_POLL_MAX_RECEIVERS if none. */
+	u8 ProfileIdx;
+	/** Next entry of Profile to replace. */
+	u8 ProfileNext;
+	XHdcp22_Tx_PollProfile Profile[XHDCP22_TX_POLL_MAX_RECEIVERS];
+	XHdcp22_Tx_PollStats Stats[XHDCP22_TX_POLL_NUM_MSGS];
+} XHdcp22_Tx_PollSchedule;
 /**
 * This typedef contains information about the HDCP22 transmitter.
 */
@@ -320,6 +423,12 @@ typedef struct
 	u8 MsgAvailable;                    /**< Message is available for reading. */
 
 	XHdcp22_Tx_PairingInfo PairingInfo[XHDCP22_TX_MAX_STORED_PAIRINGINFO];
+
+	/** Certificates of which the signature has been verified. */
+	XHdcp22_Tx_VerifiedCert VerifiedCert[XHDCP22_TX_MAX_VERIFIED_CERTS];
+	/** Next entry of VerifiedCert to replace. */
+	u8 VerifiedCertNext;
+
 	/** The result after a call to #XHdcp22Tx_Poll. */
 	XHdcp22_Tx_AuthenticationType AuthenticationStatus;
 
@@ -350,6 +459,12 @@ typedef struct
 	/** Content stream management failed */
 	u8 ContentStreamManageFailed;
 
+	/** Content stream type of the last RepeaterAuth_Stream_Manage message */
+	XHdcp22_Tx_ContentStreamType SentContentStreamType;
+
+	/** Content stream type change on the authenticated link in progress */
+	u8 IsContentStreamTypeChangePending;
+
 	/** Indicates if the first seq_num_V value is received */
 	u8 ReceivedFirstSeqNum_V;
 
@@ -529,6 +644,9 @@ typedef struct
 	/** Internal used timer. */
 	XHdcp22_Tx_Timer Timer;
 
+	/** Adaptive RxStatus polling schedule. */
+	XHdcp22_Tx_PollSchedule PollSchedule;
+
 	/** Internal used hardware random number generator. */
 	XHdcp22_Rng Rng;
 
@@ -550,6 +668,9 @@ typedef struct
 	/** Topology info. */
 	XHdcp22_Tx_Topology Topology;
 
+	/** Workspace for the RSA modular exponentiation. */
+	u32 MpWorkspace[XHDCP22_TX_MP_WORKSPACE_SIZE];
+
 #ifdef _XHDCP22_TX_TEST_
 	/** Testing. */
 	XHdcp22_Tx_Test Test;
@@ -570,6 +691,7 @@ int XHdcp22Tx_CfgInitialize(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_Config *CfgPtr,
                             UINTPTR EffectiveAddr);
 int XHdcp22Tx_Reset(XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_ClearPairingInfo(XHdcp22_Tx *InstancePtr);
+int XHdcp22Tx_ClearVerifiedCerts(XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_Authenticate (XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_Poll(XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_Enable (XHdcp22_Tx *InstancePtr);
@@ -600,6 +722,7 @@ XHdcp22_Tx_LogItem* XHdcp22Tx_LogRd(XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_LogShow(XHdcp22_Tx *InstancePtr, char *buff, int buff_size);
 u32  XHdcp22Tx_LogGetTimeUSecs(XHdcp22_Tx *InstancePtr);
 void XHdcp22Tx_SetMessagePollingValue(XHdcp22_Tx *InstancePtr, u32 PollingValue);
+void XHdcp22Tx_SetAdaptivePolling(XHdcp22_Tx *InstancePtr, u8 Enable);
 void XHdcp22Tx_Info(XHdcp22_Tx *InstancePtr);
 
 /* Functions for loading authentication constants */
@@ -619,6 +742,8 @@ u32 XHdcp22Tx_GetTopologyField(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_TopologyField
 u8 XHdcp22Tx_IsRepeater(XHdcp22_Tx *InstancePtr);
 void XHdcp22Tx_SetRepeater(XHdcp22_Tx *InstancePtr, u8 Set);
 void XHdcp22Tx_SetContentStreamType(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_ContentStreamType StreamType);
+int XHdcp22Tx_ChangeContentStreamType(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_ContentStreamType StreamType);
+u8 XHdcp22Tx_IsContentStreamTypeChangePending(XHdcp22_Tx *InstancePtr);
 
 /************************** Variable Declarations ****************************/
 
@@ -36,6 +36,8 @@
 *                       Signature verification has been updated to
 *                       check entire encoded message EM including
 *                       padding PS.
+* 2.50  XLNX   10/18/26 Use Montgomery modular exponentiation with the
+*                       per-instance workspace in XHdcp22Tx_RsaEncryptMsg.
 * </pre>
 *
 ******************************************************************************/
@@ -57,17 +59,20 @@
 
 static int XHdcp22Tx_Mgf1(const u8 *Seed, unsigned int Seedlen, u8 *Mask,
                           unsigned int MaskLen);
-static int XHdcp22Tx_RsaOaepEncrypt(const u8 *KeyPubNPtr, int KeyPubNSize,
+static int XHdcp22Tx_RsaOaepEncrypt(XHdcp22_Tx *InstancePtr,
+                                    const u8 *KeyPubNPtr, int KeyPubNSize,
                                     const u8 *KeyPubEPtr, int KeyEPubSize,
                                     const u8 *Message, const u32 MessageLen,
                                     const u8 *MaskingSeed, u8 *EncryptedMessage);
 static int XHdcp22Tx_Pkcs1EmeOaepEncode(const u8 *Message, const u32 MessageLen,
 										const u8 *MaskingSeed, u8 *EncodedMessage);
-static int XHdcp22Tx_RsaEncryptMsg(const u8 *KeyPubNPtr, int KeyPubNSize,
+static int XHdcp22Tx_RsaEncryptMsg(XHdcp22_Tx *InstancePtr,
+                                   const u8 *KeyPubNPtr, int KeyPubNSize,
                                    const u8 *KeyPubEPtr, int KeyPubESize,
                                    const u8 *MsgPtr, int MsgSize,
                                    u8 *EncryptedMsgPtr);
-static int XHdcp22Tx_RsaSignatureVerify(const u8 *MessagePtr, int MessageSize,
+static int XHdcp22Tx_RsaSignatureVerify(XHdcp22_Tx *InstancePtr,
+                                        const u8 *MessagePtr, int MessageSize,
                                         const u8 *SignaturePtr,
                                         const u8 *KpubDcpNPtr, int KpubDcpNSize,
                                         const u8 *KpubDcpEPtr, int KpubDcpESize);
@@ -219,6 +224,7 @@ static int XHdcp22Tx_Pkcs1EmeOaepEncode(const u8 *Message, const u32 MessageLen,
 * the signature representative under the control of a public key.
 * This is the same as encryption, but it in a totally different context.
 *
+* @param  InstancePtr is a pointer to the XHdcp22_Tx core instance.
 * @param  KeyPubNPtr is the RSA public key modulus part.
 * @param  KeyPubNSize is size of the RSA public key modulus in bytes.
 * @param  KeyPubEPtr is the RSA public key E (exponential) part.
@@ -235,7 +241,8 @@ static int XHdcp22Tx_Pkcs1EmeOaepEncode(const u8 *Message, const u32 MessageLen,
 * @note		Note: Verification with a public key is the same as RSA encoding.
 *
 ******************************************************************************/
-static int XHdcp22Tx_RsaEncryptMsg(const u8 *KeyPubNPtr, int KeyPubNSize,
+static int XHdcp22Tx_RsaEncryptMsg(XHdcp22_Tx *InstancePtr,
+								   const u8 *KeyPubNPtr, int KeyPubNSize,
 								   const u8 *KeyPubEPtr, int KeyPubESize,
 								   const u8 *MsgPtr, int MsgSize, u8 *EncryptedMsgPtr)
 {
@@ -249,11 +256,16 @@ static int XHdcp22Tx_RsaEncryptMsg(const u8 *KeyPubNPtr, int KeyPubNSize,
 		return XST_FAILURE;
 	}
 
+	/* Check if the workspace fits the key length. */
+	if(mpMODEXP_WORKSPACE_DIGITS(ModSize) > XHDCP22_TX_MP_WORKSPACE_SIZE) {
+		return XST_FAILURE;
+	}
+
 	mpConvFromOctets(n, ModSize, KeyPubNPtr, KeyPubNSize);
 	mpConvFromOctets(e, ModSize, KeyPubEPtr, KeyPubESize);
 
 	mpConvFromOctets(m, ModSize, MsgPtr, MsgSize);
-	mpModExp(s, m, e, n, ModSize);
+	mpModExpMont(s, m, e, n, ModSize, InstancePtr->MpWorkspace);
 	mpConvToOctets(s, ModSize, EncryptedMsgPtr, MsgSize);
 
 	return XST_SUCCESS;
@@ -267,6 +279,7 @@ static int XHdcp22Tx_RsaEncryptMsg(const u8 *KeyPubNPtr, int KeyPubNSize,
 *
 * Reference: PKCS#1 v2.1, Section 7.1.1
 *
+* @param  InstancePtr is a pointer to the XHdcp22_Tx core instance.
 * @param  KeyPubNPtr is the public certicate modulus.
 * @param  KeyPubNSize is the size public certicate modulus.
 * @param  KeyPubEPtr is the public certicate exponent.
@@ -281,7 +294,8 @@ static int XHdcp22Tx_RsaEncryptMsg(const u8 *KeyPubNPtr, int KeyPubNSize,
 *
 * @note   None.
 *****************************************************************************/
-static int XHdcp22Tx_RsaOaepEncrypt(const u8 *KeyPubNPtr, int KeyPubNSize,
+static int XHdcp22Tx_RsaOaepEncrypt(XHdcp22_Tx *InstancePtr,
+                                    const u8 *KeyPubNPtr, int KeyPubNSize,
                                     const u8 *KeyPubEPtr, int KeyEPubSize,
                                     const u8 *Message, const u32 MessageLen,
                                     const u8 *MaskingSeed, u8 *EncryptedMessage)
@@ -308,7 +322,7 @@ static int XHdcp22Tx_RsaOaepEncrypt(const u8 *KeyPubNPtr, int KeyPubNSize,
 	}
 
 	/* Step 3: RSA encryption */
-	Status = XHdcp22Tx_RsaEncryptMsg(KeyPubNPtr, KeyPubNSize, KeyPubEPtr,
+	Status = XHdcp22Tx_RsaEncryptMsg(InstancePtr, KeyPubNPtr, KeyPubNSize, KeyPubEPtr,
 	                                 KeyEPubSize, em, KeyPubNSize,
 	                                 EncryptedMessage);
 	if(Status != XST_SUCCESS) {
@@ -328,6 +342,7 @@ static int XHdcp22Tx_RsaOaepEncrypt(const u8 *KeyPubNPtr, int KeyPubNSize,
 *
 * Reference: PKCS#1 v2.1, Section 8.2.2 and Section 9.2
 *
+* @param  InstancePtr is a pointer to the XHdcp22_Tx core instance.
 * @param  MessagePtr is a pointer to the start of the message to be hashed.
 * @param  MessageSize is the size of the message to be hashed.
 * @param  SignaturePtr is a pointer to the start of the DCP generated signature.
@@ -342,7 +357,8 @@ static int XHdcp22Tx_RsaOaepEncrypt(const u8 *KeyPubNPtr, int KeyPubNSize,
 * @note   None.
 *
 *****************************************************************************/
-static int XHdcp22Tx_RsaSignatureVerify(const u8 *MessagePtr, int MessageSize,
+static int XHdcp22Tx_RsaSignatureVerify(XHdcp22_Tx *InstancePtr,
+                                        const u8 *MessagePtr, int MessageSize,
                                         const u8 *SignaturePtr,
                                         const u8 *KpubDcpNPtr, int KpubDcpNSize,
                                         const u8 *KpubDcpEPtr, int KpubDcpESize)
@@ -368,7 +384,7 @@ static int XHdcp22Tx_RsaSignatureVerify(const u8 *MessagePtr, int MessageSize,
 	XHdcp22Cmn_Sha256Hash(MessagePtr, MessageSize, THash);
 
 	/* Perform RSA decryption and recover EM */
-	Result = XHdcp22Tx_RsaEncryptMsg(KpubDcpNPtr, KpubDcpNSize,
+	Result = XHdcp22Tx_RsaEncryptMsg(InstancePtr, KpubDcpNPtr, KpubDcpNSize,
                                    KpubDcpEPtr, KpubDcpESize,
                                    SignaturePtr,
                                    XHDCP22_TX_CERT_SIGNATURE_SIZE,
@@ -445,6 +461,7 @@ void XHdcp22Tx_GenerateRandom(XHdcp22_Tx *InstancePtr, int NumOctets,
 *
 * This function verifies the HDCP receivers certificate.
 *
+* @param  InstancePtr is a pointer to the XHdcp22_Tx core instance.
 * @param  CertificatePtr is a pointer to the certificate from the HDCP2.2
 *         receiver.
 * @param  KpubDcpNPtr is a pointer to the N-value of the certificate signature.
@@ -458,11 +475,13 @@ void XHdcp22Tx_GenerateRandom(XHdcp22_Tx *InstancePtr, int NumOctets,
 * @note   None.
 *
 ******************************************************************************/
-int XHdcp22Tx_VerifyCertificate(const XHdcp22_Tx_CertRx* CertificatePtr,
+int XHdcp22Tx_VerifyCertificate(XHdcp22_Tx *InstancePtr,
+                                const XHdcp22_Tx_CertRx* CertificatePtr,
                                 const u8* KpubDcpNPtr, int KpubDcpNSize,
                                 const u8* KpubDcpEPtr, int KpubDcpESize)
 {
 	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(CertificatePtr != NULL);
 	Xil_AssertNonvoid(KpubDcpNPtr != NULL);
 	Xil_AssertNonvoid(KpubDcpEPtr != NULL);
@@ -471,7 +490,7 @@ int XHdcp22Tx_VerifyCertificate(const XHdcp22_Tx_CertRx* CertificatePtr,
 
 	int Result = XST_SUCCESS;
 
-	Result = XHdcp22Tx_RsaSignatureVerify (
+	Result = XHdcp22Tx_RsaSignatureVerify (InstancePtr,
 				(u8 *)CertificatePtr,
                     (sizeof(XHdcp22_Tx_CertRx) - sizeof(CertificatePtr->Signature)),
 				CertificatePtr->Signature,
@@ -486,6 +505,7 @@ int XHdcp22Tx_VerifyCertificate(const XHdcp22_Tx_CertRx* CertificatePtr,
 *
 * This function verifies a HDCP2 system renewability message (SRM) block.
 *
+* @param  InstancePtr is a pointer to the XHdcp22_Tx core instance.
 * @param  SrmPtr is a pointer to the SRM.
 * @param  SrmSize is the size of the SRM in bytes.
 * @param  KpubDcpNPtr is a pointer to the N-value of the DCP LLC key.
@@ -499,11 +519,13 @@ int XHdcp22Tx_VerifyCertificate(const XHdcp22_Tx_CertRx* CertificatePtr,
 * @note   None.
 *
 ******************************************************************************/
-int XHdcp22Tx_VerifySRM(const u8* SrmPtr, int SrmSize,
+int XHdcp22Tx_VerifySRM(XHdcp22_Tx *InstancePtr,
+	const u8* SrmPtr, int SrmSize,
 	const u8* KpubDcpNPtr, int KpubDcpNSize,
 	const u8* KpubDcpEPtr, int KpubDcpESize)
 {
 	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(SrmPtr != NULL);
 	Xil_AssertNonvoid(KpubDcpNPtr != NULL);
 	Xil_AssertNonvoid(KpubDcpEPtr != NULL);
@@ -513,7 +535,7 @@ int XHdcp22Tx_VerifySRM(const u8* SrmPtr, int SrmSize,
 
 	int Result = XST_SUCCESS;
 
-	Result = XHdcp22Tx_RsaSignatureVerify (
+	Result = XHdcp22Tx_RsaSignatureVerify (InstancePtr,
 				(u8 *)SrmPtr,
                     SrmSize - XHDCP22_TX_SRM_SIGNATURE_SIZE,
 				SrmPtr + (SrmSize - XHDCP22_TX_SRM_SIGNATURE_SIZE),
@@ -858,6 +880,7 @@ void XHdcp22Tx_ComputeM(const u8* Rn, const u8* Rrx, const u8* Rtx,
 *
 * This function encrypts the Km value with the receivers public key into Ekh(Km)
 *
+* @param  InstancePtr is a pointer to the XHdcp22_Tx core instance.
 * @param  CertificatePtr is a pointer to the certificate from the HDCP2.2 receiver.
 * @param  KmPtr is the random master key.
 * @param  MaskingSeedPtr is a pointer to a 32 byte seed for masking in the MGF1 function
@@ -871,16 +894,18 @@ void XHdcp22Tx_ComputeM(const u8* Rn, const u8* Rrx, const u8* Rtx,
 * @note   None.
 *
 ******************************************************************************/
-int XHdcp22Tx_EncryptKm(const XHdcp22_Tx_CertRx* CertificatePtr,
+int XHdcp22Tx_EncryptKm(XHdcp22_Tx *InstancePtr,
+                        const XHdcp22_Tx_CertRx* CertificatePtr,
                         const u8* KmPtr, u8 *MaskingSeedPtr, u8* EncryptedKmPtr)
 {
 	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(CertificatePtr != NULL);
 	Xil_AssertNonvoid(KmPtr != NULL);
 	Xil_AssertNonvoid(MaskingSeedPtr != NULL);
 	Xil_AssertNonvoid(EncryptedKmPtr != NULL);
 
-	return XHdcp22Tx_RsaOaepEncrypt(CertificatePtr->N, 	XHDCP22_TX_CERT_PUB_KEY_N_SIZE,
+	return XHdcp22Tx_RsaOaepEncrypt(InstancePtr, CertificatePtr->N, 	XHDCP22_TX_CERT_PUB_KEY_N_SIZE,
                                   CertificatePtr->e, XHDCP22_TX_CERT_PUB_KEY_E_SIZE,
                                   KmPtr, XHDCP22_TX_KM_SIZE,
                                   MaskingSeedPtr, EncryptedKmPtr);
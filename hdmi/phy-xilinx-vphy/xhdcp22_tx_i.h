@@ -236,6 +236,7 @@ typedef enum
 	XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE,
 	XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_PASS,
 	XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_FAIL,
+	XHDCP22_TX_LOG_DBG_VERIFY_SIGNATURE_CACHED,
 	XHDCP22_TX_LOG_DBG_DEVICE_IS_REVOKED,
 	XHDCP22_TX_LOG_DBG_ENCRYPT_KM,
 	XHDCP22_TX_LOG_DBG_ENCRYPT_KM_DONE,
@@ -474,10 +475,12 @@ typedef struct
 /* Crypto functions */
 void XHdcp22Tx_MemXor(u8 *Output, const u8 *InputA, const u8 *InputB,
                       unsigned int Size);
-int XHdcp22Tx_VerifyCertificate(const XHdcp22_Tx_CertRx *CertificatePtr,
+int XHdcp22Tx_VerifyCertificate(XHdcp22_Tx *InstancePtr,
+                                const XHdcp22_Tx_CertRx *CertificatePtr,
                                 const u8* KpubDcpNPtr, int KpubDcpNSize,
                                 const u8* KpubDcpEPtr, int KpubDcpESize);
-int XHdcp22Tx_VerifySRM(const u8* SrmPtr, int SrmSize,
+int XHdcp22Tx_VerifySRM(XHdcp22_Tx *InstancePtr,
+                        const u8* SrmPtr, int SrmSize,
                         const u8* KpubDcpNPtr, int KpubDcpNSize,
                         const u8* KpubDcpEPtr, int KpubDcpESize);
 void XHdcp22Tx_ComputeHPrime(const u8 *Rrx, const u8 *RxCaps,
@@ -495,7 +498,8 @@ void XHdcp22Tx_ComputeM(const u8* Rn, const u8* Rrx, const u8* Rtx,
 void XHdcp22Tx_ComputeEdkeyKs(const u8* Rn, const u8* Km,
                               const u8 *Ks, const u8 *Rrx,
                               const u8 *Rtx,  u8 *EdkeyKs);
-int XHdcp22Tx_EncryptKm(const XHdcp22_Tx_CertRx* CertificatePtr,
+int XHdcp22Tx_EncryptKm(XHdcp22_Tx *InstancePtr,
+                        const XHdcp22_Tx_CertRx* CertificatePtr,
                         const u8* KmPtr, u8 *MaskingSeedPtr,
                         u8* EncryptedKmPtr);
 void XHdcp22Tx_GenerateRandom(XHdcp22_Tx *InstancePtr, int NumOctets,
@@ -853,6 +853,8 @@ typedef struct {
     void *UserTimerPtr;         /**< Pointer to a timer instance
                             used by the custom user
                             delay/sleep function. */
+    u32 IntrHoldMask;           /**< Interrupt status bits that are left
+                            pending by the interrupt handlers. */
 } XHdmiphy1;
 
 /**************************** Function Prototypes *****************************/
@@ -1186,7 +1186,7 @@ void XHdmiphy1_HdmiGtHandler(XHdmiphy1 *InstancePtr)
 
     /* Read Interrupt Status register */
     Event = XHdmiphy1_ReadReg(InstancePtr->Config.BaseAddr,
-                XHDMIPHY1_INTR_STS_REG);
+                XHDMIPHY1_INTR_STS_REG) & ~InstancePtr->IntrHoldMask;
 
     EventAck = EventMask & Event;
 
@@ -1294,7 +1294,7 @@ void XHdmiphy1_ClkDetHandler(XHdmiphy1 *InstancePtr)
 
     /* Read Interrupt Status register */
     Event = XHdmiphy1_ReadReg(InstancePtr->Config.BaseAddr,
-                XHDMIPHY1_INTR_STS_REG);
+                XHDMIPHY1_INTR_STS_REG) & ~InstancePtr->IntrHoldMask;
 
     EventAck = EventMask & Event;
 
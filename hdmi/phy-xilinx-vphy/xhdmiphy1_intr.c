@@ -236,7 +236,7 @@ void XHdmiphy1_InterruptHandler(XHdmiphy1 *InstancePtr)
 
 	/* Determine what kind of interrupts have occurred. */
 	IntrStatus = XHdmiphy1_ReadReg(InstancePtr->Config.BaseAddr,
-			XHDMIPHY1_INTR_STS_REG);
+			XHDMIPHY1_INTR_STS_REG) & ~InstancePtr->IntrHoldMask;
 
 #if (XPAR_HDMIPHY1_0_TRANSCEIVER != XHDMIPHY1_GTYE5)
 	if (IntrStatus & XHDMIPHY1_INTR_CPLL_LOCK_MASK) {
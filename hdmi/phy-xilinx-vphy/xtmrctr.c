@@ -52,12 +52,17 @@
 *                     are used to enable/disable the PWM output.
 * 4.8   dp   02/12/21 Fix compilation errors that arise when -Werror=conversion
 *                     is enabled in compilation flags.
+* 4.9   XLNX 10/18/26 Added the software timer mode, the counters of an
+*                     instance with XTmrCtr_Config.SoftOps are emulated from
+*                     the backend time base. Added XTmrCtr_SoftWait.
 * </pre>
 *
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
 
+#include <linux/math64.h>
+#include <linux/string.h>
 #include "xstatus.h"
 
 #include "xtmrctr.h"
@@ -75,6 +80,7 @@
 /************************** Function Prototypes ******************************/
 
 static void XTmrCtr_StubCallback(void *CallBackRef, u8 TmrCtrNumber);
+static void XTmrCtr_SoftLoad(XTmrCtr *InstancePtr, u8 TmrCtrNumber);
 
 /************************** Variable Definitions *****************************/
 
@@ -102,7 +108,7 @@ void XTmrCtr_CfgInitialize(XTmrCtr *InstancePtr, XTmrCtr_Config *ConfigPtr,
 	/* Verify arguments. */
 	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(ConfigPtr != NULL);
-	Xil_AssertVoid(EffectiveAddr != 0x0);
+	Xil_AssertVoid((EffectiveAddr != 0x0) || (ConfigPtr->SoftOps != NULL));
 
 	InstancePtr->IsReady = 0;
 	InstancePtr->Config = *ConfigPtr;
@@ -149,6 +155,15 @@ int XTmrCtr_InitHw(XTmrCtr *InstancePtr)
 			continue;
 		}
 
+		if (XTmrCtr_IsSoft(InstancePtr)) {
+			InstancePtr->Config.SoftOps->Cancel(
+					InstancePtr->Config.SoftRef, TmrIndex);
+			memset(&InstancePtr->Soft[TmrIndex], 0,
+			       sizeof(XTmrCtr_SoftCounter));
+			Status = XST_SUCCESS;
+			continue;
+		}
+
 		/* Set the compare register to 0. */
 		XTmrCtr_WriteReg(InstancePtr->BaseAddress, TmrIndex,
 				  XTC_TLR_OFFSET, 0);
@@ -244,6 +259,17 @@ void XTmrCtr_Start(XTmrCtr * InstancePtr, u8 TmrCtrNumber)
 	Xil_AssertVoid(TmrCtrNumber < XTC_DEVICE_TIMER_COUNT);
 	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	if (XTmrCtr_IsSoft(InstancePtr)) {
+		if (TmrCtrNumber == 0) {
+			InstancePtr->IsStartedTmrCtr0 = XIL_COMPONENT_IS_STARTED;
+		} else {
+			InstancePtr->IsStartedTmrCtr1 = XIL_COMPONENT_IS_STARTED;
+		}
+		InstancePtr->Soft[TmrCtrNumber].IsRunning = TRUE;
+		XTmrCtr_SoftLoad(InstancePtr, TmrCtrNumber);
+		return;
+	}
+
 	/*
 	 * Read the current register contents such that only the necessary bits
 	 * of the register are modified in the following operations
@@ -309,6 +335,29 @@ void XTmrCtr_Stop(XTmrCtr * InstancePtr, u8 TmrCtrNumber)
 	Xil_AssertVoid(TmrCtrNumber < XTC_DEVICE_TIMER_COUNT);
 	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	if (XTmrCtr_IsSoft(InstancePtr)) {
+		XTmrCtr_SoftCounter *CounterPtr =
+					&InstancePtr->Soft[TmrCtrNumber];
+		u64 NowNs;
+
+		if (CounterPtr->IsRunning) {
+			/* Freeze the counter value and the expired state */
+			NowNs = XTmrCtr_SoftGetTimeNs(InstancePtr);
+			CounterPtr->Value = XTmrCtr_SoftGetValue(InstancePtr,
+							TmrCtrNumber, NowNs);
+			CounterPtr->IsExpired = (NowNs >= CounterPtr->ExpiresNs);
+			CounterPtr->IsRunning = FALSE;
+		}
+		XTmrCtr_SoftArm(InstancePtr, TmrCtrNumber);
+
+		if (TmrCtrNumber == 0) {
+			InstancePtr->IsStartedTmrCtr0 = 0;
+		} else {
+			InstancePtr->IsStartedTmrCtr1 = 0;
+		}
+		return;
+	}
+
 	/*
 	 * Read the current register contents
 	 */
@@ -360,6 +409,11 @@ u32 XTmrCtr_GetValue(XTmrCtr * InstancePtr, u8 TmrCtrNumber)
 	Xil_AssertNonvoid(TmrCtrNumber < XTC_DEVICE_TIMER_COUNT);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	if (XTmrCtr_IsSoft(InstancePtr)) {
+		return XTmrCtr_SoftGetValue(InstancePtr, TmrCtrNumber,
+				XTmrCtr_SoftGetTimeNs(InstancePtr));
+	}
+
 	return XTmrCtr_ReadReg(InstancePtr->BaseAddress,
 				  TmrCtrNumber, XTC_TCR_OFFSET);
 }
@@ -392,6 +446,11 @@ void XTmrCtr_SetResetValue(XTmrCtr * InstancePtr, u8 TmrCtrNumber,
 	Xil_AssertVoid(TmrCtrNumber < XTC_DEVICE_TIMER_COUNT);
 	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	if (XTmrCtr_IsSoft(InstancePtr)) {
+		InstancePtr->Soft[TmrCtrNumber].ResetValue = ResetValue;
+		return;
+	}
+
 	XTmrCtr_WriteReg(InstancePtr->BaseAddress, TmrCtrNumber,
 			  XTC_TLR_OFFSET, ResetValue);
 }
@@ -420,6 +479,10 @@ u32 XTmrCtr_GetCaptureValue(XTmrCtr * InstancePtr, u8 TmrCtrNumber)
 	Xil_AssertNonvoid(TmrCtrNumber < XTC_DEVICE_TIMER_COUNT);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	if (XTmrCtr_IsSoft(InstancePtr)) {
+		return InstancePtr->Soft[TmrCtrNumber].ResetValue;
+	}
+
 	return XTmrCtr_ReadReg(InstancePtr->BaseAddress,
 				  TmrCtrNumber, XTC_TLR_OFFSET);
 }
@@ -449,6 +512,11 @@ void XTmrCtr_Reset(XTmrCtr * InstancePtr, u8 TmrCtrNumber)
 	Xil_AssertVoid(TmrCtrNumber < XTC_DEVICE_TIMER_COUNT);
 	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	if (XTmrCtr_IsSoft(InstancePtr)) {
+		XTmrCtr_SoftLoad(InstancePtr, TmrCtrNumber);
+		return;
+	}
+
 	/*
 	 * Read current contents of the register so it won't be destroyed
 	 */
@@ -494,6 +562,17 @@ int XTmrCtr_IsExpired(XTmrCtr * InstancePtr, u8 TmrCtrNumber)
 	Xil_AssertNonvoid(TmrCtrNumber < XTC_DEVICE_TIMER_COUNT);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	if (XTmrCtr_IsSoft(InstancePtr)) {
+		XTmrCtr_SoftCounter *CounterPtr =
+					&InstancePtr->Soft[TmrCtrNumber];
+
+		if (CounterPtr->IsRunning) {
+			return (XTmrCtr_SoftGetTimeNs(InstancePtr) >=
+				CounterPtr->ExpiresNs);
+		}
+		return CounterPtr->IsExpired;
+	}
+
 	/*
 	 * Check if timer is expired
 	 */
@@ -529,6 +608,7 @@ u8 XTmrCtr_PwmConfigure(XTmrCtr *InstancePtr, u32 PwmPeriod, u32 PwmHighTime)
 
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(!XTmrCtr_IsSoft(InstancePtr));
 
 	/* Stop the timers if they are running */
 	if (InstancePtr->IsStartedTmrCtr0 == XIL_COMPONENT_IS_STARTED) {
@@ -606,6 +686,7 @@ void XTmrCtr_PwmEnable(XTmrCtr *InstancePtr)
 	u32 CounterControlReg;
 
 	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(!XTmrCtr_IsSoft(InstancePtr));
 
 	/* PWM already running */
 	if (InstancePtr->IsPwmEnabled) {
@@ -660,6 +741,7 @@ void XTmrCtr_PwmDisable(XTmrCtr *InstancePtr)
 	u32 CounterControlReg;
 
 	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(!XTmrCtr_IsSoft(InstancePtr));
 
 	/* PWM already disabled */
 	if (!InstancePtr->IsPwmEnabled) {
@@ -692,6 +774,204 @@ void XTmrCtr_PwmDisable(XTmrCtr *InstancePtr)
 	InstancePtr->IsPwmEnabled = FALSE;
 }
 
+/*****************************************************************************/
+/**
+*
+* Sleeps until the specified timer counter expires, using the delay operation
+* of the software timer backend. It returns immediately for an AXI timer, for
+* a counter that is not running or when the backend has no delay operation,
+* so a caller polling XTmrCtr_IsExpired after this call only spins if the
+* sleep returned early.
+*
+* @param	InstancePtr is a pointer to the XTmrCtr instance.
+* @param	TmrCtrNumber is the timer counter of the device to operate on.
+*		Each device may contain multiple timer counters. The timer
+*		number is a zero based number  with a range of
+*		0 - (XTC_DEVICE_TIMER_COUNT - 1).
+*
+* @return	None.
+*
+* @note		The caller must be allowed to sleep.
+*
+******************************************************************************/
+void XTmrCtr_SoftWait(XTmrCtr *InstancePtr, u8 TmrCtrNumber)
+{
+	XTmrCtr_SoftCounter *CounterPtr;
+	u64 NowNs;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(TmrCtrNumber < XTC_DEVICE_TIMER_COUNT);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (!XTmrCtr_IsSoft(InstancePtr) ||
+	    (InstancePtr->Config.SoftOps->Delay == NULL)) {
+		return;
+	}
+
+	CounterPtr = &InstancePtr->Soft[TmrCtrNumber];
+	if (!CounterPtr->IsRunning) {
+		return;
+	}
+
+	NowNs = XTmrCtr_SoftGetTimeNs(InstancePtr);
+	if (NowNs < CounterPtr->ExpiresNs) {
+		InstancePtr->Config.SoftOps->Delay(InstancePtr->Config.SoftRef,
+						   CounterPtr->ExpiresNs - NowNs);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns the number of counter ticks from the load value to the roll over
+* (up counting) or roll under (down counting) of a software timer counter.
+*
+* @param	CounterPtr is a pointer to the software counter state.
+*
+* @return	The number of ticks, 1 to 2^32.
+*
+* @note		None.
+*
+******************************************************************************/
+static u64 XTmrCtr_SoftTerminalTicks(XTmrCtr_SoftCounter *CounterPtr)
+{
+	if (CounterPtr->Options & XTC_DOWN_COUNT_OPTION) {
+		return (u64)CounterPtr->LoadValue + 1;
+	}
+
+	return 0x100000000ULL - CounterPtr->LoadValue;
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns the time from the load of a software timer counter to its roll
+* over/under, rounded up to the next nanosecond.
+*
+* @param	InstancePtr is a pointer to the XTmrCtr instance.
+* @param	TmrCtrNumber is the timer counter of the device to operate on.
+*
+* @return	The period in nanoseconds.
+*
+* @note		None.
+*
+******************************************************************************/
+u64 XTmrCtr_SoftPeriodNs(XTmrCtr *InstancePtr, u8 TmrCtrNumber)
+{
+	u32 FreqHz = InstancePtr->Config.SysClockFreqHz;
+	u64 Ticks = XTmrCtr_SoftTerminalTicks(&InstancePtr->Soft[TmrCtrNumber]);
+
+	/* Ticks <= 2^32, the product fits in 64 bits */
+	return div_u64(Ticks * 1000000000ULL + FreqHz - 1, FreqHz);
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns the value of a software timer counter at the given time. A single
+* shot counter holds at its terminal count, an auto reload counter wraps to
+* its load value.
+*
+* @param	InstancePtr is a pointer to the XTmrCtr instance.
+* @param	TmrCtrNumber is the timer counter of the device to operate on.
+* @param	NowNs is the current time of the backend.
+*
+* @return	The counter value.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XTmrCtr_SoftGetValue(XTmrCtr *InstancePtr, u8 TmrCtrNumber, u64 NowNs)
+{
+	XTmrCtr_SoftCounter *CounterPtr = &InstancePtr->Soft[TmrCtrNumber];
+	u32 FreqHz = InstancePtr->Config.SysClockFreqHz;
+	u64 Terminal;
+	u64 Ticks;
+	u32 RemNs;
+
+	if (!CounterPtr->IsRunning) {
+		return CounterPtr->Value;
+	}
+
+	/* Split in seconds to keep the products within 64 bits */
+	Ticks = div_u64_rem(NowNs - CounterPtr->LoadNs, 1000000000, &RemNs);
+	Ticks = (Ticks * FreqHz) + div_u64((u64)RemNs * FreqHz, 1000000000);
+
+	Terminal = XTmrCtr_SoftTerminalTicks(CounterPtr);
+	if (Ticks >= Terminal) {
+		if (CounterPtr->Options & XTC_AUTO_RELOAD_OPTION) {
+			div64_u64_rem(Ticks, Terminal, &Ticks);
+		} else {
+			Ticks = Terminal - 1;
+		}
+	}
+
+	if (CounterPtr->Options & XTC_DOWN_COUNT_OPTION) {
+		return CounterPtr->LoadValue - (u32)Ticks;
+	}
+
+	return CounterPtr->LoadValue + (u32)Ticks;
+}
+
+/*****************************************************************************/
+/**
+*
+* Arms the expiration event of a running software timer counter in interrupt
+* mode, or cancels it otherwise.
+*
+* @param	InstancePtr is a pointer to the XTmrCtr instance.
+* @param	TmrCtrNumber is the timer counter of the device to operate on.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XTmrCtr_SoftArm(XTmrCtr *InstancePtr, u8 TmrCtrNumber)
+{
+	XTmrCtr_SoftCounter *CounterPtr = &InstancePtr->Soft[TmrCtrNumber];
+	const XTmrCtr_SoftOps *OpsPtr = InstancePtr->Config.SoftOps;
+
+	if (CounterPtr->IsRunning &&
+	    (CounterPtr->Options & XTC_INT_MODE_OPTION)) {
+		OpsPtr->Arm(InstancePtr->Config.SoftRef, InstancePtr,
+			    TmrCtrNumber, CounterPtr->ExpiresNs);
+	} else {
+		OpsPtr->Cancel(InstancePtr->Config.SoftRef, TmrCtrNumber);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Loads a software timer counter with its reset value, which restarts the
+* period of a running counter and clears its expired state.
+*
+* @param	InstancePtr is a pointer to the XTmrCtr instance.
+* @param	TmrCtrNumber is the timer counter of the device to operate on.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XTmrCtr_SoftLoad(XTmrCtr *InstancePtr, u8 TmrCtrNumber)
+{
+	XTmrCtr_SoftCounter *CounterPtr = &InstancePtr->Soft[TmrCtrNumber];
+
+	CounterPtr->LoadValue = CounterPtr->ResetValue;
+	CounterPtr->Value = CounterPtr->ResetValue;
+	CounterPtr->IsExpired = FALSE;
+	CounterPtr->StartCount++;
+
+	if (CounterPtr->IsRunning) {
+		CounterPtr->LoadNs = XTmrCtr_SoftGetTimeNs(InstancePtr);
+		CounterPtr->ExpiresNs = CounterPtr->LoadNs +
+				XTmrCtr_SoftPeriodNs(InstancePtr, TmrCtrNumber);
+		XTmrCtr_SoftArm(InstancePtr, TmrCtrNumber);
+	}
+}
+
 /*****************************************************************************/
 /**
 * Default callback for the driver does nothing. It matches the signature of the
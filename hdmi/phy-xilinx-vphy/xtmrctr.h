@@ -92,6 +92,21 @@
 * or thread mutual exclusion, virtual memory, or cache control must be
 * satisfied by the layer above this driver.
 *
+* <b>Software timer</b>
+*
+* A timer counter instance whose configuration carries a software backend
+* (XTmrCtr_Config.SoftOps) does not access any register. The counters are
+* emulated from the time base of the backend, using SysClockFreqHz as the
+* tick rate, so the values returned by XTmrCtr_GetValue are the same as for
+* the AXI timer. Instead of raising an interrupt, the backend arms an
+* expiration event for each counter that is started in interrupt mode and
+* calls XTmrCtr_InterruptHandler once the event has passed, in the context
+* where the interrupt handler would run otherwise. Busy waiting callers can
+* use XTmrCtr_SoftWait to sleep until a counter expires. The backend can be
+* built on an operating system timer or on a virtual time base of a test
+* harness. Capture mode, cascade mode, the external compare output and PWM
+* are not available in this mode.
+*
 * <pre>
 * MODIFICATION HISTORY:
 *
@@ -153,6 +168,8 @@
 *                     compilation time.
 * 4.8   dp   02/12/21 Fix compilation errors that arise when -Werror=conversion
 *                     is enabled in compilation flags.
+* 4.9   XLNX 10/18/26 Added the software timer mode, selected per instance by
+*                     XTmrCtr_Config.SoftOps, and XTmrCtr_SoftWait.
 * </pre>
 *
 ******************************************************************************/
@@ -218,6 +235,25 @@ extern "C" {
 
 /**************************** Type Definitions *******************************/
 
+/**
+ * This typedef contains the operations of a software timer backend.
+ */
+typedef struct {
+	/** Returns the current time in nanoseconds. */
+	u64 (*GetTimeNs)(void *SoftRef);
+	/**
+	 * Arms the expiration event of a timer counter, replacing the event
+	 * armed before. Once ExpiresNs has passed, the backend calls
+	 * XTmrCtr_InterruptHandler(InstancePtr).
+	 */
+	void (*Arm)(void *SoftRef, void *InstancePtr, u8 TmrCtrNumber,
+		    u64 ExpiresNs);
+	/** Cancels the expiration event of a timer counter. */
+	void (*Cancel)(void *SoftRef, u8 TmrCtrNumber);
+	/** Sleeps for DelayNs nanoseconds, optional. */
+	void (*Delay)(void *SoftRef, u64 DelayNs);
+} XTmrCtr_SoftOps;
+
 /**
  * This typedef contains configuration information for the device.
  */
@@ -225,6 +261,9 @@ typedef struct {
 	u16 DeviceId;		/**< Unique ID  of device */
 	UINTPTR BaseAddress;	/**< Register base address */
 	u32 SysClockFreqHz;	/**< The AXI bus clock frequency */
+	const XTmrCtr_SoftOps *SoftOps; /**< Software timer backend, NULL
+					     for the AXI timer */
+	void *SoftRef;		/**< Passed to the backend operations */
 } XTmrCtr_Config;
 
 /**
@@ -249,6 +288,21 @@ typedef struct {
 	u32 Interrupts;	 /**< The number of interrupts that have occurred */
 } XTmrCtrStats;
 
+/**
+ * Timer counter state in the software timer mode
+ */
+typedef struct {
+	u32 ResetValue;	/**< Load register */
+	u32 LoadValue;	/**< Value loaded at the last start or reset */
+	u32 Options;	/**< Options set by XTmrCtr_SetOptions */
+	u32 Value;	/**< Counter value while stopped */
+	u32 StartCount;	/**< Number of starts and resets */
+	u64 LoadNs;	/**< Time of the last start or reset */
+	u64 ExpiresNs;	/**< Time of the next roll over/under */
+	u8 IsRunning;	/**< Counter is enabled */
+	u8 IsExpired;	/**< Rolled over/under before it was stopped */
+} XTmrCtr_SoftCounter;
+
 /**
  * The XTmrCtr driver instance data. The user is required to allocate a
  * variable of this type for every timer/counter device in the system. A
@@ -266,11 +320,31 @@ typedef struct {
 
 	XTmrCtr_Handler Handler; /**< Callback function */
 	void *CallBackRef;	 /**< Callback reference for handler */
+
+	/** Counter state in the software timer mode */
+	XTmrCtr_SoftCounter Soft[XTC_DEVICE_TIMER_COUNT];
 } XTmrCtr;
 
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
+/*****************************************************************************/
+/**
+*
+* This macro returns whether the instance runs in the software timer mode.
+*
+* @param	InstancePtr is a pointer to the XTmrCtr instance.
+*
+* @return	TRUE if the counters are emulated by a software backend,
+*		FALSE if they are the registers of an AXI timer.
+*
+* @note		C-Style signature:
+*		u8 XTmrCtr_IsSoft(XTmrCtr *InstancePtr)
+*
+******************************************************************************/
+#define XTmrCtr_IsSoft(InstancePtr) \
+	((InstancePtr)->Config.SoftOps != NULL)
+
 
 /************************** Function Prototypes ******************************/
 
@@ -290,6 +364,7 @@ void XTmrCtr_Reset(XTmrCtr * InstancePtr, u8 TmrCtrNumber);
 u8 XTmrCtr_PwmConfigure(XTmrCtr *InstancePtr, u32 PwmPeriod, u32 PwmHighTime);
 void XTmrCtr_PwmEnable(XTmrCtr *InstancePtr);
 void XTmrCtr_PwmDisable(XTmrCtr *InstancePtr);
+void XTmrCtr_SoftWait(XTmrCtr *InstancePtr, u8 TmrCtrNumber);
 
 /* Lookup configuration in xtmrctr_sinit.c */
 XTmrCtr_Config *XTmrCtr_LookupConfig(u16 DeviceId);
@@ -0,0 +1,290 @@
+/******************************************************************************
+*
+ *
+ * Copyright (C) 2015, 2016, 2017 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xtmrctr_hrtimer.c
+* @{
+* @details
+*
+* This file contains the Linux hrtimer backend of the XTmrCtr software timer
+* mode. See xtmrctr_hrtimer.h for the usage.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ------ -------- --------------------------------------------------
+* 1.00  XLNX   10/18/26 Initial release.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <linux/delay.h>
+#include <linux/kernel.h>
+#include <linux/ktime.h>
+#include <linux/math64.h>
+#include <linux/version.h>
+#include "xtmrctr_hrtimer.h"
+
+/************************** Constant Definitions *****************************/
+
+/** Delays from this length on use msleep instead of usleep_range. */
+#define XTMRCTR_HRTIMER_MSLEEP_US 20000
+
+/************************** Function Prototypes ******************************/
+
+static u64 XTmrCtr_HrTimerGetTimeNs(void *SoftRef);
+static void XTmrCtr_HrTimerArm(void *SoftRef, void *TmrCtrPtr,
+		u8 TmrCtrNumber, u64 ExpiresNs);
+static void XTmrCtr_HrTimerCancel(void *SoftRef, u8 TmrCtrNumber);
+static void XTmrCtr_HrTimerDelay(void *SoftRef, u64 DelayNs);
+static enum hrtimer_restart XTmrCtr_HrTimerExpired(struct hrtimer *Timer);
+static void XTmrCtr_HrTimerWork(struct work_struct *Work);
+
+/************************** Variable Definitions *****************************/
+
+static const XTmrCtr_SoftOps XTmrCtr_HrTimerOps = {
+	.GetTimeNs = XTmrCtr_HrTimerGetTimeNs,
+	.Arm = XTmrCtr_HrTimerArm,
+	.Cancel = XTmrCtr_HrTimerCancel,
+	.Delay = XTmrCtr_HrTimerDelay,
+};
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function initializes the hrtimer backend and selects it in a timer
+* configuration, so the timer instance initialized from that configuration
+* runs in the software timer mode.
+*
+* @param  InstancePtr is a pointer to the backend instance.
+* @param  ConfigPtr is a pointer to the timer configuration.
+* @param  Service is called from a work item after an expiration.
+* @param  ServiceRef is passed to Service.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+void XTmrCtr_HrTimerInitialize(XTmrCtr_HrTimer *InstancePtr,
+		XTmrCtr_Config *ConfigPtr, XTmrCtr_HrTimerService Service,
+		void *ServiceRef)
+{
+	u8 Index;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(ConfigPtr != NULL);
+	Xil_AssertVoid(Service != NULL);
+
+	InstancePtr->TmrCtrPtr = NULL;
+	InstancePtr->Service = Service;
+	InstancePtr->ServiceRef = ServiceRef;
+	InstancePtr->IsReleased = FALSE;
+	INIT_WORK(&InstancePtr->Work, XTmrCtr_HrTimerWork);
+
+	for (Index = 0; Index < XTC_DEVICE_TIMER_COUNT; Index++) {
+		InstancePtr->Counter[Index].HrTimerPtr = InstancePtr;
+#if (LINUX_VERSION_CODE < KERNEL_VERSION(6, 13, 0))
+		hrtimer_init(&InstancePtr->Counter[Index].Timer,
+			     CLOCK_MONOTONIC, HRTIMER_MODE_ABS);
+		InstancePtr->Counter[Index].Timer.function =
+			XTmrCtr_HrTimerExpired;
+#else
+		hrtimer_setup(&InstancePtr->Counter[Index].Timer,
+			      XTmrCtr_HrTimerExpired, CLOCK_MONOTONIC,
+			      HRTIMER_MODE_ABS);
+#endif
+	}
+
+	ConfigPtr->SoftOps = &XTmrCtr_HrTimerOps;
+	ConfigPtr->SoftRef = InstancePtr;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function cancels the hrtimers and waits for a running service function
+* to complete. Expirations armed afterwards are ignored.
+*
+* @param  InstancePtr is a pointer to the backend instance.
+*
+* @return None.
+*
+* @note   Must not be called with the locks taken by the service function.
+*
+******************************************************************************/
+void XTmrCtr_HrTimerRelease(XTmrCtr_HrTimer *InstancePtr)
+{
+	u8 Index;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	WRITE_ONCE(InstancePtr->IsReleased, TRUE);
+	for (Index = 0; Index < XTC_DEVICE_TIMER_COUNT; Index++) {
+		hrtimer_cancel(&InstancePtr->Counter[Index].Timer);
+	}
+	cancel_work_sync(&InstancePtr->Work);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the time base of the backend, CLOCK_MONOTONIC.
+*
+* @param  SoftRef is a pointer to the backend instance.
+*
+* @return The current time in nanoseconds.
+*
+* @note   None.
+*
+******************************************************************************/
+static u64 XTmrCtr_HrTimerGetTimeNs(void *SoftRef)
+{
+	return ktime_get_ns();
+}
+
+/*****************************************************************************/
+/**
+*
+* This function arms the hrtimer of a timer counter.
+*
+* @param  SoftRef is a pointer to the backend instance.
+* @param  TmrCtrPtr is a pointer to the timer instance.
+* @param  TmrCtrNumber is the timer counter.
+* @param  ExpiresNs is the absolute expiration time.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XTmrCtr_HrTimerArm(void *SoftRef, void *TmrCtrPtr,
+		u8 TmrCtrNumber, u64 ExpiresNs)
+{
+	XTmrCtr_HrTimer *InstancePtr = (XTmrCtr_HrTimer *)SoftRef;
+
+	if (READ_ONCE(InstancePtr->IsReleased)) {
+		return;
+	}
+
+	InstancePtr->TmrCtrPtr = (XTmrCtr *)TmrCtrPtr;
+	hrtimer_start(&InstancePtr->Counter[TmrCtrNumber].Timer,
+		      ns_to_ktime(ExpiresNs), HRTIMER_MODE_ABS);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function cancels the hrtimer of a timer counter. It does not wait for
+* a running expiration, the service function tolerates a late call.
+*
+* @param  SoftRef is a pointer to the backend instance.
+* @param  TmrCtrNumber is the timer counter.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XTmrCtr_HrTimerCancel(void *SoftRef, u8 TmrCtrNumber)
+{
+	XTmrCtr_HrTimer *InstancePtr = (XTmrCtr_HrTimer *)SoftRef;
+
+	hrtimer_try_to_cancel(&InstancePtr->Counter[TmrCtrNumber].Timer);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sleeps instead of spinning on a timer counter.
+*
+* @param  SoftRef is a pointer to the backend instance.
+* @param  DelayNs is the delay in nanoseconds.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XTmrCtr_HrTimerDelay(void *SoftRef, u64 DelayNs)
+{
+	u64 DelayUs = div_u64(DelayNs + 999, 1000);
+
+	if (DelayUs < XTMRCTR_HRTIMER_MSLEEP_US) {
+		usleep_range((unsigned long)DelayUs,
+			     (unsigned long)DelayUs + 50);
+	} else {
+		msleep((unsigned int)div_u64(DelayUs + 999, 1000));
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the hrtimer callback, it runs in hard interrupt context
+* and defers to the work item.
+*
+* @param  Timer is the expired hrtimer.
+*
+* @return HRTIMER_NORESTART, the next expiration is armed by the timer
+*         instance.
+*
+* @note   None.
+*
+******************************************************************************/
+static enum hrtimer_restart XTmrCtr_HrTimerExpired(struct hrtimer *Timer)
+{
+	XTmrCtr_HrTimerCounter *CounterPtr =
+		container_of(Timer, XTmrCtr_HrTimerCounter, Timer);
+	XTmrCtr_HrTimer *InstancePtr = (XTmrCtr_HrTimer *)CounterPtr->HrTimerPtr;
+
+	if (!READ_ONCE(InstancePtr->IsReleased)) {
+		schedule_work(&InstancePtr->Work);
+	}
+
+	return HRTIMER_NORESTART;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs the service function of the driver. Both timer counters
+* share the work item, XTmrCtr_InterruptHandler services every counter whose
+* expiration time has passed.
+*
+* @param  Work is the work item of the backend instance.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XTmrCtr_HrTimerWork(struct work_struct *Work)
+{
+	XTmrCtr_HrTimer *InstancePtr = container_of(Work, XTmrCtr_HrTimer, Work);
+
+	if (InstancePtr->TmrCtrPtr != NULL) {
+		InstancePtr->Service(InstancePtr->ServiceRef,
+				     InstancePtr->TmrCtrPtr);
+	}
+}
+
+/** @} */
@@ -0,0 +1,106 @@
+/******************************************************************************
+*
+ *
+ * Copyright (C) 2015, 2016, 2017 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xtmrctr_hrtimer.h
+* @{
+* @details
+*
+* This is the header file of the Linux hrtimer backend of the XTmrCtr
+* software timer mode. It replaces an AXI timer instance by two hrtimers on
+* CLOCK_MONOTONIC, one per timer counter, so the timer IP and its interrupt
+* are not needed.
+*
+* The hrtimers expire in hard interrupt context, where the timer callbacks of
+* the HDCP drivers cannot run. On expiration the backend schedules a work
+* item that calls the service function of the driver, which takes the locks
+* the timer interrupt thread would take and calls XTmrCtr_InterruptHandler,
+* e.g. through XV_HdmiTxSS_Hdcp22TimerIntrHandler. Delays sleep.
+*
+* <b>Software Initialization and Configuration</b>
+*
+* - Call XTmrCtr_HrTimerInitialize on the configuration table entry of the
+*   timer before the timer instance is initialized from it.
+* - Call XTmrCtr_HrTimerRelease before the timer instance is freed, without
+*   holding the locks taken by the service function.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ------ -------- --------------------------------------------------
+* 1.00  XLNX   10/18/26 Initial release.
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XTMRCTR_HRTIMER_H
+/**  prevent circular inclusions by using protection macros */
+#define XTMRCTR_HRTIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include <linux/hrtimer.h>
+#include <linux/workqueue.h>
+#include "xil_types.h"
+#include "xtmrctr.h"
+
+/**************************** Type Definitions *******************************/
+
+/**
+* Service function, called from a work item after an expiration with the
+* timer instance to pass to XTmrCtr_InterruptHandler.
+*/
+typedef void (*XTmrCtr_HrTimerService)(void *ServiceRef, XTmrCtr *TmrCtrPtr);
+
+/**
+* This typedef contains the hrtimer of one timer counter.
+*/
+typedef struct {
+	struct hrtimer Timer;       /**< Expiration event */
+	void *HrTimerPtr;           /**< Owning XTmrCtr_HrTimer */
+} XTmrCtr_HrTimerCounter;
+
+/**
+* The hrtimer backend instance data, one per timer instance.
+*/
+typedef struct {
+	XTmrCtr_HrTimerCounter Counter[XTC_DEVICE_TIMER_COUNT];
+	struct work_struct Work;    /**< Runs the service function */
+	XTmrCtr *TmrCtrPtr;         /**< Timer instance, set when armed */
+	XTmrCtr_HrTimerService Service;
+	void *ServiceRef;
+	u8 IsReleased;              /**< No further events are armed */
+} XTmrCtr_HrTimer;
+
+/************************** Function Prototypes ******************************/
+
+void XTmrCtr_HrTimerInitialize(XTmrCtr_HrTimer *InstancePtr,
+		XTmrCtr_Config *ConfigPtr, XTmrCtr_HrTimerService Service,
+		void *ServiceRef);
+void XTmrCtr_HrTimerRelease(XTmrCtr_HrTimer *InstancePtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* End of protection macro */
+
+/** @} */
@@ -30,6 +30,7 @@
 * 1.00b jhl  02/06/02 First release
 * 1.10b mta  03/21/07 Updated to new coding style
 * 2.00a ktn  10/30/09 _m is removed from all the macro definitions.
+* 4.9   XLNX 10/18/26 Added the software timer mode helpers.
 * </pre>
 *
 ******************************************************************************/
@@ -44,12 +45,24 @@ extern "C" {
 /***************************** Include Files *********************************/
 
 #include "xil_types.h"
+#include "xtmrctr.h"
 
 /************************** Constant Definitions *****************************/
 
 
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/* Current time of the software timer backend in nanoseconds */
+#define XTmrCtr_SoftGetTimeNs(InstancePtr) \
+	((InstancePtr)->Config.SoftOps->GetTimeNs((InstancePtr)->Config.SoftRef))
+
 /************************** Function Prototypes ******************************/
 
+/* Software timer mode, in file xtmrctr.c */
+u32 XTmrCtr_SoftGetValue(XTmrCtr *InstancePtr, u8 TmrCtrNumber, u64 NowNs);
+u64 XTmrCtr_SoftPeriodNs(XTmrCtr *InstancePtr, u8 TmrCtrNumber);
+void XTmrCtr_SoftArm(XTmrCtr *InstancePtr, u8 TmrCtrNumber);
+
 
 /************************** Variable Definitions *****************************/
 
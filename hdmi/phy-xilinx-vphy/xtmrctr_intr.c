@@ -34,13 +34,17 @@
 *		      processing for CR 584557.
 * 4.8   dp   02/12/21 Fix compilation errors that arise when -Werror=conversion
 *                     is enabled in compilation flags.
+* 4.9   XLNX 10/18/26 Added the software timer mode to
+*                     XTmrCtr_InterruptHandler.
 * </pre>
 *
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
 
+#include <linux/math64.h>
 #include "xtmrctr.h"
+#include "xtmrctr_i.h"
 #include "xil_printf.h"
 
 /************************** Constant Definitions *****************************/
@@ -54,6 +58,7 @@
 
 /************************** Function Prototypes ******************************/
 
+static void XTmrCtr_SoftInterruptHandler(XTmrCtr *TmrCtrPtr);
 
 /************************** Variable Definitions *****************************/
 
@@ -101,7 +106,9 @@ void XTmrCtr_SetHandler(XTmrCtr * InstancePtr, XTmrCtr_Handler FuncPtr,
 *
 * @return	None.
 *
-* @note		None.
+* @note		In the software timer mode, the backend calls this function
+*		when an expiration event has passed. Calling it at any other
+*		time is harmless.
 *
 ******************************************************************************/
 void XTmrCtr_InterruptHandler(void *InstancePtr)
@@ -121,6 +128,11 @@ void XTmrCtr_InterruptHandler(void *InstancePtr)
 	 */
 	TmrCtrPtr = (XTmrCtr *) InstancePtr;
 
+	if (XTmrCtr_IsSoft(TmrCtrPtr)) {
+		XTmrCtr_SoftInterruptHandler(TmrCtrPtr);
+		return;
+	}
+
 	/*
 	 * Loop thru each timer counter in the device and call the callback
 	 * function for each timer which has caused an interrupt
@@ -216,4 +228,71 @@ void XTmrCtr_InterruptHandler(void *InstancePtr)
 //		}
 	} //for
 }
+
+/*****************************************************************************/
+/**
+*
+* Interrupt processing in the software timer mode. Calls the callback for each
+* running timer counter in interrupt mode whose roll over/under time has
+* passed, then reloads an auto reload counter or stops a single shot counter,
+* unless the callback restarted or stopped it.
+*
+* @param	TmrCtrPtr contains a pointer to the timer/counter instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XTmrCtr_SoftInterruptHandler(XTmrCtr *TmrCtrPtr)
+{
+	XTmrCtr_SoftCounter *CounterPtr;
+	u8 TmrCtrNumber;
+	u32 StartCount;
+	u64 PeriodNs;
+	u64 NowNs;
+
+	for (TmrCtrNumber = 0;
+		TmrCtrNumber < XTC_DEVICE_TIMER_COUNT; TmrCtrNumber++) {
+		CounterPtr = &TmrCtrPtr->Soft[TmrCtrNumber];
+
+		if (!CounterPtr->IsRunning ||
+		    !(CounterPtr->Options & XTC_INT_MODE_OPTION)) {
+			continue;
+		}
+
+		NowNs = XTmrCtr_SoftGetTimeNs(TmrCtrPtr);
+		if (NowNs < CounterPtr->ExpiresNs) {
+			continue;
+		}
+
+		StartCount = CounterPtr->StartCount;
+		TmrCtrPtr->Stats.Interrupts++;
+		TmrCtrPtr->Handler(TmrCtrPtr->CallBackRef, TmrCtrNumber);
+
+		/* Restarted or stopped by the callback */
+		if (!CounterPtr->IsRunning ||
+		    (CounterPtr->StartCount != StartCount)) {
+			continue;
+		}
+
+		if (CounterPtr->Options & XTC_AUTO_RELOAD_OPTION) {
+			/* Skip the periods that passed meanwhile */
+			PeriodNs = XTmrCtr_SoftPeriodNs(TmrCtrPtr, TmrCtrNumber);
+			NowNs = XTmrCtr_SoftGetTimeNs(TmrCtrPtr);
+			CounterPtr->ExpiresNs += PeriodNs *
+				(div64_u64(NowNs - CounterPtr->ExpiresNs,
+					   PeriodNs) + 1);
+		} else {
+			/*
+			 * A single shot counter is disabled and reloaded, as
+			 * for the AXI timer, the interrupt is acknowledged
+			 */
+			CounterPtr->IsRunning = FALSE;
+			CounterPtr->IsExpired = FALSE;
+			CounterPtr->Value = CounterPtr->ResetValue;
+		}
+		XTmrCtr_SoftArm(TmrCtrPtr, TmrCtrNumber);
+	}
+}
 /** @} */
@@ -31,6 +31,7 @@
 * 2.00a ktn  10/30/09 Updated to use HAL API's. _m is removed from all the macro
 *		      definitions.
 * 2.04a sdm  07/12/11 Added support for the cascade mode operation.
+* 4.9   XLNX 10/18/26 Added the software timer mode.
 * </pre>
 *
 ******************************************************************************/
@@ -117,6 +118,12 @@ void XTmrCtr_SetOptions(XTmrCtr * InstancePtr, u8 TmrCtrNumber, u32 Options)
 	Xil_AssertVoid(TmrCtrNumber < XTC_DEVICE_TIMER_COUNT);
 	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	if (XTmrCtr_IsSoft(InstancePtr)) {
+		InstancePtr->Soft[TmrCtrNumber].Options = Options;
+		XTmrCtr_SoftArm(InstancePtr, TmrCtrNumber);
+		return;
+	}
+
 	/*
 	 * Loop through the Options table, turning the enable on or off
 	 * depending on whether the bit is set in the incoming Options flag.
@@ -176,6 +183,10 @@ u32 XTmrCtr_GetOptions(XTmrCtr * InstancePtr, u8 TmrCtrNumber)
 	Xil_AssertNonvoid(TmrCtrNumber < XTC_DEVICE_TIMER_COUNT);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	if (XTmrCtr_IsSoft(InstancePtr)) {
+		return InstancePtr->Soft[TmrCtrNumber].Options;
+	}
+
 	/*
 	 * Read the current contents of the control status register to allow
 	 * the current options to be determined
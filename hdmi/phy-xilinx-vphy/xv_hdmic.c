@@ -30,15 +30,72 @@
  * 1.0   EB  21/12/17 Initial release.
  * 1.1   EB  10/04/18 Fixed a bug in XV_HdmiC_ParseAudioInfoFrame
  * 1.2   EB  18/06/19 Added FrlRateTable
+ * 1.3   XLNX 10/18/26 Added XHdmiC_TMDS_GetAudSampRateHz, rounded the
+ *                     computed sample rate in XHdmiC_TMDS_GetAudSampFreq
+ * 1.4   XLNX 10/18/26 Table driven infoframe parsing and generation on the
+ *                     AUX words with a single pass checksum
  * </pre>
  *
 *******************************************************************************/
 
 /******************************* Include Files ********************************/
+#include <linux/stddef.h>
 #include "xv_hdmic.h"
 
 /************************** Constant Definitions ******************************/
 
+/** Number of 32-bit words of an AUX packet, header word included */
+#define XHDMIC_AUX_WORDS		9
+
+/** @name Byte numbering of the AUX words, byte 0 is bits 7:0 of word 0
+* @{
+*/
+#define XHDMIC_AUX_HB(n)		(n)		/**< Header.Byte[n] */
+#define XHDMIC_AUX_DB(n)		(4 + (n))	/**< Data.Byte[n] */
+/* @} */
+
+/** @name Directions of an infoframe field descriptor
+* @{
+*/
+#define XHDMIC_AUXFIELD_PARSE		0x1
+#define XHDMIC_AUXFIELD_GENERATE	0x2
+#define XHDMIC_AUXFIELD_BOTH		0x3
+/* @} */
+
+/**
+* Describes the bits (Value >> FieldShift) & Mask of a structure field that
+* are stored at bit BitShift of the packet byte Byte.
+*/
+#define XHDMIC_AUXFIELD(Type, Field, Byte, BitShift, Mask, FieldShift, Dir) \
+	{ offsetof(Type, Field), sizeof(((Type *)0)->Field), (Byte) >> 2, \
+	  (((Byte) & 0x3) << 3) + (BitShift), (Mask), (FieldShift), (Dir) }
+
+/****************************** Type Definitions ******************************/
+
+/**
+* This typedef describes one field of an infoframe structure, fields wider
+* than a byte use one descriptor per byte, the least significant one first.
+*/
+typedef struct {
+	u16 Offset;		/**< Offset of the field in the structure */
+	u8 Size;		/**< Size of the field, 1, 2 or 4 bytes */
+	u8 Word;		/**< AUX word, 0 is the header */
+	u8 Shift;		/**< Bit position in the AUX word */
+	u8 Mask;		/**< Mask of the bits in the packet */
+	u8 FieldShift;		/**< Bit position in the field */
+	u8 Dir;			/**< XHDMIC_AUXFIELD_PARSE and/or _GENERATE */
+} XHdmiC_AuxField;
+
+/**
+* This typedef describes the layout of an infoframe or packet type.
+*/
+typedef struct {
+	u32 Header;		/**< Constant header bytes, HB0 is the type */
+	u8 HasChecksum;		/**< PB0 is the infoframe checksum */
+	u8 NumFields;		/**< Number of field descriptors */
+	const XHdmiC_AuxField *Fields;	/**< Field descriptors */
+} XHdmiC_AuxFormat;
+
 /*****************************************************************************/
 /**
 * This table contains the attributes for various standard resolutions.
@@ -245,6 +302,232 @@ const XHdmiC_TMDS_N_Table TMDSChar_N_Table[] =
 	{594000000, { 3072, 9408,  6144, 18816, 12288, 37632, 24576}}
 };
 
+/**
+* These tables describe the fields of the infoframes and packets, in the
+* byte numbering of the AUX words. Data.Byte[7], [15], [23] and [31] hold
+* the ECC of the subpackets and are not used. Where parsing and generation
+* of a field differ, the field has a descriptor per direction.
+*/
+static const XHdmiC_AuxField AviIfFields[] = {
+	/* HB1, Version */
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, Version,
+			XHDMIC_AUX_HB(1), 0, 0xff, 0, XHDMIC_AUXFIELD_BOTH),
+	/* PB1 */
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, ColorSpace,
+			XHDMIC_AUX_DB(1), 5, 0x7, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, ActiveFormatDataPresent,
+			XHDMIC_AUX_DB(1), 4, 0x1, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, BarInfo,
+			XHDMIC_AUX_DB(1), 2, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, ScanInfo,
+			XHDMIC_AUX_DB(1), 0, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+	/* PB2 */
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, Colorimetry,
+			XHDMIC_AUX_DB(2), 6, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, PicAspectRatio,
+			XHDMIC_AUX_DB(2), 4, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, ActiveAspectRatio,
+			XHDMIC_AUX_DB(2), 0, 0xf, 0, XHDMIC_AUXFIELD_BOTH),
+	/* PB3 */
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, Itc,
+			XHDMIC_AUX_DB(3), 7, 0x1, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, ExtendedColorimetry,
+			XHDMIC_AUX_DB(3), 4, 0x7, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, QuantizationRange,
+			XHDMIC_AUX_DB(3), 2, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, NonUniformPictureScaling,
+			XHDMIC_AUX_DB(3), 0, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+	/* PB4 */
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, VIC,
+			XHDMIC_AUX_DB(4), 0, 0x7f, 0, XHDMIC_AUXFIELD_PARSE),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, VIC,
+			XHDMIC_AUX_DB(4), 0, 0xff, 0, XHDMIC_AUXFIELD_GENERATE),
+	/* PB5 */
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, YccQuantizationRange,
+			XHDMIC_AUX_DB(5), 6, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, ContentType,
+			XHDMIC_AUX_DB(5), 4, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, PixelRepetition,
+			XHDMIC_AUX_DB(5), 0, 0xf, 0, XHDMIC_AUXFIELD_BOTH),
+	/* PB6/7 */
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, TopBar,
+			XHDMIC_AUX_DB(6), 0, 0xff, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, TopBar,
+			XHDMIC_AUX_DB(8), 0, 0xff, 8, XHDMIC_AUXFIELD_BOTH),
+	/* PB8/9 */
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, BottomBar,
+			XHDMIC_AUX_DB(9), 0, 0xff, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, BottomBar,
+			XHDMIC_AUX_DB(10), 0, 0xff, 8, XHDMIC_AUXFIELD_BOTH),
+	/* PB10/11 */
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, LeftBar,
+			XHDMIC_AUX_DB(11), 0, 0xff, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, LeftBar,
+			XHDMIC_AUX_DB(12), 0, 0xff, 8, XHDMIC_AUXFIELD_BOTH),
+	/* PB12/13 */
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, RightBar,
+			XHDMIC_AUX_DB(13), 0, 0xff, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AVI_InfoFrame, RightBar,
+			XHDMIC_AUX_DB(14), 0, 0xff, 8, XHDMIC_AUXFIELD_BOTH),
+};
+
+static const XHdmiC_AuxField GcpFields[] = {
+	/* SB0 */
+	XHDMIC_AUXFIELD(XHdmiC_GeneralControlPacket, Clear_AVMUTE,
+			XHDMIC_AUX_DB(0), 4, 0x1, 0, XHDMIC_AUXFIELD_PARSE),
+	XHDMIC_AUXFIELD(XHdmiC_GeneralControlPacket, Set_AVMUTE,
+			XHDMIC_AUX_DB(0), 0, 0x1, 0, XHDMIC_AUXFIELD_PARSE),
+	/* SB1 */
+	XHDMIC_AUXFIELD(XHdmiC_GeneralControlPacket, PixelPackingPhase,
+			XHDMIC_AUX_DB(1), 4, 0xf, 0, XHDMIC_AUXFIELD_PARSE),
+	XHDMIC_AUXFIELD(XHdmiC_GeneralControlPacket, ColorDepth,
+			XHDMIC_AUX_DB(1), 0, 0xf, 0, XHDMIC_AUXFIELD_PARSE),
+	/* SB2 */
+	XHDMIC_AUXFIELD(XHdmiC_GeneralControlPacket, Default_Phase,
+			XHDMIC_AUX_DB(2), 0, 0x1, 0, XHDMIC_AUXFIELD_PARSE),
+};
+
+static const XHdmiC_AuxField AudioIfFields[] = {
+	/* HB1, Version, generated as 1 */
+	XHDMIC_AUXFIELD(XHdmiC_AudioInfoFrame, Version,
+			XHDMIC_AUX_HB(1), 0, 0xff, 0, XHDMIC_AUXFIELD_PARSE),
+	/* PB1 */
+	XHDMIC_AUXFIELD(XHdmiC_AudioInfoFrame, CodingType,
+			XHDMIC_AUX_DB(1), 4, 0xf, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AudioInfoFrame, ChannelCount,
+			XHDMIC_AUX_DB(1), 0, 0x7, 0, XHDMIC_AUXFIELD_BOTH),
+	/* PB2 */
+	XHDMIC_AUXFIELD(XHdmiC_AudioInfoFrame, SampleFrequency,
+			XHDMIC_AUX_DB(2), 2, 0x7, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AudioInfoFrame, SampleSize,
+			XHDMIC_AUX_DB(2), 0, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+	/* PB4 */
+	XHDMIC_AUXFIELD(XHdmiC_AudioInfoFrame, ChannelAllocation,
+			XHDMIC_AUX_DB(4), 0, 0xff, 0, XHDMIC_AUXFIELD_BOTH),
+	/* PB5 */
+	XHDMIC_AUXFIELD(XHdmiC_AudioInfoFrame, Downmix_Inhibit,
+			XHDMIC_AUX_DB(5), 7, 0x1, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AudioInfoFrame, LevelShiftVal,
+			XHDMIC_AUX_DB(5), 4, 0xf, 0, XHDMIC_AUXFIELD_PARSE),
+	XHDMIC_AUXFIELD(XHdmiC_AudioInfoFrame, LevelShiftVal,
+			XHDMIC_AUX_DB(5), 3, 0xf, 0, XHDMIC_AUXFIELD_GENERATE),
+	XHDMIC_AUXFIELD(XHdmiC_AudioInfoFrame, LFE_Playback_Level,
+			XHDMIC_AUX_DB(5), 0, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+};
+
+static const XHdmiC_AuxField AudioMetadataFields[] = {
+	/* HB1, 3D Audio */
+	XHDMIC_AUXFIELD(XHdmiC_AudioMetadata, Audio3D,
+			XHDMIC_AUX_HB(1), 0, 0x1, 0, XHDMIC_AUXFIELD_BOTH),
+	/* HB2 */
+	XHDMIC_AUXFIELD(XHdmiC_AudioMetadata, Num_Audio_Str,
+			XHDMIC_AUX_HB(2), 2, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(XHdmiC_AudioMetadata, Num_Views,
+			XHDMIC_AUX_HB(2), 0, 0x3, 0, XHDMIC_AUXFIELD_BOTH),
+	/* PB0 */
+	XHDMIC_AUXFIELD(XHdmiC_AudioMetadata, Audio3D_ChannelCount,
+			XHDMIC_AUX_DB(0), 0, 0x1f, 0, XHDMIC_AUXFIELD_BOTH),
+	/* PB1 */
+	XHDMIC_AUXFIELD(XHdmiC_AudioMetadata, ACAT,
+			XHDMIC_AUX_DB(1), 0, 0xf, 0, XHDMIC_AUXFIELD_BOTH),
+	/* PB2 */
+	XHDMIC_AUXFIELD(XHdmiC_AudioMetadata, Audio3D_ChannelAllocation,
+			XHDMIC_AUX_DB(2), 0, 0xff, 0, XHDMIC_AUXFIELD_BOTH),
+};
+
+/** Descriptor of an SPD infoframe character */
+#define XHDMIC_SPDIF_CHAR(Field, Byte) \
+	XHDMIC_AUXFIELD(XHdmiC_SPDInfoFrame, Field, XHDMIC_AUX_DB(Byte), \
+			0, 0xff, 0, XHDMIC_AUXFIELD_BOTH)
+
+static const XHdmiC_AuxField SpdIfFields[] = {
+	/* HB1, Version */
+	XHDMIC_AUXFIELD(XHdmiC_SPDInfoFrame, Version,
+			XHDMIC_AUX_HB(1), 0, 0xff, 0, XHDMIC_AUXFIELD_BOTH),
+	/* Vendor Name Characters */
+	XHDMIC_SPDIF_CHAR(VN1, 1),
+	XHDMIC_SPDIF_CHAR(VN2, 2),
+	XHDMIC_SPDIF_CHAR(VN3, 3),
+	XHDMIC_SPDIF_CHAR(VN4, 4),
+	XHDMIC_SPDIF_CHAR(VN5, 5),
+	XHDMIC_SPDIF_CHAR(VN6, 6),
+	XHDMIC_SPDIF_CHAR(VN7, 8),
+	XHDMIC_SPDIF_CHAR(VN8, 9),
+	/* Product Description Characters */
+	XHDMIC_SPDIF_CHAR(PD1, 10),
+	XHDMIC_SPDIF_CHAR(PD2, 11),
+	XHDMIC_SPDIF_CHAR(PD3, 12),
+	XHDMIC_SPDIF_CHAR(PD4, 13),
+	XHDMIC_SPDIF_CHAR(PD5, 14),
+	XHDMIC_SPDIF_CHAR(PD6, 16),
+	XHDMIC_SPDIF_CHAR(PD7, 17),
+	XHDMIC_SPDIF_CHAR(PD8, 18),
+	XHDMIC_SPDIF_CHAR(PD9, 19),
+	XHDMIC_SPDIF_CHAR(PD10, 20),
+	XHDMIC_SPDIF_CHAR(PD11, 21),
+	XHDMIC_SPDIF_CHAR(PD12, 22),
+	XHDMIC_SPDIF_CHAR(PD13, 24),
+	XHDMIC_SPDIF_CHAR(PD14, 25),
+	XHDMIC_SPDIF_CHAR(PD15, 26),
+	XHDMIC_SPDIF_CHAR(PD16, 27),
+	/* Source Information */
+	XHDMIC_SPDIF_CHAR(SourceInfo, 28),
+};
+
+/** Descriptors of a little endian 16-bit DRM infoframe field */
+#define XHDMIC_DRMIF_U16(Field, LsbByte, MsbByte) \
+	XHDMIC_AUXFIELD(struct v4l2_hdr10_payload, Field, \
+			XHDMIC_AUX_DB(LsbByte), 0, 0xff, 0, \
+			XHDMIC_AUXFIELD_BOTH), \
+	XHDMIC_AUXFIELD(struct v4l2_hdr10_payload, Field, \
+			XHDMIC_AUX_DB(MsbByte), 0, 0xff, 8, \
+			XHDMIC_AUXFIELD_BOTH)
+
+static const XHdmiC_AuxField DrmIfFields[] = {
+	XHDMIC_AUXFIELD(struct v4l2_hdr10_payload, eotf,
+			XHDMIC_AUX_DB(1), 0, 0x7, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_AUXFIELD(struct v4l2_hdr10_payload, metadata_type,
+			XHDMIC_AUX_DB(2), 0, 0x7, 0, XHDMIC_AUXFIELD_BOTH),
+	XHDMIC_DRMIF_U16(display_primaries[0].x, 3, 4),
+	XHDMIC_DRMIF_U16(display_primaries[0].y, 5, 6),
+	XHDMIC_DRMIF_U16(display_primaries[1].x, 8, 9),
+	XHDMIC_DRMIF_U16(display_primaries[1].y, 10, 11),
+	XHDMIC_DRMIF_U16(display_primaries[2].x, 12, 13),
+	XHDMIC_DRMIF_U16(display_primaries[2].y, 14, 16),
+	XHDMIC_DRMIF_U16(white_point.x, 17, 18),
+	XHDMIC_DRMIF_U16(white_point.y, 19, 20),
+	XHDMIC_DRMIF_U16(max_mdl, 21, 22),
+	XHDMIC_DRMIF_U16(min_mdl, 24, 25),
+	XHDMIC_DRMIF_U16(max_cll, 26, 27),
+	XHDMIC_DRMIF_U16(max_fall, 28, 29),
+};
+
+#define XHDMIC_AUXFORMAT(Type, Version, Length, HasChecksum, Fields) \
+	{ (Type) | ((Version) << 8) | ((Length) << 16), (HasChecksum), \
+	  sizeof(Fields) / sizeof((Fields)[0]), (Fields) }
+
+/** AVI infoframe, the version is a field */
+static const XHdmiC_AuxFormat AviIfFormat =
+	XHDMIC_AUXFORMAT(AUX_AVI_INFOFRAME_TYPE, 0, 13, TRUE, AviIfFields);
+/** General control packet, parsed only */
+static const XHdmiC_AuxFormat GcpFormat =
+	XHDMIC_AUXFORMAT(AUX_GENERAL_CONTROL_PACKET_TYPE, 0, 0, FALSE,
+			 GcpFields);
+/** Audio infoframe */
+static const XHdmiC_AuxFormat AudioIfFormat =
+	XHDMIC_AUXFORMAT(AUX_AUDIO_INFOFRAME_TYPE, 0x01, 0x0A, TRUE,
+			 AudioIfFields);
+/** Audio metadata packet, HB1 and HB2 are fields */
+static const XHdmiC_AuxFormat AudioMetadataFormat =
+	XHDMIC_AUXFORMAT(AUX_AUDIO_METADATA_PACKET_TYPE, 0, 0, FALSE,
+			 AudioMetadataFields);
+/** SPD infoframe, the version is a field */
+static const XHdmiC_AuxFormat SpdIfFormat =
+	XHDMIC_AUXFORMAT(AUX_SPD_INFOFRAME_TYPE, 0, 25, TRUE, SpdIfFields);
+/** DRM infoframe, version 1 of CEA-861-G */
+static const XHdmiC_AuxFormat DrmIfFormat =
+	XHDMIC_AUXFORMAT(AUX_DRM_INFOFRAME_TYPE, 0x1, 26, TRUE, DrmIfFields);
+
 /**
 * This returns the the N Value based Audio Sampling Rate and TMDS
 * Character Rate
@@ -277,6 +560,35 @@ u32 XHdmiC_TMDS_GetNVal(u32 TMDSCharRate,
   return item->ACR_NVal[AudSampleFreq-1];
 }
 
+/**
+* This returns the audio sample rate in Hz recovered from the ACR N and CTS
+* values and the TMDS character rate, fs = TMDS * N / (128 * CTS), rounded
+* to the nearest Hz. N and CTS may be the sums of several consecutive ACR
+* packets to average out the CTS jitter of a non-coherent source.
+*
+* @param	TMDSCharRate is the TMDS character rate in Hz.
+* @param	N is the ACR N value.
+* @param	CTSVal is the ACR CTS value.
+*
+* @return	Sample rate in Hz, or 0 if N or CTS is 0.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XHdmiC_TMDS_GetAudSampRateHz(u32 TMDSCharRate, u32 N, u32 CTSVal)
+{
+  u64 Div;
+  u64 fs;
+
+  if (!N || !CTSVal)
+	  return 0;
+
+  Div = 128 * (u64)CTSVal;
+  fs = (u64)TMDSCharRate * (u64)N + (Div / 2);
+
+  return (u32)(fs / Div);
+}
+
 /**
 * This returns the Audio Sampling Rate and TMDS
 * Character Rate.
@@ -314,8 +626,7 @@ XHdmiC_SamplingFrequency XHdmiC_TMDS_GetAudSampFreq(u32 TMDSCharRate,
           return XHDMIC_SAMPLING_FREQUENCY;
 
  /* compute and approximate */
-  fs = ((u64)TMDSCharRate * (u64)N) ;
-  fs = fs / (128 * CTSVal);
+  fs = XHdmiC_TMDS_GetAudSampRateHz(TMDSCharRate, N, CTSVal);
 
   if (((XHDMIC_SAMPLING_FREQ_32K - FsTol) <= fs) &&
 		  (fs <= (XHDMIC_SAMPLING_FREQ_32K + FsTol)))
@@ -610,60 +921,198 @@ XHdmiC_SamplingFrequencyVal
 /*************************** Function Definitions *****************************/
 /**
 *
-* This function retrieves the Auxiliary Video Information Info Frame.
+* This function reads an infoframe structure field.
 *
-* @param  None.
+* @param  Ptr is a pointer to the field.
+* @param  Size is the size of the field.
+*
+* @return The field value.
+*
+* @note   None.
+*
+******************************************************************************/
+static __always_inline u32 XV_HdmiC_AuxFieldLoad(const void *Ptr, u8 Size)
+{
+	switch (Size) {
+	case 1:
+		return *(const u8 *)Ptr;
+	case 2:
+		return *(const u16 *)Ptr;
+	default:
+		return *(const u32 *)Ptr;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes an infoframe structure field.
+*
+* @param  Ptr is a pointer to the field.
+* @param  Size is the size of the field.
+* @param  Value is the field value.
 *
 * @return None.
 *
 * @note   None.
 *
 ******************************************************************************/
-void XV_HdmiC_ParseAVIInfoFrame(XHdmiC_Aux *AuxPtr, XHdmiC_AVI_InfoFrame *infoFramePtr)
+static __always_inline void XV_HdmiC_AuxFieldStore(void *Ptr, u8 Size, u32 Value)
 {
-	if (AuxPtr->Header.Byte[0] == AUX_AVI_INFOFRAME_TYPE) {
+	switch (Size) {
+	case 1:
+		*(u8 *)Ptr = Value;
+		break;
+	case 2:
+		*(u16 *)Ptr = Value;
+		break;
+	default:
+		*(u32 *)Ptr = Value;
+		break;
+	}
+}
 
-		/* Header, Version */
-		infoFramePtr->Version = AuxPtr->Header.Byte[1];
+/*****************************************************************************/
+/**
+*
+* This function reads an AUX word.
+*
+* @param  AuxPtr is a pointer to the AUX packet.
+* @param  Word is the word, 0 is the header.
+*
+* @return The AUX word.
+*
+* @note   None.
+*
+******************************************************************************/
+static __always_inline u32 XV_HdmiC_AuxWord(const XHdmiC_Aux *AuxPtr, u8 Word)
+{
+	return Word ? AuxPtr->Data.Data[Word - 1] : AuxPtr->Header.Data;
+}
 
-		/* PB1 */
-		infoFramePtr->ColorSpace = (AuxPtr->Data.Byte[1] >> 5) & 0x7;
-		infoFramePtr->ActiveFormatDataPresent = (AuxPtr->Data.Byte[1] >> 4) & 0x1;
-		infoFramePtr->BarInfo = (AuxPtr->Data.Byte[1] >> 2) & 0x3;
-		infoFramePtr->ScanInfo = AuxPtr->Data.Byte[1] & 0x3;
+/*****************************************************************************/
+/**
+*
+* This function parses an AUX packet into an infoframe structure, it reads
+* the AUX words once and extracts the fields from the words. Fields not in
+* the format are not modified.
+*
+* @param  FormatPtr is a pointer to the format of the infoframe.
+* @param  AuxPtr is a pointer to the AUX packet.
+* @param  StructPtr is a pointer to the infoframe structure.
+*
+* @return None.
+*
+* @note   The packet is only parsed if HB0 matches the type of the format.
+*         The function is inlined with a constant format and the loop is
+*         unrolled, so the descriptors fold into straight line code.
+*
+******************************************************************************/
+static __always_inline void XV_HdmiC_AuxUnpack(const XHdmiC_AuxFormat *FormatPtr,
+		const XHdmiC_Aux *AuxPtr, void *StructPtr)
+{
+	const XHdmiC_AuxField *FieldPtr;
+	u32 Value;
+	u8 *Ptr;
+	u8 Index;
 
-		/* PB2 */
-		infoFramePtr->Colorimetry = (AuxPtr->Data.Byte[2] >> 6) & 0x3;
-		infoFramePtr->PicAspectRatio = (AuxPtr->Data.Byte[2] >> 4) & 0x3;
-		infoFramePtr->ActiveAspectRatio = AuxPtr->Data.Byte[2] & 0xf;
+	if ((AuxPtr->Header.Data & 0xff) != (FormatPtr->Header & 0xff))
+		return;
 
-		/* PB3 */
-		infoFramePtr->Itc = (AuxPtr->Data.Byte[3] >> 7) & 0x1;
-		infoFramePtr->ExtendedColorimetry = (AuxPtr->Data.Byte[3] >> 4) & 0x7;
-		infoFramePtr->QuantizationRange = (AuxPtr->Data.Byte[3] >> 2) & 0x3;
-		infoFramePtr->NonUniformPictureScaling = AuxPtr->Data.Byte[3] & 0x3;
+#pragma GCC unroll 64
+	for (Index = 0; Index < FormatPtr->NumFields; Index++) {
+		FieldPtr = &FormatPtr->Fields[Index];
+		if (!(FieldPtr->Dir & XHDMIC_AUXFIELD_PARSE))
+			continue;
 
-		/* PB4 */
-		infoFramePtr->VIC = AuxPtr->Data.Byte[4] & 0x7f;
+		Ptr = (u8 *)StructPtr + FieldPtr->Offset;
+		Value = (XV_HdmiC_AuxWord(AuxPtr, FieldPtr->Word) >>
+			 FieldPtr->Shift) & FieldPtr->Mask;
 
-		/* PB5 */
-		infoFramePtr->YccQuantizationRange = (AuxPtr->Data.Byte[5] >> 6) & 0x3;
-		infoFramePtr->ContentType = (AuxPtr->Data.Byte[5] >> 4) & 0x3;
-		infoFramePtr->PixelRepetition = AuxPtr->Data.Byte[5] & 0xf;
+		/* Upper bytes are merged into the lower byte parsed before */
+		if (FieldPtr->FieldShift)
+			Value = XV_HdmiC_AuxFieldLoad(Ptr, FieldPtr->Size) |
+				(Value << FieldPtr->FieldShift);
 
-		/* PB6/7 */
-		infoFramePtr->TopBar = (AuxPtr->Data.Byte[8] << 8) | AuxPtr->Data.Byte[6];
+		XV_HdmiC_AuxFieldStore(Ptr, FieldPtr->Size, Value);
+	}
+}
 
-		/* PB8/9 */
-		infoFramePtr->BottomBar = (AuxPtr->Data.Byte[10] << 8) | AuxPtr->Data.Byte[9];
+/*****************************************************************************/
+/**
+*
+* This function generates an AUX packet from an infoframe structure. The
+* fields are packed into the AUX words, unused and ECC bytes are zero.
+*
+* The infoframe checksum makes the sum of HB0 to HB2 and all data bytes
+* zero. As every byte outside the infoframe length is zero, it is computed
+* in a single pass over the words, summing the byte lanes two at a time.
+*
+* @param  FormatPtr is a pointer to the format of the infoframe.
+* @param  StructPtr is a pointer to the infoframe structure.
+* @param  AuxPtr is a pointer to the AUX packet to generate.
+*
+* @return None.
+*
+* @note   Inlined and unrolled like XV_HdmiC_AuxUnpack, the words stay in
+*         registers until they are stored.
+*
+******************************************************************************/
+static __always_inline void XV_HdmiC_AuxPack(const XHdmiC_AuxFormat *FormatPtr,
+		const void *StructPtr, XHdmiC_Aux *AuxPtr)
+{
+	const XHdmiC_AuxField *FieldPtr;
+	u32 Word[XHDMIC_AUX_WORDS] = { FormatPtr->Header };
+	u32 Value;
+	u32 Sum;
+	u8 Index;
 
-		/* PB10/11 */
-		infoFramePtr->LeftBar = (AuxPtr->Data.Byte[12] << 8) | AuxPtr->Data.Byte[11];
+#pragma GCC unroll 64
+	for (Index = 0; Index < FormatPtr->NumFields; Index++) {
+		FieldPtr = &FormatPtr->Fields[Index];
+		if (!(FieldPtr->Dir & XHDMIC_AUXFIELD_GENERATE))
+			continue;
 
-		/* PB12/13 */
-		infoFramePtr->RightBar = (AuxPtr->Data.Byte[14] << 8) | AuxPtr->Data.Byte[13];
+		Value = XV_HdmiC_AuxFieldLoad((const u8 *)StructPtr +
+					      FieldPtr->Offset, FieldPtr->Size);
+		Word[FieldPtr->Word] |= ((Value >> FieldPtr->FieldShift) &
+					 FieldPtr->Mask) << FieldPtr->Shift;
+	}
+
+	if (FormatPtr->HasChecksum) {
+		/* Each 16-bit lane sums at most 18 bytes, it cannot overflow */
+		Sum = 0;
+#pragma GCC unroll 9
+		for (Index = 0; Index < XHDMIC_AUX_WORDS; Index++)
+			Sum += (Word[Index] & 0x00ff00ff) +
+			       ((Word[Index] >> 8) & 0x00ff00ff);
+		Sum += Sum >> 16;
 
+		/* PB0 */
+		Word[1] |= (u8)(0x100 - (Sum & 0xff));
 	}
+
+	AuxPtr->Header.Data = Word[0];
+#pragma GCC unroll 9
+	for (Index = 1; Index < XHDMIC_AUX_WORDS; Index++)
+		AuxPtr->Data.Data[Index - 1] = Word[Index];
+}
+
+/*****************************************************************************/
+/**
+*
+* This function retrieves the Auxiliary Video Information Info Frame.
+*
+* @param  None.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+void XV_HdmiC_ParseAVIInfoFrame(XHdmiC_Aux *AuxPtr, XHdmiC_AVI_InfoFrame *infoFramePtr)
+{
+	XV_HdmiC_AuxUnpack(&AviIfFormat, AuxPtr, infoFramePtr);
 }
 
 /*****************************************************************************/
@@ -680,19 +1129,7 @@ void XV_HdmiC_ParseAVIInfoFrame(XHdmiC_Aux *AuxPtr, XHdmiC_AVI_InfoFrame *infoFr
 ******************************************************************************/
 void XV_HdmiC_ParseGCP(XHdmiC_Aux *AuxPtr, XHdmiC_GeneralControlPacket *GcpPtr)
 {
-	if (AuxPtr->Header.Byte[0] == AUX_GENERAL_CONTROL_PACKET_TYPE) {
-
-		/* SB0 */
-		GcpPtr->Clear_AVMUTE = (AuxPtr->Data.Byte[0] >> 4) & 0x1;
-		GcpPtr->Set_AVMUTE = AuxPtr->Data.Byte[0] & 0x1;
-
-		/* SB1 */
-		GcpPtr->PixelPackingPhase = (AuxPtr->Data.Byte[1] >> 4) & 0xf;
-		GcpPtr->ColorDepth = AuxPtr->Data.Byte[1] & 0xf;
-
-		/* SB2 */
-		GcpPtr->Default_Phase = AuxPtr->Data.Byte[2] & 0x1;
-	}
+	XV_HdmiC_AuxUnpack(&GcpFormat, AuxPtr, GcpPtr);
 }
 
 /*****************************************************************************/
@@ -709,27 +1146,7 @@ void XV_HdmiC_ParseGCP(XHdmiC_Aux *AuxPtr, XHdmiC_GeneralControlPacket *GcpPtr)
 ******************************************************************************/
 void XV_HdmiC_ParseAudioInfoFrame(XHdmiC_Aux *AuxPtr, XHdmiC_AudioInfoFrame *AudIFPtr)
 {
-	if (AuxPtr->Header.Byte[0] == AUX_AUDIO_INFOFRAME_TYPE) {
-
-		/* HB1, Version */
-		AudIFPtr->Version = AuxPtr->Header.Byte[1];
-
-		/* PB1 */
-		AudIFPtr->CodingType = (AuxPtr->Data.Byte[1] >> 4) & 0xf;
-		AudIFPtr->ChannelCount = (AuxPtr->Data.Byte[1]) & 0x7;
-
-		/* PB2 */
-		AudIFPtr->SampleFrequency = (AuxPtr->Data.Byte[2] >> 2) & 0x7;
-		AudIFPtr->SampleSize = AuxPtr->Data.Byte[2] & 0x3;
-
-		/* PB4 */
-		AudIFPtr->ChannelAllocation = AuxPtr->Data.Byte[4];
-
-		/* PB5 */
-		AudIFPtr->Downmix_Inhibit = (AuxPtr->Data.Byte[5] >> 7) & 0x1;
-		AudIFPtr->LevelShiftVal = (AuxPtr->Data.Byte[5] >> 4) & 0xf;
-		AudIFPtr->LFE_Playback_Level = AuxPtr->Data.Byte[5] & 0x3;
-	}
+	XV_HdmiC_AuxUnpack(&AudioIfFormat, AuxPtr, AudIFPtr);
 }
 
 /*****************************************************************************/
@@ -747,26 +1164,7 @@ void XV_HdmiC_ParseAudioInfoFrame(XHdmiC_Aux *AuxPtr, XHdmiC_AudioInfoFrame *Aud
 void XV_HdmiC_ParseAudioMetadata(XHdmiC_Aux *AuxPtr,
 		XHdmiC_AudioMetadata *AudMetadata)
 {
-	if (AuxPtr->Header.Byte[0] == AUX_AUDIO_METADATA_PACKET_TYPE) {
-		/* 3D Audio */
-		AudMetadata->Audio3D = AuxPtr->Header.Byte[1] & 0x1;
-
-		/* HB2 */
-		AudMetadata->Num_Audio_Str =
-				(AuxPtr->Header.Byte[2] >> 2) & 0x3;
-		AudMetadata->Num_Views = AuxPtr->Header.Byte[2] & 0x3;
-
-		/* PB0 */
-		AudMetadata->Audio3D_ChannelCount =
-				AuxPtr->Data.Byte[0] & 0x1F;
-
-		/* PB1 */
-		AudMetadata->ACAT = AuxPtr->Data.Byte[1] & 0x0F;
-
-		/* PB2 */
-		AudMetadata->Audio3D_ChannelAllocation =
-				AuxPtr->Data.Byte[2] & 0xFF;
-	}
+	XV_HdmiC_AuxUnpack(&AudioMetadataFormat, AuxPtr, AudMetadata);
 }
 
 /*****************************************************************************/
@@ -783,41 +1181,7 @@ void XV_HdmiC_ParseAudioMetadata(XHdmiC_Aux *AuxPtr,
 ******************************************************************************/
 void XV_HdmiC_ParseSPDIF(XHdmiC_Aux *AuxPtr, XHdmiC_SPDInfoFrame *SPDInfoFrame)
 {
-	if (AuxPtr->Header.Byte[0] == AUX_SPD_INFOFRAME_TYPE) {
-		/* 3D Audio */
-		SPDInfoFrame->Version = AuxPtr->Header.Byte[1];
-
-		/* Vendor Name Characters */
-		SPDInfoFrame->VN1 = AuxPtr->Data.Byte[1];
-		SPDInfoFrame->VN2 = AuxPtr->Data.Byte[2];
-		SPDInfoFrame->VN3 = AuxPtr->Data.Byte[3];
-		SPDInfoFrame->VN4 = AuxPtr->Data.Byte[4];
-		SPDInfoFrame->VN5 = AuxPtr->Data.Byte[5];
-		SPDInfoFrame->VN6 = AuxPtr->Data.Byte[6];
-		SPDInfoFrame->VN7 = AuxPtr->Data.Byte[8];
-		SPDInfoFrame->VN8 = AuxPtr->Data.Byte[9];
-
-		/* Product Description Character */
-		SPDInfoFrame->PD1 = AuxPtr->Data.Byte[10];
-		SPDInfoFrame->PD2 = AuxPtr->Data.Byte[11];
-		SPDInfoFrame->PD3 = AuxPtr->Data.Byte[12];
-		SPDInfoFrame->PD4 = AuxPtr->Data.Byte[13];
-		SPDInfoFrame->PD5 = AuxPtr->Data.Byte[14];
-		SPDInfoFrame->PD6 = AuxPtr->Data.Byte[16];
-		SPDInfoFrame->PD7 = AuxPtr->Data.Byte[17];
-		SPDInfoFrame->PD8 = AuxPtr->Data.Byte[18];
-		SPDInfoFrame->PD9 = AuxPtr->Data.Byte[19];
-		SPDInfoFrame->PD10 = AuxPtr->Data.Byte[20];
-		SPDInfoFrame->PD11 = AuxPtr->Data.Byte[21];
-		SPDInfoFrame->PD12 = AuxPtr->Data.Byte[22];
-		SPDInfoFrame->PD13 = AuxPtr->Data.Byte[24];
-		SPDInfoFrame->PD14 = AuxPtr->Data.Byte[25];
-		SPDInfoFrame->PD15 = AuxPtr->Data.Byte[26];
-		SPDInfoFrame->PD16 = AuxPtr->Data.Byte[27];
-
-		/* Source Information */
-		SPDInfoFrame->SourceInfo = AuxPtr->Data.Byte[28];
-	}
+	XV_HdmiC_AuxUnpack(&SpdIfFormat, AuxPtr, SPDInfoFrame);
 }
 
 /*****************************************************************************/
@@ -834,62 +1198,7 @@ void XV_HdmiC_ParseSPDIF(XHdmiC_Aux *AuxPtr, XHdmiC_SPDInfoFrame *SPDInfoFrame)
 ******************************************************************************/
 void XV_HdmiC_ParseDRMIF(XHdmiC_Aux *AuxPtr, struct v4l2_hdr10_payload *DRMInfoFrame)
 {
-	if (AuxPtr->Header.Byte[0] == AUX_DRM_INFOFRAME_TYPE) {
-
-		/* Vendor Name Characters */
-		DRMInfoFrame->eotf = AuxPtr->Data.Byte[1] & 0x7;
-
-		DRMInfoFrame->metadata_type =
-				AuxPtr->Data.Byte[2] & 0x7;
-
-		DRMInfoFrame->display_primaries[0].x =
-				(AuxPtr->Data.Byte[3] & 0xFF) |
-				(AuxPtr->Data.Byte[4] << 8);
-
-		DRMInfoFrame->display_primaries[0].y =
-				(AuxPtr->Data.Byte[5] & 0xFF) |
-				(AuxPtr->Data.Byte[6] << 8);
-
-		DRMInfoFrame->display_primaries[1].x =
-				(AuxPtr->Data.Byte[8] & 0xFF) |
-				(AuxPtr->Data.Byte[9] << 8);
-
-		DRMInfoFrame->display_primaries[1].y =
-				(AuxPtr->Data.Byte[10] & 0xFF) |
-				(AuxPtr->Data.Byte[11] << 8);
-
-		DRMInfoFrame->display_primaries[2].x =
-				(AuxPtr->Data.Byte[12] & 0xFF) |
-				(AuxPtr->Data.Byte[13] << 8);
-
-		DRMInfoFrame->display_primaries[2].y =
-				(AuxPtr->Data.Byte[14] & 0xFF) |
-				(AuxPtr->Data.Byte[16] << 8);
-
-		DRMInfoFrame->white_point.x =
-				(AuxPtr->Data.Byte[17] & 0xFF) |
-				(AuxPtr->Data.Byte[18] << 8);
-
-		DRMInfoFrame->white_point.y =
-				(AuxPtr->Data.Byte[19] & 0xFF) |
-				(AuxPtr->Data.Byte[20] << 8);
-
-		DRMInfoFrame->max_mdl =
-				(AuxPtr->Data.Byte[21] & 0xFF) |
-				(AuxPtr->Data.Byte[22] << 8);
-
-		DRMInfoFrame->min_mdl =
-				(AuxPtr->Data.Byte[24] & 0xFF) |
-				(AuxPtr->Data.Byte[25] << 8);
-
-		DRMInfoFrame->max_cll =
-				(AuxPtr->Data.Byte[26] & 0xFF) |
-				(AuxPtr->Data.Byte[27] << 8);
-
-		DRMInfoFrame->max_fall =
-				(AuxPtr->Data.Byte[28] & 0xFF) |
-				(AuxPtr->Data.Byte[29] << 8);
-	}
+	XV_HdmiC_AuxUnpack(&DrmIfFormat, AuxPtr, DRMInfoFrame);
 }
 
 /*****************************************************************************/
@@ -906,101 +1215,11 @@ void XV_HdmiC_ParseDRMIF(XHdmiC_Aux *AuxPtr, struct v4l2_hdr10_payload *DRMInfoF
 ******************************************************************************/
 XHdmiC_Aux XV_HdmiC_AVIIF_GeneratePacket(XHdmiC_AVI_InfoFrame *infoFramePtr)
 {
-//	Xil_AssertNonvoid(infoFramePtr != NULL);
-
-	u8 Index;
-	u8 Crc;
 	XHdmiC_Aux aux;
 
-	(void)memset((void *)&aux, 0, sizeof(XHdmiC_Aux));
-
-	/* Header, Packet type*/
-	aux.Header.Byte[0] = AUX_AVI_INFOFRAME_TYPE;
-
-	/* Version */
-	aux.Header.Byte[1] = infoFramePtr->Version;
+	XV_HdmiC_AuxPack(&AviIfFormat, infoFramePtr, &aux);
 
-	/* Length */
-	aux.Header.Byte[2] = 13;
-
-	/* Checksum (this will be calculated by the HDMI TX IP) */
-	aux.Header.Byte[3] = 0;
-
-	/* PB1 */
-   aux.Data.Byte[1] = (infoFramePtr->ColorSpace & 0x7) << 5 |
-		   ((infoFramePtr->ActiveFormatDataPresent << 4) & 0x10) |
-		   ((infoFramePtr->BarInfo << 2) & 0xc) |
-		   (infoFramePtr->ScanInfo & 0x3);
-
-   /* PB2 */
-   aux.Data.Byte[2] = ((infoFramePtr->Colorimetry & 0x3) << 6  |
-		   ((infoFramePtr->PicAspectRatio << 4) & 0x30) |
-		   (infoFramePtr->ActiveAspectRatio & 0xf));
-
-   /* PB3 */
-   aux.Data.Byte[3] = (infoFramePtr->Itc & 0x1) << 7 |
-		   ((infoFramePtr->ExtendedColorimetry << 4) & 0x70) |
-		   ((infoFramePtr->QuantizationRange << 2) & 0xc) |
-		   (infoFramePtr->NonUniformPictureScaling & 0x3);
-
-   /* PB4 */
-   aux.Data.Byte[4] = infoFramePtr->VIC;
-
-   /* PB5 */
-   aux.Data.Byte[5] = (infoFramePtr->YccQuantizationRange & 0x3) << 6 |
-		   ((infoFramePtr->ContentType << 4) & 0x30) |
-		   (infoFramePtr->PixelRepetition & 0xf);
-
-   /* PB6 */
-   aux.Data.Byte[6] = infoFramePtr->TopBar & 0xff;
-
-   aux.Data.Byte[7] = 0;
-
-   /* PB8 */
-   aux.Data.Byte[8] = (infoFramePtr->TopBar & 0xff00) >> 8;
-
-   /* PB9 */
-   aux.Data.Byte[9] = infoFramePtr->BottomBar & 0xff;
-
-   /* PB10 */
-   aux.Data.Byte[10] = (infoFramePtr->BottomBar & 0xff00) >> 8;
-
-   /* PB11 */
-   aux.Data.Byte[11] = infoFramePtr->LeftBar & 0xff;
-
-   /* PB12 */
-   aux.Data.Byte[12] = (infoFramePtr->LeftBar & 0xff00) >> 8;
-
-   /* PB13 */
-   aux.Data.Byte[13] = infoFramePtr->RightBar & 0xff;
-
-   /* PB14 */
-   aux.Data.Byte[14] = (infoFramePtr->RightBar & 0xff00) >> 8;
-
-   /* Index references the length to calculate start of loop from where values are reserved */
-   for (Index = aux.Header.Byte[2] + 2; Index < 32; Index++) {
-	   aux.Data.Byte[Index] = 0;
-   }
-
-   /* Calculate AVI infoframe checksum */
-   Crc = 0;
-
-   /* Header */
-   for (Index = 0; Index < 3; Index++) {
-     Crc += aux.Header.Byte[Index];
-   }
-
-   /* Data */
-   for (Index = 1; Index < (aux.Header.Byte[2] + 2); Index++) {
-     Crc += aux.Data.Byte[Index];
-   }
-
-   Crc = 256 - Crc;
-
-   /* PB0 */
-   aux.Data.Byte[0] = Crc;
-
-   return aux;
+	return aux;
 }
 
 /*****************************************************************************/
@@ -1017,68 +1236,11 @@ XHdmiC_Aux XV_HdmiC_AVIIF_GeneratePacket(XHdmiC_AVI_InfoFrame *infoFramePtr)
 ******************************************************************************/
 XHdmiC_Aux XV_HdmiC_AudioIF_GeneratePacket(XHdmiC_AudioInfoFrame *AudioInfoFrame)
 {
-//	Xil_AssertNonvoid(AudioInfoFrame != NULL);
-
-	u8 Index;
-	u8 Crc;
 	XHdmiC_Aux aux;
 
-	(void)memset((void *)&aux, 0, sizeof(XHdmiC_Aux));
-
-	/* Header, Packet Type */
-	aux.Header.Byte[0] = AUX_AUDIO_INFOFRAME_TYPE;
-
-	/* Version */
-	aux.Header.Byte[1] = 0x01;
-
-	/* Length */
-	aux.Header.Byte[2] = 0x0A;
-
-	aux.Header.Byte[3] = 0;
-
-	/* PB1 */
-	aux.Data.Byte[1] = AudioInfoFrame->CodingType << 4 |
-			(AudioInfoFrame->ChannelCount & 0x7);
-
-	/* PB2 */
-	aux.Data.Byte[2] = ((AudioInfoFrame->SampleFrequency << 2) & 0x1c) |
-			(AudioInfoFrame->SampleSize & 0x3);
-
-	/* PB3 */
-	aux.Data.Byte[3] = 0;
-
-
-	/* PB4 */
-	aux.Data.Byte[4] = AudioInfoFrame->ChannelAllocation;
-
-	/* PB5 */
-	aux.Data.Byte[5] = (AudioInfoFrame->Downmix_Inhibit << 7) |
-			((AudioInfoFrame->LevelShiftVal << 3) & 0x78) |
-			(AudioInfoFrame->LFE_Playback_Level & 0x3);
-
-	for (Index = 6; Index < 32; Index++)
-	{
-		aux.Data.Byte[Index] = 0;
-	}
-
-	/* Calculate Audio infoframe checksum */
-	  Crc = 0;
-
-	  /* Header */
-	  for (Index = 0; Index < 3; Index++) {
-	    Crc += aux.Header.Byte[Index];
-	  }
-
-	  /* Data */
-	  for (Index = 1; Index < aux.Header.Byte[2] + 1; Index++) {
-		  Crc += aux.Data.Byte[Index];
-	  }
-
-	  Crc = 256 - Crc;
-
-	  aux.Data.Byte[0] = Crc;
+	XV_HdmiC_AuxPack(&AudioIfFormat, AudioInfoFrame, &aux);
 
-	  return aux;
+	return aux;
 }
 
 /*****************************************************************************/
@@ -1096,35 +1258,9 @@ XHdmiC_Aux XV_HdmiC_AudioIF_GeneratePacket(XHdmiC_AudioInfoFrame *AudioInfoFrame
 XHdmiC_Aux XV_HdmiC_AudioMetadata_GeneratePacket(XHdmiC_AudioMetadata
 		*AudMetadata)
 {
-	u8 Index;
 	XHdmiC_Aux aux;
 
-	(void)memset((void *)&aux, 0, sizeof(XHdmiC_Aux));
-
-	/* Header, Packet Type */
-	aux.Header.Byte[0] = AUX_AUDIO_METADATA_PACKET_TYPE;
-
-	/* 3D Audio */
-	aux.Header.Byte[1] = AudMetadata->Audio3D & 0x1;
-
-	/* HB2 */
-	aux.Header.Byte[2] = ((AudMetadata->Num_Audio_Str & 0x3) << 2) |
-			(AudMetadata->Num_Views & 0x3);
-
-	/* HB3 */
-	aux.Header.Byte[3] = 0;
-
-	/* PB0 */
-	aux.Data.Byte[0] = AudMetadata->Audio3D_ChannelCount & 0x1F;
-
-	/* PB1 */
-	aux.Data.Byte[1] = AudMetadata->ACAT & 0x0F;
-
-	/* PB2 */
-	aux.Data.Byte[2] = AudMetadata->Audio3D_ChannelAllocation & 0xFF;
-
-	for (Index = 3; Index < 32; Index++)
-		aux.Data.Byte[Index] = 0;
+	XV_HdmiC_AuxPack(&AudioMetadataFormat, AudMetadata, &aux);
 
 	return aux;
 }
@@ -1143,76 +1279,9 @@ XHdmiC_Aux XV_HdmiC_AudioMetadata_GeneratePacket(XHdmiC_AudioMetadata
 ******************************************************************************/
 XHdmiC_Aux XV_HdmiC_SPDIF_GeneratePacket(XHdmiC_SPDInfoFrame *SPDInfoFrame)
 {
-	u8 Index;
-	u8 Crc;
 	XHdmiC_Aux aux;
 
-	(void)memset((void *)&aux, 0, sizeof(XHdmiC_Aux));
-
-	/* Header, Packet Type */
-	aux.Header.Byte[0] = AUX_SPD_INFOFRAME_TYPE;
-
-	/* 3D Audio */
-	aux.Header.Byte[1] = SPDInfoFrame->Version;
-
-	/* Length of SPD InfoFrame */
-	aux.Header.Byte[2] = 25;
-
-	/* HB3 */
-	aux.Header.Byte[3] = 0; /* CRC */
-
-	/* Vendor Name Characters */
-	aux.Data.Byte[0] = 0; /* CRC */
-	aux.Data.Byte[1] = SPDInfoFrame->VN1;
-	aux.Data.Byte[2] = SPDInfoFrame->VN2;
-	aux.Data.Byte[3] = SPDInfoFrame->VN3;
-	aux.Data.Byte[4] = SPDInfoFrame->VN4;
-	aux.Data.Byte[5] = SPDInfoFrame->VN5;
-	aux.Data.Byte[6] = SPDInfoFrame->VN6;
-	aux.Data.Byte[7] = 0; /* ECC */
-	aux.Data.Byte[8] = SPDInfoFrame->VN7;
-	aux.Data.Byte[9] = SPDInfoFrame->VN8;
-
-	/* Product Description Character */
-	aux.Data.Byte[10] = SPDInfoFrame->PD1;
-	aux.Data.Byte[11] = SPDInfoFrame->PD2;
-	aux.Data.Byte[12] = SPDInfoFrame->PD3;
-	aux.Data.Byte[13] = SPDInfoFrame->PD4;
-	aux.Data.Byte[14] = SPDInfoFrame->PD5;
-	aux.Data.Byte[15] = 0; /* ECC */
-	aux.Data.Byte[16] = SPDInfoFrame->PD6;
-	aux.Data.Byte[17] = SPDInfoFrame->PD7;
-	aux.Data.Byte[18] = SPDInfoFrame->PD8;
-	aux.Data.Byte[19] = SPDInfoFrame->PD9;
-	aux.Data.Byte[20] = SPDInfoFrame->PD10;
-	aux.Data.Byte[21] = SPDInfoFrame->PD11;
-	aux.Data.Byte[22] = SPDInfoFrame->PD12;
-	aux.Data.Byte[23] = 0; /* ECC */
-	aux.Data.Byte[24] = SPDInfoFrame->PD13;
-	aux.Data.Byte[25] = SPDInfoFrame->PD14;
-	aux.Data.Byte[26] = SPDInfoFrame->PD15;
-	aux.Data.Byte[27] = SPDInfoFrame->PD16;
-
-	/* Source Information */
-	aux.Data.Byte[28] = SPDInfoFrame->SourceInfo;
-	aux.Data.Byte[29] = 0;
-	aux.Data.Byte[30] = 0;
-	aux.Data.Byte[31] = 0; /* ECC */
-
-	/* Calculate SPD infoframe checksum */
-	Crc = 0;
-
-	/* Header */
-	for (Index = 0; Index < 3; Index++)
-		Crc += aux.Header.Byte[Index];
-
-	/* Data */
-	for (Index = 1; Index < aux.Header.Byte[2] + 4; Index++)
-		Crc += aux.Data.Byte[Index];
-
-	Crc = 256 - Crc;
-
-	aux.Data.Byte[0] = Crc;
+	XV_HdmiC_AuxPack(&SpdIfFormat, SPDInfoFrame, &aux);
 
 	return aux;
 }
@@ -1231,85 +1300,7 @@ XHdmiC_Aux XV_HdmiC_SPDIF_GeneratePacket(XHdmiC_SPDInfoFrame *SPDInfoFrame)
 ******************************************************************************/
 void XV_HdmiC_DRMIF_GeneratePacket(struct v4l2_hdr10_payload *DRMInfoFrame, XHdmiC_Aux *aux)
 {
-	u8 Index;
-	u8 Crc;
-
-	memset(aux, 0, sizeof(XHdmiC_Aux));
-
-	/* Header, Packet Type */
-	aux->Header.Byte[0] = AUX_DRM_INFOFRAME_TYPE;
-
-	/* Version Refer CEA-861-G */
-	aux->Header.Byte[1] = 0x1;
-
-	/* Length of DRM InfoFrame */
-	aux->Header.Byte[2] = 26;
-
-	/* HB3 */
-	aux->Header.Byte[3] = 0; /* CRC */
-
-	/* Vendor Name Characters */
-	aux->Data.Byte[0] = 0; /* CRC */
-	aux->Data.Byte[1] = DRMInfoFrame->eotf & 0x7;
-
-	aux->Data.Byte[2] = DRMInfoFrame->metadata_type & 0x7;
-
-	aux->Data.Byte[3] = DRMInfoFrame->display_primaries[0].x & 0xFF;
-	aux->Data.Byte[4] = DRMInfoFrame->display_primaries[0].x >> 8;
-
-	aux->Data.Byte[5] = DRMInfoFrame->display_primaries[0].y & 0xFF;
-	aux->Data.Byte[6] = DRMInfoFrame->display_primaries[0].y >> 8;
-	aux->Data.Byte[7] = 0; /* ECC */
-
-	aux->Data.Byte[8] = DRMInfoFrame->display_primaries[1].x & 0xFF;
-	aux->Data.Byte[9] = DRMInfoFrame->display_primaries[1].x >> 8;
-
-	aux->Data.Byte[10] = DRMInfoFrame->display_primaries[1].y & 0xFF;
-	aux->Data.Byte[11] = DRMInfoFrame->display_primaries[1].y >> 8;
-
-	aux->Data.Byte[12] = DRMInfoFrame->display_primaries[2].x & 0xFF;
-	aux->Data.Byte[13] = DRMInfoFrame->display_primaries[2].x >> 8;
-
-	aux->Data.Byte[14] = DRMInfoFrame->display_primaries[2].y & 0xFF;
-	aux->Data.Byte[15] = 0; /* ECC */
-	aux->Data.Byte[16] = DRMInfoFrame->display_primaries[2].y >> 8;
-
-	aux->Data.Byte[17] = DRMInfoFrame->white_point.x & 0xFF;
-	aux->Data.Byte[18] = DRMInfoFrame->white_point.x >> 8;
-
-	aux->Data.Byte[19] = DRMInfoFrame->white_point.y & 0xFF;
-	aux->Data.Byte[20] = DRMInfoFrame->white_point.y >> 8;
-
-	aux->Data.Byte[21] = DRMInfoFrame->max_mdl & 0xFF;
-	aux->Data.Byte[22] = DRMInfoFrame->max_mdl >> 8;
-	aux->Data.Byte[23] = 0; /* ECC */
-
-	aux->Data.Byte[24] = DRMInfoFrame->min_mdl & 0xFF;
-	aux->Data.Byte[25] = DRMInfoFrame->min_mdl >> 8;
-
-	aux->Data.Byte[26] = DRMInfoFrame->max_cll & 0xFF;
-	aux->Data.Byte[27] = DRMInfoFrame->max_cll >> 8;
-
-	aux->Data.Byte[28] = DRMInfoFrame->max_fall & 0xFF;
-	aux->Data.Byte[29] = DRMInfoFrame->max_fall >> 8;
-
-	aux->Data.Byte[30] = 0;
-	aux->Data.Byte[31] = 0; /* ECC */
-
-	/* Calculate DRM infoframe checksum */
-	Crc = 0;
-
-	/* Header */
-	for (Index = 0; Index < 3; Index++)
-		Crc += aux->Header.Byte[Index];
-
-	/* Data */
-	for (Index = 1; Index < aux->Header.Byte[2] + 4; Index++)
-		Crc += aux->Data.Byte[Index];
-
-	Crc = 256 - Crc;
-
-	aux->Data.Byte[0] = Crc;
+	XV_HdmiC_AuxPack(&DrmIfFormat, DRMInfoFrame, aux);
 }
 
 /*****************************************************************************/
@@ -30,6 +30,7 @@
  * Ver   Who  Date     Changes
  * ----- ---- -------- -----------------------------------------------
  * 1.0   EB   21/12/17 Initial release.
+ * 1.1   XLNX 10/18/26 Added XHdmiC_TMDS_GetAudSampRateHz
  * </pre>
  *
 *******************************************************************************/
@@ -573,6 +574,7 @@ XHdmiC_SamplingFrequencyVal
 		u32 CTS, u32 N);
 XHdmiC_SamplingFrequency XHdmiC_TMDS_GetAudSampFreq(u32 TMDSCharRate,
 		u32 N, u32 CTSVal);
+u32 XHdmiC_TMDS_GetAudSampRateHz(u32 TMDSCharRate, u32 N, u32 CTSVal);
 XHdmiC_SamplingFrequency
 	XHdmiC_GetAudIFSampFreq (XHdmiC_SamplingFrequencyVal AudSampFreqVal);
 XHdmiC_SamplingFrequencyVal
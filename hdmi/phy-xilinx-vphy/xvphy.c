@@ -66,6 +66,9 @@
  *                       XVphy_SetTxPreEmphasis from xvphy_i.c/h
  *                     Added XVphy_SetTxPostCursor API
  * 1.9   gm   14/05/18 Added XVphy_SetRxLpm from xvphy_i.c/.h
+ * 1.10  XLNX 10/18/26 Added XVphy_SetRegLockHandler API, the IBUFDS control
+ *                       and the GT DRP ports are accessed under the
+ *                       register lock
  *
  * </pre>
  *
@@ -271,6 +274,35 @@ void XVphy_SetUserTimerHandler(XVphy *InstancePtr,
 	InstancePtr->UserTimerPtr = CallbackRef;
 }
 
+/******************************************************************************/
+/**
+* This function installs a custom lock function for the sections of the driver
+* that access resources shared by the TX and RX directions of a quad. Without
+* it, the user must serialize all calls into the driver.
+*
+* @param	InstancePtr is a pointer to the XVphy instance.
+* @param	CallbackFunc is the address to the lock function.
+* @param	CallbackRef is the user data item that will be passed to the
+*		lock function when it is invoked.
+*
+* @return	None.
+*
+* @note		The lock function is called with TRUE to enter a section and
+*		with FALSE to leave it. Sections do not nest, so it may be a
+*		plain mutex.
+*
+*******************************************************************************/
+void XVphy_SetRegLockHandler(XVphy *InstancePtr,
+		XVphy_RegLockHandler CallbackFunc, void *CallbackRef)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(CallbackFunc != NULL);
+
+	InstancePtr->RegLockHandler = CallbackFunc;
+	InstancePtr->RegLockRef = CallbackRef;
+}
+
 /******************************************************************************/
 /**
 * This function is the delay/sleep function for the XVphy driver. For the Zynq
@@ -1124,7 +1156,9 @@ void XVphy_SetRxLpm(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 *		- XST_FAILURE otherwise, if the busy bit did not go low, or if
 *		  the ready bit did not go high.
 *
-* @note		None.
+* @note		The DRP ports of the GT channels and of the QPLLs are shared
+*		by TX and RX, accesses to them are made with the register lock
+*		held, see XVphy_SetRegLockHandler.
 *
 ******************************************************************************/
 u32 XVphy_DrpWr(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
@@ -1151,7 +1185,9 @@ u32 XVphy_DrpWr(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 *		- XST_FAILURE otherwise, if the busy bit did not go low, or if
 *		  the ready bit did not go high.
 *
-* @note		None.
+* @note		The DRP ports of the GT channels and of the QPLLs are shared
+*		by TX and RX, accesses to them are made with the register lock
+*		held, see XVphy_SetRegLockHandler.
 *
 ******************************************************************************/
 u16 XVphy_DrpRd(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
@@ -1344,6 +1380,8 @@ void XVphy_IBufDsEnable(XVphy *InstancePtr, u8 QuadId, XVphy_DirectionType Dir,
 		MaskVal = XVPHY_MISC_XXUSRCLK_REFCLK_CEB_MASK;
 	}
 
+	/* The IBUFDS control has the reference clocks of both directions. */
+	XVphy_RegLock(InstancePtr);
 	RegVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr, RegAddr);
 
 	if (Enable) {
@@ -1353,6 +1391,7 @@ void XVphy_IBufDsEnable(XVphy *InstancePtr, u8 QuadId, XVphy_DirectionType Dir,
 		RegVal |= MaskVal;
 	}
 	XVphy_WriteReg(InstancePtr->Config.BaseAddr, RegAddr, RegVal);
+	XVphy_RegUnlock(InstancePtr);
 }
 
 /*****************************************************************************/
@@ -1745,8 +1784,10 @@ void XVphy_RegisterDebug(XVphy *InstancePtr)
 		xil_printf("Offset   |  Value\r\n");
 		xil_printf("----------------------------\r\n");
 		for (DrpAddr = 0x0000; DrpAddr <= MaxDrpAddr; DrpAddr++) {
+			XVphy_RegLock(InstancePtr);
 			XVphy_DrpRd(InstancePtr, 0, XVPHY_CHANNEL_ID_CMN0,
 					DrpAddr, &DrpVal);
+			XVphy_RegUnlock(InstancePtr);
 			xil_printf("0x%04x      0x%04x\r\n",DrpAddr, DrpVal);
 		}
 	} else {
@@ -1778,7 +1819,9 @@ void XVphy_RegisterDebug(XVphy *InstancePtr)
 	xil_printf("Offset   |  Value\r\n");
 	xil_printf("-------------------------------\r\n");
 		for (DrpAddr = 0x0000; DrpAddr <= MaxDrpAddr; DrpAddr++) {
+			XVphy_RegLock(InstancePtr);
 			XVphy_DrpRd(InstancePtr, 0, ChId, DrpAddr, &DrpVal);
+			XVphy_RegUnlock(InstancePtr);
 			xil_printf("0x%04x      0x%04x\r\n",DrpAddr, DrpVal);
 		}
 	}
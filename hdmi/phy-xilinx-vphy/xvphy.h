@@ -86,6 +86,8 @@
  *                     Added XVphy_SetTxPostCursor API
  * 1.9   gm   14/05/18 Added XVphy_SetRxLpm from xvphy_i.c/.h
  *                     Removed deprecated XVphy_HdmiInitialize API
+ * 1.10  XLNX 10/18/26 Added XVphy_SetRegLockHandler API and RegLockHandler
+ *                       to serialize the registers shared by TX and RX
  * </pre>
  *
 *******************************************************************************/
@@ -450,6 +452,22 @@ typedef void (*XVphy_IntrHandler)(void *InstancePtr);
 *******************************************************************************/
 typedef void (*XVphy_TimerHandler)(void *InstancePtr, u32 MicroSeconds);
 
+/******************************************************************************/
+/**
+ * Callback type which serializes the sections of the driver that access
+ * resources shared by the TX and RX directions of a quad: the DRP ports of
+ * the GT channels and of the QPLLs, the control registers with fields of
+ * both directions and the event log. Registers of one direction are not
+ * covered, accesses to them are serialized by the user of that direction.
+ *
+ * @param	CallbackRef is a pointer to the callback reference.
+ * @param	Lock is TRUE to enter a section and FALSE to leave it.
+ *
+ * @note	Sections do not nest and do not call back into the user.
+ *
+*******************************************************************************/
+typedef void (*XVphy_RegLockHandler)(void *CallbackRef, u8 Lock);
+
 /******************************************************************************/
 /**
  * Generic callback type.
@@ -822,6 +840,15 @@ typedef struct {
 	void *UserTimerPtr;			/**< Pointer to a timer instance
 							used by the custom user
 							delay/sleep function. */
+	u32 IntrHoldMask;			/**< Interrupt status bits that
+							are left pending by the
+							interrupt handlers. */
+	XVphy_RegLockHandler RegLockHandler;	/**< Custom user function to
+							serialize the resources
+							shared by TX and RX. */
+	void *RegLockRef;			/**< To be passed to the
+							register lock
+							function. */
 } XVphy;
 
 /**************************** Function Prototypes *****************************/
@@ -841,6 +868,8 @@ u32 XVphy_GetVersion(XVphy *InstancePtr);
 void XVphy_WaitUs(XVphy *InstancePtr, u32 MicroSeconds);
 void XVphy_SetUserTimerHandler(XVphy *InstancePtr,
 		XVphy_TimerHandler CallbackFunc, void *CallbackRef);
+void XVphy_SetRegLockHandler(XVphy *InstancePtr,
+		XVphy_RegLockHandler CallbackFunc, void *CallbackRef);
 
 /* xvphy.c: Channel configuration functions - setters. */
 u32 XVphy_CfgLineRate(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
@@ -75,6 +75,8 @@
  * 1.9   gm   14/05/18 Added TX and RX MMCM lock event logging
  *                     Removed deprecated XVphy_HdmiInitialize API
  * 1.10  rg  5/17/24 Added support for MMCM/PLL Clock Primitive
+ * 1.11  XLNX 10/18/26 The clock detector control register, shared by TX and
+ *                       RX, is accessed under the register lock
  *
  * </pre>
  *
@@ -541,6 +543,7 @@ void XVphy_ClkDetEnable(XVphy *InstancePtr, u8 Enable)
 	u32 RegVal;
 
 	/* Read clkdet ctrl register. */
+	XVphy_RegLock(InstancePtr);
 	RegVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
 			XVPHY_CLKDET_CTRL_REG);
 
@@ -553,6 +556,7 @@ void XVphy_ClkDetEnable(XVphy *InstancePtr, u8 Enable)
 	}
 	XVphy_WriteReg(InstancePtr->Config.BaseAddr, XVPHY_CLKDET_CTRL_REG,
 			RegVal);
+	XVphy_RegUnlock(InstancePtr);
 }
 
 /*****************************************************************************/
@@ -577,6 +581,7 @@ void XVphy_ClkDetTimerClear(XVphy *InstancePtr, u8 QuadId,
 	QuadId = QuadId;
 
 	/* Read the clock detector control register. */
+	XVphy_RegLock(InstancePtr);
 	RegVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
 			XVPHY_CLKDET_CTRL_REG);
 
@@ -590,6 +595,7 @@ void XVphy_ClkDetTimerClear(XVphy *InstancePtr, u8 QuadId,
 	/* Write new value to clkdet ctrl register. */
 	XVphy_WriteReg(InstancePtr->Config.BaseAddr, XVPHY_CLKDET_CTRL_REG,
 			RegVal);
+	XVphy_RegUnlock(InstancePtr);
 }
 
 /*****************************************************************************/
@@ -614,6 +620,7 @@ void XVphy_ClkDetFreqReset(XVphy *InstancePtr, u8 QuadId,
 	QuadId = QuadId;
 
 	/* Read clkdet ctrl register. */
+	XVphy_RegLock(InstancePtr);
 	RegVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
 			XVPHY_CLKDET_CTRL_REG);
 
@@ -627,6 +634,7 @@ void XVphy_ClkDetFreqReset(XVphy *InstancePtr, u8 QuadId,
 	/* Write new value to clkdet ctrl register. */
 	XVphy_WriteReg(InstancePtr->Config.BaseAddr, XVPHY_CLKDET_CTRL_REG,
 			RegVal);
+	XVphy_RegUnlock(InstancePtr);
 }
 
 /*****************************************************************************/
@@ -646,6 +654,7 @@ void XVphy_ClkDetSetFreqLockThreshold(XVphy *InstancePtr, u16 ThresholdVal)
 	u32 RegVal;
 
 	/* Read clkdet ctrl register. */
+	XVphy_RegLock(InstancePtr);
 	RegVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
 			XVPHY_CLKDET_CTRL_REG);
 	RegVal &= ~XVPHY_CLKDET_CTRL_RX_FREQ_RST_MASK;
@@ -656,6 +665,7 @@ void XVphy_ClkDetSetFreqLockThreshold(XVphy *InstancePtr, u16 ThresholdVal)
 	/* Write new value to clkdet ctrl register. */
 	XVphy_WriteReg(InstancePtr->Config.BaseAddr, XVPHY_CLKDET_CTRL_REG,
 			RegVal);
+	XVphy_RegUnlock(InstancePtr);
 }
 
 /*****************************************************************************/
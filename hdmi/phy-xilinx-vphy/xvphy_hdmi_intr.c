@@ -1174,7 +1174,8 @@ void XVphy_HdmiGtHandler(XVphy *InstancePtr)
 	u8 QuadId = 0;
 
 	/* Read Interrupt Status register */
-	Event = XVphy_ReadReg(InstancePtr->Config.BaseAddr, XVPHY_INTR_STS_REG);
+	Event = XVphy_ReadReg(InstancePtr->Config.BaseAddr, XVPHY_INTR_STS_REG) &
+			~InstancePtr->IntrHoldMask;
 
 	EventAck = EventMask & Event;
 
@@ -1247,7 +1248,8 @@ void XVphy_ClkDetHandler(XVphy *InstancePtr)
 				XVPHY_INTR_RXTMRTIMEOUT_MASK;
 
 	/* Read Interrupt Status register */
-	Event = XVphy_ReadReg(InstancePtr->Config.BaseAddr, XVPHY_INTR_STS_REG);
+	Event = XVphy_ReadReg(InstancePtr->Config.BaseAddr, XVPHY_INTR_STS_REG) &
+			~InstancePtr->IntrHoldMask;
 
 	EventAck = EventMask & Event;
 
@@ -38,6 +38,10 @@
  *                       XVphy_SetTxPreEmphasis to xvphy.c/h
  *            05/09/18 Added XVphy_GetRefClkSourcesCount API
  * 1.9   gm   11/04/18 Added XVphy_IsHDMI API
+ * 1.10  XLNX 10/18/26 Added XVphy_RegLock and XVphy_RegUnlock APIs, the
+ *                       shared registers and the channel and QPLL
+ *                       reconfiguration over DRP are accessed under the
+ *                       register lock
  * </pre>
  *
 *******************************************************************************/
@@ -80,6 +84,9 @@ u32 XVphy_WriteCfgRefClkSelReg(XVphy *InstancePtr, u8 QuadId)
 	/* Point to the first channel since settings apply to all channels. */
 	ChPtr = &InstancePtr->Quads[QuadId].Ch1;
 
+	/* The selections of both directions are in the same register. */
+	XVphy_RegLock(InstancePtr);
+
 	/* PllRefClkSel. */
 	/* - QPLL0. */
 	RegVal &= ~XVPHY_REF_CLK_SEL_QPLL0_MASK;
@@ -121,6 +128,7 @@ u32 XVphy_WriteCfgRefClkSelReg(XVphy *InstancePtr, u8 QuadId)
 	/* Write to hardware. */
 	XVphy_WriteReg(InstancePtr->Config.BaseAddr, XVPHY_REF_CLK_SEL_REG,
 			RegVal);
+	XVphy_RegUnlock(InstancePtr);
 
 	return XST_SUCCESS;
 }
@@ -720,6 +728,7 @@ u32 XVphy_PowerDownGtPll(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 		}
 	}
 
+	XVphy_RegLock(InstancePtr);
 	RegVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
 					XVPHY_POWERDOWN_CONTROL_REG);
 	RegVal |= MaskVal;
@@ -731,6 +740,7 @@ u32 XVphy_PowerDownGtPll(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 		XVphy_WriteReg(InstancePtr->Config.BaseAddr,
 					XVPHY_POWERDOWN_CONTROL_REG, RegVal);
 	}
+	XVphy_RegUnlock(InstancePtr);
 
 	return XST_SUCCESS;
 }
@@ -812,8 +822,10 @@ u32 XVphy_OutDivReconfig(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 
 	XVphy_Ch2Ids(InstancePtr, ChId, &Id0, &Id1);
 	for (Id = Id0; Id <= Id1; Id++) {
+		XVphy_RegLock(InstancePtr);
 		Status = XVphy_OutDivChReconfig(InstancePtr, QuadId,
 					(XVphy_ChannelId)Id, Dir);
+		XVphy_RegUnlock(InstancePtr);
 		if (Status != XST_SUCCESS) {
 			break;
 		}
@@ -857,6 +869,8 @@ u32 XVphy_DirReconfig(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 
 	XVphy_Ch2Ids(InstancePtr, ChId, &Id0, &Id1);
 	for (Id = Id0; Id <= Id1; Id++) {
+		/* TX and RX attributes share DRP addresses of the channel. */
+		XVphy_RegLock(InstancePtr);
 		if (Dir == XVPHY_DIR_TX) {
 			Status |= XVphy_TxChReconfig(InstancePtr, QuadId,
 											(XVphy_ChannelId)Id);
@@ -865,6 +879,7 @@ u32 XVphy_DirReconfig(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 			Status |= XVphy_RxChReconfig(InstancePtr, QuadId,
 											(XVphy_ChannelId)Id);
 		}
+		XVphy_RegUnlock(InstancePtr);
 		if (Status != XST_SUCCESS) {
 			Status = XST_FAILURE;
 			break;
@@ -903,8 +918,10 @@ u32 XVphy_ClkReconfig(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId)
 	XVphy_Ch2Ids(InstancePtr, ChId, &Id0, &Id1);
 	for (Id = Id0; Id <= Id1; Id++) {
 		if (XVPHY_ISCH(Id)) {
+			XVphy_RegLock(InstancePtr);
 			Status |= XVphy_ClkChReconfig(InstancePtr, QuadId,
 											(XVphy_ChannelId)Id);
+			XVphy_RegUnlock(InstancePtr);
 		}
 		else if (XVPHY_ISCMN(ChId)) {
 			if (((XVphy_IsHDMI(InstancePtr, XVPHY_DIR_TX)) ||
@@ -916,8 +933,10 @@ u32 XVphy_ClkReconfig(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId)
 				Status = XST_FAILURE;
 				return Status;
 			}
+			XVphy_RegLock(InstancePtr);
 			Status |= XVphy_ClkCmnReconfig(InstancePtr, QuadId,
 											(XVphy_ChannelId)Id);
+			XVphy_RegUnlock(InstancePtr);
 		}
 		if (Status != XST_SUCCESS) {
 			Status = XST_FAILURE;
@@ -941,6 +960,44 @@ u32 XVphy_ClkReconfig(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* This function enters a section that accesses resources shared by the TX and
+* RX directions of the quad, using the lock function installed with
+* XVphy_SetRegLockHandler.
+*
+* @param	InstancePtr is a pointer to the XVphy core instance.
+*
+* @return	None.
+*
+* @note		Sections must not nest.
+*
+******************************************************************************/
+void XVphy_RegLock(XVphy *InstancePtr)
+{
+	if (InstancePtr->RegLockHandler != NULL) {
+		InstancePtr->RegLockHandler(InstancePtr->RegLockRef, TRUE);
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function leaves a section entered with XVphy_RegLock.
+*
+* @param	InstancePtr is a pointer to the XVphy core instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XVphy_RegUnlock(XVphy *InstancePtr)
+{
+	if (InstancePtr->RegLockHandler != NULL) {
+		InstancePtr->RegLockHandler(InstancePtr->RegLockRef, FALSE);
+	}
+}
+
 /*****************************************************************************/
 /**
 * This function will set the channel IDs to correspond with the supplied
@@ -41,6 +41,7 @@
  *            05/09/18 Added XVphy_GetRefClkSourcesCount API
  * 1.9   gm   11/04/18 Added XVphy_IsHDMI API
  *                           Moved XVphy_SetRxLpm to xvphy.c/.h
+ * 1.10  XLNX 10/18/26 Added XVphy_RegLock and XVphy_RegUnlock APIs
  * </pre>
  *
  * @{
@@ -69,6 +70,8 @@ extern "C" {
 
 void XVphy_Ch2Ids(XVphy *InstancePtr, XVphy_ChannelId ChId,
 		u8 *Id0, u8 *Id1);
+void XVphy_RegLock(XVphy *InstancePtr);
+void XVphy_RegUnlock(XVphy *InstancePtr);
 XVphy_SysClkDataSelType Pll2SysClkData(XVphy_PllType PllSelect);
 XVphy_SysClkOutSelType Pll2SysClkOut(XVphy_PllType PllSelect);
 u32 XVphy_PllCalculator(XVphy *InstancePtr, u8 QuadId,
@@ -30,6 +30,8 @@
  * 1.0   als  10/19/15 Initial release.
  * 1.4   gm   29/11/16 Added XVphy_CfgErrIntr for ERR_IRQ impl
  * 1.6   gm   06/08/17 Added TX and RX MMCM locked handlers
+ * 1.10  XLNX 10/18/26 The interrupt enable, disable and error registers are
+ *                       accessed under the register lock
  * </pre>
  *
 *******************************************************************************/
@@ -57,9 +59,11 @@ void XVphy_IntrEnable(XVphy *InstancePtr, XVphy_IntrHandlerType Intr)
 {
 	u32 RegVal;
 
+	XVphy_RegLock(InstancePtr);
 	RegVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr, XVPHY_INTR_EN_REG);
 	RegVal |= Intr;
 	XVphy_WriteReg(InstancePtr->Config.BaseAddr, XVPHY_INTR_EN_REG, RegVal);
+	XVphy_RegUnlock(InstancePtr);
 }
 
 /******************************************************************************/
@@ -79,11 +83,13 @@ void XVphy_IntrDisable(XVphy *InstancePtr, XVphy_IntrHandlerType Intr)
 {
 	u32 RegVal;
 
+	XVphy_RegLock(InstancePtr);
 	RegVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
 			XVPHY_INTR_DIS_REG);
 	RegVal |= Intr;
 	XVphy_WriteReg(InstancePtr->Config.BaseAddr, XVPHY_INTR_DIS_REG,
 			RegVal);
+	XVphy_RegUnlock(InstancePtr);
 }
 
 /******************************************************************************/
@@ -205,7 +211,7 @@ void XVphy_InterruptHandler(XVphy *InstancePtr)
 
 	/* Determine what kind of interrupts have occurred. */
 	IntrStatus = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
-			XVPHY_INTR_STS_REG);
+			XVPHY_INTR_STS_REG) & ~InstancePtr->IntrHoldMask;
 
 	if (IntrStatus & XVPHY_INTR_CPLL_LOCK_MASK) {
 		InstancePtr->IntrCpllLockHandler(
@@ -276,6 +282,7 @@ void XVphy_CfgErrIntr(XVphy *InstancePtr, XVphy_ErrType ErrIrq, u8 Set)
 	u32 ErrIrqVal;
 	u32 WriteVal;
 
+	XVphy_RegLock(InstancePtr);
 	ErrIrqVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
 			XVPHY_ERR_IRQ);
 
@@ -290,4 +297,5 @@ void XVphy_CfgErrIntr(XVphy *InstancePtr, XVphy_ErrType ErrIrq, u8 Set)
 
 	XVphy_WriteReg(InstancePtr->Config.BaseAddr,
 				XVPHY_ERR_IRQ, ErrIrqVal);
+	XVphy_RegUnlock(InstancePtr);
 }
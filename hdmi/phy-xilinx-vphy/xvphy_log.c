@@ -40,6 +40,8 @@
  *                     Changed xil_printf new lines to \r\n
  *                     Added XVPHY_LOG_EVT_DRU_CLK_ERR log event
  * 1.7   gm   13/09/17 Added XVPHY_LOG_EVT_USRCLK_ERR event
+ * 1.10  XLNX 10/18/26 The log is written by TX and RX, it is accessed under
+ *                       the register lock
  * </pre>
  *
 *******************************************************************************/
@@ -107,6 +109,8 @@ void XVphy_LogWrite(XVphy *InstancePtr, XVphy_LogEvent Evt, u8 Data)
 	Xil_AssertVoid(Evt <= (XVPHY_LOG_EVT_DUMMY));
 	Xil_AssertVoid(Data < 0xFF);
 
+	XVphy_RegLock(InstancePtr);
+
 	/* Write data and event into log buffer */
 	InstancePtr->Log.DataBuffer[InstancePtr->Log.HeadIndex] =
 			(Data << 8) | Evt;
@@ -134,6 +138,8 @@ void XVphy_LogWrite(XVphy *InstancePtr, XVphy_LogEvent Evt, u8 Data)
 			InstancePtr->Log.TailIndex++;
 		}
 	}
+
+	XVphy_RegUnlock(InstancePtr);
 }
 #endif
 
@@ -156,6 +162,8 @@ u16 XVphy_LogRead(XVphy *InstancePtr)
 	/* Verify argument. */
 	Xil_AssertNonvoid(InstancePtr != NULL);
 
+	XVphy_RegLock(InstancePtr);
+
 	/* Check if there is any data in the log */
 	if (InstancePtr->Log.TailIndex == InstancePtr->Log.HeadIndex) {
 		Log = 0;
@@ -173,6 +181,8 @@ u16 XVphy_LogRead(XVphy *InstancePtr)
 		}
 	}
 
+	XVphy_RegUnlock(InstancePtr);
+
 	return Log;
 #endif
 }
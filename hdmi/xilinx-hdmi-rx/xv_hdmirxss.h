@@ -82,6 +82,8 @@
 *       YB     17/08/18 Marked XV_HDMIRXSS_HDCP_1_PROT_EVT and
 *                           XV_HDMIRXSS_HDCP_2_PROT_EVT as deprecated.
 * 5.40  EB     06/08/19 Added Vic and Video Timing mismatch callback support
+* 5.41  XLNX   10/18/26 Made the HDCP event queue a lock-free single
+*                       producer single consumer ring with coalescing
 * </pre>
 *
 ******************************************************************************/
@@ -109,7 +111,8 @@ extern "C" {
 #define USE_HDCP_22_PROT_EVT_ENUM
 #pragma message ("'XV_HDMIRXSS_HDCP_2_PROT_EVT' event is deprecated")
 #define XV_HDMIRXSS_HDCP_KEYSEL 0x00u
-#define XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE 16
+/* Must be a power of two dividing 256, the Head and Tail counters wrap at 256 */
+#define XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE 32
 #endif
 
 #ifdef XPAR_XHDCP_NUM_INSTANCES
@@ -257,8 +260,14 @@ typedef enum
 typedef struct
 {
   XV_HdmiRxSs_HdcpEvent Queue[XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE]; /**< Data */
-  u8                    Tail;      /**< Tail pointer */
-  u8                    Head;      /**< Head pointer */
+  u8                    Tail;      /**< Tail counter, consumer only */
+  u8                    Head;      /**< Head counter, producer only */
+  u32                   Overflow;  /**< Events dropped on a full queue */
+  u32                   Coalesced; /**< Events merged or cancelled */
+  XV_HdmiRxSs_HdcpEvent LinkEvent; /**< Last connect or disconnect
+                                       pushed, producer only */
+  XV_HdmiRxSs_HdcpEvent LinkEventTaken; /**< Last connect or disconnect
+                                            taken, consumer only */
 } XV_HdmiRxSs_HdcpEventQueue;
 #endif
 
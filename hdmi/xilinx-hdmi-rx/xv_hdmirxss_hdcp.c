@@ -30,12 +30,17 @@
 * 3.2    MH  04/07/17 Fixed issue to prevent HDCP protocol switching when only
 *                     one protocol is in the design.
 *        MH  09/08/17 Added function XV_HdmiRxSs_HdcpSetCapability
+* 5.41   XLNX 10/18/26 Made the HDCP event queue a lock-free single producer
+*                     single consumer ring, drained and coalesced in one pass
+*                     XV_HdmiRxSs_HdcpTimerBusyDelay sleeps on a software
+*                     timer
 * </pre>
 *
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
 #include <linux/version.h>
+#include <asm/barrier.h>
 #include "xv_hdmirxss.h"
 /************************** Constant Definitions *****************************/
 
@@ -44,7 +49,8 @@
 /************************** Function Prototypes ******************************/
 // HDCP specific
 #ifdef USE_HDCP_RX
-static XV_HdmiRxSs_HdcpEvent XV_HdmiRxSs_HdcpGetEvent(XV_HdmiRxSs *InstancePtr);
+static int XV_HdmiRxSs_HdcpGetEvents(XV_HdmiRxSs *InstancePtr,
+                                     XV_HdmiRxSs_HdcpEvent *EventsPtr);
 static int XV_HdmiRxSs_HdcpProcessEvents(XV_HdmiRxSs *InstancePtr);
 static int XV_HdmiRxSs_HdcpReset(XV_HdmiRxSs *InstancePtr);
 static int XV_HdmiRxSs_HdcpSetTopologyDepth(XV_HdmiRxSs *InstancePtr, u32 Depth);
@@ -317,7 +323,8 @@ int XV_HdmiRxSs_HdcpTimerBusyDelay(void *InstancePtr, u16 DelayInMs)
   XTmrCtr_SetResetValue(TimerPtr, TimerChannel, NumTicks);
   XTmrCtr_Start(TimerPtr, TimerChannel);
 
-  /* Wait until done */
+  /* Wait until done, a software timer sleeps instead of spinning */
+  XTmrCtr_SoftWait(TimerPtr, TimerChannel);
   while (!XTmrCtr_IsExpired(TimerPtr, TimerChannel));
 
   return (XST_SUCCESS);
@@ -330,46 +337,63 @@ int XV_HdmiRxSs_HdcpTimerBusyDelay(void *InstancePtr, u16 DelayInMs)
 *
 * This function pushes an event into the HDCP event queue.
 *
+* The queue is a single producer single consumer ring: only this function
+* writes the head counter and only XV_HdmiRxSs_HdcpGetEvents and
+* XV_HdmiRxSs_HdcpClearEvents write the tail counter, so the interrupt
+* handlers can push while the poll function drains without a lock.
+* An event equal to the most recent pending event is merged with it. When
+* the queue is full the event is dropped and counted in Overflow. A connect
+* or disconnect is also latched in LinkEvent before it is queued, so that
+* the consumer still sees the last link state change if it was dropped.
+*
 * @param InstancePtr is a pointer to the XV_HdmiRxSs instance.
 * @param Event is the event to be pushed in the queue.
 *
 * @return
 *  - XST_SUCCESS if action was successful
-*  - XST_FAILURE if action was not successful
+*  - XST_FAILURE if the queue is full
 *
 * @note   None.
 *
 ******************************************************************************/
 int XV_HdmiRxSs_HdcpPushEvent(XV_HdmiRxSs *InstancePtr, XV_HdmiRxSs_HdcpEvent Event)
 {
+  XV_HdmiRxSs_HdcpEventQueue *QueuePtr;
+  u8 Head;
+  u8 Tail;
+
   /* Verify argument. */
   Xil_AssertNonvoid(InstancePtr != NULL);
   Xil_AssertNonvoid(Event < XV_HDMIRXSS_HDCP_INVALID_EVT);
 
-  /* Write event into the queue */
-  InstancePtr->HdcpEventQueue.Queue[InstancePtr->HdcpEventQueue.Head] = Event;
+  QueuePtr = &InstancePtr->HdcpEventQueue;
 
-  /* Update head pointer */
-  if (InstancePtr->HdcpEventQueue.Head == (XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE - 1)) {
-    InstancePtr->HdcpEventQueue.Head = 0;
+  if ((Event == XV_HDMIRXSS_HDCP_CONNECT_EVT) ||
+      (Event == XV_HDMIRXSS_HDCP_DISCONNECT_EVT)) {
+    smp_store_release(&QueuePtr->LinkEvent, Event);
   }
-  else {
-    InstancePtr->HdcpEventQueue.Head++;
+
+  Head = QueuePtr->Head;
+  Tail = smp_load_acquire(&QueuePtr->Tail);
+
+  /* Merge with the most recent pending event. Should the consumer take
+   * that event at the same time, it is still processed once, which is all
+   * a repeated event asks for. */
+  if ((Head != Tail) &&
+      (QueuePtr->Queue[(u8)(Head - 1) % XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE] == Event)) {
+    QueuePtr->Coalesced++;
+    return XST_SUCCESS;
   }
 
-  /* Check tail pointer. When the two pointer are equal, then the buffer
-   * is full. In this case then increment the tail pointer as well to
-   * remove the oldest entry from the buffer.
-   */
-  if (InstancePtr->HdcpEventQueue.Tail == InstancePtr->HdcpEventQueue.Head) {
-    if (InstancePtr->HdcpEventQueue.Tail == (XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE - 1)) {
-      InstancePtr->HdcpEventQueue.Tail = 0;
-    }
-    else {
-      InstancePtr->HdcpEventQueue.Tail++;
-    }
+  if ((u8)(Head - Tail) == XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE) {
+    QueuePtr->Overflow++;
+    return XST_FAILURE;
   }
 
+  /* Write event into the queue before publishing it */
+  QueuePtr->Queue[Head % XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE] = Event;
+  smp_store_release(&QueuePtr->Head, (u8)(Head + 1));
+
   return XST_SUCCESS;
 }
 #endif
@@ -378,39 +402,104 @@ int XV_HdmiRxSs_HdcpPushEvent(XV_HdmiRxSs *InstancePtr, XV_HdmiRxSs_HdcpEvent Ev
 /*****************************************************************************/
 /**
 *
-* This function gets an event from the HDCP event queue.
+* This function appends an event taken from the HDCP event queue to the
+* events to be processed, coalescing it with the events already there:
+* repeated events are merged into one, a connect or disconnect that repeats
+* the current link state is merged and a connect directly followed by a
+* disconnect cancels out.
+*
+* @param QueuePtr is a pointer to the HDCP event queue.
+* @param EventsPtr is a pointer to the events to be processed.
+* @param Count is the number of events in EventsPtr.
+* @param Event is the event to append.
+*
+* @return The new number of events in EventsPtr.
+*
+* @note   None.
+*
+******************************************************************************/
+static int XV_HdmiRxSs_HdcpAddEvent(XV_HdmiRxSs_HdcpEventQueue *QueuePtr,
+                                    XV_HdmiRxSs_HdcpEvent *EventsPtr,
+                                    int Count, XV_HdmiRxSs_HdcpEvent Event)
+{
+  if ((Event == XV_HDMIRXSS_HDCP_CONNECT_EVT) ||
+      (Event == XV_HDMIRXSS_HDCP_DISCONNECT_EVT)) {
+    if (Event == QueuePtr->LinkEventTaken) {
+      QueuePtr->Coalesced++;
+      return Count;
+    }
+    QueuePtr->LinkEventTaken = Event;
+  }
+
+  if ((Count > 0) && (EventsPtr[Count - 1] == Event)) {
+    QueuePtr->Coalesced++;
+  }
+  else if ((Count > 0) &&
+           (EventsPtr[Count - 1] == XV_HDMIRXSS_HDCP_CONNECT_EVT) &&
+           (Event == XV_HDMIRXSS_HDCP_DISCONNECT_EVT)) {
+    Count--;
+    QueuePtr->Coalesced += 2;
+  }
+  else {
+    EventsPtr[Count++] = Event;
+  }
+
+  return Count;
+}
+#endif
+
+#ifdef USE_HDCP_RX
+/*****************************************************************************/
+/**
+*
+* This function takes all pending events from the HDCP event queue and
+* coalesces them, see XV_HdmiRxSs_HdcpAddEvent. A connect or disconnect
+* that was dropped on a full queue is recovered from the LinkEvent latch
+* and appended last, as it is newer than every queued event.
 *
 * @param InstancePtr is a pointer to the XV_HdmiRxSs instance.
+* @param EventsPtr is a pointer to an array of at least
+*        XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE + 1 events receiving the events.
 *
-* @return When the queue is filled, the next event is returned.
-*         When the queue is empty, XV_HDMIRXSS_HDCP_NO_EVT is returned.
+* @return The number of events written to EventsPtr.
 *
 * @note   None.
 *
 ******************************************************************************/
-static XV_HdmiRxSs_HdcpEvent XV_HdmiRxSs_HdcpGetEvent(XV_HdmiRxSs *InstancePtr)
+static int XV_HdmiRxSs_HdcpGetEvents(XV_HdmiRxSs *InstancePtr,
+                                     XV_HdmiRxSs_HdcpEvent *EventsPtr)
 {
+  XV_HdmiRxSs_HdcpEventQueue *QueuePtr;
   XV_HdmiRxSs_HdcpEvent Event;
+  int Count = 0;
+  u8 Head;
+  u8 Tail;
 
   /* Verify argument. */
   Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(EventsPtr != NULL);
 
-  /* Check if there are any events in the queue */
-  if (InstancePtr->HdcpEventQueue.Tail == InstancePtr->HdcpEventQueue.Head) {
-    return XV_HDMIRXSS_HDCP_NO_EVT;
+  QueuePtr = &InstancePtr->HdcpEventQueue;
+  Tail = QueuePtr->Tail;
+  Head = smp_load_acquire(&QueuePtr->Head);
+
+  while (Tail != Head) {
+    Event = QueuePtr->Queue[Tail % XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE];
+    Tail++;
+    Count = XV_HdmiRxSs_HdcpAddEvent(QueuePtr, EventsPtr, Count, Event);
   }
 
-  Event = InstancePtr->HdcpEventQueue.Queue[InstancePtr->HdcpEventQueue.Tail];
+  /* Release the slots to the producer */
+  smp_store_release(&QueuePtr->Tail, Tail);
 
-  /* Update tail pointer */
-  if (InstancePtr->HdcpEventQueue.Tail == (XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE - 1)) {
-    InstancePtr->HdcpEventQueue.Tail = 0;
-  }
-  else {
-    InstancePtr->HdcpEventQueue.Tail++;
+  /* The latch is read after the queue, a connect or disconnect that is
+   * still queued behind Head is then merged when it is taken later */
+  Event = smp_load_acquire(&QueuePtr->LinkEvent);
+  if (Event != XV_HDMIRXSS_HDCP_NO_EVT) {
+    Count = XV_HdmiRxSs_HdcpAddEvent(QueuePtr, EventsPtr, Count, Event);
   }
 
-  return Event;
+  return Count;
 }
 #endif
 
@@ -426,7 +515,8 @@ static XV_HdmiRxSs_HdcpEvent XV_HdmiRxSs_HdcpGetEvent(XV_HdmiRxSs *InstancePtr)
 *  - XST_SUCCESS if action was successful
 *  - XST_FAILURE if action was not successful
 *
-* @note   None.
+* @note   This function acts as the consumer of the queue and must not run
+*         concurrently with XV_HdmiRxSs_HdcpPoll.
 *
 ******************************************************************************/
 int XV_HdmiRxSs_HdcpClearEvents(XV_HdmiRxSs *InstancePtr)
@@ -434,8 +524,11 @@ int XV_HdmiRxSs_HdcpClearEvents(XV_HdmiRxSs *InstancePtr)
   /* Verify argument. */
   Xil_AssertNonvoid(InstancePtr != NULL);
 
-  InstancePtr->HdcpEventQueue.Head = 0;
-  InstancePtr->HdcpEventQueue.Tail = 0;
+  smp_store_release(&InstancePtr->HdcpEventQueue.Tail,
+                    smp_load_acquire(&InstancePtr->HdcpEventQueue.Head));
+  /* The cleared link state changes are not replayed from the latch */
+  InstancePtr->HdcpEventQueue.LinkEventTaken =
+                    smp_load_acquire(&InstancePtr->HdcpEventQueue.LinkEvent);
 
   return XST_SUCCESS;
 }
@@ -445,7 +538,8 @@ int XV_HdmiRxSs_HdcpClearEvents(XV_HdmiRxSs *InstancePtr)
 /*****************************************************************************/
 /**
 *
-* This function processes pending events from the HDCP event queue.
+* This function processes all pending events from the HDCP event queue
+* in one pass.
 *
 * @param InstancePtr is a pointer to the XV_HdmiRxSs instance.
 *
@@ -458,122 +552,125 @@ int XV_HdmiRxSs_HdcpClearEvents(XV_HdmiRxSs *InstancePtr)
 ******************************************************************************/
 static int XV_HdmiRxSs_HdcpProcessEvents(XV_HdmiRxSs *InstancePtr)
 {
-  XV_HdmiRxSs_HdcpEvent Event;
+  XV_HdmiRxSs_HdcpEvent Events[XV_HDMIRXSS_HDCP_MAX_QUEUE_SIZE + 1];
+  int Count;
+  int i;
   int Status = XST_SUCCESS;
 
   /* Verify argument */
   Xil_AssertNonvoid(InstancePtr != NULL);
 
-  Event = XV_HdmiRxSs_HdcpGetEvent(InstancePtr);
-
-  switch (Event) {
+  Count = XV_HdmiRxSs_HdcpGetEvents(InstancePtr, Events);
+  for (i = 0; i < Count; i++) {
+    switch (Events[i]) {
 
-    // Stream up
-    case XV_HDMIRXSS_HDCP_STREAMUP_EVT :
-      break;
+      // Stream up
+      case XV_HDMIRXSS_HDCP_STREAMUP_EVT :
+        break;
 
-    // Stream down
-    case XV_HDMIRXSS_HDCP_STREAMDOWN_EVT :
+      // Stream down
+      case XV_HDMIRXSS_HDCP_STREAMDOWN_EVT :
 #ifdef XPAR_XHDCP_NUM_INSTANCES
-      if (InstancePtr->Hdcp14Ptr) {
-        XHdcp1x_SetHdmiMode(InstancePtr->Hdcp14Ptr, FALSE);
-      }
+        if (InstancePtr->Hdcp14Ptr) {
+          XHdcp1x_SetHdmiMode(InstancePtr->Hdcp14Ptr, FALSE);
+        }
 #endif
-      break;
+        break;
 
-    // Connect
-    case XV_HDMIRXSS_HDCP_CONNECT_EVT :
+      // Connect
+      case XV_HDMIRXSS_HDCP_CONNECT_EVT :
 #ifdef XPAR_XHDCP_NUM_INSTANCES
-      if (InstancePtr->Hdcp14Ptr) {
-        // Set physical state
-        XHdcp1x_SetPhysicalState(InstancePtr->Hdcp14Ptr, TRUE);
-        XHdcp1x_Poll(InstancePtr->Hdcp14Ptr); // This is needed to ensure that the previous command is executed.
-      }
+        if (InstancePtr->Hdcp14Ptr) {
+          // Set physical state
+          XHdcp1x_SetPhysicalState(InstancePtr->Hdcp14Ptr, TRUE);
+          XHdcp1x_Poll(InstancePtr->Hdcp14Ptr); // This is needed to ensure that the previous command is executed.
+        }
 #endif
-      XV_HdmiRxSs_HdcpSetProtocol(InstancePtr, InstancePtr->HdcpProtocol);
-      break;
+        XV_HdmiRxSs_HdcpSetProtocol(InstancePtr, InstancePtr->HdcpProtocol);
+        break;
 
-    // Disconnect
-    // Enable the previous HDCP protocol
-    case XV_HDMIRXSS_HDCP_DISCONNECT_EVT :
+      // Disconnect
+      // Enable the previous HDCP protocol
+      case XV_HDMIRXSS_HDCP_DISCONNECT_EVT :
 #ifdef XPAR_XHDCP_NUM_INSTANCES
-      if (InstancePtr->Hdcp14Ptr) {
-        // Clear HDMI mode
-        XHdcp1x_SetHdmiMode(InstancePtr->Hdcp14Ptr, FALSE);
+        if (InstancePtr->Hdcp14Ptr) {
+          // Clear HDMI mode
+          XHdcp1x_SetHdmiMode(InstancePtr->Hdcp14Ptr, FALSE);
 
-        // Set physical state
-        XHdcp1x_SetPhysicalState(InstancePtr->Hdcp14Ptr, FALSE);
-        XHdcp1x_Poll(InstancePtr->Hdcp14Ptr); // This is needed to ensure that the previous command is executed.
-      }
+          // Set physical state
+          XHdcp1x_SetPhysicalState(InstancePtr->Hdcp14Ptr, FALSE);
+          XHdcp1x_Poll(InstancePtr->Hdcp14Ptr); // This is needed to ensure that the previous command is executed.
+        }
 #endif
-      break;
+        break;
 
 #ifdef USE_HDCP_14_PROT_EVT_ENUM
-    // HDCP 1.4 protocol event
-    // Enable HDCP 1.4
-    case XV_HDMIRXSS_HDCP_1_PROT_EVT :
+      // HDCP 1.4 protocol event
+      // Enable HDCP 1.4
+      case XV_HDMIRXSS_HDCP_1_PROT_EVT :
 #if defined(XPAR_XHDCP_NUM_INSTANCES) && defined(XPAR_XHDCP22_RX_NUM_INSTANCES)
-      if (InstancePtr->Hdcp14Ptr && InstancePtr->Hdcp22Ptr) {
-        if(XV_HdmiRxSs_HdcpSetProtocol(InstancePtr, XV_HDMIRXSS_HDCP_14) != XST_SUCCESS) {
-          XV_HdmiRxSs_HdcpSetProtocol(InstancePtr, XV_HDMIRXSS_HDCP_22);
+        if (InstancePtr->Hdcp14Ptr && InstancePtr->Hdcp22Ptr) {
+          if(XV_HdmiRxSs_HdcpSetProtocol(InstancePtr, XV_HDMIRXSS_HDCP_14) != XST_SUCCESS) {
+            XV_HdmiRxSs_HdcpSetProtocol(InstancePtr, XV_HDMIRXSS_HDCP_22);
+          }
         }
-      }
 #endif
-      break;
+        break;
 #endif
 
 #ifdef USE_HDCP_22_PROT_EVT_ENUM
-    // HDCP 2.2 protocol event
-    // Enable HDCP 2.2
-    case XV_HDMIRXSS_HDCP_2_PROT_EVT :
+      // HDCP 2.2 protocol event
+      // Enable HDCP 2.2
+      case XV_HDMIRXSS_HDCP_2_PROT_EVT :
 #if defined(XPAR_XHDCP_NUM_INSTANCES) && defined(XPAR_XHDCP22_RX_NUM_INSTANCES)
-      if (InstancePtr->Hdcp14Ptr && InstancePtr->Hdcp22Ptr) {
-        if(XV_HdmiRxSs_HdcpSetProtocol(InstancePtr, XV_HDMIRXSS_HDCP_22) != XST_SUCCESS) {
-          XV_HdmiRxSs_HdcpSetProtocol(InstancePtr, XV_HDMIRXSS_HDCP_14);
+        if (InstancePtr->Hdcp14Ptr && InstancePtr->Hdcp22Ptr) {
+          if(XV_HdmiRxSs_HdcpSetProtocol(InstancePtr, XV_HDMIRXSS_HDCP_22) != XST_SUCCESS) {
+            XV_HdmiRxSs_HdcpSetProtocol(InstancePtr, XV_HDMIRXSS_HDCP_14);
+          }
         }
-      }
 #endif
-      break;
+        break;
 #endif
 
-    // DVI mode event
-    case XV_HDMIRXSS_HDCP_DVI_MODE_EVT:
+      // DVI mode event
+      case XV_HDMIRXSS_HDCP_DVI_MODE_EVT:
 #ifdef XPAR_XHDCP_NUM_INSTANCES
-      if (InstancePtr->Hdcp14Ptr) {
-        XHdcp1x_SetHdmiMode(InstancePtr->Hdcp14Ptr, FALSE);
-      }
+        if (InstancePtr->Hdcp14Ptr) {
+          XHdcp1x_SetHdmiMode(InstancePtr->Hdcp14Ptr, FALSE);
+        }
 #endif
-      break;
+        break;
 
-    // HDMI mode event
-    case XV_HDMIRXSS_HDCP_HDMI_MODE_EVT:
+      // HDMI mode event
+      case XV_HDMIRXSS_HDCP_HDMI_MODE_EVT:
 #ifdef XPAR_XHDCP_NUM_INSTANCES
-      if (InstancePtr->Hdcp14Ptr) {
-        XHdcp1x_SetHdmiMode(InstancePtr->Hdcp14Ptr, TRUE);
-      }
+        if (InstancePtr->Hdcp14Ptr) {
+          XHdcp1x_SetHdmiMode(InstancePtr->Hdcp14Ptr, TRUE);
+        }
 #endif
-      break;
+        break;
 
-    // Sync loss event
-    case XV_HDMIRXSS_HDCP_SYNC_LOSS_EVT:
+      // Sync loss event
+      case XV_HDMIRXSS_HDCP_SYNC_LOSS_EVT:
 #ifdef XPAR_XHDCP_NUM_INSTANCES
-      if (InstancePtr->Hdcp14Ptr) {
-        XHdcp1x_SetHdmiMode(InstancePtr->Hdcp14Ptr, FALSE);
-      }
+        if (InstancePtr->Hdcp14Ptr) {
+          XHdcp1x_SetHdmiMode(InstancePtr->Hdcp14Ptr, FALSE);
+        }
 #endif
-      break;
+        break;
 
       // Sync est/recover event
       case XV_HDMIRXSS_HDCP_SYNC_EST_EVT:
-  #ifdef XPAR_XHDCP_NUM_INSTANCES
+#ifdef XPAR_XHDCP_NUM_INSTANCES
         if (InstancePtr->Hdcp14Ptr) {
           XHdcp1x_SetHdmiMode(InstancePtr->Hdcp14Ptr, TRUE);
         }
-  #endif
+#endif
         break;
 
-    default :
-      break;
+      default :
+        break;
+    }
   }
 
   return Status;
@@ -63,6 +63,10 @@
 *       EB     16/07/19 Replaced sampling rate of 4 with 2 at the API
 *                           XV_HdmiTx_SetSampleRate
 * 2.50  EB     02/12/18 Added 3D Audio Support
+* 2.60  XLNX   10/18/26 Added XV_HdmiTx_ScdcReadStatus,
+*                           XV_HdmiTx_ScdcGetTmdsConfig,
+*                           XV_HdmiTx_ScdcSetTmdsConfig and
+*                           XV_HdmiTx_ScdcSetReadRequest
 * </pre>
 *
 ******************************************************************************/
@@ -705,6 +709,185 @@ void XV_HdmiTx_ShowSCDC(XV_HdmiTx *InstancePtr)
     }
 }
 
+/*****************************************************************************/
+/**
+*
+* This function reads the sink SCDC status in a single DDC burst, from the
+* Update_0 flags up to the character error detection checksum, and clears
+* the Update flags that were set.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx core instance.
+* @param    StatusPtr is a pointer to the status to fill in.
+*
+* @return
+*       - XST_SUCCESS if the status was read
+*       - XST_FAILURE if the sink did not respond
+*
+* @note     The character error counts are only reported valid when the
+*       checksum of the error detection registers is correct.
+*
+******************************************************************************/
+int XV_HdmiTx_ScdcReadStatus(XV_HdmiTx *InstancePtr,
+    XV_HdmiTx_ScdcStatus *StatusPtr)
+{
+    u8 DdcBuf[XV_HDMITX_SCDC_ERR_DET_CHECKSUM - XV_HDMITX_SCDC_UPDATE_0 + 1];
+    u8 *CedPtr;
+    u8 Checksum;
+    u32 Status;
+    u32 Index;
+
+    /* Verify arguments. */
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(StatusPtr != NULL);
+
+    /* Offset Update_0 */
+    DdcBuf[0] = XV_HDMITX_SCDC_UPDATE_0;
+    Status = XV_HdmiTx_DdcWrite(InstancePtr, XV_HDMITX_SCDC_SLAVE, 1,
+        (u8*)&DdcBuf, (FALSE));
+    if (Status != (XST_SUCCESS)) {
+        return XST_FAILURE;
+    }
+
+    Status = XV_HdmiTx_DdcRead(InstancePtr, XV_HDMITX_SCDC_SLAVE,
+        sizeof(DdcBuf), (u8*)&DdcBuf, (TRUE));
+    if (Status != (XST_SUCCESS)) {
+        return XST_FAILURE;
+    }
+
+    StatusPtr->Update0 = DdcBuf[0];
+    StatusPtr->TmdsConfig =
+        DdcBuf[XV_HDMITX_SCDC_TMDS_CONFIG - XV_HDMITX_SCDC_UPDATE_0];
+    StatusPtr->ScramblerStatus =
+        DdcBuf[XV_HDMITX_SCDC_SCRAMBLER_STATUS - XV_HDMITX_SCDC_UPDATE_0];
+    StatusPtr->StatusFlags0 =
+        DdcBuf[XV_HDMITX_SCDC_STATUS_FLAGS_0 - XV_HDMITX_SCDC_UPDATE_0];
+
+    /* Err_Det_0_L up to the checksum sum up to zero */
+    CedPtr = &DdcBuf[XV_HDMITX_SCDC_ERR_DET_0_L - XV_HDMITX_SCDC_UPDATE_0];
+    Checksum = 0;
+    for (Index = 0;
+         Index <= (XV_HDMITX_SCDC_ERR_DET_CHECKSUM - XV_HDMITX_SCDC_ERR_DET_0_L);
+         Index++) {
+        Checksum += CedPtr[Index];
+    }
+
+    StatusPtr->CedValid = 0;
+    for (Index = 0; Index < XV_HDMITX_SCDC_CHANNELS; Index++) {
+        StatusPtr->Ced[Index] = CedPtr[2 * Index] |
+            ((CedPtr[(2 * Index) + 1] & 0x7F) << 8);
+        if ((Checksum == 0) &&
+            (CedPtr[(2 * Index) + 1] & XV_HDMITX_SCDC_ERR_DET_VALID_MASK)) {
+            StatusPtr->CedValid |= (1 << Index);
+        }
+    }
+
+    /* The Update flags are cleared by writing them back */
+    if (StatusPtr->Update0) {
+        DdcBuf[0] = XV_HDMITX_SCDC_UPDATE_0;
+        DdcBuf[1] = StatusPtr->Update0;
+        (void)XV_HdmiTx_DdcWrite(InstancePtr, XV_HDMITX_SCDC_SLAVE, 2,
+            (u8*)&DdcBuf, (TRUE));
+    }
+
+    return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the SCDC TMDS_Config value matching the current
+* scrambler and TMDS clock ratio settings of the HDMI TX.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx core instance.
+*
+* @return   TMDS_Config value.
+*
+* @note     None.
+*
+******************************************************************************/
+u8 XV_HdmiTx_ScdcGetTmdsConfig(XV_HdmiTx *InstancePtr)
+{
+    u8 TmdsConfig = 0;
+
+    /* Verify argument. */
+    Xil_AssertNonvoid(InstancePtr != NULL);
+
+    if (InstancePtr->Stream.IsScrambled)
+        TmdsConfig |= XV_HDMITX_SCDC_TMDS_CONFIG_SCRAMBLING_MASK;
+
+    if (InstancePtr->Stream.TMDSClockRatio)
+        TmdsConfig |= XV_HDMITX_SCDC_TMDS_CONFIG_CLOCK_RATIO_MASK;
+
+    return TmdsConfig;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes the SCDC TMDS_Config of the sink in a single DDC
+* write, e.g. to restore the scrambler and TMDS clock ratio of a sink that
+* lost them.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx core instance.
+* @param    TmdsConfig is the TMDS_Config value,
+*       see XV_HdmiTx_ScdcGetTmdsConfig.
+*
+* @return
+*       - XST_SUCCESS if the write was successful
+*       - XST_FAILURE if the sink did not respond
+*
+* @note     None.
+*
+******************************************************************************/
+int XV_HdmiTx_ScdcSetTmdsConfig(XV_HdmiTx *InstancePtr, u8 TmdsConfig)
+{
+    u8 DdcBuf[2];
+
+    /* Verify argument. */
+    Xil_AssertNonvoid(InstancePtr != NULL);
+
+    DdcBuf[0] = XV_HDMITX_SCDC_TMDS_CONFIG;
+    DdcBuf[1] = TmdsConfig;
+
+    return XV_HdmiTx_DdcWrite(InstancePtr, XV_HDMITX_SCDC_SLAVE, 2,
+        (u8*)&DdcBuf, (TRUE));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function enables or disables the SCDC read request of the sink
+* (RR_Enable). With read requests enabled the sink holds SCL low to request
+* a read of the Update flags, see XV_HdmiTx_DdcIsReadRequest, so the status
+* does not have to be polled over the DDC.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx core instance.
+* @param    Enable specifies TRUE/FALSE value to enable/disable read
+*       requests.
+*
+* @return
+*       - XST_SUCCESS if the write was successful
+*       - XST_FAILURE if the sink did not respond
+*
+* @note     Only enable read requests for a sink that reports RR_Capable in
+*       its HDMI Forum VSDB.
+*
+******************************************************************************/
+int XV_HdmiTx_ScdcSetReadRequest(XV_HdmiTx *InstancePtr, u8 Enable)
+{
+    u8 DdcBuf[2];
+
+    /* Verify arguments. */
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid((Enable == (TRUE)) || (Enable == (FALSE)));
+
+    DdcBuf[0] = XV_HDMITX_SCDC_CONFIG_0;
+    DdcBuf[1] = Enable ? XV_HDMITX_SCDC_CONFIG_0_RR_ENABLE_MASK : 0;
+
+    return XV_HdmiTx_DdcWrite(InstancePtr, XV_HDMITX_SCDC_SLAVE, 2,
+        (u8*)&DdcBuf, (TRUE));
+}
+
 /*****************************************************************************/
 /**
 *
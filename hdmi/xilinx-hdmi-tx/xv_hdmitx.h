@@ -139,6 +139,7 @@
 *                           as deprecated
 *       MMO    11/08/18 Added Bridge Overflow and Bridge Underflow (PIO IN)
 * 2.5   EB     02/12/18 Added 3D Audio Support
+* 2.6   XLNX   10/18/26 Added SCDC status monitoring and read request APIs
 * </pre>
 *
 ******************************************************************************/
@@ -161,6 +162,30 @@ extern "C" {
 
 /************************** Constant Definitions *****************************/
 
+/** @name SCDC registers read by XV_HdmiTx_ScdcReadStatus
+* @{
+*/
+#define XV_HDMITX_SCDC_SLAVE                0x54
+#define XV_HDMITX_SCDC_UPDATE_0             0x10
+#define XV_HDMITX_SCDC_UPDATE_0_STATUS_MASK 0x01 /**< Status_Update */
+#define XV_HDMITX_SCDC_UPDATE_0_CED_MASK    0x02 /**< CED_Update */
+#define XV_HDMITX_SCDC_UPDATE_0_RR_TEST_MASK 0x04 /**< RR_Test */
+#define XV_HDMITX_SCDC_TMDS_CONFIG          0x20
+#define XV_HDMITX_SCDC_TMDS_CONFIG_SCRAMBLING_MASK 0x01
+#define XV_HDMITX_SCDC_TMDS_CONFIG_CLOCK_RATIO_MASK 0x02
+#define XV_HDMITX_SCDC_SCRAMBLER_STATUS     0x21
+#define XV_HDMITX_SCDC_SCRAMBLING_STATUS_MASK 0x01
+#define XV_HDMITX_SCDC_CONFIG_0             0x30
+#define XV_HDMITX_SCDC_CONFIG_0_RR_ENABLE_MASK 0x01
+#define XV_HDMITX_SCDC_STATUS_FLAGS_0       0x40
+#define XV_HDMITX_SCDC_STATUS_FLAGS_0_LOCK_MASK 0x0F /**< Clock and Ch0..2
+                                                    *  locked */
+#define XV_HDMITX_SCDC_ERR_DET_0_L          0x50
+#define XV_HDMITX_SCDC_ERR_DET_CHECKSUM     0x56
+#define XV_HDMITX_SCDC_ERR_DET_VALID_MASK   0x80 /**< In Err_Det_n_H */
+#define XV_HDMITX_SCDC_ERR_DET_MAX          0x7FFF
+#define XV_HDMITX_SCDC_CHANNELS             3
+/* @} */
 
 /**************************** Type Definitions *******************************/
 
@@ -243,6 +268,20 @@ typedef struct {
     u8                      SampleRate;         /**< Sample rate */
 } XV_HdmiTx_Stream;
 
+/**
+* This typedef contains the sink SCDC status read in one burst by
+* XV_HdmiTx_ScdcReadStatus.
+*/
+typedef struct {
+    u8 Update0;                 /**< Update_0 flags, cleared in the sink */
+    u8 TmdsConfig;              /**< TMDS_Config */
+    u8 ScramblerStatus;         /**< Scrambler_Status */
+    u8 StatusFlags0;            /**< Status_Flags_0 */
+    u8 CedValid;                /**< Bitmap of the channels with a valid
+                                  *  character error count */
+    u16 Ced[XV_HDMITX_SCDC_CHANNELS]; /**< Character errors per channel */
+} XV_HdmiTx_ScdcStatus;
+
 /**
 * Callback type for Vsync event interrupt.
 *
@@ -1052,6 +1091,26 @@ typedef struct {
     XV_HdmiTx_ReadReg((InstancePtr)->Config.BaseAddress, \
     (XV_HDMITX_MASK_CTRL_OFFSET)) & (XV_HDMITX_MASK_CTRL_RUN_MASK)
 
+/*****************************************************************************/
+/**
+*
+* This macro checks for a SCDC read request of the sink. With RR_Enable set,
+* the sink requests a read of the Update flags by holding SCL low while the
+* DDC is idle.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx core instance.
+*
+* @return   TRUE if the sink holds SCL low on an idle DDC, FALSE otherwise.
+*
+* @note     C-style signature:
+*       u8 XV_HdmiTx_DdcIsReadRequest(XV_HdmiTx *InstancePtr)
+*
+******************************************************************************/
+#define XV_HdmiTx_DdcIsReadRequest(InstancePtr) \
+    ((XV_HdmiTx_ReadReg((InstancePtr)->Config.BaseAddress, \
+    (XV_HDMITX_DDC_STA_OFFSET)) & ((XV_HDMITX_DDC_STA_BUSY_MASK) | \
+    (XV_HDMITX_DDC_STA_SCL_MASK))) == 0)
+
 /************************** Function Prototypes ******************************/
 
 /* Initialization function in xv_hdmitx_sinit.c */
@@ -1103,6 +1162,11 @@ int XV_HdmiTx_Scrambler(XV_HdmiTx *InstancePtr);
 int XV_HdmiTx_ClockRatio(XV_HdmiTx *InstancePtr);
 int XV_HdmiTx_DetectHdmi20(XV_HdmiTx *InstancePtr);
 void XV_HdmiTx_ShowSCDC(XV_HdmiTx *InstancePtr);
+int XV_HdmiTx_ScdcReadStatus(XV_HdmiTx *InstancePtr,
+    XV_HdmiTx_ScdcStatus *StatusPtr);
+u8 XV_HdmiTx_ScdcGetTmdsConfig(XV_HdmiTx *InstancePtr);
+int XV_HdmiTx_ScdcSetTmdsConfig(XV_HdmiTx *InstancePtr, u8 TmdsConfig);
+int XV_HdmiTx_ScdcSetReadRequest(XV_HdmiTx *InstancePtr, u8 Enable);
 void XV_HdmiTx_DebugInfo(XV_HdmiTx *InstancePtr);
 int XV_HdmiTx_SetAudioChannels(XV_HdmiTx *InstancePtr, u8 Value);
 int XV_HdmiTx_SetAudioFormat(XV_HdmiTx *InstancePtr, XV_HdmiTx_AudioFormatType Value);
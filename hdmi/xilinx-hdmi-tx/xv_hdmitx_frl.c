@@ -0,0 +1,805 @@
+/******************************************************************************
+*
+ *
+ * Copyright (C) 2015, 2016, 2017 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xv_hdmitx_frl.c
+*
+* This file contains the HDMI 2.1 FRL link training engine of the HDMI TX.
+* Please see xv_hdmitx_frl.h for more details of the engine.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ------ -------- --------------------------------------------------
+* 1.00  XLNX   10/18/26 Initial release.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xv_hdmitx_frl.h"
+#include "xv_hdmitx.h"
+#include "xil_assert.h"
+#include <linux/string.h>
+
+/************************** Constant Definitions *****************************/
+
+/* CEA-861 extension and data block identifiers used by the EDID parser */
+#define XV_HDMITX_FRL_EDID_BLOCK_SIZE       128
+#define XV_HDMITX_FRL_EDID_CEA_TAG          0x02
+#define XV_HDMITX_FRL_EDID_TAG_VSDB         0x03
+#define XV_HDMITX_FRL_EDID_TAG_EXTENDED     0x07
+#define XV_HDMITX_FRL_EDID_EXT_TAG_HF_SCDB  0x79
+#define XV_HDMITX_FRL_EDID_SCDC_PRESENT     0x80
+
+/**************************** Type Definitions *******************************/
+
+/************************** Function Prototypes ******************************/
+
+static void XV_HdmiTx_FrlSetState(XV_HdmiTx_Frl *InstancePtr,
+		XV_HdmiTx_FrlState State);
+static int XV_HdmiTx_FrlConfigRate(XV_HdmiTx_Frl *InstancePtr);
+static void XV_HdmiTx_FrlLegacy(XV_HdmiTx_Frl *InstancePtr);
+static void XV_HdmiTx_FrlLowerRate(XV_HdmiTx_Frl *InstancePtr);
+static int XV_HdmiTx_FrlReadLtpReq(XV_HdmiTx_Frl *InstancePtr, u8 *LtpReq);
+static void XV_HdmiTx_FrlApplyLtpReq(XV_HdmiTx_Frl *InstancePtr,
+		const u8 *LtpReq);
+static void XV_HdmiTx_FrlStopLtp(XV_HdmiTx_Frl *InstancePtr);
+static XV_HdmiTx_FrlCacheEntry *XV_HdmiTx_FrlCacheFind(
+		XV_HdmiTx_Frl *InstancePtr, u32 SinkId);
+static void XV_HdmiTx_FrlCacheStore(XV_HdmiTx_Frl *InstancePtr);
+
+/************************** Variable Definitions *****************************/
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function initializes the FRL training engine.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+* @param    ConfigPtr is a pointer to the callbacks and source capabilities.
+*           The SCDC read and write, rate and pattern callbacks are
+*           mandatory, the TxFFE callback is optional.
+*
+* @return
+*           - XST_SUCCESS if the engine was initialized.
+*           - XST_FAILURE if a mandatory callback is missing.
+*
+* @note     The rate cache is emptied.
+*
+******************************************************************************/
+int XV_HdmiTx_FrlInitialize(XV_HdmiTx_Frl *InstancePtr,
+		const XV_HdmiTx_FrlConfig *ConfigPtr)
+{
+	/* Verify arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(ConfigPtr != NULL);
+	Xil_AssertNonvoid(ConfigPtr->MaxFrlRate < XHDMIC_MAXFRLRATE_SIZE);
+
+	memset(InstancePtr, 0, sizeof(XV_HdmiTx_Frl));
+
+	if (!ConfigPtr->ScdcRead || !ConfigPtr->ScdcWrite ||
+	    !ConfigPtr->SetRate || !ConfigPtr->SetLtp) {
+		return XST_FAILURE;
+	}
+
+	InstancePtr->Config = *ConfigPtr;
+	if (InstancePtr->Config.FfeLevels > XV_HDMITX_FRL_MAX_FFE_LEVEL)
+		InstancePtr->Config.FfeLevels = XV_HDMITX_FRL_MAX_FFE_LEVEL;
+	InstancePtr->State = XV_HDMITX_FRL_STATE_LTS_L;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the Max_FRL_Rate of a sink from its EDID. It looks
+* for the HDMI Forum Vendor Specific Data Block or the HDMI Forum Sink
+* Capability Data Block in the CEA-861 extension blocks.
+*
+* @param    EdidPtr is a pointer to the EDID.
+* @param    Length is the length of the EDID in bytes.
+*
+* @return   The Max_FRL_Rate, a XHdmiC_MaxFrlRate value, or
+*           XHDMIC_MAXFRLRATE_NOT_SUPPORTED if the sink does not support FRL
+*           or SCDC.
+*
+* @note     None.
+*
+******************************************************************************/
+u8 XV_HdmiTx_FrlGetEdidMaxRate(const u8 *EdidPtr, u32 Length)
+{
+	const u8 *Ext;
+	const u8 *Blk;
+	u32 Offset;
+	u32 End;
+	u8 Tag;
+	u8 Len;
+	u8 Rate;
+
+	/* Verify argument. */
+	Xil_AssertNonvoid(EdidPtr != NULL);
+
+	for (Offset = XV_HDMITX_FRL_EDID_BLOCK_SIZE;
+	     Offset + XV_HDMITX_FRL_EDID_BLOCK_SIZE <= Length;
+	     Offset += XV_HDMITX_FRL_EDID_BLOCK_SIZE) {
+		Ext = &EdidPtr[Offset];
+		if (Ext[0] != XV_HDMITX_FRL_EDID_CEA_TAG)
+			continue;
+
+		/* The data block collection ends at the DTD offset */
+		End = Ext[2];
+		if (End < 4 || End > XV_HDMITX_FRL_EDID_BLOCK_SIZE - 1)
+			End = XV_HDMITX_FRL_EDID_BLOCK_SIZE - 1;
+
+		for (Blk = &Ext[4]; Blk < &Ext[End]; Blk += Len + 1) {
+			Tag = Blk[0] >> 5;
+			Len = Blk[0] & 0x1F;
+			if (Blk + Len >= &Ext[End])
+				break;
+			if (Len < 7)
+				continue;
+
+			/* HF-VSDB (OUI C4-5D-D8) or HF-SCDB */
+			if (!((Tag == XV_HDMITX_FRL_EDID_TAG_VSDB &&
+			       Blk[1] == 0xD8 && Blk[2] == 0x5D &&
+			       Blk[3] == 0xC4) ||
+			      (Tag == XV_HDMITX_FRL_EDID_TAG_EXTENDED &&
+			       Blk[1] == XV_HDMITX_FRL_EDID_EXT_TAG_HF_SCDB)))
+				continue;
+
+			/* FRL training requires SCDC */
+			if (!(Blk[6] & XV_HDMITX_FRL_EDID_SCDC_PRESENT))
+				return XHDMIC_MAXFRLRATE_NOT_SUPPORTED;
+
+			Rate = Blk[7] >> 4;
+			if (Rate >= XHDMIC_MAXFRLRATE_SIZE)
+				Rate = XHDMIC_MAXFRLRATE_SIZE - 1;
+			return Rate;
+		}
+	}
+
+	return XHDMIC_MAXFRLRATE_NOT_SUPPORTED;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the identifier of a sink used as rate cache key. It
+* is a FNV-1a hash of the vendor and product identification of the EDID.
+*
+* @param    EdidPtr is a pointer to the EDID base block.
+*
+* @return   The sink identifier.
+*
+* @note     None.
+*
+******************************************************************************/
+u32 XV_HdmiTx_FrlGetEdidSinkId(const u8 *EdidPtr)
+{
+	u32 Hash = 0x811C9DC5;
+	u8 Index;
+
+	/* Verify argument. */
+	Xil_AssertNonvoid(EdidPtr != NULL);
+
+	/* Manufacturer, product code, serial number, week and year */
+	for (Index = 8; Index < 18; Index++) {
+		Hash ^= EdidPtr[Index];
+		Hash *= 0x01000193;
+	}
+
+	return Hash;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function starts the link training (LTS:1). The start rate and TxFFE
+* levels are taken from the rate cache when the sink was trained before and
+* its cached rate is still allowed, else training starts at the highest
+* rate supported by both the source and the sink.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+* @param    SinkId is the identifier of the sink, see
+*           XV_HdmiTx_FrlGetEdidSinkId.
+* @param    SinkMaxFrlRate is the Max_FRL_Rate of the sink, see
+*           XV_HdmiTx_FrlGetEdidMaxRate.
+*
+* @return
+*           - XST_SUCCESS if the training was started (LTS:2).
+*           - XST_FAILURE if the link cannot use FRL, the engine is in LTS:L.
+*
+* @note     None.
+*
+******************************************************************************/
+int XV_HdmiTx_FrlStart(XV_HdmiTx_Frl *InstancePtr, u32 SinkId,
+		u8 SinkMaxFrlRate)
+{
+	XV_HdmiTx_FrlConfig *Cfg;
+	XV_HdmiTx_FrlCacheEntry *Entry;
+	u8 Data;
+	u8 Lane;
+
+	/* Verify argument. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	Cfg = &InstancePtr->Config;
+	InstancePtr->SinkId = SinkId;
+	InstancePtr->Trainings++;
+
+	InstancePtr->MaxFrlRate = Cfg->MaxFrlRate;
+	if (SinkMaxFrlRate < InstancePtr->MaxFrlRate)
+		InstancePtr->MaxFrlRate = SinkMaxFrlRate;
+	if (InstancePtr->MaxFrlRate == XHDMIC_MAXFRLRATE_NOT_SUPPORTED)
+		goto legacy;
+
+	/* LTS:1, the sink must support SCDC version 1 or later */
+	if (Cfg->ScdcRead(Cfg->CallbackRef, XV_HDMITX_FRL_SCDC_SINK_VERSION,
+			  &Data) != XST_SUCCESS || Data == 0)
+		goto legacy;
+	if (Cfg->ScdcWrite(Cfg->CallbackRef,
+			   XV_HDMITX_FRL_SCDC_SOURCE_VERSION, 1) != XST_SUCCESS)
+		goto legacy;
+
+	if (Cfg->ScdcRead(Cfg->CallbackRef,
+			  XV_HDMITX_FRL_SCDC_SOURCE_TEST_CFG,
+			  &Data) != XST_SUCCESS)
+		Data = 0;
+	InstancePtr->NoTimeout =
+		(Data & XV_HDMITX_FRL_SCDC_FLT_NO_TIMEOUT_MASK) ? TRUE : FALSE;
+
+	Entry = XV_HdmiTx_FrlCacheFind(InstancePtr, SinkId);
+	if (Entry && Entry->FrlRate <= InstancePtr->MaxFrlRate) {
+		InstancePtr->FrlRate = Entry->FrlRate;
+		memcpy(InstancePtr->Ffe, Entry->Ffe, sizeof(InstancePtr->Ffe));
+	} else {
+		InstancePtr->FrlRate = InstancePtr->MaxFrlRate;
+		memset(InstancePtr->Ffe, 0, sizeof(InstancePtr->Ffe));
+	}
+	for (Lane = 0; Lane < XV_HDMITX_FRL_MAX_LANES; Lane++) {
+		if (InstancePtr->Ffe[Lane] > Cfg->FfeLevels)
+			InstancePtr->Ffe[Lane] = Cfg->FfeLevels;
+	}
+
+	/* LTS:2 */
+	if (XV_HdmiTx_FrlConfigRate(InstancePtr) != XST_SUCCESS)
+		goto legacy;
+	XV_HdmiTx_FrlSetState(InstancePtr, XV_HDMITX_FRL_STATE_LTS_2);
+
+	return XST_SUCCESS;
+
+legacy:
+	XV_HdmiTx_FrlLegacy(InstancePtr);
+	return XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function advances the link training. It must be called at least every
+* XV_HDMITX_FRL_POLL_INTERVAL milliseconds while the engine is not in
+* LTS:L.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+* @param    ElapsedMs is the time since the previous call in milliseconds.
+*
+* @return   The training state after the call.
+*
+* @note     A failing SCDC read is handled as if the sink did not update
+*           its status, so the state timeouts still apply.
+*
+******************************************************************************/
+XV_HdmiTx_FrlState XV_HdmiTx_FrlPoll(XV_HdmiTx_Frl *InstancePtr,
+		u32 ElapsedMs)
+{
+	XV_HdmiTx_FrlConfig *Cfg;
+	u8 LtpReq[XV_HDMITX_FRL_MAX_LANES];
+	u8 Update;
+	u8 Data;
+	u8 Lane;
+	u8 Passed;
+
+	/* Verify argument. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	Cfg = &InstancePtr->Config;
+	InstancePtr->TimerMs += ElapsedMs;
+
+	switch (InstancePtr->State) {
+	case XV_HDMITX_FRL_STATE_LTS_2:
+		if (Cfg->ScdcRead(Cfg->CallbackRef,
+				  XV_HDMITX_FRL_SCDC_STATUS_FLAGS_0,
+				  &Data) == XST_SUCCESS &&
+		    (Data & XV_HDMITX_FRL_SCDC_FLT_READY_MASK)) {
+			XV_HdmiTx_FrlSetState(InstancePtr,
+					      XV_HDMITX_FRL_STATE_LTS_3);
+		} else if (InstancePtr->TimerMs >=
+			   XV_HDMITX_FRL_LTS2_TIMEOUT) {
+			XV_HdmiTx_FrlLegacy(InstancePtr);
+		}
+		break;
+
+	case XV_HDMITX_FRL_STATE_LTS_3:
+	case XV_HDMITX_FRL_STATE_LTS_P_ARM:
+	case XV_HDMITX_FRL_STATE_LTS_P:
+		if (Cfg->ScdcRead(Cfg->CallbackRef,
+				  XV_HDMITX_FRL_SCDC_UPDATE_0,
+				  &Update) != XST_SUCCESS)
+			Update = 0;
+
+		if ((Update & XV_HDMITX_FRL_SCDC_FLT_UPDATE_MASK) &&
+		    XV_HdmiTx_FrlReadLtpReq(InstancePtr,
+					    LtpReq) == XST_SUCCESS) {
+			Passed = TRUE;
+			for (Lane = 0; Lane < InstancePtr->Lanes; Lane++) {
+				if (LtpReq[Lane] != XV_HDMITX_FRL_LTP_NONE)
+					Passed = FALSE;
+			}
+
+			if (!Passed &&
+			    InstancePtr->State != XV_HDMITX_FRL_STATE_LTS_3) {
+				/* The sink requests retraining */
+				XV_HdmiTx_FrlSetState(InstancePtr,
+						XV_HDMITX_FRL_STATE_LTS_3);
+			}
+
+			if (InstancePtr->State == XV_HDMITX_FRL_STATE_LTS_3) {
+				if (Passed) {
+					XV_HdmiTx_FrlStopLtp(InstancePtr);
+					XV_HdmiTx_FrlSetState(InstancePtr,
+						XV_HDMITX_FRL_STATE_LTS_P_ARM);
+				} else {
+					XV_HdmiTx_FrlApplyLtpReq(InstancePtr,
+								 LtpReq);
+				}
+			}
+
+			Cfg->ScdcWrite(Cfg->CallbackRef,
+				       XV_HDMITX_FRL_SCDC_UPDATE_0,
+				       XV_HDMITX_FRL_SCDC_FLT_UPDATE_MASK);
+			if (InstancePtr->State == XV_HDMITX_FRL_STATE_LTS_L)
+				break;
+		}
+
+		if (InstancePtr->State == XV_HDMITX_FRL_STATE_LTS_P_ARM &&
+		    (Update & XV_HDMITX_FRL_SCDC_FRL_START_MASK)) {
+			Cfg->ScdcWrite(Cfg->CallbackRef,
+				       XV_HDMITX_FRL_SCDC_UPDATE_0,
+				       XV_HDMITX_FRL_SCDC_FRL_START_MASK);
+			XV_HdmiTx_FrlCacheStore(InstancePtr);
+			XV_HdmiTx_FrlSetState(InstancePtr,
+					      XV_HDMITX_FRL_STATE_LTS_P);
+			break;
+		}
+
+		if (InstancePtr->State != XV_HDMITX_FRL_STATE_LTS_P &&
+		    !InstancePtr->NoTimeout &&
+		    InstancePtr->TimerMs >= XV_HDMITX_FRL_LTS3_TIMEOUT) {
+			XV_HdmiTx_FrlLegacy(InstancePtr);
+		}
+		break;
+
+	case XV_HDMITX_FRL_STATE_LTS_L:
+	default:
+		break;
+	}
+
+	return InstancePtr->State;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function stops the link training and the FRL link, e.g. on
+* disconnect. The SCDC is not accessed, the rate cache is kept.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+*
+* @return   None.
+*
+* @note     None.
+*
+******************************************************************************/
+void XV_HdmiTx_FrlStop(XV_HdmiTx_Frl *InstancePtr)
+{
+	/* Verify argument. */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	if (InstancePtr->State == XV_HDMITX_FRL_STATE_LTS_L)
+		return;
+
+	XV_HdmiTx_FrlStopLtp(InstancePtr);
+	InstancePtr->FrlRate = XHDMIC_MAXFRLRATE_NOT_SUPPORTED;
+	InstancePtr->Config.SetRate(InstancePtr->Config.CallbackRef,
+				    0, FrlRateTable[0].Lanes, 0);
+	XV_HdmiTx_FrlSetState(InstancePtr, XV_HDMITX_FRL_STATE_LTS_L);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function empties the rate cache.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+*
+* @return   None.
+*
+* @note     None.
+*
+******************************************************************************/
+void XV_HdmiTx_FrlCacheFlush(XV_HdmiTx_Frl *InstancePtr)
+{
+	/* Verify argument. */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	memset(InstancePtr->Cache, 0, sizeof(InstancePtr->Cache));
+	InstancePtr->CacheNext = 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads a SCDC register over the HDMI TX DDC. It can be used
+* as XV_HdmiTx_FrlConfig ScdcRead callback with a XV_HdmiTx instance as
+* callback reference.
+*
+* @param    CallbackRef is a pointer to the XV_HdmiTx instance.
+* @param    Offset is the SCDC register offset.
+* @param    DataPtr is a pointer to the read value.
+*
+* @return   XST_SUCCESS or XST_FAILURE.
+*
+* @note     None.
+*
+******************************************************************************/
+int XV_HdmiTx_FrlDdcScdcRead(void *CallbackRef, u8 Offset, u8 *DataPtr)
+{
+	XV_HdmiTx *HdmiTxPtr = (XV_HdmiTx *)CallbackRef;
+	int Status;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(HdmiTxPtr != NULL);
+	Xil_AssertNonvoid(DataPtr != NULL);
+
+	Status = XV_HdmiTx_DdcWrite(HdmiTxPtr, XV_HDMITX_FRL_SCDC_SLAVE, 1,
+				    &Offset, (FALSE));
+	if (Status != (XST_SUCCESS))
+		return XST_FAILURE;
+
+	return XV_HdmiTx_DdcRead(HdmiTxPtr, XV_HDMITX_FRL_SCDC_SLAVE, 1,
+				 DataPtr, (TRUE));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes a SCDC register over the HDMI TX DDC. It can be used
+* as XV_HdmiTx_FrlConfig ScdcWrite callback with a XV_HdmiTx instance as
+* callback reference.
+*
+* @param    CallbackRef is a pointer to the XV_HdmiTx instance.
+* @param    Offset is the SCDC register offset.
+* @param    Data is the value to write.
+*
+* @return   XST_SUCCESS or XST_FAILURE.
+*
+* @note     None.
+*
+******************************************************************************/
+int XV_HdmiTx_FrlDdcScdcWrite(void *CallbackRef, u8 Offset, u8 Data)
+{
+	XV_HdmiTx *HdmiTxPtr = (XV_HdmiTx *)CallbackRef;
+	u8 DdcBuf[2];
+
+	/* Verify argument. */
+	Xil_AssertNonvoid(HdmiTxPtr != NULL);
+
+	DdcBuf[0] = Offset;
+	DdcBuf[1] = Data;
+
+	return XV_HdmiTx_DdcWrite(HdmiTxPtr, XV_HDMITX_FRL_SCDC_SLAVE, 2,
+				  DdcBuf, (TRUE));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function enters a new training state and restarts the state timer.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+* @param    State is the new state.
+*
+* @return   None.
+*
+* @note     None.
+*
+******************************************************************************/
+static void XV_HdmiTx_FrlSetState(XV_HdmiTx_Frl *InstancePtr,
+		XV_HdmiTx_FrlState State)
+{
+	InstancePtr->State = State;
+	InstancePtr->TimerMs = 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function configures the PHY and TX for the current FRL rate, applies
+* the current TxFFE levels and writes the rate and the number of TxFFE
+* levels to the SCDC Config_1 register.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+*
+* @return   XST_SUCCESS or XST_FAILURE.
+*
+* @note     None.
+*
+******************************************************************************/
+static int XV_HdmiTx_FrlConfigRate(XV_HdmiTx_Frl *InstancePtr)
+{
+	XV_HdmiTx_FrlConfig *Cfg = &InstancePtr->Config;
+	const XHdmiC_FrlRate *RatePtr = &FrlRateTable[InstancePtr->FrlRate];
+	u8 Lane;
+
+	InstancePtr->Lanes = RatePtr->Lanes;
+	memset(InstancePtr->Ltp, 0, sizeof(InstancePtr->Ltp));
+
+	if (Cfg->SetRate(Cfg->CallbackRef, InstancePtr->FrlRate,
+			 RatePtr->Lanes, RatePtr->LineRate) != XST_SUCCESS)
+		return XST_FAILURE;
+
+	if (Cfg->SetFfe) {
+		for (Lane = 0; Lane < InstancePtr->Lanes; Lane++)
+			Cfg->SetFfe(Cfg->CallbackRef, Lane,
+				    InstancePtr->Ffe[Lane]);
+	}
+
+	return Cfg->ScdcWrite(Cfg->CallbackRef, XV_HDMITX_FRL_SCDC_CONFIG_1,
+			      InstancePtr->FrlRate |
+			      (Cfg->FfeLevels <<
+			       XV_HDMITX_FRL_SCDC_FFE_LEVELS_SHIFT));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function ends the link training without FRL (LTS:L). The sink is
+* told to stop FRL, the link returns to TMDS and the sink is removed from
+* the rate cache so the next training starts from scratch.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+*
+* @return   None.
+*
+* @note     None.
+*
+******************************************************************************/
+static void XV_HdmiTx_FrlLegacy(XV_HdmiTx_Frl *InstancePtr)
+{
+	XV_HdmiTx_FrlConfig *Cfg = &InstancePtr->Config;
+	XV_HdmiTx_FrlCacheEntry *Entry;
+
+	XV_HdmiTx_FrlStopLtp(InstancePtr);
+	Cfg->ScdcWrite(Cfg->CallbackRef, XV_HDMITX_FRL_SCDC_CONFIG_1, 0);
+	Cfg->SetRate(Cfg->CallbackRef, 0, FrlRateTable[0].Lanes, 0);
+
+	Entry = XV_HdmiTx_FrlCacheFind(InstancePtr, InstancePtr->SinkId);
+	if (Entry)
+		Entry->IsValid = FALSE;
+
+	InstancePtr->FrlRate = XHDMIC_MAXFRLRATE_NOT_SUPPORTED;
+	InstancePtr->Failures++;
+	XV_HdmiTx_FrlSetState(InstancePtr, XV_HDMITX_FRL_STATE_LTS_L);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function falls back to the next lower FRL rate (LTS:4) and resumes
+* the training at that rate in LTS:3, or ends in LTS:L when there is no
+* lower rate.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+*
+* @return   None.
+*
+* @note     None.
+*
+******************************************************************************/
+static void XV_HdmiTx_FrlLowerRate(XV_HdmiTx_Frl *InstancePtr)
+{
+	InstancePtr->RateFallbacks++;
+	XV_HdmiTx_FrlStopLtp(InstancePtr);
+
+	if (InstancePtr->FrlRate <= XHDMIC_MAXFRLRATE_3X3GBITSPS) {
+		XV_HdmiTx_FrlLegacy(InstancePtr);
+		return;
+	}
+
+	InstancePtr->FrlRate--;
+	memset(InstancePtr->Ffe, 0, sizeof(InstancePtr->Ffe));
+
+	if (XV_HdmiTx_FrlConfigRate(InstancePtr) != XST_SUCCESS) {
+		XV_HdmiTx_FrlLegacy(InstancePtr);
+		return;
+	}
+	XV_HdmiTx_FrlSetState(InstancePtr, XV_HDMITX_FRL_STATE_LTS_3);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads the Ln_LTP_req fields of all lanes.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+* @param    LtpReq is an array receiving the request of each lane.
+*
+* @return   XST_SUCCESS or XST_FAILURE.
+*
+* @note     None.
+*
+******************************************************************************/
+static int XV_HdmiTx_FrlReadLtpReq(XV_HdmiTx_Frl *InstancePtr, u8 *LtpReq)
+{
+	XV_HdmiTx_FrlConfig *Cfg = &InstancePtr->Config;
+	u8 Data[2];
+
+	if (Cfg->ScdcRead(Cfg->CallbackRef, XV_HDMITX_FRL_SCDC_STATUS_FLAGS_1,
+			  &Data[0]) != XST_SUCCESS ||
+	    Cfg->ScdcRead(Cfg->CallbackRef, XV_HDMITX_FRL_SCDC_STATUS_FLAGS_2,
+			  &Data[1]) != XST_SUCCESS)
+		return XST_FAILURE;
+
+	LtpReq[0] = Data[0] & 0xF;
+	LtpReq[1] = Data[0] >> 4;
+	LtpReq[2] = Data[1] & 0xF;
+	LtpReq[3] = Data[1] >> 4;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function applies the pattern and TxFFE requests of the sink. A rate
+* change request of any lane takes precedence over all other requests.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+* @param    LtpReq is an array holding the request of each lane.
+*
+* @return   None.
+*
+* @note     None.
+*
+******************************************************************************/
+static void XV_HdmiTx_FrlApplyLtpReq(XV_HdmiTx_Frl *InstancePtr,
+		const u8 *LtpReq)
+{
+	XV_HdmiTx_FrlConfig *Cfg = &InstancePtr->Config;
+	u8 Lane;
+
+	for (Lane = 0; Lane < InstancePtr->Lanes; Lane++) {
+		if (LtpReq[Lane] == XV_HDMITX_FRL_LTP_RATE_CHANGE) {
+			XV_HdmiTx_FrlLowerRate(InstancePtr);
+			return;
+		}
+	}
+
+	for (Lane = 0; Lane < InstancePtr->Lanes; Lane++) {
+		if (LtpReq[Lane] == XV_HDMITX_FRL_LTP_FFE_CHANGE) {
+			if (InstancePtr->Ffe[Lane] < Cfg->FfeLevels) {
+				InstancePtr->Ffe[Lane]++;
+				if (Cfg->SetFfe)
+					Cfg->SetFfe(Cfg->CallbackRef, Lane,
+						    InstancePtr->Ffe[Lane]);
+			}
+		} else if (LtpReq[Lane] <= XV_HDMITX_FRL_LTP_MAX &&
+			   LtpReq[Lane] != InstancePtr->Ltp[Lane]) {
+			/* Passed lanes stop their pattern */
+			InstancePtr->Ltp[Lane] = LtpReq[Lane];
+			Cfg->SetLtp(Cfg->CallbackRef, Lane, LtpReq[Lane]);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function stops the link training pattern on all lanes.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+*
+* @return   None.
+*
+* @note     None.
+*
+******************************************************************************/
+static void XV_HdmiTx_FrlStopLtp(XV_HdmiTx_Frl *InstancePtr)
+{
+	XV_HdmiTx_FrlConfig *Cfg = &InstancePtr->Config;
+	u8 Lane;
+
+	for (Lane = 0; Lane < XV_HDMITX_FRL_MAX_LANES; Lane++) {
+		if (InstancePtr->Ltp[Lane] != XV_HDMITX_FRL_LTP_NONE) {
+			InstancePtr->Ltp[Lane] = XV_HDMITX_FRL_LTP_NONE;
+			Cfg->SetLtp(Cfg->CallbackRef, Lane,
+				    XV_HDMITX_FRL_LTP_NONE);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function looks up a sink in the rate cache.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+* @param    SinkId is the identifier of the sink.
+*
+* @return   The cache entry of the sink or NULL.
+*
+* @note     None.
+*
+******************************************************************************/
+static XV_HdmiTx_FrlCacheEntry *XV_HdmiTx_FrlCacheFind(
+		XV_HdmiTx_Frl *InstancePtr, u32 SinkId)
+{
+	u8 Index;
+
+	for (Index = 0; Index < XV_HDMITX_FRL_CACHE_SIZE; Index++) {
+		if (InstancePtr->Cache[Index].IsValid &&
+		    InstancePtr->Cache[Index].SinkId == SinkId)
+			return &InstancePtr->Cache[Index];
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function stores the trained rate and TxFFE levels of the current sink
+* in the rate cache, replacing the oldest entry when the cache is full.
+*
+* @param    InstancePtr is a pointer to the XV_HdmiTx_Frl instance.
+*
+* @return   None.
+*
+* @note     None.
+*
+******************************************************************************/
+static void XV_HdmiTx_FrlCacheStore(XV_HdmiTx_Frl *InstancePtr)
+{
+	XV_HdmiTx_FrlCacheEntry *Entry;
+
+	Entry = XV_HdmiTx_FrlCacheFind(InstancePtr, InstancePtr->SinkId);
+	if (!Entry) {
+		Entry = &InstancePtr->Cache[InstancePtr->CacheNext];
+		InstancePtr->CacheNext = (InstancePtr->CacheNext + 1) %
+					 XV_HDMITX_FRL_CACHE_SIZE;
+	}
+
+	Entry->SinkId = InstancePtr->SinkId;
+	Entry->FrlRate = InstancePtr->FrlRate;
+	memcpy(Entry->Ffe, InstancePtr->Ffe, sizeof(Entry->Ffe));
+	Entry->IsValid = TRUE;
+}
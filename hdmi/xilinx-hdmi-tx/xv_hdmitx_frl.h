@@ -0,0 +1,236 @@
+/******************************************************************************
+*
+ *
+ * Copyright (C) 2015, 2016, 2017 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xv_hdmitx_frl.h
+* @{
+* @details
+*
+* This is the header file of the HDMI 2.1 Fixed Rate Link (FRL) training
+* engine of the HDMI TX. The engine implements the source side of the link
+* training state machine (LTS:1 to LTS:4, LTS:P and LTS:L) of the HDMI 2.1
+* specification:
+*
+* - LTS:1 checks the SCDC Sink_Version and selects the FRL rate from the
+*   Max_FRL_Rate of the sink EDID, the source limit and the rate cache.
+* - LTS:2 programs the rate and the number of TxFFE levels in SCDC Config_1
+*   and waits up to 100 ms for FLT_ready.
+* - LTS:3 transmits the link training pattern requested by the sink on each
+*   lane, raises the TxFFE level of a lane on request and waits up to 200 ms
+*   for all lanes to pass, unless the sink sets FLT_no_timeout.
+* - LTS:4 falls back to the next lower FRL rate.
+* - LTS:P waits for FRL_start and handles retraining requests.
+* - LTS:L returns the link to TMDS.
+*
+* The FRL rate and TxFFE levels of the last successful training are cached
+* per sink, so retraining a known sink starts at its known-good point.
+*
+* The engine does not access the hardware. SCDC accesses, the PHY and TX
+* rate configuration, the link training patterns and the TxFFE levels are
+* delegated to the callbacks in XV_HdmiTx_FrlConfig, which makes it usable
+* with any HDMI 2.1 capable TX and PHY, e.g. XHdmiphy1_Hdmi21Config, as well
+* as against a simulated SCDC peer.
+*
+* <b>Software Initialization and Configuration</b>
+*
+* - Call XV_HdmiTx_FrlInitialize with the callbacks and the source limits.
+* - Call XV_HdmiTx_FrlGetEdidMaxRate and XV_HdmiTx_FrlGetEdidSinkId on the
+*   sink EDID and XV_HdmiTx_FrlStart to start the training.
+* - Call XV_HdmiTx_FrlPoll at least every XV_HDMITX_FRL_POLL_INTERVAL ms
+*   with the time elapsed since the previous call, until it returns
+*   XV_HDMITX_FRL_STATE_LTS_P (video can be sent over FRL) or
+*   XV_HDMITX_FRL_STATE_LTS_L (the link is back to TMDS). Keep polling in
+*   LTS:P to handle retraining requests of the sink.
+* - Call XV_HdmiTx_FrlStop on disconnect.
+*
+* <b> Threads </b>
+*
+* The engine is not thread safe, the caller serializes all calls.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ------ -------- --------------------------------------------------
+* 1.00  XLNX   10/18/26 Initial release.
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XV_HDMITX_FRL_H_
+/**  prevent circular inclusions by using protection macros */
+#define XV_HDMITX_FRL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+#include "xstatus.h"
+#include "xv_hdmic.h"
+
+/************************** Constant Definitions *****************************/
+
+/** @name SCDC registers and fields used by the link training
+* @{
+*/
+#define XV_HDMITX_FRL_SCDC_SLAVE            0x54
+#define XV_HDMITX_FRL_SCDC_SINK_VERSION     0x01
+#define XV_HDMITX_FRL_SCDC_SOURCE_VERSION   0x02
+#define XV_HDMITX_FRL_SCDC_UPDATE_0         0x10
+#define XV_HDMITX_FRL_SCDC_FRL_START_MASK   0x10
+#define XV_HDMITX_FRL_SCDC_FLT_UPDATE_MASK  0x20
+#define XV_HDMITX_FRL_SCDC_CONFIG_1         0x31
+#define XV_HDMITX_FRL_SCDC_FFE_LEVELS_SHIFT 4
+#define XV_HDMITX_FRL_SCDC_SOURCE_TEST_CFG  0x35
+#define XV_HDMITX_FRL_SCDC_FLT_NO_TIMEOUT_MASK 0x20
+#define XV_HDMITX_FRL_SCDC_STATUS_FLAGS_0   0x40
+#define XV_HDMITX_FRL_SCDC_FLT_READY_MASK   0x40
+#define XV_HDMITX_FRL_SCDC_STATUS_FLAGS_1   0x41 /**< Ln0/Ln1_LTP_req */
+#define XV_HDMITX_FRL_SCDC_STATUS_FLAGS_2   0x42 /**< Ln2/Ln3_LTP_req */
+/* @} */
+
+/** @name Ln_LTP_req values
+* @{
+*/
+#define XV_HDMITX_FRL_LTP_NONE              0x0 /**< Lane passed */
+#define XV_HDMITX_FRL_LTP_MAX               0x8 /**< Patterns 1 to 8 */
+#define XV_HDMITX_FRL_LTP_FFE_CHANGE        0xE /**< Next TxFFE level */
+#define XV_HDMITX_FRL_LTP_RATE_CHANGE       0xF /**< Lower the FRL rate */
+/* @} */
+
+/** Maximum number of FRL lanes. */
+#define XV_HDMITX_FRL_MAX_LANES             4
+
+/** Maximum number of TxFFE levels above level 0 (FFE_Levels). */
+#define XV_HDMITX_FRL_MAX_FFE_LEVEL         3
+
+/** Number of sinks in the rate cache. */
+#define XV_HDMITX_FRL_CACHE_SIZE            4
+
+/** @name Link training timeouts in milliseconds
+* @{
+*/
+#define XV_HDMITX_FRL_LTS2_TIMEOUT          100 /**< FLT_ready */
+#define XV_HDMITX_FRL_LTS3_TIMEOUT          200 /**< All lanes passed */
+#define XV_HDMITX_FRL_POLL_INTERVAL         2   /**< Max poll interval */
+/* @} */
+
+/**************************** Type Definitions *******************************/
+
+/**
+* This typedef enumerates the states of the link training.
+*/
+typedef enum {
+	XV_HDMITX_FRL_STATE_LTS_L = 0,  /**< Legacy TMDS, training failed */
+	XV_HDMITX_FRL_STATE_LTS_2,      /**< Waiting for FLT_ready */
+	XV_HDMITX_FRL_STATE_LTS_3,      /**< Link training */
+	XV_HDMITX_FRL_STATE_LTS_P_ARM,  /**< Trained, waiting for FRL_start */
+	XV_HDMITX_FRL_STATE_LTS_P,      /**< FRL started */
+} XV_HdmiTx_FrlState;
+
+/** SCDC read callback, returns XST_SUCCESS or XST_FAILURE. */
+typedef int (*XV_HdmiTx_FrlScdcReadHandler)(void *CallbackRef, u8 Offset,
+		u8 *DataPtr);
+/** SCDC write callback, returns XST_SUCCESS or XST_FAILURE. */
+typedef int (*XV_HdmiTx_FrlScdcWriteHandler)(void *CallbackRef, u8 Offset,
+		u8 Data);
+/**
+* Rate callback, configures the PHY and TX for the FRL rate with the given
+* number of lanes and line rate in Gbps, or for TMDS if FrlRate is 0.
+* Returns XST_SUCCESS or XST_FAILURE.
+*/
+typedef int (*XV_HdmiTx_FrlSetRateHandler)(void *CallbackRef, u8 FrlRate,
+		u8 Lanes, u8 LineRate);
+/** Link training pattern callback, Ltp 0 stops the pattern of the lane. */
+typedef void (*XV_HdmiTx_FrlSetLtpHandler)(void *CallbackRef, u8 Lane,
+		u8 Ltp);
+/** TxFFE callback, sets the TxFFE level of a lane. */
+typedef void (*XV_HdmiTx_FrlSetFfeHandler)(void *CallbackRef, u8 Lane,
+		u8 FfeLevel);
+
+/**
+* This typedef contains the callbacks and the source capabilities.
+*/
+typedef struct {
+	XV_HdmiTx_FrlScdcReadHandler ScdcRead;   /**< SCDC read */
+	XV_HdmiTx_FrlScdcWriteHandler ScdcWrite; /**< SCDC write */
+	XV_HdmiTx_FrlSetRateHandler SetRate;     /**< PHY and TX rate */
+	XV_HdmiTx_FrlSetLtpHandler SetLtp;       /**< Training pattern */
+	XV_HdmiTx_FrlSetFfeHandler SetFfe;       /**< TxFFE level, optional */
+	void *CallbackRef;                       /**< Passed to the callbacks */
+	XHdmiC_MaxFrlRate MaxFrlRate;            /**< Source maximum FRL rate */
+	u8 FfeLevels;                            /**< Source TxFFE levels,
+	                                              0 to 3 */
+} XV_HdmiTx_FrlConfig;
+
+/**
+* This typedef contains a rate cache entry.
+*/
+typedef struct {
+	u32 SinkId;                              /**< Sink identifier */
+	u8 IsValid;                              /**< Entry in use */
+	u8 FrlRate;                              /**< Last trained rate */
+	u8 Ffe[XV_HDMITX_FRL_MAX_LANES];         /**< Last TxFFE levels */
+} XV_HdmiTx_FrlCacheEntry;
+
+/**
+* The FRL training engine instance data.
+*/
+typedef struct {
+	XV_HdmiTx_FrlConfig Config;              /**< Callbacks and limits */
+	XV_HdmiTx_FrlState State;                /**< Training state */
+	u32 SinkId;                              /**< Sink being trained */
+	u8 MaxFrlRate;                           /**< Source and sink limit */
+	u8 FrlRate;                              /**< Current FRL rate */
+	u8 Lanes;                                /**< Lanes of FrlRate */
+	u8 Ffe[XV_HDMITX_FRL_MAX_LANES];         /**< Current TxFFE levels */
+	u8 Ltp[XV_HDMITX_FRL_MAX_LANES];         /**< Current patterns */
+	u8 NoTimeout;                            /**< Sink set FLT_no_timeout */
+	u32 TimerMs;                             /**< Time in current state */
+	XV_HdmiTx_FrlCacheEntry Cache[XV_HDMITX_FRL_CACHE_SIZE]; /**< Rates */
+	u8 CacheNext;                            /**< Next entry to replace */
+	u32 Trainings;                           /**< Trainings started */
+	u32 RateFallbacks;                       /**< LTS:4 transitions */
+	u32 Failures;                            /**< LTS:L transitions */
+} XV_HdmiTx_Frl;
+
+/************************** Function Prototypes ******************************/
+
+int XV_HdmiTx_FrlInitialize(XV_HdmiTx_Frl *InstancePtr,
+		const XV_HdmiTx_FrlConfig *ConfigPtr);
+u8 XV_HdmiTx_FrlGetEdidMaxRate(const u8 *EdidPtr, u32 Length);
+u32 XV_HdmiTx_FrlGetEdidSinkId(const u8 *EdidPtr);
+int XV_HdmiTx_FrlStart(XV_HdmiTx_Frl *InstancePtr, u32 SinkId,
+		u8 SinkMaxFrlRate);
+XV_HdmiTx_FrlState XV_HdmiTx_FrlPoll(XV_HdmiTx_Frl *InstancePtr,
+		u32 ElapsedMs);
+void XV_HdmiTx_FrlStop(XV_HdmiTx_Frl *InstancePtr);
+void XV_HdmiTx_FrlCacheFlush(XV_HdmiTx_Frl *InstancePtr);
+
+/* SCDC callbacks over the HDMI TX DDC, CallbackRef is a XV_HdmiTx */
+int XV_HdmiTx_FrlDdcScdcRead(void *CallbackRef, u8 Offset, u8 *DataPtr);
+int XV_HdmiTx_FrlDdcScdcWrite(void *CallbackRef, u8 Offset, u8 Data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* End of protection macro */
+
+/** @} */
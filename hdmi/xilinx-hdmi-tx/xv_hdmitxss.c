@@ -139,6 +139,11 @@
 *                           XV_HdmiTx_AudioEnable
 *                       Replaced XV_HdmiTx_AudioUnmute API call with
 * 		MMO    11/08/18 Added Bridge Overflow and Bridge Underflow Interrupt
+* 5.21  XLNX   10/18/26 Added XV_HdmiTxSs_UpdateVideoTiming API
+*                       Added XV_HdmiTxSs_ReadEdidBlock API
+*                       XV_HdmiTxSs_VtcSetup only writes the changed VTC
+*                       generator registers and caches the horizontal
+*                       timing per mode
 * </pre>
 *
 ******************************************************************************/
@@ -197,6 +202,8 @@ XV_HdmiTxSs_SubCores XV_HdmiTxSs_SubCoreRepo[XPAR_XV_HDMITXSS_NUM_INSTANCES];
 static void XV_HdmiTxSs_GetIncludedSubcores(XV_HdmiTxSs *HdmiTxSsPtr,
                                             u16 DevId);
 static int XV_HdmiTxSs_RegisterSubsysCallbacks(XV_HdmiTxSs *InstancePtr);
+static int XV_HdmiTxSs_VtcHoriTiming(XV_HdmiTxSs *HdmiTxSsPtr,
+                                     XVtc_Timing *VideoTiming);
 static int XV_HdmiTxSs_VtcSetup(XV_HdmiTxSs *HdmiTxSsPtr);
 static u32 XV_HdmiTxSS_SetTMDS(XV_HdmiTxSs *InstancePtr,
                         XVidC_VideoMode VideoMode,
@@ -726,6 +733,11 @@ void XV_HdmiTxSs_VRST(XV_HdmiTxSs *InstancePtr, u8 Reset)
   Xil_AssertVoid(InstancePtr != NULL);
 
   XV_HdmiTx_EXT_VRST(InstancePtr->HdmiTxPtr, Reset);
+
+  /* The VTC registers return to their defaults */
+  if (Reset && InstancePtr->VtcPtr) {
+    XVtc_InvalidateGenerator(InstancePtr->VtcPtr);
+  }
 }
 
 /*****************************************************************************/
@@ -743,6 +755,11 @@ void XV_HdmiTxSs_SYSRST(XV_HdmiTxSs *InstancePtr, u8 Reset)
   Xil_AssertVoid(InstancePtr != NULL);
 
   XV_HdmiTx_EXT_SYSRST(InstancePtr->HdmiTxPtr, Reset);
+
+  /* The VTC registers return to their defaults */
+  if (Reset && InstancePtr->VtcPtr) {
+    XVtc_InvalidateGenerator(InstancePtr->VtcPtr);
+  }
 }
 
 /*****************************************************************************/
@@ -811,84 +828,65 @@ void XV_HdmiTxSs_ClearGcpClearAvmuteBit(XV_HdmiTxSs *InstancePtr)
 /*****************************************************************************/
 /**
 *
-* This function configures Video Timing Controller (VTC).
+* This function computes the horizontal VTC timing of the current video
+* stream, divided for the pixels per clock and YUV 4:2:0 and compensated for
+* the horizontal blanking. The result of the last mode is cached.
 *
-* @param  None.
+* @param  HdmiTxSsPtr is a pointer to the Subsystem instance to be worked on.
+* @param  VideoTiming is a pointer to the VTC timing whose horizontal fields
+*         are set.
 *
-* @return None.
+* @return XST_SUCCESS if the timing can be generated by the VTC, XST_FAILURE
+*         otherwise.
 *
 * @note   None.
 *
 ******************************************************************************/
-static int XV_HdmiTxSs_VtcSetup(XV_HdmiTxSs *HdmiTxSsPtr)
+static int XV_HdmiTxSs_VtcHoriTiming(XV_HdmiTxSs *HdmiTxSsPtr,
+                                     XVtc_Timing *VideoTiming)
 {
-  /* Polarity configuration */
-  XVtc_Polarity Polarity;
-  XVtc_SourceSelect SourceSelect;
-  XVtc_Timing VideoTiming;
+  XVidC_VideoStream *Video = &HdmiTxSsPtr->HdmiTxPtr->Stream.Video;
+  XVidC_VideoTiming *Timing = &Video->Timing;
+  XV_HdmiTxSs_VtcHoriCache *Cache = &HdmiTxSsPtr->VtcHoriCache;
   u32 HdmiTx_Hblank;
   u32 Vtc_Hblank;
 
-  /* Disable Generator */
-  XVtc_Reset(HdmiTxSsPtr->VtcPtr);
-  XVtc_DisableGenerator(HdmiTxSsPtr->VtcPtr);
-  XVtc_Disable(HdmiTxSsPtr->VtcPtr);
-
-  /* Set up source select */
-  memset((void *)&SourceSelect, 0, sizeof(SourceSelect));
-
-  /* 1 = Generator registers, 0 = Detector registers */
-  SourceSelect.VChromaSrc = 1;
-  SourceSelect.VActiveSrc = 1;
-  SourceSelect.VBackPorchSrc = 1;
-  SourceSelect.VSyncSrc = 1;
-  SourceSelect.VFrontPorchSrc = 1;
-  SourceSelect.VTotalSrc = 1;
-  SourceSelect.HActiveSrc = 1;
-  SourceSelect.HBackPorchSrc = 1;
-  SourceSelect.HSyncSrc = 1;
-  SourceSelect.HFrontPorchSrc = 1;
-  SourceSelect.HTotalSrc = 1;
-
-  XVtc_SetSource(HdmiTxSsPtr->VtcPtr, &SourceSelect);
-
-  VideoTiming.HActiveVideo = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.HActive;
-  VideoTiming.HFrontPorch = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.HFrontPorch;
-  VideoTiming.HSyncWidth = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.HSyncWidth;
-  VideoTiming.HBackPorch = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.HBackPorch;
-  VideoTiming.HSyncPolarity = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.HSyncPolarity;
-
-  /* Vertical Timing */
-  VideoTiming.VActiveVideo = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.VActive;
-
-  VideoTiming.V0FrontPorch = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F0PVFrontPorch;
-  VideoTiming.V0BackPorch = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F0PVBackPorch;
-  VideoTiming.V0SyncWidth = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F0PVSyncWidth;
-
-  VideoTiming.V1FrontPorch = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F1VFrontPorch;
-  VideoTiming.V1SyncWidth = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F1VSyncWidth;
-  VideoTiming.V1BackPorch = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F1VBackPorch;
+  if (Cache->IsValid &&
+      Cache->HActive == Timing->HActive &&
+      Cache->HFrontPorch == Timing->HFrontPorch &&
+      Cache->HSyncWidth == Timing->HSyncWidth &&
+      Cache->HBackPorch == Timing->HBackPorch &&
+      Cache->PixPerClk == Video->PixPerClk &&
+      Cache->ColorFormatId == Video->ColorFormatId) {
+    VideoTiming->HActiveVideo = Cache->VtcHActive;
+    VideoTiming->HFrontPorch = Cache->VtcHFrontPorch;
+    VideoTiming->HSyncWidth = Cache->VtcHSyncWidth;
+    VideoTiming->HBackPorch = Cache->VtcHBackPorch;
+    return (XST_SUCCESS);
+  }
+  Cache->IsValid = FALSE;
 
-  VideoTiming.VSyncPolarity = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.VSyncPolarity;
-
-  VideoTiming.Interlaced = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.IsInterlaced;
+  VideoTiming->HActiveVideo = Timing->HActive;
+  VideoTiming->HFrontPorch = Timing->HFrontPorch;
+  VideoTiming->HSyncWidth = Timing->HSyncWidth;
+  VideoTiming->HBackPorch = Timing->HBackPorch;
 
     /* 4 pixels per clock */
     if (HdmiTxSsPtr->HdmiTxPtr->Stream.Video.PixPerClk == XVIDC_PPC_4) {
     	/* If the parameters below are not divisible by the current PPC setting,
     	 * log an error as VTC does not support such video timing
     	 */
-		if (VideoTiming.HActiveVideo & 0x3 || VideoTiming.HFrontPorch & 0x3 ||
-				VideoTiming.HBackPorch & 0x3 || VideoTiming.HSyncWidth & 0x3) {
+		if (VideoTiming->HActiveVideo & 0x3 || VideoTiming->HFrontPorch & 0x3 ||
+				VideoTiming->HBackPorch & 0x3 || VideoTiming->HSyncWidth & 0x3) {
 #ifdef XV_HDMITXSS_LOG_ENABLE
 				XV_HdmiTxSs_LogWrite(HdmiTxSsPtr,
 						XV_HDMITXSS_LOG_EVT_VTC_RES_ERR, 0);
 #endif
 		}
-		VideoTiming.HActiveVideo = VideoTiming.HActiveVideo/4;
-		VideoTiming.HFrontPorch = VideoTiming.HFrontPorch/4;
-		VideoTiming.HBackPorch = VideoTiming.HBackPorch/4;
-		VideoTiming.HSyncWidth = VideoTiming.HSyncWidth/4;
+		VideoTiming->HActiveVideo = VideoTiming->HActiveVideo/4;
+		VideoTiming->HFrontPorch = VideoTiming->HFrontPorch/4;
+		VideoTiming->HBackPorch = VideoTiming->HBackPorch/4;
+		VideoTiming->HSyncWidth = VideoTiming->HSyncWidth/4;
     }
 
     /* 2 pixels per clock */
@@ -896,25 +894,25 @@ static int XV_HdmiTxSs_VtcSetup(XV_HdmiTxSs *HdmiTxSsPtr)
     	/* If the parameters below are not divisible by the current PPC setting,
     	 * log an error as VTC does not support such video timing
     	 */
-		if (VideoTiming.HActiveVideo & 0x1 || VideoTiming.HFrontPorch & 0x1 ||
-				VideoTiming.HBackPorch & 0x1 || VideoTiming.HSyncWidth & 0x1) {
+		if (VideoTiming->HActiveVideo & 0x1 || VideoTiming->HFrontPorch & 0x1 ||
+				VideoTiming->HBackPorch & 0x1 || VideoTiming->HSyncWidth & 0x1) {
 #ifdef XV_HDMITXSS_LOG_ENABLE
 			XV_HdmiTxSs_LogWrite(HdmiTxSsPtr,
 					XV_HDMITXSS_LOG_EVT_VTC_RES_ERR, 0);
 #endif
 		}
-		VideoTiming.HActiveVideo = VideoTiming.HActiveVideo/2;
-		VideoTiming.HFrontPorch = VideoTiming.HFrontPorch/2;
-		VideoTiming.HBackPorch = VideoTiming.HBackPorch/2;
-		VideoTiming.HSyncWidth = VideoTiming.HSyncWidth/2;
+		VideoTiming->HActiveVideo = VideoTiming->HActiveVideo/2;
+		VideoTiming->HFrontPorch = VideoTiming->HFrontPorch/2;
+		VideoTiming->HBackPorch = VideoTiming->HBackPorch/2;
+		VideoTiming->HSyncWidth = VideoTiming->HSyncWidth/2;
     }
 
     /* 1 pixels per clock */
     else {
-		VideoTiming.HActiveVideo = VideoTiming.HActiveVideo;
-		VideoTiming.HFrontPorch = VideoTiming.HFrontPorch;
-		VideoTiming.HBackPorch = VideoTiming.HBackPorch;
-		VideoTiming.HSyncWidth = VideoTiming.HSyncWidth;
+		VideoTiming->HActiveVideo = VideoTiming->HActiveVideo;
+		VideoTiming->HFrontPorch = VideoTiming->HFrontPorch;
+		VideoTiming->HBackPorch = VideoTiming->HBackPorch;
+		VideoTiming->HSyncWidth = VideoTiming->HSyncWidth;
     }
 
     /* For YUV420 the line width is double there for double the blanking */
@@ -922,17 +920,17 @@ static int XV_HdmiTxSs_VtcSetup(XV_HdmiTxSs *HdmiTxSsPtr)
     	/* If the parameters below are not divisible by the current PPC setting,
     	 * log an error as VTC does not support such video timing
     	 */
-		if (VideoTiming.HActiveVideo & 0x1 || VideoTiming.HFrontPorch & 0x1 ||
-				VideoTiming.HBackPorch & 0x1 || VideoTiming.HSyncWidth & 0x1) {
+		if (VideoTiming->HActiveVideo & 0x1 || VideoTiming->HFrontPorch & 0x1 ||
+				VideoTiming->HBackPorch & 0x1 || VideoTiming->HSyncWidth & 0x1) {
 #ifdef XV_HDMITXSS_LOG_ENABLE
 			XV_HdmiTxSs_LogWrite(HdmiTxSsPtr,
 					XV_HDMITXSS_LOG_EVT_VTC_RES_ERR, 0);
 #endif
 		}
-		VideoTiming.HActiveVideo = VideoTiming.HActiveVideo/2;
-		VideoTiming.HFrontPorch = VideoTiming.HFrontPorch/2;
-		VideoTiming.HBackPorch = VideoTiming.HBackPorch/2;
-		VideoTiming.HSyncWidth = VideoTiming.HSyncWidth/2;
+		VideoTiming->HActiveVideo = VideoTiming->HActiveVideo/2;
+		VideoTiming->HFrontPorch = VideoTiming->HFrontPorch/2;
+		VideoTiming->HBackPorch = VideoTiming->HBackPorch/2;
+		VideoTiming->HSyncWidth = VideoTiming->HSyncWidth/2;
     }
 
 /** When compensating the vtc horizontal timing parameters for the pixel mode
@@ -951,9 +949,9 @@ static int XV_HdmiTxSs_VtcSetup(XV_HdmiTxSs *HdmiTxSsPtr)
 
   do {
     // Calculate vtc horizontal blanking
-    Vtc_Hblank = VideoTiming.HFrontPorch +
-        VideoTiming.HBackPorch +
-        VideoTiming.HSyncWidth;
+    Vtc_Hblank = VideoTiming->HFrontPorch +
+        VideoTiming->HBackPorch +
+        VideoTiming->HSyncWidth;
 
     // Quad pixel mode
     if (HdmiTxSsPtr->HdmiTxPtr->Stream.Video.PixPerClk == XVIDC_PPC_4) {
@@ -978,7 +976,7 @@ static int XV_HdmiTxSs_VtcSetup(XV_HdmiTxSs *HdmiTxSsPtr)
     // If the horizontal total blanking differs,
     // then increment the Vtc horizontal front porch.
     if (Vtc_Hblank != HdmiTx_Hblank) {
-      VideoTiming.HFrontPorch++;
+      VideoTiming->HFrontPorch++;
     }
 
   } while (Vtc_Hblank < HdmiTx_Hblank);
@@ -993,7 +991,71 @@ static int XV_HdmiTxSs_VtcSetup(XV_HdmiTxSs *HdmiTxSsPtr)
       return (XST_FAILURE);
   }
 
-  XVtc_SetGeneratorTiming(HdmiTxSsPtr->VtcPtr, &VideoTiming);
+  Cache->IsValid = TRUE;
+  Cache->HActive = Timing->HActive;
+  Cache->HFrontPorch = Timing->HFrontPorch;
+  Cache->HSyncWidth = Timing->HSyncWidth;
+  Cache->HBackPorch = Timing->HBackPorch;
+  Cache->PixPerClk = Video->PixPerClk;
+  Cache->ColorFormatId = Video->ColorFormatId;
+  Cache->VtcHActive = VideoTiming->HActiveVideo;
+  Cache->VtcHFrontPorch = VideoTiming->HFrontPorch;
+  Cache->VtcHSyncWidth = VideoTiming->HSyncWidth;
+  Cache->VtcHBackPorch = VideoTiming->HBackPorch;
+
+  return (XST_SUCCESS);
+
+}
+
+/*****************************************************************************/
+/**
+*
+* This function configures Video Timing Controller (VTC). The generator
+* registers are only written where they differ from the last setup, and the
+* VTC is left untouched when the timing did not change.
+*
+* @param  None.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static int XV_HdmiTxSs_VtcSetup(XV_HdmiTxSs *HdmiTxSsPtr)
+{
+  /* Polarity configuration */
+  XVtc_Polarity Polarity;
+  XVtc_SourceSelect SourceSelect;
+  XVtc_Timing VideoTiming;
+  XVtc_GeneratorRegs GenRegs;
+  XVtc *VtcPtr = HdmiTxSsPtr->VtcPtr;
+
+  memset((void *)&VideoTiming, 0, sizeof(VideoTiming));
+  VideoTiming.HSyncPolarity = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.HSyncPolarity;
+
+  /* Vertical Timing */
+  VideoTiming.VActiveVideo = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.VActive;
+
+  VideoTiming.V0FrontPorch = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F0PVFrontPorch;
+  VideoTiming.V0BackPorch = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F0PVBackPorch;
+  VideoTiming.V0SyncWidth = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F0PVSyncWidth;
+
+  VideoTiming.V1FrontPorch = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F1VFrontPorch;
+  VideoTiming.V1SyncWidth = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F1VSyncWidth;
+  VideoTiming.V1BackPorch = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.F1VBackPorch;
+
+  VideoTiming.VSyncPolarity = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.Timing.VSyncPolarity;
+
+  VideoTiming.Interlaced = HdmiTxSsPtr->HdmiTxPtr->Stream.Video.IsInterlaced;
+
+  if (XV_HdmiTxSs_VtcHoriTiming(HdmiTxSsPtr, &VideoTiming) != XST_SUCCESS) {
+    /* Disable Generator */
+    XVtc_Reset(VtcPtr);
+    XVtc_InvalidateGenerator(VtcPtr);
+    XVtc_DisableGenerator(VtcPtr);
+    XVtc_Disable(VtcPtr);
+    return (XST_FAILURE);
+  }
 
   /* Set up Polarity of all outputs */
   memset((void *)&Polarity, 0, sizeof(XVtc_Polarity));
@@ -1013,24 +1075,64 @@ static int XV_HdmiTxSs_VtcSetup(XV_HdmiTxSs *HdmiTxSsPtr)
   Polarity.HBlankPol = VideoTiming.HSyncPolarity;
   Polarity.HSyncPol = VideoTiming.HSyncPolarity;
 
-  XVtc_SetPolarity(HdmiTxSsPtr->VtcPtr, &Polarity);
+  XVtc_ConvTiming2GeneratorRegs(VtcPtr, &VideoTiming, &Polarity, &GenRegs);
 
   /* VTC driver does not take care of the setting of the VTC in
    * interlaced operation. As a work around the register
    * is set manually */
   if (VideoTiming.Interlaced) {
     /* Interlaced mode */
-    XVtc_WriteReg(HdmiTxSsPtr->VtcPtr->Config.BaseAddress, 0x68, 0x42);
+    GenRegs.Reg[XVTC_GEN_REG_FENC] = 0x42;
   }
   else {
     /* Progressive mode */
-    XVtc_WriteReg(HdmiTxSsPtr->VtcPtr->Config.BaseAddress, 0x68, 0x2);
+    GenRegs.Reg[XVTC_GEN_REG_FENC] = 0x2;
   }
 
-  /* Enable generator module */
-  XVtc_Enable(HdmiTxSsPtr->VtcPtr);
-  XVtc_EnableGenerator(HdmiTxSsPtr->VtcPtr);
-  XVtc_RegUpdateEnable(HdmiTxSsPtr->VtcPtr);
+  if (!VtcPtr->GenShadowValid) {
+    /* Disable Generator */
+    XVtc_Reset(VtcPtr);
+    XVtc_DisableGenerator(VtcPtr);
+    XVtc_Disable(VtcPtr);
+
+    /* Set up source select */
+    memset((void *)&SourceSelect, 0, sizeof(SourceSelect));
+
+    /* 1 = Generator registers, 0 = Detector registers */
+    SourceSelect.VChromaSrc = 1;
+    SourceSelect.VActiveSrc = 1;
+    SourceSelect.VBackPorchSrc = 1;
+    SourceSelect.VSyncSrc = 1;
+    SourceSelect.VFrontPorchSrc = 1;
+    SourceSelect.VTotalSrc = 1;
+    SourceSelect.HActiveSrc = 1;
+    SourceSelect.HBackPorchSrc = 1;
+    SourceSelect.HSyncSrc = 1;
+    SourceSelect.HFrontPorchSrc = 1;
+    SourceSelect.HTotalSrc = 1;
+
+    XVtc_SetSource(VtcPtr, &SourceSelect);
+
+    XVtc_CommitGenerator(VtcPtr, &GenRegs);
+
+    /* Enable generator module */
+    XVtc_Enable(VtcPtr);
+    XVtc_EnableGenerator(VtcPtr);
+    XVtc_RegUpdateEnable(VtcPtr);
+  }
+  else {
+    /* Write the changed registers only, they are transferred at the end
+     * of the frame once the register update is enabled again. Nothing
+     * to do if the previous setup is still active */
+    if (memcmp(&GenRegs, &VtcPtr->GenShadow, sizeof(GenRegs))) {
+      XVtc_RegUpdateDisable(VtcPtr);
+      XVtc_CommitGenerator(VtcPtr, &GenRegs);
+      XVtc_RegUpdateEnable(VtcPtr);
+    }
+    /* The generator may have been stopped by XV_HdmiTxSs_Stop */
+    XVtc_Enable(VtcPtr);
+    XVtc_EnableGenerator(VtcPtr);
+  }
 
   return (XST_SUCCESS);
 }
@@ -1651,6 +1753,101 @@ int XV_HdmiTxSs_ReadEdidSegment(XV_HdmiTxSs *InstancePtr, u8 *Buffer, u8 segment
   return Status;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function reads a single 128-byte block from the HDMI Sink EDID. Blocks
+* beyond the first two are addressed through the E-DDC segment pointer, so
+* all blocks of an EDID with more than one extension can be read without
+* reading the rest of the segment.
+*
+* @param  InstancePtr is a pointer to the XV_HdmiTxSs core instance.
+* @param  Buffer is a pointer to a buffer of at least 128 bytes.
+* @param  Block is the EDID block number (0-255).
+*
+* @return
+*         - XST_SUCCESS if the block has been read.
+*         - XST_FAILURE if no sink is connected or the DDC transfer failed.
+*
+* @note   None.
+*
+******************************************************************************/
+int XV_HdmiTxSs_ReadEdidBlock(XV_HdmiTxSs *InstancePtr, u8 *Buffer, u8 Block)
+{
+	u32 Status;
+	u8 Segment = Block >> 1;
+	u8 Offset = (Block & 0x1) ? 0x80 : 0x00;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Buffer != NULL);
+
+	/* Check if a sink is connected */
+	if (InstancePtr->IsStreamConnected != (TRUE))
+		return (XST_FAILURE);
+
+	/* Segment Pointer, the first segment does not need one */
+	if (Segment != 0) {
+		Status = XV_HdmiTx_DdcWrite(InstancePtr->HdmiTxPtr, 0x30, 1,
+					    &Segment, (FALSE));
+		if (Status != (XST_SUCCESS))
+			return Status;
+	}
+
+	/* Block offset within the segment */
+	Status = XV_HdmiTx_DdcWrite(InstancePtr->HdmiTxPtr, 0x50, 1, &Offset,
+				    (FALSE));
+
+	/* Check if write was successful */
+	if (Status == (XST_SUCCESS)) {
+		/* Read block */
+		Status = XV_HdmiTx_DdcRead(InstancePtr->HdmiTxPtr, 0x50, 128,
+					   Buffer, (TRUE));
+	}
+
+	return Status;
+}
+
+
+/*****************************************************************************/
+/**
+*
+* This function applies a new video timing to a running HDMI TX stream. Only
+* the VTC and the video bridge are reprogrammed; the link and the TX core
+* resets are left untouched. It is intended for mode changes that keep the
+* TMDS clock, color format, color depth and pixels per clock of the current
+* stream, as set by XV_HdmiTxSs_SetStream.
+*
+* @param  InstancePtr is a pointer to the Subsystem instance to be worked on.
+*
+* @return
+*         - XST_SUCCESS if the new timing has been applied.
+*         - XST_FAILURE if the stream is not up or the VTC cannot generate
+*           the timing. The VTC is then stopped and the caller must set
+*           the stream up again.
+*
+* @note   The VTC latches the new timing at the next frame boundary.
+*
+******************************************************************************/
+int XV_HdmiTxSs_UpdateVideoTiming(XV_HdmiTxSs *InstancePtr)
+{
+  Xil_AssertNonvoid(InstancePtr != NULL);
+
+  if (!InstancePtr->IsStreamUp) {
+    return (XST_FAILURE);
+  }
+
+  if (InstancePtr->VtcPtr) {
+    /* Setup VTC */
+    if (XV_HdmiTxSs_VtcSetup(InstancePtr) != XST_SUCCESS) {
+      return (XST_FAILURE);
+    }
+  }
+
+  /* Configure video bridge mode according to HW setting and video format */
+  XV_HdmiTxSs_ConfigBridgeMode(InstancePtr);
+
+  return (XST_SUCCESS);
+}
 
 /*****************************************************************************/
 /**
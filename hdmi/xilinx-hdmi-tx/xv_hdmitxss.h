@@ -89,6 +89,15 @@
 *       SM     28/02/18 Added XV_HdmiTxSS_SetAppVersion API and AppMajVer and
 *                           AppMinVer version number in XV_HdmiTxSs structure
 *       MMO    11/08/18 Added Bridge Overflow and Bridge Underflow Interrupt
+* 5.21  XLNX   10/18/26 Added XV_HdmiTxSs_UpdateVideoTiming API
+*                       Added XV_HdmiTxSs_ReadEdidBlock API
+*                       Made the HDCP event queue a lock-free single
+*                       producer single consumer ring with coalescing
+*                       Added XV_HdmiTxSs_VtcHoriCache
+*                       Added XV_HdmiTxSs_HdcpChangeContentStreamType and
+*                       XV_HdmiTxSs_HdcpIsContentStreamTypeChangePending
+*                       Added XV_HdmiTxSs_HdcpSetHdcp14Srm API and
+*                       Hdcp14SrmSize
 * </pre>
 *
 ******************************************************************************/
@@ -117,7 +126,8 @@ extern "C" {
 #if defined(XPAR_XHDCP_NUM_INSTANCES) || defined(XPAR_XHDCP22_TX_NUM_INSTANCES)
 #define USE_HDCP_TX
 #define XV_HDMITXSS_HDCP_KEYSEL 0x00u
-#define XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE 16
+/* Must be a power of two dividing 256, the Head and Tail counters wrap at 256 */
+#define XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE 32
 #endif
 
 #ifdef XPAR_XHDCP_NUM_INSTANCES
@@ -258,8 +268,15 @@ typedef enum {
 typedef struct
 {
     XV_HdmiTxSs_HdcpEvent   Queue[XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE]; /**< Data */
-    u8                      Tail;      /**< Tail pointer */
-    u8                      Head;      /**< Head pointer */
+    u8                      Tail;      /**< Tail counter, consumer only */
+    u8                      Head;      /**< Head counter, producer only */
+    u32                     Overflow;  /**< Events dropped on a full queue */
+    u32                     Coalesced; /**< Events merged or cancelled */
+    XV_HdmiTxSs_HdcpEvent   LinkEvent; /**< Last connect or disconnect
+                                            pushed, producer only */
+    XV_HdmiTxSs_HdcpEvent   LinkEventTaken; /**< Last connect or
+                                            disconnect taken, consumer
+                                            only */
 } XV_HdmiTxSs_HdcpEventQueue;
 #endif
 
@@ -352,6 +369,26 @@ typedef struct
 */
 typedef void (*XV_HdmiTxSs_Callback)(void *CallbackRef);
 
+/**
+* Horizontal VTC timing of the last video mode, divided for the pixels per
+* clock and YUV 4:2:0 and compensated for the horizontal blanking, keyed by
+* the HDMI TX horizontal timing, pixels per clock and color format.
+*/
+typedef struct
+{
+    u8 IsValid;                       /**< Cache holds a result */
+    u16 HActive;                      /**< Key: HDMI TX horizontal timing */
+    u16 HFrontPorch;
+    u16 HSyncWidth;
+    u16 HBackPorch;
+    XVidC_PixelsPerClock PixPerClk;   /**< Key: pixels per clock */
+    XVidC_ColorFormat ColorFormatId;  /**< Key: color format */
+    u16 VtcHActive;                   /**< VTC horizontal timing */
+    u16 VtcHFrontPorch;
+    u16 VtcHSyncWidth;
+    u16 VtcHBackPorch;
+} XV_HdmiTxSs_VtcHoriCache;
+
 /**
 * The XVprocss driver instance data. The user is required to allocate a variable
 * of this type for every XVprocss device in the system. A pointer to a variable
@@ -374,6 +411,7 @@ typedef struct
 #endif
     XV_HdmiTx *HdmiTxPtr;           /**< handle to sub-core driver instance */
     XVtc *VtcPtr;                   /**< handle to sub-core driver instance */
+    XV_HdmiTxSs_VtcHoriCache VtcHoriCache; /**< Last VTC horizontal timing */
 
     /* Callbacks */
     XV_HdmiTxSs_Callback ConnectCallback; /**< Callback for connect event */
@@ -436,6 +474,7 @@ typedef struct
 #ifdef XPAR_XHDCP_NUM_INSTANCES
     u8                          *Hdcp14KeyPtr;   /**< Pointer to HDCP 1.4 key */
     u8                          *Hdcp14SrmPtr;   /**< Pointer to HDCP 1.4 SRM */
+    u32                         Hdcp14SrmSize;   /**< Size of HDCP 1.4 SRM */
 #endif
 #endif
 } XV_HdmiTxSs;
@@ -475,8 +514,10 @@ int XV_HdmiTxSs_SetCallback(XV_HdmiTxSs *InstancePtr,
 		void *CallbackRef);
 int XV_HdmiTxSs_ReadEdid(XV_HdmiTxSs *InstancePtr, u8 *BufferPtr);
 int XV_HdmiTxSs_ReadEdidSegment(XV_HdmiTxSs *InstancePtr, u8 *Buffer, u8 segment);
+int XV_HdmiTxSs_ReadEdidBlock(XV_HdmiTxSs *InstancePtr, u8 *Buffer, u8 Block);
 void XV_HdmiTxSs_SetScrambler(XV_HdmiTxSs *InstancePtr, u8 Enable);
 void XV_HdmiTxSs_StreamStart(XV_HdmiTxSs *InstancePtr);
+int XV_HdmiTxSs_UpdateVideoTiming(XV_HdmiTxSs *InstancePtr);
 void XV_HdmiTxSs_SendAuxInfoframe(XV_HdmiTxSs *InstancePtr, void *AuxPtr);
 u32 XV_HdmiTxSs_SendGenericAuxInfoframe(XV_HdmiTxSs *InstancePtr, void *AuxPtr);
 void XV_HdmiTxSs_SetAudioChannels(XV_HdmiTxSs *InstancePtr, u8 AudioChannels);
@@ -529,6 +570,7 @@ int XV_HdmiTxSs_ShowInfo(XV_HdmiTxSs *InstancePtr, char *buff, int buff_size);
 
 #ifdef USE_HDCP_TX
 void XV_HdmiTxSs_HdcpSetKey(XV_HdmiTxSs *InstancePtr, XV_HdmiTxSs_HdcpKeyType KeyType, u8 *KeyPtr);
+int XV_HdmiTxSs_HdcpSetHdcp14Srm(XV_HdmiTxSs *InstancePtr, u8 *SrmPtr, u32 SrmSize);
 int XV_HdmiTxSs_HdcpPoll(XV_HdmiTxSs *InstancePtr);
 int XV_HdmiTxSs_HdcpSetProtocol(XV_HdmiTxSs *InstancePtr, XV_HdmiTxSs_HdcpProtocol Protocol);
 int XV_HdmiTxSs_HdcpSetCapability(XV_HdmiTxSs *InstancePtr, XV_HdmiTxSs_HdcpProtocol Protocol);
@@ -556,6 +598,9 @@ u32 XV_HdmiTxSs_HdcpGetTopologyField(XV_HdmiTxSs *InstancePtr, XV_HdmiTxSs_HdcpT
 
 void XV_HdmiTxSs_HdcpSetContentStreamType(XV_HdmiTxSs *InstancePtr,
        XV_HdmiTxSs_HdcpContentStreamType StreamType);
+int XV_HdmiTxSs_HdcpChangeContentStreamType(XV_HdmiTxSs *InstancePtr,
+       XV_HdmiTxSs_HdcpContentStreamType StreamType);
+int XV_HdmiTxSs_HdcpIsContentStreamTypeChangePending(XV_HdmiTxSs *InstancePtr);
 int XV_HdmiTxSs_HdcpIsRepeater(XV_HdmiTxSs *InstancePtr);
 int XV_HdmiTxSs_HdcpSetRepeater(XV_HdmiTxSs *InstancePtr, u8 Set);
 int XV_HdmiTxSs_HdcpIsInComputations(XV_HdmiTxSs *InstancePtr);
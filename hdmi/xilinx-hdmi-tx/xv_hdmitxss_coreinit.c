@@ -51,6 +51,9 @@
 *                       Re-align coding style to ensure, 80 characters per row
 * 3.2   MH     04/24/17 Set default HDMI mode in XV_HdmiTxSs_SubcoreInitHdmiTx
 * 3.3   MH     07/17/17 Set HDCP 2.2 polling value to 10 ms.
+* 5.21  XLNX   10/18/26 Load the HDCP 1.4 SRM in
+*                       XV_HdmiTxSs_SubcoreInitHdcp14, continue with an
+*                       empty revocation list if it fails to load
 * </pre>
 *
 ******************************************************************************/
@@ -272,8 +275,17 @@ int XV_HdmiTxSs_SubcoreInitHdcp14(XV_HdmiTxSs *HdmiTxSsPtr)
       /* Key select */
       XHdcp1x_SetKeySelect(HdmiTxSsPtr->Hdcp14Ptr, XV_HDMITXSS_HDCP_KEYSEL);
 
-      /* Load SRM */
-
+      /* Load SRM, a bad SRM leaves the revocation list empty but does
+       * not keep HDCP 1.4 from working */
+      if (HdmiTxSsPtr->Hdcp14SrmPtr && HdmiTxSsPtr->Hdcp14SrmSize) {
+        Status = XHdcp1x_LoadRevocationList(HdmiTxSsPtr->Hdcp14Ptr,
+                                            HdmiTxSsPtr->Hdcp14SrmPtr,
+                                            HdmiTxSsPtr->Hdcp14SrmSize);
+        if (Status != XST_SUCCESS) {
+          xil_printf("HDMITXSS ERR:: HDCP 1.4 SRM load failed, "
+                     "using an empty revocation list\r\n");
+        }
+      }
 
       /* Disable HDCP 1.4 repeater */
       HdmiTxSsPtr->Hdcp14Ptr->IsRepeater = 0;
@@ -30,12 +30,20 @@
 * 3.20   MH  04/12/17 Updated function XV_HdmiTxSs_IsSinkHdcp14Capable and
 *                     XV_HdmiTxSs_IsSinkHdcp22Capable.
 *            08/09/17 Added function XV_HdmiTxSs_HdcpSetCapability
+* 5.21  XLNX 10/18/26 Made the HDCP event queue a lock-free single producer
+*                     single consumer ring, drained and coalesced in one pass
+*                     Added XV_HdmiTxSs_HdcpChangeContentStreamType and
+*                     XV_HdmiTxSs_HdcpIsContentStreamTypeChangePending
+*                     XV_HdmiTxSs_HdcpTimerBusyDelay sleeps on a software
+*                     timer
+*                     Added function XV_HdmiTxSs_HdcpSetHdcp14Srm
 * </pre>
 *
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
 #include <linux/version.h>
+#include <asm/barrier.h>
 #include "xv_hdmitxss.h"
 /************************** Constant Definitions *****************************/
 
@@ -46,7 +54,8 @@
 /************************** Function Prototypes ******************************/
 // HDCP specific
 #ifdef USE_HDCP_TX
-static XV_HdmiTxSs_HdcpEvent XV_HdmiTxSs_HdcpGetEvent(XV_HdmiTxSs *InstancePtr);
+static int XV_HdmiTxSs_HdcpGetEvents(XV_HdmiTxSs *InstancePtr,
+                                     XV_HdmiTxSs_HdcpEvent *EventsPtr);
 static int XV_HdmiTxSs_HdcpProcessEvents(XV_HdmiTxSs *InstancePtr);
 static int XV_HdmiTxSs_HdcpReset(XV_HdmiTxSs *InstancePtr);
 static u32 XV_HdmiTxSs_HdcpGetTopologyDepth(XV_HdmiTxSs *InstancePtr);
@@ -323,7 +332,8 @@ int XV_HdmiTxSs_HdcpTimerBusyDelay(void *InstancePtr, u16 DelayInMs)
     XTmrCtr_SetResetValue(TimerPtr, TimerChannel, NumTicks);
     XTmrCtr_Start(TimerPtr, TimerChannel);
 
-    /* Wait until done */
+    /* Wait until done, a software timer sleeps instead of spinning */
+    XTmrCtr_SoftWait(TimerPtr, TimerChannel);
     while (!XTmrCtr_IsExpired(TimerPtr, TimerChannel));
 
     return (XST_SUCCESS);
@@ -336,12 +346,21 @@ int XV_HdmiTxSs_HdcpTimerBusyDelay(void *InstancePtr, u16 DelayInMs)
 *
 * This function pushes an event into the HDCP event queue.
 *
+* The queue is a single producer single consumer ring: only this function
+* writes the head counter and only XV_HdmiTxSs_HdcpGetEvents and
+* XV_HdmiTxSs_HdcpClearEvents write the tail counter, so the interrupt
+* handlers can push while the poll function drains without a lock.
+* An event equal to the most recent pending event is merged with it. When
+* the queue is full the event is dropped and counted in Overflow. A connect
+* or disconnect is also latched in LinkEvent before it is queued, so that
+* the consumer still sees the last link state change if it was dropped.
+*
 * @param InstancePtr is a pointer to the XV_HdmiTxSs instance.
 * @param Event is the event to be pushed in the queue.
 *
 * @return
 *  - XST_SUCCESS if action was successful
-*  - XST_FAILURE if action was not successful
+*  - XST_FAILURE if the queue is full
 *
 * @note   None.
 *
@@ -349,37 +368,105 @@ int XV_HdmiTxSs_HdcpTimerBusyDelay(void *InstancePtr, u16 DelayInMs)
 int XV_HdmiTxSs_HdcpPushEvent(XV_HdmiTxSs *InstancePtr,
                               XV_HdmiTxSs_HdcpEvent Event)
 {
+  XV_HdmiTxSs_HdcpEventQueue *QueuePtr;
+  u8 Head;
+  u8 Tail;
+
   /* Verify argument. */
   Xil_AssertNonvoid(InstancePtr != NULL);
   Xil_AssertNonvoid(Event < XV_HDMITXSS_HDCP_INVALID_EVT);
 
-  /* Write event into the queue */
-  InstancePtr->HdcpEventQueue.Queue[InstancePtr->HdcpEventQueue.Head] = Event;
+  QueuePtr = &InstancePtr->HdcpEventQueue;
 
-  /* Update head pointer */
-  if (InstancePtr->HdcpEventQueue.Head ==
-                                        (XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE - 1)) {
-    InstancePtr->HdcpEventQueue.Head = 0;
+  if ((Event == XV_HDMITXSS_HDCP_CONNECT_EVT) ||
+      (Event == XV_HDMITXSS_HDCP_DISCONNECT_EVT)) {
+    smp_store_release(&QueuePtr->LinkEvent, Event);
   }
-  else {
-    InstancePtr->HdcpEventQueue.Head++;
+
+  Head = QueuePtr->Head;
+  Tail = smp_load_acquire(&QueuePtr->Tail);
+
+  /* Merge with the most recent pending event. Should the consumer take
+   * that event at the same time, it is still processed once, which is all
+   * a repeated event asks for. */
+  if ((Head != Tail) &&
+      (QueuePtr->Queue[(u8)(Head - 1) % XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE] ==
+                                                                      Event)) {
+    QueuePtr->Coalesced++;
+    return XST_SUCCESS;
   }
 
-  /* Check tail pointer. When the two pointer are equal, then the buffer
-   * is full. In this case then increment the tail pointer as well to
-   * remove the oldest entry from the buffer.
-   */
-  if (InstancePtr->HdcpEventQueue.Tail == InstancePtr->HdcpEventQueue.Head) {
-    if (InstancePtr->HdcpEventQueue.Tail ==
-                                        (XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE - 1)) {
-      InstancePtr->HdcpEventQueue.Tail = 0;
+  if ((u8)(Head - Tail) == XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE) {
+    QueuePtr->Overflow++;
+    return XST_FAILURE;
+  }
+
+  /* Write event into the queue before publishing it */
+  QueuePtr->Queue[Head % XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE] = Event;
+  smp_store_release(&QueuePtr->Head, (u8)(Head + 1));
+
+  return XST_SUCCESS;
+}
+#endif
+
+#ifdef USE_HDCP_TX
+/*****************************************************************************/
+/**
+*
+* This function appends an event taken from the HDCP event queue to the
+* events to be processed, coalescing it with the events already there:
+*  - repeated events are merged into one,
+*  - a connect or disconnect that repeats the current link state is merged,
+*  - a connect directly followed by a disconnect cancels out,
+*  - an authenticate request followed by a disconnect or stream down is
+*    dropped, as the HDCP is reset anyway.
+*
+* @param QueuePtr is a pointer to the HDCP event queue.
+* @param EventsPtr is a pointer to the events to be processed.
+* @param Count is the number of events in EventsPtr.
+* @param Event is the event to append.
+*
+* @return The new number of events in EventsPtr.
+*
+* @note   None.
+*
+******************************************************************************/
+static int XV_HdmiTxSs_HdcpAddEvent(XV_HdmiTxSs_HdcpEventQueue *QueuePtr,
+                                    XV_HdmiTxSs_HdcpEvent *EventsPtr,
+                                    int Count, XV_HdmiTxSs_HdcpEvent Event)
+{
+  if ((Event == XV_HDMITXSS_HDCP_CONNECT_EVT) ||
+      (Event == XV_HDMITXSS_HDCP_DISCONNECT_EVT)) {
+    if (Event == QueuePtr->LinkEventTaken) {
+      QueuePtr->Coalesced++;
+      return Count;
     }
-    else {
-      InstancePtr->HdcpEventQueue.Tail++;
+    QueuePtr->LinkEventTaken = Event;
+  }
+
+  if ((Event == XV_HDMITXSS_HDCP_DISCONNECT_EVT) ||
+      (Event == XV_HDMITXSS_HDCP_STREAMDOWN_EVT)) {
+    while ((Count > 0) &&
+           (EventsPtr[Count - 1] == XV_HDMITXSS_HDCP_AUTHENTICATE_EVT)) {
+      Count--;
+      QueuePtr->Coalesced++;
     }
   }
 
-  return XST_SUCCESS;
+  if ((Count > 0) && (EventsPtr[Count - 1] == Event)) {
+    QueuePtr->Coalesced++;
+  }
+  else if ((Count > 0) &&
+           (EventsPtr[Count - 1] == XV_HDMITXSS_HDCP_CONNECT_EVT) &&
+           (Event == XV_HDMITXSS_HDCP_DISCONNECT_EVT)) {
+    Count--;
+    QueuePtr->Coalesced += 2;
+  }
+  else {
+    EventsPtr[Count++] = Event;
+  }
+
+  return Count;
 }
 #endif
 
@@ -387,40 +474,54 @@ int XV_HdmiTxSs_HdcpPushEvent(XV_HdmiTxSs *InstancePtr,
 /*****************************************************************************/
 /**
 *
-* This function gets an event from the HDCP event queue.
+* This function takes all pending events from the HDCP event queue and
+* coalesces them, see XV_HdmiTxSs_HdcpAddEvent. A connect or disconnect
+* that was dropped on a full queue is recovered from the LinkEvent latch
+* and appended last, as it is newer than every queued event.
 *
 * @param InstancePtr is a pointer to the XV_HdmiTxSs instance.
+* @param EventsPtr is a pointer to an array of at least
+*        XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE + 1 events receiving the events.
 *
-* @return When the queue is filled, the next event is returned.
-*         When the queue is empty, XV_HDMITXSS_HDCP_NO_EVT is returned.
+* @return The number of events written to EventsPtr.
 *
 * @note   None.
 *
 ******************************************************************************/
-static XV_HdmiTxSs_HdcpEvent XV_HdmiTxSs_HdcpGetEvent(XV_HdmiTxSs *InstancePtr)
+static int XV_HdmiTxSs_HdcpGetEvents(XV_HdmiTxSs *InstancePtr,
+                                     XV_HdmiTxSs_HdcpEvent *EventsPtr)
 {
+  XV_HdmiTxSs_HdcpEventQueue *QueuePtr;
   XV_HdmiTxSs_HdcpEvent Event;
+  int Count = 0;
+  u8 Head;
+  u8 Tail;
 
   /* Verify argument. */
   Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(EventsPtr != NULL);
 
-  /* Check if there are any events in the queue */
-  if (InstancePtr->HdcpEventQueue.Tail == InstancePtr->HdcpEventQueue.Head) {
-    return XV_HDMITXSS_HDCP_NO_EVT;
+  QueuePtr = &InstancePtr->HdcpEventQueue;
+  Tail = QueuePtr->Tail;
+  Head = smp_load_acquire(&QueuePtr->Head);
+
+  while (Tail != Head) {
+    Event = QueuePtr->Queue[Tail % XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE];
+    Tail++;
+    Count = XV_HdmiTxSs_HdcpAddEvent(QueuePtr, EventsPtr, Count, Event);
   }
 
-  Event = InstancePtr->HdcpEventQueue.Queue[InstancePtr->HdcpEventQueue.Tail];
+  /* Release the slots to the producer */
+  smp_store_release(&QueuePtr->Tail, Tail);
 
-  /* Update tail pointer */
-  if (InstancePtr->HdcpEventQueue.Tail ==
-                                        (XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE - 1)) {
-    InstancePtr->HdcpEventQueue.Tail = 0;
-  }
-  else {
-    InstancePtr->HdcpEventQueue.Tail++;
+  /* The latch is read after the queue, a connect or disconnect that is
+   * still queued behind Head is then merged when it is taken later */
+  Event = smp_load_acquire(&QueuePtr->LinkEvent);
+  if (Event != XV_HDMITXSS_HDCP_NO_EVT) {
+    Count = XV_HdmiTxSs_HdcpAddEvent(QueuePtr, EventsPtr, Count, Event);
   }
 
-  return Event;
+  return Count;
 }
 #endif
 
@@ -436,7 +537,8 @@ static XV_HdmiTxSs_HdcpEvent XV_HdmiTxSs_HdcpGetEvent(XV_HdmiTxSs *InstancePtr)
 *  - XST_SUCCESS if action was successful
 *  - XST_FAILURE if action was not successful
 *
-* @note   None.
+* @note   This function acts as the consumer of the queue and must not run
+*         concurrently with XV_HdmiTxSs_HdcpPoll.
 *
 ******************************************************************************/
 int XV_HdmiTxSs_HdcpClearEvents(XV_HdmiTxSs *InstancePtr)
@@ -444,8 +546,11 @@ int XV_HdmiTxSs_HdcpClearEvents(XV_HdmiTxSs *InstancePtr)
   /* Verify argument. */
   Xil_AssertNonvoid(InstancePtr != NULL);
 
-  InstancePtr->HdcpEventQueue.Head = 0;
-  InstancePtr->HdcpEventQueue.Tail = 0;
+  smp_store_release(&InstancePtr->HdcpEventQueue.Tail,
+                    smp_load_acquire(&InstancePtr->HdcpEventQueue.Head));
+  /* The cleared link state changes are not replayed from the latch */
+  InstancePtr->HdcpEventQueue.LinkEventTaken =
+                    smp_load_acquire(&InstancePtr->HdcpEventQueue.LinkEvent);
 
   return XST_SUCCESS;
 }
@@ -455,7 +560,8 @@ int XV_HdmiTxSs_HdcpClearEvents(XV_HdmiTxSs *InstancePtr)
 /*****************************************************************************/
 /**
 *
-* This function processes pending events from the HDCP event queue.
+* This function processes all pending events from the HDCP event queue
+* in one pass.
 *
 * @param InstancePtr is a pointer to the XV_HdmiTxSs instance.
 *
@@ -468,58 +574,62 @@ int XV_HdmiTxSs_HdcpClearEvents(XV_HdmiTxSs *InstancePtr)
 ******************************************************************************/
 static int XV_HdmiTxSs_HdcpProcessEvents(XV_HdmiTxSs *InstancePtr)
 {
-  XV_HdmiTxSs_HdcpEvent Event;
+  XV_HdmiTxSs_HdcpEvent Events[XV_HDMITXSS_HDCP_MAX_QUEUE_SIZE + 1];
+  int Count;
+  int i;
   int Status = XST_SUCCESS;
 
   /* Verify argument. */
   Xil_AssertNonvoid(InstancePtr != NULL);
 
-  Event = XV_HdmiTxSs_HdcpGetEvent(InstancePtr);
-  switch (Event) {
+  Count = XV_HdmiTxSs_HdcpGetEvents(InstancePtr, Events);
+  for (i = 0; i < Count; i++) {
+    switch (Events[i]) {
 
-    // Stream up
-    // Attempt authentication with downstream device
-    case XV_HDMITXSS_HDCP_STREAMUP_EVT :
+      // Stream up
+      // Attempt authentication with downstream device
+      case XV_HDMITXSS_HDCP_STREAMUP_EVT :
 #ifdef XPAR_XHDCP_NUM_INSTANCES
-      if (InstancePtr->Hdcp14Ptr) {
-        // Set physical state
-        XHdcp1x_SetPhysicalState(InstancePtr->Hdcp14Ptr, TRUE);
-        // This is needed to ensure that the previous command is executed.
-        XHdcp1x_Poll(InstancePtr->Hdcp14Ptr);
-      }
+        if (InstancePtr->Hdcp14Ptr) {
+          // Set physical state
+          XHdcp1x_SetPhysicalState(InstancePtr->Hdcp14Ptr, TRUE);
+          // This is needed to ensure that the previous command is executed.
+          XHdcp1x_Poll(InstancePtr->Hdcp14Ptr);
+        }
 #endif
-      break;
+        break;
 
-    // Stream down
-    case XV_HDMITXSS_HDCP_STREAMDOWN_EVT :
+      // Stream down
+      case XV_HDMITXSS_HDCP_STREAMDOWN_EVT :
 #ifdef XPAR_XHDCP_NUM_INSTANCES
-      if (InstancePtr->Hdcp14Ptr) {
-        // Set physical state
-        XHdcp1x_SetPhysicalState(InstancePtr->Hdcp14Ptr, FALSE);
-        // This is needed to ensure that the previous command is executed.
-        XHdcp1x_Poll(InstancePtr->Hdcp14Ptr);
-      }
+        if (InstancePtr->Hdcp14Ptr) {
+          // Set physical state
+          XHdcp1x_SetPhysicalState(InstancePtr->Hdcp14Ptr, FALSE);
+          // This is needed to ensure that the previous command is executed.
+          XHdcp1x_Poll(InstancePtr->Hdcp14Ptr);
+        }
 #endif
-      XV_HdmiTxSs_HdcpReset(InstancePtr);
-      break;
+        XV_HdmiTxSs_HdcpReset(InstancePtr);
+        break;
 
-    // Connect
-    case XV_HDMITXSS_HDCP_CONNECT_EVT :
-      break;
+      // Connect
+      case XV_HDMITXSS_HDCP_CONNECT_EVT :
+        break;
 
-    // Disconnect
-    // Reset both HDCP protocols
-    case XV_HDMITXSS_HDCP_DISCONNECT_EVT :
-      XV_HdmiTxSs_HdcpReset(InstancePtr);
-      break;
+      // Disconnect
+      // Reset both HDCP protocols
+      case XV_HDMITXSS_HDCP_DISCONNECT_EVT :
+        XV_HdmiTxSs_HdcpReset(InstancePtr);
+        break;
 
-    // Authenticate
-    case XV_HDMITXSS_HDCP_AUTHENTICATE_EVT :
-      XV_HdmiTxSs_HdcpAuthRequest(InstancePtr);
-      break;
+      // Authenticate
+      case XV_HDMITXSS_HDCP_AUTHENTICATE_EVT :
+        XV_HdmiTxSs_HdcpAuthRequest(InstancePtr);
+        break;
 
-    default :
-      break;
+      default :
+        break;
+    }
   }
 
   return Status;
@@ -1511,6 +1621,51 @@ void XV_HdmiTxSs_HdcpSetKey(XV_HdmiTxSs *InstancePtr,
       break;
   }
 }
+
+/*****************************************************************************/
+/**
+*
+* This function sets the HDCP 1.4 System Renewability Message (SRM). Unlike
+* the HDCP 2.2 SRM, the size of an HDCP 1.4 SRM can not be known in advance,
+* so it is set here rather than with XV_HdmiTxSs_HdcpSetKey. The KSV
+* revocation list is loaded from the SRM immediately if HDCP 1.4 is
+* initialized, else by XV_HdmiTxSs_CfgInitializeHdcp.
+*
+* @param InstancePtr is a pointer to the XV_HdmiTxSs instance.
+* @param SrmPtr is a pointer to the SRM, which must stay valid while
+*        it is set.
+* @param SrmSize is the size of the SRM in bytes.
+*
+* @return
+*  - XST_SUCCESS if the SRM is set.
+*  - XST_FAILURE if the SRM is malformed or HDCP 1.4 is not included.
+*
+* @note   The DCP LLC signature of the SRM is not verified.
+*
+******************************************************************************/
+int XV_HdmiTxSs_HdcpSetHdcp14Srm(XV_HdmiTxSs *InstancePtr, u8 *SrmPtr,
+                                 u32 SrmSize)
+{
+  /* Verify arguments. */
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(SrmPtr != NULL);
+
+#ifdef XPAR_XHDCP_NUM_INSTANCES
+  if (InstancePtr->Hdcp14Ptr && InstancePtr->Hdcp14Ptr->IsReady) {
+    if (XHdcp1x_LoadRevocationList(InstancePtr->Hdcp14Ptr,
+                                   SrmPtr, SrmSize) != XST_SUCCESS) {
+      return (XST_FAILURE);
+    }
+  }
+
+  InstancePtr->Hdcp14SrmPtr = SrmPtr;
+  InstancePtr->Hdcp14SrmSize = SrmSize;
+
+  return (XST_SUCCESS);
+#else
+  return (XST_FAILURE);
+#endif
+}
 #endif
 
 #ifdef USE_HDCP_TX
@@ -2148,6 +2303,102 @@ void XV_HdmiTxSs_HdcpSetContentStreamType(XV_HdmiTxSs *InstancePtr,
 }
 #endif
 
+#ifdef USE_HDCP_TX
+/*****************************************************************************/
+/**
+*
+* This function changes the HDCP content stream type on the authenticated
+* link, without re-authentication. An HDCP 2.2 repeater is sent the new type
+* with content stream management. Without an active protocol the type is
+* used by the next HDCP 2.2 authentication.
+*
+* @param InstancePtr is a pointer to the XV_HdmiTxSs instance.
+* @param StreamType is the content stream type.
+*
+* @return
+*  - XST_SUCCESS if the type is changed or the change is started
+*  - XST_FAILURE if the active protocol or the downstream topology does not
+*    allow Type 1 content
+*
+* @note   Type 1 content must not be transmitted before
+*         XV_HdmiTxSs_HdcpIsContentStreamTypeChangePending returns FALSE.
+*
+******************************************************************************/
+int XV_HdmiTxSs_HdcpChangeContentStreamType(XV_HdmiTxSs *InstancePtr,
+       XV_HdmiTxSs_HdcpContentStreamType StreamType)
+{
+  /* Verify argument. */
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(StreamType <= XV_HDMITXSS_HDCP_STREAMTYPE_1);
+
+  switch (InstancePtr->HdcpProtocol)
+  {
+    // HDCP 1.4 links only carry Type 0 content
+    case XV_HDMITXSS_HDCP_14:
+      return (StreamType == XV_HDMITXSS_HDCP_STREAMTYPE_0) ?
+             XST_SUCCESS : XST_FAILURE;
+
+#ifdef XPAR_XHDCP22_TX_NUM_INSTANCES
+    // HDCP 2.2
+    case XV_HDMITXSS_HDCP_22:
+      if (InstancePtr->Hdcp22Ptr) {
+        return XHdcp22Tx_ChangeContentStreamType(InstancePtr->Hdcp22Ptr,
+                                   (XHdcp22_Tx_ContentStreamType) StreamType);
+      }
+      return XST_FAILURE;
+#endif
+
+    default:
+#ifdef XPAR_XHDCP22_TX_NUM_INSTANCES
+      if (InstancePtr->Hdcp22Ptr) {
+        XHdcp22Tx_SetContentStreamType(InstancePtr->Hdcp22Ptr,
+                                   (XHdcp22_Tx_ContentStreamType) StreamType);
+      }
+#endif
+      return XST_SUCCESS;
+  }
+}
+#endif
+
+#ifdef USE_HDCP_TX
+/*****************************************************************************/
+/**
+*
+* This function checks if a content stream type change started with
+* XV_HdmiTxSs_HdcpChangeContentStreamType is still in progress.
+*
+* @param InstancePtr is a pointer to the XV_HdmiTxSs instance.
+*
+* @return
+*  - TRUE if the repeater has not confirmed the new type yet
+*  - FALSE if the type is in effect
+*
+* @note   None.
+*
+******************************************************************************/
+int XV_HdmiTxSs_HdcpIsContentStreamTypeChangePending(XV_HdmiTxSs *InstancePtr)
+{
+  /* Verify argument. */
+  Xil_AssertNonvoid(InstancePtr != NULL);
+
+  switch (InstancePtr->HdcpProtocol)
+  {
+#ifdef XPAR_XHDCP22_TX_NUM_INSTANCES
+    // HDCP 2.2
+    case XV_HDMITXSS_HDCP_22:
+      if (InstancePtr->Hdcp22Ptr) {
+        return XHdcp22Tx_IsContentStreamTypeChangePending(
+                                   InstancePtr->Hdcp22Ptr);
+      }
+      return FALSE;
+#endif
+
+    default:
+      return FALSE;
+  }
+}
+#endif
+
 #ifdef USE_HDCP_TX
 /*****************************************************************************/
 /**
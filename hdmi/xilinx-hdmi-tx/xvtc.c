@@ -164,6 +164,10 @@
 * 			driver.
 * 	jsr    10/03/18	Corrected the VGA resoultion timing paramters w.r.t the
 * 			timing values given in the VTC GUI for 640x480p
+* 8.1   XLNX   10/18/26 Added XVtc_ConvTiming2GeneratorRegs and
+*                       XVtc_CommitGenerator. XVtc_SetGenerator,
+*                       XVtc_SetPolarity and XVtc_SetGeneratorHoriOffset
+*                       share the register conversion with them.
 * </pre>
 *
 ******************************************************************************/
@@ -195,8 +199,31 @@
 static void StubCallBack(void *CallBackRef, u32 Mask);
 static void StubErrCallBack(void *CallBackRef, u32 ErrorMask);
 
+static u32 XVtc_ConvPolarity2Reg(XVtc_Polarity *PolarityPtr);
+static void XVtc_ConvHoriOffsets2Regs(XVtc_HoriOffsets *HoriOffsets,
+				XVtc_GeneratorRegs *RegsPtr);
+static void XVtc_ConvSignal2Regs(XVtc_Signal *SignalCfgPtr,
+				XVtc_GeneratorRegs *RegsPtr);
+
 /************************** Variable Definitions *****************************/
 
+/* Offsets of the Generator registers, indexed by XVTC_GEN_REG_* */
+static const u32 XVtc_GenRegOffset[XVTC_GEN_NUM_REGS] = {
+	XVTC_GHSIZE_OFFSET,
+	XVTC_GVSIZE_OFFSET,
+	XVTC_GASIZE_OFFSET,
+	XVTC_GASIZE_F1_OFFSET,
+	XVTC_GHSYNC_OFFSET,
+	XVTC_GVSYNC_OFFSET,
+	XVTC_GVSYNC_F1_OFFSET,
+	XVTC_GFENC_OFFSET,
+	XVTC_GPOL_OFFSET,
+	XVTC_GVBHOFF_OFFSET,
+	XVTC_GVSHOFF_OFFSET,
+	XVTC_GVBHOFF_F1_OFFSET,
+	XVTC_GVSHOFF_F1_OFFSET
+};
+
 
 /************************** Function Definitions *****************************/
 
@@ -482,29 +509,12 @@ void XVtc_SetPolarity(XVtc *InstancePtr, XVtc_Polarity *PolarityPtr)
 	/* Change the register value according to the setting in the Polarity
 	 * configuration structure
 	 */
-	if (PolarityPtr->ActiveChromaPol)
-		PolRegValue |= XVTC_POL_ACP_MASK;
-
-	if (PolarityPtr->ActiveVideoPol)
-		PolRegValue |= XVTC_POL_AVP_MASK;
-
-	if (PolarityPtr->FieldIdPol)
-		PolRegValue |= XVTC_POL_FIP_MASK;
-
-	if (PolarityPtr->VBlankPol)
-		PolRegValue |= XVTC_POL_VBP_MASK;
-
-	if (PolarityPtr->VSyncPol)
-		PolRegValue |= XVTC_POL_VSP_MASK;
-
-	if (PolarityPtr->HBlankPol)
-		PolRegValue |= XVTC_POL_HBP_MASK;
-
-	if (PolarityPtr->HSyncPol)
-		PolRegValue |= XVTC_POL_HSP_MASK;
+	PolRegValue |= XVtc_ConvPolarity2Reg(PolarityPtr);
 
 	XVtc_WriteReg(InstancePtr->Config.BaseAddress, (XVTC_GPOL_OFFSET),
 			PolRegValue);
+
+	XVtc_InvalidateGenerator(InstancePtr);
 }
 
 /*****************************************************************************/
@@ -1133,48 +1143,25 @@ void XVtc_GetFSync(XVtc *InstancePtr, u16 FrameSyncIndex,
 void XVtc_SetGeneratorHoriOffset(XVtc *InstancePtr,
 				XVtc_HoriOffsets *HoriOffsets)
 {
-	u32 RegValue;
+	XVtc_GeneratorRegs Regs;
 
 	/* Assert bad arguments and conditions */
 	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 	Xil_AssertVoid(HoriOffsets != NULL);
 
-	/* Calculate and update Generator VBlank Hori. Offset 0 register value
-	 */
-	RegValue = (HoriOffsets->V0BlankHoriStart) & XVTC_XVXHOX_HSTART_MASK;
-	RegValue |= (HoriOffsets->V0BlankHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
-					XVTC_XVXHOX_HEND_MASK;
-	XVtc_WriteReg(InstancePtr->Config.BaseAddress, XVTC_GVBHOFF_OFFSET,
-								RegValue);
+	XVtc_ConvHoriOffsets2Regs(HoriOffsets, &Regs);
 
-	/* Calculate and update Generator VSync Hori. Offset 0 register
-	 * value
-	 */
-	RegValue = (HoriOffsets->V0SyncHoriStart) & XVTC_XVXHOX_HSTART_MASK;
-	RegValue |= (HoriOffsets->V0SyncHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
-					XVTC_XVXHOX_HEND_MASK;
+	XVtc_WriteReg(InstancePtr->Config.BaseAddress, XVTC_GVBHOFF_OFFSET,
+					Regs.Reg[XVTC_GEN_REG_VBHOFF]);
 	XVtc_WriteReg(InstancePtr->Config.BaseAddress, XVTC_GVSHOFF_OFFSET,
-								RegValue);
-
-	/* Calculate and update Generator VBlank Hori. Offset 1 register
-	 * value
-	 */
-	RegValue = (HoriOffsets->V1BlankHoriStart) & XVTC_XVXHOX_HSTART_MASK;
-	RegValue |= (HoriOffsets->V1BlankHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
-					XVTC_XVXHOX_HEND_MASK;
+					Regs.Reg[XVTC_GEN_REG_VSHOFF]);
 	XVtc_WriteReg(InstancePtr->Config.BaseAddress, XVTC_GVBHOFF_F1_OFFSET,
-								RegValue);
+					Regs.Reg[XVTC_GEN_REG_VBHOFF_F1]);
+	XVtc_WriteReg(InstancePtr->Config.BaseAddress, XVTC_GVSHOFF_F1_OFFSET,
+					Regs.Reg[XVTC_GEN_REG_VSHOFF_F1]);
 
-	/* Calculate and update Generator VSync Hori. Offset 1 register
-	 * value
-	 */
-	RegValue = (HoriOffsets->V1SyncHoriStart) & XVTC_XVXHOX_HSTART_MASK;
-	RegValue |= (HoriOffsets->V1SyncHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
-					XVTC_XVXHOX_HEND_MASK;
-	XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-						XVTC_GVSHOFF_F1_OFFSET,
-								RegValue);
+	XVtc_InvalidateGenerator(InstancePtr);
 }
 
 /*****************************************************************************/
@@ -1310,196 +1297,51 @@ void XVtc_GetDetectorHoriOffset(XVtc *InstancePtr,
 void XVtc_SetGenerator(XVtc *InstancePtr, XVtc_Signal *SignalCfgPtr)
 {
 	u32 RegValue;
-	u32 r_htotal, r_vtotal, r_hactive, r_vactive;
-	XVtc_Signal *SCPtr;
-	XVtc_HoriOffsets horiOffsets;
+	UINTPTR BaseAddress;
+	XVtc_GeneratorRegs Regs;
 
 	/* Verify arguments. */
 	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 	Xil_AssertVoid(SignalCfgPtr != NULL);
 
-	SCPtr = SignalCfgPtr;
-	if(SCPtr->OriginMode == 0)
-	{
-		r_htotal = SCPtr->HTotal+1;
-		r_vtotal = SCPtr->V0Total+1;
-
-		r_hactive = r_htotal - SCPtr->HActiveStart;
-		r_vactive = r_vtotal - SCPtr->V0ActiveStart;
-
-		RegValue = (r_htotal) & XVTC_SB_START_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-					XVTC_GHSIZE_OFFSET, RegValue);
-
-		RegValue = (r_vtotal) & XVTC_VSIZE_F0_MASK;
-		RegValue |= ((SCPtr->V1Total+1) << XVTC_VSIZE_F1_SHIFT) &
-							XVTC_VSIZE_F1_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-					XVTC_GVSIZE_OFFSET, RegValue);
-
-
-		RegValue = (r_hactive) & XVTC_ASIZE_HORI_MASK;
-		RegValue |= ((r_vactive) << XVTC_ASIZE_VERT_SHIFT ) &
-							XVTC_ASIZE_VERT_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-						XVTC_GASIZE_OFFSET, RegValue);
-		/* For some resolutions, the FIELD1 vactive size is different
-		 * from FIELD0, e.g. XVIDC_VM_720x486_60_I (SDI NTSC),
-		 * As there is no vactive FIELD1 entry in the video common
-		 * library, program it separately. For resolutions where
-		 * vactive values are different, it should be taken care in
-		 * corrosponding driver. Otherwise program same values in
-		 * FIELD0 and FIELD1 registers */
-		RegValue = ((r_vactive) << XVTC_ASIZE_VERT_SHIFT) &
-				XVTC_ASIZE_VERT_MASK;
-
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-						XVTC_GASIZE_F1_OFFSET, RegValue);
-
-		/* Update the Generator Horizontal 1 Register */
-		RegValue = (SCPtr->HSyncStart + r_hactive) &
-						XVTC_SB_START_MASK;
-		RegValue |= ((SCPtr->HBackPorchStart + r_hactive) <<
-				XVTC_SB_END_SHIFT) & XVTC_SB_END_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-					XVTC_GHSYNC_OFFSET, RegValue);
-
-		/* Update the Generator Vertical 1 Register (field 0) */
-		RegValue = (SCPtr->V0SyncStart + r_vactive -1) &
-						XVTC_SB_START_MASK;
-		RegValue |= ((SCPtr->V0BackPorchStart + r_vactive -1) <<
-				XVTC_SB_END_SHIFT) & XVTC_SB_END_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-					XVTC_GVSYNC_OFFSET, RegValue);
-
-		/* Update the Generator Vertical Sync Register (field 1) */
-		RegValue = (SCPtr->V1SyncStart + r_vactive -1) &
-						XVTC_SB_START_MASK;
-		RegValue |= ((SCPtr->V1BackPorchStart + r_vactive -1) <<
-					XVTC_SB_END_SHIFT) & XVTC_SB_END_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-					XVTC_GVSYNC_F1_OFFSET, RegValue);
-
-		/* Chroma Start */
-		RegValue = XVtc_ReadReg(InstancePtr->Config.BaseAddress,
-							XVTC_GFENC_OFFSET);
-		RegValue &= ~XVTC_ENC_CPARITY_MASK;
-		RegValue = (((SCPtr->V0ChromaStart - SCPtr->V0ActiveStart) <<
-						XVTC_ENC_CPARITY_SHIFT) &
-					XVTC_ENC_CPARITY_MASK) | RegValue;
-
-		RegValue &= ~XVTC_ENC_PROG_MASK;
-		RegValue |= (SCPtr->Interlaced << XVTC_ENC_PROG_SHIFT) &
-				XVTC_ENC_PROG_MASK;
-
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-						XVTC_GFENC_OFFSET, RegValue);
-
-		/* Setup default Horizontal Offsets - can override later with
-		 * XVtc_SetGeneratorHoriOffset()
-		 */
-		horiOffsets.V0BlankHoriStart = r_hactive;
-		horiOffsets.V0BlankHoriEnd = r_hactive;
-		horiOffsets.V0SyncHoriStart = SCPtr->HSyncStart + r_hactive;
-		horiOffsets.V0SyncHoriEnd = SCPtr->HSyncStart + r_hactive;
-
-		horiOffsets.V1BlankHoriStart = r_hactive;
-		horiOffsets.V1BlankHoriEnd = r_hactive;
-		horiOffsets.V1SyncHoriStart = SCPtr->HSyncStart + r_hactive;
-		horiOffsets.V1SyncHoriEnd = SCPtr->HSyncStart + r_hactive;
-
-	}
-	else
-	{
-		/* Total in mode=1 is the line width */
-		r_htotal = SCPtr->HTotal;
-		/* Total in mode=1 is the frame height */
-		r_vtotal = SCPtr->V0Total;
-		r_hactive = SCPtr->HFrontPorchStart;
-		r_vactive = SCPtr->V0FrontPorchStart;
-
-		RegValue = (r_htotal) & XVTC_SB_START_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-					XVTC_GHSIZE_OFFSET, RegValue);
-
-		RegValue = (r_vtotal) & XVTC_VSIZE_F0_MASK;
-		RegValue |= ((SCPtr->V1Total) << XVTC_VSIZE_F1_SHIFT) &
-							XVTC_VSIZE_F1_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-						XVTC_GVSIZE_OFFSET, RegValue);
-
-
-		RegValue = (r_hactive) & XVTC_ASIZE_HORI_MASK;
-		RegValue |= ((r_vactive) << XVTC_ASIZE_VERT_SHIFT) &
-							XVTC_ASIZE_VERT_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-						XVTC_GASIZE_OFFSET, RegValue);
-		/* For some resolutions, the FIELD1 vactive size is different
-		 * from FIELD0, e.g. XVIDC_VM_720x486_60_I (SDI NTSC),
-		 * As there is no vactive FIELD1 entry in the video common
-		 * library, program it separately. For resolutions where
-		 * vactive values are different, it should be taken care in
-		 * corrosponding driver. Otherwise program same values in
-		 * FIELD0 and FIELD1 registers */
-		RegValue = ((r_vactive) << XVTC_ASIZE_VERT_SHIFT) &
-				XVTC_ASIZE_VERT_MASK;
-
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-						XVTC_GASIZE_F1_OFFSET, RegValue);
-
-		/* Update the Generator Horizontal 1 Register */
-		RegValue = (SCPtr->HSyncStart) & XVTC_SB_START_MASK;
-		RegValue |= ((SCPtr->HBackPorchStart) << XVTC_SB_END_SHIFT) &
-						XVTC_SB_END_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-					XVTC_GHSYNC_OFFSET, RegValue);
-
-
-		/* Update the Generator Vertical Sync Register (field 0) */
-		RegValue = (SCPtr->V0SyncStart) & XVTC_SB_START_MASK;
-		RegValue |= ((SCPtr->V0BackPorchStart) << XVTC_SB_END_SHIFT) &
-						XVTC_SB_END_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-						XVTC_GVSYNC_OFFSET, RegValue);
-
-		/* Update the Generator Vertical Sync Register (field 1) */
-		RegValue = (SCPtr->V1SyncStart) & XVTC_SB_START_MASK;
-		RegValue |= ((SCPtr->V1BackPorchStart) << XVTC_SB_END_SHIFT) &
-						XVTC_SB_END_MASK;
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-					XVTC_GVSYNC_F1_OFFSET, RegValue);
-
-		/* Chroma Start */
-		  RegValue = XVtc_ReadReg(InstancePtr->Config.BaseAddress,
-							XVTC_GFENC_OFFSET);
-		RegValue &= ~XVTC_ENC_CPARITY_MASK;
-		RegValue = (((SCPtr->V0ChromaStart - SCPtr->V0ActiveStart) <<
-							XVTC_ENC_CPARITY_SHIFT)
-					& XVTC_ENC_CPARITY_MASK) | RegValue;
-
-		RegValue &= ~XVTC_ENC_PROG_MASK;
-		RegValue |= (SCPtr->Interlaced << XVTC_ENC_PROG_SHIFT) &
-						XVTC_ENC_PROG_MASK;
-
-		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
-					XVTC_GFENC_OFFSET, RegValue);
-
-		/* Setup default Horizontal Offsets - can override later with
-		 * XVtc_SetGeneratorHoriOffset()
-		 */
-		horiOffsets.V0BlankHoriStart = r_hactive;
-		horiOffsets.V0BlankHoriEnd = r_hactive;
-		horiOffsets.V0SyncHoriStart = SCPtr->HSyncStart;
-		horiOffsets.V0SyncHoriEnd = SCPtr->HSyncStart;
-		horiOffsets.V1BlankHoriStart = r_hactive;
-		horiOffsets.V1BlankHoriEnd = r_hactive;
-		horiOffsets.V1SyncHoriStart = SCPtr->HSyncStart;
-		horiOffsets.V1SyncHoriEnd = SCPtr->HSyncStart;
-
-	}
-	XVtc_SetGeneratorHoriOffset(InstancePtr, &horiOffsets);
-
+	BaseAddress = InstancePtr->Config.BaseAddress;
+	XVtc_ConvSignal2Regs(SignalCfgPtr, &Regs);
+
+	XVtc_WriteReg(BaseAddress, XVTC_GHSIZE_OFFSET,
+				Regs.Reg[XVTC_GEN_REG_HSIZE]);
+	XVtc_WriteReg(BaseAddress, XVTC_GVSIZE_OFFSET,
+				Regs.Reg[XVTC_GEN_REG_VSIZE]);
+	XVtc_WriteReg(BaseAddress, XVTC_GASIZE_OFFSET,
+				Regs.Reg[XVTC_GEN_REG_ASIZE]);
+	XVtc_WriteReg(BaseAddress, XVTC_GASIZE_F1_OFFSET,
+				Regs.Reg[XVTC_GEN_REG_ASIZE_F1]);
+	XVtc_WriteReg(BaseAddress, XVTC_GHSYNC_OFFSET,
+				Regs.Reg[XVTC_GEN_REG_HSYNC]);
+	XVtc_WriteReg(BaseAddress, XVTC_GVSYNC_OFFSET,
+				Regs.Reg[XVTC_GEN_REG_VSYNC]);
+	XVtc_WriteReg(BaseAddress, XVTC_GVSYNC_F1_OFFSET,
+				Regs.Reg[XVTC_GEN_REG_VSYNC_F1]);
+
+	/* Chroma Start and progressive/interlaced, keep the other bits */
+	RegValue = XVtc_ReadReg(BaseAddress, XVTC_GFENC_OFFSET);
+	RegValue &= ~(XVTC_ENC_CPARITY_MASK | XVTC_ENC_PROG_MASK);
+	RegValue |= Regs.Reg[XVTC_GEN_REG_FENC];
+	XVtc_WriteReg(BaseAddress, XVTC_GFENC_OFFSET, RegValue);
+
+	/* Setup default Horizontal Offsets - can override later with
+	 * XVtc_SetGeneratorHoriOffset()
+	 */
+	XVtc_WriteReg(BaseAddress, XVTC_GVBHOFF_OFFSET,
+				Regs.Reg[XVTC_GEN_REG_VBHOFF]);
+	XVtc_WriteReg(BaseAddress, XVTC_GVSHOFF_OFFSET,
+				Regs.Reg[XVTC_GEN_REG_VSHOFF]);
+	XVtc_WriteReg(BaseAddress, XVTC_GVBHOFF_F1_OFFSET,
+				Regs.Reg[XVTC_GEN_REG_VBHOFF_F1]);
+	XVtc_WriteReg(BaseAddress, XVTC_GVSHOFF_F1_OFFSET,
+				Regs.Reg[XVTC_GEN_REG_VSHOFF_F1]);
+
+	XVtc_InvalidateGenerator(InstancePtr);
 }
 
 /*****************************************************************************/
@@ -2461,6 +2303,91 @@ void XVtc_SetGeneratorVideoMode(XVtc *InstancePtr, u16 Mode)
 
 }
 
+/*****************************************************************************/
+/**
+*
+* This function computes the register image of the Generator for a video
+* timing structure. The image holds the values XVtc_SetGeneratorTiming
+* writes to the timing and horizontal offset registers, the polarity
+* register and the chroma parity and progressive bits of the encoding
+* register.
+*
+* @param	InstancePtr is a pointer to the VTC instance to be
+*		worked on.
+* @param	TimingPtr is a pointer to a Video Timing Structure to be read.
+* @param	PolarityPtr is a pointer to the polarity to use, or NULL for
+*		the polarity derived from the timing.
+* @param	RegsPtr is a pointer to the register image to be populated.
+*
+* @return	None.
+*
+* @note		The image does not touch the hardware, see
+*		XVtc_CommitGenerator.
+*
+******************************************************************************/
+void XVtc_ConvTiming2GeneratorRegs(XVtc *InstancePtr, XVtc_Timing *TimingPtr,
+		XVtc_Polarity *PolarityPtr, XVtc_GeneratorRegs *RegsPtr)
+{
+	XVtc_Polarity Polarity;
+	XVtc_Signal Signal;
+	XVtc_HoriOffsets Hoff;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(TimingPtr != NULL);
+	Xil_AssertVoid(RegsPtr != NULL);
+
+	XVtc_ConvTiming2Signal(InstancePtr, TimingPtr, &Signal, &Hoff,
+				&Polarity);
+	XVtc_ConvSignal2Regs(&Signal, RegsPtr);
+	XVtc_ConvHoriOffsets2Regs(&Hoff, RegsPtr);
+	RegsPtr->Reg[XVTC_GEN_REG_POL] = XVtc_ConvPolarity2Reg(
+				PolarityPtr ? PolarityPtr : &Polarity);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes a Generator register image to the VTC core. Only the
+* registers that differ from the shadow copy of the last commit are written,
+* all of them if the shadow is not valid.
+*
+* @param	InstancePtr is a pointer to the VTC instance to be
+*		worked on.
+* @param	RegsPtr is a pointer to the register image to be written.
+*
+* @return	The number of registers written, 0 if the Generator already
+*		used this image and no register update is needed.
+*
+* @note		The encoding and polarity registers are written as a whole.
+*		The caller handles XVtc_RegUpdateDisable/Enable around the
+*		commit.
+*
+******************************************************************************/
+u32 XVtc_CommitGenerator(XVtc *InstancePtr, XVtc_GeneratorRegs *RegsPtr)
+{
+	u32 Index;
+	u32 Count = 0;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(RegsPtr != NULL);
+
+	for (Index = 0; Index < XVTC_GEN_NUM_REGS; Index++) {
+		if (InstancePtr->GenShadowValid &&
+		    RegsPtr->Reg[Index] == InstancePtr->GenShadow.Reg[Index])
+			continue;
+		XVtc_WriteReg(InstancePtr->Config.BaseAddress,
+				XVtc_GenRegOffset[Index], RegsPtr->Reg[Index]);
+		InstancePtr->GenShadow.Reg[Index] = RegsPtr->Reg[Index];
+		Count++;
+	}
+	InstancePtr->GenShadowValid = TRUE;
+
+	return Count;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -2596,6 +2523,197 @@ u16 XVtc_GetDetectorVideoMode(XVtc *InstancePtr)
 	return mode;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function converts a polarity configuration to the polarity bits of
+* the Generator Polarity register.
+*
+* @param	PolarityPtr points to the Polarity configuration.
+*
+* @return	The polarity bits, XVTC_POL_*_MASK.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XVtc_ConvPolarity2Reg(XVtc_Polarity *PolarityPtr)
+{
+	u32 PolRegValue = 0;
+
+	if (PolarityPtr->ActiveChromaPol)
+		PolRegValue |= XVTC_POL_ACP_MASK;
+
+	if (PolarityPtr->ActiveVideoPol)
+		PolRegValue |= XVTC_POL_AVP_MASK;
+
+	if (PolarityPtr->FieldIdPol)
+		PolRegValue |= XVTC_POL_FIP_MASK;
+
+	if (PolarityPtr->VBlankPol)
+		PolRegValue |= XVTC_POL_VBP_MASK;
+
+	if (PolarityPtr->VSyncPol)
+		PolRegValue |= XVTC_POL_VSP_MASK;
+
+	if (PolarityPtr->HBlankPol)
+		PolRegValue |= XVTC_POL_HBP_MASK;
+
+	if (PolarityPtr->HSyncPol)
+		PolRegValue |= XVTC_POL_HSP_MASK;
+
+	return PolRegValue;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function converts VBlank/VSync Horizontal Offsets to the values of the
+* four Generator horizontal offset registers.
+*
+* @param	HoriOffsets points to the Horizontal Offset configuration.
+* @param	RegsPtr is a pointer to the register image to be updated.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XVtc_ConvHoriOffsets2Regs(XVtc_HoriOffsets *HoriOffsets,
+				XVtc_GeneratorRegs *RegsPtr)
+{
+	/* Generator VBlank Hori. Offset 0 */
+	RegsPtr->Reg[XVTC_GEN_REG_VBHOFF] =
+		((HoriOffsets->V0BlankHoriStart) & XVTC_XVXHOX_HSTART_MASK) |
+		((HoriOffsets->V0BlankHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
+					XVTC_XVXHOX_HEND_MASK);
+
+	/* Generator VSync Hori. Offset 0 */
+	RegsPtr->Reg[XVTC_GEN_REG_VSHOFF] =
+		((HoriOffsets->V0SyncHoriStart) & XVTC_XVXHOX_HSTART_MASK) |
+		((HoriOffsets->V0SyncHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
+					XVTC_XVXHOX_HEND_MASK);
+
+	/* Generator VBlank Hori. Offset 1 */
+	RegsPtr->Reg[XVTC_GEN_REG_VBHOFF_F1] =
+		((HoriOffsets->V1BlankHoriStart) & XVTC_XVXHOX_HSTART_MASK) |
+		((HoriOffsets->V1BlankHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
+					XVTC_XVXHOX_HEND_MASK);
+
+	/* Generator VSync Hori. Offset 1 */
+	RegsPtr->Reg[XVTC_GEN_REG_VSHOFF_F1] =
+		((HoriOffsets->V1SyncHoriStart) & XVTC_XVXHOX_HSTART_MASK) |
+		((HoriOffsets->V1SyncHoriEnd << XVTC_XVXHOX_HEND_SHIFT) &
+					XVTC_XVXHOX_HEND_MASK);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function converts a VTC signal configuration to the values of the
+* Generator size, sync and encoding registers and the default horizontal
+* offsets.
+*
+* @param	SignalCfgPtr is a pointer to the VTC signal configuration.
+* @param	RegsPtr is a pointer to the register image to be populated,
+*		the polarity register is left untouched.
+*
+* @return	None.
+*
+* @note		Only the chroma parity and progressive bits of the encoding
+*		register are set.
+*
+******************************************************************************/
+static void XVtc_ConvSignal2Regs(XVtc_Signal *SignalCfgPtr,
+				XVtc_GeneratorRegs *RegsPtr)
+{
+	u32 r_htotal, r_vtotal, r_v1total, r_hactive, r_vactive;
+	u32 HOff, VOff;
+	XVtc_Signal *SCPtr;
+	XVtc_HoriOffsets horiOffsets;
+
+	SCPtr = SignalCfgPtr;
+	if(SCPtr->OriginMode == 0)
+	{
+		r_htotal = SCPtr->HTotal+1;
+		r_vtotal = SCPtr->V0Total+1;
+		r_v1total = SCPtr->V1Total+1;
+
+		r_hactive = r_htotal - SCPtr->HActiveStart;
+		r_vactive = r_vtotal - SCPtr->V0ActiveStart;
+
+		/* Sync positions are relative to the end of active video */
+		HOff = r_hactive;
+		VOff = r_vactive - 1;
+	}
+	else
+	{
+		/* Total in mode=1 is the line width */
+		r_htotal = SCPtr->HTotal;
+		/* Total in mode=1 is the frame height */
+		r_vtotal = SCPtr->V0Total;
+		r_v1total = SCPtr->V1Total;
+		r_hactive = SCPtr->HFrontPorchStart;
+		r_vactive = SCPtr->V0FrontPorchStart;
+
+		HOff = 0;
+		VOff = 0;
+	}
+
+	RegsPtr->Reg[XVTC_GEN_REG_HSIZE] = (r_htotal) & XVTC_SB_START_MASK;
+
+	RegsPtr->Reg[XVTC_GEN_REG_VSIZE] = ((r_vtotal) & XVTC_VSIZE_F0_MASK) |
+		(((r_v1total) << XVTC_VSIZE_F1_SHIFT) & XVTC_VSIZE_F1_MASK);
+
+	RegsPtr->Reg[XVTC_GEN_REG_ASIZE] = ((r_hactive) & XVTC_ASIZE_HORI_MASK) |
+		(((r_vactive) << XVTC_ASIZE_VERT_SHIFT) & XVTC_ASIZE_VERT_MASK);
+
+	/* For some resolutions, the FIELD1 vactive size is different
+	 * from FIELD0, e.g. XVIDC_VM_720x486_60_I (SDI NTSC),
+	 * As there is no vactive FIELD1 entry in the video common
+	 * library, program it separately. For resolutions where
+	 * vactive values are different, it should be taken care in
+	 * corrosponding driver. Otherwise program same values in
+	 * FIELD0 and FIELD1 registers */
+	RegsPtr->Reg[XVTC_GEN_REG_ASIZE_F1] =
+		((r_vactive) << XVTC_ASIZE_VERT_SHIFT) & XVTC_ASIZE_VERT_MASK;
+
+	/* Generator Horizontal 1 Register */
+	RegsPtr->Reg[XVTC_GEN_REG_HSYNC] =
+		((SCPtr->HSyncStart + HOff) & XVTC_SB_START_MASK) |
+		(((SCPtr->HBackPorchStart + HOff) << XVTC_SB_END_SHIFT) &
+					XVTC_SB_END_MASK);
+
+	/* Generator Vertical Sync Register (field 0) */
+	RegsPtr->Reg[XVTC_GEN_REG_VSYNC] =
+		((SCPtr->V0SyncStart + VOff) & XVTC_SB_START_MASK) |
+		(((SCPtr->V0BackPorchStart + VOff) << XVTC_SB_END_SHIFT) &
+					XVTC_SB_END_MASK);
+
+	/* Generator Vertical Sync Register (field 1) */
+	RegsPtr->Reg[XVTC_GEN_REG_VSYNC_F1] =
+		((SCPtr->V1SyncStart + VOff) & XVTC_SB_START_MASK) |
+		(((SCPtr->V1BackPorchStart + VOff) << XVTC_SB_END_SHIFT) &
+					XVTC_SB_END_MASK);
+
+	/* Chroma Start and progressive/interlaced */
+	RegsPtr->Reg[XVTC_GEN_REG_FENC] =
+		(((SCPtr->V0ChromaStart - SCPtr->V0ActiveStart) <<
+			XVTC_ENC_CPARITY_SHIFT) & XVTC_ENC_CPARITY_MASK) |
+		((SCPtr->Interlaced << XVTC_ENC_PROG_SHIFT) &
+			XVTC_ENC_PROG_MASK);
+
+	/* Default Horizontal Offsets */
+	horiOffsets.V0BlankHoriStart = r_hactive;
+	horiOffsets.V0BlankHoriEnd = r_hactive;
+	horiOffsets.V0SyncHoriStart = SCPtr->HSyncStart + HOff;
+	horiOffsets.V0SyncHoriEnd = SCPtr->HSyncStart + HOff;
+	horiOffsets.V1BlankHoriStart = r_hactive;
+	horiOffsets.V1BlankHoriEnd = r_hactive;
+	horiOffsets.V1SyncHoriStart = SCPtr->HSyncStart + HOff;
+	horiOffsets.V1SyncHoriEnd = SCPtr->HSyncStart + HOff;
+	XVtc_ConvHoriOffsets2Regs(&horiOffsets, RegsPtr);
+}
+
 /*****************************************************************************/
 /**
 *
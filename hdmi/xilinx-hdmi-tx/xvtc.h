@@ -282,6 +282,10 @@
 *                       Changed the prototype of XVtc_CfgInitialize API.
 *       ms     03/17/17 Added readme.txt file in examples folder for doxygen
 *                       generation.
+* 8.1   XLNX   10/18/26 Added XVtc_GeneratorRegs, a register image of the
+*                       Generator, XVtc_ConvTiming2GeneratorRegs and
+*                       XVtc_CommitGenerator which only writes the
+*                       registers that differ from a shadow copy.
 * </pre>
 *
 ******************************************************************************/
@@ -345,6 +349,25 @@ extern "C" {
 #define XVTC_VMODE_PAL		102	/**< Video mode PAL */
 /*@}*/
 
+/** @name Generator register image indices
+ *  @{
+ */
+#define XVTC_GEN_REG_HSIZE	0	/**< XVTC_GHSIZE_OFFSET */
+#define XVTC_GEN_REG_VSIZE	1	/**< XVTC_GVSIZE_OFFSET */
+#define XVTC_GEN_REG_ASIZE	2	/**< XVTC_GASIZE_OFFSET */
+#define XVTC_GEN_REG_ASIZE_F1	3	/**< XVTC_GASIZE_F1_OFFSET */
+#define XVTC_GEN_REG_HSYNC	4	/**< XVTC_GHSYNC_OFFSET */
+#define XVTC_GEN_REG_VSYNC	5	/**< XVTC_GVSYNC_OFFSET */
+#define XVTC_GEN_REG_VSYNC_F1	6	/**< XVTC_GVSYNC_F1_OFFSET */
+#define XVTC_GEN_REG_FENC	7	/**< XVTC_GFENC_OFFSET */
+#define XVTC_GEN_REG_POL	8	/**< XVTC_GPOL_OFFSET */
+#define XVTC_GEN_REG_VBHOFF	9	/**< XVTC_GVBHOFF_OFFSET */
+#define XVTC_GEN_REG_VSHOFF	10	/**< XVTC_GVSHOFF_OFFSET */
+#define XVTC_GEN_REG_VBHOFF_F1	11	/**< XVTC_GVBHOFF_F1_OFFSET */
+#define XVTC_GEN_REG_VSHOFF_F1	12	/**< XVTC_GVSHOFF_F1_OFFSET */
+#define XVTC_GEN_NUM_REGS	13	/**< Number of Generator registers */
+/*@}*/
+
 /**************************** Type Definitions *******************************/
 
 /**
@@ -499,6 +522,15 @@ typedef struct {
 	u8 Interlaced;		/**< Interlaced / Progressive video */
 } XVtc_Timing;
 
+/**
+* This typedef contains the register image of the Generator, the values of
+* the timing, encoding, polarity and horizontal offset registers indexed by
+* XVTC_GEN_REG_*.
+*/
+typedef struct {
+	u32 Reg[XVTC_GEN_NUM_REGS];	/**< Register values */
+} XVtc_GeneratorRegs;
+
 /**
 *
 * Callback type for all interrupts except error interrupt.
@@ -567,6 +599,10 @@ typedef struct {
 	XVtc_ErrorCallBack ErrCallBack;	/**< Callback for Error interrupt */
 	void *ErrRef;			/**< To be passed to the Error
 					  *  interrupt callback */
+
+	XVtc_GeneratorRegs GenShadow;	/**< Generator registers as last
+					  *  written by XVtc_CommitGenerator */
+	u8 GenShadowValid;		/**< GenShadow matches the core */
 } XVtc;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -589,6 +625,25 @@ typedef struct {
 	XVtc_WriteReg((InstancePtr)->Config.BaseAddress, (XVTC_CTL_OFFSET), \
 			(XVTC_CTL_RESET_MASK))
 
+/*****************************************************************************/
+/**
+*
+* This function macro invalidates the shadow copy of the Generator registers,
+* so that the next XVtc_CommitGenerator writes all of them. It must be used
+* when the core was reset outside of this driver.
+*
+* @param	InstancePtr is a pointer to the VTC instance to be
+*		worked on.
+*
+* @return	None.
+*
+* @note		C-style signature:
+*		void XVtc_InvalidateGenerator(XVtc *InstancePtr)
+*
+******************************************************************************/
+#define XVtc_InvalidateGenerator(InstancePtr) \
+	((InstancePtr)->GenShadowValid = FALSE)
+
 /*****************************************************************************/
 /**
 *
@@ -875,6 +930,9 @@ void XVtc_ConvSignal2Timing(XVtc *InstancePtr, XVtc_Signal *SignalCfgPtr,
 		XVtc_HoriOffsets *HOffPtr, XVtc_Polarity *PolarityPtr,
 		XVtc_Timing *TimingPtr);
 u16 XVtc_ConvTiming2VideoMode(XVtc *InstancePtr, XVtc_Timing *TimingPtr);
+void XVtc_ConvTiming2GeneratorRegs(XVtc *InstancePtr, XVtc_Timing *TimingPtr,
+		XVtc_Polarity *PolarityPtr, XVtc_GeneratorRegs *RegsPtr);
+u32 XVtc_CommitGenerator(XVtc *InstancePtr, XVtc_GeneratorRegs *RegsPtr);
 
 /* Timing/Video Mode Setting/Fetching */
 void XVtc_SetGeneratorTiming(XVtc *InstancePtr, XVtc_Timing * TimingPtr);
@@ -34,6 +34,7 @@
 #include <media/v4l2-dv-timings.h>
 
 #include "linux/phy/phy-vphy.h"
+#include "uapi/linux/xilinx-hdmirx.h"
 
 /* baseline driver includes */
 #include "xilinx-hdmi-rx/xv_hdmirxss.h"
@@ -41,7 +42,10 @@
 /* for the HMAC, using password to decrypt HDCP keys */
 #include "phy-xilinx-vphy/xhdcp22_common.h"
 #include "phy-xilinx-vphy/aes256.h"
+/* hrtimer backend replacing the HDCP timer IPs */
+#include "phy-xilinx-vphy/xtmrctr_hrtimer.h"
 #include "xlnx_hdmirx_audio.h"
+#include "xlnx_hdmi_stats.h"
 
 #define hdmi_mutex_lock(x) mutex_lock(x)
 #define hdmi_mutex_unlock(x) mutex_unlock(x)
@@ -51,6 +55,23 @@
 #define EDID_BLOCKS_MAX 10
 #define EDID_BLOCK_SIZE 128
 
+/* EDID pass-through: CEA-861 extension and data block tags */
+#define EDID_CEA_EXT_TAG	0x02
+#define EDID_CEA_DB_AUDIO	1
+#define EDID_CEA_DB_VENDOR	3
+#define EDID_CEA_DB_SPEAKER	4
+#define EDID_CEA_DB_EXTENDED	7
+#define EDID_CEA_EXT_DB_Y420VDB	14
+#define EDID_CEA_EXT_DB_Y420CMDB 15
+#define EDID_HDMI_VSDB_OUI	0x000c03
+#define EDID_HDMI_FORUM_VSDB_OUI 0xc45dd8
+
+/* EDID pass-through: colour formats advertised upstream, besides RGB */
+#define EDID_FORMAT_YUV444	BIT(0)
+#define EDID_FORMAT_YUV422	BIT(1)
+#define EDID_FORMAT_YUV420	BIT(2)
+#define EDID_FORMAT_ALL		(EDID_FORMAT_YUV444 | EDID_FORMAT_YUV422 | EDID_FORMAT_YUV420)
+
 /* RX Subsystem Sub-core offsets */
 #define RXSS_RX_OFFSET				0x00000u
 #define RXSS_HDCP14_OFFSET			0x10000u
@@ -62,6 +83,93 @@
 #define RX_HDCP22_TIMER_OFFSET		0x20000u
 #define RX_HDCP22_RNG_OFFSET		0x30000u
 
+/* link-quality monitor: sample period and history depth */
+#define XHDMI_LINK_MON_PERIOD_MS	1000
+#define XHDMI_LINK_MON_SAMPLES		64
+/* default character errors per second on any channel that degrade the link,
+ * the "average" boundary of XV_HdmiRxSs_ReportLinkQuality() */
+#define XHDMI_LINK_MON_THRESHOLD	1024
+
+/* audio monitor: ACR sample period, averaging window in ACR packets and the
+ * number of consecutive samples a new sample rate must be seen before it is
+ * reported */
+#define XHDMI_AUDIO_MON_PERIOD_MS	10
+#define XHDMI_AUDIO_ACR_SAMPLES		8
+#define XHDMI_AUDIO_RATE_STABLE		3
+
+/* one link-quality monitor sample */
+struct xhdmi_link_sample {
+	s64 time_ms;
+	/* character errors per channel since the previous sample */
+	u32 errors[XHDMI_LINK_CHANNELS];
+	/* an error counter saturated, the counts are a lower bound */
+	bool saturated;
+};
+
+/* performance counters of the RX port, exported through hdmi_stats */
+struct xhdmi_stats {
+	/* interrupts per sub-core, in IntrStatus[] order */
+	atomic64_t irq_pio;
+	atomic64_t irq_tmr;
+	atomic64_t irq_vtd;
+	atomic64_t irq_ddc;
+	atomic64_t irq_aux;
+	atomic64_t irq_aud;
+	atomic64_t irq_lnksta;
+	atomic64_t irq_hdcp1x;
+	atomic64_t irq_hdcp1x_timer;
+	atomic64_t irq_hdcp22_timer;
+	/* HDCP software timer expirations */
+	atomic64_t soft_timer_hdcp1x;
+	atomic64_t soft_timer_hdcp22;
+	/* link and stream events */
+	atomic64_t connect;
+	atomic64_t disconnect;
+	atomic64_t stream_init;
+	atomic64_t stream_up;
+	atomic64_t stream_down;
+	atomic64_t brdg_overflow;
+	atomic64_t audio_rate_change;
+	/* link error counters reached their maximum */
+	atomic64_t link_err_max;
+	/* character errors per channel, accumulated by the link monitor */
+	atomic64_t link_err[XHDMI_LINK_CHANNELS];
+	atomic64_t hdcp_auth_success;
+	atomic64_t hdcp_unauthenticated;
+	/* resumes from system sleep, and stream inits after resume that
+	 * reused the RX MMCM parameters of the link up at suspend */
+	atomic64_t resume;
+	atomic64_t resume_restore;
+	/* stream init to stream up, i.e. the time to lock onto a new source */
+	struct xlnx_hdmi_hist streamup_us;
+	/* stream up to HDCP authenticated, driven by the upstream source */
+	struct xlnx_hdmi_hist hdcp_auth_us;
+};
+
+/* link up at system suspend, a source that comes back with the same link
+ * after resume skips the RX MMCM calculation and the format change event */
+struct xhdmi_pm_state {
+	/* the stream was up at suspend, cleared by the next stream init */
+	bool valid;
+	/* the next stream up is the same link as before suspend */
+	bool same_link;
+	/* the HDCP poll work was running at suspend */
+	bool hdcp_poll;
+	/* the link the RX MMCM parameters were calculated for */
+	u32 ref_clk_hz;
+	u8 tmds_clock_ratio;
+	XVidC_PixelsPerClock ppc;
+	XVidC_ColorDepth bpc;
+	XVidC_ColorFormat cfmt;
+	union {
+		XVphy_Mmcm vphy;
+		XHdmiphy1_Mmcm gtphy;
+	} rx_mmcm;
+	/* format and timings reported to user space before suspend */
+	struct v4l2_mbus_framefmt format;
+	struct v4l2_dv_timings timings;
+};
+
 struct xhdmi_device {
 	struct device *dev;
 	void __iomem *iomem;
@@ -78,12 +186,21 @@ struct xhdmi_device {
 	int hdcp1x_timer_irq;
 	int hdcp22_irq;
 	int hdcp22_timer_irq;
+	/* HDCP timers emulated on hrtimers, instead of the timer IPs */
+	XTmrCtr_HrTimer hdcp1x_soft_timer;
+	XTmrCtr_HrTimer hdcp22_soft_timer;
+	bool hdcp1x_timer_soft;
+	bool hdcp22_timer_soft;
 	/* status */
 	bool hdcp_authenticated;
 	bool hdcp_encrypted;
 	bool hdcp_password_accepted;
 	/* delayed work to drive HDCP poll */
 	struct delayed_work delayed_work_hdcp_poll;
+	/* the hdcp2.2 instance is lent to the PHY loopback benchmark, with
+	 * the HDCP DDC slave disabled if it was enabled before */
+	bool hdcp22_loopback;
+	bool hdcp22_loopback_ddc;
 
 	bool teardown;
 	struct phy *phy[HDMI_MAX_LANES];
@@ -117,6 +234,18 @@ struct xhdmi_device {
 	/* number of EDID blocks supported by IP */
 	int edid_blocks_max;
 
+	/* load the EDID read by a TX sharing the PHY into the EDID RAM */
+	bool edid_passthrough;
+	struct work_struct edid_passthrough_work;
+	/* a pass-through EDID is loaded, edid_local is restored on withdraw */
+	bool edid_passthrough_active;
+	u8 edid_local[EDID_BLOCKS_MAX * EDID_BLOCK_SIZE];
+	int edid_local_blocks;
+	/* capabilities advertised upstream in the pass-through EDID */
+	u32 edid_max_tmds_mhz;
+	u32 edid_color_formats;
+	bool edid_audio;
+
 	/* configuration for the baseline subsystem driver instance */
 	XV_HdmiRxSs_Config config;
 	/* bookkeeping for the baseline subsystem driver instance */
@@ -141,6 +270,37 @@ struct xhdmi_device {
 	bool audio_init;
 	/* audio data to be shared with audio module */
 	struct xlnx_hdmirx_audio_data *rx_audio_data;
+
+	struct xhdmi_stats stats;
+	/* time of the last stream init and stream up, 0 once accounted */
+	ktime_t stream_init_time;
+	ktime_t stream_up_time;
+
+	/* link-quality monitor, runs while the stream is up */
+	struct delayed_work link_mon_work;
+	struct xhdmi_link_sample link_mon_ring[XHDMI_LINK_MON_SAMPLES];
+	unsigned int link_mon_head;
+	unsigned int link_mon_count;
+	/* error counter values and time at the previous sample */
+	u32 link_mon_last[XHDMI_LINK_CHANNELS];
+	ktime_t link_mon_time;
+	/* errors per second on any channel that degrade the link, 0 = off */
+	u32 link_mon_threshold;
+	bool link_mon_degraded;
+
+	/* audio monitor, tracks the sample rate from the ACR packets */
+	struct delayed_work audio_mon_work;
+	/* N of the window, CTS of the last ACR packets */
+	u32 acr_n;
+	u32 acr_cts[XHDMI_AUDIO_ACR_SAMPLES];
+	unsigned int acr_head;
+	unsigned int acr_count;
+	/* sample rate seen for audio_rate_stable samples, not yet reported */
+	u32 audio_rate_candidate;
+	unsigned int audio_rate_stable;
+
+	/* snapshot taken at system suspend */
+	struct xhdmi_pm_state pm;
 };
 
 // Xilinx EDID
@@ -189,6 +349,8 @@ static int xhdmi_subscribe_event(struct v4l2_subdev *sd, struct v4l2_fh *fh, str
 			dev_dbg(xhdmi->dev, "xhdmi_subscribe_event(V4L2_EVENT_SOURCE_CHANGE) = %d\n", rc);
 			return rc;
 		}
+		case XHDMI_EVENT_LINK_QUALITY:
+			return v4l2_event_subscribe(fh, sub, 2, NULL);
 #if 0
 		case V4L2_EVENT_CTRL:
 			return v4l2_ctrl_subdev_subscribe_event(sd, fh, sub);
@@ -344,9 +506,28 @@ static void xhdmi_delayed_work_enable_hotplug(struct work_struct *work)
 	XV_HdmiRx_SetHpd(HdmiRxSsPtr->HdmiRxPtr, 1);
 }
 
+/* load edid_user into the EDID RAM and re-assert hotplug, xhdmi_mutex must be held */
+static void xhdmi_load_edid(struct xhdmi_device *xhdmi, int blocks)
+{
+	XV_HdmiRxSs *HdmiRxSsPtr = &xhdmi->xv_hdmirxss;
+
+	xhdmi->edid_user_blocks = blocks;
+
+	/* Disable hotplug and I2C access to EDID RAM from DDC port */
+	cancel_delayed_work_sync(&xhdmi->delayed_work_enable_hotplug);
+	xhdmi_set_hpd(xhdmi, 0);
+
+	if (blocks) {
+		XV_HdmiRxSs_LoadEdid(HdmiRxSsPtr, (u8 *)&xhdmi->edid_user,
+				     128 * (u16)xhdmi->edid_user_blocks);
+		/* enable hotplug after 100 ms */
+		queue_delayed_work(xhdmi->work_queue,
+				&xhdmi->delayed_work_enable_hotplug, HZ / 10);
+	}
+}
+
 static int xhdmi_set_edid(struct v4l2_subdev *subdev, struct v4l2_edid *edid) {
 	struct xhdmi_device *xhdmi = to_xhdmi(subdev);
-	XV_HdmiRxSs *HdmiRxSsPtr = &xhdmi->xv_hdmirxss;
 	if (edid->pad > 0)
 		return -EINVAL;
 	if (edid->start_block != 0)
@@ -357,22 +538,237 @@ static int xhdmi_set_edid(struct v4l2_subdev *subdev, struct v4l2_edid *edid) {
 		return -E2BIG;
 	}
 	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
-	xhdmi->edid_user_blocks = edid->blocks;
+	if (edid->blocks)
+		memcpy(xhdmi->edid_user, edid->edid, 128 * edid->blocks);
+	/* a user EDID replaces the pass-through one until the next update */
+	xhdmi->edid_passthrough_active = false;
+	xhdmi_load_edid(xhdmi, edid->blocks);
+	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
+	return 0;
+}
 
-	/* Disable hotplug and I2C access to EDID RAM from DDC port */
+static void xhdmi_edid_fix_checksum(u8 *block)
+{
+	u8 sum = 0;
+	int i;
+
+	for (i = 0; i < EDID_BLOCK_SIZE - 1; i++)
+		sum += block[i];
+	block[EDID_BLOCK_SIZE - 1] = (u8)(0x100 - sum);
+}
+
+/* intersect the deep colour flags with the RX bits per component */
+static u8 xhdmi_edid_deep_color(struct xhdmi_device *xhdmi, u8 flags,
+				u8 dc30, u8 dc36, u8 dc48)
+{
+	int bpc = xhdmi->config.MaxBitsPerPixel;
+
+	if (bpc < 10)
+		flags &= ~dc30;
+	if (bpc < 12)
+		flags &= ~dc36;
+	if (bpc < 16)
+		flags &= ~dc48;
+	return flags;
+}
+
+/* limit a CEA data block to the RX capabilities, returns true to drop it.
+ * len is the payload length, db[0] the data block header. */
+static bool xhdmi_edid_filter_db(struct xhdmi_device *xhdmi, u8 *db, int len)
+{
+	u32 max_tmds = xhdmi->edid_max_tmds_mhz;
+	u32 formats = xhdmi->edid_color_formats;
+	u32 oui;
+
+	switch (db[0] >> 5) {
+	case EDID_CEA_DB_AUDIO:
+	case EDID_CEA_DB_SPEAKER:
+		return !xhdmi->edid_audio;
+	case EDID_CEA_DB_EXTENDED:
+		if (len >= 1 && (db[1] == EDID_CEA_EXT_DB_Y420VDB ||
+				 db[1] == EDID_CEA_EXT_DB_Y420CMDB))
+			return !(formats & EDID_FORMAT_YUV420);
+		return false;
+	case EDID_CEA_DB_VENDOR:
+		if (len < 3)
+			return false;
+		oui = db[1] | (db[2] << 8) | (db[3] << 16);
+		if (oui == EDID_HDMI_VSDB_OUI) {
+			if (len >= 6) {
+				db[6] = xhdmi_edid_deep_color(xhdmi, db[6],
+						BIT(4), BIT(5), BIT(6));
+				if (!(formats & EDID_FORMAT_YUV444))
+					db[6] &= ~BIT(3);
+			}
+			/* Max_TMDS_Clock in 5 MHz units */
+			if (len >= 7 && max_tmds && db[7] > min(max_tmds, 340u) / 5)
+				db[7] = min(max_tmds, 340u) / 5;
+		} else if (oui == EDID_HDMI_FORUM_VSDB_OUI) {
+			/* Max_TMDS_Character_Rate in 5 MHz units, 0 is 340 MHz or less */
+			if (len >= 5 && max_tmds) {
+				if (max_tmds <= 340)
+					db[5] = 0;
+				else if (db[5] > max_tmds / 5)
+					db[5] = max_tmds / 5;
+			}
+			if (len >= 7) {
+				db[7] = xhdmi_edid_deep_color(xhdmi, db[7],
+						BIT(0), BIT(1), BIT(2));
+				if (!(formats & EDID_FORMAT_YUV420))
+					db[7] &= ~(BIT(0) | BIT(1) | BIT(2));
+			}
+		}
+		return false;
+	default:
+		return false;
+	}
+}
+
+static void xhdmi_edid_filter_cea(struct xhdmi_device *xhdmi, u8 *blk)
+{
+	u32 formats = xhdmi->edid_color_formats;
+	int dtd = blk[2];
+	int i = 4;
+	int len;
+
+	if (blk[0] != EDID_CEA_EXT_TAG || blk[1] < 3 || dtd < 4 ||
+	    dtd > EDID_BLOCK_SIZE - 1)
+		return;
+
+	if (!xhdmi->edid_audio)
+		blk[3] &= ~BIT(6);
+	if (!(formats & EDID_FORMAT_YUV444))
+		blk[3] &= ~BIT(5);
+	if (!(formats & EDID_FORMAT_YUV422))
+		blk[3] &= ~BIT(4);
+
+	while (i < dtd) {
+		len = blk[i] & 0x1f;
+		if (i + 1 + len > dtd)
+			break;
+		if (!xhdmi_edid_filter_db(xhdmi, &blk[i], len)) {
+			i += 1 + len;
+			continue;
+		}
+		/* drop the data block, move the rest of the block down */
+		memmove(&blk[i], &blk[i + 1 + len],
+			EDID_BLOCK_SIZE - 1 - (i + 1 + len));
+		memset(&blk[EDID_BLOCK_SIZE - 2 - len], 0, len + 1);
+		dtd -= 1 + len;
+	}
+	blk[2] = dtd;
+}
+
+static void xhdmi_edid_filter_base(struct xhdmi_device *xhdmi, u8 *blk, int blocks)
+{
+	u32 formats = xhdmi->edid_color_formats;
+	u8 *d;
+	int i;
+
+	blk[126] = blocks - 1;
+
+	/* EDID 1.4 digital input: supported colour encodings */
+	if (blk[18] == 1 && blk[19] >= 4 && (blk[20] & BIT(7))) {
+		if (!(formats & EDID_FORMAT_YUV444))
+			blk[24] &= ~BIT(3);
+		if (!(formats & EDID_FORMAT_YUV422))
+			blk[24] &= ~BIT(4);
+	}
+
+	/* display range limits, max. pixel clock in 10 MHz units */
+	for (i = 0; i < 4 && xhdmi->edid_max_tmds_mhz; i++) {
+		d = &blk[54 + 18 * i];
+		if (d[0] || d[1] || d[2] || d[3] != 0xfd)
+			continue;
+		if (d[9] > DIV_ROUND_UP(xhdmi->edid_max_tmds_mhz, 10))
+			d[9] = DIV_ROUND_UP(xhdmi->edid_max_tmds_mhz, 10);
+	}
+}
+
+/*
+ * go back to the EDID used before pass-through, the user or firmware EDID or
+ * the built-in one, and pulse hotplug so the source reads it again;
+ * xhdmi_mutex must be held
+ */
+static void xhdmi_edid_passthrough_restore(struct xhdmi_device *xhdmi)
+{
+	XV_HdmiRxSs *HdmiRxSsPtr = &xhdmi->xv_hdmirxss;
+
+	xhdmi->edid_passthrough_active = false;
+	if (xhdmi->edid_local_blocks) {
+		memcpy(xhdmi->edid_user, xhdmi->edid_local,
+		       xhdmi->edid_local_blocks * EDID_BLOCK_SIZE);
+		xhdmi_load_edid(xhdmi, xhdmi->edid_local_blocks);
+		return;
+	}
+
+	xhdmi->edid_user_blocks = 0;
 	cancel_delayed_work_sync(&xhdmi->delayed_work_enable_hotplug);
 	xhdmi_set_hpd(xhdmi, 0);
+	XV_HdmiRxSs_LoadDefaultEdid(HdmiRxSsPtr);
+	/* enable hotplug after 100 ms */
+	queue_delayed_work(xhdmi->work_queue,
+			   &xhdmi->delayed_work_enable_hotplug, HZ / 10);
+}
 
-	if (edid->blocks) {
-		memcpy(xhdmi->edid_user, edid->edid, 128 * edid->blocks);
-		XV_HdmiRxSs_LoadEdid(HdmiRxSsPtr, (u8 *)&xhdmi->edid_user,
-				     128 * (u16)xhdmi->edid_user_blocks);
-		/* enable hotplug after 100 ms */
-		queue_delayed_work(xhdmi->work_queue,
-				&xhdmi->delayed_work_enable_hotplug, HZ / 10);
-	}
+/* load the downstream EDID, limited to the RX capabilities */
+static void xhdmi_edid_passthrough_work(struct work_struct *work)
+{
+	struct xhdmi_device *xhdmi = container_of(work, struct xhdmi_device,
+						edid_passthrough_work);
+	u8 *edid;
+	int blocks, i;
+
+	edid = kmalloc(XVPHY_EDID_MAX_SIZE, GFP_KERNEL);
+	if (!edid)
+		return;
+
+	blocks = xvphy_edid_get(xhdmi->phy[0], edid, XVPHY_EDID_MAX_SIZE) /
+		 EDID_BLOCK_SIZE;
+	if (blocks)
+		blocks = min3(blocks, (int)edid[126] + 1, xhdmi->edid_blocks_max);
+
+	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
+	if (xhdmi->teardown)
+		goto unlock;
+
+	/* the downstream EDID was withdrawn or pass-through turned off */
+	if (!blocks || !xhdmi->edid_passthrough) {
+		if (xhdmi->edid_passthrough_active) {
+			xhdmi_edid_passthrough_restore(xhdmi);
+			dev_dbg(xhdmi->dev, "pass-through EDID withdrawn\n");
+		}
+		goto unlock;
+	}
+
+	xhdmi_edid_filter_base(xhdmi, edid, blocks);
+	for (i = 1; i < blocks; i++)
+		xhdmi_edid_filter_cea(xhdmi, &edid[i * EDID_BLOCK_SIZE]);
+	for (i = 0; i < blocks; i++)
+		xhdmi_edid_fix_checksum(&edid[i * EDID_BLOCK_SIZE]);
+
+	/* remember the EDID to restore when pass-through ends */
+	if (!xhdmi->edid_passthrough_active) {
+		memcpy(xhdmi->edid_local, xhdmi->edid_user,
+		       xhdmi->edid_user_blocks * EDID_BLOCK_SIZE);
+		xhdmi->edid_local_blocks = xhdmi->edid_user_blocks;
+		xhdmi->edid_passthrough_active = true;
+	}
+	memcpy(xhdmi->edid_user, edid, blocks * EDID_BLOCK_SIZE);
+	xhdmi_load_edid(xhdmi, blocks);
+	dev_dbg(xhdmi->dev, "pass-through EDID loaded, %d blocks\n", blocks);
+unlock:
 	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
-	return 0;
+	kfree(edid);
+}
+
+/* called by the PHY when a TX sharing it read a new EDID */
+static void xhdmi_edid_notify(void *ctx)
+{
+	struct xhdmi_device *xhdmi = ctx;
+
+	if (READ_ONCE(xhdmi->edid_passthrough))
+		queue_work(xhdmi->work_queue, &xhdmi->edid_passthrough_work);
 }
 
 /* -----------------------------------------------------------------------------
@@ -619,15 +1015,96 @@ static void XV_HdmiRxSs_IntrDisable(XV_HdmiRxSs *HdmiRxSsPtr)
 	XV_HdmiRx_LinkIntrDisable(HdmiRxSsPtr->HdmiRxPtr);
 }
 
+static void RxStreamDownCallback(void *CallbackRef);
+
+/* take the snapshot of the link that is up, xhdmi_mutex must be held */
+static void xhdmi_pm_save(struct xhdmi_device *xhdmi)
+{
+	struct xhdmi_pm_state *pm = &xhdmi->pm;
+	XVidC_VideoStream *Stream = XV_HdmiRxSs_GetVideoStream(&xhdmi->xv_hdmirxss);
+
+	xvphy_mutex_lock(xhdmi->phy[0]);
+	if (xhdmi->isvphy) {
+		pm->ref_clk_hz = xhdmi->xvphy->HdmiRxRefClkHz;
+		pm->tmds_clock_ratio = xhdmi->xvphy->HdmiRxTmdsClockRatio;
+		pm->rx_mmcm.vphy = xhdmi->xvphy->Quads[0].RxMmcm;
+	} else {
+		pm->ref_clk_hz = xhdmi->xgtphy->HdmiRxRefClkHz;
+		pm->tmds_clock_ratio = xhdmi->xgtphy->HdmiRxTmdsClockRatio;
+		pm->rx_mmcm.gtphy = xhdmi->xgtphy->Quads[0].RxMmcm;
+	}
+	xvphy_mutex_unlock(xhdmi->phy[0]);
+	pm->ppc = Stream->PixPerClk;
+	pm->bpc = Stream->ColorDepth;
+	pm->cfmt = Stream->ColorFormatId;
+	pm->format = xhdmi->detected_format;
+	pm->timings = xhdmi->detected_timings;
+	pm->valid = true;
+}
+
+/* restore the RX MMCM parameters of the snapshot if the source came back
+ * with the same link, the vphy mutex must be held */
+static bool xhdmi_pm_restore_mmcm(struct xhdmi_device *xhdmi,
+				  const XVidC_VideoStream *Stream)
+{
+	struct xhdmi_pm_state *pm = &xhdmi->pm;
+
+	if (!pm->valid)
+		return false;
+	pm->valid = false;
+	if (Stream->PixPerClk != pm->ppc || Stream->ColorDepth != pm->bpc ||
+	    Stream->ColorFormatId != pm->cfmt)
+		return false;
+	if (xhdmi->isvphy) {
+		if (xhdmi->xvphy->HdmiRxRefClkHz != pm->ref_clk_hz ||
+		    xhdmi->xvphy->HdmiRxTmdsClockRatio != pm->tmds_clock_ratio)
+			return false;
+		xhdmi->xvphy->Quads[0].RxMmcm = pm->rx_mmcm.vphy;
+	} else {
+		if (xhdmi->xgtphy->HdmiRxRefClkHz != pm->ref_clk_hz ||
+		    xhdmi->xgtphy->HdmiRxTmdsClockRatio != pm->tmds_clock_ratio)
+			return false;
+		xhdmi->xgtphy->Quads[0].RxMmcm = pm->rx_mmcm.gtphy;
+	}
+	pm->same_link = true;
+	atomic64_inc(&xhdmi->stats.resume_restore);
+	return true;
+}
+
 static int __maybe_unused hdmirx_pm_suspend(struct device *dev)
 {
 	unsigned long flags;
 	struct xhdmi_device *xhdmi = dev_get_drvdata(dev);
 	XV_HdmiRxSs *HdmiRxSsPtr = (XV_HdmiRxSs *)&xhdmi->xv_hdmirxss;
 	dev_dbg(xhdmi->dev,"HDMI RX suspend function called\n");
+
+	/* the works take xhdmi_mutex, stop them before taking it, the HDCP
+	 * poll work runs once the keys have been loaded */
+	xhdmi->pm.hdcp_poll = false;
+	if (xhdmi->config.Hdcp14.IsPresent || xhdmi->config.Hdcp22.IsPresent) {
+		cancel_delayed_work_sync(&xhdmi->delayed_work_hdcp_poll);
+		xhdmi->pm.hdcp_poll = xhdmi->hdcp_password_accepted;
+	}
+	cancel_delayed_work_sync(&xhdmi->link_mon_work);
+	cancel_delayed_work_sync(&xhdmi->audio_mon_work);
+
+	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
+	xhdmi->pm.valid = false;
+	xhdmi->pm.same_link = false;
+	if (xhdmi->hdmi_stream_is_up) {
+		xhdmi_pm_save(xhdmi);
+		RxStreamDownCallback(xhdmi);
+	}
+	/* deassert hotplug, the source re-trains the link after resume */
+	cancel_delayed_work_sync(&xhdmi->delayed_work_enable_hotplug);
+	xhdmi_set_hpd(xhdmi, 0);
+
 	spin_lock_irqsave(&xhdmi->irq_lock, flags);
 	XV_HdmiRxSs_IntrDisable(HdmiRxSsPtr);
 	spin_unlock_irqrestore(&xhdmi->irq_lock, flags);
+	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
+
+	clk_disable_unprepare(xhdmi->axi_lite_clk);
 	return 0;
 }
 
@@ -636,10 +1113,35 @@ static int __maybe_unused hdmirx_pm_resume(struct device *dev)
 	unsigned long flags;
 	struct xhdmi_device *xhdmi = dev_get_drvdata(dev);
 	XV_HdmiRxSs *HdmiRxSsPtr = (XV_HdmiRxSs *)&xhdmi->xv_hdmirxss;
+	int ret;
 	dev_dbg(xhdmi->dev,"HDMI RX resume function called\n");
+
+	ret = clk_prepare_enable(xhdmi->axi_lite_clk);
+	if (ret) {
+		dev_err(xhdmi->dev, "failed to enable axi-lite clk\n");
+		return ret;
+	}
+
+	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
+	atomic64_inc(&xhdmi->stats.resume);
+	/* the EDID RAM may have lost its content */
+	if (xhdmi->edid_user_blocks)
+		XV_HdmiRxSs_LoadEdid(HdmiRxSsPtr, (u8 *)&xhdmi->edid_user,
+				     128 * (u16)xhdmi->edid_user_blocks);
+	else
+		XV_HdmiRxSs_LoadDefaultEdid(HdmiRxSsPtr);
+
 	spin_lock_irqsave(&xhdmi->irq_lock, flags);
 	XV_HdmiRxSs_IntrEnable(HdmiRxSsPtr);
 	spin_unlock_irqrestore(&xhdmi->irq_lock, flags);
+
+	/* enable hotplug after 100 ms */
+	queue_delayed_work(xhdmi->work_queue,
+			&xhdmi->delayed_work_enable_hotplug, HZ / 10);
+	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
+
+	if (xhdmi->pm.hdcp_poll)
+		schedule_delayed_work(&xhdmi->delayed_work_hdcp_poll, 0);
 	return 0;
 }
 
@@ -664,6 +1166,14 @@ static irqreturn_t hdmirx_irq_handler(int irq, void *dev_id)
 	xhdmi->IntrStatus[5] = XV_HdmiRx_ReadReg(HdmiRxSsPtr->HdmiRxPtr->Config.BaseAddress, (XV_HDMIRX_AUD_STA_OFFSET)) & (XV_HDMIRX_AUD_STA_IRQ_MASK);
 	xhdmi->IntrStatus[6] = XV_HdmiRx_ReadReg(HdmiRxSsPtr->HdmiRxPtr->Config.BaseAddress, (XV_HDMIRX_LNKSTA_STA_OFFSET)) & (XV_HDMIRX_LNKSTA_STA_IRQ_MASK);
 
+	atomic64_add(!!xhdmi->IntrStatus[0], &xhdmi->stats.irq_pio);
+	atomic64_add(!!xhdmi->IntrStatus[1], &xhdmi->stats.irq_tmr);
+	atomic64_add(!!xhdmi->IntrStatus[2], &xhdmi->stats.irq_vtd);
+	atomic64_add(!!xhdmi->IntrStatus[3], &xhdmi->stats.irq_ddc);
+	atomic64_add(!!xhdmi->IntrStatus[4], &xhdmi->stats.irq_aux);
+	atomic64_add(!!xhdmi->IntrStatus[5], &xhdmi->stats.irq_aud);
+	atomic64_add(!!xhdmi->IntrStatus[6], &xhdmi->stats.irq_lnksta);
+
 	spin_lock_irqsave(&xhdmi->irq_lock, flags);
 	/* mask interrupt request */
 	XV_HdmiRxSs_IntrDisable(HdmiRxSsPtr);
@@ -720,11 +1230,14 @@ static irqreturn_t hdmirx_hdcp_irq_handler(int irq, void *dev_id)
 	spin_lock_irqsave(&xhdmi->irq_lock, flags);
 	/* mask/disable interrupt requests */
 	if (irq == xhdmi->hdcp1x_irq) {
+		atomic64_inc(&xhdmi->stats.irq_hdcp1x);
 		XHdcp1x_WriteReg(HdmiRxSsPtr->Hdcp14Ptr->Config.BaseAddress,
 			XHDCP1X_CIPHER_REG_INTERRUPT_MASK, (u32)0xFFFFFFFFu);
 	} else if (irq == xhdmi->hdcp1x_timer_irq) {
+		atomic64_inc(&xhdmi->stats.irq_hdcp1x_timer);
 		XTmrCtr_DisableIntr(HdmiRxSsPtr->HdcpTimerPtr->BaseAddress, 0);
 	} else if (irq == xhdmi->hdcp22_timer_irq) {
+		atomic64_inc(&xhdmi->stats.irq_hdcp22_timer);
 		XTmrCtr_DisableIntr(HdmiRxSsPtr->Hdcp22Ptr->TimerInst.BaseAddress, 0);
 		XTmrCtr_DisableIntr(HdmiRxSsPtr->Hdcp22Ptr->TimerInst.BaseAddress, 1);
 	}
@@ -776,6 +1289,47 @@ static irqreturn_t hdmirx_hdcp_irq_thread(int irq, void *dev_id)
 	return IRQ_HANDLED;
 }
 
+/* HDCP software timer service, runs from a work item in place of the timer irq thread */
+static void hdmirx_hdcp_soft_timer_service(void *ref, XTmrCtr *TmrCtrPtr)
+{
+	struct xhdmi_device *xhdmi = (struct xhdmi_device *)ref;
+
+	/* driver is being torn down, do not process further expirations */
+	if (xhdmi->teardown)
+		return;
+
+	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
+	if (TmrCtrPtr == xhdmi->xv_hdmirxss.HdcpTimerPtr)
+		atomic64_inc(&xhdmi->stats.soft_timer_hdcp1x);
+	else
+		atomic64_inc(&xhdmi->stats.soft_timer_hdcp22);
+	XTmrCtr_InterruptHandler(TmrCtrPtr);
+	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
+}
+
+/*
+ * Runs an HDCP timer on an hrtimer if the device tree asks for it or if the
+ * timer interrupt is not connected, the timer IP and its interrupt are then
+ * not used. Returns true if the software timer is selected.
+ */
+static bool xhdmi_hdcp_soft_timer(struct xhdmi_device *xhdmi,
+				  XTmrCtr_Config *cfg,
+				  XTmrCtr_HrTimer *soft_timer, int *irq)
+{
+	if (*irq > 0 &&
+	    !of_property_read_bool(xhdmi->dev->of_node, "xlnx,hdcp-soft-timer")) {
+		/* the table outlives this driver instance */
+		cfg->SoftOps = NULL;
+		cfg->SoftRef = NULL;
+		return false;
+	}
+
+	XTmrCtr_HrTimerInitialize(soft_timer, cfg, hdmirx_hdcp_soft_timer_service,
+				  xhdmi);
+	*irq = 0;
+	return true;
+}
+
 /* callbacks from HDMI RX SS interrupt handler
  * these are called with the xhdmi->mutex locked and the xvphy_mutex non-locked
  * to prevent mutex deadlock, always lock the xhdmi first, then the xvphy mutex */
@@ -796,6 +1350,10 @@ static void RxConnectCallback(void *CallbackRef)
 		return;
 
 	xhdmi->cable_is_connected = !!HdmiRxSsPtr->IsStreamConnected;
+	if (xhdmi->cable_is_connected)
+		atomic64_inc(&xhdmi->stats.connect);
+	else
+		atomic64_inc(&xhdmi->stats.disconnect);
 	dev_dbg(xhdmi->dev,"RxConnectCallback(): cable is %sconnected.\n",
 					xhdmi->cable_is_connected? "": "dis");
 
@@ -829,7 +1387,18 @@ static void RxStreamDownCallback(void *CallbackRef)
 	(void)HdmiRxSsPtr;
 	dev_dbg(xhdmi->dev,"RxStreamDownCallback()\n");
 	xhdmi->hdmi_stream_is_up = 0;
+	atomic64_inc(&xhdmi->stats.stream_down);
+	xhdmi->stream_up_time = 0;
 	xhdmi->hdcp_authenticated = 0;
+	if (xhdmi->audio_init) {
+		xhdmi->rx_audio_data->audio_detected = false;
+		xhdmi->acr_count = 0;
+		xhdmi->audio_rate_stable = 0;
+		if (xhdmi->rx_audio_data->rate) {
+			xhdmi->rx_audio_data->rate = 0;
+			hdmirx_audio_rate_changed(xhdmi->dev);
+		}
+	}
 }
 
 static void RxStreamInitCallback(void *CallbackRef)
@@ -851,6 +1420,8 @@ static void RxStreamInitCallback(void *CallbackRef)
 		return;
 
 	dev_dbg(xhdmi->dev,"RxStreamInitCallback\r\n");
+	atomic64_inc(&xhdmi->stats.stream_init);
+	xhdmi->stream_init_time = ktime_get();
 	// Calculate RX MMCM parameters
 	// In the application the YUV422 colordepth is 12 bits
 	// However the HDMI transports YUV422 in 8 bits.
@@ -860,7 +1431,10 @@ static void RxStreamInitCallback(void *CallbackRef)
 
 	xvphy_mutex_lock(xhdmi->phy[0]);
 
-	if (HdmiRxSsVidStreamPtr->ColorFormatId == XVIDC_CSF_YCRCB_422) {
+	// Same link as before suspend, reuse its MMCM parameters
+	if (xhdmi_pm_restore_mmcm(xhdmi, HdmiRxSsVidStreamPtr)) {
+		Status = XST_SUCCESS;
+	} else if (HdmiRxSsVidStreamPtr->ColorFormatId == XVIDC_CSF_YCRCB_422) {
 		if (xhdmi->isvphy) {
 			Status = XVphy_HdmiCfgCalcMmcmParam(VphyPtr, 0, XVPHY_CHANNEL_ID_CH1,
 					XVPHY_DIR_RX,
@@ -1066,6 +1640,19 @@ static void RxStreamUpCallback(void *CallbackRef)
 
 	if (!xhdmi || !HdmiRxSsPtr || !HdmiRxSsPtr->HdmiRxPtr) return;
 	dev_dbg(xhdmi->dev,"RxStreamUpCallback() - stream is up.\n");
+	/* also called on AVI infoframe changes, only account the first */
+	if (!xhdmi->hdmi_stream_is_up) {
+		atomic64_inc(&xhdmi->stats.stream_up);
+		xlnx_hdmi_hist_add(&xhdmi->stats.streamup_us, xhdmi->stream_init_time);
+		xhdmi->stream_init_time = 0;
+		xhdmi->stream_up_time = ktime_get();
+		/* the subsystem cleared the link error counters */
+		memset(xhdmi->link_mon_last, 0, sizeof(xhdmi->link_mon_last));
+		xhdmi->link_mon_time = xhdmi->stream_up_time;
+		mod_delayed_work(xhdmi->work_queue, &xhdmi->link_mon_work,
+				 msecs_to_jiffies(XHDMI_LINK_MON_PERIOD_MS));
+		mod_delayed_work(xhdmi->work_queue, &xhdmi->audio_mon_work, 0);
+	}
 	Stream = XV_HdmiRxSs_GetVideoStream(HdmiRxSsPtr);
 #ifdef DEBUG
 	XV_HdmiRx_DebugInfo(HdmiRxSsPtr->HdmiRxPtr);
@@ -1223,8 +1810,15 @@ static void RxStreamUpCallback(void *CallbackRef)
 	(void)Stream->VmId;
 
 	xhdmi->hdmi_stream_is_up = 1;
-	/* notify source format change event */
-	v4l2_subdev_notify_event(&xhdmi->subdev, &xhdmi_ev_fmt);
+	/* notify source format change event, unless the source came back
+	 * after resume with the format user space already knows */
+	if (!xhdmi->pm.same_link ||
+	    memcmp(&xhdmi->detected_format, &xhdmi->pm.format,
+		   sizeof(xhdmi->detected_format)) ||
+	    !v4l2_match_dv_timings(&xhdmi->detected_timings, &xhdmi->pm.timings,
+				   0, false))
+		v4l2_subdev_notify_event(&xhdmi->subdev, &xhdmi_ev_fmt);
+	xhdmi->pm.same_link = false;
 
 	/* TODO: As subsystem API XV_HdmiRxSs_AudioEnable is not available,
 	 *  core API is used currently.
@@ -1238,23 +1832,227 @@ static void RxStreamUpCallback(void *CallbackRef)
 
 static void RxBrdgOverflowCallback(void *CallbackRef)
 {
+	struct xhdmi_device *xhdmi = (struct xhdmi_device *)CallbackRef;
+
 	//dev_dbg(xhdmi->dev,"RxBrdgOverflowCallback()\n");
+	atomic64_inc(&xhdmi->stats.brdg_overflow);
 }
 
-static void RxAudCallback(void *CallbackRef)
+static void RxLnkStaCallback(void *CallbackRef)
 {
 	struct xhdmi_device *xhdmi = (struct xhdmi_device *)CallbackRef;
+
+	if (xhdmi->xv_hdmirxss.IsLinkStatusErrMax)
+		atomic64_inc(&xhdmi->stats.link_err_max);
+}
+
+static void xhdmi_link_mon_notify(struct xhdmi_device *xhdmi, const u32 *rate)
+{
+	struct v4l2_event ev = { .type = XHDMI_EVENT_LINK_QUALITY };
+	struct xhdmi_link_quality_event *lq = (void *)ev.u.data;
+	int ch;
+
+	BUILD_BUG_ON(sizeof(*lq) > sizeof(ev.u.data));
+	lq->degraded = xhdmi->link_mon_degraded;
+	for (ch = 0; ch < XHDMI_LINK_CHANNELS; ch++)
+		lq->errors[ch] = rate[ch];
+	v4l2_subdev_notify_event(&xhdmi->subdev, &ev);
+	sysfs_notify(&xhdmi->dev->kobj, NULL, "link_quality");
+	dev_info(xhdmi->dev, "link quality %s, errors/s %u %u %u\n",
+		 xhdmi->link_mon_degraded ? "degraded" : "recovered",
+		 rate[0], rate[1], rate[2]);
+}
+
+/* called with xhdmi_mutex locked while the stream is up */
+static void xhdmi_link_mon_sample(struct xhdmi_device *xhdmi)
+{
+	XV_HdmiRx *HdmiRxPtr = xhdmi->xv_hdmirxss.HdmiRxPtr;
+	struct xhdmi_link_sample *sample;
+	u32 rate[XHDMI_LINK_CHANNELS];
+	ktime_t now = ktime_get();
+	s64 period_ms;
+	bool degraded = false;
+	int ch;
+
+	period_ms = max_t(s64, ktime_ms_delta(now, xhdmi->link_mon_time), 1);
+	sample = &xhdmi->link_mon_ring[xhdmi->link_mon_head];
+	sample->time_ms = ktime_to_ms(now);
+	sample->saturated = XV_HdmiRx_IsLinkStatusErrMax(HdmiRxPtr);
+	for (ch = 0; ch < XHDMI_LINK_CHANNELS; ch++) {
+		u32 count = XV_HdmiRx_GetLinkStatus(HdmiRxPtr, ch);
+
+		/* the counters are only cleared on saturation here, but also
+		 * on stream up and by hdmi_info, a drop means a restart */
+		sample->errors[ch] = count >= xhdmi->link_mon_last[ch] ?
+			count - xhdmi->link_mon_last[ch] : count;
+		xhdmi->link_mon_last[ch] = count;
+		atomic64_add(sample->errors[ch], &xhdmi->stats.link_err[ch]);
+		rate[ch] = div64_u64((u64)sample->errors[ch] * MSEC_PER_SEC,
+				     period_ms);
+		if (xhdmi->link_mon_threshold &&
+		    rate[ch] > xhdmi->link_mon_threshold)
+			degraded = true;
+	}
+	if (sample->saturated) {
+		XV_HdmiRx_ClearLinkStatus(HdmiRxPtr);
+		memset(xhdmi->link_mon_last, 0, sizeof(xhdmi->link_mon_last));
+	}
+	xhdmi->link_mon_time = now;
+	xhdmi->link_mon_head = (xhdmi->link_mon_head + 1) % XHDMI_LINK_MON_SAMPLES;
+	if (xhdmi->link_mon_count < XHDMI_LINK_MON_SAMPLES)
+		xhdmi->link_mon_count++;
+
+	if (degraded != xhdmi->link_mon_degraded) {
+		xhdmi->link_mon_degraded = degraded;
+		xhdmi_link_mon_notify(xhdmi, rate);
+	}
+}
+
+/* samples the TMDS character error counters every XHDMI_LINK_MON_PERIOD_MS
+ * while the stream is up, started by RxStreamUpCallback() */
+static void xhdmi_link_mon_work(struct work_struct *work)
+{
+	struct xhdmi_device *xhdmi = container_of(work, struct xhdmi_device,
+						  link_mon_work.work);
+
+	if (xhdmi->teardown)
+		return;
+	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
+	if (xhdmi->hdmi_stream_is_up) {
+		xhdmi_link_mon_sample(xhdmi);
+		queue_delayed_work(xhdmi->work_queue, &xhdmi->link_mon_work,
+				   msecs_to_jiffies(XHDMI_LINK_MON_PERIOD_MS));
+	} else {
+		/* a link that is down is not reported as degraded */
+		xhdmi->link_mon_degraded = false;
+	}
+	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
+}
+
+static const u32 xhdmi_audio_rates[] = {
+	32000, 44100, 48000, 88200, 96000, 176400, 192000
+};
+
+/* snap a measured sample rate to the standard rate within 2%, 0 if none */
+static u32 xhdmi_audio_snap_rate(u32 rate)
+{
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(xhdmi_audio_rates); i++)
+		if (abs((s32)(rate - xhdmi_audio_rates[i])) <=
+		    xhdmi_audio_rates[i] / 50)
+			return xhdmi_audio_rates[i];
+	return 0;
+}
+
+/* sample rate from the ACR packets averaged over the window, fs equals
+ * TMDS * N / (128 * CTS); XV_HdmiRxSs_SetStream already stores the TMDS
+ * character rate in RefClk, including the x4 of the 1/40 clock ratio */
+static u32 xhdmi_audio_acr_rate(struct xhdmi_device *xhdmi)
+{
+	XV_HdmiRxSs *HdmiRxSsPtr = &xhdmi->xv_hdmirxss;
+	XV_HdmiRx *HdmiRxPtr = HdmiRxSsPtr->HdmiRxPtr;
+	u32 n, cts, tmds, sum = 0;
+	unsigned int i;
+
+	n = XV_HdmiRx_GetAcrN(HdmiRxPtr);
+	cts = XV_HdmiRx_GetAcrCts(HdmiRxPtr);
+	if (!n || !cts) {
+		xhdmi->acr_count = 0;
+		return 0;
+	}
+	/* a new N is a new rate or source, restart the window */
+	if (n != xhdmi->acr_n || !xhdmi->acr_count) {
+		xhdmi->acr_n = n;
+		xhdmi->acr_head = 0;
+		xhdmi->acr_count = 0;
+	}
+	xhdmi->acr_cts[xhdmi->acr_head] = cts;
+	xhdmi->acr_head = (xhdmi->acr_head + 1) % XHDMI_AUDIO_ACR_SAMPLES;
+	if (xhdmi->acr_count < XHDMI_AUDIO_ACR_SAMPLES)
+		xhdmi->acr_count++;
+	for (i = 0; i < xhdmi->acr_count; i++)
+		sum += xhdmi->acr_cts[i];
+
+	tmds = HdmiRxPtr->Stream.RefClk;
+	return xhdmi_audio_snap_rate(XHdmiC_TMDS_GetAudSampRateHz(tmds,
+					n * xhdmi->acr_count, sum));
+}
+
+/* refresh the cached format, channel count and detection state */
+static void xhdmi_audio_update(struct xhdmi_device *xhdmi)
+{
 	XV_HdmiRxSs *HdmiRxSsPtr = &xhdmi->xv_hdmirxss;
 	struct xlnx_hdmirx_audio_data *adata = xhdmi->rx_audio_data;
+	XHdmiC_AudioInfoFrame *AudIf = XV_HdmiRxSs_GetAudioInfoframe(HdmiRxSsPtr);
+	bool detected;
 
-	dev_dbg(xhdmi->dev,"%s()\n", __func__);
 	adata->format = XV_HdmiRxSs_GetAudioFormat(HdmiRxSsPtr);
-	adata->num_channels = XV_HdmiRxSs_GetAudioChannels(HdmiRxSsPtr);
-	//ToDo: Insert registered ALSA driver call-back
-	if (xhdmi->audio_init && adata->num_channels >= 2) {
-		adata->audio_detected = true;
-		wake_up_interruptible(&adata->audio_update_q);
+	/* the infoframe count is authoritative, fall back to the core */
+	if (AudIf->ChannelCount)
+		adata->num_channels = AudIf->ChannelCount + 1;
+	else
+		adata->num_channels = XV_HdmiRxSs_GetAudioChannels(HdmiRxSsPtr);
+
+	detected = adata->rate && adata->num_channels >= 2;
+	if (detected != adata->audio_detected) {
+		adata->audio_detected = detected;
+		if (detected)
+			wake_up_interruptible(&adata->audio_update_q);
 	}
+}
+
+static void xhdmi_audio_mon_sample(struct xhdmi_device *xhdmi)
+{
+	struct xlnx_hdmirx_audio_data *adata = xhdmi->rx_audio_data;
+	u32 rate = xhdmi_audio_acr_rate(xhdmi);
+
+	if (rate == adata->rate) {
+		xhdmi->audio_rate_stable = 0;
+	} else if (!xhdmi->audio_rate_stable ||
+		   rate != xhdmi->audio_rate_candidate) {
+		xhdmi->audio_rate_candidate = rate;
+		xhdmi->audio_rate_stable = 1;
+	} else if (++xhdmi->audio_rate_stable >= XHDMI_AUDIO_RATE_STABLE) {
+		dev_dbg(xhdmi->dev, "audio sample rate %u -> %u Hz\n",
+			adata->rate, rate);
+		adata->rate = rate;
+		xhdmi->audio_rate_stable = 0;
+		atomic64_inc(&xhdmi->stats.audio_rate_change);
+		hdmirx_audio_rate_changed(xhdmi->dev);
+	}
+	xhdmi_audio_update(xhdmi);
+}
+
+/* tracks the audio sample rate every XHDMI_AUDIO_MON_PERIOD_MS while the
+ * stream is up, there is no interrupt on ACR updates. Started by
+ * RxStreamUpCallback() */
+static void xhdmi_audio_mon_work(struct work_struct *work)
+{
+	struct xhdmi_device *xhdmi = container_of(work, struct xhdmi_device,
+						  audio_mon_work.work);
+
+	if (xhdmi->teardown)
+		return;
+	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
+	if (xhdmi->hdmi_stream_is_up) {
+		if (xhdmi->audio_init)
+			xhdmi_audio_mon_sample(xhdmi);
+		queue_delayed_work(xhdmi->work_queue, &xhdmi->audio_mon_work,
+				   msecs_to_jiffies(XHDMI_AUDIO_MON_PERIOD_MS));
+	}
+	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
+}
+
+static void RxAudCallback(void *CallbackRef)
+{
+	struct xhdmi_device *xhdmi = (struct xhdmi_device *)CallbackRef;
+	struct xlnx_hdmirx_audio_data *adata = xhdmi->rx_audio_data;
+
+	dev_dbg(xhdmi->dev,"%s()\n", __func__);
+	if (!xhdmi->audio_init)
+		return;
+	xhdmi_audio_update(xhdmi);
 
 	dev_dbg(xhdmi->dev, "Channels = %d\n", adata->num_channels);
 	dev_dbg(xhdmi->dev, "Format   = %d\n", adata->format);
@@ -1388,6 +2186,9 @@ static void RxHdcpAuthenticatedCallback(void *CallbackRef)
 	HdmiRxSsPtr = &xhdmi->xv_hdmirxss;
 	HdcpProtocol = XV_HdmiRxSs_HdcpGetProtocol(HdmiRxSsPtr);
 	xhdmi->hdcp_authenticated = 1;
+	atomic64_inc(&xhdmi->stats.hdcp_auth_success);
+	xlnx_hdmi_hist_add(&xhdmi->stats.hdcp_auth_us, xhdmi->stream_up_time);
+	xhdmi->stream_up_time = 0;
 	switch (HdcpProtocol) {
 	case XV_HDMIRXSS_HDCP_22:
 		dev_dbg(xhdmi->dev,"HDCP 2.2 RX authenticated.\n");
@@ -1403,6 +2204,7 @@ static void RxHdcpUnauthenticatedCallback(void *CallbackRef)
 	struct xhdmi_device *xhdmi = (struct xhdmi_device *)CallbackRef;
 
 	xhdmi->hdcp_authenticated = 0;
+	atomic64_inc(&xhdmi->stats.hdcp_unauthenticated);
 	dev_dbg(xhdmi->dev,"HDCP RX unauthenticated.\n");
 }
 
@@ -1416,6 +2218,39 @@ static void RxHdcpEncryptionUpdateCallback(void *CallbackRef)
 					xhdmi->hdcp_encrypted? "enabled": "disabled");
 }
 
+/* lends the hdcp2.2 instance to the PHY loopback benchmark while no cable is
+ * connected, and gives it back re-initialized with the active protocol */
+static int xhdmi_hdcp22_claim(void *ctx, bool claim)
+{
+	struct xhdmi_device *xhdmi = ctx;
+	XV_HdmiRxSs *HdmiRxSsPtr = &xhdmi->xv_hdmirxss;
+	int ret = 0;
+
+	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
+	if (claim) {
+		if (xhdmi->cable_is_connected) {
+			ret = -EBUSY;
+		} else {
+			/* keep a source that connects meanwhile off the HDCP port */
+			xhdmi->hdcp22_loopback_ddc = !!(XV_HdmiRx_ReadReg(
+				HdmiRxSsPtr->HdmiRxPtr->Config.BaseAddress,
+				XV_HDMIRX_DDC_CTRL_OFFSET) &
+				XV_HDMIRX_DDC_CTRL_HDCP_EN_MASK);
+			XV_HdmiRx_DdcHdcpDisable(HdmiRxSsPtr->HdmiRxPtr);
+			xhdmi->hdcp22_loopback = true;
+		}
+	} else {
+		XV_HdmiRxSs_HdcpSetProtocol(HdmiRxSsPtr, HdmiRxSsPtr->HdcpProtocol);
+		if (xhdmi->hdcp22_loopback_ddc)
+			XV_HdmiRx_DdcHdcpEnable(HdmiRxSsPtr->HdmiRxPtr);
+		xhdmi->hdcp_authenticated = 0;
+		xhdmi->hdcp_encrypted = 0;
+		xhdmi->hdcp22_loopback = false;
+	}
+	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
+	return ret;
+}
+
 /* this function is responsible for periodically calling XV_HdmiRxSs_HdcpPoll() */
 static void hdcp_poll_work(struct work_struct *work)
 {
@@ -1428,7 +2263,9 @@ static void hdcp_poll_work(struct work_struct *work)
 	HdmiRxSsPtr = (XV_HdmiRxSs *)&xhdmi->xv_hdmirxss;
 
 	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
-	XV_HdmiRxSs_HdcpPoll(HdmiRxSsPtr);
+	/* the PHY loopback benchmark polls the hdcp2.2 instance meanwhile */
+	if (!xhdmi->hdcp22_loopback)
+		XV_HdmiRxSs_HdcpPoll(HdmiRxSsPtr);
 	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
 	/* reschedule this work again in 1 millisecond */
 	schedule_delayed_work(&xhdmi->delayed_work_hdcp_poll, msecs_to_jiffies(1));
@@ -1720,6 +2557,69 @@ static ssize_t hdcp_log_show(struct device *sysfs_dev, struct device_attribute *
 	return count;
 }
 
+/* key=value counters, cheap enough to be scraped at a high rate */
+static ssize_t hdmi_stats_show(struct device *sysfs_dev, struct device_attribute *attr,
+	char *buf)
+{
+	struct xhdmi_device *xhdmi = (struct xhdmi_device *)dev_get_drvdata(sysfs_dev);
+	const struct xhdmi_stats *stats = &xhdmi->stats;
+	ssize_t count = 0;
+
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_pio", &stats->irq_pio);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_tmr", &stats->irq_tmr);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_vtd", &stats->irq_vtd);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_ddc", &stats->irq_ddc);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_aux", &stats->irq_aux);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_aud", &stats->irq_aud);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_lnksta",
+					&stats->irq_lnksta);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_hdcp1x",
+					&stats->irq_hdcp1x);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_hdcp1x_timer",
+					&stats->irq_hdcp1x_timer);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_hdcp22_timer",
+					&stats->irq_hdcp22_timer);
+	count = xlnx_hdmi_stats_counter(buf, count, "soft_timer_hdcp1x",
+					&stats->soft_timer_hdcp1x);
+	count = xlnx_hdmi_stats_counter(buf, count, "soft_timer_hdcp22",
+					&stats->soft_timer_hdcp22);
+	count = xlnx_hdmi_stats_counter(buf, count, "connect", &stats->connect);
+	count = xlnx_hdmi_stats_counter(buf, count, "disconnect",
+					&stats->disconnect);
+	count = xlnx_hdmi_stats_counter(buf, count, "stream_init",
+					&stats->stream_init);
+	count = xlnx_hdmi_stats_counter(buf, count, "stream_up",
+					&stats->stream_up);
+	count = xlnx_hdmi_stats_counter(buf, count, "stream_down",
+					&stats->stream_down);
+	count = xlnx_hdmi_stats_counter(buf, count, "brdg_overflow",
+					&stats->brdg_overflow);
+	count = xlnx_hdmi_stats_counter(buf, count, "audio_rate_change",
+					&stats->audio_rate_change);
+	count = xlnx_hdmi_stats_counter(buf, count, "link_err_max",
+					&stats->link_err_max);
+	count = xlnx_hdmi_stats_counter(buf, count, "link_err_ch0",
+					&stats->link_err[0]);
+	count = xlnx_hdmi_stats_counter(buf, count, "link_err_ch1",
+					&stats->link_err[1]);
+	count = xlnx_hdmi_stats_counter(buf, count, "link_err_ch2",
+					&stats->link_err[2]);
+	count = xlnx_hdmi_stats_counter(buf, count, "hdcp_auth_success",
+					&stats->hdcp_auth_success);
+	count = xlnx_hdmi_stats_counter(buf, count, "hdcp_unauthenticated",
+					&stats->hdcp_unauthenticated);
+	count = xlnx_hdmi_stats_u64(buf, count, "hdcp_evt_overflow",
+				    xhdmi->xv_hdmirxss.HdcpEventQueue.Overflow);
+	count = xlnx_hdmi_stats_u64(buf, count, "hdcp_evt_coalesced",
+				    xhdmi->xv_hdmirxss.HdcpEventQueue.Coalesced);
+	count = xlnx_hdmi_stats_counter(buf, count, "resume", &stats->resume);
+	count = xlnx_hdmi_stats_counter(buf, count, "resume_restore",
+					&stats->resume_restore);
+	count = xlnx_hdmi_stats_hist(buf, count, "streamup", &stats->streamup_us);
+	count = xlnx_hdmi_stats_hist(buf, count, "hdcp_auth", &stats->hdcp_auth_us);
+	return count;
+}
+
 static ssize_t hdmi_info_show(struct device *sysfs_dev, struct device_attribute *attr,
 	char *buf)
 {
@@ -1943,6 +2843,11 @@ static ssize_t hdcp_key_store(struct device *sysfs_dev, struct device_attribute
 		XV_HdmiRxSs_SetCallback(HdmiRxSsPtr, XV_HDMIRXSS_HANDLER_HDCP_ENCRYPTION_UPDATE,
 			RxHdcpEncryptionUpdateCallback, (void *)xhdmi);
 
+		/* offer HDCP 2.2 to the PHY loopback benchmark */
+		if (HdmiRxSsPtr->Config.Hdcp22.IsPresent && HdmiRxSsPtr->Hdcp22Ptr)
+			xvphy_hdcp22_register(xhdmi->phy[0], HdmiRxSsPtr->Hdcp22Ptr,
+					      xhdmi_hdcp22_claim, xhdmi);
+
 		if (HdmiRxSsPtr->Config.Hdcp14.IsPresent || HdmiRxSsPtr->Config.Hdcp22.IsPresent) {
 			if (xhdmi->cable_is_connected) {
 				// Push connect event to HDCP event queue
@@ -1990,16 +2895,124 @@ static ssize_t hdcp_password_store(struct device *sysfs_dev, struct device_attri
 	return count;
 }
 
+static ssize_t edid_passthrough_show(struct device *sysfs_dev, struct device_attribute *attr,
+	char *buf)
+{
+	struct xhdmi_device *xhdmi = (struct xhdmi_device *)dev_get_drvdata(sysfs_dev);
+
+	return scnprintf(buf, PAGE_SIZE, "%d\n", xhdmi->edid_passthrough);
+}
+
+static ssize_t edid_passthrough_store(struct device *sysfs_dev, struct device_attribute *attr,
+	const char *buf, size_t count)
+{
+	struct xhdmi_device *xhdmi = (struct xhdmi_device *)dev_get_drvdata(sysfs_dev);
+	long int i;
+
+	if (kstrtol(buf, 10, &i))
+		return -EINVAL;
+	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
+	xhdmi->edid_passthrough = !!i;
+	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
+	/* pick up the EDID that is already available, or restore the local
+	 * EDID when turned off */
+	queue_work(xhdmi->work_queue, &xhdmi->edid_passthrough_work);
+	return count;
+}
+
+static ssize_t edid_caps_show(struct device *sysfs_dev, struct device_attribute *attr,
+	char *buf)
+{
+	struct xhdmi_device *xhdmi = (struct xhdmi_device *)dev_get_drvdata(sysfs_dev);
+
+	return scnprintf(buf, PAGE_SIZE,
+		"max_tmds_mhz=%u yuv444=%d yuv422=%d yuv420=%d audio=%d\n",
+		xhdmi->edid_max_tmds_mhz,
+		!!(xhdmi->edid_color_formats & EDID_FORMAT_YUV444),
+		!!(xhdmi->edid_color_formats & EDID_FORMAT_YUV422),
+		!!(xhdmi->edid_color_formats & EDID_FORMAT_YUV420),
+		xhdmi->edid_audio);
+}
+
+/* set the pass-through capabilities as "<max_tmds_mhz> <formats> <audio>",
+ * formats being a mask of 1 = YCbCr 4:4:4, 2 = YCbCr 4:2:2, 4 = YCbCr 4:2:0,
+ * max_tmds_mhz 0 keeps the TMDS limits of the sink */
+static ssize_t edid_caps_store(struct device *sysfs_dev, struct device_attribute *attr,
+	const char *buf, size_t count)
+{
+	struct xhdmi_device *xhdmi = (struct xhdmi_device *)dev_get_drvdata(sysfs_dev);
+	u32 max_tmds, formats, audio;
+
+	if (sscanf(buf, "%u %x %u", &max_tmds, &formats, &audio) != 3)
+		return -EINVAL;
+	if (formats & ~EDID_FORMAT_ALL)
+		return -EINVAL;
+	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
+	xhdmi->edid_max_tmds_mhz = max_tmds;
+	xhdmi->edid_color_formats = formats;
+	xhdmi->edid_audio = !!audio;
+	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
+	xhdmi_edid_notify(xhdmi);
+	return count;
+}
+
+/* link-quality monitor state and history, oldest sample first:
+ * <time_ms> <errors ch0> <errors ch1> <errors ch2> <saturated>
+ * writing sets the degraded threshold in errors per second, 0 disables */
+static ssize_t link_quality_show(struct device *sysfs_dev, struct device_attribute *attr,
+	char *buf)
+{
+	struct xhdmi_device *xhdmi = (struct xhdmi_device *)dev_get_drvdata(sysfs_dev);
+	const struct xhdmi_link_sample *sample;
+	unsigned int i, idx;
+	ssize_t count;
+
+	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
+	count = scnprintf(buf, PAGE_SIZE, "period_ms=%u\nthreshold=%u\ndegraded=%d\n",
+			  XHDMI_LINK_MON_PERIOD_MS, xhdmi->link_mon_threshold,
+			  xhdmi->link_mon_degraded);
+	idx = (xhdmi->link_mon_head + XHDMI_LINK_MON_SAMPLES -
+	       xhdmi->link_mon_count) % XHDMI_LINK_MON_SAMPLES;
+	for (i = 0; i < xhdmi->link_mon_count; i++) {
+		sample = &xhdmi->link_mon_ring[idx];
+		count += scnprintf(&buf[count], PAGE_SIZE - count,
+				   "%lld %u %u %u %d\n", sample->time_ms,
+				   sample->errors[0], sample->errors[1],
+				   sample->errors[2], sample->saturated);
+		idx = (idx + 1) % XHDMI_LINK_MON_SAMPLES;
+	}
+	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
+	return count;
+}
+
+static ssize_t link_quality_store(struct device *sysfs_dev, struct device_attribute *attr,
+	const char *buf, size_t count)
+{
+	struct xhdmi_device *xhdmi = (struct xhdmi_device *)dev_get_drvdata(sysfs_dev);
+	u32 threshold;
+
+	if (kstrtou32(buf, 10, &threshold))
+		return -EINVAL;
+	hdmi_mutex_lock(&xhdmi->xhdmi_mutex);
+	xhdmi->link_mon_threshold = threshold;
+	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
+	return count;
+}
+
 static DEVICE_ATTR(vphy_log,  0444, vphy_log_show, NULL/*null_store*/);
 static DEVICE_ATTR(vphy_info, 0444, vphy_info_show, NULL/*null_store*/);
 static DEVICE_ATTR(hdmi_log,  0444, hdmi_log_show, NULL/*null_store*/);
 static DEVICE_ATTR(hdcp_log,  0444, hdcp_log_show, NULL/*null_store*/);
 static DEVICE_ATTR(hdmi_info, 0444, hdmi_info_show, NULL/*null_store*/);
+static DEVICE_ATTR(hdmi_stats, 0444, hdmi_stats_show, NULL/*null_store*/);
+static DEVICE_ATTR(link_quality, 0664, link_quality_show, link_quality_store);
 static DEVICE_ATTR(hdcp_debugen, 0220, NULL/*show*/, hdcp_debugen_store);
 static DEVICE_ATTR(hdcp_key, 0220, NULL/*null_show*/, hdcp_key_store);
 static DEVICE_ATTR(hdcp_password, 0660, hdcp_password_show, hdcp_password_store);
 /* read-only status */
 static DEVICE_ATTR(hdcp_authenticated, 0444, hdcp_authenticated_show, NULL/*store*/);
+static DEVICE_ATTR(edid_passthrough, 0660, edid_passthrough_show, edid_passthrough_store);
+static DEVICE_ATTR(edid_caps, 0660, edid_caps_show, edid_caps_store);
 static DEVICE_ATTR(hdcp_encrypted, 0444, hdcp_encrypted_show, NULL/*store*/);
 
 static struct attribute *attrs[] = {
@@ -2008,11 +3021,15 @@ static struct attribute *attrs[] = {
 	&dev_attr_hdmi_log.attr,
 	&dev_attr_hdcp_log.attr,
 	&dev_attr_hdmi_info.attr,
+	&dev_attr_hdmi_stats.attr,
+	&dev_attr_link_quality.attr,
 	&dev_attr_hdcp_debugen.attr,
 	&dev_attr_hdcp_key.attr,
 	&dev_attr_hdcp_password.attr,
 	&dev_attr_hdcp_authenticated.attr,
 	&dev_attr_hdcp_encrypted.attr,
+	&dev_attr_edid_passthrough.attr,
+	&dev_attr_edid_caps.attr,
 	NULL,
 };
 
@@ -2055,6 +3072,8 @@ static int xhdmi_parse_of(struct xhdmi_device *xhdmi, XV_HdmiRxSs_Config *config
 	isHdcp22_en = of_property_read_bool(node, "xlnx,include-hdcp-2-2");
 	xhdmi->audio_enabled =
 		of_property_read_bool(node, "xlnx,audio-enabled");
+	xhdmi->edid_passthrough =
+		of_property_read_bool(node, "xlnx,edid-passthrough");
 
 	if (isHdcp14_en) {
 		/* HDCP14 Core */
@@ -2148,6 +3167,8 @@ static int xhdmi_probe(struct platform_device *pdev)
 	xhdmi->dev = &pdev->dev;
 
 	xhdmi->edid_blocks_max = 2;
+	xhdmi->edid_max_tmds_mhz = 600;
+	xhdmi->edid_color_formats = EDID_FORMAT_ALL;
 
 	/* mutex that protects against concurrent access */
 	mutex_init(&xhdmi->xhdmi_mutex);
@@ -2161,6 +3182,10 @@ static int xhdmi_probe(struct platform_device *pdev)
 
 	INIT_DELAYED_WORK(&xhdmi->delayed_work_enable_hotplug,
 		xhdmi_delayed_work_enable_hotplug);
+	INIT_WORK(&xhdmi->edid_passthrough_work, xhdmi_edid_passthrough_work);
+	INIT_DELAYED_WORK(&xhdmi->link_mon_work, xhdmi_link_mon_work);
+	xhdmi->link_mon_threshold = XHDMI_LINK_MON_THRESHOLD;
+	INIT_DELAYED_WORK(&xhdmi->audio_mon_work, xhdmi_audio_mon_work);
 
 	dev_dbg(xhdmi->dev,"DT parse start\n");
 	/* parse open firmware device tree data */
@@ -2307,6 +3332,10 @@ static int xhdmi_probe(struct platform_device *pdev)
 		dev_dbg(xhdmi->dev,"xhdmi->hdcp1x_irq = %d\n", xhdmi->hdcp1x_irq);
 		xhdmi->hdcp1x_timer_irq = platform_get_irq_byname(pdev, "hdcp14_timer_irq");
 		dev_dbg(xhdmi->dev,"xhdmi->hdcp1x_timer_irq = %d\n", xhdmi->hdcp1x_timer_irq);
+		xhdmi->hdcp1x_timer_soft = xhdmi_hdcp_soft_timer(xhdmi,
+			&XTmrCtr_ConfigTable[XPAR_XTMRCTR_NUM_INSTANCES/2 + instance * 2 + 0],
+			&xhdmi->hdcp1x_soft_timer, &xhdmi->hdcp1x_timer_irq);
+		dev_dbg(xhdmi->dev,"xhdmi->hdcp1x_timer_soft = %d\n", xhdmi->hdcp1x_timer_soft);
 	}
 
 	if (xhdmi->config.Hdcp22.IsPresent) {
@@ -2314,6 +3343,10 @@ static int xhdmi_probe(struct platform_device *pdev)
 		dev_dbg(xhdmi->dev,"xhdmi->hdcp22_irq = %d\n", xhdmi->hdcp22_irq);
 		xhdmi->hdcp22_timer_irq = platform_get_irq_byname(pdev, "hdcp22_timer_irq");
 		dev_dbg(xhdmi->dev,"xhdmi->hdcp22_timer_irq = %d\n", xhdmi->hdcp22_timer_irq);
+		xhdmi->hdcp22_timer_soft = xhdmi_hdcp_soft_timer(xhdmi,
+			&XTmrCtr_ConfigTable[XPAR_XTMRCTR_NUM_INSTANCES/2 + instance * 2 + 1],
+			&xhdmi->hdcp22_soft_timer, &xhdmi->hdcp22_timer_irq);
+		dev_dbg(xhdmi->dev,"xhdmi->hdcp22_timer_soft = %d\n", xhdmi->hdcp22_timer_soft);
 	}
 
 	if (xhdmi->config.Hdcp14.IsPresent || xhdmi->config.Hdcp22.IsPresent) {
@@ -2441,6 +3474,8 @@ static int xhdmi_probe(struct platform_device *pdev)
 		RxStreamUpCallback, (void *)xhdmi);
 	XV_HdmiRxSs_SetCallback(HdmiRxSsPtr, XV_HDMIRXSS_HANDLER_BRDGOVERFLOW,
 		RxBrdgOverflowCallback, (void *)xhdmi);
+	XV_HdmiRxSs_SetCallback(HdmiRxSsPtr, XV_HDMIRXSS_HANDLER_LNKSTA,
+		RxLnkStaCallback, (void *)xhdmi);
 	XV_HdmiRxSs_SetCallback(HdmiRxSsPtr, XV_HDMIRXSS_HANDLER_AUD,
 		RxAudCallback, (void *)xhdmi);
 	XV_HdmiRxSs_SetCallback(HdmiRxSsPtr, XV_HDMIRXSS_HANDLER_AUX,
@@ -2569,6 +3604,11 @@ static int xhdmi_probe(struct platform_device *pdev)
 			dev_info(xhdmi->dev, "hdmi rx audio initialized\n");
 		}
 	}
+	/* receive the downstream EDID from a TX sharing the PHY */
+	xhdmi->edid_audio = xhdmi->audio_init;
+	xvphy_edid_set_notify(xhdmi->phy[0], xhdmi_edid_notify, xhdmi);
+	xhdmi_edid_notify(xhdmi);
+
 	/* return success */
 	dev_info(xhdmi->dev, "probe successful\n");
 	return 0;
@@ -2603,7 +3643,16 @@ static int xhdmi_remove(struct platform_device *pdev)
 	xhdmi->teardown = 1;
 	spin_unlock_irqrestore(&xhdmi->irq_lock, flags);
 
+	xvphy_edid_set_notify(xhdmi->phy[0], NULL, NULL);
+	xvphy_hdcp22_register(xhdmi->phy[0], NULL, NULL, NULL);
+	cancel_work_sync(&xhdmi->edid_passthrough_work);
 	cancel_delayed_work(&xhdmi->delayed_work_enable_hotplug);
+	cancel_delayed_work_sync(&xhdmi->link_mon_work);
+	cancel_delayed_work_sync(&xhdmi->audio_mon_work);
+	if (xhdmi->hdcp1x_timer_soft)
+		XTmrCtr_HrTimerRelease(&xhdmi->hdcp1x_soft_timer);
+	if (xhdmi->hdcp22_timer_soft)
+		XTmrCtr_HrTimerRelease(&xhdmi->hdcp22_soft_timer);
 	destroy_workqueue(xhdmi->work_queue);
 
 	sysfs_remove_group(&pdev->dev.kobj, &attr_group);
@@ -2660,6 +3709,11 @@ u32 hdmirx_audio_startup(struct device *dev)
 	XV_HdmiRx_AudioEnable(HdmiRxSsPtr->HdmiRxPtr);
 	hdmi_mutex_unlock(&xhdmi->xhdmi_mutex);
 
+	/* the audio monitor keeps the format current, only wait for the
+	 * first rate to settle after a stream up */
+	if (adata->audio_detected)
+		return adata->num_channels;
+
 	err = wait_event_interruptible_timeout(adata->audio_update_q,
 					       adata->audio_detected,
 					       jiffies);
@@ -30,6 +30,7 @@
 #include <drm/display/drm_hdmi_helper.h>
 
 #include <linux/clk.h>
+#include <linux/completion.h>
 #include <linux/delay.h>
 #include <linux/device.h>
 #include <linux/module.h>
@@ -37,6 +38,7 @@
 #include <linux/component.h>
 #include <linux/device.h>
 #include <linux/hdmi.h>
+#include <linux/mm.h>
 #include <linux/of_device.h>
 #include <linux/of_graph.h>
 #include <linux/phy/phy.h>
@@ -55,8 +57,11 @@
 /* for the HMAC, using password to decrypt HDCP keys */
 #include "phy-xilinx-vphy/xhdcp22_common.h"
 #include "phy-xilinx-vphy/aes256.h"
+/* hrtimer backend replacing the HDCP timer IPs */
+#include "phy-xilinx-vphy/xtmrctr_hrtimer.h"
 
 #include "xlnx_hdmitx_audio.h"
+#include "xlnx_hdmi_stats.h"
 
 #define HDMI_MAX_LANES				4
 
@@ -91,6 +96,193 @@
 #define XHDMI_VPSS_MAX_WIDTH		4096
 #define XHDMI_VPSS_MAX_HEIGHT		2160
 
+/* TMDS character rate limits in kHz */
+#define XHDMI_TMDS_MIN_KHZ		25000
+#define XHDMI_TMDS_MAX_HDMI14_KHZ	340000
+#define XHDMI_TMDS_MAX_HDMI20_KHZ	600000
+/* pixel clock deviation, in ppm, still taken as the clock of the running
+ * link by a timing-only mode change, covers the kHz rounding of DRM modes */
+#define XHDMI_RETIME_CLOCK_PPM		100
+/* time allowed for the TX stream to come up after a mode set */
+#define XHDMI_STREAMUP_TIMEOUT_MS	10000
+/* EDID blocks kept across reads and hotplugs of the same sink */
+#define XHDMI_EDID_CACHE_BLOCKS		8
+/* largest HDCP 1.4 SRM accepted through sysfs */
+#define XHDMI_HDCP14_SRM_MAX_SIZE	(128 * 1024)
+/* number of modes whose feasibility is remembered per hotplug */
+#define XHDMI_MODE_CACHE_SIZE		64
+/* SCDC monitor intervals, doubling from fast to slow while the sink is stable */
+#define XHDMI_SCDC_MON_FAST_MS		100
+#define XHDMI_SCDC_MON_SLOW_MS		2000
+/* read request check and fallback status read of a read request capable sink */
+#define XHDMI_SCDC_MON_RR_MS		20
+#define XHDMI_SCDC_MON_RR_FULL_MS	10000
+/* consecutive mismatching status reads before the TMDS config is rewritten */
+#define XHDMI_SCDC_MON_MISMATCH		2
+
+/**
+ * struct xlnx_drm_hdmi_mode_cache - feasibility of a mode for the current sink
+ * @clock: pixel clock in kHz
+ * @hdisplay: horizontal active
+ * @hsync_start: horizontal sync start
+ * @hsync_end: horizontal sync end
+ * @htotal: horizontal total
+ * @vdisplay: vertical active
+ * @vsync_start: vertical sync start
+ * @vsync_end: vertical sync end
+ * @vtotal: vertical total
+ * @flags: DRM mode flags
+ * @fmt: color format the mode was checked in
+ * @bpc: color depth the mode was checked in
+ * @status: result of the feasibility check
+ * @valid: entry is in use
+ */
+struct xlnx_drm_hdmi_mode_cache {
+	int clock;
+	u16 hdisplay;
+	u16 hsync_start;
+	u16 hsync_end;
+	u16 htotal;
+	u16 vdisplay;
+	u16 vsync_start;
+	u16 vsync_end;
+	u16 vtotal;
+	u32 flags;
+	XVidC_ColorFormat fmt;
+	XVidC_ColorDepth bpc;
+	enum drm_mode_status status;
+	bool valid;
+};
+
+/**
+ * struct xlnx_drm_hdmi_stats - performance counters of the TX port
+ * @irq_pio: HDMI TX PIO interrupts
+ * @irq_hdcp1x: HDCP 1.4 cipher interrupts
+ * @irq_hdcp1x_timer: HDCP 1.4 timer interrupts
+ * @irq_hdcp22_timer: HDCP 2.2 timer interrupts
+ * @soft_timer_hdcp1x: HDCP 1.4 software timer expirations
+ * @soft_timer_hdcp22: HDCP 2.2 software timer expirations
+ * @connect: sink connect events
+ * @disconnect: sink disconnect events
+ * @stream_up: stream up events
+ * @stream_down: stream down events
+ * @streamup_timeout: mode sets whose stream did not come up in time
+ * @brdg_overflow: video bridge overflows
+ * @brdg_underflow: video bridge underflows
+ * @brdg_unlocked: video bridge lock losses
+ * @ddc_edid_read: EDID blocks read over DDC
+ * @ddc_edid_error: failed EDID block reads
+ * @edid_cache_hit: EDID blocks served from the cache
+ * @hdcp_auth_attempt: HDCP authentications started
+ * @hdcp_auth_success: HDCP authentications completed
+ * @hdcp_unauthenticated: HDCP authentication failures or losses
+ * @hdcp_type_change: HDCP content stream type changes
+ * @hdcp_type_change_fail: type changes that ended in a loss of authentication
+ * @modeset: mode sets
+ * @modeset_fast: mode sets that kept the link running
+ * @resume: resumes from system sleep
+ * @resume_restore: resumes that restored the stream from the snapshot
+ * @scdc_read: SCDC status reads of the monitor
+ * @scdc_read_error: failed SCDC status reads
+ * @scdc_read_request: SCDC read requests of the sink
+ * @scdc_restore: TMDS configurations rewritten after the sink lost them
+ * @scdc_ced: character errors reported by the sink, per lane
+ * @scdc_ced_rate: character errors per second over the last read, per lane
+ * @modeset_us: time spent in mode set
+ * @streamup_us: time from mode set to stream up
+ * @resume_us: time from resume to stream up
+ * @hdcp_auth_us: time from HDCP authentication start to authenticated
+ * @hdcp_type_change_us: time from content stream type change to in effect
+ */
+struct xlnx_drm_hdmi_stats {
+	atomic64_t irq_pio;
+	atomic64_t irq_hdcp1x;
+	atomic64_t irq_hdcp1x_timer;
+	atomic64_t irq_hdcp22_timer;
+	atomic64_t soft_timer_hdcp1x;
+	atomic64_t soft_timer_hdcp22;
+	atomic64_t connect;
+	atomic64_t disconnect;
+	atomic64_t stream_up;
+	atomic64_t stream_down;
+	atomic64_t streamup_timeout;
+	atomic64_t brdg_overflow;
+	atomic64_t brdg_underflow;
+	atomic64_t brdg_unlocked;
+	atomic64_t ddc_edid_read;
+	atomic64_t ddc_edid_error;
+	atomic64_t edid_cache_hit;
+	atomic64_t hdcp_auth_attempt;
+	atomic64_t hdcp_auth_success;
+	atomic64_t hdcp_unauthenticated;
+	atomic64_t hdcp_type_change;
+	atomic64_t hdcp_type_change_fail;
+	atomic64_t modeset;
+	atomic64_t modeset_fast;
+	atomic64_t resume;
+	atomic64_t resume_restore;
+	atomic64_t scdc_read;
+	atomic64_t scdc_read_error;
+	atomic64_t scdc_read_request;
+	atomic64_t scdc_restore;
+	atomic64_t scdc_ced[XV_HDMITX_SCDC_CHANNELS];
+	atomic64_t scdc_ced_rate[XV_HDMITX_SCDC_CHANNELS];
+	struct xlnx_hdmi_hist modeset_us;
+	struct xlnx_hdmi_hist streamup_us;
+	struct xlnx_hdmi_hist resume_us;
+	struct xlnx_hdmi_hist hdcp_auth_us;
+	struct xlnx_hdmi_hist hdcp_type_change_us;
+};
+
+/**
+ * struct xlnx_drm_hdmi_pm_state - stream programmed at system suspend
+ * @valid: the stream was up at suspend, restore it on resume
+ * @hdcp_poll: the HDCP poll work was running at suspend
+ * @stream: TX core stream
+ * @avi: AVI infoframe
+ * @audio: audio infoframe
+ * @vsif: vendor specific infoframe
+ * @drm: dynamic range and mastering infoframe
+ * @tmds_rate: TX reference clock rate
+ * @ref_clk_hz: PHY TX reference clock
+ * @sample_rate: PHY TX oversampling rate
+ * @pll: first PHY Plls[] entry of the TX PLL
+ * @pll_count: number of Plls[] entries of the TX PLL, 0 if shared with RX
+ * @line_rate: line rate of the TX PLL entries
+ * @out_div: TX output divider of each channel
+ * @vphy: TX MMCM and PLL parameters of the video PHY
+ * @gtphy: TX MMCM and PLL parameters of the HDMI GT controller
+ *
+ * The PHY part is the result of the PLL parameter search done at mode set,
+ * so resume reprograms the PHY without searching again.
+ */
+struct xlnx_drm_hdmi_pm_state {
+	bool valid;
+	bool hdcp_poll;
+	XV_HdmiTx_Stream stream;
+	XHdmiC_AVI_InfoFrame avi;
+	XHdmiC_AudioInfoFrame audio;
+	XHdmiC_VSIF vsif;
+	struct v4l2_hdr10_payload drm;
+	unsigned long tmds_rate;
+	u32 ref_clk_hz;
+	u8 sample_rate;
+	unsigned int pll;
+	unsigned int pll_count;
+	u64 line_rate[4];
+	u8 out_div[4];
+	union {
+		struct {
+			XVphy_Mmcm mmcm;
+			XVphy_PllParam pll[4];
+		} vphy;
+		struct {
+			XHdmiphy1_Mmcm mmcm;
+			XHdmiphy1_PllParam pll[4];
+		} gtphy;
+	};
+};
+
 /**
  * struct xlnx_drm_hdmi - Xilinx HDMI core
  * @encoder: the drm encoder structure
@@ -107,12 +299,17 @@
  * @hdcp1x_timer_irq: hdcp1.4 timer irq
  * @hdcp22_irq: hdcp2.2 block irq
  * @hdcp22_timer_irq: hdcp2.2 time irq
+ * @hdcp1x_soft_timer: hrtimer backend of the hdcp1.4 timer
+ * @hdcp22_soft_timer: hrtimer backend of the hdcp2.2 timer
+ * @hdcp1x_timer_soft: hdcp1.4 timer runs on hdcp1x_soft_timer
+ * @hdcp22_timer_soft: hdcp2.2 timer runs on hdcp22_soft_timer
  * @hdcp_authenticate: flag to enable/disable hdcp authentication
  * @hdcp_encrypt: flag to enable/disable encryption
  * @hdcp_protect: flag to prevent hdcp in pass-throuch mode
  * @hdcp_authenticated: authentication state flag
  * @hdcp_encrypted: ecryption state flag
  * @hdcp_password_accepted: flag to denote is user pwd was accepted
+ * @hdcp22_loopback: hdcp2.2 instance is lent to the PHY loopback benchmark
  * @delayed_work_hdcp_poll: work queue for hdcp polling
  * @hdcp_auth_counter: counter to control hdcp poll time
  * @teardown: flag to indicate driver is being unloaded
@@ -123,7 +320,12 @@
  * @hdmi_stream_up: flag to inidcate video stream state
  * @have_edid: flag to indicate if edid is available
  * @is_hdmi_20_sink: flag to indicate if sink is hdmi2.0 capable
+ * @edid_cache: EDID blocks read from the sink
+ * @edid_cache_valid: bitmap of the valid blocks in edid_cache
+ * @edid_cache_stale: hotplug seen, edid_cache is valid only if block 0 matches
  * @dpms: current dpms state
+ * @mode_cache: feasibility of the modes checked since the last hotplug
+ * @mode_cache_next: next mode_cache entry to replace
  * @xvidc_colorfmt: hdmi ip internal colorformat representation
  * @config: IP configuration structure
  * @xv_hdmitxss: IP low level driver structure
@@ -131,8 +333,25 @@
  * @xvphy: pointer to xilinx video phy
  * @xgtphy: pointer to Xilinx HDMI GT Controller phy
  * @isvphy: Flag to determine which Phy
- * @wait_for_streamup: Flag for TxStreamUpCallback done
- * @wait_event: Wait event queue for TxStreamUpCallback
+ * @streamup_done: completed by TxStreamUpCallback once link and video are ready
+ * @streamup_work: reports the stream-up outcome through the link-status
+ * @link_status: link-status last reported to user space
+ * @retime_work: applies a committed timing change that keeps the link
+ * @retime_state: last committed connector state seen by @retime_work, only
+ *	compared and never dereferenced
+ * @stats: performance counters
+ * @modeset_start: time of the last mode set, 0 once the stream is up
+ * @hdcp_auth_start: time the pending HDCP authentication was started
+ * @hdcp_type_change_start: time the pending content stream type change was
+ *	started, 0 once the type is in effect
+ * @resume_start: time of the last resume, 0 once the stream is up
+ * @pm: stream snapshot taken at system suspend
+ * @scdc_mon_work: reads the SCDC status of an HDMI 2.0 sink while streaming
+ * @scdc_mon_interval: current SCDC monitor interval in ms
+ * @scdc_mon_last: time of the last SCDC status read in jiffies
+ * @scdc_mismatch: consecutive reads with a TMDS config mismatch
+ * @scdc_rr_enabled: the sink signals status changes by read requests
+ * @scdc_ced_last: last character error counts read, per lane
  * @audio_enabled: flag to indicate audio is enabled in device tree
  * @audio_init: flag to indicate audio is initialized
  * @tx_audio_data: audio data to be shared with audio module
@@ -147,6 +366,14 @@
  * @out_fmt_prop_val: configurable media bus format value
  * @aspect_ratio: configurable aspect ratio parameter
  * @aspect_ratio_prop_val: configurable aspect ratio value
+ * @hdcp_content_type: HDCP content stream type property
+ * @hdcp_content_type_val: HDCP content stream type in effect, 0 or 1
+ * @hdcp_content_type_state: last committed connector state whose HDCP content
+ *	stream type was applied, only compared and never dereferenced
+ * @hdcp14_srm: HDCP 1.4 SRM uploaded through sysfs, device managed
+ * @hdcp14_srm_size: size of @hdcp14_srm in bytes
+ * @hdcp14_srm_stage: HDCP 1.4 SRM being written through sysfs
+ * @hdcp14_srm_staged: number of bytes in @hdcp14_srm_stage
  */
 struct xlnx_drm_hdmi {
 	struct drm_encoder encoder;
@@ -169,6 +396,11 @@ struct xlnx_drm_hdmi {
 	int hdcp1x_timer_irq;
 	int hdcp22_irq;
 	int hdcp22_timer_irq;
+	/* HDCP timers emulated on hrtimers, instead of the timer IPs */
+	XTmrCtr_HrTimer hdcp1x_soft_timer;
+	XTmrCtr_HrTimer hdcp22_soft_timer;
+	bool hdcp1x_timer_soft;
+	bool hdcp22_timer_soft;
 	/* controls */
 	bool hdcp_authenticate;
 	bool hdcp_encrypt;
@@ -177,6 +409,7 @@ struct xlnx_drm_hdmi {
 	bool hdcp_authenticated;
 	bool hdcp_encrypted;
 	bool hdcp_password_accepted;
+	bool hdcp22_loopback;
 	/* delayed work to drive HDCP poll */
 	struct delayed_work delayed_work_hdcp_poll;
 	int hdcp_auth_counter;
@@ -194,7 +427,12 @@ struct xlnx_drm_hdmi {
 	bool hdmi_stream_up;
 	bool have_edid;
 	bool is_hdmi_20_sink;
+	u8 edid_cache[XHDMI_EDID_CACHE_BLOCKS * EDID_LENGTH];
+	u32 edid_cache_valid;
+	bool edid_cache_stale;
 	int dpms;
+	struct xlnx_drm_hdmi_mode_cache mode_cache[XHDMI_MODE_CACHE_SIZE];
+	unsigned int mode_cache_next;
 
 	XVidC_ColorFormat xvidc_colorfmt;
 	XVidC_ColorDepth xvidc_colordepth;
@@ -211,10 +449,31 @@ struct xlnx_drm_hdmi {
 	/* flag to determine which Phy */
 	u32 isvphy;
 
-	/* flag for waiting till TxStreamUpCallback ends */
-	u32 wait_for_streamup:1;
-	/* Queue to wait on event of TxStreamUpCallback */
-	wait_queue_head_t wait_event;
+	/* completed when TxStreamUpCallback finds link and video ready */
+	struct completion streamup_done;
+	/* stream-up time-out, updates the connector link-status */
+	struct delayed_work streamup_work;
+	int link_status;
+	/* timing changes that keep the link, without a mode set */
+	struct work_struct retime_work;
+	const struct drm_connector_state *retime_state;
+
+	/* counters exported through the hdmi_stats sysfs entry */
+	struct xlnx_drm_hdmi_stats stats;
+	ktime_t modeset_start;
+	ktime_t hdcp_auth_start;
+	ktime_t hdcp_type_change_start;
+	ktime_t resume_start;
+	/* restored on resume */
+	struct xlnx_drm_hdmi_pm_state pm;
+
+	/* SCDC monitor, serialized with other DDC accesses by hdmi_mutex */
+	struct delayed_work scdc_mon_work;
+	unsigned int scdc_mon_interval;
+	unsigned long scdc_mon_last;
+	unsigned int scdc_mismatch;
+	bool scdc_rr_enabled;
+	u16 scdc_ced_last[XV_HDMITX_SCDC_CHANNELS];
 
 	/* HDCP keys */
 	u8 hdcp_password[32];
@@ -236,6 +495,13 @@ struct xlnx_drm_hdmi {
 	u32 out_fmt_prop_val;
 	struct drm_property *aspect_ratio;
 	u32 aspect_ratio_prop_val;
+	struct drm_property *hdcp_content_type;
+	u32 hdcp_content_type_val;
+	const struct drm_connector_state *hdcp_content_type_state;
+	u8 *hdcp14_srm;
+	size_t hdcp14_srm_size;
+	u8 *hdcp14_srm_stage;
+	size_t hdcp14_srm_staged;
 	/*
 	 * Map of v4l2_hdmi_rx_colorimetry.
 	 * AVI infoframe values are derived in driver reverse of how the
@@ -289,6 +555,195 @@ static inline struct xlnx_drm_hdmi *connector_to_hdmi(struct drm_connector *conn
 	return container_of(connector, struct xlnx_drm_hdmi, connector);
 }
 
+/**
+ * struct xlnx_drm_hdmi_connector_state - HDMI connector state
+ * @base: DRM connector state
+ * @hdcp_content_type: requested HDCP content stream type, 0 or 1
+ * @retime: the commit only changes the timing of the running link, the mode
+ *	is applied by retime_work instead of a mode set
+ * @retime_mode: mode to apply when @retime is set
+ * @retime_fourcc: format of the scanned out framebuffer when @retime is set
+ */
+struct xlnx_drm_hdmi_connector_state {
+	struct drm_connector_state base;
+	u32 hdcp_content_type;
+	bool retime;
+	struct drm_display_mode retime_mode;
+	u32 retime_fourcc;
+};
+
+static inline struct xlnx_drm_hdmi_connector_state *
+to_xlnx_drm_hdmi_connector_state(const struct drm_connector_state *state)
+{
+	return container_of(state, struct xlnx_drm_hdmi_connector_state, base);
+}
+
+static void xlnx_drm_hdmi_mode_cache_flush(struct xlnx_drm_hdmi *xhdmi)
+{
+	memset(xhdmi->mode_cache, 0, sizeof(xhdmi->mode_cache));
+	xhdmi->mode_cache_next = 0;
+}
+
+static bool xlnx_drm_hdmi_mode_cache_match(const struct xlnx_drm_hdmi_mode_cache *entry,
+					   const struct drm_display_mode *mode,
+					   XVidC_ColorFormat fmt,
+					   XVidC_ColorDepth bpc)
+{
+	return entry->valid &&
+	       entry->fmt == fmt &&
+	       entry->bpc == bpc &&
+	       entry->clock == mode->clock &&
+	       entry->hdisplay == mode->hdisplay &&
+	       entry->hsync_start == mode->hsync_start &&
+	       entry->hsync_end == mode->hsync_end &&
+	       entry->htotal == mode->htotal &&
+	       entry->vdisplay == mode->vdisplay &&
+	       entry->vsync_start == mode->vsync_start &&
+	       entry->vsync_end == mode->vsync_end &&
+	       entry->vtotal == mode->vtotal &&
+	       entry->flags == mode->flags;
+}
+
+static struct xlnx_drm_hdmi_mode_cache *
+xlnx_drm_hdmi_mode_cache_find(struct xlnx_drm_hdmi *xhdmi,
+			      const struct drm_display_mode *mode,
+			      XVidC_ColorFormat fmt, XVidC_ColorDepth bpc)
+{
+	int i;
+
+	for (i = 0; i < XHDMI_MODE_CACHE_SIZE; i++)
+		if (xlnx_drm_hdmi_mode_cache_match(&xhdmi->mode_cache[i], mode,
+						   fmt, bpc))
+			return &xhdmi->mode_cache[i];
+	return NULL;
+}
+
+static void xlnx_drm_hdmi_mode_cache_store(struct xlnx_drm_hdmi *xhdmi,
+					   const struct drm_display_mode *mode,
+					   XVidC_ColorFormat fmt,
+					   XVidC_ColorDepth bpc,
+					   enum drm_mode_status status)
+{
+	struct xlnx_drm_hdmi_mode_cache *entry;
+
+	entry = xlnx_drm_hdmi_mode_cache_find(xhdmi, mode, fmt, bpc);
+	if (!entry) {
+		entry = &xhdmi->mode_cache[xhdmi->mode_cache_next];
+		xhdmi->mode_cache_next = (xhdmi->mode_cache_next + 1) %
+					 XHDMI_MODE_CACHE_SIZE;
+		entry->clock = mode->clock;
+		entry->hdisplay = mode->hdisplay;
+		entry->hsync_start = mode->hsync_start;
+		entry->hsync_end = mode->hsync_end;
+		entry->htotal = mode->htotal;
+		entry->vdisplay = mode->vdisplay;
+		entry->vsync_start = mode->vsync_start;
+		entry->vsync_end = mode->vsync_end;
+		entry->vtotal = mode->vtotal;
+		entry->flags = mode->flags;
+		entry->fmt = fmt;
+		entry->bpc = bpc;
+		entry->valid = true;
+	}
+	entry->status = status;
+}
+
+/* highest TMDS character rate (kHz) supported by both sink and GT */
+static int xlnx_drm_hdmi_max_tmds_clock(struct xlnx_drm_hdmi *xhdmi)
+{
+	int max_rate = XHDMI_TMDS_MAX_HDMI14_KHZ;
+	int sink_max = xhdmi->connector.display_info.max_tmds_clock;
+
+	if (xhdmi->is_hdmi_20_sink)
+		max_rate = XHDMI_TMDS_MAX_HDMI20_KHZ;
+	/* max TMDS clock advertised in the HDMI (Forum) VSDB */
+	if (sink_max && sink_max < max_rate)
+		max_rate = sink_max;
+	/* TMDS line rate is 10x the character rate, TxMaxRate is in Gbps */
+	if (!xhdmi->isvphy && xhdmi->xgtphy->Config.TxMaxRate &&
+	    xhdmi->xgtphy->Config.TxMaxRate * 100000 < max_rate)
+		max_rate = xhdmi->xgtphy->Config.TxMaxRate * 100000;
+	return max_rate;
+}
+
+/**
+ * xlnx_drm_hdmi_mode_feasible - check a mode against the TX and sink limits
+ * @xhdmi: pointer to HDMI TX
+ * @mode: mode to check
+ * @fmt: color format the mode is transmitted in
+ * @bpc: color depth the mode is transmitted in
+ *
+ * Mirrors the constraints applied by xlnx_drm_hdmi_encoder_atomic_mode_set()
+ * without touching the hardware: the active width and the total horizontal
+ * blanking must be divisible by the pixels per clock of the video interface,
+ * and the resulting TMDS clock must be within the sink and GT range. Front
+ * porch, sync and back porch need not be, XV_HdmiTxSs_VtcHoriTiming()
+ * rounds them while keeping the total blanking.
+ *
+ * Return: MODE_OK if the mode can be set, a failure reason otherwise
+ */
+static enum drm_mode_status
+xlnx_drm_hdmi_mode_feasible(struct xlnx_drm_hdmi *xhdmi,
+			    const struct drm_display_mode *mode,
+			    XVidC_ColorFormat fmt, XVidC_ColorDepth bpc)
+{
+	int ppc = xhdmi->xv_hdmitxss.Config.Ppc;
+	int clock = mode->clock;
+	u32 htiming;
+
+	/* the timing of a bridged output is taken from the VIC table */
+	if (!xhdmi->bridge) {
+		htiming = mode->hdisplay | (mode->htotal - mode->hdisplay);
+		/* NTSC/PAL are sent with doubled horizontal timing */
+		if (mode->flags & DRM_MODE_FLAG_DBLCLK)
+			htiming <<= 1;
+		/* YUV 4:2:0 halves the horizontal timing once more */
+		if (fmt == XVIDC_CSF_YCRCB_420)
+			ppc *= 2;
+		if (ppc > 1 && (htiming & (ppc - 1)))
+			return MODE_H_ILLEGAL;
+	}
+
+	if (mode->flags & DRM_MODE_FLAG_DBLCLK)
+		clock *= 2;
+	switch (fmt) {
+	case XVIDC_CSF_YCRCB_422:
+		/* 4:2:2 is always carried in 24 bits on the link */
+		break;
+	case XVIDC_CSF_YCRCB_420:
+		clock = clock * bpc / 16;
+		break;
+	default:
+		clock = clock * bpc / 8;
+		break;
+	}
+
+	if (clock < XHDMI_TMDS_MIN_KHZ)
+		return MODE_CLOCK_LOW;
+	if (clock > xlnx_drm_hdmi_max_tmds_clock(xhdmi))
+		return MODE_CLOCK_HIGH;
+	return MODE_OK;
+}
+
+/* look up or compute (and remember) whether the mode fits the current sink
+ * when transmitted in the given color format and depth */
+static enum drm_mode_status
+xlnx_drm_hdmi_mode_status(struct xlnx_drm_hdmi *xhdmi,
+			  const struct drm_display_mode *mode,
+			  XVidC_ColorFormat fmt, XVidC_ColorDepth bpc)
+{
+	struct xlnx_drm_hdmi_mode_cache *entry;
+	enum drm_mode_status status;
+
+	entry = xlnx_drm_hdmi_mode_cache_find(xhdmi, mode, fmt, bpc);
+	if (entry)
+		return entry->status;
+
+	status = xlnx_drm_hdmi_mode_feasible(xhdmi, mode, fmt, bpc);
+	xlnx_drm_hdmi_mode_cache_store(xhdmi, mode, fmt, bpc, status);
+	return status;
+}
+
 
 void HdmiTx_PioIntrHandler(XV_HdmiTx *InstancePtr);
 
@@ -302,15 +757,192 @@ static void XV_HdmiTxSs_IntrDisable(XV_HdmiTxSs *HdmiTxSsPtr)
 	XV_HdmiTx_PioIntrDisable(HdmiTxSsPtr->HdmiTxPtr);
 }
 
+/* take the stream snapshot, entered with hdmi_mutex and the vphy mutex taken */
+static void xlnx_drm_hdmi_pm_save(struct xlnx_drm_hdmi *xhdmi)
+{
+	struct xlnx_drm_hdmi_pm_state *pm = &xhdmi->pm;
+	XV_HdmiTxSs *HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
+	unsigned int i;
+
+	pm->stream = HdmiTxSsPtr->HdmiTxPtr->Stream;
+	pm->avi = HdmiTxSsPtr->AVIInfoframe;
+	pm->audio = HdmiTxSsPtr->AudioInfoframe;
+	pm->vsif = HdmiTxSsPtr->VSIF;
+	pm->drm = HdmiTxSsPtr->DrmInfoframe;
+	pm->tmds_rate = clk_get_rate(xhdmi->tmds_clk);
+
+	if (xhdmi->isvphy) {
+		XVphy *VphyPtr = xhdmi->xvphy;
+		XVphy_Quad *QuadPtr = &VphyPtr->Quads[0];
+		XVphy_PllType TxPllType;
+
+		TxPllType = XVphy_GetPllType(VphyPtr, 0, XVPHY_DIR_TX, XVPHY_CHANNEL_ID_CH1);
+		if (TxPllType == XVPHY_PLL_TYPE_CPLL) {
+			pm->pll = 0;
+			pm->pll_count = 4;
+		} else if ((TxPllType == XVPHY_PLL_TYPE_QPLL) ||
+			   (TxPllType == XVPHY_PLL_TYPE_QPLL0) ||
+			   (TxPllType == XVPHY_PLL_TYPE_PLL0)) {
+			pm->pll = 4;
+			pm->pll_count = 1;
+		} else {
+			pm->pll = 5;
+			pm->pll_count = 1;
+		}
+		/* a PLL shared with RX is (re)configured by RX */
+		if (XVphy_GetPllType(VphyPtr, 0, XVPHY_DIR_RX, XVPHY_CHANNEL_ID_CH1) == TxPllType)
+			pm->pll_count = 0;
+		pm->ref_clk_hz = VphyPtr->HdmiTxRefClkHz;
+		pm->sample_rate = VphyPtr->HdmiTxSampleRate;
+		pm->vphy.mmcm = QuadPtr->TxMmcm;
+		for (i = 0; i < 4; i++)
+			pm->out_div[i] = QuadPtr->Plls[i].TxOutDiv;
+		for (i = 0; i < pm->pll_count; i++) {
+			pm->line_rate[i] = QuadPtr->Plls[pm->pll + i].LineRateHz;
+			pm->vphy.pll[i] = QuadPtr->Plls[pm->pll + i].PllParams;
+		}
+	} else {
+		XHdmiphy1 *XGtPhyPtr = xhdmi->xgtphy;
+		XHdmiphy1_Quad *QuadPtr = &XGtPhyPtr->Quads[0];
+		XHdmiphy1_PllType GtTxPllType;
+
+		GtTxPllType = XHdmiphy1_GetPllType(XGtPhyPtr, 0, XHDMIPHY1_DIR_TX, XHDMIPHY1_CHANNEL_ID_CH1);
+		if (GtTxPllType == XHDMIPHY1_PLL_TYPE_LCPLL) {
+			pm->pll = 4;
+			pm->pll_count = 1;
+		} else if (GtTxPllType == XHDMIPHY1_PLL_TYPE_RPLL) {
+			pm->pll = 5;
+			pm->pll_count = 1;
+		} else {
+			pm->pll = 0;
+			pm->pll_count = 4;
+		}
+		if (XHdmiphy1_GetPllType(XGtPhyPtr, 0, XHDMIPHY1_DIR_RX, XHDMIPHY1_CHANNEL_ID_CH1) == GtTxPllType)
+			pm->pll_count = 0;
+		pm->ref_clk_hz = XGtPhyPtr->HdmiTxRefClkHz;
+		pm->sample_rate = XGtPhyPtr->HdmiTxSampleRate;
+		pm->gtphy.mmcm = QuadPtr->TxMmcm;
+		for (i = 0; i < 4; i++)
+			pm->out_div[i] = QuadPtr->Plls[i].TxOutDiv;
+		for (i = 0; i < pm->pll_count; i++) {
+			pm->line_rate[i] = QuadPtr->Plls[pm->pll + i].LineRateHz;
+			pm->gtphy.pll[i] = QuadPtr->Plls[pm->pll + i].PllParams;
+		}
+	}
+	pm->valid = true;
+}
+
+/* restore the stream snapshot, entered with hdmi_mutex and the vphy mutex
+ * taken. The PHY is reprogrammed from the restored parameters by its TX
+ * timer handler once the reference clock is detected. */
+static void xlnx_drm_hdmi_pm_restore(struct xlnx_drm_hdmi *xhdmi)
+{
+	struct xlnx_drm_hdmi_pm_state *pm = &xhdmi->pm;
+	XV_HdmiTxSs *HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
+	XV_HdmiTx_Stream *StreamPtr = &HdmiTxSsPtr->HdmiTxPtr->Stream;
+	XV_HdmiTx_State State = StreamPtr->State;
+	u8 IsConnected = StreamPtr->IsConnected;
+	unsigned int i;
+	int ret;
+
+	/* the link state is live, the configuration comes from the snapshot */
+	*StreamPtr = pm->stream;
+	StreamPtr->State = State;
+	StreamPtr->IsConnected = IsConnected;
+	HdmiTxSsPtr->AVIInfoframe = pm->avi;
+	HdmiTxSsPtr->AudioInfoframe = pm->audio;
+	HdmiTxSsPtr->VSIF = pm->vsif;
+	HdmiTxSsPtr->DrmInfoframe = pm->drm;
+
+	if (xhdmi->isvphy) {
+		XVphy *VphyPtr = xhdmi->xvphy;
+		XVphy_Quad *QuadPtr = &VphyPtr->Quads[0];
+
+		VphyPtr->HdmiTxRefClkHz = pm->ref_clk_hz;
+		VphyPtr->HdmiTxSampleRate = pm->sample_rate;
+		QuadPtr->TxMmcm = pm->vphy.mmcm;
+		for (i = 0; i < 4; i++)
+			QuadPtr->Plls[i].TxOutDiv = pm->out_div[i];
+		for (i = 0; i < pm->pll_count; i++) {
+			QuadPtr->Plls[pm->pll + i].LineRateHz = pm->line_rate[i];
+			QuadPtr->Plls[pm->pll + i].PllParams = pm->vphy.pll[i];
+		}
+	} else {
+		XHdmiphy1 *XGtPhyPtr = xhdmi->xgtphy;
+		XHdmiphy1_Quad *QuadPtr = &XGtPhyPtr->Quads[0];
+
+		XGtPhyPtr->HdmiTxRefClkHz = pm->ref_clk_hz;
+		XGtPhyPtr->HdmiTxSampleRate = pm->sample_rate;
+		QuadPtr->TxMmcm = pm->gtphy.mmcm;
+		for (i = 0; i < 4; i++)
+			QuadPtr->Plls[i].TxOutDiv = pm->out_div[i];
+		for (i = 0; i < pm->pll_count; i++) {
+			QuadPtr->Plls[pm->pll + i].LineRateHz = pm->line_rate[i];
+			QuadPtr->Plls[pm->pll + i].PllParams = pm->gtphy.pll[i];
+		}
+	}
+
+	ret = clk_set_rate(xhdmi->tmds_clk, pm->tmds_rate);
+	if (ret)
+		dev_err(xhdmi->dev, "failed to set tmds clock rate to %lu: %d\n",
+			pm->tmds_rate, ret);
+	/* the reference clock rate did not change, restart frequency
+	 * detection to have the PHY pick up the restored parameters */
+	if (xhdmi->isvphy)
+		XVphy_ClkDetFreqReset(xhdmi->xvphy, 0, XVPHY_DIR_TX);
+	else
+		XHdmiphy1_ClkDetFreqReset(xhdmi->xgtphy, 0, XHDMIPHY1_DIR_TX);
+}
+
 static int __maybe_unused hdmitx_pm_suspend(struct device *dev)
 {
 	unsigned long flags;
 	struct xlnx_drm_hdmi *xhdmi = dev_get_drvdata(dev);
 	XV_HdmiTxSs *HdmiTxSsPtr = (XV_HdmiTxSs *)&xhdmi->xv_hdmitxss;
 	dev_dbg(xhdmi->dev,"HDMI TX suspend function called\n");
+
+	/* the HDCP poll work takes hdmi_mutex, stop it before taking it,
+	 * it runs once the keys have been loaded */
+	xhdmi->pm.hdcp_poll = false;
+	if (xhdmi->config.Hdcp14.IsPresent || xhdmi->config.Hdcp22.IsPresent) {
+		cancel_delayed_work_sync(&xhdmi->delayed_work_hdcp_poll);
+		xhdmi->pm.hdcp_poll = xhdmi->hdcp_password_accepted;
+	}
+	cancel_delayed_work_sync(&xhdmi->streamup_work);
+	cancel_delayed_work_sync(&xhdmi->scdc_mon_work);
+	cancel_work_sync(&xhdmi->retime_work);
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	/* drop the authentication, the pairing info (stored km) is kept */
+	if (XV_HdmiTxSs_HdcpIsReady(HdmiTxSsPtr) && !xhdmi->hdcp22_loopback) {
+		XV_HdmiTxSs_HdcpPushEvent(HdmiTxSsPtr, XV_HDMITXSS_HDCP_STREAMDOWN_EVT);
+		XV_HdmiTxSs_HdcpPoll(HdmiTxSsPtr);
+	}
+	xhdmi->hdcp_authenticated = 0;
+	xhdmi->hdcp_encrypted = 0;
+
+	xvphy_mutex_lock(xhdmi->phy[0]);
+	xhdmi->pm.valid = false;
+	if (xhdmi->hdmi_stream_up)
+		xlnx_drm_hdmi_pm_save(xhdmi);
+	xhdmi->hdmi_stream_up = 0;
+
+	/* Disable TX TMDS clock */
+	if (xhdmi->isvphy)
+		XVphy_Clkout1OBufTdsEnable(xhdmi->xvphy, XVPHY_DIR_TX, (FALSE));
+	else
+		XHdmiphy1_Clkout1OBufTdsEnable(xhdmi->xgtphy, XHDMIPHY1_DIR_TX, (FALSE));
+	xvphy_mutex_unlock(xhdmi->phy[0]);
+
 	spin_lock_irqsave(&xhdmi->irq_lock, flags);
 	XV_HdmiTxSs_IntrDisable(HdmiTxSsPtr);
 	spin_unlock_irqrestore(&xhdmi->irq_lock, flags);
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+
+	if (xhdmi->retimer_clk)
+		clk_disable_unprepare(xhdmi->retimer_clk);
+	clk_disable_unprepare(xhdmi->tmds_clk);
+	clk_disable_unprepare(xhdmi->axi_lite_clk);
 	return 0;
 }
 
@@ -319,10 +951,101 @@ static int __maybe_unused hdmitx_pm_resume(struct device *dev)
 	unsigned long flags;
 	struct xlnx_drm_hdmi *xhdmi = dev_get_drvdata(dev);
 	XV_HdmiTxSs *HdmiTxSsPtr = (XV_HdmiTxSs *)&xhdmi->xv_hdmitxss;
+	int ret;
 	dev_dbg(xhdmi->dev,"HDMI TX resume function called\n");
+
+	ret = clk_prepare_enable(xhdmi->axi_lite_clk);
+	if (ret) {
+		dev_err(xhdmi->dev, "failed to enable axi-lite clk\n");
+		return ret;
+	}
+	ret = clk_prepare_enable(xhdmi->tmds_clk);
+	if (ret) {
+		dev_err(xhdmi->dev, "failed to enable tmds clk\n");
+		goto err_disable_axi_lite_clk;
+	}
+	if (xhdmi->retimer_clk) {
+		ret = clk_prepare_enable(xhdmi->retimer_clk);
+		if (ret) {
+			dev_err(xhdmi->dev, "failed to enable retimer clk\n");
+			goto err_disable_tmds_clk;
+		}
+	}
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	atomic64_inc(&xhdmi->stats.resume);
+	if (xhdmi->pm.valid) {
+		xvphy_mutex_lock(xhdmi->phy[0]);
+		xlnx_drm_hdmi_pm_restore(xhdmi);
+		xvphy_mutex_unlock(xhdmi->phy[0]);
+		/* the sink may have dropped scrambling while the link was down */
+		if (HdmiTxSsPtr->HdmiTxPtr->Stream.IsConnected)
+			XV_HdmiTxSs_StreamStart(HdmiTxSsPtr);
+		reinit_completion(&xhdmi->streamup_done);
+		mod_delayed_work(system_wq, &xhdmi->streamup_work,
+				 msecs_to_jiffies(XHDMI_STREAMUP_TIMEOUT_MS));
+		xhdmi->resume_start = ktime_get();
+		atomic64_inc(&xhdmi->stats.resume_restore);
+		xhdmi->pm.valid = false;
+	}
 	spin_lock_irqsave(&xhdmi->irq_lock, flags);
 	XV_HdmiTxSs_IntrEnable(HdmiTxSsPtr);
 	spin_unlock_irqrestore(&xhdmi->irq_lock, flags);
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+
+	/* re-authenticates on stream up, with the stored km of a known sink */
+	if (xhdmi->pm.hdcp_poll)
+		schedule_delayed_work(&xhdmi->delayed_work_hdcp_poll, 0);
+	return 0;
+
+err_disable_tmds_clk:
+	clk_disable_unprepare(xhdmi->tmds_clk);
+err_disable_axi_lite_clk:
+	clk_disable_unprepare(xhdmi->axi_lite_clk);
+	return ret;
+}
+
+/* read one EDID block, from the per-hotplug cache when possible */
+static int xlnx_drm_hdmi_read_edid_block(struct xlnx_drm_hdmi *xhdmi, u8 *buf,
+					 unsigned int block)
+{
+	XV_HdmiTxSs *HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
+	u8 *cached = xhdmi->edid_cache + block * EDID_LENGTH;
+	bool cacheable = block < XHDMI_EDID_CACHE_BLOCKS;
+
+	if (cacheable && !xhdmi->edid_cache_stale &&
+	    (xhdmi->edid_cache_valid & BIT(block))) {
+		memcpy(buf, cached, EDID_LENGTH);
+		atomic64_inc(&xhdmi->stats.edid_cache_hit);
+		return 0;
+	}
+
+	if (!HdmiTxSsPtr->IsStreamConnected)
+		dev_dbg(xhdmi->dev, "%s() stream is not connected\n", __func__);
+	atomic64_inc(&xhdmi->stats.ddc_edid_read);
+	if (XV_HdmiTxSs_ReadEdidBlock(HdmiTxSsPtr, buf, block) != XST_SUCCESS) {
+		atomic64_inc(&xhdmi->stats.ddc_edid_error);
+		dev_dbg(xhdmi->dev, "%s() failed reading EDID block %u\n",
+			__func__, block);
+		return -EINVAL;
+	}
+
+	/* after a hotplug, block 0 tells whether the same sink is back */
+	if (block == 0 && xhdmi->edid_cache_stale) {
+		xhdmi->edid_cache_stale = false;
+		if ((xhdmi->edid_cache_valid & BIT(0)) &&
+		    cached[EDID_LENGTH - 1] == buf[EDID_LENGTH - 1] &&
+		    !memcmp(cached, buf, EDID_LENGTH)) {
+			dev_dbg(xhdmi->dev, "EDID unchanged, using cached blocks\n");
+			return 0;
+		}
+		xhdmi->edid_cache_valid = 0;
+	}
+
+	if (cacheable && !xhdmi->edid_cache_stale) {
+		memcpy(cached, buf, EDID_LENGTH);
+		xhdmi->edid_cache_valid |= BIT(block);
+	}
 	return 0;
 }
 
@@ -336,33 +1059,20 @@ static int __maybe_unused hdmitx_pm_resume(struct device *dev)
 static int xlnx_drm_hdmi_get_edid_block(void *data, u8 *buf, unsigned int block,
 				  size_t len)
 {
-	u8 *buffer;
 	struct xlnx_drm_hdmi *xhdmi = (struct xlnx_drm_hdmi *)data;
-	XV_HdmiTxSs *HdmiTxSsPtr;
+	unsigned int i;
 	int ret;
 
-	/* out of bounds? */
-	if (((block * 128) + len) > 256) return -EINVAL;
-
-	buffer = kzalloc(256, GFP_KERNEL);
-	if (!buffer) return -ENOMEM;
-
-	HdmiTxSsPtr = (XV_HdmiTxSs *)&xhdmi->xv_hdmitxss;
-	if (!HdmiTxSsPtr->IsStreamConnected) {
-		dev_dbg(xhdmi->dev, "xlnx_drm_hdmi_get_edid_block() stream is not connected\n");
-	}
-	/* first obtain edid in local buffer */
-	ret = XV_HdmiTxSs_ReadEdid(HdmiTxSsPtr, buffer);
-	if (ret == XST_FAILURE) {
-		kfree(buffer);
-		dev_dbg(xhdmi->dev, "xlnx_drm_hdmi_get_edid_block() failed reading EDID\n");
+	/* E-DDC addresses 128 segments of two blocks */
+	if (len % EDID_LENGTH || block + len / EDID_LENGTH > 256)
 		return -EINVAL;
-	}
 
-	/* then copy the requested 128-byte block(s) */
-	memcpy(buf, buffer + block * 128, len);
-	/* free our local buffer */
-	kfree(buffer);
+	for (i = 0; i < len / EDID_LENGTH; i++) {
+		ret = xlnx_drm_hdmi_read_edid_block(xhdmi, buf + i * EDID_LENGTH,
+						    block + i);
+		if (ret)
+			return ret;
+	}
 	return 0;
 }
 
@@ -384,6 +1094,7 @@ static irqreturn_t hdmitx_irq_handler(int irq, void *dev_id)
 	/* read status registers */
 	xhdmi->IntrStatus = XV_HdmiTx_ReadReg(HdmiTxSsPtr->HdmiTxPtr->Config.BaseAddress, (
 							XV_HDMITX_PIO_STA_OFFSET)) & (XV_HDMITX_PIO_STA_IRQ_MASK);
+	atomic64_inc(&xhdmi->stats.irq_pio);
 
 	spin_lock_irqsave(&xhdmi->irq_lock, flags);
 	/* mask interrupt request */
@@ -443,11 +1154,14 @@ static irqreturn_t hdmitx_hdcp_irq_handler(int irq, void *dev_id)
 	spin_lock_irqsave(&xhdmi->irq_lock, flags);
 	/* mask/disable interrupt requests */
 	if (irq == xhdmi->hdcp1x_irq) {
+	  atomic64_inc(&xhdmi->stats.irq_hdcp1x);
 	  XHdcp1x_WriteReg(HdmiTxSsPtr->Hdcp14Ptr->Config.BaseAddress,
 		  XHDCP1X_CIPHER_REG_INTERRUPT_MASK, (u32)0xFFFFFFFFu);
 	} else if (irq == xhdmi->hdcp1x_timer_irq) {
+	  atomic64_inc(&xhdmi->stats.irq_hdcp1x_timer);
 	  XTmrCtr_DisableIntr(HdmiTxSsPtr->HdcpTimerPtr->BaseAddress, 0);
 	} else if (irq == xhdmi->hdcp22_timer_irq) {
+	  atomic64_inc(&xhdmi->stats.irq_hdcp22_timer);
 	  XTmrCtr_DisableIntr(HdmiTxSsPtr->Hdcp22Ptr->Timer.TmrCtr.BaseAddress, 0);
 	  XTmrCtr_DisableIntr(HdmiTxSsPtr->Hdcp22Ptr->Timer.TmrCtr.BaseAddress, 1);
 	}
@@ -503,14 +1217,57 @@ static irqreturn_t hdmitx_hdcp_irq_thread(int irq, void *dev_id)
 	return IRQ_HANDLED;
 }
 
+/* HDCP software timer service, runs from a work item in place of the timer irq thread */
+static void hdmitx_hdcp_soft_timer_service(void *ref, XTmrCtr *TmrCtrPtr)
+{
+	struct xlnx_drm_hdmi *xhdmi = (struct xlnx_drm_hdmi *)ref;
+
+	/* driver is being torn down, do not process further expirations */
+	if (xhdmi->teardown)
+		return;
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	if (TmrCtrPtr == xhdmi->xv_hdmitxss.HdcpTimerPtr)
+		atomic64_inc(&xhdmi->stats.soft_timer_hdcp1x);
+	else
+		atomic64_inc(&xhdmi->stats.soft_timer_hdcp22);
+	XTmrCtr_InterruptHandler(TmrCtrPtr);
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+}
+
+/*
+ * Runs an HDCP timer on an hrtimer if the device tree asks for it or if the
+ * timer interrupt is not connected, the timer IP and its interrupt are then
+ * not used. Returns true if the software timer is selected.
+ */
+static bool xlnx_drm_hdmi_hdcp_soft_timer(struct xlnx_drm_hdmi *xhdmi,
+					  XTmrCtr_Config *cfg,
+					  XTmrCtr_HrTimer *soft_timer, int *irq)
+{
+	if (*irq > 0 &&
+	    !of_property_read_bool(xhdmi->dev->of_node, "xlnx,hdcp-soft-timer")) {
+		/* the table outlives this driver instance */
+		cfg->SoftOps = NULL;
+		cfg->SoftRef = NULL;
+		return false;
+	}
+
+	XTmrCtr_HrTimerInitialize(soft_timer, cfg, hdmitx_hdcp_soft_timer_service,
+				  xhdmi);
+	*irq = 0;
+	return true;
+}
+
 static void hdcp_protect_content(struct xlnx_drm_hdmi *xhdmi)
 {
 	XV_HdmiTxSs *HdmiTxSsPtr;
 	HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
 
 	if (!XV_HdmiTxSs_HdcpIsReady(HdmiTxSsPtr)) return;
-	/* content must be protected but is not encrypted? */
-	if (xhdmi->hdcp_protect && (!xhdmi->hdcp_encrypted)) {
+	/* content must be protected but is not encrypted, or the repeater
+	 * did not confirm Type 1 yet? */
+	if (xhdmi->hdcp_protect && (!xhdmi->hdcp_encrypted ||
+	    (xhdmi->hdcp_type_change_start && xhdmi->hdcp_content_type_val))) {
 		/* blank content instead of encrypting */
 		XV_HdmiTxSs_HdcpEnableBlank(HdmiTxSsPtr);
 	} else {
@@ -519,18 +1276,130 @@ static void hdcp_protect_content(struct xlnx_drm_hdmi *xhdmi)
 	}
 }
 
+/* changes the HDCP content stream type on the authenticated link, a repeater
+ * is told with content stream management instead of re-authentication */
+static int xlnx_drm_hdmi_hdcp_set_content_type(struct xlnx_drm_hdmi *xhdmi,
+					       u32 type)
+{
+	XV_HdmiTxSs *HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
+	ktime_t start = ktime_get();
+	int ret = 0;
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	if (xhdmi->hdcp22_loopback) {
+		ret = -EBUSY;
+		goto out;
+	}
+	if (type == xhdmi->hdcp_content_type_val)
+		goto out;
+	if (XV_HdmiTxSs_HdcpChangeContentStreamType(HdmiTxSsPtr, type) !=
+	    XST_SUCCESS) {
+		dev_dbg(xhdmi->dev, "HDCP content type %u not allowed\n", type);
+		ret = -EINVAL;
+		goto out;
+	}
+	xhdmi->hdcp_content_type_val = type;
+	atomic64_inc(&xhdmi->stats.hdcp_type_change);
+	/* hdcp_poll_work accounts the change once the repeater confirmed it */
+	if (XV_HdmiTxSs_HdcpIsContentStreamTypeChangePending(HdmiTxSsPtr)) {
+		xhdmi->hdcp_type_change_start = start;
+	} else {
+		xlnx_hdmi_hist_add(&xhdmi->stats.hdcp_type_change_us, start);
+		xhdmi->hdcp_type_change_start = 0;
+	}
+	hdcp_protect_content(xhdmi);
+out:
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+	return ret;
+}
+
+/* tells if the link can carry the HDCP content stream type, Type 1 content
+ * needs HDCP 2.2 without HDCP 1.x or legacy HDCP 2.x devices downstream */
+static bool xlnx_drm_hdmi_hdcp_content_type_allowed(struct xlnx_drm_hdmi *xhdmi,
+						    u32 type)
+{
+	XV_HdmiTxSs *HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
+	bool allowed = true;
+
+	if (type == XV_HDMITXSS_HDCP_STREAMTYPE_0)
+		return true;
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	switch (XV_HdmiTxSs_HdcpGetProtocol(HdmiTxSsPtr)) {
+	case XV_HDMITXSS_HDCP_14:
+		allowed = false;
+		break;
+	case XV_HDMITXSS_HDCP_22:
+		allowed = !XV_HdmiTxSs_HdcpGetTopologyField(HdmiTxSsPtr,
+				XV_HDMITXSS_HDCP_TOPOLOGY_HDCP1DEVICEDOWNSTREAM) &&
+			  !XV_HdmiTxSs_HdcpGetTopologyField(HdmiTxSsPtr,
+				XV_HDMITXSS_HDCP_TOPOLOGY_HDCP2LEGACYDEVICEDOWNSTREAM);
+		break;
+	default:
+		/* not authenticated, applied when authentication starts */
+		break;
+	}
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+	return allowed;
+}
+
+/*
+ * Applies the HDCP content stream type of the committed connector state.
+ * The connector has no commit hook outside of a modeset and a modeset would
+ * re-authenticate, so the committed state is picked up by hdcp_poll_work.
+ * Every newly committed state is applied once, so committing the type again
+ * retries a type the link could not carry.
+ */
+static void xlnx_drm_hdmi_hdcp_apply_content_type(struct xlnx_drm_hdmi *xhdmi)
+{
+	struct drm_connector *connector = &xhdmi->connector;
+	const struct drm_connector_state *state;
+	struct drm_modeset_lock *lock;
+	u32 type = 0;
+
+	if (!xhdmi->hdcp_content_type || !connector->dev)
+		return;
+
+	/* connector->state is swapped under the connection mutex; without an
+	 * acquire context the lock cannot back off and always succeeds */
+	lock = &connector->dev->mode_config.connection_mutex;
+	if (drm_modeset_lock(lock, NULL))
+		return;
+	state = connector->state;
+	if (state)
+		type = to_xlnx_drm_hdmi_connector_state(state)->hdcp_content_type;
+	drm_modeset_unlock(lock);
+
+	if (!state || state == xhdmi->hdcp_content_type_state)
+		return;
+	xhdmi->hdcp_content_type_state = state;
+	xlnx_drm_hdmi_hdcp_set_content_type(xhdmi, type);
+}
+
+/* push the authenticate event and account the attempt */
+static void xlnx_drm_hdmi_hdcp_auth_start(struct xlnx_drm_hdmi *xhdmi)
+{
+	XV_HdmiTxSs_HdcpPushEvent(&xhdmi->xv_hdmitxss,
+				  XV_HDMITXSS_HDCP_AUTHENTICATE_EVT);
+	atomic64_inc(&xhdmi->stats.hdcp_auth_attempt);
+	xhdmi->hdcp_auth_start = ktime_get();
+}
+
 static void XHdcp_Authenticate(XV_HdmiTxSs *HdmiTxSsPtr)
 {
+	struct xlnx_drm_hdmi *xhdmi = container_of(HdmiTxSsPtr,
+		struct xlnx_drm_hdmi, xv_hdmitxss);
+
 	if (!XV_HdmiTxSs_HdcpIsReady(HdmiTxSsPtr)) return;
 	if (XV_HdmiTxSs_IsStreamUp(HdmiTxSsPtr)) {
 		/* Trigger authentication on Idle */
 		if (!(XV_HdmiTxSs_HdcpIsAuthenticated(HdmiTxSsPtr)) &&
 			!(XV_HdmiTxSs_HdcpIsInProgress(HdmiTxSsPtr))) {
-			XV_HdmiTxSs_HdcpPushEvent(HdmiTxSsPtr, XV_HDMITXSS_HDCP_AUTHENTICATE_EVT);
+			xlnx_drm_hdmi_hdcp_auth_start(xhdmi);
 		}
 		/* Trigger authentication on Toggle */
 		else if (XV_HdmiTxSs_IsStreamToggled(HdmiTxSsPtr)) {
-			XV_HdmiTxSs_HdcpPushEvent(HdmiTxSsPtr, XV_HDMITXSS_HDCP_AUTHENTICATE_EVT);
+			xlnx_drm_hdmi_hdcp_auth_start(xhdmi);
 		}
 	}
 }
@@ -626,14 +1495,24 @@ static void TxConnectCallback(void *CallbackRef)
 	struct edid *edid = NULL;
 
 	dev_dbg(xhdmi->dev,"%s()\n", __func__);
-	xvphy_mutex_lock(xhdmi->phy[0]);
+	/* the TX domain is held across the (slow) EDID read, the quad lock only
+	 * around PHY accesses, so RX can reconfigure the PHY meanwhile */
+	xvphy_domain_lock(xhdmi->phy[0]);
+	/* a different sink may have been connected, re-check all modes */
+	xlnx_drm_hdmi_mode_cache_flush(xhdmi);
+	xhdmi->edid_cache_stale = true;
 	if (HdmiTxSsPtr->IsStreamConnected) {
 		int xst_hdmi20;
+		atomic64_inc(&xhdmi->stats.connect);
 		xhdmi->cable_connected = 1;
 		xhdmi->connector.status = connector_status_connected;
 		edid = drm_do_get_edid(&xhdmi->connector, xlnx_drm_hdmi_get_edid_block, xhdmi);
 		if (edid) {
 			xhdmi->have_edid = 1;
+			/* hand the sink EDID to an RX sharing the PHY (pass-through) */
+			xvphy_edid_publish(xhdmi->phy[0], (u8 *)edid,
+				min_t(int, EDID_LENGTH * (edid->extensions + 1),
+				      XVPHY_EDID_MAX_SIZE));
 			kfree(edid);
 		}
 		/* Check HDMI sink version */
@@ -641,32 +1520,39 @@ static void TxConnectCallback(void *CallbackRef)
 		dev_dbg(xhdmi->dev,"TxConnectCallback(): TX connected to HDMI %s Sink Device\n",
 			(xst_hdmi20 == XST_SUCCESS)? "2.0": "1.4");
 		xhdmi->is_hdmi_20_sink = (xst_hdmi20 == XST_SUCCESS);
+		xvphy_quad_lock(xhdmi->phy[0]);
 		if (xhdmi->isvphy)
 			XVphy_IBufDsEnable(VphyPtr, 0, XVPHY_DIR_TX, (TRUE));
 		else
 			XHdmiphy1_IBufDsEnable(XGtPhyPtr, 0, XHDMIPHY1_DIR_TX, (TRUE));
+		xvphy_quad_unlock(xhdmi->phy[0]);
 		XV_HdmiTxSs_StreamStart(HdmiTxSsPtr);
 		/* stream never goes down on disconnect. Force hdcp event */
 		if (xhdmi->hdmi_stream_up &&
 			XV_HdmiTxSs_HdcpIsReady(HdmiTxSsPtr) &&
 			xhdmi->hdcp_authenticate) {
 			/* Push the Authenticate event to the HDCP event queue */
-			XV_HdmiTxSs_HdcpPushEvent(HdmiTxSsPtr, XV_HDMITXSS_HDCP_AUTHENTICATE_EVT);
+			xlnx_drm_hdmi_hdcp_auth_start(xhdmi);
 		}
 	}
 	else {
 		dev_dbg(xhdmi->dev,"TxConnectCallback(): TX disconnected\n");
+		atomic64_inc(&xhdmi->stats.disconnect);
 		xhdmi->cable_connected = 0;
 		xhdmi->connector.status = connector_status_disconnected;
 		xhdmi->have_edid = 0;
 		xhdmi->is_hdmi_20_sink = 0;
+		/* withdraw the sink EDID from an RX sharing the PHY */
+		xvphy_edid_publish(xhdmi->phy[0], NULL, 0);
 		/* do not disable ibufds - stream will not go down*/
+		xvphy_quad_lock(xhdmi->phy[0]);
 		if (xhdmi->isvphy)
 			XVphy_IBufDsEnable(VphyPtr, 0, XVPHY_DIR_TX, (FALSE));
 		else
 			XHdmiphy1_IBufDsEnable(XGtPhyPtr, 0, XHDMIPHY1_DIR_TX, (FALSE));
+		xvphy_quad_unlock(xhdmi->phy[0]);
 	}
-	xvphy_mutex_unlock(xhdmi->phy[0]);
+	xvphy_domain_unlock(xhdmi->phy[0]);
 
 	if(xhdmi->connector.dev) {
 		/* Not using drm_kms_helper_hotplug_event because apart from notifying
@@ -685,6 +1571,27 @@ static void TxConnectCallback(void *CallbackRef)
 	dev_dbg(xhdmi->dev,"TxConnectCallback() done\n");
 }
 
+/* (re)starts the SCDC monitor of an HDMI 2.0 sink, called with hdmi_mutex held */
+static void xlnx_drm_hdmi_scdc_mon_start(struct xlnx_drm_hdmi *xhdmi)
+{
+	XV_HdmiTx *HdmiTxPtr = xhdmi->xv_hdmitxss.HdmiTxPtr;
+	struct drm_scdc *scdc = &xhdmi->connector.display_info.hdmi.scdc;
+
+	if (!HdmiTxPtr->Stream.IsHdmi20)
+		return;
+
+	/* a read request capable sink tells when its status changed, which
+	 * saves reading the status over the DDC at every interval */
+	xhdmi->scdc_rr_enabled = scdc->supported && scdc->read_request &&
+		XV_HdmiTx_ScdcSetReadRequest(HdmiTxPtr, TRUE) == XST_SUCCESS;
+	xhdmi->scdc_mon_interval = XHDMI_SCDC_MON_FAST_MS;
+	xhdmi->scdc_mon_last = jiffies;
+	xhdmi->scdc_mismatch = 0;
+	memset(xhdmi->scdc_ced_last, 0, sizeof(xhdmi->scdc_ced_last));
+	mod_delayed_work(system_wq, &xhdmi->scdc_mon_work,
+			 msecs_to_jiffies(XHDMI_SCDC_MON_FAST_MS));
+}
+
 static void TxStreamUpCallback(void *CallbackRef)
 {
 	struct xlnx_drm_hdmi *xhdmi = (struct xlnx_drm_hdmi *)CallbackRef;
@@ -706,6 +1613,7 @@ static void TxStreamUpCallback(void *CallbackRef)
 	/* Ensure that the bridge SYSRST is not released */
 	XV_HdmiTxSs_SYSRST(HdmiTxSsPtr, TRUE);
 	xhdmi->hdmi_stream_up = 1;
+	atomic64_inc(&xhdmi->stats.stream_up);
 
 	AVIInfoFramePtr = XV_HdmiTxSs_GetAviInfoframe(HdmiTxSsPtr);
 	HdmiTxSsVidStreamPtr = XV_HdmiTxSs_GetVideoStream(HdmiTxSsPtr);
@@ -773,6 +1681,7 @@ static void TxStreamUpCallback(void *CallbackRef)
 #ifdef DEBUG
 	XV_HdmiTx_DebugInfo(HdmiTxSsPtr->HdmiTxPtr);
 #endif
+	xlnx_drm_hdmi_scdc_mon_start(xhdmi);
 	if (xhdmi->hdcp_authenticate) {
 		XHdcp_Authenticate(HdmiTxSsPtr);
 	}
@@ -786,13 +1695,15 @@ static void TxStreamUpCallback(void *CallbackRef)
 	if ((XV_HDMITX_PIO_IN_VID_RDY_MASK | XV_HDMITX_PIO_IN_LNK_RDY_MASK) &&
 			XV_HdmiTx_ReadReg((uintptr_t)xhdmi->iomem,
 					XV_HDMITX_PIO_IN_OFFSET)) {
-		xhdmi->wait_for_streamup = 1;
-	} else {
-		xhdmi->wait_for_streamup = 0;
+		complete_all(&xhdmi->streamup_done);
+		xlnx_hdmi_hist_add(&xhdmi->stats.streamup_us, xhdmi->modeset_start);
+		xhdmi->modeset_start = 0;
+		xlnx_hdmi_hist_add(&xhdmi->stats.resume_us, xhdmi->resume_start);
+		xhdmi->resume_start = 0;
+		/* report the link good now rather than at the time-out */
+		mod_delayed_work(system_wq, &xhdmi->streamup_work, 0);
 	}
 
-	wake_up(&xhdmi->wait_event);
-
 	/* When YUYV is base color format for pl display then HDMI doesn't come up
 	 * first couple of tries as the EXT_SYSRST (bit 22) is cleared.
 	 * Set this bit in case stream is up and encoder is enabled
@@ -809,6 +1720,7 @@ static void TxStreamDownCallback(void *CallbackRef)
 
 	dev_dbg(xhdmi->dev,"TxStreamDownCallback(): TX stream is down\n\r");
 	xhdmi->hdmi_stream_up = 0;
+	atomic64_inc(&xhdmi->stats.stream_down);
 
 	xhdmi->hdcp_authenticated = 0;
 	xhdmi->hdcp_encrypted = 0;
@@ -886,18 +1798,21 @@ void TxBrdgUnlockedCallback(void *CallbackRef)
 	/* XV_ConfigTpg(&Tpg);                        */
 	struct xlnx_drm_hdmi *xhdmi = (struct xlnx_drm_hdmi *)CallbackRef;
 	dev_dbg(xhdmi->dev,"TX Bridge Unlocked Callback\r\n");
+	atomic64_inc(&xhdmi->stats.brdg_unlocked);
 }
 
 void TxBrdgOverflowCallback(void *CallbackRef)
 {
 	struct xlnx_drm_hdmi *xhdmi = (struct xlnx_drm_hdmi *)CallbackRef;
 	dev_dbg(xhdmi->dev,"TX Video Bridge Overflow\r\n");
+	atomic64_inc(&xhdmi->stats.brdg_overflow);
 }
 
 void TxBrdgUnderflowCallback(void *CallbackRef)
 {
 	struct xlnx_drm_hdmi *xhdmi = (struct xlnx_drm_hdmi *)CallbackRef;
 	dev_dbg(xhdmi->dev,"TX Video Bridge Underflow\r\n");
+	atomic64_inc(&xhdmi->stats.brdg_underflow);
 }
 
 void TxHdcpAuthenticatedCallback(void *CallbackRef)
@@ -906,6 +1821,9 @@ void TxHdcpAuthenticatedCallback(void *CallbackRef)
 	XV_HdmiTxSs *HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
 
 	xhdmi->hdcp_authenticated = 1;
+	atomic64_inc(&xhdmi->stats.hdcp_auth_success);
+	xlnx_hdmi_hist_add(&xhdmi->stats.hdcp_auth_us, xhdmi->hdcp_auth_start);
+	xhdmi->hdcp_auth_start = 0;
 	if (XV_HdmiTxSs_HdcpGetProtocol(HdmiTxSsPtr) == XV_HDMITXSS_HDCP_22) {
 		dev_dbg(xhdmi->dev,"HDCP 2.2 TX authenticated.\n");
 	}
@@ -929,6 +1847,12 @@ void TxHdcpUnauthenticatedCallback(void *CallbackRef)
 	struct xlnx_drm_hdmi *xhdmi = (struct xlnx_drm_hdmi *)CallbackRef;
 
 	dev_dbg(xhdmi->dev,"TxHdcpUnauthenticatedCallback()\n");
+	atomic64_inc(&xhdmi->stats.hdcp_unauthenticated);
+	xhdmi->hdcp_auth_start = 0;
+	if (xhdmi->hdcp_type_change_start) {
+		atomic64_inc(&xhdmi->stats.hdcp_type_change_fail);
+		xhdmi->hdcp_type_change_start = 0;
+	}
 	xhdmi->hdcp_authenticated = 0;
 	xhdmi->hdcp_encrypted = 0;
 	hdcp_protect_content(xhdmi);
@@ -1029,6 +1953,9 @@ static int xlnx_drm_hdmi_set_property(struct drm_connector *connector,
 		xhdmi->out_fmt_prop_val = (u32)val;
 	else if (property == xhdmi->aspect_ratio)
 		xhdmi->aspect_ratio_prop_val = (u32)val;
+	else if (property == xhdmi->hdcp_content_type)
+		/* applied by hdcp_poll_work once committed */
+		to_xlnx_drm_hdmi_connector_state(state)->hdcp_content_type = (u32)val;
 	else
 		return -EINVAL;
 
@@ -1059,20 +1986,63 @@ static int xlnx_drm_hdmi_get_property(struct drm_connector *connector,
 		*val = xhdmi->out_fmt_prop_val;
 	else if (property == xhdmi->aspect_ratio)
 		*val = xhdmi->aspect_ratio_prop_val;
+	else if (property == xhdmi->hdcp_content_type)
+		/* the type in effect, a rejected request is not reported */
+		*val = xhdmi->hdcp_content_type_val;
 	else
 		return -EINVAL;
 
 	return 0;
 }
 
+static void xlnx_drm_hdmi_connector_reset(struct drm_connector *connector)
+{
+	struct xlnx_drm_hdmi_connector_state *state;
+
+	if (connector->state) {
+		__drm_atomic_helper_connector_destroy_state(connector->state);
+		kfree(to_xlnx_drm_hdmi_connector_state(connector->state));
+		connector->state = NULL;
+	}
+
+	state = kzalloc(sizeof(*state), GFP_KERNEL);
+	if (state)
+		__drm_atomic_helper_connector_reset(connector, &state->base);
+}
+
+static struct drm_connector_state *
+xlnx_drm_hdmi_connector_duplicate_state(struct drm_connector *connector)
+{
+	struct xlnx_drm_hdmi_connector_state *state;
+
+	if (WARN_ON(!connector->state))
+		return NULL;
+
+	state = kmemdup(to_xlnx_drm_hdmi_connector_state(connector->state),
+			sizeof(*state), GFP_KERNEL);
+	if (!state)
+		return NULL;
+	__drm_atomic_helper_connector_duplicate_state(connector, &state->base);
+	state->retime = false;
+
+	return &state->base;
+}
+
+static void xlnx_drm_hdmi_connector_destroy_state(struct drm_connector *connector,
+						  struct drm_connector_state *state)
+{
+	__drm_atomic_helper_connector_destroy_state(state);
+	kfree(to_xlnx_drm_hdmi_connector_state(state));
+}
+
 static const struct drm_connector_funcs xlnx_drm_hdmi_connector_funcs = {
 //	.dpms			= drm_helper_connector_dpms,
 	.detect			= xlnx_drm_hdmi_connector_detect,
 	.fill_modes		= drm_helper_probe_single_connector_modes,
 	.destroy		= xlnx_drm_hdmi_connector_destroy,
-	.atomic_duplicate_state	= drm_atomic_helper_connector_duplicate_state,
-	.atomic_destroy_state	= drm_atomic_helper_connector_destroy_state,
-	.reset			= drm_atomic_helper_connector_reset,
+	.atomic_duplicate_state	= xlnx_drm_hdmi_connector_duplicate_state,
+	.atomic_destroy_state	= xlnx_drm_hdmi_connector_destroy_state,
+	.reset			= xlnx_drm_hdmi_connector_reset,
 	.atomic_set_property = xlnx_drm_hdmi_set_property,
 	.atomic_get_property = xlnx_drm_hdmi_get_property,
 };
@@ -1081,8 +2051,7 @@ static int xlnx_drm_hdmi_connector_mode_valid(struct drm_connector *connector,
 				    struct drm_display_mode *mode)
 {
 	struct xlnx_drm_hdmi *xhdmi = connector_to_hdmi(connector);
-	int max_rate = 340 * 1000;
-	enum drm_mode_status status = MODE_OK;
+	enum drm_mode_status status;
 
 	dev_dbg(xhdmi->dev, "%s\n", __func__);
 
@@ -1097,13 +2066,12 @@ static int xlnx_drm_hdmi_connector_mode_valid(struct drm_connector *connector,
 
 	drm_mode_debug_printmodeline(mode);
 	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
-	/* HDMI 2.0 sink connected? */
-	if (xhdmi->is_hdmi_20_sink)
-		max_rate = 600 * 1000;
-	/* pixel clock too high for sink? */
-	if (mode->clock > max_rate)
-		status = MODE_CLOCK_HIGH;
+	/* RGB 8 bpc is the least demanding format offered for a mode */
+	status = xlnx_drm_hdmi_mode_status(xhdmi, mode, XVIDC_CSF_RGB,
+					   XVIDC_BPC_8);
 	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+	if (status != MODE_OK)
+		dev_dbg(xhdmi->dev, "mode rejected: %d\n", status);
 	return status;
 }
 
@@ -1159,10 +2127,36 @@ xlnx_drm_hdmi_connector_best_encoder(struct drm_connector *connector)
 	return &xhdmi->encoder;
 }
 
+/* reject an HDCP content stream type the authenticated link cannot carry */
+static int xlnx_drm_hdmi_connector_atomic_check(struct drm_connector *connector,
+						struct drm_atomic_state *state)
+{
+	struct xlnx_drm_hdmi *xhdmi = connector_to_hdmi(connector);
+	struct drm_connector_state *old_state =
+		drm_atomic_get_old_connector_state(state, connector);
+	struct drm_connector_state *new_state =
+		drm_atomic_get_new_connector_state(state, connector);
+	u32 type;
+
+	if (!xhdmi->hdcp_content_type || !new_state)
+		return 0;
+	type = to_xlnx_drm_hdmi_connector_state(new_state)->hdcp_content_type;
+	/* only a changed type is checked, the link may change after a commit */
+	if (old_state &&
+	    type == to_xlnx_drm_hdmi_connector_state(old_state)->hdcp_content_type)
+		return 0;
+	if (!xlnx_drm_hdmi_hdcp_content_type_allowed(xhdmi, type)) {
+		dev_dbg(xhdmi->dev, "HDCP content type %u not allowed\n", type);
+		return -EINVAL;
+	}
+	return 0;
+}
+
 static struct drm_connector_helper_funcs xlnx_drm_hdmi_connector_helper_funcs = {
 	.get_modes		= xlnx_drm_hdmi_connector_get_modes,
 	.best_encoder	= xlnx_drm_hdmi_connector_best_encoder,
 	.mode_valid		= xlnx_drm_hdmi_connector_mode_valid,
+	.atomic_check		= xlnx_drm_hdmi_connector_atomic_check,
 };
 
 /*
@@ -1383,103 +2377,26 @@ static void xlnx_drm_hdmi_set_colorimetry(struct xlnx_drm_hdmi *xhdmi)
 }
 
 /**
- * xlnx_drm_hdmi_encoder_atomic_mode_set -  drive the HDMI timing parameters
+ * xlnx_drm_hdmi_set_stream - derive the HDMI TX stream from a mode
  *
- * @encoder: pointer to Xilinx DRM encoder
- * @crtc_state: DRM crtc state
- * @connector_state: DRM connector state
+ * @xhdmi: pointer to HDMI TX
+ * @mode: mode to set, in the color format and depth selected by
+ *	hdmitx_find_media_bus()
  *
- * This function derives the HDMI IP timing parameters from the timing
- * values given to timing module.
+ * Sets the video timing, the stream and the AVI infoframe of the TX
+ * subsystem. Called with hdmi_mutex held.
+ *
+ * Return: TMDS clock of the stream in Hz, 0 if it cannot be set
  */
-static void xlnx_drm_hdmi_encoder_atomic_mode_set(struct drm_encoder *encoder,
-				  struct drm_crtc_state *crtc_state,
-				  struct drm_connector_state *connector_state)
+static u32 xlnx_drm_hdmi_set_stream(struct xlnx_drm_hdmi *xhdmi,
+				    struct drm_display_mode *mode)
 {
-	struct xlnx_drm_hdmi *xhdmi = encoder_to_hdmi(encoder);
-	struct drm_display_mode *mode = &crtc_state->mode;
-	struct drm_display_mode *adjusted_mode = &crtc_state->adjusted_mode;
-
-	XVidC_VideoTiming vt;
-	XVphy *VphyPtr;
-	XHdmiphy1 *XGtPhyPtr;
-	XV_HdmiTxSs *HdmiTxSsPtr;
+	XV_HdmiTxSs *HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
 	XVidC_VideoStream *HdmiTxSsVidStreamPtr;
 	XHdmiC_AVI_InfoFrame *AviInfoFramePtr;
 	XHdmiC_VSIF *VSIFPtr;
-	u32 TmdsClock = 0;
-	u32 PrevPhyTxRefClock = 0;
-	u32 Result;
-	u32 drm_fourcc;
-	int ret;
-	int i, frame_rate;
-	XVidC_VideoMode vic_id = 0;
-	XHdmiC_VicTable const *entry;
-
-	dev_dbg(xhdmi->dev,"%s\n", __func__);
-	HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
-
-	VphyPtr = xhdmi->xvphy;
-	XGtPhyPtr = xhdmi->xgtphy;
-
-	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
-	xvphy_mutex_lock(xhdmi->phy[0]);
-	drm_mode_debug_printmodeline(mode);
-
-	drm_fourcc = encoder->crtc->primary->state->fb->format->format;
-	xhdmi->xvidc_colorfmt = hdmitx_find_media_bus(xhdmi, drm_fourcc);
-	dev_dbg(xhdmi->dev,"xvidc_colorfmt = %d\n", xhdmi->xvidc_colorfmt);
-	dev_dbg(xhdmi->dev,"xvidc_colordepth = %d\n", xhdmi->xvidc_colordepth);
-
-	dev_dbg(xhdmi->dev,"mode->clock = %d\n", mode->clock * 1000);
-	dev_dbg(xhdmi->dev,"mode->crtc_clock = %d\n", mode->crtc_clock * 1000);
-	dev_dbg(xhdmi->dev,"mode->pvsync = %d\n",
-		!!(mode->flags & DRM_MODE_FLAG_PVSYNC));
-	dev_dbg(xhdmi->dev,"mode->phsync = %d\n",
-		!!(mode->flags & DRM_MODE_FLAG_PHSYNC));
-	dev_dbg(xhdmi->dev,"mode->hsync_end = %d\n", mode->hsync_end);
-	dev_dbg(xhdmi->dev,"mode->hsync_start = %d\n", mode->hsync_start);
-	dev_dbg(xhdmi->dev,"mode->vsync_end = %d\n", mode->vsync_end);
-	dev_dbg(xhdmi->dev,"mode->vsync_start = %d\n", mode->vsync_start);
-	dev_dbg(xhdmi->dev,"mode->hdisplay = %d\n", mode->hdisplay);
-	dev_dbg(xhdmi->dev,"mode->vdisplay = %d\n", mode->vdisplay);
-	dev_dbg(xhdmi->dev,"mode->htotal = %d\n", mode->htotal);
-	dev_dbg(xhdmi->dev,"mode->vtotal = %d\n", mode->vtotal);
-	dev_dbg(xhdmi->dev,"vrefresh = %d\n", drm_mode_vrefresh(mode));
-	dev_dbg(xhdmi->dev,"mode->flags = %d interlace = %d\n", mode->flags,
-			!!(mode->flags & DRM_MODE_FLAG_INTERLACE));
-
-	/* Set bridge input and output parameters */
-	if (xhdmi->bridge) {
-		xlnx_bridge_set_input(xhdmi->bridge, adjusted_mode->hdisplay,
-				      adjusted_mode->vdisplay,
-				      xhdmi->in_fmt_prop_val);
-		xlnx_bridge_set_output(xhdmi->bridge, xhdmi->width_out_prop_val,
-				       xhdmi->height_out_prop_val,
-				       xhdmi->out_fmt_prop_val);
-		xlnx_bridge_enable(xhdmi->bridge);
-
-		frame_rate = drm_mode_vrefresh(adjusted_mode);
-
-		for (i = 0; i < VICTABLE_SIZE; i++) {
-			entry = &VicTable[i];
-			if (entry->Width == xhdmi->width_out_prop_val &&
-			    entry->Height == xhdmi->height_out_prop_val &&
-			    entry->AspectRatio == xhdmi->aspect_ratio_prop_val &&
-			    entry->FrameRate == frame_rate) {
-				vic_id = entry->Vic;
-				break;
-			}
-
-		}
-
-		if (vic_id){
-			mode = drm_display_mode_from_cea_vic(encoder->dev, vic_id);
-		} else {
-			dev_err(xhdmi->dev, "Unsupported Vic Id %d\n", vic_id);
-			return;
-		}
-	}
+	XVidC_VideoTiming vt;
+	u32 TmdsClock;
 
 	/* see slide 20 of http://events.linuxfoundation.org/sites/events/files/slides/brezillon-drm-kms.pdf */
 	vt.HActive = mode->hdisplay;
@@ -1541,74 +2458,177 @@ static void xlnx_drm_hdmi_encoder_atomic_mode_set(struct drm_encoder *encoder,
 	// Reset Vendor Specific InfoFrame
 	(void)memset((void *)VSIFPtr, 0, sizeof(XHdmiC_VSIF));
 
-	if (xhdmi->isvphy) {
-		/* Get current Tx Ref clock from PHY */
-		PrevPhyTxRefClock = VphyPtr->HdmiTxRefClkHz;
+	/* The isExtensive is made true to get the correct video timing by matching
+	 * all the parameters */
+	HdmiTxSsVidStreamPtr->VmId = XVidC_GetVideoModeIdExtensive(&vt,
+			drm_mode_vrefresh(mode), (u8)!!(mode->flags & DRM_MODE_FLAG_INTERLACE), (u8)TRUE);
+
+	dev_dbg(xhdmi->dev,"VmId = %d Interlaced = %d\n", HdmiTxSsVidStreamPtr->VmId, !!(mode->flags & DRM_MODE_FLAG_INTERLACE));
+	if (HdmiTxSsVidStreamPtr->VmId == XVIDC_VM_NOT_SUPPORTED) { //no match found in timing table
+		dev_dbg(xhdmi->dev,"Tx Video Mode not supported. Using DRM Timing\n");
+		HdmiTxSsVidStreamPtr->VmId = XVIDC_VM_CUSTOM;
+		HdmiTxSsVidStreamPtr->FrameRate = (XVidC_FrameRate)drm_mode_vrefresh(mode);
+		HdmiTxSsVidStreamPtr->Timing = vt; //overwrite with drm detected timing
+		HdmiTxSsVidStreamPtr->IsInterlaced = (!!(mode->flags & DRM_MODE_FLAG_INTERLACE));
+#ifdef DEBUG
+		XVidC_ReportTiming(&HdmiTxSsVidStreamPtr->Timing, (u8)!!(mode->flags & DRM_MODE_FLAG_INTERLACE));
+#endif
+	}
+
+	/* The value of xvidc_colordepth is set by calling hdmitx_find_media_bus()
+	 * API earlier in this function. Check whether the value is valid or not */
+	if (XVIDC_BPC_UNKNOWN == xhdmi->xvidc_colordepth)
+		xhdmi->xvidc_colordepth = (XVidC_ColorDepth)HdmiTxSsPtr->Config.MaxBitsPerPixel;
+
+	/* check if resolution is supported at requested bit depth */
+	switch (xhdmi->xvidc_colorfmt) {
+		case XVIDC_CSF_RGB:
+		case XVIDC_CSF_YCRCB_444:
+			if ((xhdmi->xvidc_colordepth > XVIDC_BPC_8) &&
+				(mode->hdisplay >= 3840) &&
+				(mode->vdisplay >= 2160) &&
+				(drm_mode_vrefresh(mode) >= XVIDC_FR_50HZ)) {
+					dev_dbg(xhdmi->dev,"INFO> UHD only supports 24-bits color depth\n");
+					xhdmi->xvidc_colordepth = XVIDC_BPC_8;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	TmdsClock = XV_HdmiTxSs_SetStream(HdmiTxSsPtr, HdmiTxSsVidStreamPtr->VmId, xhdmi->xvidc_colorfmt,
+			xhdmi->xvidc_colordepth, NULL);
+
+	//Update AVI InfoFrame
+	AviInfoFramePtr->Version = 2;
+	AviInfoFramePtr->ColorSpace = XV_HdmiC_XVidC_To_IfColorformat(xhdmi->xvidc_colorfmt);
+	AviInfoFramePtr->VIC = HdmiTxSsPtr->HdmiTxPtr->Stream.Vic;
+	xlnx_drm_hdmi_set_colorimetry(xhdmi);
+
+	if ( (HdmiTxSsVidStreamPtr->VmId == XVIDC_VM_1440x480_60_I) ||
+			(HdmiTxSsVidStreamPtr->VmId == XVIDC_VM_1440x576_50_I) ) {
+		AviInfoFramePtr->PixelRepetition = XHDMIC_PIXEL_REPETITION_FACTOR_2;
+	} else {
+		AviInfoFramePtr->PixelRepetition = XHDMIC_PIXEL_REPETITION_FACTOR_1;
+	}
+
+	return TmdsClock;
+}
+
+/**
+ * xlnx_drm_hdmi_encoder_atomic_mode_set -  drive the HDMI timing parameters
+ *
+ * @encoder: pointer to Xilinx DRM encoder
+ * @crtc_state: DRM crtc state
+ * @connector_state: DRM connector state
+ *
+ * This function derives the HDMI IP timing parameters from the timing
+ * values given to timing module.
+ */
+static void xlnx_drm_hdmi_encoder_atomic_mode_set(struct drm_encoder *encoder,
+				  struct drm_crtc_state *crtc_state,
+				  struct drm_connector_state *connector_state)
+{
+	struct xlnx_drm_hdmi *xhdmi = encoder_to_hdmi(encoder);
+	struct drm_display_mode *mode = &crtc_state->mode;
+	struct drm_display_mode *adjusted_mode = &crtc_state->adjusted_mode;
+
+	XVphy *VphyPtr;
+	XHdmiphy1 *XGtPhyPtr;
+	XV_HdmiTxSs *HdmiTxSsPtr;
+	XVidC_VideoStream *HdmiTxSsVidStreamPtr;
+	u32 TmdsClock = 0;
+	u32 PrevPhyTxRefClock = 0;
+	u32 Result;
+	u32 drm_fourcc;
+	int ret;
+	int i, frame_rate;
+	XVidC_VideoMode vic_id = 0;
+	XHdmiC_VicTable const *entry;
+
+	dev_dbg(xhdmi->dev,"%s\n", __func__);
+	HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
+
+	VphyPtr = xhdmi->xvphy;
+	XGtPhyPtr = xhdmi->xgtphy;
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	xvphy_mutex_lock(xhdmi->phy[0]);
+	atomic64_inc(&xhdmi->stats.modeset);
+	xhdmi->modeset_start = ktime_get();
+	drm_mode_debug_printmodeline(mode);
+
+	drm_fourcc = encoder->crtc->primary->state->fb->format->format;
+	xhdmi->xvidc_colorfmt = hdmitx_find_media_bus(xhdmi, drm_fourcc);
+	dev_dbg(xhdmi->dev,"xvidc_colorfmt = %d\n", xhdmi->xvidc_colorfmt);
+	dev_dbg(xhdmi->dev,"xvidc_colordepth = %d\n", xhdmi->xvidc_colordepth);
+
+	dev_dbg(xhdmi->dev,"mode->clock = %d\n", mode->clock * 1000);
+	dev_dbg(xhdmi->dev,"mode->crtc_clock = %d\n", mode->crtc_clock * 1000);
+	dev_dbg(xhdmi->dev,"mode->pvsync = %d\n",
+		!!(mode->flags & DRM_MODE_FLAG_PVSYNC));
+	dev_dbg(xhdmi->dev,"mode->phsync = %d\n",
+		!!(mode->flags & DRM_MODE_FLAG_PHSYNC));
+	dev_dbg(xhdmi->dev,"mode->hsync_end = %d\n", mode->hsync_end);
+	dev_dbg(xhdmi->dev,"mode->hsync_start = %d\n", mode->hsync_start);
+	dev_dbg(xhdmi->dev,"mode->vsync_end = %d\n", mode->vsync_end);
+	dev_dbg(xhdmi->dev,"mode->vsync_start = %d\n", mode->vsync_start);
+	dev_dbg(xhdmi->dev,"mode->hdisplay = %d\n", mode->hdisplay);
+	dev_dbg(xhdmi->dev,"mode->vdisplay = %d\n", mode->vdisplay);
+	dev_dbg(xhdmi->dev,"mode->htotal = %d\n", mode->htotal);
+	dev_dbg(xhdmi->dev,"mode->vtotal = %d\n", mode->vtotal);
+	dev_dbg(xhdmi->dev,"vrefresh = %d\n", drm_mode_vrefresh(mode));
+	dev_dbg(xhdmi->dev,"mode->flags = %d interlace = %d\n", mode->flags,
+			!!(mode->flags & DRM_MODE_FLAG_INTERLACE));
+
+	/* Set bridge input and output parameters */
+	if (xhdmi->bridge) {
+		xlnx_bridge_set_input(xhdmi->bridge, adjusted_mode->hdisplay,
+				      adjusted_mode->vdisplay,
+				      xhdmi->in_fmt_prop_val);
+		xlnx_bridge_set_output(xhdmi->bridge, xhdmi->width_out_prop_val,
+				       xhdmi->height_out_prop_val,
+				       xhdmi->out_fmt_prop_val);
+		xlnx_bridge_enable(xhdmi->bridge);
 
-		/* Disable TX TDMS clock */
-		XVphy_Clkout1OBufTdsEnable(VphyPtr, XVPHY_DIR_TX, (FALSE));
-	} else {
-		/* Get current Tx Ref clock from PHY */
-		PrevPhyTxRefClock = XGtPhyPtr->HdmiTxRefClkHz;
+		frame_rate = drm_mode_vrefresh(adjusted_mode);
 
-		/* Disable TX TDMS clock */
-		XHdmiphy1_Clkout1OBufTdsEnable(XGtPhyPtr, XHDMIPHY1_DIR_TX, (FALSE));
-	}
+		for (i = 0; i < VICTABLE_SIZE; i++) {
+			entry = &VicTable[i];
+			if (entry->Width == xhdmi->width_out_prop_val &&
+			    entry->Height == xhdmi->height_out_prop_val &&
+			    entry->AspectRatio == xhdmi->aspect_ratio_prop_val &&
+			    entry->FrameRate == frame_rate) {
+				vic_id = entry->Vic;
+				break;
+			}
 
-	/* The isExtensive is made true to get the correct video timing by matching
-	 * all the parameters */
-	HdmiTxSsVidStreamPtr->VmId = XVidC_GetVideoModeIdExtensive(&vt,
-			drm_mode_vrefresh(mode), (u8)!!(mode->flags & DRM_MODE_FLAG_INTERLACE), (u8)TRUE);
+		}
 
-	dev_dbg(xhdmi->dev,"VmId = %d Interlaced = %d\n", HdmiTxSsVidStreamPtr->VmId, !!(mode->flags & DRM_MODE_FLAG_INTERLACE));
-	if (HdmiTxSsVidStreamPtr->VmId == XVIDC_VM_NOT_SUPPORTED) { //no match found in timing table
-		dev_dbg(xhdmi->dev,"Tx Video Mode not supported. Using DRM Timing\n");
-		HdmiTxSsVidStreamPtr->VmId = XVIDC_VM_CUSTOM;
-		HdmiTxSsVidStreamPtr->FrameRate = (XVidC_FrameRate)drm_mode_vrefresh(mode);
-		HdmiTxSsVidStreamPtr->Timing = vt; //overwrite with drm detected timing
-		HdmiTxSsVidStreamPtr->IsInterlaced = (!!(mode->flags & DRM_MODE_FLAG_INTERLACE));
-#ifdef DEBUG
-		XVidC_ReportTiming(&HdmiTxSsVidStreamPtr->Timing, (u8)!!(mode->flags & DRM_MODE_FLAG_INTERLACE));
-#endif
+		if (vic_id){
+			mode = drm_display_mode_from_cea_vic(encoder->dev, vic_id);
+		} else {
+			dev_err(xhdmi->dev, "Unsupported Vic Id %d\n", vic_id);
+			return;
+		}
 	}
 
-	/* The value of xvidc_colordepth is set by calling hdmitx_find_media_bus()
-	 * API earlier in this function. Check whether the value is valid or not */
-	if (XVIDC_BPC_UNKNOWN == xhdmi->xvidc_colordepth)
-		xhdmi->xvidc_colordepth = (XVidC_ColorDepth)HdmiTxSsPtr->Config.MaxBitsPerPixel;
-
-	/* check if resolution is supported at requested bit depth */
-	switch (xhdmi->xvidc_colorfmt) {
-		case XVIDC_CSF_RGB:
-		case XVIDC_CSF_YCRCB_444:
-			if ((xhdmi->xvidc_colordepth > XVIDC_BPC_8) &&
-				(mode->hdisplay >= 3840) &&
-				(mode->vdisplay >= 2160) &&
-				(drm_mode_vrefresh(mode) >= XVIDC_FR_50HZ)) {
-					dev_dbg(xhdmi->dev,"INFO> UHD only supports 24-bits color depth\n");
-					xhdmi->xvidc_colordepth = XVIDC_BPC_8;
-			}
-			break;
-
-		default:
-			break;
-	}
+	HdmiTxSsVidStreamPtr = XV_HdmiTxSs_GetVideoStream(HdmiTxSsPtr);
 
-	TmdsClock = XV_HdmiTxSs_SetStream(HdmiTxSsPtr, HdmiTxSsVidStreamPtr->VmId, xhdmi->xvidc_colorfmt,
-			xhdmi->xvidc_colordepth, NULL);
+	/* Get current Tx Ref clock from PHY */
+	if (xhdmi->isvphy)
+		PrevPhyTxRefClock = VphyPtr->HdmiTxRefClkHz;
+	else
+		PrevPhyTxRefClock = XGtPhyPtr->HdmiTxRefClkHz;
 
-	//Update AVI InfoFrame
-	AviInfoFramePtr->Version = 2;
-	AviInfoFramePtr->ColorSpace = XV_HdmiC_XVidC_To_IfColorformat(xhdmi->xvidc_colorfmt);
-	AviInfoFramePtr->VIC = HdmiTxSsPtr->HdmiTxPtr->Stream.Vic;
-	xlnx_drm_hdmi_set_colorimetry(xhdmi);
+	TmdsClock = xlnx_drm_hdmi_set_stream(xhdmi, mode);
 
-	if ( (HdmiTxSsVidStreamPtr->VmId == XVIDC_VM_1440x480_60_I) ||
-			(HdmiTxSsVidStreamPtr->VmId == XVIDC_VM_1440x576_50_I) ) {
-		AviInfoFramePtr->PixelRepetition = XHDMIC_PIXEL_REPETITION_FACTOR_2;
-	} else {
-		AviInfoFramePtr->PixelRepetition = XHDMIC_PIXEL_REPETITION_FACTOR_1;
-	}
+	/* Disable TX TDMS clock */
+	if (xhdmi->isvphy)
+		XVphy_Clkout1OBufTdsEnable(VphyPtr, XVPHY_DIR_TX, (FALSE));
+	else
+		XHdmiphy1_Clkout1OBufTdsEnable(XGtPhyPtr, XHDMIPHY1_DIR_TX, (FALSE));
 
 	// Set TX reference clock
 	if (xhdmi->isvphy)
@@ -1641,6 +2661,13 @@ static void xlnx_drm_hdmi_encoder_atomic_mode_set(struct drm_encoder *encoder,
 	}
 	if (Result == (XST_FAILURE)) {
 		dev_dbg(xhdmi->dev,"Unable to set requested TX video resolution.\n\r");
+		/* no GT PLL solution, do not accept this mode in this color
+		 * format and depth again */
+		xlnx_drm_hdmi_mode_cache_store(xhdmi, &crtc_state->mode,
+					       HdmiTxSsVidStreamPtr->ColorFormatId,
+					       HdmiTxSsVidStreamPtr->ColorDepth,
+					       MODE_CLOCK_RANGE);
+		xhdmi->modeset_start = 0;
 		xvphy_mutex_unlock(xhdmi->phy[0]);
 		hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
 		return;
@@ -1695,17 +2722,267 @@ static void xlnx_drm_hdmi_encoder_atomic_mode_set(struct drm_encoder *encoder,
 		xhdmi->tx_audio_data->tmds_clk_ratio = false;
 	}
 
+	/* Do not stall the commit until the stream is up, TxStreamUpCallback
+	 * completes streamup_done and the outcome is reported to user space
+	 * through the connector link-status by xlnx_drm_hdmi_streamup_work() */
+	reinit_completion(&xhdmi->streamup_done);
+	mod_delayed_work(system_wq, &xhdmi->streamup_work,
+			 msecs_to_jiffies(XHDMI_STREAMUP_TIMEOUT_MS));
+	xlnx_hdmi_hist_add(&xhdmi->stats.modeset_us, xhdmi->modeset_start);
+
 	xvphy_mutex_unlock(xhdmi->phy[0]);
 	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
 
-	xhdmi->wait_for_streamup = 0;
-	wait_event_timeout(xhdmi->wait_event, xhdmi->wait_for_streamup, msecs_to_jiffies(10000));
-	if (!xhdmi->wait_for_streamup)
-		dev_dbg(xhdmi->dev, "wait_for_streamup timeout\n");
 	/* Keep SYS_RST asserted */
 	XV_HdmiTxSs_SYSRST(HdmiTxSsPtr, TRUE);
 }
 
+/* tells if two pixel or TMDS clocks are the same within XHDMI_RETIME_CLOCK_PPM */
+static bool xlnx_drm_hdmi_same_clock(u64 clock, u64 ref)
+{
+	u64 diff = clock > ref ? clock - ref : ref - clock;
+
+	return diff * 1000000 <= ref * XHDMI_RETIME_CLOCK_PPM;
+}
+
+/**
+ * xlnx_drm_hdmi_retime - apply a mode that keeps the link of the stream
+ *
+ * @xhdmi: pointer to HDMI TX
+ * @mode: mode to apply
+ * @drm_fourcc: format of the scanned out framebuffer
+ *
+ * Applies the timing of a mode with the TMDS clock, color format and depth
+ * and pixels per clock of the running stream. The PHY, the TMDS clock and
+ * the TX core keep running, only the VTC and the video bridge are
+ * reprogrammed. Called with hdmi_mutex held.
+ *
+ * Return: 0 on success, -EAGAIN if the link has to be set up again
+ */
+static int xlnx_drm_hdmi_retime(struct xlnx_drm_hdmi *xhdmi,
+				struct drm_display_mode *mode, u32 drm_fourcc)
+{
+	XV_HdmiTxSs *HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
+	XVidC_VideoStream *HdmiTxSsVidStreamPtr =
+		XV_HdmiTxSs_GetVideoStream(HdmiTxSsPtr);
+	XVidC_VideoStream PrevStream = *HdmiTxSsVidStreamPtr;
+	u32 PrevTmdsClock = HdmiTxSsPtr->HdmiTxPtr->Stream.TMDSClock;
+	u8 PrevTmdsClockRatio = HdmiTxSsPtr->HdmiTxPtr->Stream.TMDSClockRatio;
+	ktime_t start = ktime_get();
+	u32 TmdsClock;
+
+	if (!xhdmi->hdmi_stream_up)
+		return -EAGAIN;
+	atomic64_inc(&xhdmi->stats.modeset);
+	drm_mode_debug_printmodeline(mode);
+
+	xhdmi->xvidc_colorfmt = hdmitx_find_media_bus(xhdmi, drm_fourcc);
+	TmdsClock = xlnx_drm_hdmi_set_stream(xhdmi, mode);
+	if (!TmdsClock || !xlnx_drm_hdmi_same_clock(TmdsClock, PrevTmdsClock) ||
+	    HdmiTxSsPtr->HdmiTxPtr->Stream.TMDSClockRatio != PrevTmdsClockRatio ||
+	    HdmiTxSsVidStreamPtr->ColorFormatId != PrevStream.ColorFormatId ||
+	    HdmiTxSsVidStreamPtr->ColorDepth != PrevStream.ColorDepth ||
+	    HdmiTxSsVidStreamPtr->PixPerClk != PrevStream.PixPerClk)
+		goto restore;
+	/* the link keeps running at its clock */
+	HdmiTxSsPtr->HdmiTxPtr->Stream.TMDSClock = PrevTmdsClock;
+
+	/* the AVI infoframe is sent on the next vsync */
+	if (XV_HdmiTxSs_UpdateVideoTiming(HdmiTxSsPtr) != XST_SUCCESS)
+		goto restore;
+
+	dev_dbg(xhdmi->dev, "seamless switch, TmdsClock = %u\n", PrevTmdsClock);
+	atomic64_inc(&xhdmi->stats.modeset_fast);
+	xlnx_hdmi_hist_add(&xhdmi->stats.modeset_us, start);
+	return 0;
+
+restore:
+	/* describe the running link until the mode is set again */
+	*HdmiTxSsVidStreamPtr = PrevStream;
+	HdmiTxSsPtr->HdmiTxPtr->Stream.TMDSClock = PrevTmdsClock;
+	HdmiTxSsPtr->HdmiTxPtr->Stream.TMDSClockRatio = PrevTmdsClockRatio;
+	return -EAGAIN;
+}
+
+/*
+ * Applies the timing-only mode change of the committed connector state, see
+ * xlnx_drm_hdmi_check_retime(). The encoder has no commit hook outside of a
+ * mode set, so the committed state is picked up here. Each committed state
+ * is looked at once. When the link cannot keep running, its link-status goes
+ * bad so that user space sets the mode again, with a mode set.
+ */
+static void xlnx_drm_hdmi_retime_work(struct work_struct *work)
+{
+	struct xlnx_drm_hdmi *xhdmi = container_of(work, struct xlnx_drm_hdmi,
+						   retime_work);
+	struct drm_connector *connector = &xhdmi->connector;
+	const struct drm_connector_state *state;
+	struct xlnx_drm_hdmi_connector_state *xstate;
+	struct drm_modeset_lock *lock;
+	struct drm_display_mode mode;
+	bool retime = false;
+	u32 drm_fourcc = 0;
+	int ret;
+
+	if (!connector->dev)
+		return;
+
+	/* connector->state is swapped under the connection mutex, which the
+	 * commit that scheduled this work holds until its state is swapped */
+	lock = &connector->dev->mode_config.connection_mutex;
+	if (drm_modeset_lock(lock, NULL))
+		return;
+	state = connector->state;
+	if (state && state != xhdmi->retime_state) {
+		xhdmi->retime_state = state;
+		xstate = to_xlnx_drm_hdmi_connector_state(state);
+		retime = xstate->retime;
+		if (retime) {
+			drm_mode_copy(&mode, &xstate->retime_mode);
+			drm_fourcc = xstate->retime_fourcc;
+		}
+	}
+	drm_modeset_unlock(lock);
+	if (!retime)
+		return;
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	ret = xlnx_drm_hdmi_retime(xhdmi, &mode, drm_fourcc);
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+	if (!ret)
+		return;
+
+	dev_dbg(xhdmi->dev, "seamless switch failed, mode set required\n");
+	xhdmi->link_status = DRM_MODE_LINK_STATUS_BAD;
+	drm_connector_set_link_status_property(connector,
+					       DRM_MODE_LINK_STATUS_BAD);
+	drm_sysfs_hotplug_event(connector->dev);
+}
+
+/*
+ * A mode that keeps the active size, the pixel clock within
+ * XHDMI_RETIME_CLOCK_PPM and the framebuffer format of the running stream
+ * only changes its timing. The mode set is skipped, so the CRTC, the encoder
+ * and the link stay enabled, and xlnx_drm_hdmi_retime_work() reprograms the
+ * VTC once the state is committed. This needs the VTC of the AXI4-Stream
+ * video interface, which generates the timing of the stream itself.
+ */
+static void xlnx_drm_hdmi_check_retime(struct xlnx_drm_hdmi *xhdmi,
+				       struct drm_crtc_state *crtc_state,
+				       struct drm_connector_state *conn_state,
+				       struct drm_plane_state *plane_state)
+{
+	struct xlnx_drm_hdmi_connector_state *xstate =
+		to_xlnx_drm_hdmi_connector_state(conn_state);
+	struct drm_crtc *crtc = crtc_state->crtc;
+	struct drm_display_mode *mode = &crtc_state->mode;
+	struct drm_crtc_state *old_crtc_state;
+	struct drm_plane_state *old_plane_state;
+	struct drm_framebuffer *old_fb;
+	struct drm_display_mode *old_mode;
+	bool stream_up;
+
+	if (!xhdmi->config.Vtc.IsPresent || xhdmi->bridge ||
+	    !crtc_state->active || !crtc_state->mode_changed ||
+	    crtc_state->active_changed || crtc_state->connectors_changed ||
+	    !plane_state || !plane_state->fb)
+		return;
+
+	old_crtc_state = drm_atomic_get_old_crtc_state(crtc_state->state, crtc);
+	if (!old_crtc_state || !old_crtc_state->active)
+		return;
+	old_plane_state = drm_atomic_get_old_plane_state(crtc_state->state,
+							 crtc->primary);
+	old_fb = old_plane_state ? old_plane_state->fb : plane_state->fb;
+	old_mode = &old_crtc_state->mode;
+	if (!old_fb ||
+	    old_fb->format->format != plane_state->fb->format->format ||
+	    mode->hdisplay != old_mode->hdisplay ||
+	    mode->vdisplay != old_mode->vdisplay ||
+	    ((mode->flags ^ old_mode->flags) &
+	     (DRM_MODE_FLAG_INTERLACE | DRM_MODE_FLAG_DBLCLK)) ||
+	    !xlnx_drm_hdmi_same_clock(mode->clock, old_mode->clock))
+		return;
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	stream_up = xhdmi->hdmi_stream_up;
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+	if (!stream_up)
+		return;
+
+	crtc_state->mode_changed = false;
+	xstate->retime = true;
+	drm_mode_copy(&xstate->retime_mode, mode);
+	xstate->retime_fourcc = plane_state->fb->format->format;
+	/* waits for the commit, nothing to do if the state is not committed */
+	schedule_work(&xhdmi->retime_work);
+}
+
+/**
+ * xlnx_drm_hdmi_encoder_atomic_check - reject modes that cannot be set
+ *
+ * @encoder: pointer to Xilinx DRM encoder
+ * @crtc_state: DRM crtc state
+ * @conn_state: DRM connector state
+ *
+ * Consults the per-hotplug feasibility cache and checks the TMDS clock for
+ * the color format and depth of the framebuffer being scanned out, so that
+ * xlnx_drm_hdmi_encoder_atomic_mode_set() does not fail half way. A mode that
+ * keeps the link of the running stream is applied without a mode set.
+ *
+ * Return: 0 on success, -EINVAL if the mode cannot be set
+ */
+static int xlnx_drm_hdmi_encoder_atomic_check(struct drm_encoder *encoder,
+				  struct drm_crtc_state *crtc_state,
+				  struct drm_connector_state *conn_state)
+{
+	struct xlnx_drm_hdmi *xhdmi = encoder_to_hdmi(encoder);
+	struct drm_display_mode *mode = &crtc_state->mode;
+	struct drm_plane *primary = crtc_state->crtc->primary;
+	struct drm_plane_state *plane_state;
+	XVidC_ColorDepth colordepth;
+	XVidC_ColorFormat fmt;
+	XVidC_ColorDepth bpc;
+	enum drm_mode_status status;
+
+	if (!crtc_state->enable || !drm_atomic_crtc_needs_modeset(crtc_state))
+		return 0;
+
+	plane_state = drm_atomic_get_new_plane_state(crtc_state->state, primary);
+	if (!plane_state)
+		plane_state = primary->state;
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	status = xlnx_drm_hdmi_mode_status(xhdmi, mode, XVIDC_CSF_RGB,
+					   XVIDC_BPC_8);
+	if (status == MODE_OK && plane_state && plane_state->fb) {
+		/* same color format and depth selection as atomic_mode_set */
+		colordepth = xhdmi->xvidc_colordepth;
+		fmt = hdmitx_find_media_bus(xhdmi,
+					    plane_state->fb->format->format);
+		bpc = xhdmi->xvidc_colordepth;
+		xhdmi->xvidc_colordepth = colordepth;
+		if (bpc == XVIDC_BPC_UNKNOWN)
+			bpc = (XVidC_ColorDepth)xhdmi->xv_hdmitxss.Config.MaxBitsPerPixel;
+		if ((fmt == XVIDC_CSF_RGB || fmt == XVIDC_CSF_YCRCB_444) &&
+		    bpc > XVIDC_BPC_8 && mode->hdisplay >= 3840 &&
+		    mode->vdisplay >= 2160 &&
+		    drm_mode_vrefresh(mode) >= XVIDC_FR_50HZ)
+			bpc = XVIDC_BPC_8;
+		status = xlnx_drm_hdmi_mode_status(xhdmi, mode, fmt, bpc);
+	}
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+
+	if (status != MODE_OK) {
+		dev_dbg(xhdmi->dev, "%s: mode %s rejected: %d\n", __func__,
+			mode->name, status);
+		return -EINVAL;
+	}
+
+	xlnx_drm_hdmi_check_retime(xhdmi, crtc_state, conn_state, plane_state);
+	return 0;
+}
+
 static const struct drm_encoder_funcs xlnx_drm_hdmi_encoder_funcs = {
 	.destroy = drm_encoder_cleanup,
 };
@@ -1715,8 +2992,158 @@ static const struct drm_encoder_helper_funcs xlnx_drm_hdmi_encoder_helper_funcs
 	.enable				= xlnx_drm_hdmi_encoder_enable,
 	.disable			= xlnx_drm_hdmi_encoder_disable,
 	.atomic_mode_set	= xlnx_drm_hdmi_encoder_atomic_mode_set,
+	.atomic_check		= xlnx_drm_hdmi_encoder_atomic_check,
 };
 
+/* runs when the stream came up or the stream-up time-out expired after a mode
+ * set, and reports the result through the link-status connector property */
+static void xlnx_drm_hdmi_streamup_work(struct work_struct *work)
+{
+	struct xlnx_drm_hdmi *xhdmi = container_of(work, struct xlnx_drm_hdmi,
+		streamup_work.work);
+	struct drm_connector *connector = &xhdmi->connector;
+	int link_status;
+
+	if (completion_done(&xhdmi->streamup_done)) {
+		link_status = DRM_MODE_LINK_STATUS_GOOD;
+	} else if (xhdmi->cable_connected) {
+		dev_dbg(xhdmi->dev, "stream-up timeout\n");
+		atomic64_inc(&xhdmi->stats.streamup_timeout);
+		link_status = DRM_MODE_LINK_STATUS_BAD;
+	} else {
+		return;
+	}
+
+	if (!connector->dev || link_status == xhdmi->link_status)
+		return;
+	xhdmi->link_status = link_status;
+	drm_connector_set_link_status_property(connector, link_status);
+	/* let user space retry the mode set */
+	if (link_status == DRM_MODE_LINK_STATUS_BAD)
+		drm_sysfs_hotplug_event(connector->dev);
+}
+
+/* reads the SCDC status of an HDMI 2.0 sink while the stream is up, accounts
+ * the character errors and rewrites the TMDS config when the sink lost it,
+ * e.g. after its receiver was power cycled without a hotplug */
+static void xlnx_drm_hdmi_scdc_mon_work(struct work_struct *work)
+{
+	struct xlnx_drm_hdmi *xhdmi = container_of(work, struct xlnx_drm_hdmi,
+		scdc_mon_work.work);
+	XV_HdmiTx *HdmiTxPtr = xhdmi->xv_hdmitxss.HdmiTxPtr;
+	XV_HdmiTx_ScdcStatus status;
+	unsigned long now = jiffies;
+	unsigned int elapsed_ms, delta, delay, i;
+	bool stable;
+	u8 tmds_config;
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	if (xhdmi->teardown || !xhdmi->hdmi_stream_up ||
+	    !HdmiTxPtr->Stream.IsConnected || !HdmiTxPtr->Stream.IsHdmi20)
+		goto out;
+
+	/* only read on request of the sink, or to confirm a mismatch, with a
+	 * status read now and then in case a request was missed */
+	if (xhdmi->scdc_rr_enabled) {
+		if (XV_HdmiTx_DdcIsReadRequest(HdmiTxPtr))
+			atomic64_inc(&xhdmi->stats.scdc_read_request);
+		else if (!xhdmi->scdc_mismatch &&
+			 time_before(now, xhdmi->scdc_mon_last +
+				     msecs_to_jiffies(XHDMI_SCDC_MON_RR_FULL_MS)))
+			goto requeue;
+	}
+
+	elapsed_ms = jiffies_to_msecs(now - xhdmi->scdc_mon_last);
+	xhdmi->scdc_mon_last = now;
+	atomic64_inc(&xhdmi->stats.scdc_read);
+	if (XV_HdmiTx_ScdcReadStatus(HdmiTxPtr, &status) != XST_SUCCESS) {
+		atomic64_inc(&xhdmi->stats.scdc_read_error);
+		xhdmi->scdc_mon_interval = XHDMI_SCDC_MON_FAST_MS;
+		goto requeue;
+	}
+
+	stable = !(status.Update0 & XV_HDMITX_SCDC_UPDATE_0_STATUS_MASK);
+	for (i = 0; i < XV_HDMITX_SCDC_CHANNELS; i++) {
+		if (!(status.CedValid & BIT(i)))
+			continue;
+		/* the sink restarts the counters from 0 when it resets them */
+		if (status.Ced[i] >= xhdmi->scdc_ced_last[i])
+			delta = status.Ced[i] - xhdmi->scdc_ced_last[i];
+		else
+			delta = status.Ced[i];
+		xhdmi->scdc_ced_last[i] = status.Ced[i];
+		atomic64_add(delta, &xhdmi->stats.scdc_ced[i]);
+		atomic64_set(&xhdmi->stats.scdc_ced_rate[i], elapsed_ms ?
+			     div_u64((u64)delta * MSEC_PER_SEC, elapsed_ms) : 0);
+		if (delta)
+			stable = false;
+	}
+
+	/* scrambling may take the sink a moment to detect, so a mismatch has
+	 * to be seen on consecutive reads before the config is rewritten */
+	tmds_config = XV_HdmiTx_ScdcGetTmdsConfig(HdmiTxPtr);
+	if ((status.TmdsConfig & (XV_HDMITX_SCDC_TMDS_CONFIG_SCRAMBLING_MASK |
+				  XV_HDMITX_SCDC_TMDS_CONFIG_CLOCK_RATIO_MASK)) !=
+	    tmds_config ||
+	    ((tmds_config & XV_HDMITX_SCDC_TMDS_CONFIG_SCRAMBLING_MASK) &&
+	     !(status.ScramblerStatus &
+	       XV_HDMITX_SCDC_SCRAMBLING_STATUS_MASK))) {
+		stable = false;
+		if (++xhdmi->scdc_mismatch >= XHDMI_SCDC_MON_MISMATCH) {
+			dev_dbg(xhdmi->dev, "scdc: tmds config 0x%02x, expected 0x%02x\n",
+				status.TmdsConfig, tmds_config);
+			if (XV_HdmiTx_ScdcSetTmdsConfig(HdmiTxPtr, tmds_config) ==
+			    XST_SUCCESS)
+				atomic64_inc(&xhdmi->stats.scdc_restore);
+			/* the sink lost its configuration as a whole */
+			if (xhdmi->scdc_rr_enabled)
+				XV_HdmiTx_ScdcSetReadRequest(HdmiTxPtr, TRUE);
+			xhdmi->scdc_mismatch = 0;
+		}
+	} else {
+		xhdmi->scdc_mismatch = 0;
+	}
+
+	if (!stable)
+		xhdmi->scdc_mon_interval = XHDMI_SCDC_MON_FAST_MS;
+	else
+		xhdmi->scdc_mon_interval = min(xhdmi->scdc_mon_interval * 2,
+					       (unsigned int)XHDMI_SCDC_MON_SLOW_MS);
+
+requeue:
+	delay = xhdmi->scdc_rr_enabled && !xhdmi->scdc_mismatch ?
+		XHDMI_SCDC_MON_RR_MS : xhdmi->scdc_mon_interval;
+	schedule_delayed_work(&xhdmi->scdc_mon_work, msecs_to_jiffies(delay));
+out:
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+}
+
+/* lends the hdcp2.2 instance to the PHY loopback benchmark while no stream is
+ * up, and gives it back disabled, to authenticate again on the next stream */
+static int xlnx_drm_hdmi_hdcp22_claim(void *ctx, bool claim)
+{
+	struct xlnx_drm_hdmi *xhdmi = ctx;
+	XV_HdmiTxSs *HdmiTxSsPtr = &xhdmi->xv_hdmitxss;
+	int ret = 0;
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	if (claim) {
+		if (xhdmi->hdmi_stream_up ||
+		    XV_HdmiTxSs_HdcpIsInProgress(HdmiTxSsPtr) ||
+		    XV_HdmiTxSs_HdcpIsAuthenticated(HdmiTxSsPtr))
+			ret = -EBUSY;
+		else
+			WRITE_ONCE(xhdmi->hdcp22_loopback, true);
+	} else {
+		XV_HdmiTxSs_HdcpDisable(HdmiTxSsPtr);
+		xhdmi->hdcp_authenticated = 0;
+		xhdmi->hdcp_encrypted = 0;
+		WRITE_ONCE(xhdmi->hdcp22_loopback, false);
+	}
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+	return ret;
+}
+
 /* this function is responsible for periodically calling XV_HdmiTxSs_HdcpPoll()
 	and XHdcp_Authenticate */
 static void hdcp_poll_work(struct work_struct *work)
@@ -1728,9 +3155,30 @@ static void hdcp_poll_work(struct work_struct *work)
 
 	HdmiTxSsPtr = (XV_HdmiTxSs *)&xhdmi->xv_hdmitxss;
 
+	/* the PHY loopback benchmark polls the hdcp2.2 instance meanwhile */
+	if (READ_ONCE(xhdmi->hdcp22_loopback))
+		goto reschedule;
+
+	xlnx_drm_hdmi_hdcp_apply_content_type(xhdmi);
+
 	if (XV_HdmiTxSs_HdcpIsReady(HdmiTxSsPtr)) {
 		hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+		if (xhdmi->hdcp22_loopback) {
+			hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+			goto reschedule;
+		}
 		XV_HdmiTxSs_HdcpPoll(HdmiTxSsPtr);
+		/* the repeater confirmed the content stream type */
+		if (xhdmi->hdcp_type_change_start &&
+		    !XV_HdmiTxSs_HdcpIsContentStreamTypeChangePending(HdmiTxSsPtr)) {
+			if (XV_HdmiTxSs_HdcpIsAuthenticated(HdmiTxSsPtr))
+				xlnx_hdmi_hist_add(&xhdmi->stats.hdcp_type_change_us,
+						   xhdmi->hdcp_type_change_start);
+			else
+				atomic64_inc(&xhdmi->stats.hdcp_type_change_fail);
+			xhdmi->hdcp_type_change_start = 0;
+			hdcp_protect_content(xhdmi);
+		}
 		xhdmi->hdcp_auth_counter++;
 		if(xhdmi->hdcp_auth_counter >= 10) { //every 10ms
 			xhdmi->hdcp_auth_counter = 0;
@@ -1740,6 +3188,7 @@ static void hdcp_poll_work(struct work_struct *work)
 		}
 		hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
 	}
+reschedule:
 	/* reschedule this work again in 1 millisecond */
 	schedule_delayed_work(&xhdmi->delayed_work_hdcp_poll, msecs_to_jiffies(1));
 	return;
@@ -2055,6 +3504,93 @@ static ssize_t hdcp_log_show(struct device *sysfs_dev, struct device_attribute *
 	return count;
 }
 
+/* key=value counters, cheap enough to be scraped at a high rate */
+static ssize_t hdmi_stats_show(struct device *sysfs_dev, struct device_attribute *attr,
+	char *buf)
+{
+	struct xlnx_drm_hdmi *xhdmi = (struct xlnx_drm_hdmi *)dev_get_drvdata(sysfs_dev);
+	const struct xlnx_drm_hdmi_stats *stats = &xhdmi->stats;
+	ssize_t count = 0;
+	char name[20];
+	unsigned int i;
+
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_pio", &stats->irq_pio);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_hdcp1x",
+					&stats->irq_hdcp1x);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_hdcp1x_timer",
+					&stats->irq_hdcp1x_timer);
+	count = xlnx_hdmi_stats_counter(buf, count, "irq_hdcp22_timer",
+					&stats->irq_hdcp22_timer);
+	count = xlnx_hdmi_stats_counter(buf, count, "soft_timer_hdcp1x",
+					&stats->soft_timer_hdcp1x);
+	count = xlnx_hdmi_stats_counter(buf, count, "soft_timer_hdcp22",
+					&stats->soft_timer_hdcp22);
+	count = xlnx_hdmi_stats_counter(buf, count, "connect", &stats->connect);
+	count = xlnx_hdmi_stats_counter(buf, count, "disconnect",
+					&stats->disconnect);
+	count = xlnx_hdmi_stats_counter(buf, count, "stream_up",
+					&stats->stream_up);
+	count = xlnx_hdmi_stats_counter(buf, count, "stream_down",
+					&stats->stream_down);
+	count = xlnx_hdmi_stats_counter(buf, count, "streamup_timeout",
+					&stats->streamup_timeout);
+	count = xlnx_hdmi_stats_counter(buf, count, "brdg_overflow",
+					&stats->brdg_overflow);
+	count = xlnx_hdmi_stats_counter(buf, count, "brdg_underflow",
+					&stats->brdg_underflow);
+	count = xlnx_hdmi_stats_counter(buf, count, "brdg_unlocked",
+					&stats->brdg_unlocked);
+	count = xlnx_hdmi_stats_counter(buf, count, "ddc_edid_read",
+					&stats->ddc_edid_read);
+	count = xlnx_hdmi_stats_counter(buf, count, "ddc_edid_error",
+					&stats->ddc_edid_error);
+	count = xlnx_hdmi_stats_counter(buf, count, "edid_cache_hit",
+					&stats->edid_cache_hit);
+	count = xlnx_hdmi_stats_counter(buf, count, "hdcp_auth_attempt",
+					&stats->hdcp_auth_attempt);
+	count = xlnx_hdmi_stats_counter(buf, count, "hdcp_auth_success",
+					&stats->hdcp_auth_success);
+	count = xlnx_hdmi_stats_counter(buf, count, "hdcp_unauthenticated",
+					&stats->hdcp_unauthenticated);
+	count = xlnx_hdmi_stats_counter(buf, count, "hdcp_type_change",
+					&stats->hdcp_type_change);
+	count = xlnx_hdmi_stats_counter(buf, count, "hdcp_type_change_fail",
+					&stats->hdcp_type_change_fail);
+	count = xlnx_hdmi_stats_u64(buf, count, "hdcp_evt_overflow",
+				    xhdmi->xv_hdmitxss.HdcpEventQueue.Overflow);
+	count = xlnx_hdmi_stats_u64(buf, count, "hdcp_evt_coalesced",
+				    xhdmi->xv_hdmitxss.HdcpEventQueue.Coalesced);
+	count = xlnx_hdmi_stats_counter(buf, count, "modeset", &stats->modeset);
+	count = xlnx_hdmi_stats_counter(buf, count, "modeset_fast",
+					&stats->modeset_fast);
+	count = xlnx_hdmi_stats_counter(buf, count, "resume", &stats->resume);
+	count = xlnx_hdmi_stats_counter(buf, count, "resume_restore",
+					&stats->resume_restore);
+	count = xlnx_hdmi_stats_counter(buf, count, "scdc_read",
+					&stats->scdc_read);
+	count = xlnx_hdmi_stats_counter(buf, count, "scdc_read_error",
+					&stats->scdc_read_error);
+	count = xlnx_hdmi_stats_counter(buf, count, "scdc_read_request",
+					&stats->scdc_read_request);
+	count = xlnx_hdmi_stats_counter(buf, count, "scdc_restore",
+					&stats->scdc_restore);
+	for (i = 0; i < XV_HDMITX_SCDC_CHANNELS; i++) {
+		snprintf(name, sizeof(name), "scdc_ced%u", i);
+		count = xlnx_hdmi_stats_counter(buf, count, name,
+						&stats->scdc_ced[i]);
+		snprintf(name, sizeof(name), "scdc_ced_rate%u", i);
+		count = xlnx_hdmi_stats_counter(buf, count, name,
+						&stats->scdc_ced_rate[i]);
+	}
+	count = xlnx_hdmi_stats_hist(buf, count, "modeset", &stats->modeset_us);
+	count = xlnx_hdmi_stats_hist(buf, count, "streamup", &stats->streamup_us);
+	count = xlnx_hdmi_stats_hist(buf, count, "resume", &stats->resume_us);
+	count = xlnx_hdmi_stats_hist(buf, count, "hdcp_auth", &stats->hdcp_auth_us);
+	count = xlnx_hdmi_stats_hist(buf, count, "hdcp_type_change",
+				     &stats->hdcp_type_change_us);
+	return count;
+}
+
 static ssize_t hdcp_authenticate_store(struct device *sysfs_dev, struct device_attribute *attr,
 	const char *buf, size_t count)
 {
@@ -2068,11 +3604,14 @@ static ssize_t hdcp_authenticate_store(struct device *sysfs_dev, struct device_a
 		return count;
 	}
 	i = !!i;
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
 	xhdmi->hdcp_authenticate = i;
-	if (i && XV_HdmiTxSs_HdcpIsReady(HdmiTxSsPtr)) {
+	/* otherwise picked up by hdcp_poll_work after the loopback */
+	if (i && XV_HdmiTxSs_HdcpIsReady(HdmiTxSsPtr) && !xhdmi->hdcp22_loopback) {
 		XV_HdmiTxSs_HdcpSetProtocol(HdmiTxSsPtr, XV_HDMITXSS_HDCP_22);
 		XV_HdmiTxSs_HdcpAuthRequest(HdmiTxSsPtr);
 	}
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
 	return count;
 }
 
@@ -2356,6 +3895,11 @@ static ssize_t hdcp_key_store(struct device *sysfs_dev, struct device_attribute
 		XV_HdmiTxSs_SetCallback(HdmiTxSsPtr, XV_HDMITXSS_HANDLER_HDCP_UNAUTHENTICATED,
 			TxHdcpUnauthenticatedCallback, (void *)xhdmi);
 
+		/* offer HDCP 2.2 to the PHY loopback benchmark */
+		if (xhdmi->config.Hdcp22.IsPresent && HdmiTxSsPtr->Hdcp22Ptr)
+			xvphy_hdcp22_register(xhdmi->phy[0], HdmiTxSsPtr->Hdcp22Ptr,
+					      xlnx_drm_hdmi_hdcp22_claim, xhdmi);
+
 		if (xhdmi->config.Hdcp14.IsPresent || xhdmi->config.Hdcp22.IsPresent) {
 			/* call into hdcp_poll_work, which will reschedule itself */
 			hdcp_poll_work(&xhdmi->delayed_work_hdcp_poll.work);
@@ -2364,6 +3908,75 @@ static ssize_t hdcp_key_store(struct device *sysfs_dev, struct device_attribute
 	return count;
 }
 
+/* the HDCP 1.4 SRM is written as a binary blob, starting at offset 0 and in
+ * order, possibly over several writes; once the SRM is complete, the KSV
+ * revocation list is loaded from it, now or when HDCP is initialized */
+static ssize_t hdcp14_srm_write(struct file *filp, struct kobject *kobj,
+	struct bin_attribute *attr, char *buf, loff_t pos, size_t count)
+{
+	struct device *sysfs_dev = kobj_to_dev(kobj);
+	struct xlnx_drm_hdmi *xhdmi = (struct xlnx_drm_hdmi *)dev_get_drvdata(sysfs_dev);
+	XV_HdmiTxSs *HdmiTxSsPtr = (XV_HdmiTxSs *)&xhdmi->xv_hdmitxss;
+	size_t staged;
+	u32 size;
+	u8 *srm;
+	int Status;
+
+	if (!xhdmi->config.Hdcp14.IsPresent || !count)
+		return -EINVAL;
+	if (pos + count > XHDMI_HDCP14_SRM_MAX_SIZE)
+		return -EFBIG;
+
+	hdmi_mutex_lock(&xhdmi->hdmi_mutex);
+	if (pos == 0) {
+		kvfree(xhdmi->hdcp14_srm_stage);
+		xhdmi->hdcp14_srm_stage = kvmalloc(XHDMI_HDCP14_SRM_MAX_SIZE, GFP_KERNEL);
+		xhdmi->hdcp14_srm_staged = 0;
+		if (!xhdmi->hdcp14_srm_stage) {
+			hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+			return -ENOMEM;
+		}
+	}
+	if (!xhdmi->hdcp14_srm_stage || pos != xhdmi->hdcp14_srm_staged) {
+		hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+		return -EINVAL;
+	}
+	memcpy(xhdmi->hdcp14_srm_stage + pos, buf, count);
+	staged = pos + count;
+	xhdmi->hdcp14_srm_staged = staged;
+
+	size = XHdcp1x_GetSrmSize(xhdmi->hdcp14_srm_stage, staged);
+	if (!size || staged < size) {
+		/* wait for the remainder of the SRM */
+		hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+		return count;
+	}
+
+	srm = NULL;
+	Status = XST_FAILURE;
+	if (staged == size)
+		srm = devm_kmemdup(xhdmi->dev, xhdmi->hdcp14_srm_stage, size, GFP_KERNEL);
+	if (srm)
+		Status = XV_HdmiTxSs_HdcpSetHdcp14Srm(HdmiTxSsPtr, srm, size);
+	kvfree(xhdmi->hdcp14_srm_stage);
+	xhdmi->hdcp14_srm_stage = NULL;
+	xhdmi->hdcp14_srm_staged = 0;
+	if (Status != XST_SUCCESS) {
+		hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+		dev_err(xhdmi->dev, "HDCP 1.4 SRM is malformed or too large.\n");
+		if (srm)
+			devm_kfree(xhdmi->dev, srm);
+		return -EINVAL;
+	}
+	swap(xhdmi->hdcp14_srm, srm);
+	xhdmi->hdcp14_srm_size = size;
+	hdmi_mutex_unlock(&xhdmi->hdmi_mutex);
+
+	if (srm)
+		devm_kfree(xhdmi->dev, srm);
+	return count;
+}
+
 static ssize_t hdcp_password_show(struct device *sysfs_dev, struct device_attribute *attr,
 	char *buf)
 {
@@ -2402,8 +4015,10 @@ static DEVICE_ATTR(vphy_info, 0444, vphy_info_show, NULL/*store*/);
 static DEVICE_ATTR(hdmi_log,  0444, hdmi_log_show, NULL/*store*/);
 static DEVICE_ATTR(hdcp_log,  0444, hdcp_log_show, NULL/*store*/);
 static DEVICE_ATTR(hdmi_info, 0444, hdmi_info_show, NULL/*store*/);
+static DEVICE_ATTR(hdmi_stats, 0444, hdmi_stats_show, NULL/*store*/);
 static DEVICE_ATTR(hdcp_debugen, 0220, NULL/*show*/, hdcp_debugen_store);
 static DEVICE_ATTR(hdcp_key, 0220, NULL/*show*/, hdcp_key_store);
+static BIN_ATTR(hdcp14_srm, 0220, NULL/*read*/, hdcp14_srm_write, XHDMI_HDCP14_SRM_MAX_SIZE);
 static DEVICE_ATTR(hdcp_password, 0660, hdcp_password_show, hdcp_password_store);
 
 /* readable and writable controls */
@@ -2420,6 +4035,7 @@ static struct attribute *attrs[] = {
 	&dev_attr_hdmi_log.attr,
 	&dev_attr_hdcp_log.attr,
 	&dev_attr_hdmi_info.attr,
+	&dev_attr_hdmi_stats.attr,
 	&dev_attr_hdcp_debugen.attr,
 	&dev_attr_hdcp_key.attr,
 	&dev_attr_hdcp_password.attr,
@@ -2431,8 +4047,14 @@ static struct attribute *attrs[] = {
 	NULL,
 };
 
+static struct bin_attribute *bin_attrs[] = {
+	&bin_attr_hdcp14_srm,
+	NULL,
+};
+
 static struct attribute_group attr_group = {
 	.attrs = attrs,
+	.bin_attrs = bin_attrs,
 };
 
 static void xlnx_drm_hdmi_create_connector_property(
@@ -2467,6 +4089,11 @@ static void xlnx_drm_hdmi_create_connector_property(
 						   MEDIA_BUS_FMT_VYYUYY8_1X24);
 	xhdmi->aspect_ratio = drm_property_create_range(dev, 0, "aspect_ratio",
 							XVIDC_AR_4_3, XVIDC_AR_256_135);
+	/* HDCP 2.2 content stream type, 0 or 1 */
+	if (xhdmi->config.Hdcp22.IsPresent)
+		xhdmi->hdcp_content_type =
+			drm_property_create_range(dev, 0, "hdcp_content_type",
+						  0, 1);
 }
 
 static void xlnx_drm_hdmi_attach_connector_property(
@@ -2493,6 +4120,8 @@ static void xlnx_drm_hdmi_attach_connector_property(
 		drm_object_attach_property(obj, xhdmi->out_fmt, 0);
 	if (xhdmi->aspect_ratio)
 		drm_object_attach_property(obj, xhdmi->aspect_ratio, 0);
+	if (xhdmi->hdcp_content_type)
+		drm_object_attach_property(obj, xhdmi->hdcp_content_type, 0);
 }
 
 static int xlnx_drm_hdmi_create_connector(struct drm_encoder *encoder)
@@ -2574,6 +4203,9 @@ static void xlnx_drm_hdmi_unbind(struct device *dev, struct device *master,
 {
 	struct xlnx_drm_hdmi *xhdmi = dev_get_drvdata(dev);
 
+	cancel_delayed_work_sync(&xhdmi->streamup_work);
+	cancel_delayed_work_sync(&xhdmi->scdc_mon_work);
+	cancel_work_sync(&xhdmi->retime_work);
 	if (xhdmi->bridge)
 		xlnx_bridge_disable(xhdmi->bridge);
 	xlnx_drm_hdmi_encoder_dpms(&xhdmi->encoder, DRM_MODE_DPMS_OFF);
@@ -2860,7 +4492,11 @@ static int xlnx_drm_hdmi_probe(struct platform_device *pdev)
 	mutex_init(&xhdmi->hdmi_mutex);
 	spin_lock_init(&xhdmi->irq_lock);
 
-	init_waitqueue_head(&xhdmi->wait_event);
+	init_completion(&xhdmi->streamup_done);
+	INIT_DELAYED_WORK(&xhdmi->streamup_work, xlnx_drm_hdmi_streamup_work);
+	INIT_WORK(&xhdmi->retime_work, xlnx_drm_hdmi_retime_work);
+	INIT_DELAYED_WORK(&xhdmi->scdc_mon_work, xlnx_drm_hdmi_scdc_mon_work);
+	xhdmi->link_status = DRM_MODE_LINK_STATUS_GOOD;
 
 	dev_dbg(xhdmi->dev,"DT parse start\n");
 	/* parse open firmware device tree data */
@@ -3049,6 +4685,10 @@ static int xlnx_drm_hdmi_probe(struct platform_device *pdev)
 	  dev_dbg(xhdmi->dev,"xhdmi->hdcp1x_irq = %d\n", xhdmi->hdcp1x_irq);
 	  xhdmi->hdcp1x_timer_irq = platform_get_irq_byname(pdev, "hdcp14_timer_irq");
 	  dev_dbg(xhdmi->dev,"xhdmi->hdcp1x_timer_irq = %d\n", xhdmi->hdcp1x_timer_irq);
+	  xhdmi->hdcp1x_timer_soft = xlnx_drm_hdmi_hdcp_soft_timer(xhdmi,
+		&XTmrCtr_ConfigTable[instance * 2 + 0], &xhdmi->hdcp1x_soft_timer,
+		&xhdmi->hdcp1x_timer_irq);
+	  dev_dbg(xhdmi->dev,"xhdmi->hdcp1x_timer_soft = %d\n", xhdmi->hdcp1x_timer_soft);
 	}
 
 	if (xhdmi->config.Hdcp22.IsPresent) {
@@ -3056,6 +4696,10 @@ static int xlnx_drm_hdmi_probe(struct platform_device *pdev)
 	  dev_dbg(xhdmi->dev,"xhdmi->hdcp22_irq = %d\n", xhdmi->hdcp22_irq);
 	  xhdmi->hdcp22_timer_irq = platform_get_irq_byname(pdev, "hdcp22_timer_irq");
 	  dev_dbg(xhdmi->dev,"xhdmi->hdcp22_timer_irq = %d\n", xhdmi->hdcp22_timer_irq);
+	  xhdmi->hdcp22_timer_soft = xlnx_drm_hdmi_hdcp_soft_timer(xhdmi,
+		&XTmrCtr_ConfigTable[instance * 2 + 1], &xhdmi->hdcp22_soft_timer,
+		&xhdmi->hdcp22_timer_irq);
+	  dev_dbg(xhdmi->dev,"xhdmi->hdcp22_timer_soft = %d\n", xhdmi->hdcp22_timer_soft);
 	}
 
 	if (xhdmi->config.Hdcp14.IsPresent || xhdmi->config.Hdcp22.IsPresent) {
@@ -3107,10 +4751,17 @@ static int xlnx_drm_hdmi_remove(struct platform_device *pdev)
 {
 	struct xlnx_drm_hdmi *xhdmi = platform_get_drvdata(pdev);
 
+	xvphy_hdcp22_register(xhdmi->phy[0], NULL, NULL, NULL);
 	if (xhdmi->audio_init)
 		hdmitx_unregister_aud_dev(&pdev->dev);
 
+	if (xhdmi->hdcp1x_timer_soft)
+		XTmrCtr_HrTimerRelease(&xhdmi->hdcp1x_soft_timer);
+	if (xhdmi->hdcp22_timer_soft)
+		XTmrCtr_HrTimerRelease(&xhdmi->hdcp22_soft_timer);
+
 	sysfs_remove_group(&pdev->dev.kobj, &attr_group);
+	kvfree(xhdmi->hdcp14_srm_stage);
 	component_del(&pdev->dev, &xlnx_drm_hdmi_component_ops);
 	return 0;
 }
@@ -0,0 +1,104 @@
+/*
+ * Xilinx HDMI performance counters
+ *
+ * Copyright (C) 2026 Xilinx, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef __XILINX_HDMI_STATS_H__
+#define __XILINX_HDMI_STATS_H__
+
+#include <linux/atomic.h>
+#include <linux/kernel.h>
+#include <linux/ktime.h>
+#include <linux/log2.h>
+
+/*
+ * Latency histogram with power-of-two microsecond buckets: bucket 0 counts
+ * samples below 1 us, bucket n counts samples in [2^(n-1), 2^n) us and the
+ * last bucket everything from 2^(XHDMI_STATS_HIST_BUCKETS - 2) us (~4 s) up.
+ */
+#define XHDMI_STATS_HIST_BUCKETS 24
+
+struct xlnx_hdmi_hist {
+	atomic64_t count;
+	atomic64_t sum_us;
+	atomic64_t max_us;
+	atomic64_t bucket[XHDMI_STATS_HIST_BUCKETS];
+};
+
+/* account the time elapsed since start, start == 0 means not started */
+static inline void xlnx_hdmi_hist_add(struct xlnx_hdmi_hist *hist, ktime_t start)
+{
+	s64 us, max;
+	unsigned int i;
+
+	if (!start)
+		return;
+	us = ktime_us_delta(ktime_get(), start);
+	if (us < 0)
+		us = 0;
+	i = us ? ilog2(us) + 1 : 0;
+	if (i >= XHDMI_STATS_HIST_BUCKETS)
+		i = XHDMI_STATS_HIST_BUCKETS - 1;
+	atomic64_inc(&hist->bucket[i]);
+	atomic64_add(us, &hist->sum_us);
+	max = atomic64_read(&hist->max_us);
+	while (us > max) {
+		s64 old = atomic64_cmpxchg(&hist->max_us, max, us);
+
+		if (old == max)
+			break;
+		max = old;
+	}
+	atomic64_inc(&hist->count);
+}
+
+/*
+ * The counters are updated in the interrupt and callback paths and read
+ * without locking. They are atomic64_t so that a 32-bit reader never sees
+ * a torn value and concurrent updates are not lost. A scrape may still
+ * race with a histogram sample in progress; every field is monotonic and
+ * the next scrape picks up the difference.
+ */
+static inline ssize_t xlnx_hdmi_stats_u64(char *buf, ssize_t count,
+					  const char *name, u64 value)
+{
+	return count + scnprintf(&buf[count], PAGE_SIZE - count, "%s=%llu\n",
+				 name, value);
+}
+
+static inline ssize_t xlnx_hdmi_stats_counter(char *buf, ssize_t count,
+					      const char *name,
+					      const atomic64_t *counter)
+{
+	return xlnx_hdmi_stats_u64(buf, count, name, atomic64_read(counter));
+}
+
+static inline ssize_t xlnx_hdmi_stats_hist(char *buf, ssize_t count,
+					   const char *name,
+					   const struct xlnx_hdmi_hist *hist)
+{
+	unsigned int i;
+
+	count += scnprintf(&buf[count], PAGE_SIZE - count,
+			   "%s_count=%llu\n%s_sum_us=%llu\n%s_max_us=%llu\n%s_hist=",
+			   name, (u64)atomic64_read(&hist->count),
+			   name, (u64)atomic64_read(&hist->sum_us),
+			   name, (u64)atomic64_read(&hist->max_us), name);
+	for (i = 0; i < XHDMI_STATS_HIST_BUCKETS; i++)
+		count += scnprintf(&buf[count], PAGE_SIZE - count, "%llu%c",
+				   (u64)atomic64_read(&hist->bucket[i]),
+				   i == XHDMI_STATS_HIST_BUCKETS - 1 ? '\n' : ' ');
+	return count;
+}
+
+#endif /* __XILINX_HDMI_STATS_H__ */
@@ -16,6 +16,8 @@
  */
 
 #include <linux/of_address.h>
+#include <sound/control.h>
+#include <sound/pcm_params.h>
 #include <sound/soc.h>
 #include <sound/hdmi-codec.h>
 
@@ -34,14 +36,20 @@
 static int xlnx_rx_pcm_startup(struct snd_pcm_substream *substream,
 			struct snd_soc_dai *dai)
 {
+	struct xlnx_hdmirx_audio_data *adata = hdmirx_get_audio_data(dai->dev);
 	u32 channels = hdmirx_audio_startup(dai->dev);
 
 	if (!channels)
 		return -EINVAL;
 
 	dev_info(dai->dev,
-		 "Detected audio with channel count = %d, starting capture\n",
-		 channels);
+		 "Detected audio with channel count = %d, rate = %u, starting capture\n",
+		 channels, adata->rate);
+	/* restrict hw_params to the rate of the incoming stream */
+	if (adata->rate)
+		return snd_pcm_hw_constraint_single(substream->runtime,
+						    SNDRV_PCM_HW_PARAM_RATE,
+						    adata->rate);
 	return 0;
 }
 
@@ -76,13 +84,60 @@ static struct snd_soc_dai_driver xlnx_rx_audio_dai = {
 	.ops = &xlnx_rx_dai_ops,
 };
 
+static int xlnx_rx_rate_info(struct snd_kcontrol *kcontrol,
+			     struct snd_ctl_elem_info *uinfo)
+{
+	uinfo->type = SNDRV_CTL_ELEM_TYPE_INTEGER;
+	uinfo->count = 1;
+	uinfo->value.integer.min = 0;
+	uinfo->value.integer.max = 192000;
+	return 0;
+}
+
+static int xlnx_rx_rate_get(struct snd_kcontrol *kcontrol,
+			    struct snd_ctl_elem_value *ucontrol)
+{
+	struct xlnx_hdmirx_audio_data *adata = snd_kcontrol_chip(kcontrol);
+
+	ucontrol->value.integer.value[0] = READ_ONCE(adata->rate);
+	return 0;
+}
+
+/* sample rate of the incoming stream, 0 if no audio is detected */
+static const struct snd_kcontrol_new xlnx_rx_rate_ctl = {
+	.iface = SNDRV_CTL_ELEM_IFACE_PCM,
+	.name = "HDMI Capture Rate",
+	.access = SNDRV_CTL_ELEM_ACCESS_READ |
+		  SNDRV_CTL_ELEM_ACCESS_VOLATILE,
+	.info = xlnx_rx_rate_info,
+	.get = xlnx_rx_rate_get,
+};
+
 static int xlnx_rx_codec_probe(struct snd_soc_component *component)
 {
+	struct xlnx_hdmirx_audio_data *adata =
+		hdmirx_get_audio_data(component->dev);
+	struct snd_card *card = component->card->snd_card;
+	struct snd_kcontrol *kctl;
+	int ret;
+
+	kctl = snd_ctl_new1(&xlnx_rx_rate_ctl, adata);
+	ret = snd_ctl_add(card, kctl);
+	if (ret < 0)
+		return ret;
+	adata->card = card;
+	adata->rate_ctl = kctl;
 	return 0;
 }
 
 void xlnx_rx_codec_remove(struct snd_soc_component *component)
 {
+	struct xlnx_hdmirx_audio_data *adata =
+		hdmirx_get_audio_data(component->dev);
+
+	/* the control is released with the card */
+	adata->rate_ctl = NULL;
+	adata->card = NULL;
 }
 
 static const struct snd_soc_component_driver xlnx_rx_codec_driver = {
@@ -101,6 +156,20 @@ int hdmirx_register_aud_dev(struct device *dev)
 			&xlnx_rx_audio_dai, 1);
 }
 
+/* hdmirx_audio_rate_changed - notify a sample rate change
+ *
+ * This function is called by the HDMI RX driver when the sample rate
+ * derived from the ACR packets changes, including to and from 0.
+ */
+void hdmirx_audio_rate_changed(struct device *dev)
+{
+	struct xlnx_hdmirx_audio_data *adata = hdmirx_get_audio_data(dev);
+
+	if (adata && adata->rate_ctl)
+		snd_ctl_notify(adata->card, SNDRV_CTL_EVENT_MASK_VALUE,
+			       &adata->rate_ctl->id);
+}
+
 /* hdmirx_register_aud_dev - register audio device
  *
  * This functions unregisters codec DAI device
@@ -25,12 +25,19 @@ int hdmirx_register_aud_dev(struct device *dev);
 void hdmirx_unregister_aud_dev(struct device *dev);
 u32 hdmirx_audio_startup(struct device *dev);
 void hdmirx_audio_shutdown(struct device *dev);
+void hdmirx_audio_rate_changed(struct device *dev);
 
 struct xlnx_hdmirx_audio_data {
 	void __iomem *aes_base;
 	bool audio_detected;
 	wait_queue_head_t audio_update_q;
+	/* 0 unknown, 1 L-PCM, 2 HBR, as reported by the core */
 	int format;
 	u8 num_channels;
+	/* sample rate in Hz derived from the ACR packets, 0 if unknown */
+	u32 rate;
+	/* "HDMI Capture Rate" control, notified on rate changes */
+	struct snd_card *card;
+	struct snd_kcontrol *rate_ctl;
 };
 #endif /* __XILINX_HDMI_RX_AUD_H__ */
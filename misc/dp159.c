@@ -199,6 +199,20 @@ static void dp159_remove(struct i2c_client *client)
 		clk_unregister(clk_tx->clk);
 }
 
+/* the retimer may have lost its configuration, reprogram it for the last
+ * line rate, or for HDMI 1.4 as at probe if no rate was set */
+static int __maybe_unused dp159_pm_resume(struct device *dev)
+{
+	struct i2c_client *client = to_i2c_client(dev);
+	struct clk_tx_linerate *clk_tx;
+	clk_tx = (struct clk_tx_linerate *)i2c_get_clientdata(client);
+	if (!clk_tx)
+		return 0;
+	return dp159_program(client, clk_tx->rate) ? -EIO : 0;
+}
+
+static SIMPLE_DEV_PM_OPS(dp159_pm_ops, NULL, dp159_pm_resume);
+
 static const struct i2c_device_id dp159_id[] = {
 	{ "dp159", 0 },
 	{ }
@@ -218,6 +232,7 @@ static struct i2c_driver dp159_driver = {
 		.owner = THIS_MODULE,
 		.name	= "dp159",
 		.of_match_table = of_match_ptr(dp159_of_match),
+		.pm = &dp159_pm_ops,
 	},
 	.probe		= dp159_probe,
 	.remove		= dp159_remove,